@@ -2,99 +2,7 @@
 using namespace metal;
 
 #include "ShaderCommon.h"
-
-// Chunk header structure (must match ChunkedSplatFormat.swift GPUChunkHeader)
-struct ChunkHeader {
-    float3 minPosition;
-    float padding1;
-
-    float3 maxPosition;
-    float padding2;
-
-    float3 minScale;
-    float padding3;
-
-    float3 maxScale;
-    uint splatCount;
-};
-
-// Packed splat structure (16 bytes, must match ChunkedSplatFormat.swift PackedSplat)
-struct PackedSplat {
-    uint positionPacked;   // 11-10-11 bits
-    uint rotationPacked;   // 2-bit selector + 3×10-bit components
-    uint scalePacked;      // 11-10-11 bits with exponential mapping
-    uint colorPacked;      // RGBA8
-};
-
-// Unpack position from 11-10-11 bits using chunk bounds
-inline float3 unpackPosition(uint packed, float3 minPos, float3 maxPos) {
-    float x = float((packed >> 21) & 0x7FF) / 2047.0;
-    float y = float((packed >> 11) & 0x3FF) / 1023.0;
-    float z = float(packed & 0x7FF) / 2047.0;
-
-    float3 range = maxPos - minPos;
-    return minPos + float3(x, y, z) * range;
-}
-
-// Unpack quaternion from 2-bit selector + 3×10-bit components
-// Uses smallest-three encoding
-inline float4 unpackRotation(uint packed) {
-    uint largestIdx = (packed >> 30) & 0x3;
-    float a = float((packed >> 20) & 0x3FF) / 1023.0;
-    float b = float((packed >> 10) & 0x3FF) / 1023.0;
-    float c = float(packed & 0x3FF) / 1023.0;
-
-    // Map back from [0, 1] to [-0.707, 0.707]
-    float3 components = float3(
-        (a * 2.0 - 1.0) * 0.707,
-        (b * 2.0 - 1.0) * 0.707,
-        (c * 2.0 - 1.0) * 0.707
-    );
-
-    // Reconstruct largest component from unit quaternion constraint
-    float sumSq = dot(components, components);
-    float largest = sqrt(max(1.0 - sumSq, 0.0));
-
-    // Build quaternion
-    float4 q;
-    uint j = 0;
-    for (uint i = 0; i < 4; i++) {
-        if (i == largestIdx) {
-            q[i] = largest;
-        } else {
-            q[i] = components[j];
-            j++;
-        }
-    }
-
-    return q;
-}
-
-// Unpack scale from 11-10-11 bits with exponential mapping
-inline float3 unpackScale(uint packed, float3 minScale, float3 maxScale) {
-    float x = float((packed >> 21) & 0x7FF) / 2047.0;
-    float y = float((packed >> 11) & 0x3FF) / 1023.0;
-    float z = float(packed & 0x7FF) / 2047.0;
-
-    // Use log-space interpolation for exponential mapping
-    float3 logMin = log(max(minScale, float3(0.0001)));
-    float3 logMax = log(max(maxScale, float3(0.0001)));
-
-    float3 logRange = logMax - logMin;
-    float3 logScale = logMin + float3(x, y, z) * logRange;
-
-    return exp(logScale);
-}
-
-// Unpack RGBA color from 32 bits (8 bits per channel)
-inline half4 unpackColor(uint packed) {
-    float r = float((packed >> 24) & 0xFF) / 255.0;
-    float g = float((packed >> 16) & 0xFF) / 255.0;
-    float b = float((packed >> 8) & 0xFF) / 255.0;
-    float a = float(packed & 0xFF) / 255.0;
-
-    return half4(r, g, b, a);
-}
+#include "PackedSplat.h"
 
 // Convert quaternion and scale to covariance matrix components
 inline void quaternionScaleToCovariance(float4 quat, float3 scale, thread half3& covA, thread half3& covB) {
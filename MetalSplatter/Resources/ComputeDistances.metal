@@ -80,6 +80,79 @@ kernel void computeSplatDistancesWithCaching(uint index [[thread_position_in_gri
     }
 }
 
+// =============================================================================
+// Instanced Scene Sort Keys
+// =============================================================================
+// Distances for every (visible instance, splat) pair of an instanced scene, slot-major: pair
+// slot * splatCount + splat. Each visible entry is (instance, LOD stride); an instance at stride k only
+// keeps every k-th splat. Culled pairs get -INFINITY, which the descending argsort moves to the end.
+
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void computeInstancedSplatDistances(uint2 gid [[thread_position_in_grid]],
+                                           constant Splat* splatArray [[buffer(0)]],
+                                           device float* distances [[buffer(1)]],
+                                           const device uchar *editStates [[buffer(2)]],
+                                           constant float3& cameraPosition [[buffer(3)]],
+                                           constant float3& cameraForward [[buffer(4)]],
+                                           constant bool& sortByDistance [[buffer(5)]],
+                                           constant uint& splatCount [[buffer(6)]],
+                                           const device float4x4 *instanceTransforms [[buffer(7)]],
+                                           const device uint2 *visibleInstances [[buffer(8)]],
+                                           constant uint& visibleInstanceCount [[buffer(9)]],
+                                           const device uint *pairOffsets [[buffer(10)]]) {
+    if (gid.y >= visibleInstanceCount) return;
+    // gid.x is the instance's gid.x-th kept splat; its pairs are compacted to pairOffsets[gid.y]...
+    uint pairStart = pairOffsets[gid.y];
+    if (gid.x >= pairOffsets[gid.y + 1] - pairStart) return;
+
+    uint pair = pairStart + gid.x;
+    uint2 entry = visibleInstances[gid.y];
+    uint splat = gid.x * max(entry.y, 1u);
+    bool hidden = editStates != nullptr && (editStates[splat] & ((1u << 1) | (1u << 3))) != 0u;
+    if (hidden || splat >= splatCount) {
+        distances[pair] = -INFINITY;
+        return;
+    }
+
+    float3 splatPos = (instanceTransforms[entry.x] * float4(float3(splatArray[splat].position), 1.0)).xyz;
+    float3 delta = splatPos - cameraPosition;
+    distances[pair] = sortByDistance ? dot(delta, delta) : dot(delta, cameraForward);
+}
+
+// Rewrites the argsorted compacted pair order into the (instance, splat) keys the instanced vertex shader
+// reads, instance * splatCount + splat. Culled pairs become -1.
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void remapInstancedSortKeys(uint index [[thread_position_in_grid]],
+                                   device int32_t *order [[buffer(0)]],
+                                   const device float *distances [[buffer(1)]],
+                                   const device uint2 *visibleInstances [[buffer(2)]],
+                                   constant uint& splatCount [[buffer(3)]],
+                                   constant uint& keyCount [[buffer(4)]],
+                                   const device uint *pairOffsets [[buffer(5)]],
+                                   constant uint& visibleInstanceCount [[buffer(6)]]) {
+    if (index >= keyCount) return;
+
+    uint pair = uint(order[index]);
+    if (distances[pair] == -INFINITY) {
+        order[index] = -1;
+        return;
+    }
+    // The last visible instance whose slots start at or before the pair
+    uint low = 0;
+    uint high = visibleInstanceCount - 1;
+    while (low < high) {
+        uint middle = (low + high + 1) / 2;
+        if (pairOffsets[middle] <= pair) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    uint2 entry = visibleInstances[low];
+    uint splat = (pair - pairOffsets[low]) * max(entry.y, 1u);
+    order[index] = int32_t(entry.x * splatCount + splat);
+}
+
 // =============================================================================
 // SIMD-Group Parallel Bounds Computation
 // =============================================================================
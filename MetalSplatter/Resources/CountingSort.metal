@@ -1,4 +1,5 @@
 #include "ShaderCommon.h"
+#include "PackedSplat.h"
 
 // Counting Sort Implementation for O(n) Gaussian Splat Sorting
 // Inspired by PlayCanvas gsplat-sort-worker.js
@@ -216,6 +217,68 @@ void countingSortHistogramWeightedNoEdit(
     }
 }
 
+// Packed splat storage variants: positions are decoded from PackedSplat + chunk header.
+// Packed scenes are view-only, so there are no edit-state variants.
+[[kernel]]
+void countingSortHistogramPacked(
+    constant PackedSplat* packedSplats [[buffer(0)]],
+    device atomic_uint* histogram [[buffer(1)]],
+    constant CountingSortParams& params [[buffer(2)]],
+    constant float3& cameraPosition [[buffer(3)]],
+    constant float3& cameraForward [[buffer(4)]],
+    constant bool& sortByDistance [[buffer(5)]],
+    device ushort* cachedBins [[buffer(6)]],
+    constant ChunkHeader* chunkHeaders [[buffer(7)]],
+    uint tid [[thread_position_in_grid]],
+    uint threadCount [[threads_per_grid]]
+) {
+    for (uint i = tid; i < params.splatCount; i += threadCount) {
+        float3 delta = packedSplatPosition(packedSplats, chunkHeaders, i) - cameraPosition;
+        float depth = sortByDistance ? length(delta) : dot(delta, cameraForward);
+
+        float normalizedDepth = (depth - params.minDepth) * params.invRange;
+        uint bin = clamp(uint(normalizedDepth), 0u, params.binCount - 1);
+        bin = params.binCount - 1 - bin;
+
+        cachedBins[i] = ushort(bin);
+
+        atomic_fetch_add_explicit(&histogram[bin], 1, memory_order_relaxed);
+    }
+}
+
+[[kernel]]
+void countingSortHistogramWeightedPacked(
+    constant PackedSplat* packedSplats [[buffer(0)]],
+    device atomic_uint* histogram [[buffer(1)]],
+    constant CountingSortParams& params [[buffer(2)]],
+    constant float3& cameraPosition [[buffer(3)]],
+    constant float3& cameraForward [[buffer(4)]],
+    constant bool& sortByDistance [[buffer(5)]],
+    device ushort* cachedBins [[buffer(6)]],
+    constant CameraRelativeBinParams& binParams [[buffer(7)]],
+    constant ChunkHeader* chunkHeaders [[buffer(8)]],
+    uint tid [[thread_position_in_grid]],
+    uint threadCount [[threads_per_grid]]
+) {
+    for (uint i = tid; i < params.splatCount; i += threadCount) {
+        float3 delta = packedSplatPosition(packedSplats, chunkHeaders, i) - cameraPosition;
+        float depth = sortByDistance ? length(delta) : dot(delta, cameraForward);
+
+        float normalizedDist = (depth - binParams.minDepth) * binParams.invRange;
+        uint distBin = clamp(uint(normalizedDist), 0u, NUM_DISTANCE_BINS - 1);
+        float binFraction = normalizedDist - float(distBin);
+
+        uint sortKey = binParams.binBase[distBin] + uint(float(binParams.binDivider[distBin]) * binFraction);
+        sortKey = min(sortKey, binParams.totalBuckets - 1);
+
+        uint bin = binParams.totalBuckets - 1 - sortKey;
+
+        cachedBins[i] = ushort(bin);
+
+        atomic_fetch_add_explicit(&histogram[bin], 1, memory_order_relaxed);
+    }
+}
+
 // Legacy version without caching (for compatibility)
 [[kernel]]
 void countingSortHistogramNoCaching(
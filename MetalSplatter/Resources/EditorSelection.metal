@@ -46,6 +46,12 @@ typedef struct
     float distanceSquared;
 } NearestSelectionCandidate;
 
+// Matches MTLDispatchThreadgroupsIndirectArguments
+typedef struct
+{
+    uint threadgroupsPerGrid[3];
+} ThreadgroupsIndirectArguments;
+
 inline float4x4 editorTransformForIndex(const device ushort *transformIndices,
                                         const device float4x4 *transformPalette,
                                         uint index) {
@@ -193,30 +199,22 @@ inline bool projectEditableSplat(float3 worldPosition,
     return true;
 }
 
-kernel void selectEditableSplats(constant Splat *splats [[buffer(0)]],
-                                 const device uchar *states [[buffer(1)]],
-                                 const device ushort *transformIndices [[buffer(2)]],
-                                 const device float4x4 *transformPalette [[buffer(3)]],
-                                 device uint *outputIndices [[buffer(4)]],
-                                 device atomic_uint *outputCount [[buffer(5)]],
-                                 constant SelectionQueryParameters &params [[buffer(6)]],
-                                 texture2d<float, access::read> maskTexture [[texture(0)]],
-                                 uint gid [[thread_position_in_grid]]) {
-    if (gid >= params.splatCount) {
-        return;
-    }
-
-    uint state = states[gid];
+inline bool editableSplatMatchesQuery(constant Splat *splats,
+                                      const device uchar *states,
+                                      const device ushort *transformIndices,
+                                      const device float4x4 *transformPalette,
+                                      constant SelectionQueryParameters &params,
+                                      texture2d<float, access::read> maskTexture,
+                                      uint index) {
+    uint state = states[index];
     if (!isSelectableEditorState(state)) {
-        return;
+        return false;
     }
 
     float3 worldPosition;
     packed_half3 covA;
     packed_half3 covB;
-    editableWorldState(splats[gid], transformIndices, transformPalette, gid, worldPosition, covA, covB);
-
-    bool selected = false;
+    editableWorldState(splats[index], transformIndices, transformPalette, index, worldPosition, covA, covB);
 
     switch (params.mode) {
         case SelectionModePoint:
@@ -225,17 +223,16 @@ kernel void selectEditableSplats(constant Splat *splats [[buffer(0)]],
             float2 normalized;
             float distanceSquared = 0.0f;
             float projectedRadius = 0.0f;
-            if (projectEditableSplat(worldPosition, covA, covB, params, normalized, distanceSquared, projectedRadius)) {
-                if (params.mode == SelectionModePoint) {
-                    float effectiveRadius = params.pointRadius + projectedRadius;
-                    selected = distanceSquared <= effectiveRadius * effectiveRadius;
-                } else if (params.mode == SelectionModeRect) {
-                    selected = rectContainsCircle(normalized, projectedRadius, params.rect);
-                } else {
-                    selected = maskContainsProjectedCircle(maskTexture, params, normalized, projectedRadius);
-                }
+            if (!projectEditableSplat(worldPosition, covA, covB, params, normalized, distanceSquared, projectedRadius)) {
+                return false;
             }
-            break;
+            if (params.mode == SelectionModePoint) {
+                float effectiveRadius = params.pointRadius + projectedRadius;
+                return distanceSquared <= effectiveRadius * effectiveRadius;
+            } else if (params.mode == SelectionModeRect) {
+                return rectContainsCircle(normalized, projectedRadius, params.rect);
+            }
+            return maskContainsProjectedCircle(maskTexture, params, normalized, projectedRadius);
         }
         case SelectionModeSphere: {
             float3x3 covariance3D = float3x3(
@@ -244,8 +241,7 @@ kernel void selectEditableSplats(constant Splat *splats [[buffer(0)]],
                 covA.z, covB.y, covB.z
             );
             float extent = visibleFootprintExtent(covariance3D, worldPosition - params.sphereCenter);
-            selected = distance(worldPosition, params.sphereCenter) <= params.sphereRadius + extent;
-            break;
+            return distance(worldPosition, params.sphereCenter) <= params.sphereRadius + extent;
         }
         case SelectionModeBox: {
             float3x3 covariance3D = float3x3(
@@ -257,20 +253,88 @@ kernel void selectEditableSplats(constant Splat *splats [[buffer(0)]],
             float extentY = visibleFootprintExtent(covariance3D, float3(0, 1, 0));
             float extentZ = visibleFootprintExtent(covariance3D, float3(0, 0, 1));
             float3 delta = abs(worldPosition - params.boxCenter);
-            selected = all(delta <= params.boxExtents + float3(extentX, extentY, extentZ));
-            break;
+            return all(delta <= params.boxExtents + float3(extentX, extentY, extentZ));
         }
         default:
-            selected = false;
-            break;
+            return false;
     }
+}
 
-    if (selected) {
+kernel void selectEditableSplats(constant Splat *splats [[buffer(0)]],
+                                 const device uchar *states [[buffer(1)]],
+                                 const device ushort *transformIndices [[buffer(2)]],
+                                 const device float4x4 *transformPalette [[buffer(3)]],
+                                 device uint *outputIndices [[buffer(4)]],
+                                 device atomic_uint *outputCount [[buffer(5)]],
+                                 constant SelectionQueryParameters &params [[buffer(6)]],
+                                 texture2d<float, access::read> maskTexture [[texture(0)]],
+                                 uint gid [[thread_position_in_grid]]) {
+    if (gid >= params.splatCount) {
+        return;
+    }
+
+    if (editableSplatMatchesQuery(splats, states, transformIndices, transformPalette, params, maskTexture, gid)) {
         uint outputIndex = atomic_fetch_add_explicit(outputCount, 1, memory_order_relaxed);
         outputIndices[outputIndex] = gid;
     }
 }
 
+// Whether a selectable splat's footprint reaches the query point, and its squared distance when it does
+inline bool nearestEditableSplatDistance(constant Splat *splats,
+                                         const device uchar *states,
+                                         const device ushort *transformIndices,
+                                         const device float4x4 *transformPalette,
+                                         constant SelectionQueryParameters &params,
+                                         uint index,
+                                         thread float &distanceSquared) {
+    uint state = states[index];
+    if (!isSelectableEditorState(state)) {
+        return false;
+    }
+
+    float3 worldPosition;
+    packed_half3 covA;
+    packed_half3 covB;
+    editableWorldState(splats[index], transformIndices, transformPalette, index, worldPosition, covA, covB);
+    float2 normalized;
+    float projectedRadius = 0.0f;
+    if (!projectEditableSplat(worldPosition, covA, covB, params, normalized, distanceSquared, projectedRadius)) {
+        return false;
+    }
+    float effectiveRadius = params.pointRadius + projectedRadius;
+    return distanceSquared <= effectiveRadius * effectiveRadius;
+}
+
+// Reduces each thread's candidate to the threadgroup's nearest, ties going to the lower thread
+inline NearestSelectionCandidate reduceNearestCandidate(threadgroup float *localDistances,
+                                                        threadgroup int *localIndices,
+                                                        float distanceSquared,
+                                                        int index,
+                                                        uint tid,
+                                                        uint threadCount) {
+    localDistances[tid] = distanceSquared;
+    localIndices[tid] = index;
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    uint reductionWidth = 1;
+    while (reductionWidth * 2 <= threadCount) {
+        reductionWidth *= 2;
+    }
+
+    for (uint stride = reductionWidth / 2; stride > 0; stride >>= 1) {
+        if (tid < stride && localDistances[tid + stride] < localDistances[tid]) {
+            localDistances[tid] = localDistances[tid + stride];
+            localIndices[tid] = localIndices[tid + stride];
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+    }
+
+    NearestSelectionCandidate nearest;
+    nearest.index = localIndices[0];
+    nearest.distanceSquared = localDistances[0];
+    return nearest;
+}
+
 [[kernel, max_total_threads_per_threadgroup(256)]]
 kernel void pickNearestEditableSplat(constant Splat *splats [[buffer(0)]],
                                      const device uchar *states [[buffer(1)]],
@@ -285,48 +349,674 @@ kernel void pickNearestEditableSplat(constant Splat *splats [[buffer(0)]],
     threadgroup float localDistances[256];
     threadgroup int localIndices[256];
 
-    float bestDistanceSquared = INFINITY;
-    int bestIndex = -1;
+    float distanceSquared = INFINITY;
+    int index = -1;
+    if (gid < params.splatCount &&
+        nearestEditableSplatDistance(splats, states, transformIndices, transformPalette, params, gid, distanceSquared)) {
+        index = int(gid);
+    } else {
+        distanceSquared = INFINITY;
+    }
 
-    if (gid < params.splatCount) {
-        uint state = states[gid];
-        if (isSelectableEditorState(state)) {
-            float3 worldPosition;
-            packed_half3 covA;
-            packed_half3 covB;
-            editableWorldState(splats[gid], transformIndices, transformPalette, gid, worldPosition, covA, covB);
-            float2 normalized;
-            float distanceSquared = 0.0f;
-            float projectedRadius = 0.0f;
-            if (projectEditableSplat(worldPosition, covA, covB, params, normalized, distanceSquared, projectedRadius)) {
-                float effectiveRadius = params.pointRadius + projectedRadius;
-                if (distanceSquared <= effectiveRadius * effectiveRadius) {
-                    bestDistanceSquared = distanceSquared;
-                    bestIndex = int(gid);
+    NearestSelectionCandidate nearest = reduceNearestCandidate(localDistances, localIndices,
+                                                               distanceSquared, index, tid, threadCount);
+    if (tid == 0) {
+        candidates[tgid] = nearest;
+    }
+}
+
+// MARK: - Spatial hash selection
+//
+// Flood fill and outlier selection bucket candidate splats into grid cells keyed by the cell's Morton code. The
+// (key, index) entries are sorted by key, so each cell is a contiguous range of entries found by binary search.
+// Entries that aren't candidates get SpatialHashEmptyKey and sort to the end.
+
+constant uint EditableSplatStateSelected = 1u << 0;
+constant uint SpatialHashEmptyKey = 0xFFFFFFFFu;
+// Flood fill cells are offset so footprints hanging off the top or left of the viewport keep positive coordinates
+constant int FloodFillCellOffset = 1024;
+// Neighborhood half-width in cells a fill step searches, bounding each thread's work at 33x33 cell lookups. A
+// footprint wider than that reaches farther only through its neighbors. Keep in sync with
+// EditableSplatStore.floodFillMaxCellRange, which caps the CPU fill the same way.
+constant int FloodFillMaxCellRange = 16;
+
+// Same layout as MortonCodeOutput, so both sort with the same key sorter
+typedef struct
+{
+    uint key;
+    uint index;
+} SpatialHashEntry;
+
+typedef struct
+{
+    uint splatCount;
+    uint seedIndex;
+    float threshold;
+    uint threadgroupWidth;
+} FloodFillParameters;
+
+typedef struct
+{
+    uint frontierStart;
+    uint frontierEnd;
+    float cellSize;
+    uint padding;
+} FloodFillState;
+
+// Bounds in the stored, gamma-expanded color space; see SplatSelectionEngine.storedColorMatchBounds
+typedef struct
+{
+    float3 lower;
+    float3 upper;
+    uint splatCount;
+} ColorMatchParameters;
+
+typedef struct
+{
+    float3 origin;
+    uint splatCount;
+    uint selectionOnly;
+    float voxelSize;
+    float scaleReference;
+    float largeSplatPenalty;
+    float minimumOpacityWeight;
+} OutlierParameters;
+
+// minimum.w carries the threadgroup's scale sum and maximum.w its candidate count
+typedef struct
+{
+    float4 minimum;
+    float4 maximum;
+} OutlierCandidatePartial;
+
+typedef struct
+{
+    uint key;
+    uint start;
+    uint count;
+    float score;
+} OutlierVoxelCell;
+
+inline uint spatialHashExpandBits2(uint v) {
+    uint x = v & 0xFFFFu;
+    x = (x | (x << 8)) & 0x00FF00FFu;
+    x = (x | (x << 4)) & 0x0F0F0F0Fu;
+    x = (x | (x << 2)) & 0x33333333u;
+    x = (x | (x << 1)) & 0x55555555u;
+    return x;
+}
+
+inline uint spatialHashExpandBits3(uint v) {
+    uint x = v & 0x3FFu;
+    x = (x | (x << 16)) & 0x030000FFu;
+    x = (x | (x << 8)) & 0x0300F00Fu;
+    x = (x | (x << 4)) & 0x030C30C3u;
+    x = (x | (x << 2)) & 0x09249249u;
+    return x;
+}
+
+inline int2 floodFillCell(float2 normalized, float cellSize) {
+    return int2(floor(normalized / cellSize));
+}
+
+inline uint floodFillCellKey(int2 cell) {
+    // 65534 keeps the largest key below SpatialHashEmptyKey
+    uint2 clamped = uint2(clamp(cell + int2(FloodFillCellOffset), int2(0), int2(65534)));
+    return spatialHashExpandBits2(clamped.x) | (spatialHashExpandBits2(clamped.y) << 1);
+}
+
+// The entries [start, end) whose key is `key`
+inline uint2 spatialHashCellRange(const device SpatialHashEntry *entries, uint count, uint key) {
+    uint low = 0;
+    uint high = count;
+    while (low < high) {
+        uint mid = (low + high) >> 1;
+        if (entries[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    uint start = low;
+    high = count;
+    while (low < high) {
+        uint mid = (low + high) >> 1;
+        if (entries[mid].key <= key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return uint2(start, low);
+}
+
+inline bool isOutlierCandidateState(uint state, uint selectionOnly) {
+    return isSelectableEditorState(state) && (selectionOnly == 0u || (state & EditableSplatStateSelected) != 0u);
+}
+
+// Largest scale axis: the square root of the covariance's largest eigenvalue (closed form for symmetric 3x3)
+inline float representativeSplatScale(packed_half3 covA, packed_half3 covB) {
+    float a = covA.x, b = covA.y, c = covA.z;
+    float d = covB.x, e = covB.y, f = covB.z;
+    float offDiagonal = b * b + c * c + e * e;
+    if (offDiagonal <= 1e-12f) {
+        return sqrt(max(max(a, d), max(f, 0.0f)));
+    }
+    float q = (a + d + f) / 3.0f;
+    float p2 = (a - q) * (a - q) + (d - q) * (d - q) + (f - q) * (f - q) + 2.0f * offDiagonal;
+    float p = sqrt(p2 / 6.0f);
+    float ba = (a - q) / p, bb = b / p, bc = c / p;
+    float bd = (d - q) / p, be = e / p, bf = (f - q) / p;
+    float determinant = ba * (bd * bf - be * be) - bb * (bb * bf - be * bc) + bc * (bb * be - bd * bc);
+    float phi = acos(clamp(determinant * 0.5f, -1.0f, 1.0f)) / 3.0f;
+    return sqrt(max(q + 2.0f * p * cos(phi), 0.0f));
+}
+
+// Projects every selectable splat: (normalized.xy, footprint radius, opacity), or radius -1 when it isn't visible
+kernel void projectFloodFillCandidates(constant Splat *splats [[buffer(0)]],
+                                       const device uchar *states [[buffer(1)]],
+                                       const device ushort *transformIndices [[buffer(2)]],
+                                       const device float4x4 *transformPalette [[buffer(3)]],
+                                       device float4 *candidates [[buffer(4)]],
+                                       constant SelectionQueryParameters &params [[buffer(5)]],
+                                       constant FloodFillParameters &floodParams [[buffer(6)]],
+                                       uint gid [[thread_position_in_grid]]) {
+    if (gid >= floodParams.splatCount) {
+        return;
+    }
+
+    float4 candidate = float4(0.0f, 0.0f, -1.0f, 0.0f);
+    if (isSelectableEditorState(states[gid])) {
+        float3 worldPosition;
+        packed_half3 covA;
+        packed_half3 covB;
+        editableWorldState(splats[gid], transformIndices, transformPalette, gid, worldPosition, covA, covB);
+        float2 normalized;
+        float distanceSquared = 0.0f;
+        float projectedRadius = 0.0f;
+        if (projectEditableSplat(worldPosition, covA, covB, params, normalized, distanceSquared, projectedRadius)) {
+            candidate = float4(normalized, projectedRadius, float(unpackSplatColor(splats[gid].packedColor).a));
+        }
+    }
+    candidates[gid] = candidate;
+}
+
+// Keys each candidate by its cell, sized from the seed's footprint, and seeds the fill with the seed splat.
+// `visited` and `resultCount` must be zeroed beforehand.
+kernel void assignFloodFillCells(const device float4 *candidates [[buffer(0)]],
+                                 device SpatialHashEntry *entries [[buffer(1)]],
+                                 device FloodFillState *state [[buffer(2)]],
+                                 device atomic_uint *visited [[buffer(3)]],
+                                 device uint *result [[buffer(4)]],
+                                 device atomic_uint *resultCount [[buffer(5)]],
+                                 constant FloodFillParameters &floodParams [[buffer(6)]],
+                                 uint gid [[thread_position_in_grid]]) {
+    if (gid >= floodParams.splatCount) {
+        return;
+    }
+
+    float4 seed = candidates[floodParams.seedIndex];
+    float cellSize = max(seed.z * 1.5f, 0.01f);
+    if (gid == 0) {
+        state->frontierStart = 0;
+        state->frontierEnd = 0;
+        state->cellSize = cellSize;
+        if (seed.z >= 0.0f) {
+            atomic_store_explicit(&visited[floodParams.seedIndex], 1u, memory_order_relaxed);
+            result[0] = floodParams.seedIndex;
+            atomic_store_explicit(resultCount, 1u, memory_order_relaxed);
+        }
+    }
+
+    float4 candidate = candidates[gid];
+    bool keyed = seed.z >= 0.0f && candidate.z >= 0.0f;
+    entries[gid].key = keyed ? floodFillCellKey(floodFillCell(candidate.xy, cellSize)) : SpatialHashEmptyKey;
+    entries[gid].index = gid;
+}
+
+// Makes the splats found by the last expansion the next frontier and sizes its indirect dispatch
+kernel void advanceFloodFillFrontier(device FloodFillState *state [[buffer(0)]],
+                                     device atomic_uint *resultCount [[buffer(1)]],
+                                     device ThreadgroupsIndirectArguments *dispatchArguments [[buffer(2)]],
+                                     constant FloodFillParameters &floodParams [[buffer(3)]],
+                                     uint gid [[thread_position_in_grid]]) {
+    if (gid != 0) {
+        return;
+    }
+    state->frontierStart = state->frontierEnd;
+    state->frontierEnd = atomic_load_explicit(resultCount, memory_order_relaxed);
+    uint frontierSize = state->frontierEnd - state->frontierStart;
+    uint width = max(floodParams.threadgroupWidth, 1u);
+    dispatchArguments->threadgroupsPerGrid[0] = (frontierSize + width - 1) / width;
+    dispatchArguments->threadgroupsPerGrid[1] = 1;
+    dispatchArguments->threadgroupsPerGrid[2] = 1;
+}
+
+// One breadth-first step: each frontier splat claims unvisited neighbors whose footprints touch its own and whose
+// opacity is within the threshold, appending them to the result
+kernel void expandFloodFillFrontier(const device SpatialHashEntry *entries [[buffer(0)]],
+                                    const device float4 *candidates [[buffer(1)]],
+                                    device atomic_uint *visited [[buffer(2)]],
+                                    device uint *result [[buffer(3)]],
+                                    device atomic_uint *resultCount [[buffer(4)]],
+                                    const device FloodFillState &state [[buffer(5)]],
+                                    constant FloodFillParameters &floodParams [[buffer(6)]],
+                                    uint gid [[thread_position_in_grid]]) {
+    if (gid >= state.frontierEnd - state.frontierStart) {
+        return;
+    }
+
+    float4 current = candidates[result[state.frontierStart + gid]];
+    float cellSize = state.cellSize;
+    float searchRadius = max(current.z * 2.5f, cellSize);
+    int cellRange = clamp(int(ceil(searchRadius / cellSize)), 1, FloodFillMaxCellRange);
+    int2 currentCell = floodFillCell(current.xy, cellSize);
+
+    for (int deltaY = -cellRange; deltaY <= cellRange; ++deltaY) {
+        for (int deltaX = -cellRange; deltaX <= cellRange; ++deltaX) {
+            uint key = floodFillCellKey(currentCell + int2(deltaX, deltaY));
+            uint2 range = spatialHashCellRange(entries, floodParams.splatCount, key);
+            for (uint entry = range.x; entry < range.y; ++entry) {
+                uint neighborIndex = entries[entry].index;
+                if (atomic_load_explicit(&visited[neighborIndex], memory_order_relaxed) != 0u) {
+                    continue;
+                }
+                float4 neighbor = candidates[neighborIndex];
+                if (abs(neighbor.w - current.w) > floodParams.threshold) {
+                    continue;
+                }
+                float combinedRadius = max(searchRadius, neighbor.z * 2.5f);
+                if (distance(current.xy, neighbor.xy) > combinedRadius) {
+                    continue;
+                }
+                if (atomic_exchange_explicit(&visited[neighborIndex], 1u, memory_order_relaxed) == 0u) {
+                    uint slot = atomic_fetch_add_explicit(resultCount, 1u, memory_order_relaxed);
+                    result[slot] = neighborIndex;
                 }
             }
         }
     }
+}
+
+// Selectable splats whose stored color lies within the bounds on every channel, a conservative superset of those
+// whose linear color is within the threshold of the reference
+kernel void selectColorMatchSplats(constant Splat *splats [[buffer(0)]],
+                                   const device uchar *states [[buffer(1)]],
+                                   device uint *outputIndices [[buffer(2)]],
+                                   device atomic_uint *outputCount [[buffer(3)]],
+                                   constant ColorMatchParameters &params [[buffer(4)]],
+                                   uint gid [[thread_position_in_grid]]) {
+    if (gid >= params.splatCount || !isSelectableEditorState(states[gid])) {
+        return;
+    }
+
+    float3 color = float3(unpackSplatColor(splats[gid].packedColor).rgb);
+    if (all(color >= params.lower) && all(color <= params.upper)) {
+        uint outputIndex = atomic_fetch_add_explicit(outputCount, 1, memory_order_relaxed);
+        outputIndices[outputIndex] = gid;
+    }
+}
+
+// Per-threadgroup bounds, scale sum and count of the outlier candidates
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void reduceOutlierCandidates(constant Splat *splats [[buffer(0)]],
+                                    const device uchar *states [[buffer(1)]],
+                                    const device ushort *transformIndices [[buffer(2)]],
+                                    const device float4x4 *transformPalette [[buffer(3)]],
+                                    device OutlierCandidatePartial *partials [[buffer(4)]],
+                                    constant OutlierParameters &params [[buffer(5)]],
+                                    uint gid [[thread_position_in_grid]],
+                                    uint tid [[thread_index_in_threadgroup]],
+                                    uint tgid [[threadgroup_position_in_grid]],
+                                    uint threadCount [[threads_per_threadgroup]]) {
+    threadgroup float4 localMinimum[256];
+    threadgroup float4 localMaximum[256];
+
+    float4 minimum = float4(INFINITY, INFINITY, INFINITY, 0.0f);
+    float4 maximum = float4(-INFINITY, -INFINITY, -INFINITY, 0.0f);
+    if (gid < params.splatCount && isOutlierCandidateState(states[gid], params.selectionOnly)) {
+        float3 worldPosition;
+        packed_half3 covA;
+        packed_half3 covB;
+        editableWorldState(splats[gid], transformIndices, transformPalette, gid, worldPosition, covA, covB);
+        minimum = float4(worldPosition, representativeSplatScale(covA, covB));
+        maximum = float4(worldPosition, 1.0f);
+    }
 
-    localDistances[tid] = bestDistanceSquared;
-    localIndices[tid] = bestIndex;
+    localMinimum[tid] = minimum;
+    localMaximum[tid] = maximum;
     threadgroup_barrier(mem_flags::mem_threadgroup);
 
     uint reductionWidth = 1;
     while (reductionWidth * 2 <= threadCount) {
         reductionWidth *= 2;
     }
+    // Fold threads past the power of two in first
+    if (tid >= reductionWidth) {
+        uint target = tid - reductionWidth;
+        localMinimum[target] = float4(min(localMinimum[target].xyz, localMinimum[tid].xyz),
+                                      localMinimum[target].w + localMinimum[tid].w);
+        localMaximum[target] = float4(max(localMaximum[target].xyz, localMaximum[tid].xyz),
+                                      localMaximum[target].w + localMaximum[tid].w);
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
 
     for (uint stride = reductionWidth / 2; stride > 0; stride >>= 1) {
-        if (tid < stride && localDistances[tid + stride] < localDistances[tid]) {
-            localDistances[tid] = localDistances[tid + stride];
-            localIndices[tid] = localIndices[tid + stride];
+        if (tid < stride) {
+            float4 otherMinimum = localMinimum[tid + stride];
+            float4 otherMaximum = localMaximum[tid + stride];
+            localMinimum[tid] = float4(min(localMinimum[tid].xyz, otherMinimum.xyz), localMinimum[tid].w + otherMinimum.w);
+            localMaximum[tid] = float4(max(localMaximum[tid].xyz, otherMaximum.xyz), localMaximum[tid].w + otherMaximum.w);
         }
         threadgroup_barrier(mem_flags::mem_threadgroup);
     }
 
     if (tid == 0) {
-        candidates[tgid].index = localIndices[0];
-        candidates[tgid].distanceSquared = localDistances[0];
+        partials[tgid].minimum = localMinimum[0];
+        partials[tgid].maximum = localMaximum[0];
+    }
+}
+
+// Keys each outlier candidate by its voxel and computes its density weight
+kernel void computeOutlierVoxelKeys(constant Splat *splats [[buffer(0)]],
+                                    const device uchar *states [[buffer(1)]],
+                                    const device ushort *transformIndices [[buffer(2)]],
+                                    const device float4x4 *transformPalette [[buffer(3)]],
+                                    device SpatialHashEntry *entries [[buffer(4)]],
+                                    device float *weights [[buffer(5)]],
+                                    constant OutlierParameters &params [[buffer(6)]],
+                                    uint gid [[thread_position_in_grid]]) {
+    if (gid >= params.splatCount) {
+        return;
+    }
+
+    entries[gid].index = gid;
+    if (!isOutlierCandidateState(states[gid], params.selectionOnly)) {
+        entries[gid].key = SpatialHashEmptyKey;
+        weights[gid] = 0.0f;
+        return;
+    }
+
+    float3 worldPosition;
+    packed_half3 covA;
+    packed_half3 covB;
+    editableWorldState(splats[gid], transformIndices, transformPalette, gid, worldPosition, covA, covB);
+    uint3 voxel = uint3(clamp(floor((worldPosition - params.origin) / params.voxelSize), 0.0f, 1023.0f));
+    entries[gid].key = spatialHashExpandBits3(voxel.x)
+        | (spatialHashExpandBits3(voxel.y) << 1)
+        | (spatialHashExpandBits3(voxel.z) << 2);
+
+    float oversizeRatio = max(representativeSplatScale(covA, covB) / params.scaleReference - 1.0f, 0.0f);
+    float scaleWeight = 1.0f / (1.0f + max(params.largeSplatPenalty, 0.0f) * oversizeRatio);
+    float opacityWeight = max(float(unpackSplatColor(splats[gid].packedColor).a), params.minimumOpacityWeight);
+    weights[gid] = opacityWeight * scaleWeight;
+}
+
+// Compacts the sorted entries into one record per occupied voxel, summing its weights
+kernel void buildOutlierVoxelCells(const device SpatialHashEntry *entries [[buffer(0)]],
+                                   const device float *weights [[buffer(1)]],
+                                   device OutlierVoxelCell *cells [[buffer(2)]],
+                                   device atomic_uint *cellCount [[buffer(3)]],
+                                   constant uint &entryCount [[buffer(4)]],
+                                   uint gid [[thread_position_in_grid]]) {
+    if (gid >= entryCount) {
+        return;
+    }
+    uint key = entries[gid].key;
+    if (key == SpatialHashEmptyKey || (gid > 0 && entries[gid - 1].key == key)) {
+        return;
+    }
+
+    uint end = gid;
+    float score = 0.0f;
+    while (end < entryCount && entries[end].key == key) {
+        score += weights[entries[end].index];
+        end += 1;
+    }
+    uint cellIndex = atomic_fetch_add_explicit(cellCount, 1u, memory_order_relaxed);
+    cells[cellIndex].key = key;
+    cells[cellIndex].start = gid;
+    cells[cellIndex].count = end - gid;
+    cells[cellIndex].score = score;
+}
+
+// MARK: - Selection clusters
+//
+// Point, rect, mask, sphere and box queries first cull fixed runs of SelectionClusterSize splats against the query,
+// then test only the splats of clusters that survive. Splats are Morton-ordered on load, so runs are spatially
+// compact. A cluster's bounds hold each splat's edited world position padded by SelectionClusterSigmaPadding times
+// its largest standard deviation, which contains the 3D footprints the sphere and box tests use. Screen queries pad
+// the projected bounds by the largest radius projectEditableSplat can give any splat in the cluster, bounded from
+// the variance kept in maximum.w, in that function's units.
+
+constant uint SelectionClusterSize = 256;
+// visibleFootprintExtent's 3 sigma along any direction
+constant float SelectionClusterSigmaPadding = 3.0f;
+// Normalized-screen slack for half-precision covariance and fast-math rounding
+constant float SelectionClusterScreenMargin = 0.002f;
+
+// minimum.w is 1 when any splat in the cluster has an editor transform, maximum.w the largest trace of a splat's
+// world covariance; an empty cluster has minimum > maximum
+typedef struct
+{
+    float4 minimum;
+    float4 maximum;
+} SelectionCluster;
+
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void buildSelectionClusters(constant Splat *splats [[buffer(0)]],
+                                   const device ushort *transformIndices [[buffer(1)]],
+                                   const device float4x4 *transformPalette [[buffer(2)]],
+                                   device SelectionCluster *clusters [[buffer(3)]],
+                                   const device uint *clusterIndices [[buffer(4)]],
+                                   constant uint &splatCount [[buffer(5)]],
+                                   uint tid [[thread_index_in_threadgroup]],
+                                   uint tgid [[threadgroup_position_in_grid]],
+                                   uint simdLane [[thread_index_in_simdgroup]],
+                                   uint simdGroup [[simdgroup_index_in_threadgroup]],
+                                   uint simdGroupCount [[simdgroups_per_threadgroup]]) {
+    threadgroup float4 groupMinimum[32];
+    threadgroup float4 groupMaximum[32];
+
+    uint clusterIndex = clusterIndices[tgid];
+    uint index = clusterIndex * SelectionClusterSize + tid;
+    float3 minimum = float3(INFINITY);
+    float3 maximum = float3(-INFINITY);
+    float transformed = 0.0f;
+    float varianceTrace = 0.0f;
+    if (index < splatCount) {
+        float3 worldPosition;
+        packed_half3 covA;
+        packed_half3 covB;
+        editableWorldState(splats[index], transformIndices, transformPalette, index, worldPosition, covA, covB);
+        // The trace bounds the largest eigenvalue, so the padding is isotropic whatever the splat's orientation
+        varianceTrace = max(float(covA.x) + float(covB.x) + float(covB.z), 0.0f);
+        float padding = sqrt(varianceTrace) * SelectionClusterSigmaPadding;
+        minimum = worldPosition - padding;
+        maximum = worldPosition + padding;
+        transformed = transformIndices[index] != 0u ? 1.0f : 0.0f;
+    }
+
+    minimum = simd_min(minimum);
+    maximum = simd_max(maximum);
+    transformed = simd_max(transformed);
+    varianceTrace = simd_max(varianceTrace);
+    if (simdLane == 0) {
+        groupMinimum[simdGroup] = float4(minimum, transformed);
+        groupMaximum[simdGroup] = float4(maximum, varianceTrace);
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    if (tid == 0) {
+        float4 clusterMinimum = groupMinimum[0];
+        float4 clusterMaximum = groupMaximum[0];
+        for (uint group = 1; group < simdGroupCount; ++group) {
+            clusterMinimum = min(clusterMinimum, groupMinimum[group]);
+            clusterMinimum.w = max(clusterMinimum.w, groupMinimum[group].w);
+            clusterMaximum = max(clusterMaximum, groupMaximum[group]);
+        }
+        clusters[clusterIndex].minimum = clusterMinimum;
+        clusters[clusterIndex].maximum = clusterMaximum;
+    }
+}
+
+// Conservative: false only when no splat in the cluster can match the query
+inline bool selectionClusterMayMatch(SelectionCluster cluster, constant SelectionQueryParameters &params) {
+    float3 minimum = cluster.minimum.xyz;
+    float3 maximum = cluster.maximum.xyz;
+    if (any(minimum > maximum)) {
+        return false;
+    }
+
+    switch (params.mode) {
+        case SelectionModeSphere: {
+            float3 closest = clamp(params.sphereCenter, minimum, maximum);
+            return distance(closest, params.sphereCenter) <= params.sphereRadius;
+        }
+        case SelectionModeBox:
+            return all(minimum <= params.boxCenter + params.boxExtents) &&
+                   all(maximum >= params.boxCenter - params.boxExtents);
+        default:
+            break;
+    }
+
+    // The box holds every splat center; their screen bounds are those of its projected corners while it is entirely
+    // in front of the camera
+    float2 screenMinimum = float2(INFINITY);
+    float2 screenMaximum = float2(-INFINITY);
+    float nearestDepth = INFINITY;
+    float2 largestSlope = float2(0.0f);
+    uint cornersBehind = 0;
+    for (uint corner = 0; corner < 8; ++corner) {
+        float3 position = select(minimum, maximum, bool3(corner & 1u, corner & 2u, corner & 4u));
+        float4 viewPosition = params.viewMatrix * float4(position, 1.0f);
+        if (viewPosition.z >= -kDivisionEpsilon) {
+            cornersBehind += 1;
+            continue;
+        }
+        float4 clipPosition = params.projectionMatrix * float4(viewPosition.xyz, 1.0f);
+        float2 ndc = clipPosition.xy / clipPosition.w;
+        float2 normalized = float2(ndc.x * 0.5f + 0.5f, 0.5f - ndc.y * 0.5f);
+        screenMinimum = min(screenMinimum, normalized);
+        screenMaximum = max(screenMaximum, normalized);
+        nearestDepth = min(nearestDepth, -viewPosition.z);
+        largestSlope = max(largestSlope, abs(viewPosition.xy / viewPosition.z));
+    }
+    if (cornersBehind == 8) {
+        return false;
+    }
+    if (cornersBehind > 0) {
+        return true;
+    }
+
+    // Bound projectEditableSplat's radius, 3 * sqrt(trace(cov2D)), over the cluster: trace(J W cov W^T J^T) is at most
+    // |J|^2 |W|^2 trace(cov) in Frobenius norms. Depth and the x/y slopes of a linear-fractional map over the box
+    // peak at its corners, and calcCovariance2D clamps the slopes to 1.3 tan(fov/2).
+    float3x3 viewRotation = float3x3(params.viewMatrix[0].xyz, params.viewMatrix[1].xyz, params.viewMatrix[2].xyz);
+    float viewScaleSquared = dot(viewRotation[0], viewRotation[0]) +
+                             dot(viewRotation[1], viewRotation[1]) +
+                             dot(viewRotation[2], viewRotation[2]);
+    float varianceTrace = max(cluster.maximum.w, 0.0f);
+    float jacobianSquared;
+    if (params.isOrthographic != 0u) {
+        jacobianSquared = params.focalX * params.focalX + params.focalY * params.focalY;
+    } else {
+        float2 slope = min(largestSlope, 1.3f * float2(params.tanHalfFovX, params.tanHalfFovY));
+        float inverseDepth = 1.0f / max(nearestDepth, kDivisionEpsilon);
+        jacobianSquared = (params.focalX * params.focalX * (1.0f + slope.x * slope.x) +
+                           params.focalY * params.focalY * (1.0f + slope.y * slope.y)) * inverseDepth * inverseDepth;
+    }
+    float pixelRadius = float(kBoundsRadius) *
+        sqrt(jacobianSquared * viewScaleSquared * varianceTrace + 2.0f * max(params.covarianceBlur, 0.0f));
+    // In projectEditableSplat's units: pixels over the shorter screen side, applied to both normalized axes
+    float screenPadding = max(pixelRadius / float(max(min(params.screenSize.x, params.screenSize.y), 1u)), 0.008f) +
+                          SelectionClusterScreenMargin;
+
+    screenMinimum -= screenPadding;
+    screenMaximum += screenPadding;
+    float4 rect = float4(0.0f, 0.0f, 1.0f, 1.0f);
+    if (params.mode == SelectionModePoint) {
+        rect = float4(params.point - params.pointRadius, params.point + params.pointRadius);
+    } else if (params.mode == SelectionModeRect) {
+        rect = params.rect;
+    }
+    return screenMaximum.x >= rect.x && screenMaximum.y >= rect.y &&
+           screenMinimum.x <= rect.z && screenMinimum.y <= rect.w;
+}
+
+kernel void cullSelectionClusters(const device SelectionCluster *clusters [[buffer(0)]],
+                                  constant SelectionQueryParameters &params [[buffer(1)]],
+                                  device uint *survivors [[buffer(2)]],
+                                  device atomic_uint *survivorCount [[buffer(3)]],
+                                  constant uint &clusterCount [[buffer(4)]],
+                                  uint gid [[thread_position_in_grid]]) {
+    if (gid >= clusterCount || !selectionClusterMayMatch(clusters[gid], params)) {
+        return;
+    }
+    uint slot = atomic_fetch_add_explicit(survivorCount, 1, memory_order_relaxed);
+    survivors[slot] = gid;
+}
+
+// One threadgroup per surviving cluster
+kernel void prepareSelectionClusterDispatch(const device uint *survivorCount [[buffer(0)]],
+                                            device ThreadgroupsIndirectArguments *dispatchArguments [[buffer(1)]]) {
+    dispatchArguments->threadgroupsPerGrid[0] = survivorCount[0];
+    dispatchArguments->threadgroupsPerGrid[1] = 1;
+    dispatchArguments->threadgroupsPerGrid[2] = 1;
+}
+
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void selectEditableSplatsInClusters(constant Splat *splats [[buffer(0)]],
+                                           const device uchar *states [[buffer(1)]],
+                                           const device ushort *transformIndices [[buffer(2)]],
+                                           const device float4x4 *transformPalette [[buffer(3)]],
+                                           device uint *outputIndices [[buffer(4)]],
+                                           device atomic_uint *outputCount [[buffer(5)]],
+                                           constant SelectionQueryParameters &params [[buffer(6)]],
+                                           const device uint *survivors [[buffer(7)]],
+                                           texture2d<float, access::read> maskTexture [[texture(0)]],
+                                           uint tid [[thread_index_in_threadgroup]],
+                                           uint tgid [[threadgroup_position_in_grid]]) {
+    uint index = survivors[tgid] * SelectionClusterSize + tid;
+    if (index >= params.splatCount) {
+        return;
+    }
+
+    if (editableSplatMatchesQuery(splats, states, transformIndices, transformPalette, params, maskTexture, index)) {
+        uint outputIndex = atomic_fetch_add_explicit(outputCount, 1, memory_order_relaxed);
+        outputIndices[outputIndex] = index;
+    }
+}
+
+// candidates[i] is the nearest splat in the cluster survivors[i]
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void pickNearestEditableSplatInClusters(constant Splat *splats [[buffer(0)]],
+                                               const device uchar *states [[buffer(1)]],
+                                               const device ushort *transformIndices [[buffer(2)]],
+                                               const device float4x4 *transformPalette [[buffer(3)]],
+                                               device NearestSelectionCandidate *candidates [[buffer(4)]],
+                                               constant SelectionQueryParameters &params [[buffer(5)]],
+                                               const device uint *survivors [[buffer(6)]],
+                                               uint tid [[thread_index_in_threadgroup]],
+                                               uint tgid [[threadgroup_position_in_grid]],
+                                               uint threadCount [[threads_per_threadgroup]]) {
+    threadgroup float localDistances[256];
+    threadgroup int localIndices[256];
+
+    uint splatIndex = survivors[tgid] * SelectionClusterSize + tid;
+    float distanceSquared = INFINITY;
+    int index = -1;
+    if (splatIndex < params.splatCount &&
+        nearestEditableSplatDistance(splats, states, transformIndices, transformPalette, params, splatIndex,
+                                     distanceSquared)) {
+        index = int(splatIndex);
+    } else {
+        distanceSquared = INFINITY;
+    }
+
+    NearestSelectionCandidate nearest = reduceNearestCandidate(localDistances, localIndices,
+                                                               distanceSquared, index, tid, threadCount);
+    if (tid == 0) {
+        candidates[tgid] = nearest;
     }
 }
@@ -20,6 +20,7 @@ extern constant bool HAS_SH_BAND_3;
 
 constant constexpr int FastSHBufferIndexPalette = 7;
 constant constexpr int FastSHBufferIndexParams = 8;
+constant constexpr int FastSHBufferIndexCachedColors = 9;
 
 struct FastSHParams {
     uint coeffsPerEntry;
@@ -57,9 +58,47 @@ inline float3 rotateVectorByQuaternion(float4 q, float3 v) {
     return v + s * t + cross(u, t);
 }
 
+// View-dependent color of a splat with SH, seen from cameraPosition: SH-evaluated RGB and the base alpha,
+// before the animation tint
+inline half4 evaluateSplatSHColor(SplatSH splatSH,
+                                  float3 cameraPosition,
+                                  device const half3* shPalette,
+                                  constant FastSHParams& params) {
+    device const half3* coeffs = shPalette + params.coeffsPerEntry * splatSH.shPaletteIndex;
+
+    float3 worldPosition = float3(splatSH.position);
+    float3 viewDirection = normalize(cameraPosition - worldPosition);
+
+    // Rotate view direction into the Gaussian's local frame
+    float4 q = splatSH.rotation;
+    float4 qConjugate = float4(-q.xyz, q.w);
+
+    float3 localDirection = normalize(rotateVectorByQuaternion(qConjugate, viewDirection));
+
+    half4 shColor = evaluateSHHalf(localDirection, coeffs, params.degree);
+    // Preserve original alpha from base color, combine with SH-evaluated RGB
+    return half4(shColor.rgb, unpackSplatColor(splatSH.packedBaseColor).a);
+}
+
+inline bool splatHasSH(SplatSH splatSH, constant FastSHParams& params) {
+    const uint invalidIndex = 0xffffffffu;
+    return (splatSH.shDegree > 0) &&
+           (params.coeffsPerEntry > 0) &&
+           (splatSH.shPaletteIndex != invalidIndex) &&
+           (splatSH.shPaletteIndex < params.paletteSize);
+}
+
+inline uint tintedSplatColor(half4 color, float4 tint) {
+    half4 tintColor = half4(tint);
+    return pack_half_to_unorm4x8(half4(color.rgb * tintColor.rgb, color.a * tintColor.a));
+}
+
+// cachedColors, when set, holds each splat's color from evaluateVisibleSplatSH and replaces inline evaluation
 Splat evaluateSplatWithSH(SplatSH splatSH,
+                         uint splatID,
                          Uniforms uniforms,
                          device const half3* shPalette,
+                         device const uint* cachedColors,
                          constant FastSHParams& params) {
     Splat splat;
     splat.position = splatSH.position;
@@ -69,40 +108,17 @@ Splat evaluateSplatWithSH(SplatSH splatSH,
     // Skip SH evaluation if flag is set (camera hasn't moved enough to warrant update)
     // This reuses cached base colors from previous evaluation
     if (params.skipSHEvaluation != 0) {
-        half4 baseColor = unpackSplatColor(splatSH.packedBaseColor);
-        half4 tintColor = half4(splatSH.tintColor);
-        splat.packedColor = pack_half_to_unorm4x8(half4(baseColor.rgb * tintColor.rgb, baseColor.a * tintColor.a));
+        splat.packedColor = tintedSplatColor(unpackSplatColor(splatSH.packedBaseColor), splatSH.tintColor);
         return splat;
     }
 
-    const uint invalidIndex = 0xffffffffu;
-    bool hasSH = (splatSH.shDegree > 0) &&
-                 (params.coeffsPerEntry > 0) &&
-                 (splatSH.shPaletteIndex != invalidIndex) &&
-                 (splatSH.shPaletteIndex < params.paletteSize);
-
-    if (hasSH) {
-        device const half3* coeffs = shPalette + params.coeffsPerEntry * splatSH.shPaletteIndex;
-
-        float3 worldPosition = float3(splatSH.position);
-        float3 cameraPosition = cameraWorldPosition(uniforms.viewMatrix);
-        float3 viewDirection = normalize(cameraPosition - worldPosition);
-
-        // Rotate view direction into the Gaussian's local frame
-        float4 q = splatSH.rotation;
-        float4 qConjugate = float4(-q.xyz, q.w);
-
-        float3 localDirection = normalize(rotateVectorByQuaternion(qConjugate, viewDirection));
-
-        half4 shColor = evaluateSHHalf(localDirection, coeffs, params.degree);
-        // Preserve original alpha from base color, combine with SH-evaluated RGB
-        half baseAlpha = unpackSplatColor(splatSH.packedBaseColor).a;
-        half4 tintColor = half4(splatSH.tintColor);
-        splat.packedColor = pack_half_to_unorm4x8(half4(shColor.rgb * tintColor.rgb, baseAlpha * tintColor.a));
+    if (cachedColors != nullptr) {
+        splat.packedColor = tintedSplatColor(unpackSplatColor(cachedColors[splatID]), splatSH.tintColor);
+    } else if (splatHasSH(splatSH, params)) {
+        half4 shColor = evaluateSplatSHColor(splatSH, cameraWorldPosition(uniforms.viewMatrix), shPalette, params);
+        splat.packedColor = tintedSplatColor(shColor, splatSH.tintColor);
     } else {
-        half4 baseColor = unpackSplatColor(splatSH.packedBaseColor);
-        half4 tintColor = half4(splatSH.tintColor);
-        splat.packedColor = pack_half_to_unorm4x8(half4(baseColor.rgb * tintColor.rgb, baseColor.a * tintColor.a));
+        splat.packedColor = tintedSplatColor(unpackSplatColor(splatSH.packedBaseColor), splatSH.tintColor);
     }
 
     return splat;
@@ -120,6 +136,7 @@ inline FragmentIn fastSHSplatVertex(uint vertexID,
                                     const device ushort *transformIndices,
                                     const device float4x4 *transformPalette,
                                     device const half3* shPalette,
+                                    device const uint* cachedColors,
                                     constant FastSHParams& params) {
     Uniforms uniforms = uniformsArray.uniforms[min(int(amplificationID), kMaxViewCount - 1)];
     
@@ -136,7 +153,7 @@ inline FragmentIn fastSHSplatVertex(uint vertexID,
     }
 
     // Use sorted index to access splat in depth-sorted order
-    uint actualSplatID = uint(sortedIndices[logicalSplatID]);
+    uint actualSplatID = uint(sortedIndices[uniforms.sortedIndexViewOffset + logicalSplatID]);
     // Defensive guard for transient stale/corrupt sorted indices
     if (actualSplatID >= uniforms.splatCount) {
         FragmentIn out;
@@ -150,7 +167,7 @@ inline FragmentIn fastSHSplatVertex(uint vertexID,
     }
     SplatSH splatSH = splatArray[actualSplatID];
     // Evaluate in Gaussian local frame
-    Splat splat = evaluateSplatWithSH(splatSH, uniforms, shPalette, params);
+    Splat splat = evaluateSplatWithSH(splatSH, actualSplatID, uniforms, shPalette, cachedColors, params);
     uint editState = editStates != nullptr ? editStates[actualSplatID] : 0u;
 
     return splatVertex(splat,
@@ -180,6 +197,7 @@ vertex FragmentIn fastSHSplatVertexShader(uint vertexID [[vertex_id]],
                              nullptr,
                              nullptr,
                              shPalette,
+                             nullptr,
                              params);
 }
 
@@ -204,9 +222,131 @@ vertex FragmentIn fastSHSplatVertexShaderEditing(uint vertexID [[vertex_id]],
                              transformIndices,
                              transformPalette,
                              shPalette,
+                             nullptr,
                              params);
 }
 
+// Variants reading the colors cached by evaluateVisibleSplatSH instead of evaluating SH per vertex
+vertex FragmentIn fastSHCachedSplatVertexShader(uint vertexID [[vertex_id]],
+                                                uint instanceID [[instance_id]],
+                                                ushort amplificationID [[amplification_id]],
+                                                constant SplatSH* splatArray [[ buffer(BufferIndexSplat) ]],
+                                                constant UniformsArray & uniformsArray [[ buffer(BufferIndexUniforms) ]],
+                                                constant int32_t* sortedIndices [[ buffer(BufferIndexSortedIndices) ]],
+                                                constant FastSHParams& params [[ buffer(FastSHBufferIndexParams) ]],
+                                                device const uint* cachedColors [[ buffer(FastSHBufferIndexCachedColors) ]]) {
+    return fastSHSplatVertex(vertexID,
+                             instanceID,
+                             amplificationID,
+                             splatArray,
+                             uniformsArray,
+                             sortedIndices,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             nullptr,
+                             cachedColors,
+                             params);
+}
+
+vertex FragmentIn fastSHCachedSplatVertexShaderEditing(uint vertexID [[vertex_id]],
+                                                       uint instanceID [[instance_id]],
+                                                       ushort amplificationID [[amplification_id]],
+                                                       constant SplatSH* splatArray [[ buffer(BufferIndexSplat) ]],
+                                                       constant UniformsArray & uniformsArray [[ buffer(BufferIndexUniforms) ]],
+                                                       constant int32_t* sortedIndices [[ buffer(BufferIndexSortedIndices) ]],
+                                                       const device uchar *editStates [[ buffer(BufferIndexEditState) ]],
+                                                       const device ushort *transformIndices [[ buffer(BufferIndexTransformIndex) ]],
+                                                       const device float4x4 *transformPalette [[ buffer(BufferIndexTransformPalette) ]],
+                                                       constant FastSHParams& params [[ buffer(FastSHBufferIndexParams) ]],
+                                                       device const uint* cachedColors [[ buffer(FastSHBufferIndexCachedColors) ]]) {
+    return fastSHSplatVertex(vertexID,
+                             instanceID,
+                             amplificationID,
+                             splatArray,
+                             uniformsArray,
+                             sortedIndices,
+                             editStates,
+                             transformIndices,
+                             transformPalette,
+                             nullptr,
+                             cachedColors,
+                             params);
+}
+
+// ============================================================================
+// Visible-only SH evaluation with a direction-bucketed cache
+// Each splat's color is evaluated once per frame at most, and only when it is inside the frustum and its local
+// view direction has moved to another octahedral bucket since it was cached. Stereo views share the eyes'
+// midpoint as the SH camera.
+// ============================================================================
+
+// Keep in sync with SplatRenderer+FastSH.swift : FastSHCacheParams
+struct FastSHCacheParams {
+    uint splatCount;
+    uint viewCount;
+    uint bucketResolution;   // Octahedral buckets per axis
+    uint padding;
+};
+
+constant constexpr uint kSHCacheBaseColorBucket = 0xfffffffeu;  // Cached color is the base color (no SH)
+
+inline uint shDirectionBucket(float3 direction, uint resolution) {
+    float2 p = direction.xy / (abs(direction.x) + abs(direction.y) + abs(direction.z));
+    if (direction.z < 0.0f) {
+        p = (1.0f - abs(p.yx)) * select(float2(-1.0f), float2(1.0f), p >= 0.0f);
+    }
+    uint2 cell = uint2(clamp((p * 0.5f + 0.5f) * float(resolution), 0.0f, float(resolution - 1)));
+    return cell.y * resolution + cell.x;
+}
+
+kernel void evaluateVisibleSplatSH(uint index [[thread_position_in_grid]],
+                                   constant SplatSH* splatArray [[ buffer(0) ]],
+                                   device const half3* shPalette [[ buffer(1) ]],
+                                   constant FastSHParams& params [[ buffer(2) ]],
+                                   constant UniformsArray & uniformsArray [[ buffer(3) ]],
+                                   constant FastSHCacheParams& cacheParams [[ buffer(4) ]],
+                                   device uint* cachedColors [[ buffer(5) ]],
+                                   device uint* cachedBuckets [[ buffer(6) ]]) {
+    if (index >= cacheParams.splatCount) return;
+
+    SplatSH splatSH = splatArray[index];
+    float3 worldPosition = float3(splatSH.position);
+
+    // Same conservative clip-space test as frustumCullSplats, passing if any view sees the splat
+    bool visible = false;
+    float3 cameraPosition = float3(0.0f);
+    for (uint view = 0; view < cacheParams.viewCount; view++) {
+        Uniforms uniforms = uniformsArray.uniforms[view];
+        cameraPosition += cameraWorldPosition(uniforms.viewMatrix);
+        float4 clipPosition = uniforms.projectionMatrix * (uniforms.viewMatrix * float4(worldPosition, 1.0f));
+        if (clipPosition.w > 0.001f) {
+            float2 ndc = clipPosition.xy / clipPosition.w;
+            visible = visible || all(abs(ndc) <= float2(2.5f));
+        } else if (clipPosition.w >= -0.1f) {
+            visible = true;
+        }
+    }
+    if (!visible) return;
+
+    if (!splatHasSH(splatSH, params)) {
+        if (cachedBuckets[index] != kSHCacheBaseColorBucket) {
+            cachedColors[index] = splatSH.packedBaseColor;
+            cachedBuckets[index] = kSHCacheBaseColorBucket;
+        }
+        return;
+    }
+
+    cameraPosition /= float(cacheParams.viewCount);
+    float4 qConjugate = float4(-splatSH.rotation.xyz, splatSH.rotation.w);
+    float3 localDirection = rotateVectorByQuaternion(qConjugate, normalize(cameraPosition - worldPosition));
+    uint bucket = shDirectionBucket(localDirection, cacheParams.bucketResolution);
+    if (cachedBuckets[index] == bucket) return;
+
+    cachedColors[index] = pack_half_to_unorm4x8(evaluateSplatSHColor(splatSH, cameraPosition, shPalette, params));
+    cachedBuckets[index] = bucket;
+}
+
 // Fragment shader remains the same
 fragment half4 fastSHSplatFragmentShader(FragmentIn in [[stage_in]]) {
     return shadeSplat(in);
@@ -240,7 +380,7 @@ vertex FragmentIn textureSHSplatVertexShader(uint vertexID [[vertex_id]],
     }
 
     // Use sorted index to access splat in depth-sorted order
-    uint actualSplatID = uint(sortedIndices[logicalSplatID]);
+    uint actualSplatID = uint(sortedIndices[uniforms.sortedIndexViewOffset + logicalSplatID]);
     // Defensive guard for transient stale/corrupt sorted indices
     if (actualSplatID >= uniforms.splatCount) {
         FragmentIn out;
@@ -253,7 +393,7 @@ vertex FragmentIn textureSHSplatVertexShader(uint vertexID [[vertex_id]],
         return out;
     }
     SplatSH splatSH = splatArray[actualSplatID];
-    Splat splat = evaluateSplatWithSH(splatSH, uniforms, shPalette, params);
+    Splat splat = evaluateSplatWithSH(splatSH, actualSplatID, uniforms, shPalette, nullptr, params);
     uint editState = editStates != nullptr ? editStates[actualSplatID] : 0u;
     return splatVertex(splat,
                        uniforms,
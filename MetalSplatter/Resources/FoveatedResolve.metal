@@ -0,0 +1,30 @@
+#include <metal_stdlib>
+using namespace metal;
+
+// Resolves splats drawn through a rasterization rate map into a full-resolution target. The foveated pass writes
+// the physical-size sub-rect of a screen-size texture; every logical pixel here looks up its physical location and
+// blends the premultiplied color over the destination.
+
+struct FoveatedResolveVertexOut {
+    float4 position [[position]];
+};
+
+vertex FoveatedResolveVertexOut foveatedResolveVertexShader(uint vertexID [[vertex_id]]) {
+    // Single triangle covering the viewport
+    float2 uv = float2((vertexID << 1) & 2, vertexID & 2);
+    FoveatedResolveVertexOut out;
+    out.position = float4(uv * float2(2, -2) + float2(-1, 1), 0, 1);
+    return out;
+}
+
+fragment half4 foveatedResolveFragmentShader(FoveatedResolveVertexOut in [[stage_in]],
+                                             constant rasterization_rate_map_data &rateMapData [[buffer(0)]],
+                                             constant float2 &physicalSize [[buffer(1)]],
+                                             texture2d<half> physicalColor [[texture(0)]]) {
+    constexpr sampler physicalSampler(coord::pixel, address::clamp_to_edge, filter::linear);
+    rasterization_rate_map_decoder decoder(rateMapData);
+    float2 physical = decoder.map_screen_to_physical_coordinates(in.position.xy);
+    // Texels past the physical sub-rect were not drawn this frame; keep the filter from reaching them
+    physical = clamp(physical, float2(0.5), physicalSize - 0.5);
+    return physicalColor.sample(physicalSampler, physical);
+}
@@ -0,0 +1,208 @@
+#include <metal_stdlib>
+using namespace metal;
+
+#include "ShaderCommon.h"
+
+// GPU dequantization of packed scene formats straight into Splat buffers.
+// Each kernel mirrors the SplatIO CPU decoder named above it, followed by
+// SplatRenderer.Splat.init(_:) (sRGB → linear color, normalized rotation, covariance),
+// so GPU-decoded and CPU-decoded scenes match; keep them in sync when changing either.
+
+constant float dequantizeSHC0 = 0.28209479177387814f;
+
+// Same covariance construction as SplatRenderer.Splat.init(position:color:scale:rotation:)
+inline void dequantizeCovariance(float4 rotation, float3 scale, thread packed_half3 &covA, thread packed_half3 &covB) {
+    float4 q = rotation / max(length(rotation), 1e-8f);
+    float x = q.x, y = q.y, z = q.z, w = q.w;
+
+    float3x3 rotationMatrix = float3x3(float3(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y)),
+                                       float3(2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x)),
+                                       float3(2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y)));
+    float3x3 transform = float3x3(rotationMatrix[0] * scale.x,
+                                  rotationMatrix[1] * scale.y,
+                                  rotationMatrix[2] * scale.z);
+    float3x3 cov3D = transform * transpose(transform);
+
+    covA = packed_half3(half(cov3D[0][0]), half(cov3D[0][1]), half(cov3D[0][2]));
+    covB = packed_half3(half(cov3D[1][1]), half(cov3D[1][2]), half(cov3D[2][2]));
+}
+
+// Linear color from a DC spherical harmonic (SplatScenePoint.Color.asLinearFloat), then sRGBToLinear
+inline float3 dequantizeDCToLinear(float3 sh0) {
+    float3 color = clamp(0.5f + dequantizeSHC0 * sh0, 0.0f, 1.0f);
+    return pow(color, float3(2.2f));
+}
+
+inline Splat dequantizedSplat(float3 position, float3 linearColor, float opacity, float3 scale, float4 rotation) {
+    Splat splat;
+    splat.position = packed_float3(position);
+    splat.packedColor = pack_float_to_unorm4x8(float4(linearColor, opacity));
+    dequantizeCovariance(rotation, scale, splat.covA, splat.covB);
+    return splat;
+}
+
+// MARK: - SOG v2
+
+// Must match GPUDequantizer.swift SOGV2Params
+struct SOGV2DequantizeParams {
+    float4 meansMin;
+    float4 meansMax;
+    uint splatCount;
+    uint premultipliedMask;  // Bit per image, in SOGV2Image order
+    uint2 padding;
+};
+
+enum SOGV2Image : uint {
+    SOGV2ImageMeansLower = 0,
+    SOGV2ImageMeansUpper = 1,
+    SOGV2ImageQuats = 2,
+    SOGV2ImageScales = 3,
+    SOGV2ImageSH0 = 4,
+};
+
+// WebPDecoder.getPixel: images decoded premultiplied are un-premultiplied (truncating) before use
+inline uint4 sogPixel(const device uchar4 *image, uint index, uint premultipliedMask, SOGV2Image which) {
+    uint4 pixel = uint4(image[index]);
+    if ((premultipliedMask & (1u << which)) != 0 && pixel.w > 0) {
+        float alpha = float(pixel.w) / 255.0f;
+        pixel.xyz = uint3(min(float3(255.0f), float3(pixel.xyz) / alpha));
+    }
+    return pixel;
+}
+
+// SOGSIteratorV2.readPoint: log-encoded 16-bit means, smallest-three quaternions, codebook scales and colors
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void dequantizeSOGV2Splats(constant SOGV2DequantizeParams &params [[buffer(0)]],
+                                  const device uchar4 *meansLower [[buffer(1)]],
+                                  const device uchar4 *meansUpper [[buffer(2)]],
+                                  const device uchar4 *quats [[buffer(3)]],
+                                  const device uchar4 *scales [[buffer(4)]],
+                                  const device uchar4 *sh0 [[buffer(5)]],
+                                  const device float *scalesCodebook [[buffer(6)]],  // 256 entries
+                                  const device float *sh0Codebook [[buffer(7)]],     // 256 entries
+                                  device Splat *outputSplats [[buffer(8)]],
+                                  uint index [[thread_position_in_grid]]) {
+    if (index >= params.splatCount) return;
+    uint mask = params.premultipliedMask;
+
+    uint4 lower = sogPixel(meansLower, index, mask, SOGV2ImageMeansLower);
+    uint4 upper = sogPixel(meansUpper, index, mask, SOGV2ImageMeansUpper);
+    float3 quantized = float3((upper.xyz << 8) | lower.xyz) / 65535.0f;
+    float3 logPosition = mix(params.meansMin.xyz, params.meansMax.xyz, quantized);
+    float3 position = sign(logPosition) * (exp(abs(logPosition)) - 1.0f);
+
+    uint4 quatPixel = sogPixel(quats, index, mask, SOGV2ImageQuats);
+    float3 abc = (float3(quatPixel.xyz) / 255.0f - 0.5f) * M_SQRT2_F;
+    float d = sqrt(max(0.0f, 1.0f - dot(abc, abc)));
+    float4 rotation;
+    switch (int(quatPixel.w) - 252) {
+        case 1: rotation = float4(d, abc.y, abc.z, abc.x); break;
+        case 2: rotation = float4(abc.y, d, abc.z, abc.x); break;
+        case 3: rotation = float4(abc.y, abc.z, d, abc.x); break;
+        default: rotation = float4(abc, d); break;
+    }
+
+    uint4 scalePixel = sogPixel(scales, index, mask, SOGV2ImageScales);
+    float3 scale = exp(float3(scalesCodebook[scalePixel.x], scalesCodebook[scalePixel.y], scalesCodebook[scalePixel.z]));
+
+    uint4 colorPixel = sogPixel(sh0, index, mask, SOGV2ImageSH0);
+    float3 dc = float3(sh0Codebook[colorPixel.x], sh0Codebook[colorPixel.y], sh0Codebook[colorPixel.z]);
+    float opacity = float(colorPixel.w) / 255.0f;
+
+    outputSplats[index] = dequantizedSplat(position, dequantizeDCToLinear(dc), opacity, scale, rotation);
+}
+
+// MARK: - SPZ
+
+// Must match GPUDequantizer.swift SPZParams
+struct SPZDequantizeParams {
+    uint splatCount;
+    uint fractionalBits;
+    uint usesFloat16Positions;
+    uint usesSmallestThreeRotations;
+};
+
+inline uint spzByte(const device uchar *bytes, uint offset) {
+    return uint(bytes[offset]);
+}
+
+// SPZ streams are tightly packed bytes, so multi-byte values are assembled without alignment assumptions
+inline float3 spzPosition(const device uchar *positions, uint index, constant SPZDequantizeParams &params) {
+    float3 position;
+    if (params.usesFloat16Positions != 0) {
+        uint base = index * 6;
+        for (uint axis = 0; axis < 3; axis++) {
+            ushort bits = ushort(spzByte(positions, base + axis * 2) | (spzByte(positions, base + axis * 2 + 1) << 8));
+            position[axis] = float(as_type<half>(bits));
+        }
+    } else {
+        uint base = index * 9;
+        float fixedPointScale = 1.0f / float(1u << params.fractionalBits);
+        for (uint axis = 0; axis < 3; axis++) {
+            uint offset = base + axis * 3;
+            uint fixed24 = spzByte(positions, offset) | (spzByte(positions, offset + 1) << 8) | (spzByte(positions, offset + 2) << 16);
+            int fixed32 = (fixed24 & 0x800000u) != 0 ? int(fixed24 | 0xFF000000u) : int(fixed24);
+            position[axis] = float(fixed32) * fixedPointScale;
+        }
+    }
+    return position;
+}
+
+// unpackQuaternionSmallestThreePacked / unpackQuaternionFirstThreeUnsafe, without coordinate flips (RUB → RUB)
+inline float4 spzRotation(const device uchar *rotations, uint index, constant SPZDequantizeParams &params) {
+    if (params.usesSmallestThreeRotations == 0) {
+        uint base = index * 3;
+        float3 xyz = float3(spzByte(rotations, base), spzByte(rotations, base + 1), spzByte(rotations, base + 2)) / 127.5f - 1.0f;
+        return float4(xyz, sqrt(max(0.0f, 1.0f - dot(xyz, xyz))));
+    }
+
+    uint base = index * 4;
+    uint packed = spzByte(rotations, base)
+        | (spzByte(rotations, base + 1) << 8)
+        | (spzByte(rotations, base + 2) << 16)
+        | (spzByte(rotations, base + 3) << 24);
+    uint largestIndex = packed >> 30;
+    float componentScale = M_SQRT1_2_F / 511.0f;
+
+    float4 components = 0.0f;
+    float sumSquares = 0.0f;
+    uint remaining = packed;
+    for (int component = 3; component >= 0; component--) {
+        if (uint(component) == largestIndex) continue;
+        uint encoded = remaining & 0x3FFu;
+        remaining >>= 10;
+        float value = float(encoded & 0x1FFu) * componentScale * ((encoded & 0x200u) == 0 ? 1.0f : -1.0f);
+        components[component] = value;
+        sumSquares += value * value;
+    }
+    components[largestIndex] = sqrt(max(0.0f, 1.0f - sumSquares));
+    return components;
+}
+
+// SPZSceneReader.processPointChunk: the DC color, alpha and scale streams are one byte per channel
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void dequantizeSPZSplats(constant SPZDequantizeParams &params [[buffer(0)]],
+                                const device uchar *positions [[buffer(1)]],
+                                const device uchar *scales [[buffer(2)]],
+                                const device uchar *rotations [[buffer(3)]],
+                                const device uchar *alphas [[buffer(4)]],
+                                const device uchar *colors [[buffer(5)]],
+                                device Splat *outputSplats [[buffer(6)]],
+                                uint index [[thread_position_in_grid]]) {
+    if (index >= params.splatCount) return;
+
+    uint channelBase = index * 3;
+    float3 scale = exp(float3(spzByte(scales, channelBase), spzByte(scales, channelBase + 1), spzByte(scales, channelBase + 2)) / 16.0f - 10.0f);
+
+    // The CPU path stores logit(clamp(a)) and the renderer applies sigmoid, which round-trips to clamp(a)
+    float opacity = clamp(float(spzByte(alphas, index)) / 255.0f, 0.0001f, 0.9999f);
+
+    float3 colorBytes = float3(spzByte(colors, channelBase), spzByte(colors, channelBase + 1), spzByte(colors, channelBase + 2));
+    float3 dc = (colorBytes / 255.0f - 0.5f) / 0.15f;
+
+    outputSplats[index] = dequantizedSplat(spzPosition(positions, index, params),
+                                           dequantizeDCToLinear(dc),
+                                           opacity,
+                                           scale,
+                                           spzRotation(rotations, index, params));
+}
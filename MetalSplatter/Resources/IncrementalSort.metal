@@ -0,0 +1,133 @@
+#include "ShaderCommon.h"
+
+// Incremental (temporally coherent) depth sort
+//
+// Between nearby camera poses the previous frame's sorted indices are already
+// almost in back-to-front order. Instead of sorting from scratch, each pass loads
+// tiles of the previous order, re-evaluates depth for the new camera and
+// bitonic-sorts every tile in threadgroup memory. Consecutive passes alternate the
+// tile origin by half a tile (odd-even merge across tiles), so a splat can move
+// half a tile per pass. A final pass counts the adjacent pairs that are still out
+// of order, which the renderer uses to decide when to fall back to a full sort.
+//
+// Configuration notes:
+// - Tile size is 1024 entries, sorted by 512 threads (one compare-exchange each)
+// - Tiles that are already in order are detected up front and skipped
+
+constant uint INCREMENTAL_SORT_TILE_SIZE = 1024;
+constant uint INCREMENTAL_SORT_THREADS = INCREMENTAL_SORT_TILE_SIZE / 2;
+
+struct IncrementalSortParams {
+    uint count;          // Entries in the order being refined
+    uint tileOffset;     // Origin of the first tile (0 or half a tile)
+};
+
+static inline float incrementalSortDepth(float3 splatPos,
+                                         float3 cameraPosition,
+                                         float3 cameraForward,
+                                         bool sortByDistance) {
+    float3 delta = splatPos - cameraPosition;
+    return sortByDistance ? length_squared(delta) : dot(delta, cameraForward);
+}
+
+// Refines one tile of `sortedIndices` in place; dispatched with INCREMENTAL_SORT_THREADS threads per threadgroup
+[[kernel]]
+void incrementalSortRefineTiles(
+    device const Splat* splats [[buffer(0)]],
+    device int* sortedIndices [[buffer(1)]],
+    constant IncrementalSortParams& params [[buffer(2)]],
+    constant float3& cameraPosition [[buffer(3)]],
+    constant float3& cameraForward [[buffer(4)]],
+    constant bool& sortByDistance [[buffer(5)]],
+    uint tgid [[threadgroup_position_in_grid]],
+    uint lid [[thread_position_in_threadgroup]]
+) {
+    threadgroup float depths[INCREMENTAL_SORT_TILE_SIZE];
+    threadgroup int indices[INCREMENTAL_SORT_TILE_SIZE];
+    threadgroup atomic_uint tileInversions;
+
+    const uint tileStart = params.tileOffset + tgid * INCREMENTAL_SORT_TILE_SIZE;
+    if (lid == 0) {
+        atomic_store_explicit(&tileInversions, 0, memory_order_relaxed);
+    }
+
+    // Past the end of the order, pad with entries that sort to the back of the tile
+    for (uint k = lid; k < INCREMENTAL_SORT_TILE_SIZE; k += INCREMENTAL_SORT_THREADS) {
+        uint i = tileStart + k;
+        if (i < params.count) {
+            int index = sortedIndices[i];
+            indices[k] = index;
+            depths[k] = incrementalSortDepth(float3(splats[index].position), cameraPosition, cameraForward, sortByDistance);
+        } else {
+            indices[k] = -1;
+            depths[k] = -INFINITY;
+        }
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+
+    // Skip tiles that are still in order for the new camera
+    uint inverted = 0;
+    for (uint k = lid; k + 1 < INCREMENTAL_SORT_TILE_SIZE; k += INCREMENTAL_SORT_THREADS) {
+        inverted += depths[k] < depths[k + 1] ? 1 : 0;
+    }
+    if (inverted > 0) {
+        atomic_fetch_add_explicit(&tileInversions, inverted, memory_order_relaxed);
+    }
+    threadgroup_barrier(mem_flags::mem_threadgroup);
+    if (atomic_load_explicit(&tileInversions, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    // Bitonic sort, descending depth (back-to-front)
+    for (uint size = 2; size <= INCREMENTAL_SORT_TILE_SIZE; size <<= 1) {
+        for (uint stride = size >> 1; stride > 0; stride >>= 1) {
+            uint low = 2 * lid - (lid & (stride - 1));
+            uint high = low + stride;
+            bool descending = (low & size) == 0;
+            float lowDepth = depths[low];
+            float highDepth = depths[high];
+            if (descending ? (lowDepth < highDepth) : (lowDepth > highDepth)) {
+                depths[low] = highDepth;
+                depths[high] = lowDepth;
+                int lowIndex = indices[low];
+                indices[low] = indices[high];
+                indices[high] = lowIndex;
+            }
+            threadgroup_barrier(mem_flags::mem_threadgroup);
+        }
+    }
+
+    for (uint k = lid; k < INCREMENTAL_SORT_TILE_SIZE; k += INCREMENTAL_SORT_THREADS) {
+        uint i = tileStart + k;
+        if (i < params.count) {
+            sortedIndices[i] = indices[k];
+        }
+    }
+}
+
+// Counts adjacent pairs of the refined order that are still front-to-back for the new camera
+[[kernel]]
+void incrementalSortCountInversions(
+    device const Splat* splats [[buffer(0)]],
+    device const int* sortedIndices [[buffer(1)]],
+    constant IncrementalSortParams& params [[buffer(2)]],
+    constant float3& cameraPosition [[buffer(3)]],
+    constant float3& cameraForward [[buffer(4)]],
+    constant bool& sortByDistance [[buffer(5)]],
+    device atomic_uint* inversionCount [[buffer(6)]],
+    uint tid [[thread_position_in_grid]]
+) {
+    uint inverted = 0;
+    if (tid + 1 < params.count) {
+        float depth = incrementalSortDepth(float3(splats[sortedIndices[tid]].position),
+                                           cameraPosition, cameraForward, sortByDistance);
+        float nextDepth = incrementalSortDepth(float3(splats[sortedIndices[tid + 1]].position),
+                                               cameraPosition, cameraForward, sortByDistance);
+        inverted = depth < nextDepth ? 1 : 0;
+    }
+
+    uint simdInversions = simd_sum(inverted);
+    if (simd_is_first() && simdInversions > 0) {
+        atomic_fetch_add_explicit(inversionCount, simdInversions, memory_order_relaxed);
+    }
+}
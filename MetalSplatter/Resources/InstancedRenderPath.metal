@@ -0,0 +1,117 @@
+#include "SplatProcessing.h"
+
+// Instanced scenes: one splat asset drawn at many transforms from a single Splat buffer. sortedIndices holds
+// (instance, splat) keys, instance * instanceSplatCount + splat, ordered back to front across every instance
+// (see computeInstancedSplatDistances). Each key's instance transform is composed with the splat's edit
+// transform, when it has one, so edits made in asset space show up in every instance.
+
+inline FragmentIn culledInstancedFragment() {
+    FragmentIn out;
+    out.position = float4(1, 1, 0, 1);
+    out.relativePosition = half2(0);
+    out.color = half4(0);
+    out.lodBand = 0;
+    out.debugFlags = 0;
+    out.splatID = 0;
+    return out;
+}
+
+inline FragmentIn instancedSplatVertex(uint vertexID,
+                                       uint instanceID,
+                                       ushort amplificationID,
+                                       constant Splat* splatArray,
+                                       constant UniformsArray &uniformsArray,
+                                       constant int32_t* sortedIndices,
+                                       const device float4x4 *instanceTransforms,
+                                       const device uchar *editStates,
+                                       const device ushort *transformIndices,
+                                       const device float4x4 *transformPalette) {
+    Uniforms uniforms = uniformsArray.uniforms[min(int(amplificationID), kMaxViewCount - 1)];
+
+    uint logicalSplatID = instanceID * uniforms.indexedSplatCount + (vertexID / 4);
+    if (logicalSplatID >= uniforms.splatCount || uniforms.instanceSplatCount == 0) {
+        return culledInstancedFragment();
+    }
+
+    // Keys culled by edit state or instance LOD are written as -1 and land past every instance
+    uint key = uint(sortedIndices[uniforms.sortedIndexViewOffset + logicalSplatID]);
+    uint instance = key / uniforms.instanceSplatCount;
+    uint splatID = key - instance * uniforms.instanceSplatCount;
+    if (instance >= uniforms.instanceCount) {
+        return culledInstancedFragment();
+    }
+
+    float4x4 transform = instanceTransforms[instance];
+    if (transformIndices != nullptr && transformPalette != nullptr) {
+        uint transformIndex = transformIndices[splatID];
+        if (transformIndex != 0u) {
+            transform = transform * transformPalette[transformIndex];
+        }
+    }
+
+    Splat splat = splatArray[splatID];
+    float3x3 transform3x3 = float3x3(transform[0].xyz, transform[1].xyz, transform[2].xyz);
+    float3x3 covariance3D = float3x3(
+        splat.covA.x, splat.covA.y, splat.covA.z,
+        splat.covA.y, splat.covB.x, splat.covB.y,
+        splat.covA.z, splat.covB.y, splat.covB.z
+    );
+    float3x3 transformedCovariance = transform3x3 * covariance3D * transpose(transform3x3);
+    splat.position = packed_float3((transform * float4(float3(splat.position), 1.0)).xyz);
+    splat.covA = packed_half3(half(transformedCovariance[0][0]),
+                              half(transformedCovariance[0][1]),
+                              half(transformedCovariance[0][2]));
+    splat.covB = packed_half3(half(transformedCovariance[1][1]),
+                              half(transformedCovariance[1][2]),
+                              half(transformedCovariance[2][2]));
+
+    // The edit transform is already applied, so only the edit state is passed on
+    return splatVertex(splat,
+                       uniforms,
+                       vertexID % 4,
+                       splatID,
+                       editStates != nullptr ? editStates[splatID] : 0u,
+                       nullptr,
+                       nullptr);
+}
+
+vertex FragmentIn instancedSplatVertexShader(uint vertexID [[vertex_id]],
+                                             uint instanceID [[instance_id]],
+                                             ushort amplificationID [[amplification_id]],
+                                             constant Splat* splatArray [[ buffer(BufferIndexSplat) ]],
+                                             constant UniformsArray & uniformsArray [[ buffer(BufferIndexUniforms) ]],
+                                             constant int32_t* sortedIndices [[ buffer(BufferIndexSortedIndices) ]],
+                                             const device float4x4 *instanceTransforms [[ buffer(BufferIndexInstanceTransforms) ]]) {
+    return instancedSplatVertex(vertexID,
+                                instanceID,
+                                amplificationID,
+                                splatArray,
+                                uniformsArray,
+                                sortedIndices,
+                                instanceTransforms,
+                                nullptr,
+                                nullptr,
+                                nullptr);
+}
+
+vertex FragmentIn instancedSplatVertexShaderEditing(uint vertexID [[vertex_id]],
+                                                    uint instanceID [[instance_id]],
+                                                    ushort amplificationID [[amplification_id]],
+                                                    constant Splat* splatArray [[ buffer(BufferIndexSplat) ]],
+                                                    constant UniformsArray & uniformsArray [[ buffer(BufferIndexUniforms) ]],
+                                                    constant int32_t* sortedIndices [[ buffer(BufferIndexSortedIndices) ]],
+                                                    const device float4x4 *instanceTransforms [[ buffer(BufferIndexInstanceTransforms) ]],
+                                                    const device uchar *editStates [[ buffer(BufferIndexEditState) ]],
+                                                    const device ushort *transformIndices [[ buffer(BufferIndexTransformIndex) ]],
+                                                    const device float4x4 *transformPalette [[ buffer(BufferIndexTransformPalette) ]]) {
+    return instancedSplatVertex(vertexID,
+                                instanceID,
+                                amplificationID,
+                                splatArray,
+                                uniformsArray,
+                                sortedIndices,
+                                instanceTransforms,
+                                editStates,
+                                transformIndices,
+                                transformPalette);
+}
@@ -0,0 +1,136 @@
+#include "ShaderCommon.h"
+
+// GPU-driven LOD selection and culling
+//
+// Evaluates an LOD hierarchy (e.g. octree node bounds) entirely on the GPU, with no CPU traversal
+// or readback:
+// 1. lodSelectNodes: per node, frustum-test the AABB and compute its screen-space error. A node's
+//    splats are drawn when the node is visible, does not need refining (or is a leaf), and its
+//    nearest ancestor with splats does need refining (or there is none). Ancestors without splats
+//    are skipped, so a node under an empty intermediate node is not drawn over a coarser ancestor.
+// 2. lodCullSplats: per splat, look up its node's selection, apply the edit state and a
+//    conservative per-splat frustum test, and write a sort mask (edit-state encoding, so the
+//    counting sort skips culled splats) plus the survivor count.
+// 3. lodPadSortedIndices: marks sorted entries past the survivor count invalid, so draws that
+//    still cover the full renderable count discard them in the vertex stage.
+//
+// Screen-space errors are expected to shrink from parent to child, as with any LOD cut.
+
+// Keep in sync with GPULODSelector.swift
+struct LODNodeGPU {
+    float4 boundsMin;        // xyz = AABB min, w = geometric error (world units)
+    float4 boundsMax;        // xyz = AABB max
+    int splatAncestorIndex;  // Nearest ancestor with splats, -1 for none
+    uint flags;              // LOD_NODE_*
+    uint2 padding;
+};
+
+constant uint LOD_NODE_LEAF = 1u << 0;
+constant uint LOD_NODE_HAS_SPLATS = 1u << 1;
+
+struct LODCullParams {
+    float4x4 viewProjectionMatrix;
+    float4 cameraPosition;       // xyz = camera position, w = projection scale (focal length in pixels)
+    float maxScreenSpaceError;   // Pixels; nodes above this are refined into their children
+    float frustumMargin;         // NDC margin for the per-splat test
+    uint nodeCount;
+    uint splatCount;
+};
+
+// Edit-state bit the counting sort treats as hidden
+constant uchar LOD_CULLED_MASK = uchar(1u << 1);
+
+static inline bool lodNodeInFrustum(LODNodeGPU node, float4x4 viewProjection) {
+    // Culled only if all eight corners are outside one clip plane
+    bool outside[6] = { true, true, true, true, true, true };
+    for (uint corner = 0; corner < 8; corner++) {
+        float3 p = float3((corner & 1) ? node.boundsMax.x : node.boundsMin.x,
+                          (corner & 2) ? node.boundsMax.y : node.boundsMin.y,
+                          (corner & 4) ? node.boundsMax.z : node.boundsMin.z);
+        float4 clip = viewProjection * float4(p, 1.0);
+        outside[0] = outside[0] && clip.x < -clip.w;
+        outside[1] = outside[1] && clip.x > clip.w;
+        outside[2] = outside[2] && clip.y < -clip.w;
+        outside[3] = outside[3] && clip.y > clip.w;
+        outside[4] = outside[4] && clip.z < 0.0;
+        outside[5] = outside[5] && clip.z > clip.w;
+    }
+    return !(outside[0] || outside[1] || outside[2] || outside[3] || outside[4] || outside[5]);
+}
+
+static inline float lodScreenSpaceError(LODNodeGPU node, constant LODCullParams& params) {
+    // Distance to the closest point of the box, so the camera inside a node always refines it
+    float3 closest = clamp(params.cameraPosition.xyz, node.boundsMin.xyz, node.boundsMax.xyz);
+    float distance = length(closest - params.cameraPosition.xyz);
+    return node.boundsMin.w * params.cameraPosition.w / max(distance, 1e-4);
+}
+
+[[kernel]]
+void lodSelectNodes(device const LODNodeGPU* nodes [[buffer(0)]],
+                    constant LODCullParams& params [[buffer(1)]],
+                    device uchar* nodeSelected [[buffer(2)]],
+                    uint index [[thread_position_in_grid]]) {
+    if (index >= params.nodeCount) {
+        return;
+    }
+
+    LODNodeGPU node = nodes[index];
+    bool selected = false;
+    if ((node.flags & LOD_NODE_HAS_SPLATS) != 0 && lodNodeInFrustum(node, params.viewProjectionMatrix)) {
+        bool refine = (node.flags & LOD_NODE_LEAF) == 0 &&
+                      lodScreenSpaceError(node, params) > params.maxScreenSpaceError;
+        bool ancestorRefined = true;
+        if (node.splatAncestorIndex >= 0) {
+            ancestorRefined = lodScreenSpaceError(nodes[node.splatAncestorIndex], params) > params.maxScreenSpaceError;
+        }
+        selected = !refine && ancestorRefined;
+    }
+    nodeSelected[index] = selected ? 1 : 0;
+}
+
+[[kernel, max_total_threads_per_threadgroup(256)]]
+void lodCullSplats(device const Splat* splats [[buffer(0)]],
+                   device const uint* splatNodeIndices [[buffer(1)]],
+                   device const uchar* nodeSelected [[buffer(2)]],
+                   constant LODCullParams& params [[buffer(3)]],
+                   device uchar* sortMask [[buffer(4)]],
+                   device atomic_uint* survivorCount [[buffer(5)]],
+                   const device uchar* editStates [[buffer(6)]],
+                   constant bool& hasEditStates [[buffer(7)]],
+                   uint index [[thread_position_in_grid]]) {
+    bool survives = false;
+    if (index < params.splatCount) {
+        uchar editState = hasEditStates ? editStates[index] : uchar(0);
+        survives = (editState & ((1u << 1) | (1u << 3))) == 0u &&
+                   nodeSelected[splatNodeIndices[index]] != 0;
+
+        if (survives) {
+            // Same conservative test as frustumCullSplats: only cull splats clearly off screen
+            float4 clipPos = params.viewProjectionMatrix * float4(float3(splats[index].position), 1.0);
+            if (clipPos.w < -0.1) {
+                survives = false;
+            } else if (clipPos.w > 0.001) {
+                float2 ndc = clipPos.xy / clipPos.w;
+                float limit = 1.0 + params.frustumMargin;
+                survives = all(abs(ndc) <= limit);
+            }
+        }
+        sortMask[index] = survives ? editState : uchar(editState | LOD_CULLED_MASK);
+    }
+
+    uint simdSurvivors = simd_sum(survives ? 1u : 0u);
+    if (simd_is_first() && simdSurvivors > 0) {
+        atomic_fetch_add_explicit(survivorCount, simdSurvivors, memory_order_relaxed);
+    }
+}
+
+[[kernel]]
+void lodPadSortedIndices(device int32_t* sortedIndices [[buffer(0)]],
+                         device const uint* survivorCount [[buffer(1)]],
+                         constant uint& renderableCount [[buffer(2)]],
+                         uint index [[thread_position_in_grid]]) {
+    uint slot = index + survivorCount[0];
+    if (slot < renderableCount) {
+        sortedIndices[slot] = -1;
+    }
+}
@@ -30,29 +30,31 @@ struct MortonCodeOutput {
     uint originalIndex;
 };
 
-// Parameters for Morton code computation
-struct MortonParameters {
-    float3 boundsMin;
-    float3 invBoundsSize;
-    uint splatCount;
-    uint padding;
+// Element count and byte stride for reorderElementsByMorton
+struct MortonGatherParameters {
+    uint count;
+    uint stride;
 };
 
 // Compute Morton codes for all splats
 // Output: array of (mortonCode, originalIndex) pairs for sorting
+// Bounds come straight from computeBoundsForMorton's output, so both run in one command buffer
 [[kernel, max_total_threads_per_threadgroup(256)]]
 kernel void computeMortonCodes(
     constant Splat* splats [[buffer(0)]],
     device MortonCodeOutput* output [[buffer(1)]],
-    constant MortonParameters& params [[buffer(2)]],
+    device const float* bounds [[buffer(2)]],  // [minX, minY, minZ, maxX, maxY, maxZ]
+    constant uint& splatCount [[buffer(3)]],
     uint index [[thread_position_in_grid]]
 ) {
-    if (index >= params.splatCount) return;
+    if (index >= splatCount) return;
 
     float3 pos = float3(splats[index].position);
+    float3 boundsMin = float3(bounds[0], bounds[1], bounds[2]);
+    float3 boundsSize = max(float3(bounds[3], bounds[4], bounds[5]) - boundsMin, float3(1e-6f));
 
     // Normalize position to [0, 1] within bounds
-    float3 normalized = (pos - params.boundsMin) * params.invBoundsSize;
+    float3 normalized = (pos - boundsMin) / boundsSize;
 
     // Quantize to 10-bit integers (0-1023)
     uint qx = uint(clamp(normalized.x * 1023.0f, 0.0f, 1023.0f));
@@ -181,18 +183,45 @@ kernel void resetBoundsForMorton(device atomic_uint* bounds [[buffer(0)]]) {
     atomic_store_explicit(&bounds[5], negInf, memory_order_relaxed);  // maxZ
 }
 
-// Reorder splats based on sorted Morton indices
+// Reorder splats based on sorted Morton codes
 // Uses double-buffering: reads from source, writes to destination
 [[kernel, max_total_threads_per_threadgroup(256)]]
 kernel void reorderSplatsByMorton(
     constant Splat* sourceSplats [[buffer(0)]],
     device Splat* destSplats [[buffer(1)]],
-    constant uint* sortedIndices [[buffer(2)]],
+    device const MortonCodeOutput* sortedCodes [[buffer(2)]],
     constant uint& splatCount [[buffer(3)]],
     uint index [[thread_position_in_grid]]
 ) {
     if (index >= splatCount) return;
 
-    uint sourceIndex = sortedIndices[index];
+    uint sourceIndex = sortedCodes[index].originalIndex;
     destSplats[index] = sourceSplats[sourceIndex];
 }
+
+// Applies the same order to a per-splat side buffer (edit state, transform indices, SH splats)
+// of any element size; 4-byte-aligned strides are copied a word at a time
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void reorderElementsByMorton(
+    device const uchar* source [[buffer(0)]],
+    device uchar* destination [[buffer(1)]],
+    device const MortonCodeOutput* sortedCodes [[buffer(2)]],
+    constant MortonGatherParameters& params [[buffer(3)]],
+    uint index [[thread_position_in_grid]]
+) {
+    if (index >= params.count) return;
+
+    uint sourceOffset = sortedCodes[index].originalIndex * params.stride;
+    uint destinationOffset = index * params.stride;
+    if ((params.stride & 3u) == 0) {
+        device const uint* sourceWords = (device const uint*)(source + sourceOffset);
+        device uint* destinationWords = (device uint*)(destination + destinationOffset);
+        for (uint word = 0; word < params.stride / 4; word++) {
+            destinationWords[word] = sourceWords[word];
+        }
+    } else {
+        for (uint byte = 0; byte < params.stride; byte++) {
+            destination[destinationOffset + byte] = source[sourceOffset + byte];
+        }
+    }
+}
@@ -11,6 +11,14 @@ typedef struct
     FragmentValues values [[imageblock_data]];
 } FragmentStore;
 
+// Front-to-back mode: splats are drawn nearest-first (the back-to-front sorted order read from its end)
+// and color.a accumulates opacity, so 1 - color.a is the pixel's remaining transmittance.
+// Indices 13-14 follow use2DGS (12).
+constant bool frontToBackBlending [[function_constant(13)]];
+constant float frontToBackEpsilonValue [[function_constant(14)]];
+constant bool readSortedOrderReversed = is_function_constant_defined(frontToBackBlending) && frontToBackBlending;
+constant float frontToBackTransmittanceEpsilon = is_function_constant_defined(frontToBackEpsilonValue) ? frontToBackEpsilonValue : (1.0 / 255.0);
+
 typedef struct
 {
     half4 color [[color(0)]];
@@ -53,7 +61,8 @@ inline FragmentIn multiStageSplatVertex(uint vertexID,
     }
 
     // Use sorted index to access splat in depth-sorted order
-    uint actualSplatID = uint(sortedIndices[logicalSplatID]);
+    uint sortedSlot = readSortedOrderReversed ? (uniforms.splatCount - 1 - logicalSplatID) : logicalSplatID;
+    uint actualSplatID = uint(sortedIndices[uniforms.sortedIndexViewOffset + sortedSlot]);
     // Defensive check for transient stale/corrupt sorted indices.
     if (actualSplatID >= uniforms.splatCount) {
         FragmentIn out;
@@ -133,6 +142,31 @@ fragment FragmentStore multiStageSplatFragmentShader(FragmentIn in [[stage_in]],
     return out;
 }
 
+// Front-to-back "under" blending with early termination: once the pixel is effectively opaque, later
+// (farther) fragments are discarded before shading. Produces the same premultiplied color and
+// alpha-weighted depth as the back-to-front shader, so postprocessing is shared.
+fragment FragmentStore multiStageSplatFragmentShaderFrontToBack(FragmentIn in [[stage_in]],
+                                                                FragmentValues previousFragmentValues [[imageblock_data]]) {
+    FragmentStore out;
+
+    half4 previousColor = previousFragmentValues.color;
+    half transmittance = 1 - previousColor.a;
+    if (float(transmittance) < frontToBackTransmittanceEpsilon) {
+        discard_fragment();
+    }
+
+    half4 shaded = shadeSplat(in);
+    half alpha = shaded.a;
+    half4 colorWithPremultipliedAlpha = half4(shaded.rgb, alpha);
+
+    out.values.color = previousColor + colorWithPremultipliedAlpha * transmittance;
+
+    float depth = in.position.z;
+    out.values.depth = previousFragmentValues.depth + depth * float(alpha * transmittance);
+
+    return out;
+}
+
 /// Generate a single triangle covering the entire screen
 vertex FragmentIn postprocessVertexShader(uint vertexID [[vertex_id]]) {
     FragmentIn out;
@@ -0,0 +1,137 @@
+#pragma once
+
+// Chunked splat format (ChunkedSplatFormat.swift): 16-byte PackedSplats quantized against the bounds
+// in their 256-splat chunk's header. Include after ShaderCommon.h.
+
+constant const uint kPackedSplatChunkSize = 256;
+
+// Chunk header structure (must match ChunkedSplatFormat.swift GPUChunkHeader)
+struct ChunkHeader {
+    float3 minPosition;
+    float padding1;
+
+    float3 maxPosition;
+    float padding2;
+
+    float3 minScale;
+    float padding3;
+
+    float3 maxScale;
+    uint splatCount;
+};
+
+// Packed splat structure (16 bytes, must match ChunkedSplatFormat.swift PackedSplat)
+struct PackedSplat {
+    uint positionPacked;   // 11-10-11 bits
+    uint rotationPacked;   // 2-bit selector + 3×10-bit components
+    uint scalePacked;      // 11-10-11 bits with exponential mapping
+    uint colorPacked;      // RGBA8
+};
+
+// Unpack position from 11-10-11 bits using chunk bounds
+inline float3 unpackPosition(uint packed, float3 minPos, float3 maxPos) {
+    float x = float((packed >> 21) & 0x7FF) / 2047.0;
+    float y = float((packed >> 11) & 0x3FF) / 1023.0;
+    float z = float(packed & 0x7FF) / 2047.0;
+
+    float3 range = maxPos - minPos;
+    return minPos + float3(x, y, z) * range;
+}
+
+// Unpack quaternion from 2-bit selector + 3×10-bit components
+// Uses smallest-three encoding
+inline float4 unpackRotation(uint packed) {
+    uint largestIdx = (packed >> 30) & 0x3;
+    float a = float((packed >> 20) & 0x3FF) / 1023.0;
+    float b = float((packed >> 10) & 0x3FF) / 1023.0;
+    float c = float(packed & 0x3FF) / 1023.0;
+
+    // Map back from [0, 1] to [-0.707, 0.707]
+    float3 components = float3(
+        (a * 2.0 - 1.0) * 0.707,
+        (b * 2.0 - 1.0) * 0.707,
+        (c * 2.0 - 1.0) * 0.707
+    );
+
+    // Reconstruct largest component from unit quaternion constraint
+    float sumSq = dot(components, components);
+    float largest = sqrt(max(1.0 - sumSq, 0.0));
+
+    // Build quaternion
+    float4 q;
+    uint j = 0;
+    for (uint i = 0; i < 4; i++) {
+        if (i == largestIdx) {
+            q[i] = largest;
+        } else {
+            q[i] = components[j];
+            j++;
+        }
+    }
+
+    return q;
+}
+
+// Unpack scale from 11-10-11 bits with exponential mapping
+inline float3 unpackScale(uint packed, float3 minScale, float3 maxScale) {
+    float x = float((packed >> 21) & 0x7FF) / 2047.0;
+    float y = float((packed >> 11) & 0x3FF) / 1023.0;
+    float z = float(packed & 0x7FF) / 2047.0;
+
+    // Use log-space interpolation for exponential mapping
+    float3 logMin = log(max(minScale, float3(0.0001)));
+    float3 logMax = log(max(maxScale, float3(0.0001)));
+
+    float3 logRange = logMax - logMin;
+    float3 logScale = logMin + float3(x, y, z) * logRange;
+
+    return exp(logScale);
+}
+
+// Unpack RGBA color from 32 bits (8 bits per channel)
+inline half4 unpackColor(uint packed) {
+    float r = float((packed >> 24) & 0xFF) / 255.0;
+    float g = float((packed >> 16) & 0xFF) / 255.0;
+    float b = float((packed >> 8) & 0xFF) / 255.0;
+    float a = float(packed & 0xFF) / 255.0;
+
+    return half4(r, g, b, a);
+}
+
+// MARK: - Render-time decoding
+
+// Splats fill every chunk but the last, so a splat's chunk follows from its index
+inline float3 packedSplatPosition(constant PackedSplat *packedSplats, constant ChunkHeader *chunkHeaders, uint index) {
+    constant ChunkHeader &header = chunkHeaders[index / kPackedSplatChunkSize];
+    return unpackPosition(packedSplats[index].positionPacked, header.minPosition, header.maxPosition);
+}
+
+// Decodes into the Splat the renderer would have built from the source point: same covariance
+// construction as SplatRenderer.Splat.init(position:color:scale:rotation:). colorPacked holds the
+// renderer's linear color and opacity, R in the high byte, so only the byte order changes.
+inline Splat decodePackedSplat(constant PackedSplat *packedSplats, constant ChunkHeader *chunkHeaders, uint index) {
+    PackedSplat packed = packedSplats[index];
+    constant ChunkHeader &header = chunkHeaders[index / kPackedSplatChunkSize];
+
+    float4 q = unpackRotation(packed.rotationPacked);
+    q /= max(length(q), 1e-8f);
+    float3 scale = unpackScale(packed.scalePacked, header.minScale, header.maxScale);
+    float x = q.x, y = q.y, z = q.z, w = q.w;
+    float3x3 rotationMatrix = float3x3(float3(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y)),
+                                       float3(2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x)),
+                                       float3(2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y)));
+    float3x3 transform = float3x3(rotationMatrix[0] * scale.x,
+                                  rotationMatrix[1] * scale.y,
+                                  rotationMatrix[2] * scale.z);
+    float3x3 cov3D = transform * transpose(transform);
+
+    Splat splat;
+    splat.position = packed_float3(unpackPosition(packed.positionPacked, header.minPosition, header.maxPosition));
+    splat.packedColor = ((packed.colorPacked >> 24) & 0xFFu)
+        | ((packed.colorPacked >> 8) & 0xFF00u)
+        | ((packed.colorPacked << 8) & 0xFF0000u)
+        | (packed.colorPacked << 24);
+    splat.covA = packed_half3(half(cov3D[0][0]), half(cov3D[0][1]), half(cov3D[0][2]));
+    splat.covB = packed_half3(half(cov3D[1][1]), half(cov3D[1][2]), half(cov3D[2][2]));
+    return splat;
+}
@@ -0,0 +1,35 @@
+#include "SplatProcessing.h"
+#include "PackedSplat.h"
+
+// Packed splat storage: the vertex stage decodes each sorted splat straight from its 16-byte
+// PackedSplat and chunk header, so no 28-byte Splat buffer is resident. Otherwise identical to
+// singleStageSplatVertexShader (no editing resources; packed scenes are view-only).
+vertex FragmentIn packedSplatVertexShader(uint vertexID [[vertex_id]],
+                                          uint instanceID [[instance_id]],
+                                          ushort amplificationID [[amplification_id]],
+                                          constant PackedSplat* packedSplats [[ buffer(BufferIndexSplat) ]],
+                                          constant UniformsArray & uniformsArray [[ buffer(BufferIndexUniforms) ]],
+                                          constant int32_t* sortedIndices [[ buffer(BufferIndexSortedIndices) ]],
+                                          constant ChunkHeader* chunkHeaders [[ buffer(BufferIndexChunkHeaders) ]]) {
+    Uniforms uniforms = uniformsArray.uniforms[min(int(amplificationID), kMaxViewCount - 1)];
+
+    uint logicalSplatID = instanceID * uniforms.indexedSplatCount + (vertexID / 4);
+    uint actualSplatID = logicalSplatID < uniforms.splatCount
+        ? uint(sortedIndices[uniforms.sortedIndexViewOffset + logicalSplatID])
+        : uniforms.splatCount;
+    if (actualSplatID >= uniforms.splatCount) {
+        FragmentIn out;
+        out.position = float4(1, 1, 0, 1);
+        out.relativePosition = half2(0);
+        out.color = half4(0);
+        out.lodBand = 0;
+        out.debugFlags = 0;
+        out.splatID = 0;
+        return out;
+    }
+
+    return splatVertex(decodePackedSplat(packedSplats, chunkHeaders, actualSplatID),
+                       uniforms,
+                       vertexID % 4,
+                       actualSplatID);
+}
@@ -21,6 +21,8 @@ enum BufferIndex: int32_t
     BufferIndexEditState      = 4,
     BufferIndexTransformIndex = 5,
     BufferIndexTransformPalette = 6,
+    BufferIndexChunkHeaders   = 7,  // Chunk headers for packed splat storage
+    BufferIndexInstanceTransforms = 8,  // Per-instance transforms for instanced scenes
 };
 
 typedef struct
@@ -45,16 +47,28 @@ typedef struct
     uint debugFlags;
     uint renderMode;
     uint isOrthographic;
-    uint padding1;
+    uint instanceSplatCount;    // Splats per instance in an instanced scene; keys are instance * this + splat
     float3 lodThresholds;
     float covarianceBlur;       // Low-pass filter for 2D covariance (derived from render mode by default)
     float4 selectionTintColor;
     uint editingEnabled;
-    uint padding2;
-    uint padding3;
-    uint padding4;
+    uint sortedIndexViewOffset; // Start of this view's order in sortedIndices (per-eye stereo sorting)
+    uint foveationEnabled;      // Nonzero when drawing through a rasterization rate map
+    uint instanceCount;         // Instances in BufferIndexInstanceTransforms (instanced scenes only)
+    // Rasterization rates of the map's kFoveationZoneCount columns and rows, unorm8-packed four per uint
+    uint4 foveationRatesX;
+    uint4 foveationRatesY;
 } Uniforms;
 
+// Zones per axis sampled from a rasterization rate map into Uniforms.foveationRates*
+constant static const uint kFoveationZoneCount = 16;
+
+inline float foveationRate(uint4 packedRates, float screenFraction) {
+    uint zone = min(uint(saturate(screenFraction) * float(kFoveationZoneCount)), kFoveationZoneCount - 1);
+    uint rate = (packedRates[zone / 4] >> ((zone % 4) * 8)) & 0xFFu;
+    return max(float(rate), 1.0f) / 255.0f;
+}
+
 typedef struct
 {
     Uniforms uniforms[kMaxViewCount];
@@ -27,7 +27,7 @@ inline FragmentIn singleStageSplatVertex(uint vertexID,
 
     // Use sorted index to access splat in depth-sorted order
     // sortedIndices maps logical draw order → actual splat index in buffer
-    uint actualSplatID = uint(sortedIndices[logicalSplatID]);
+    uint actualSplatID = uint(sortedIndices[uniforms.sortedIndexViewOffset + logicalSplatID]);
     // Defensive check for transient stale/corrupt sorted indices.
     if (actualSplatID >= uniforms.splatCount) {
         FragmentIn out;
@@ -121,7 +121,7 @@ vertex FragmentIn selectedOutlineVertexShader(uint vertexID [[vertex_id]],
         return out;
     }
 
-    uint actualSplatID = uint(sortedIndices[logicalSplatID]);
+    uint actualSplatID = uint(sortedIndices[uniforms.sortedIndexViewOffset + logicalSplatID]);
     if (actualSplatID >= uniforms.splatCount) {
         FragmentIn out;
         out.position = float4(1, 1, 0, 1);
@@ -0,0 +1,639 @@
+#include <metal_stdlib>
+using namespace metal;
+
+#include "ShaderCommon.h"
+
+// GPU port of SplatAnimationEngine (SplatAnimation.swift).
+// Every effect and helper below mirrors its Swift counterpart line-for-line so the GPU and CPU
+// paths produce the same animated scene; keep the two in sync when changing either.
+
+// Resident per-splat animation input (must match SplatAnimation.swift SplatAnimationSourcePoint)
+struct SplatAnimationSourcePoint {
+    float4 positionOpacity;  // xyz = position, w = linear opacity
+    float4 scale;            // xyz = linear scale
+    float4 rotation;         // Normalized quaternion (x,y,z,w)
+    float4 color;            // xyz = linear color before tint / sRGB conversion
+};
+
+// Per-scene metrics (must match SplatAnimation.swift SplatAnimationGPUSceneMetrics)
+struct SplatAnimationSceneData {
+    float4 center;
+    float4 centerOfMass;
+};
+
+// Animation parameters (must match SplatAnimation.swift SplatAnimationGPUParameters)
+struct SplatAnimationParams {
+    uint effect;
+    uint pointCount;
+    uint sceneCount;
+    uint hasOrigin;
+    float time;                 // Already multiplied by speed
+    float intensity;            // Already clamped to >= 0
+    float minimumScale;
+    float radius;
+    float height;
+    float duration;
+    float holdDuration;
+    float transitionDuration;
+    float randomRadius;
+    float explosionStrength;
+    float gravity;
+    float bounceDamping;
+    float floorLevel;
+    float waves;
+    float padding0;
+    float padding1;
+    float4 origin;
+};
+
+// Extended Splat structure for SH support (must match FastSHRenderPath.metal SplatSH)
+typedef struct {
+    packed_float3 position;
+    uint packedBaseColor;
+    float4 tintColor;
+    float4 rotation;
+    packed_half3 covA;
+    packed_half3 covB;
+    uint shPaletteIndex;
+    ushort shDegree;
+    ushort padding;
+} AnimatedSplatSH;
+
+// Must match SplatAnimationEffect raw values
+constant uint AnimationEffectMagic = 0u;
+constant uint AnimationEffectSpread = 1u;
+constant uint AnimationEffectUnroll = 2u;
+constant uint AnimationEffectTwister = 3u;
+constant uint AnimationEffectRain = 4u;
+constant uint AnimationEffectSpherical = 5u;
+constant uint AnimationEffectExplosion = 6u;
+constant uint AnimationEffectFlow = 7u;
+constant uint AnimationEffectMorph = 8u;
+
+struct AnimationSample {
+    float3 position;
+    float3 scale;
+    float4 rotation;
+    float opacity;
+    float3 tint;
+};
+
+// MARK: - Helpers
+
+inline float animClamp(float value, float lower, float upper) {
+    return min(max(value, lower), upper);
+}
+
+inline float animMix(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+inline float2 animMix(float2 a, float2 b, float t) {
+    return a + (b - a) * t;
+}
+
+inline float3 animMix(float3 a, float3 b, float t) {
+    return a + (b - a) * t;
+}
+
+// Matches the Swift helper, including the degenerate edge0 == edge1 case and reversed edges
+inline float animSmoothStep(float edge0, float edge1, float x) {
+    if (edge0 == edge1) {
+        return x >= edge1 ? 1.0f : 0.0f;
+    }
+    float t = animClamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+inline float animStep(float edge, float value) {
+    return value >= edge ? 1.0f : 0.0f;
+}
+
+// pow() for the non-negative bases used by the effects; fast-math pow(0, 0) is NaN
+inline float animPow(float base, float exponent) {
+    if (base <= 0.0f) {
+        return exponent == 0.0f ? 1.0f : 0.0f;
+    }
+    return precise::pow(base, exponent);
+}
+
+inline float animEase(float x) {
+    return x * x * (3.0f - 2.0f * x);
+}
+
+inline float animPositiveMod(float value, float modulus) {
+    float result = fmod(value, modulus);
+    return result < 0.0f ? result + modulus : result;
+}
+
+// Hashes use precise::sin so they stay close to the CPU references
+inline float3 animNoise3(float3 p) {
+    return float3(fract(precise::sin(dot(p, float3(12.9898f, 78.233f, 37.719f))) * 43758.5453f),
+                  fract(precise::sin(dot(p, float3(93.9898f, 67.345f, 54.123f))) * 24631.6345f),
+                  fract(precise::sin(dot(p, float3(45.332f, 18.654f, 91.122f))) * 12345.6789f)) * 2.0f - 1.0f;
+}
+
+inline float3 animHash3(float3 p) {
+    return float3(fract(precise::sin(dot(p, float3(127.1f, 311.7f, 74.7f))) * 43758.5453f),
+                  fract(precise::sin(dot(p, float3(269.5f, 183.3f, 246.1f))) * 43758.5453f),
+                  fract(precise::sin(dot(p, float3(113.5f, 271.9f, 124.6f))) * 43758.5453f));
+}
+
+inline float animSparkHash(float3 value) {
+    return fract(precise::sin(dot(value, float3(127.1f, 311.7f, 74.7f))) * 43758.5453f);
+}
+
+inline float animSparkHash11(float value) {
+    float x = fract(value * 0.1031f);
+    x += x * (x + 33.33f);
+    return fract(x * x);
+}
+
+inline float3 animSparkHash3(uint value) {
+    float x = float(value);
+    return float3(fract(precise::sin(x) * 43758.5453123f),
+                  fract(precise::sin(x + 1.0f) * 43758.5453123f),
+                  fract(precise::sin(x + 2.0f) * 43758.5453123f));
+}
+
+inline float2 animRotateXZ(float2 value, float angle) {
+    float s = sin(angle);
+    float c = cos(angle);
+    return float2(c * value.x - s * value.y, s * value.x + c * value.y);
+}
+
+// Equivalent of simd_quatf(angle:axis: (0, 1, 0)) * rotation
+inline float4 animRotateAroundY(float4 rotation, float angle) {
+    float s = sin(angle * 0.5f);
+    float c = cos(angle * 0.5f);
+    float3 axis = float3(0.0f, s, 0.0f);
+    float3 v = c * rotation.xyz + rotation.w * axis + cross(axis, rotation.xyz);
+    float w = c * rotation.w - dot(axis, rotation.xyz);
+    return float4(v, w);
+}
+
+inline float animMinimumScaleScale(float3 original, float minimumScale) {
+    float3 ratios = float3(minimumScale) / max(original, float3(0.0001f));
+    return max(ratios.x, max(ratios.y, ratios.z));
+}
+
+inline float3 animScaleMix(float minimumScale, float3 original, float factor) {
+    return animMix(float3(minimumScale), original, animClamp(factor, 0.0f, 1.0f));
+}
+
+inline float animSceneFadeAlpha(float localTime, bool fadeIn) {
+    if (fadeIn) {
+        if (localTime < 0.4f) { return 0.0f; }
+        if (localTime < 0.6f) { return animPow((localTime - 0.4f) * 5.0f, 2.0f); }
+        return 1.0f;
+    }
+    if (localTime < 0.4f) { return 1.0f; }
+    if (localTime < 0.6f) { return 1.0f - animPow((localTime - 0.4f) * 5.0f, 2.0f); }
+    return 0.0f;
+}
+
+// MARK: - Effects
+
+inline AnimationSample animMagic(SplatAnimationSourcePoint point, AnimationSample sample,
+                                 constant SplatAnimationParams &params, float3 origin) {
+    float3 position = point.positionOpacity.xyz;
+    float3 local = position - origin;
+    float radial = length(local.xz);
+    float revealRadius = animSmoothStep(0.0f, 10.0f, params.time - 4.5f) * 10.0f;
+    float border = abs(revealRadius - radial - 0.5f);
+    local *= 1.0f - 0.2f * exp(-20.0f * border) * params.intensity;
+
+    float reveal = animSmoothStep(revealRadius - 0.5f, revealRadius, radial + 0.5f);
+    local += 0.1f * animNoise3(local * 2.0f + float3(params.time * 0.5f)) * reveal * params.intensity;
+
+    float angle = atan2(local.x, local.z) / M_PI_F;
+    float visible = animStep(angle, params.time - M_PI_F);
+    float glow = exp(-20.0f * border) + exp(-50.0f * abs(params.time - angle - M_PI_F)) * 0.5f;
+
+    sample.position = origin + local;
+    sample.scale = animScaleMix(params.minimumScale, point.scale.xyz, reveal);
+    sample.opacity = point.positionOpacity.w * visible;
+    sample.tint = float3(1.0f + glow * params.intensity);
+    return sample;
+}
+
+inline AnimationSample animSpread(SplatAnimationSourcePoint point, AnimationSample sample,
+                                  constant SplatAnimationParams &params, float3 origin) {
+    float3 local = point.positionOpacity.xyz - origin;
+    float radial = length(local.xz);
+    float tt = params.time * params.time * 0.4f + 0.5f;
+    local.x *= min(1.0f, 0.3f + max(0.0f, tt * 0.05f));
+    local.z *= min(1.0f, 0.3f + max(0.0f, tt * 0.05f));
+
+    float largeReveal = animClamp(tt - 7.0f - radial * 2.5f, 0.0f, 1.0f);
+    float smallReveal = animClamp(tt - 1.0f - radial * 2.0f, 0.0f, 1.0f);
+    float3 scaleA = point.scale.xyz * largeReveal;
+    float3 scaleB = point.scale.xyz * 0.2f * smallReveal;
+
+    sample.position = origin + local;
+    sample.scale = max(scaleA, max(scaleB, float3(params.minimumScale)));
+    sample.opacity = point.positionOpacity.w * max(largeReveal, smallReveal);
+    float colorReveal = animClamp(tt - radial * 2.5f - 3.0f, 0.0f, 1.0f);
+    sample.tint = float3(0.3f) + (float3(1.0f) - float3(0.3f)) * (colorReveal * params.intensity);
+    return sample;
+}
+
+inline AnimationSample animUnroll(SplatAnimationSourcePoint point, AnimationSample sample,
+                                  constant SplatAnimationParams &params, float3 origin) {
+    float3 position = point.positionOpacity.xyz;
+    float3 local = position - origin;
+    float angle = (local.y * 50.0f - 20.0f) * exp(-params.time) * params.intensity;
+    // Same component order as the Swift SIMD3(SIMD2, scalar) initializer
+    local = float3(animRotateXZ(local.xz, angle), local.y);
+    local *= (1.0f - exp(-params.time) * 2.0f);
+
+    float reveal = animSmoothStep(0.3f, 0.7f, params.time + (position.y - origin.y) - 2.0f);
+    sample.position = origin + local;
+    sample.scale = animScaleMix(params.minimumScale, point.scale.xyz, reveal);
+    sample.opacity = point.positionOpacity.w * animStep(0.0f, params.time * 0.5f + (position.y - origin.y) - 0.5f);
+    return sample;
+}
+
+inline AnimationSample animTwister(SplatAnimationSourcePoint point, AnimationSample sample,
+                                   constant SplatAnimationParams &params, float3 origin) {
+    float3 position = point.positionOpacity.xyz;
+    float3 local = position - origin;
+    float3 h = animHash3(position);
+    float radial = length(local.xz);
+    float s = animSmoothStep(0.0f, 8.0f, params.time * params.time * 0.1f - radial * 2.0f + 2.0f);
+    float scaleLength = length(point.scale.xyz);
+
+    if (scaleLength < 0.05f) {
+        local.y = animMix(-10.0f, local.y, animPow(s, 2.0f * h.x));
+    }
+
+    float radialFactor = animPow(s, 2.0f * h.x);
+    float2 xz = animMix(local.xz * 0.5f, local.xz, radialFactor);
+    float rotationTime = params.time * (1.0f - s) * 0.2f * max(params.intensity, 0.1f);
+    float swirl = rotationTime + local.y * 20.0f * (1.0f - s) * exp(-length(xz));
+    float2 spun = animRotateXZ(xz, swirl);
+
+    sample.position = origin + float3(spun.x, local.y, spun.y);
+    sample.scale = animScaleMix(params.minimumScale, point.scale.xyz, animPow(s, 12.0f));
+    sample.rotation = animRotateAroundY(point.rotation, -params.time * 0.3f * (1.0f - s));
+    sample.opacity = point.positionOpacity.w * animPow(s, 4.0f);
+    return sample;
+}
+
+inline AnimationSample animRain(SplatAnimationSourcePoint point, AnimationSample sample,
+                                constant SplatAnimationParams &params, float3 origin) {
+    float3 position = point.positionOpacity.xyz;
+    float3 h = animHash3(position);
+    float3 local = position - origin;
+    float originalY = local.y;
+    float radial = length(local.xz);
+    float exponent = 0.5f + h.x;
+    float s = animPow(max(animSmoothStep(0.0f, 5.0f, params.time * params.time * 0.1f - radial * 2.0f + 1.0f), 0.0f), exponent);
+
+    local.y = min(-10.0f + s * 15.0f, local.y);
+    float2 scaledXZ = animMix(local.xz * 0.3f, local.xz, s);
+    float2 spun = animRotateXZ(scaledXZ, params.time * 0.3f * max(params.intensity, 0.1f));
+
+    sample.position = origin + float3(spun.x, local.y, spun.y);
+    sample.scale = animScaleMix(max(params.minimumScale, 0.005f), point.scale.xyz, animPow(s, 30.0f));
+    sample.rotation = animRotateAroundY(point.rotation, -params.time * 0.3f);
+    sample.opacity = point.positionOpacity.w * animSmoothStep(-10.0f, originalY, local.y);
+    return sample;
+}
+
+inline AnimationSample animSpherical(SplatAnimationSourcePoint point, AnimationSample sample,
+                                     constant SplatAnimationParams &params, uint sceneIndex, float3 origin) {
+    // transitionNormTime(stay: 0, transition: 1)
+    uint sceneCount = params.sceneCount;
+    float cycle = 1.0f;
+    float total = max(float(sceneCount), 1.0f) * cycle;
+    float wrapped = animPositiveMod(params.time, total);
+    float fadeInStart = float(sceneIndex) * cycle;
+    float fadeOutStart = float((sceneIndex + 1) % sceneCount) * cycle;
+    bool fadeIn = wrapped >= fadeInStart && wrapped < fadeInStart + 1.0f;
+    bool fadeOut = wrapped >= fadeOutStart && wrapped < fadeOutStart + 1.0f;
+    float t = animPositiveMod(wrapped, cycle) / cycle;
+
+    if (!(fadeIn || fadeOut)) {
+        sample.opacity = 0.0f;
+        return sample;
+    }
+
+    float3 local = point.positionOpacity.xyz - origin;
+    float3 targetCenter = float3(0.0f, (0.5f + 0.5f * animPow(abs(1.0f - 2.0f * t), 0.2f)) * params.height, 0.0f);
+    float3 dir = normalize(local - targetCenter);
+    float3 targetPoint = targetCenter + dir * params.radius;
+
+    float3 transformed = local;
+    if (t >= 0.25f && t < 0.45f) {
+        transformed = animMix(local, targetPoint, animPow((t - 0.25f) * 5.0f, 4.0f));
+    } else if (t >= 0.45f && t < 0.55f) {
+        float transitionT = (t - 0.45f) * 10.0f;
+        float churnAngle = transitionT * 2.0f * M_PI_F;
+        float3 rotVec = float3(sin(churnAngle), 0.0f, cos(churnAngle));
+        transformed = targetPoint + cross(dir, rotVec) * 0.1f * sin(transitionT * M_PI_F) * params.intensity;
+    } else if (t >= 0.55f && t < 0.75f) {
+        transformed = animMix(targetPoint, local, animPow((t - 0.55f) * 5.0f, 4.0f));
+    }
+
+    float3 scale = point.scale.xyz;
+    float scaleFactor;
+    if (t < 0.25f || t >= 0.75f) {
+        scaleFactor = 1.0f;
+    } else if (t < 0.45f) {
+        scaleFactor = animMix(1.0f, animMinimumScaleScale(scale, params.minimumScale), animPow((t - 0.25f) * 5.0f, 2.0f));
+    } else if (t < 0.55f) {
+        scaleFactor = animMinimumScaleScale(scale, params.minimumScale);
+    } else {
+        scaleFactor = animMix(animMinimumScaleScale(scale, params.minimumScale), 1.0f, animPow((t - 0.55f) * 5.0f, 2.0f));
+    }
+
+    sample.position = origin + transformed;
+    sample.scale = max(scale * scaleFactor, float3(params.minimumScale));
+    sample.opacity = point.positionOpacity.w * animSceneFadeAlpha(t, fadeIn);
+    return sample;
+}
+
+inline AnimationSample animExplosion(SplatAnimationSourcePoint point, AnimationSample sample,
+                                     constant SplatAnimationParams &params, uint sceneIndex, float3 origin) {
+    uint sceneCount = params.sceneCount;
+    float idleDuration = max(params.holdDuration, 0.0f);
+    float cycle = idleDuration + max(params.duration, 0.25f);
+    float total = max(float(sceneCount), 1.0f) * cycle;
+    float wrapped = animPositiveMod(params.time, total);
+    uint currentScene = uint(floor(wrapped / cycle)) % sceneCount;
+    uint nextScene = (currentScene + 1) % sceneCount;
+    float local = animPositiveMod(wrapped, cycle);
+    bool inTransition = local >= idleDuration;
+    float transitionTime = max(local - idleDuration, 0.0f);
+
+    float3 original = point.positionOpacity.xyz;
+    float3 scale = point.scale.xyz;
+
+    if (sceneIndex == currentScene) {
+        if (!inTransition || transitionTime <= 0.0f) {
+            return sample;
+        }
+
+        // simulatedExplosion(friction: 0.98, shrinkSpeed: 2)
+        float strength = params.explosionStrength * max(params.intensity, 0.25f);
+        float friction = 0.98f;
+        float timeVariation = animSparkHash(original + 42.0f) * 0.2f - 0.1f;
+        float adjustedDropTime = max(0.0f, transitionTime + timeVariation);
+        float3 velocity = float3(
+            (animSparkHash(original + 1.0f) - 0.5f) * strength * (0.3f + animSparkHash(original + 10.0f) * 0.4f),
+            abs(animSparkHash(original + 3.0f)) * strength * (0.8f + animSparkHash(original + 20.0f) * 0.4f) + 0.5f,
+            (animSparkHash(original + 2.0f) - 0.5f) * strength * (0.3f + animSparkHash(original + 30.0f) * 0.4f));
+        float frictionDecay = animPow(friction, adjustedDropTime * 60.0f);
+
+        float3 position = original;
+        float frictionDivisor = max(1.0f - friction, 0.0001f);
+        position.x += velocity.x * (1.0f - frictionDecay) / frictionDivisor / 60.0f;
+        position.z += velocity.z * (1.0f - frictionDecay) / frictionDivisor / 60.0f;
+        position.y += velocity.y * adjustedDropTime - 0.5f * params.gravity * adjustedDropTime * adjustedDropTime;
+        if (position.y <= params.floorLevel) {
+            float bounceCount = floor(adjustedDropTime * 3.0f);
+            float timeSinceBounce = adjustedDropTime - bounceCount / 3.0f;
+            float bounceHeight = velocity.y * animPow(params.bounceDamping, bounceCount) * max(0.0f, 1.0f - timeSinceBounce * 3.0f);
+            if (bounceHeight > 0.1f) {
+                position.y = params.floorLevel + abs(sin(timeSinceBounce * M_PI_F * 3.0f)) * bounceHeight;
+            } else {
+                position.y = params.floorLevel;
+                float scatterFactor = animSparkHash(original + 50.0f) * 0.2f;
+                position.x += (animSparkHash(original + 60.0f) - 0.5f) * scatterFactor;
+                position.z += (animSparkHash(original + 70.0f) - 0.5f) * scatterFactor;
+            }
+        }
+
+        float factor = exp(-transitionTime * 2.0f);
+        float3 targetScale = float3(max(params.minimumScale, 0.005f));
+        sample.position = position;
+        sample.scale = animMix(scale, targetScale, 1.0f - factor);
+        return sample;
+    }
+
+    if (sceneIndex == nextScene && inTransition) {
+        float birthDuration = 0.5f;
+        if (transitionTime >= birthDuration) {
+            return sample;
+        }
+
+        // birthedExplosion
+        float progress = animClamp(transitionTime / max(birthDuration, 0.0001f), 0.0f, 1.0f);
+        float birthOffset = animSparkHash(original) * 0.1f;
+        float adjusted = animClamp((progress - birthOffset / birthDuration) / max(1.0f - birthOffset / birthDuration, 0.0001f), 0.0f, 1.0f);
+        float eased = animPow(animEase(adjusted), 0.6f);
+        sample.position = animMix(origin, original, eased);
+        sample.scale = animMix(float3(params.minimumScale), scale, eased);
+        sample.opacity = point.positionOpacity.w * eased;
+        return sample;
+    }
+
+    sample.opacity = 0.0f;
+    return sample;
+}
+
+inline AnimationSample animFlow(SplatAnimationSourcePoint point, AnimationSample sample,
+                                constant SplatAnimationParams &params, uint globalIndex, uint sceneIndex,
+                                const device SplatAnimationSceneData *sceneData) {
+    uint sceneCount = params.sceneCount;
+    float cycle = max(1.0f + params.holdDuration, 1.1f);
+    float total = float(sceneCount) * cycle;
+    float wrapped = animPositiveMod(params.time, total);
+    float local = animPositiveMod(wrapped, cycle);
+    float normT = local > 1.0f ? 1.0f : local;
+    float fade = abs(animMix(-1.0f, 1.0f, normT));
+    uint nextScene = (sceneIndex + 1) % sceneCount;
+    float3 centerNext = sceneData[nextScene].centerOfMass.xyz;
+    float3 centerOwn = sceneData[sceneIndex].centerOfMass.xyz;
+    float3 original = point.positionOpacity.xyz;
+    float blend = animPow(fade, 0.5f + animSparkHash11(float(globalIndex)) * 2.0f);
+    float3 position = normT < 0.5f ? animMix(centerNext, original, blend) : animMix(centerOwn, original, blend);
+    float3 waveSample = sin(position * 2.5f);
+    float waveStrength = length(waveSample) * params.waves * (1.0f - fade) * animSmoothStep(0.5f, 0.0f, normT) * 2.0f * max(params.intensity, 0.0f);
+    position += float3(waveStrength);
+
+    float3 scale = point.scale.xyz;
+    sample.position = position;
+    float3 collapsedScale = max(scale * 0.2f, float3(params.minimumScale));
+    sample.scale = animMix(collapsedScale, scale, animPow(fade, 3.0f));
+    uint activeScene = uint(floor(animPositiveMod(params.time + params.holdDuration + 0.5f, total) / cycle)) % sceneCount;
+    float alpha = activeScene == sceneIndex ? 0.1f + fade : 0.0f;
+    sample.opacity = point.positionOpacity.w * alpha;
+    sample.tint = float3(0.5f + fade * 0.5f);
+    return sample;
+}
+
+inline AnimationSample animMorph(SplatAnimationSourcePoint point, AnimationSample sample,
+                                 constant SplatAnimationParams &params, uint globalIndex, uint sceneIndex, float3 origin) {
+    uint sceneCount = params.sceneCount;
+    float stay = max(params.holdDuration, 0.1f);
+    float trans = max(params.transitionDuration, 0.1f);
+    float cycle = stay + trans;
+    float total = float(sceneCount) * cycle;
+    float wrapped = animPositiveMod(params.time, total);
+    uint current = uint(floor(wrapped / cycle)) % sceneCount;
+    uint next = (current + 1) % sceneCount;
+    float local = animPositiveMod(wrapped, cycle);
+    bool inTransition = local > stay;
+    float phase = inTransition ? animClamp((local - stay) / trans, 0.0f, 1.0f) : 0.0f;
+    float scatterPhase = phase < 0.5f ? phase / 0.5f : (phase - 0.5f) / 0.5f;
+    float eased = animEase(scatterPhase);
+
+    // randomMorphPosition
+    float3 h = animSparkHash3(globalIndex);
+    float theta = 2.0f * M_PI_F * h.x;
+    float r = params.randomRadius * sqrt(h.y);
+    float3 randomMid = float3(r * cos(theta), 0.0f, r * sin(theta)) + origin;
+
+    float3 original = point.positionOpacity.xyz;
+    float3 scale = point.scale.xyz;
+    float opacity = point.positionOpacity.w;
+    float3 midpoint = animMix(original, randomMid, 0.7f);
+    float3 small = max(scale * 0.2f, float3(params.minimumScale));
+
+    if (sceneIndex == current) {
+        if (!inTransition) {
+            sample.opacity = opacity;
+        } else if (phase < 0.5f) {
+            sample.position = animMix(original, midpoint, eased);
+            sample.scale = animMix(scale, small, eased);
+            sample.opacity = opacity * (1.0f - eased * 0.5f);
+        } else {
+            sample.position = midpoint;
+            sample.scale = small;
+            sample.opacity = 0.0f;
+        }
+    } else if (sceneIndex == next) {
+        if (!inTransition || phase < 0.5f) {
+            sample.position = midpoint;
+            sample.scale = small;
+            sample.opacity = 0.0f;
+        } else {
+            sample.position = animMix(midpoint, original, eased);
+            sample.scale = animMix(small, scale, eased);
+            sample.opacity = opacity * max(eased, 0.5f);
+        }
+    } else {
+        sample.opacity = 0.0f;
+    }
+    return sample;
+}
+
+// MARK: - Dispatch
+
+inline AnimationSample animateSplat(uint index,
+                                    constant SplatAnimationParams &params,
+                                    const device SplatAnimationSourcePoint *sourcePoints,
+                                    const device uint *sceneIndices,
+                                    const device SplatAnimationSceneData *sceneData) {
+    SplatAnimationSourcePoint point = sourcePoints[index];
+
+    AnimationSample sample;
+    sample.position = point.positionOpacity.xyz;
+    sample.scale = point.scale.xyz;
+    sample.rotation = point.rotation;
+    sample.opacity = point.positionOpacity.w;
+    sample.tint = float3(1.0f);
+
+    if (params.sceneCount == 0) {
+        return sample;
+    }
+
+    uint sceneIndex = sceneIndices[index];
+    uint metricsIndex = min(sceneIndex, params.sceneCount - 1);
+    float3 origin = params.hasOrigin != 0 ? params.origin.xyz : sceneData[metricsIndex].center.xyz;
+
+    switch (params.effect) {
+        case AnimationEffectMagic:
+            return animMagic(point, sample, params, origin);
+        case AnimationEffectSpread:
+            return animSpread(point, sample, params, origin);
+        case AnimationEffectUnroll:
+            return animUnroll(point, sample, params, origin);
+        case AnimationEffectTwister:
+            return animTwister(point, sample, params, origin);
+        case AnimationEffectRain:
+            return animRain(point, sample, params, origin);
+        case AnimationEffectSpherical:
+            return animSpherical(point, sample, params, sceneIndex, origin);
+        case AnimationEffectExplosion:
+            return animExplosion(point, sample, params, sceneIndex,
+                                 params.hasOrigin != 0 ? params.origin.xyz : float3(0.0f));
+        case AnimationEffectFlow:
+            return animFlow(point, sample, params, index, metricsIndex, sceneData);
+        case AnimationEffectMorph:
+            return animMorph(point, sample, params, index, sceneIndex, origin);
+        default:
+            return sample;
+    }
+}
+
+// Same covariance construction as SplatRenderer.Splat.init(position:color:scale:rotation:)
+inline void animCovariance(float4 rotation, float3 scale, thread packed_half3 &covA, thread packed_half3 &covB) {
+    float4 q = rotation / max(length(rotation), 1e-8f);
+    float x = q.x, y = q.y, z = q.z, w = q.w;
+
+    float3x3 rotationMatrix = float3x3(float3(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y + w * z), 2.0f * (x * z - w * y)),
+                                       float3(2.0f * (x * y - w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z + w * x)),
+                                       float3(2.0f * (x * z + w * y), 2.0f * (y * z - w * x), 1.0f - 2.0f * (x * x + y * y)));
+    float3x3 transform = float3x3(rotationMatrix[0] * scale.x,
+                                  rotationMatrix[1] * scale.y,
+                                  rotationMatrix[2] * scale.z);
+    float3x3 cov3D = transform * transpose(transform);
+
+    covA = packed_half3(half(cov3D[0][0]), half(cov3D[0][1]), half(cov3D[0][2]));
+    covB = packed_half3(half(cov3D[1][1]), half(cov3D[1][2]), half(cov3D[2][2]));
+}
+
+inline float3 animSRGBToLinear(float3 color) {
+    return float3(animPow(color.x, 2.2f), animPow(color.y, 2.2f), animPow(color.z, 2.2f));
+}
+
+// Animate every source splat into a Splat buffer (tint baked into the packed color)
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void animateSplats(constant SplatAnimationParams &params [[buffer(0)]],
+                          const device SplatAnimationSourcePoint *sourcePoints [[buffer(1)]],
+                          const device uint *sceneIndices [[buffer(2)]],
+                          const device SplatAnimationSceneData *sceneData [[buffer(3)]],
+                          device Splat *outputSplats [[buffer(4)]],
+                          uint index [[thread_position_in_grid]]) {
+    if (index >= params.pointCount) return;
+
+    AnimationSample sample = animateSplat(index, params, sourcePoints, sceneIndices, sceneData);
+    float3 tintedColor = clamp(sourcePoints[index].color.xyz * sample.tint, float3(0.0f), float3(4.0f));
+
+    Splat splat;
+    splat.position = packed_float3(sample.position);
+    splat.packedColor = pack_float_to_unorm4x8(float4(animSRGBToLinear(tintedColor), sample.opacity));
+    animCovariance(sample.rotation, sample.scale, splat.covA, splat.covB);
+    outputSplats[index] = splat;
+}
+
+// Animate every source splat into a SplatSH buffer (tint kept separate for SH evaluation)
+[[kernel, max_total_threads_per_threadgroup(256)]]
+kernel void animateSplatsSH(constant SplatAnimationParams &params [[buffer(0)]],
+                            const device SplatAnimationSourcePoint *sourcePoints [[buffer(1)]],
+                            const device uint *sceneIndices [[buffer(2)]],
+                            const device SplatAnimationSceneData *sceneData [[buffer(3)]],
+                            device AnimatedSplatSH *outputSplats [[buffer(4)]],
+                            const device uint *shPaletteIndices [[buffer(5)]],
+                            constant uint &shDegree [[buffer(6)]],
+                            uint index [[thread_position_in_grid]]) {
+    if (index >= params.pointCount) return;
+
+    AnimationSample sample = animateSplat(index, params, sourcePoints, sceneIndices, sceneData);
+    float3 baseColor = max(sourcePoints[index].color.xyz, float3(0.0f));
+    uint paletteIndex = shPaletteIndices[index];
+
+    AnimatedSplatSH splat;
+    splat.position = packed_float3(sample.position);
+    splat.packedBaseColor = pack_float_to_unorm4x8(float4(animSRGBToLinear(baseColor), sample.opacity));
+    splat.tintColor = float4(sample.tint, 1.0f);
+    splat.rotation = sample.rotation / max(length(sample.rotation), 1e-8f);
+    animCovariance(sample.rotation, sample.scale, splat.covA, splat.covB);
+    splat.shPaletteIndex = paletteIndex;
+    splat.shDegree = paletteIndex != 0xFFFFFFFFu ? ushort(shDegree) : ushort(0);
+    splat.padding = 0;
+    outputSplats[index] = splat;
+}
@@ -204,6 +204,18 @@ static FragmentIn splatVertexInternal(Splat splat,
                                     uniforms.isOrthographic,
                                     opacityScale);
 
+    if (uniforms.foveationEnabled != 0u) {
+        // Quads are sized in logical pixels, but a zone at rate r shades one physical pixel per 1/r logical ones.
+        // Widen the low-pass filter to a physical pixel there so peripheral splats don't alias.
+        float rateX = foveationRate(uniforms.foveationRatesX, ndc.x * 0.5f + 0.5f);
+        float rateY = foveationRate(uniforms.foveationRatesY, 0.5f - ndc.y * 0.5f);
+        float3 covFiltered = float3(cov2D.x + uniforms.covarianceBlur * (1.0f / (rateX * rateX) - 1.0f),
+                                    cov2D.y,
+                                    cov2D.z + uniforms.covarianceBlur * (1.0f / (rateY * rateY) - 1.0f));
+        opacityScale *= opacityCompensation(cov2D, covFiltered, uniforms.renderMode);
+        cov2D = covFiltered;
+    }
+
     float2 axis1;
     float2 axis2;
     decomposeCovariance(cov2D, axis1, axis2);
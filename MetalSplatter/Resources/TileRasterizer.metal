@@ -0,0 +1,271 @@
+#include "SplatProcessing.h"
+
+// Tile-binned compute rasterizer (3DGS-style splatting)
+//
+// An alternative to the hardware-blended quad paths, for dense captures where overdraw of
+// large low-alpha splats dominates:
+// 1. tileRasterProjectSplats: per splat, project the Gaussian (same math as the vertex paths),
+//    then emit one (tile, depth) key per 16x16 tile its 3-sigma footprint touches
+// 2. The keys are sorted with the stable radix passes in Metal4AdvancedAtomics.metal; tile ID
+//    is the key's high bits, so each tile's entries end up contiguous and front-to-back
+// 3. tileRasterIdentifyRanges: find each tile's [start, end) in the sorted keys (dispatched
+//    indirectly from the GPU-side entry count)
+// 4. tileRasterBlend: one threadgroup per tile streams its splats through threadgroup memory
+//    and blends front-to-back per pixel, stopping once every pixel is saturated
+// 5. tileRasterComposite*: draws the premultiplied result over the render target
+//
+// Keys are packed as (tile << depthBits) | depth, where depth is the top bits of the positive
+// view depth's float encoding (monotonic, scale-free). Unused key slots hold 0xFFFFFFFF, whose
+// tile ID is reserved, so they sort last and are never part of a tile range.
+
+constant uint TILE_RASTER_TILE_SIZE = 16;
+constant uint TILE_RASTER_THREADS = TILE_RASTER_TILE_SIZE * TILE_RASTER_TILE_SIZE;
+constant uint TILE_RASTER_EMPTY_KEY = 0xFFFFFFFFu;
+
+// Keep in sync with TileRasterizer.swift
+struct TileRasterParams {
+    uint2 screenSize;       // Pixels rasterized (the viewport size)
+    uint2 tileCount;        // Tiles per row/column
+    uint splatCount;
+    uint entryCapacity;     // Key slots; entries past this are dropped for the frame
+    uint depthBits;         // Low key bits holding depth; the rest hold the tile ID
+    uint padding;
+};
+
+// Same layout as advanced_atomics::SortingKey (the radix passes only read the first word's bits)
+struct TileRasterEntry {
+    uint key;
+    uint splatIndex;
+};
+
+struct TileRasterSplat {
+    float4 conicOpacity;    // xyz = inverse 2D covariance (y up), w = opacity
+    float2 center;          // Pixels, y down
+    half4 color;            // rgb, a unused
+};
+
+struct TileRasterDispatchArguments {
+    uint threadgroupsPerGrid[3];
+};
+
+[[kernel]]
+void tileRasterProjectSplats(device const Splat* splats [[buffer(0)]],
+                             constant UniformsArray& uniformsArray [[buffer(1)]],
+                             constant TileRasterParams& params [[buffer(2)]],
+                             device TileRasterSplat* projected [[buffer(3)]],
+                             device TileRasterEntry* entries [[buffer(4)]],
+                             device atomic_uint* entryCount [[buffer(5)]],
+                             const device uchar* editStates [[buffer(6)]],
+                             constant bool& hasEditStates [[buffer(7)]],
+                             uint index [[thread_position_in_grid]]) {
+    if (index >= params.splatCount) {
+        return;
+    }
+    if (hasEditStates && (editStates[index] & ((1u << 1) | (1u << 3))) != 0u) {
+        return;
+    }
+
+    Uniforms uniforms = uniformsArray.uniforms[0];
+    Splat splat = splats[index];
+    float3 splatPos = float3(splat.position);
+    float3 viewPosition = (uniforms.viewMatrix * float4(splatPos, 1.0)).xyz;
+    if (viewPosition.z >= 0.0) {
+        return;
+    }
+
+    // Same frustum test as the vertex paths
+    float4 clipPosition = uniforms.projectionMatrix * float4(viewPosition, 1.0);
+    float safeW = (abs(clipPosition.w) < kDivisionEpsilon) ? copysign(kDivisionEpsilon, clipPosition.w) : clipPosition.w;
+    float3 ndc = clipPosition.xyz / safeW;
+    if (ndc.z > 1.0f || any(abs(ndc.xy) > 1.2f)) {
+        return;
+    }
+
+    float opacityScale = 1.0f;
+    float3 cov2D = calcCovariance2D(viewPosition, splat.covA, splat.covB,
+                                    uniforms.viewMatrix,
+                                    uniforms.focalX, uniforms.focalY,
+                                    uniforms.tanHalfFovX, uniforms.tanHalfFovY,
+                                    uniforms.covarianceBlur,
+                                    uniforms.renderMode,
+                                    uniforms.isOrthographic,
+                                    opacityScale);
+    float det = covarianceDeterminant(cov2D);
+    if (det <= 0.0f) {
+        return;
+    }
+
+    // 3-sigma radius along the major axis, matching the quad extent of the vertex paths
+    float mean = 0.5f * (cov2D.x + cov2D.z);
+    float lambda1 = mean + max(0.1f, sqrt(max(mean * mean - det, 0.0f)));
+    float radius = float(kBoundsRadius) * sqrt(lambda1);
+    if (radius < 0.5f) {
+        return;
+    }
+
+    float2 screenSize = float2(params.screenSize);
+    float2 center = float2((ndc.x * 0.5f + 0.5f) * screenSize.x,
+                           (0.5f - ndc.y * 0.5f) * screenSize.y);
+    int2 tileMin = clamp(int2(floor((center - radius) / float(TILE_RASTER_TILE_SIZE))),
+                         int2(0), int2(params.tileCount));
+    int2 tileMax = clamp(int2(ceil((center + radius) / float(TILE_RASTER_TILE_SIZE))),
+                         int2(0), int2(params.tileCount));
+    uint2 tileExtent = uint2(tileMax - tileMin);
+    uint touched = tileExtent.x * tileExtent.y;
+    if (touched == 0) {
+        return;
+    }
+
+    half4 color = unpackSplatColor(splat.packedColor);
+    TileRasterSplat out;
+    out.conicOpacity = float4(cov2D.z / det, -cov2D.y / det, cov2D.x / det,
+                              min(float(color.a) * opacityScale, 0.99f));
+    out.center = center;
+    out.color = color;
+    projected[index] = out;
+
+    // Positive floats sort as their bit patterns; drop the (always zero) sign bit first
+    uint depthKey = (as_type<uint>(-viewPosition.z) << 1) >> (32u - params.depthBits);
+    uint base = atomic_fetch_add_explicit(entryCount, touched, memory_order_relaxed);
+    for (uint k = 0; k < touched && base + k < params.entryCapacity; k++) {
+        uint2 tile = uint2(tileMin) + uint2(k % tileExtent.x, k / tileExtent.x);
+        uint tileIndex = tile.y * params.tileCount.x + tile.x;
+        entries[base + k].key = (tileIndex << params.depthBits) | depthKey;
+        entries[base + k].splatIndex = index;
+    }
+}
+
+// Sizes the range pass from the GPU-side entry count, so the CPU never needs it
+[[kernel]]
+void tileRasterPrepareDispatch(device const uint* entryCount [[buffer(0)]],
+                               constant TileRasterParams& params [[buffer(1)]],
+                               device TileRasterDispatchArguments* dispatchArgs [[buffer(2)]],
+                               uint index [[thread_position_in_grid]]) {
+    if (index != 0) {
+        return;
+    }
+    uint entries = min(entryCount[0], params.entryCapacity);
+    dispatchArgs->threadgroupsPerGrid[0] = max((entries + TILE_RASTER_THREADS - 1) / TILE_RASTER_THREADS, 1u);
+    dispatchArgs->threadgroupsPerGrid[1] = 1;
+    dispatchArgs->threadgroupsPerGrid[2] = 1;
+}
+
+[[kernel]]
+void tileRasterIdentifyRanges(device const TileRasterEntry* entries [[buffer(0)]],
+                              device uint2* tileRanges [[buffer(1)]],
+                              constant TileRasterParams& params [[buffer(2)]],
+                              device const uint* entryCount [[buffer(3)]],
+                              uint index [[thread_position_in_grid]]) {
+    uint count = min(entryCount[0], params.entryCapacity);
+    if (index >= count) {
+        return;
+    }
+
+    uint tile = entries[index].key >> params.depthBits;
+    if (index == 0 || (entries[index - 1].key >> params.depthBits) != tile) {
+        tileRanges[tile].x = index;
+    }
+    if (index + 1 == count || (entries[index + 1].key >> params.depthBits) != tile) {
+        tileRanges[tile].y = index + 1;
+    }
+}
+
+[[kernel, max_total_threads_per_threadgroup(256)]]
+void tileRasterBlend(device const TileRasterSplat* projected [[buffer(0)]],
+                     device const TileRasterEntry* entries [[buffer(1)]],
+                     device const uint2* tileRanges [[buffer(2)]],
+                     constant TileRasterParams& params [[buffer(3)]],
+                     texture2d<half, access::write> output [[texture(0)]],
+                     uint2 tile [[threadgroup_position_in_grid]],
+                     uint2 pixelInTile [[thread_position_in_threadgroup]],
+                     uint threadIndex [[thread_index_in_threadgroup]]) {
+    threadgroup float4 batchConicOpacity[TILE_RASTER_THREADS];
+    threadgroup float2 batchCenter[TILE_RASTER_THREADS];
+    threadgroup half3 batchColor[TILE_RASTER_THREADS];
+    threadgroup atomic_uint saturatedPixels;
+
+    uint2 pixel = tile * TILE_RASTER_TILE_SIZE + pixelInTile;
+    bool inside = all(pixel < params.screenSize);
+    float2 pixelCenter = float2(pixel) + 0.5f;
+
+    uint2 range = tileRanges[tile.y * params.tileCount.x + tile.x];
+    float transmittance = 1.0f;
+    float3 accumulated = float3(0.0f);
+    bool done = !inside;
+
+    for (uint batchStart = range.x; batchStart < range.y; batchStart += TILE_RASTER_THREADS) {
+        // Early termination: stop once every pixel of the tile is saturated
+        if (threadIndex == 0) {
+            atomic_store_explicit(&saturatedPixels, 0, memory_order_relaxed);
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+        if (done) {
+            atomic_fetch_add_explicit(&saturatedPixels, 1, memory_order_relaxed);
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+        if (atomic_load_explicit(&saturatedPixels, memory_order_relaxed) == TILE_RASTER_THREADS) {
+            break;
+        }
+
+        // Stage this batch of splats in threadgroup memory
+        uint entry = batchStart + threadIndex;
+        if (entry < range.y) {
+            TileRasterSplat splat = projected[entries[entry].splatIndex];
+            batchConicOpacity[threadIndex] = splat.conicOpacity;
+            batchCenter[threadIndex] = splat.center;
+            batchColor[threadIndex] = splat.color.rgb;
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+
+        uint batchCount = min(TILE_RASTER_THREADS, range.y - batchStart);
+        for (uint j = 0; !done && j < batchCount; j++) {
+            float4 conicOpacity = batchConicOpacity[j];
+            // The conic is in y-up screen space, like the covariance
+            float2 d = float2(pixelCenter.x - batchCenter[j].x, batchCenter[j].y - pixelCenter.y);
+            float power = -0.5f * (conicOpacity.x * d.x * d.x + conicOpacity.z * d.y * d.y) - conicOpacity.y * d.x * d.y;
+            // Same 3-sigma cutoff as splatFragmentAlpha
+            if (power > 0.0f || power < -0.5f * float(kBoundsRadiusSquared)) {
+                continue;
+            }
+            float alpha = min(0.99f, conicOpacity.w * fast::exp(power));
+            if (alpha < 1.0f / 255.0f) {
+                continue;
+            }
+            float nextTransmittance = transmittance * (1.0f - alpha);
+            if (nextTransmittance < 1e-4f) {
+                done = true;
+                break;
+            }
+            accumulated += float3(batchColor[j]) * alpha * transmittance;
+            transmittance = nextTransmittance;
+        }
+        threadgroup_barrier(mem_flags::mem_threadgroup);
+    }
+
+    if (inside) {
+        output.write(half4(half3(accumulated), half(1.0f - transmittance)), pixel);
+    }
+}
+
+struct TileRasterCompositeVertexOut {
+    float4 position [[position]];
+};
+
+vertex TileRasterCompositeVertexOut tileRasterCompositeVertex(uint vertexID [[vertex_id]]) {
+    // Fullscreen triangle
+    float2 uv = float2((vertexID << 1) & 2, vertexID & 2);
+    TileRasterCompositeVertexOut out;
+    out.position = float4(uv * 2.0f - 1.0f, 0.0f, 1.0f);
+    return out;
+}
+
+fragment half4 tileRasterCompositeFragment(TileRasterCompositeVertexOut in [[stage_in]],
+                                           texture2d<half, access::read> image [[texture(0)]],
+                                           constant float2& viewportOrigin [[buffer(0)]]) {
+    float2 position = in.position.xy - viewportOrigin;
+    if (any(position < 0.0f) || position.x >= float(image.get_width()) || position.y >= float(image.get_height())) {
+        return half4(0);
+    }
+    // Premultiplied; blended with (one, oneMinusSourceAlpha) like the quad paths
+    return image.read(uint2(position));
+}
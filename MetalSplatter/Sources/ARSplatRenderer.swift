@@ -174,6 +174,17 @@ public class ARSplatRenderer: NSObject {
         set { splatRenderer.covarianceBlur = newValue }
     }
 
+    /// Draws splats through a rate map built from where they land on screen, so sparse regions of the camera frame
+    /// shade fewer fragments. Ignored on devices without rasterization rate map support.
+    public var foveatedRenderingEnabled: Bool = false
+
+    /// Frame-time governor for the splat renderer. While set, poor tracking raises its `levelFloor` instead of
+    /// adjusting sort thresholds directly.
+    public var qualityGovernor: SplatQualityGovernor? {
+        get { splatRenderer.qualityGovernor }
+        set { splatRenderer.qualityGovernor = newValue }
+    }
+
     /// Enable/disable Fast SH evaluation (if FastSHSplatRenderer is in use)
     public var fastSHEnabled: Bool {
         get { fastSHRenderer?.fastSHConfig.enabled ?? false }
@@ -907,6 +918,18 @@ public class ARSplatRenderer: NSObject {
 
     /// Apply render mode to splat renderer
     private func applyRenderMode(_ mode: UInt32) {
+        if let qualityGovernor = splatRenderer.qualityGovernor {
+            // The governor owns the knobs; tracking quality only caps how high it may go
+            switch mode {
+            case 0: qualityGovernor.levelFloor = 2
+            case 1: qualityGovernor.levelFloor = 1
+            case 2: qualityGovernor.levelFloor = 0
+            default: break
+            }
+            logVerbose("ARSplatRenderer: Tracking quality mode \(mode), governor level floor \(qualityGovernor.levelFloor)")
+            return
+        }
+
         switch mode {
         case 0: // Basic quality - reduce splat density for performance
             splatRenderer.sortDirectionEpsilon = 0.2 // Less frequent sorting
@@ -985,7 +1008,16 @@ public class ARSplatRenderer: NSObject {
             hasLoggedRenderPath = true
             logActiveRenderingPath()
         }
-        
+
+        if foveatedRenderingEnabled {
+            try splatRenderer.renderFoveated(viewport: viewport,
+                                             colorTexture: drawable.texture,
+                                             colorLoadAction: .load, // Preserve AR background
+                                             colorStoreAction: .store,
+                                             to: commandBuffer)
+            return
+        }
+
         try splatRenderer.render(
             viewports: [viewport],
             colorTexture: drawable.texture,
@@ -95,6 +95,8 @@ internal class CountingSorter {
     private let histogramNoEditPipeline: MTLComputePipelineState
     private let histogramWeightedPipeline: MTLComputePipelineState
     private let histogramWeightedNoEditPipeline: MTLComputePipelineState
+    private let histogramPackedPipeline: MTLComputePipelineState
+    private let histogramWeightedPackedPipeline: MTLComputePipelineState
     private let prefixSumPipeline: MTLComputePipelineState
     private let scatterPipeline: MTLComputePipelineState
     private let scatterNoEditPipeline: MTLComputePipelineState
@@ -109,6 +111,37 @@ internal class CountingSorter {
     // Maximum block size based on device threadgroup memory
     private let maxPrefixSumBlockSize: Int
 
+    /// Times each pass when the renderer's frame timeline is on
+    var timelineRecorder: FrameTimelineRecorder?
+
+    /// When set, each sort carves its bin and cached-bin buffers from this arena and hands them back once encoded,
+    /// instead of keeping its own buffers sized for the largest sort so far
+    var scratchHeap: MetalScratchHeap? {
+        didSet {
+            if scratchHeap != nil {
+                histogramBuffer = nil
+                prefixSumBuffer = nil
+                binOffsetsBuffer = nil
+                cachedBinsBuffer = nil
+                blockSumsBuffer = nil
+                currentBinCount = 0
+                currentSplatCapacity = 0
+            }
+        }
+    }
+
+    private struct SortBuffers {
+        let histogram: MTLBuffer
+        let prefixSum: MTLBuffer
+        let binOffsets: MTLBuffer
+        let cachedBins: MTLBuffer
+        let blockSums: MTLBuffer?
+
+        var all: [MTLBuffer] {
+            [histogram, prefixSum, binOffsets, cachedBins] + (blockSums.map { [$0] } ?? [])
+        }
+    }
+
     // Reusable buffers (allocated once, reused across frames)
     private var histogramBuffer: MTLBuffer?
     private var prefixSumBuffer: MTLBuffer?
@@ -138,6 +171,12 @@ internal class CountingSorter {
         guard let histogramWeightedNoEditFunction = library.makeFunction(name: "countingSortHistogramWeightedNoEdit") else {
             throw SplatRendererError.failedToLoadShaderFunction(name: "countingSortHistogramWeightedNoEdit")
         }
+        guard let histogramPackedFunction = library.makeFunction(name: "countingSortHistogramPacked") else {
+            throw SplatRendererError.failedToLoadShaderFunction(name: "countingSortHistogramPacked")
+        }
+        guard let histogramWeightedPackedFunction = library.makeFunction(name: "countingSortHistogramWeightedPacked") else {
+            throw SplatRendererError.failedToLoadShaderFunction(name: "countingSortHistogramWeightedPacked")
+        }
         guard let prefixSumFunction = library.makeFunction(name: "countingSortPrefixSum") else {
             throw SplatRendererError.failedToLoadShaderFunction(name: "countingSortPrefixSum")
         }
@@ -170,6 +209,8 @@ internal class CountingSorter {
         histogramNoEditPipeline = try device.makeComputePipelineState(function: histogramNoEditFunction)
         histogramWeightedPipeline = try device.makeComputePipelineState(function: histogramWeightedFunction)
         histogramWeightedNoEditPipeline = try device.makeComputePipelineState(function: histogramWeightedNoEditFunction)
+        histogramPackedPipeline = try device.makeComputePipelineState(function: histogramPackedFunction)
+        histogramWeightedPackedPipeline = try device.makeComputePipelineState(function: histogramWeightedPackedFunction)
         prefixSumPipeline = try device.makeComputePipelineState(function: prefixSumFunction)
         scatterPipeline = try device.makeComputePipelineState(function: scatterFunction)
         scatterNoEditPipeline = try device.makeComputePipelineState(function: scatterNoEditFunction)
@@ -319,6 +360,37 @@ internal class CountingSorter {
         }
     }
 
+    private func sortBuffers(binCount: Int, splatCount: Int) throws -> SortBuffers {
+        guard let scratchHeap else {
+            try ensureBuffers(binCount: binCount, splatCount: splatCount)
+            guard let histogramBuffer, let prefixSumBuffer, let binOffsetsBuffer, let cachedBinsBuffer else {
+                throw SplatRendererError.failedToCreateBuffer(length: 0)
+            }
+            return SortBuffers(histogram: histogramBuffer,
+                               prefixSum: prefixSumBuffer,
+                               binOffsets: binOffsetsBuffer,
+                               cachedBins: cachedBinsBuffer,
+                               blockSums: blockSumsBuffer)
+        }
+
+        func scratch(_ length: Int, _ label: String) throws -> MTLBuffer {
+            guard let buffer = scratchHeap.makeBuffer(length: length, label: label) else {
+                throw SplatRendererError.failedToCreateBuffer(length: length)
+            }
+            return buffer
+        }
+        let binBufferSize = binCount * MemoryLayout<UInt32>.stride
+        let blockCount = (binCount + maxPrefixSumBlockSize - 1) / maxPrefixSumBlockSize
+        let blockSums = try blockCount > 1
+            ? scratch(blockCount * MemoryLayout<UInt32>.stride, "CountingSort BlockSums")
+            : nil
+        return SortBuffers(histogram: try scratch(binBufferSize, "CountingSort Histogram"),
+                           prefixSum: try scratch(binBufferSize, "CountingSort PrefixSum"),
+                           binOffsets: try scratch(binBufferSize, "CountingSort BinOffsets"),
+                           cachedBins: try scratch(splatCount * MemoryLayout<UInt16>.stride, "CountingSort CachedBins"),
+                           blockSums: blockSums)
+    }
+
     /// Computes depth bounds for all splats (can be cached if splats don't change)
     internal func computeDepthBounds(
         splats: UnsafeBufferPointer<SplatRenderer.Splat>,
@@ -360,7 +432,7 @@ internal class CountingSorter {
 
     /// Determines optimal bin count based on splat count
     /// Smaller scenes need fewer bins for efficiency
-    private func optimalBinCount(for splatCount: Int) -> Int {
+    static func optimalBinCount(for splatCount: Int) -> Int {
         if splatCount < 10_000 {
             return Self.minBinCount
         } else if splatCount < 100_000 {
@@ -372,6 +444,19 @@ internal class CountingSorter {
         }
     }
 
+    /// Bin counts `SortPathTuner` measures: the heuristic's, and half and double it within the supported range
+    static func binCountCandidates(for splatCount: Int) -> [Int] {
+        let heuristic = optimalBinCount(for: splatCount)
+        var candidates: [Int] = []
+        for binCount in [heuristic, heuristic / 2, heuristic * 2] {
+            let clamped = min(max(binCount, minBinCount), defaultBinCount)
+            if !candidates.contains(clamped) {
+                candidates.append(clamped)
+            }
+        }
+        return candidates
+    }
+
     /// Performs counting sort on splats
     /// - Parameters:
     ///   - commandBuffer: Command buffer to encode into
@@ -383,6 +468,9 @@ internal class CountingSorter {
     ///   - splatCount: Number of splats to sort
     ///   - depthBounds: Optional pre-computed depth bounds (min, max)
     ///   - useCameraRelativeBinning: When true, allocates more precision to near-camera splats
+    ///   - chunkHeaderBuffer: When set, `splatBuffer` holds `PackedSplat`s quantized against these chunk headers.
+    ///     Packed scenes have no edit states, so `editStateBuffer` is ignored.
+    ///   - binCount: Histogram bins, clamped to `minBinCount...defaultBinCount`; `optimalBinCount(for:)` when nil
     internal func sort(
         commandBuffer: MTLCommandBuffer,
         splatBuffer: MTLBuffer,
@@ -393,20 +481,23 @@ internal class CountingSorter {
         sortByDistance: Bool,
         splatCount: Int,
         depthBounds: (min: Float, max: Float)? = nil,
-        useCameraRelativeBinning: Bool = false
+        useCameraRelativeBinning: Bool = false,
+        chunkHeaderBuffer: MTLBuffer? = nil,
+        binCount: Int? = nil
     ) throws {
         guard splatCount > 0 else { return }
 
-        let binCount = optimalBinCount(for: splatCount)
-        try ensureBuffers(binCount: binCount, splatCount: splatCount)
-
-        guard let histogram = histogramBuffer,
-              let prefixSum = prefixSumBuffer,
-              let binOffsets = binOffsetsBuffer,
-              let cachedBins = cachedBinsBuffer else {
-            Self.log.error("Counting sort buffers not allocated")
-            return
+        let binCount = binCount.map { min(max($0, Self.minBinCount), Self.defaultBinCount) }
+            ?? Self.optimalBinCount(for: splatCount)
+        let buffers = try sortBuffers(binCount: binCount, splatCount: splatCount)
+        defer {
+            // Everything using the scratch is encoded by now (or abandoned with the command buffer on a throw)
+            scratchHeap?.recycle(buffers.all)
         }
+        let histogram = buffers.histogram
+        let prefixSum = buffers.prefixSum
+        let binOffsets = buffers.binOffsets
+        let cachedBins = buffers.cachedBins
 
         // Use provided bounds or compute them
         let bounds: (min: Float, max: Float)
@@ -428,13 +519,14 @@ internal class CountingSorter {
         var cameraFwd = cameraForward
         var sortByDist = sortByDistance
         var binCountVar = UInt32(binCount)
-        let shouldFilterEditingState = editStateBuffer != nil
+        let packed = chunkHeaderBuffer != nil
+        let shouldFilterEditingState = editStateBuffer != nil && !packed
 
         let threadsPerGroup = min(256, histogramPipeline.maxTotalThreadsPerThreadgroup)
         let threadgroups = (splatCount + threadsPerGroup - 1) / threadsPerGroup
 
         // Pass 1: Reset histogram
-        if let encoder = commandBuffer.makeComputeCommandEncoder() {
+        if let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) {
             encoder.label = "CountingSort Reset"
             encoder.setComputePipelineState(resetHistogramPipeline)
             encoder.setBuffer(histogram, offset: 0, index: 0)
@@ -449,11 +541,15 @@ internal class CountingSorter {
         }
 
         // Pass 2: Build histogram AND cache bin indices
-        if let encoder = commandBuffer.makeComputeCommandEncoder() {
+        if let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortKeys, with: timelineRecorder) {
             if useCameraRelativeBinning {
                 // Use camera-relative weighted binning for better near-camera precision
                 encoder.label = "CountingSort Histogram (Weighted)"
-                encoder.setComputePipelineState(shouldFilterEditingState ? histogramWeightedPipeline : histogramWeightedNoEditPipeline)
+                if packed {
+                    encoder.setComputePipelineState(histogramWeightedPackedPipeline)
+                } else {
+                    encoder.setComputePipelineState(shouldFilterEditingState ? histogramWeightedPipeline : histogramWeightedNoEditPipeline)
+                }
 
                 var binParams = computeCameraRelativeBinParams(
                     minDepth: bounds.min,
@@ -471,13 +567,19 @@ internal class CountingSorter {
                 encoder.setBytes(&sortByDist, length: MemoryLayout<Bool>.size, index: 5)
                 encoder.setBuffer(cachedBins, offset: 0, index: 6)
                 encoder.setBytes(&binParams, length: MemoryLayout<CameraRelativeBinParams>.size, index: 7)
-                if shouldFilterEditingState, let editStateBuffer {
+                if let chunkHeaderBuffer {
+                    encoder.setBuffer(chunkHeaderBuffer, offset: 0, index: 8)
+                } else if shouldFilterEditingState, let editStateBuffer {
                     encoder.setBuffer(editStateBuffer, offset: 0, index: 8)
                 }
             } else {
                 // Standard uniform binning
                 encoder.label = "CountingSort Histogram"
-                encoder.setComputePipelineState(shouldFilterEditingState ? histogramPipeline : histogramNoEditPipeline)
+                if packed {
+                    encoder.setComputePipelineState(histogramPackedPipeline)
+                } else {
+                    encoder.setComputePipelineState(shouldFilterEditingState ? histogramPipeline : histogramNoEditPipeline)
+                }
                 encoder.setBuffer(splatBuffer, offset: 0, index: 0)
                 encoder.setBuffer(histogram, offset: 0, index: 1)
                 encoder.setBytes(&params, length: MemoryLayout<CountingSortParams>.size, index: 2)
@@ -485,7 +587,9 @@ internal class CountingSorter {
                 encoder.setBytes(&cameraFwd, length: MemoryLayout<SIMD3<Float>>.size, index: 4)
                 encoder.setBytes(&sortByDist, length: MemoryLayout<Bool>.size, index: 5)
                 encoder.setBuffer(cachedBins, offset: 0, index: 6)
-                if shouldFilterEditingState, let editStateBuffer {
+                if let chunkHeaderBuffer {
+                    encoder.setBuffer(chunkHeaderBuffer, offset: 0, index: 7)
+                } else if shouldFilterEditingState, let editStateBuffer {
                     encoder.setBuffer(editStateBuffer, offset: 0, index: 7)
                 }
             }
@@ -501,12 +605,12 @@ internal class CountingSorter {
         // Use blocked approach for large bin counts that exceed threadgroup memory
         let blockCount = (binCount + maxPrefixSumBlockSize - 1) / maxPrefixSumBlockSize
 
-        if blockCount > 1, let blockSums = blockSumsBuffer {
+        if blockCount > 1, let blockSums = buffers.blockSums {
             // Blocked 3-phase prefix sum for large bin counts
             var blockSizeVar = UInt32(maxPrefixSumBlockSize)
 
             // Phase 1: Local prefix sum per block, output block totals
-            if let encoder = commandBuffer.makeComputeCommandEncoder() {
+            if let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) {
                 encoder.label = "CountingSort BlockPrefixSum"
                 encoder.setComputePipelineState(blockPrefixSumPipeline)
                 encoder.setBuffer(histogram, offset: 0, index: 0)
@@ -523,7 +627,7 @@ internal class CountingSorter {
             }
 
             // Phase 2: Prefix sum of block totals (small array, single-thread is fine)
-            if let encoder = commandBuffer.makeComputeCommandEncoder() {
+            if let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) {
                 encoder.label = "CountingSort BlockSumsPrefixSum"
                 encoder.setComputePipelineState(blockSumsPrefixSumPipeline)
                 encoder.setBuffer(blockSums, offset: 0, index: 0)
@@ -537,7 +641,7 @@ internal class CountingSorter {
             }
 
             // Phase 3: Add block prefix to each element
-            if let encoder = commandBuffer.makeComputeCommandEncoder() {
+            if let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) {
                 encoder.label = "CountingSort AddBlockPrefix"
                 encoder.setComputePipelineState(addBlockPrefixPipeline)
                 encoder.setBuffer(prefixSum, offset: 0, index: 0)
@@ -553,7 +657,7 @@ internal class CountingSorter {
             }
         } else {
             // Single-thread prefix sum for small bin counts (fits in one block)
-            if let encoder = commandBuffer.makeComputeCommandEncoder() {
+            if let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) {
                 encoder.label = "CountingSort PrefixSum"
                 encoder.setComputePipelineState(prefixSumPipeline)
                 encoder.setBuffer(histogram, offset: 0, index: 0)
@@ -568,7 +672,7 @@ internal class CountingSorter {
         }
 
         // Pass 4: Copy prefix sum to bin offsets
-        if let encoder = commandBuffer.makeComputeCommandEncoder() {
+        if let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) {
             encoder.label = "CountingSort InitOffsets"
             encoder.setComputePipelineState(initBinOffsetsPipeline)
             encoder.setBuffer(prefixSum, offset: 0, index: 0)
@@ -584,7 +688,7 @@ internal class CountingSorter {
         }
 
         // Pass 5: Scatter indices to sorted positions (uses cached bin indices - no depth recomputation!)
-        if let encoder = commandBuffer.makeComputeCommandEncoder() {
+        if let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) {
             encoder.label = "CountingSort Scatter"
             encoder.setComputePipelineState(shouldFilterEditingState ? scatterPipeline : scatterNoEditPipeline)
             encoder.setBuffer(cachedBins, offset: 0, index: 0)   // Use cached bin indices
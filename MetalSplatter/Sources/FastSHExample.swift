@@ -58,17 +58,15 @@ public class FastSHExample {
             screenSize: SIMD2<Int>(1920, 1080)
         )
         
-        // Render with fast SH (using SplatRenderer's internal render method)
+        // Render with fast SH, through a splat density rate map where the device supports one; this falls
+        // back to a full-rate render otherwise
         if let commandBuffer = commandQueue.makeCommandBuffer() {
             let colorTexture = try createDummyTexture(device: device)
             
-            try renderer.render(
-                viewports: [viewport],
+            try renderer.renderFoveated(
+                viewport: viewport,
                 colorTexture: colorTexture,
                 colorStoreAction: .store,
-                depthTexture: nil,
-                rasterizationRateMap: nil,
-                renderTargetArrayLength: 0,
                 to: commandBuffer
             )
             
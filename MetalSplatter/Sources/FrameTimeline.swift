@@ -0,0 +1,274 @@
+import Foundation
+import Metal
+import os
+
+/// GPU stage timings and CPU encode time for one rendered frame, recorded while
+/// `SplatRenderer.frameTimelineEnabled` is set.
+///
+/// Passes arrive as their command buffers complete, so a frame's sort passes (which run on their own command
+/// buffers) may be filled in after its draw.
+public struct FrameTimeline: Sendable {
+    public enum Stage: String, CaseIterable, Sendable {
+        /// GPU frustum culling and its indirect-argument setup
+        case cull
+        /// Batch covariance/transform precompute
+        case precompute
+        /// Visible-splat SH color evaluation (`FastSHSplatRenderer`)
+        case shEvaluation
+        /// Depth/distance key generation ahead of a GPU sort
+        case sortKeys
+        /// Histogram, prefix-sum and scatter passes of the counting and radix sorts
+        case sortPasses
+        /// The splat render pass, vertex start to fragment end
+        case draw
+        /// Multi-stage depth resolve. Sampled on its own only on GPUs with draw-boundary counter sampling;
+        /// elsewhere it shares, and is included in, the `draw` pass.
+        case postprocess
+    }
+
+    public struct Pass: Sendable {
+        public let stage: Stage
+        /// GPU timestamps in seconds, converted to the CPU clock with `MTLDevice.sampleTimestamps`
+        public let start: TimeInterval
+        public let end: TimeInterval
+
+        public var duration: TimeInterval { end - start }
+    }
+
+    /// Monotonic frame counter, starting at 1 when the timeline is enabled
+    public let frameIndex: UInt64
+    /// CPU time spent inside `render(...)`
+    public internal(set) var cpuEncodeDuration: TimeInterval?
+    public internal(set) var passes: [Pass] = []
+
+    init(frameIndex: UInt64) {
+        self.frameIndex = frameIndex
+    }
+
+    /// Summed GPU time of the passes tagged `stage`
+    public func gpuDuration(of stage: Stage) -> TimeInterval {
+        passes.lazy.filter { $0.stage == stage }.reduce(0) { $0 + $1.duration }
+    }
+
+    /// First pass start to last pass end
+    public var gpuSpan: TimeInterval? {
+        guard let start = passes.map(\.start).min(), let end = passes.map(\.end).max() else { return nil }
+        return end - start
+    }
+}
+
+/// Samples GPU timestamps at encoder boundaries into one shared counter buffer and keeps the last `capacity`
+/// frames. Only exists while the timeline is enabled; every hook is an optional call on it, so a disabled timeline
+/// costs a nil check.
+internal final class FrameTimelineRecorder: @unchecked Sendable {
+    private struct PendingPass {
+        let frameIndex: UInt64
+        let stage: FrameTimeline.Stage
+        let sampleIndex: Int
+    }
+
+    /// 32 KB of 64-bit timestamps, the largest counter sample buffer Metal allocates; used as a ring of sample pairs
+    private static let sampleCount = 4096
+
+    let capacity: Int
+
+    private let device: MTLDevice
+    private let sampleBuffer: MTLCounterSampleBuffer
+    private let supportsDrawBoundarySampling: Bool
+    private let signposter = OSSignposter(subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
+                                          category: "FrameTimeline")
+
+    private let lock = NSLock()
+    private var frames: [FrameTimeline] = []
+    private var currentFrameIndex: UInt64 = 0
+    private var nextSampleIndex = 0
+    private var pendingPasses: [ObjectIdentifier: [PendingPass]] = [:]
+    private var encodeInterval: OSSignpostIntervalState?
+
+    // CPU/GPU clock calibration: a fixed origin pair and a rate refreshed on every resolve
+    private let calibrationCPU: MTLTimestamp
+    private let calibrationGPU: MTLTimestamp
+    private var nanosecondsPerTick: Double = 1
+
+    /// Returns nil when the device has no timestamp counter set or can't sample at encoder boundaries
+    init?(device: MTLDevice, capacity: Int) {
+        guard device.supportsCounterSampling(.atStageBoundary),
+              let timestampSet = device.counterSets?.first(where: {
+                  $0.name.caseInsensitiveCompare(MTLCommonCounterSet.timestamp.rawValue) == .orderedSame
+              }) else {
+            return nil
+        }
+        let descriptor = MTLCounterSampleBufferDescriptor()
+        descriptor.counterSet = timestampSet
+        descriptor.label = "Frame Timeline"
+        descriptor.storageMode = .shared
+        descriptor.sampleCount = Self.sampleCount
+        guard let sampleBuffer = try? device.makeCounterSampleBuffer(descriptor: descriptor) else { return nil }
+
+        self.device = device
+        self.sampleBuffer = sampleBuffer
+        self.capacity = max(capacity, 1)
+        self.supportsDrawBoundarySampling = device.supportsCounterSampling(.atDrawBoundary)
+        var cpu: MTLTimestamp = 0
+        var gpu: MTLTimestamp = 0
+        device.sampleTimestamps(&cpu, gpuTimestamp: &gpu)
+        calibrationCPU = cpu
+        calibrationGPU = gpu
+    }
+
+    /// Recorded frames, oldest first
+    var recentFrames: [FrameTimeline] {
+        lock.lock()
+        defer { lock.unlock() }
+        return frames
+    }
+
+    // MARK: - CPU
+
+    func beginFrame() {
+        lock.lock()
+        currentFrameIndex += 1
+        let frameIndex = currentFrameIndex
+        frames.append(FrameTimeline(frameIndex: frameIndex))
+        if frames.count > capacity {
+            frames.removeFirst(frames.count - capacity)
+        }
+        lock.unlock()
+        encodeInterval = signposter.beginInterval("Encode Frame", id: signposter.makeSignpostID(), "\(frameIndex)")
+    }
+
+    func endFrame(cpuEncodeDuration: TimeInterval) {
+        lock.lock()
+        if let index = frames.lastIndex(where: { $0.frameIndex == currentFrameIndex }) {
+            frames[index].cpuEncodeDuration = cpuEncodeDuration
+        }
+        lock.unlock()
+        if let encodeInterval {
+            signposter.endInterval("Encode Frame", encodeInterval)
+            self.encodeInterval = nil
+        }
+    }
+
+    /// Brackets a hop onto the main queue, from the `async` call to the block running
+    func beginMainQueueHop() -> OSSignpostIntervalState {
+        signposter.beginInterval("Main Queue Hop", id: signposter.makeSignpostID())
+    }
+
+    func endMainQueueHop(_ state: OSSignpostIntervalState) {
+        signposter.endInterval("Main Queue Hop", state)
+    }
+
+    // MARK: - GPU
+
+    func makeComputeCommandEncoder(for stage: FrameTimeline.Stage,
+                                   on commandBuffer: MTLCommandBuffer) -> MTLComputeCommandEncoder? {
+        let descriptor = MTLComputePassDescriptor()
+        guard let attachment = descriptor.sampleBufferAttachments[0] else {
+            return commandBuffer.makeComputeCommandEncoder()
+        }
+        let sampleIndex = reserveSamples(for: stage, on: commandBuffer)
+        attachment.sampleBuffer = sampleBuffer
+        attachment.startOfEncoderSampleIndex = sampleIndex
+        attachment.endOfEncoderSampleIndex = sampleIndex + 1
+        return commandBuffer.makeComputeCommandEncoder(descriptor: descriptor)
+    }
+
+    /// Times the render pass `descriptor` describes, from its first vertex to its last fragment
+    func attach(_ stage: FrameTimeline.Stage, to descriptor: MTLRenderPassDescriptor, on commandBuffer: MTLCommandBuffer) {
+        guard let attachment = descriptor.sampleBufferAttachments[0] else { return }
+        let sampleIndex = reserveSamples(for: stage, on: commandBuffer)
+        attachment.sampleBuffer = sampleBuffer
+        attachment.startOfVertexSampleIndex = sampleIndex
+        attachment.endOfVertexSampleIndex = MTLCounterDontSample
+        attachment.startOfFragmentSampleIndex = MTLCounterDontSample
+        attachment.endOfFragmentSampleIndex = sampleIndex + 1
+    }
+
+    /// Samples around draws inside an already-open render pass; nil when the GPU only samples at encoder boundaries
+    func beginDraws(_ stage: FrameTimeline.Stage,
+                    in encoder: MTLRenderCommandEncoder,
+                    on commandBuffer: MTLCommandBuffer) -> Int? {
+        guard supportsDrawBoundarySampling else { return nil }
+        let sampleIndex = reserveSamples(for: stage, on: commandBuffer)
+        encoder.sampleCounters(sampleBuffer: sampleBuffer, sampleIndex: sampleIndex, barrier: true)
+        return sampleIndex
+    }
+
+    func endDraws(_ sampleIndex: Int?, in encoder: MTLRenderCommandEncoder) {
+        guard let sampleIndex else { return }
+        encoder.sampleCounters(sampleBuffer: sampleBuffer, sampleIndex: sampleIndex + 1, barrier: true)
+    }
+
+    // MARK: - Private
+
+    /// Reserves a start/end sample pair attributed to the current frame, resolving it when `commandBuffer` completes
+    private func reserveSamples(for stage: FrameTimeline.Stage, on commandBuffer: MTLCommandBuffer) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        let sampleIndex = nextSampleIndex
+        nextSampleIndex = (nextSampleIndex + 2) % Self.sampleCount
+        let key = ObjectIdentifier(commandBuffer)
+        if pendingPasses[key] == nil {
+            pendingPasses[key] = []
+            commandBuffer.addCompletedHandler { [weak self] commandBuffer in
+                self?.resolve(commandBuffer)
+            }
+        }
+        pendingPasses[key]?.append(PendingPass(frameIndex: currentFrameIndex, stage: stage, sampleIndex: sampleIndex))
+        return sampleIndex
+    }
+
+    private func resolve(_ commandBuffer: MTLCommandBuffer) {
+        lock.lock()
+        let pending = pendingPasses.removeValue(forKey: ObjectIdentifier(commandBuffer)) ?? []
+        lock.unlock()
+        guard commandBuffer.status == .completed, !pending.isEmpty else { return }
+
+        var cpu: MTLTimestamp = 0
+        var gpu: MTLTimestamp = 0
+        device.sampleTimestamps(&cpu, gpuTimestamp: &gpu)
+        lock.lock()
+        if gpu > calibrationGPU, cpu > calibrationCPU {
+            nanosecondsPerTick = Double(cpu - calibrationCPU) / Double(gpu - calibrationGPU)
+        }
+        let nanosecondsPerTick = nanosecondsPerTick
+        lock.unlock()
+
+        let resolved = pending.compactMap { pass -> (UInt64, FrameTimeline.Pass)? in
+            guard let data = try? sampleBuffer.resolveCounterRange(pass.sampleIndex..<(pass.sampleIndex + 2)) else {
+                return nil
+            }
+            let timestamps = data.withUnsafeBytes { Array($0.bindMemory(to: MTLCounterResultTimestamp.self)) }
+            guard timestamps.count == 2,
+                  timestamps[0].timestamp != MTLCounterErrorValue,
+                  timestamps[1].timestamp != MTLCounterErrorValue,
+                  timestamps[1].timestamp >= timestamps[0].timestamp else {
+                return nil
+            }
+            return (pass.frameIndex, FrameTimeline.Pass(stage: pass.stage,
+                                                        start: seconds(timestamps[0].timestamp, nanosecondsPerTick),
+                                                        end: seconds(timestamps[1].timestamp, nanosecondsPerTick)))
+        }
+
+        lock.lock()
+        for (frameIndex, pass) in resolved {
+            if let index = frames.lastIndex(where: { $0.frameIndex == frameIndex }) {
+                frames[index].passes.append(pass)
+            }
+        }
+        lock.unlock()
+    }
+
+    private func seconds(_ gpuTimestamp: UInt64, _ nanosecondsPerTick: Double) -> TimeInterval {
+        let gpuDelta = Double(gpuTimestamp) - Double(calibrationGPU)
+        return (Double(calibrationCPU) + gpuDelta * nanosecondsPerTick) / 1_000_000_000
+    }
+}
+
+extension MTLCommandBuffer {
+    /// A compute encoder whose pass is timed by `recorder` when there is one
+    func makeComputeCommandEncoder(timing stage: FrameTimeline.Stage,
+                                   with recorder: FrameTimelineRecorder?) -> MTLComputeCommandEncoder? {
+        recorder?.makeComputeCommandEncoder(for: stage, on: self) ?? makeComputeCommandEncoder()
+    }
+}
@@ -0,0 +1,195 @@
+import Foundation
+import Metal
+import simd
+import os
+import SplatIO
+
+/// Dequantizes packed scene formats into `Splat`s on the GPU
+///
+/// The packed SOG v2 images and SPZ byte streams are uploaded as-is, and a kernel per format
+/// (GPUDequantization.metal) writes each splat's position, color and covariance directly into the
+/// splat buffer. The CPU only parses metadata, so load time scales with GPU bandwidth rather than
+/// per-point CPU decoding.
+internal final class GPUDequantizer: @unchecked Sendable {
+
+    private static let log = Logger(subsystem: Bundle.main.bundleIdentifier ?? "MetalSplatter",
+                                    category: "GPUDequantizer")
+
+    // Keep in sync with GPUDequantization.metal
+    struct SOGV2Params {
+        var meansMin: SIMD4<Float>
+        var meansMax: SIMD4<Float>
+        var splatCount: UInt32
+        var premultipliedMask: UInt32
+        var padding: SIMD2<UInt32> = .zero
+    }
+
+    struct SPZParams {
+        var splatCount: UInt32
+        var fractionalBits: UInt32
+        var usesFloat16Positions: UInt32
+        var usesSmallestThreeRotations: UInt32
+    }
+
+    /// Entries of the SOG v2 scale and color codebooks read by the kernel
+    static let sogCodebookLength = 256
+
+    private let device: MTLDevice
+    private let commandQueue: MTLCommandQueue
+    private let sogV2Pipeline: MTLComputePipelineState
+    private let spzPipeline: MTLComputePipelineState
+
+    internal init(device: MTLDevice, library: MTLLibrary) throws {
+        self.device = device
+
+        func makePipeline(_ name: String) throws -> MTLComputePipelineState {
+            guard let function = library.makeFunction(name: name) else {
+                throw SplatRendererError.failedToLoadShaderFunction(name: name)
+            }
+            do {
+                return try device.makeComputePipelineState(function: function)
+            } catch {
+                throw SplatRendererError.failedToCreateComputePipelineState(functionName: name, underlying: error)
+            }
+        }
+
+        sogV2Pipeline = try makePipeline("dequantizeSOGV2Splats")
+        spzPipeline = try makePipeline("dequantizeSPZSplats")
+
+        guard let commandQueue = device.makeCommandQueue() else {
+            throw SplatRendererError.metalDeviceUnavailable
+        }
+        commandQueue.label = "GPU Dequantization Queue"
+        self.commandQueue = commandQueue
+    }
+
+    /// Whether the kernel covers this scene's layout: RGBA8 images of one size, holding every splat
+    static func supports(_ data: SOGSCompressedDataV2) -> Bool {
+        let images = [data.means_l, data.means_u, data.quats, data.scales, data.sh0]
+        let count = data.numSplats
+        return count > 0
+            && data.metadata.means.mins.count >= 3
+            && data.metadata.means.maxs.count >= 3
+            && images.allSatisfy {
+                $0.bytesPerPixel == 4
+                    && $0.width == data.textureWidth
+                    && $0.height == data.textureHeight
+                    && $0.pixels.count >= count * 4
+            }
+    }
+
+    /// Writes the first `numSplats` splats of a SOG v2 scene into `output`
+    func dequantize(_ data: SOGSCompressedDataV2, into output: MTLBuffer) async throws {
+        let count = data.numSplats
+        let images = [data.means_l, data.means_u, data.quats, data.scales, data.sh0]
+        var premultipliedMask: UInt32 = 0
+        for (bit, image) in images.enumerated() where image.isPremultiplied {
+            premultipliedMask |= 1 << UInt32(bit)
+        }
+
+        let means = data.metadata.means
+        var params = SOGV2Params(meansMin: SIMD4(means.mins[0], means.mins[1], means.mins[2], 0),
+                                 meansMax: SIMD4(means.maxs[0], means.maxs[1], means.maxs[2], 0),
+                                 splatCount: UInt32(count),
+                                 premultipliedMask: premultipliedMask)
+
+        let labels = ["SOG Means (Lower)", "SOG Means (Upper)", "SOG Quats", "SOG Scales", "SOG SH0"]
+        let imageBuffers = try zip(images, labels).map { image, label in
+            try makeBuffer(image.pixels.prefix(count * 4), label: label)
+        }
+        // The CPU iterator pads short codebooks with zeros; so does the upload
+        let scalesCodebook = try makeBuffer(Self.paddedCodebook(data.metadata.scales.codebook), label: "SOG Scales Codebook")
+        let sh0Codebook = try makeBuffer(Self.paddedCodebook(data.metadata.sh0.codebook), label: "SOG SH0 Codebook")
+
+        try await run(label: "Dequantize SOG v2", count: count) { encoder in
+            encoder.setComputePipelineState(sogV2Pipeline)
+            encoder.setBytes(&params, length: MemoryLayout<SOGV2Params>.stride, index: 0)
+            for (index, buffer) in imageBuffers.enumerated() {
+                encoder.setBuffer(buffer, offset: 0, index: 1 + index)
+            }
+            encoder.setBuffer(scalesCodebook, offset: 0, index: 6)
+            encoder.setBuffer(sh0Codebook, offset: 0, index: 7)
+            encoder.setBuffer(output, offset: 0, index: 8)
+            return sogV2Pipeline
+        }
+    }
+
+    /// Writes every point of an SPZ scene into `output`
+    func dequantize(_ streams: SPZSceneReader.PackedStreams, into output: MTLBuffer) async throws {
+        let count = streams.pointCount
+        guard count > 0 else { return }
+        var params = SPZParams(splatCount: UInt32(count),
+                               fractionalBits: UInt32(streams.fractionalBits),
+                               usesFloat16Positions: streams.usesFloat16Positions ? 1 : 0,
+                               usesSmallestThreeRotations: streams.usesSmallestThreeRotations ? 1 : 0)
+
+        let positions = try makeBuffer(streams.positions.prefix(count * streams.positionStride), label: "SPZ Positions")
+        let scales = try makeBuffer(streams.scales.prefix(count * 3), label: "SPZ Scales")
+        let rotations = try makeBuffer(streams.rotations.prefix(count * streams.rotationStride), label: "SPZ Rotations")
+        let alphas = try makeBuffer(streams.alphas.prefix(count), label: "SPZ Alphas")
+        let colors = try makeBuffer(streams.colors.prefix(count * 3), label: "SPZ Colors")
+
+        try await run(label: "Dequantize SPZ", count: count) { encoder in
+            encoder.setComputePipelineState(spzPipeline)
+            encoder.setBytes(&params, length: MemoryLayout<SPZParams>.stride, index: 0)
+            encoder.setBuffer(positions, offset: 0, index: 1)
+            encoder.setBuffer(scales, offset: 0, index: 2)
+            encoder.setBuffer(rotations, offset: 0, index: 3)
+            encoder.setBuffer(alphas, offset: 0, index: 4)
+            encoder.setBuffer(colors, offset: 0, index: 5)
+            encoder.setBuffer(output, offset: 0, index: 6)
+            return spzPipeline
+        }
+    }
+
+    static func paddedCodebook(_ codebook: [Float]) -> [Float] {
+        let prefix = codebook.prefix(sogCodebookLength)
+        return Array(prefix) + [Float](repeating: 0, count: sogCodebookLength - prefix.count)
+    }
+
+    // MARK: - Private
+
+    private func makeBuffer<Bytes: ContiguousBytes>(_ bytes: Bytes, label: String) throws -> MTLBuffer {
+        let buffer = bytes.withUnsafeBytes { raw -> MTLBuffer? in
+            guard let base = raw.baseAddress, raw.count > 0 else { return nil }
+            return device.makeBuffer(bytes: base, length: raw.count, options: .storageModeShared)
+        }
+        guard let buffer else {
+            throw SplatRendererError.failedToCreateBuffer(length: bytes.withUnsafeBytes { $0.count })
+        }
+        buffer.label = label
+        return buffer
+    }
+
+    /// Encodes one dispatch of `count` threads and waits for it to complete
+    private func run(label: String,
+                     count: Int,
+                     encode: (MTLComputeCommandEncoder) -> MTLComputePipelineState) async throws {
+        guard let commandBuffer = commandQueue.makeCommandBuffer() else {
+            throw SplatRendererError.metalDeviceUnavailable
+        }
+        commandBuffer.label = label
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        encoder.label = label
+        let pipeline = encode(encoder)
+        let threads = min(256, pipeline.maxTotalThreadsPerThreadgroup)
+        encoder.dispatchThreadgroups(MTLSize(width: (count + threads - 1) / threads, height: 1, depth: 1),
+                                     threadsPerThreadgroup: MTLSize(width: threads, height: 1, depth: 1))
+        encoder.endEncoding()
+
+        let startTime = CFAbsoluteTimeGetCurrent()
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            commandBuffer.addCompletedHandler { _ in
+                continuation.resume()
+            }
+            commandBuffer.commit()
+        }
+        if let error = commandBuffer.error {
+            Self.log.error("\(label) failed: \(error.localizedDescription)")
+            throw error
+        }
+        Self.log.info("\(label) of \(count) splats took \(String(format: "%.2f", (CFAbsoluteTimeGetCurrent() - startTime) * 1000))ms on the GPU")
+    }
+}
@@ -0,0 +1,300 @@
+import Metal
+import simd
+import os
+
+/// GPU LOD selection and culling for sorted rendering
+///
+/// Holds an LOD hierarchy (node bounds plus a node index per splat) on the GPU and encodes, into the
+/// sort command buffer:
+/// 1. Node selection: frustum test and screen-space error per node
+/// 2. Splat culling: a per-splat sort mask in edit-state encoding plus the survivor count, so the
+///    counting sort only bins and scatters splats that contribute
+/// 3. After the sort: invalidates sorted entries past the survivor count and writes
+///    `DrawIndexedIndirectArguments` via `generateIndirectDrawArguments`
+///
+/// The survivor count never leaves the GPU on the render path; it is only read from completion
+/// handlers for statistics.
+///
+/// Sorts are serialized by the renderer, so the mask and counter buffers are reused across sorts.
+internal final class GPULODSelector: @unchecked Sendable {
+
+    private static let log = Logger(subsystem: Bundle.main.bundleIdentifier ?? "MetalSplatter",
+                                    category: "GPULODSelector")
+
+    // Keep in sync with LODCulling.metal
+    struct GPUNode {
+        var boundsMin: SIMD4<Float>     // w = geometric error
+        var boundsMax: SIMD4<Float>
+        var splatAncestorIndex: Int32   // Nearest ancestor with splats, -1 for none
+        var flags: UInt32
+        var padding: SIMD2<UInt32> = .zero
+    }
+
+    struct NodeFlags: OptionSet {
+        let rawValue: UInt32
+        static let leaf = NodeFlags(rawValue: 1 << 0)
+        static let hasSplats = NodeFlags(rawValue: 1 << 1)
+    }
+
+    struct LODCullParams {
+        var viewProjectionMatrix: simd_float4x4
+        var cameraPosition: SIMD4<Float>    // w = projection scale (focal length in pixels)
+        var maxScreenSpaceError: Float
+        var frustumMargin: Float
+        var nodeCount: UInt32
+        var splatCount: UInt32
+    }
+
+    /// Entries of `DrawIndexedIndirectArguments` (5 × UInt32)
+    static let drawArgumentsLength = 5
+
+    private let device: MTLDevice
+
+    // Pipeline states
+    private let selectNodesPipeline: MTLComputePipelineState
+    private let cullSplatsPipeline: MTLComputePipelineState
+    private let padSortedIndicesPipeline: MTLComputePipelineState
+    private let generateArgumentsPipeline: MTLComputePipelineState
+
+    // Hierarchy buffers (replaced by setHierarchy)
+    private var nodeBuffer: MTLBuffer?
+    private var splatNodeIndexBuffer: MTLBuffer?
+    private var nodeSelectedBuffer: MTLBuffer?
+    private(set) var nodeCount = 0
+    /// Splat count the per-splat node indices were built for; the selector only applies to a scene of this size
+    private(set) var splatCount = 0
+    /// Set once the renderer has warned that the scene no longer has `splatCount` splats
+    var reportedSplatCountMismatch = false
+
+    // Per-sort buffers, reused across frames
+    private var sortMaskBuffer: MTLBuffer?
+    private let survivorCountBuffer: MTLBuffer
+
+    internal init(device: MTLDevice, library: MTLLibrary) throws {
+        self.device = device
+
+        func makePipeline(_ name: String) throws -> MTLComputePipelineState {
+            guard let function = library.makeFunction(name: name) else {
+                throw SplatRendererError.failedToLoadShaderFunction(name: name)
+            }
+            do {
+                return try device.makeComputePipelineState(function: function)
+            } catch {
+                throw SplatRendererError.failedToCreateComputePipelineState(functionName: name, underlying: error)
+            }
+        }
+
+        selectNodesPipeline = try makePipeline("lodSelectNodes")
+        cullSplatsPipeline = try makePipeline("lodCullSplats")
+        padSortedIndicesPipeline = try makePipeline("lodPadSortedIndices")
+        generateArgumentsPipeline = try makePipeline("generateIndirectDrawArguments")
+
+        let counterLength = MemoryLayout<UInt32>.stride
+        guard let counter = device.makeBuffer(length: counterLength, options: .storageModeShared) else {
+            throw SplatRendererError.failedToCreateBuffer(length: counterLength)
+        }
+        counter.label = "LOD Survivor Count"
+        survivorCountBuffer = counter
+    }
+
+    /// Validates a hierarchy and converts it to the GPU node layout, deriving the leaf and has-splats flags.
+    ///
+    /// Each node records its nearest ancestor with splats rather than its parent: a node is drawn once that
+    /// ancestor is refined, so nodes under an empty intermediate node don't draw on top of a coarser ancestor.
+    static func makeGPUNodes(_ nodes: [SplatRenderer.LODNode], splatNodeIndices: [UInt32]) throws -> [GPUNode] {
+        var hasChildren = [Bool](repeating: false, count: nodes.count)
+        for (index, node) in nodes.enumerated() {
+            if let parent = node.parentIndex {
+                guard parent >= 0, parent < nodes.count, parent != index else {
+                    throw SplatRenderer.LODHierarchyError.invalidParentIndex(node: index, parent: parent)
+                }
+                hasChildren[parent] = true
+            }
+        }
+
+        var hasSplats = [Bool](repeating: false, count: nodes.count)
+        for (splat, nodeIndex) in splatNodeIndices.enumerated() {
+            guard Int(nodeIndex) < nodes.count else {
+                throw SplatRenderer.LODHierarchyError.invalidNodeIndex(splat: splat, node: Int(nodeIndex))
+            }
+            hasSplats[Int(nodeIndex)] = true
+        }
+
+        // Resolved per chain of splat-less ancestors; -2 marks nodes not resolved yet
+        var splatAncestors = [Int32](repeating: -2, count: nodes.count)
+        for start in nodes.indices where splatAncestors[start] == -2 {
+            var chain: [Int] = []
+            var current = start
+            var ancestor: Int32 = -1
+            while let parent = nodes[current].parentIndex {
+                chain.append(current)
+                guard chain.count <= nodes.count else {
+                    throw SplatRenderer.LODHierarchyError.invalidParentIndex(node: current, parent: parent)
+                }
+                if hasSplats[parent] {
+                    ancestor = Int32(parent)
+                    break
+                }
+                if splatAncestors[parent] != -2 {
+                    ancestor = splatAncestors[parent]
+                    break
+                }
+                current = parent
+            }
+            splatAncestors[start] = ancestor
+            for node in chain {
+                splatAncestors[node] = ancestor
+            }
+        }
+
+        return nodes.enumerated().map { index, node in
+            var flags: NodeFlags = []
+            if !hasChildren[index] { flags.insert(.leaf) }
+            if hasSplats[index] { flags.insert(.hasSplats) }
+            return GPUNode(boundsMin: SIMD4(node.bounds.min, node.geometricError),
+                           boundsMax: SIMD4(node.bounds.max, 0),
+                           splatAncestorIndex: splatAncestors[index],
+                           flags: flags.rawValue)
+        }
+    }
+
+    /// Uploads a hierarchy; `splatNodeIndices[i]` is the node of splat `i`
+    func setHierarchy(nodes: [SplatRenderer.LODNode], splatNodeIndices: [UInt32]) throws {
+        let gpuNodes = try Self.makeGPUNodes(nodes, splatNodeIndices: splatNodeIndices)
+        guard !gpuNodes.isEmpty, !splatNodeIndices.isEmpty else {
+            clearHierarchy()
+            return
+        }
+
+        let nodeLength = gpuNodes.count * MemoryLayout<GPUNode>.stride
+        guard let nodes = gpuNodes.withUnsafeBytes({ device.makeBuffer(bytes: $0.baseAddress!, length: nodeLength, options: .storageModeShared) }) else {
+            throw SplatRendererError.failedToCreateBuffer(length: nodeLength)
+        }
+        nodes.label = "LOD Nodes"
+
+        let indexLength = splatNodeIndices.count * MemoryLayout<UInt32>.stride
+        guard let indices = splatNodeIndices.withUnsafeBytes({ device.makeBuffer(bytes: $0.baseAddress!, length: indexLength, options: .storageModeShared) }) else {
+            throw SplatRendererError.failedToCreateBuffer(length: indexLength)
+        }
+        indices.label = "LOD Splat Node Indices"
+
+        guard let selected = device.makeBuffer(length: gpuNodes.count, options: .storageModePrivate) else {
+            throw SplatRendererError.failedToCreateBuffer(length: gpuNodes.count)
+        }
+        selected.label = "LOD Node Selection"
+
+        if (sortMaskBuffer?.length ?? 0) < splatNodeIndices.count {
+            guard let mask = device.makeBuffer(length: splatNodeIndices.count, options: .storageModePrivate) else {
+                throw SplatRendererError.failedToCreateBuffer(length: splatNodeIndices.count)
+            }
+            mask.label = "LOD Sort Mask"
+            sortMaskBuffer = mask
+        }
+
+        nodeBuffer = nodes
+        splatNodeIndexBuffer = indices
+        nodeSelectedBuffer = selected
+        nodeCount = gpuNodes.count
+        splatCount = splatNodeIndices.count
+        reportedSplatCountMismatch = false
+    }
+
+    func clearHierarchy() {
+        nodeBuffer = nil
+        splatNodeIndexBuffer = nil
+        nodeSelectedBuffer = nil
+        sortMaskBuffer = nil
+        nodeCount = 0
+        splatCount = 0
+    }
+
+    /// Encodes node selection and splat culling.
+    /// - Returns: The sort mask to pass to the counting sort in place of the edit states
+    func encodeSelection(commandBuffer: MTLCommandBuffer,
+                         splatBuffer: MTLBuffer,
+                         editStateBuffer: MTLBuffer?,
+                         params: LODCullParams) throws -> MTLBuffer {
+        guard let nodeBuffer, let splatNodeIndexBuffer, let nodeSelectedBuffer, let sortMaskBuffer,
+              Int(params.splatCount) == splatCount else {
+            Self.log.error("LOD hierarchy does not match the scene")
+            throw SplatRendererError.internalPipelineMismatch(expected: "\(splatCount) splats", actual: "\(params.splatCount)")
+        }
+        var params = params
+        params.nodeCount = UInt32(nodeCount)
+
+        guard let blit = commandBuffer.makeBlitCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        blit.label = "LOD Reset"
+        blit.fill(buffer: survivorCountBuffer, range: 0..<MemoryLayout<UInt32>.stride, value: 0)
+        blit.endEncoding()
+
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        encoder.label = "LOD Select Nodes"
+        encoder.setComputePipelineState(selectNodesPipeline)
+        encoder.setBuffer(nodeBuffer, offset: 0, index: 0)
+        encoder.setBytes(&params, length: MemoryLayout<LODCullParams>.stride, index: 1)
+        encoder.setBuffer(nodeSelectedBuffer, offset: 0, index: 2)
+        let nodeThreads = min(256, selectNodesPipeline.maxTotalThreadsPerThreadgroup)
+        encoder.dispatchThreadgroups(MTLSize(width: (nodeCount + nodeThreads - 1) / nodeThreads, height: 1, depth: 1),
+                                     threadsPerThreadgroup: MTLSize(width: nodeThreads, height: 1, depth: 1))
+
+        // Dispatches in the same encoder are serialized, so culling sees this frame's node selection
+        var hasEditStates = editStateBuffer != nil
+        encoder.label = "LOD Cull Splats"
+        encoder.setComputePipelineState(cullSplatsPipeline)
+        encoder.setBuffer(splatBuffer, offset: 0, index: 0)
+        encoder.setBuffer(splatNodeIndexBuffer, offset: 0, index: 1)
+        encoder.setBuffer(nodeSelectedBuffer, offset: 0, index: 2)
+        encoder.setBytes(&params, length: MemoryLayout<LODCullParams>.stride, index: 3)
+        encoder.setBuffer(sortMaskBuffer, offset: 0, index: 4)
+        encoder.setBuffer(survivorCountBuffer, offset: 0, index: 5)
+        // Not read without edit states; bound so every argument has a buffer
+        encoder.setBuffer(editStateBuffer ?? sortMaskBuffer, offset: 0, index: 6)
+        encoder.setBytes(&hasEditStates, length: MemoryLayout<Bool>.size, index: 7)
+        encoder.dispatchThreadgroups(MTLSize(width: (splatCount + 255) / 256, height: 1, depth: 1),
+                                     threadsPerThreadgroup: MTLSize(width: 256, height: 1, depth: 1))
+        encoder.endEncoding()
+
+        return sortMaskBuffer
+    }
+
+    /// Encodes, after the sort: invalidation of entries past the survivor count, then the indirect draw
+    /// arguments at `drawArgumentsOffset` (in Int32 entries) of `sortedIndices`
+    func encodeDrawArguments(commandBuffer: MTLCommandBuffer,
+                             sortedIndices: MTLBuffer,
+                             renderableCount: Int,
+                             drawArgumentsOffset: Int,
+                             maxIndexedSplatCount: Int) throws {
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        var count = UInt32(renderableCount)
+        encoder.label = "LOD Pad Sorted Indices"
+        encoder.setComputePipelineState(padSortedIndicesPipeline)
+        encoder.setBuffer(sortedIndices, offset: 0, index: 0)
+        encoder.setBuffer(survivorCountBuffer, offset: 0, index: 1)
+        encoder.setBytes(&count, length: MemoryLayout<UInt32>.stride, index: 2)
+        encoder.dispatchThreadgroups(MTLSize(width: max((renderableCount + 255) / 256, 1), height: 1, depth: 1),
+                                     threadsPerThreadgroup: MTLSize(width: 256, height: 1, depth: 1))
+
+        var indicesPerSplat: UInt32 = 6  // 2 triangles per splat
+        var maxIndexed = UInt32(maxIndexedSplatCount)
+        encoder.label = "LOD Indirect Draw Args"
+        encoder.setComputePipelineState(generateArgumentsPipeline)
+        encoder.setBuffer(sortedIndices, offset: drawArgumentsOffset * MemoryLayout<Int32>.stride, index: 0)
+        encoder.setBuffer(survivorCountBuffer, offset: 0, index: 1)
+        encoder.setBytes(&indicesPerSplat, length: MemoryLayout<UInt32>.stride, index: 2)
+        encoder.setBytes(&maxIndexed, length: MemoryLayout<UInt32>.stride, index: 3)
+        encoder.dispatchThreads(MTLSize(width: 1, height: 1, depth: 1),
+                                threadsPerThreadgroup: MTLSize(width: 1, height: 1, depth: 1))
+        encoder.endEncoding()
+    }
+
+    /// Survivors of the last selection; only valid once its command buffer completes
+    var lastSurvivorCount: Int {
+        Int(survivorCountBuffer.contents().load(as: UInt32.self))
+    }
+}
@@ -0,0 +1,264 @@
+import Metal
+import os
+
+/// Load-time Morton (Z-order) reordering of a range of the splat buffer and its per-splat side buffers, on the GPU
+///
+/// One command buffer runs the whole stage:
+/// 1. Bounds: `resetBoundsForMorton` + `computeBoundsForMorton` reduce the range's positions
+/// 2. Codes: `computeMortonCodes` writes a (30-bit code, local index) pair per splat
+/// 3. Sort: the pairs are radix-sorted ascending by code; without a GPU key sorter the stage waits once, sorts
+///    the pairs on the CPU and continues in a second command buffer
+/// 4. Gather: splats and every attachment are gathered into scratch in code order and copied back in place
+///
+/// `reorder` blocks until the GPU is done and returns the sorted order, so callers can permute their CPU-side
+/// copies the same way. Sorting is stable, so splats sharing a code keep their relative order.
+internal final class GPUMortonReorderer: @unchecked Sendable {
+    private static let log = Logger(subsystem: Bundle.main.bundleIdentifier ?? "MetalSplatter",
+                                    category: "GPUMortonReorderer")
+
+    /// Keep in sync with `MortonCodeOutput` in MortonCode.metal
+    struct MortonCode {
+        var code: UInt32
+        var originalIndex: UInt32
+    }
+
+    /// Keep in sync with `MortonGatherParameters` in MortonCode.metal
+    struct GatherParameters {
+        var count: UInt32
+        var stride: UInt32
+    }
+
+    /// A per-splat buffer reordered alongside the splats; element `i` of the range starts at `offset + i * stride`
+    struct Attachment {
+        let buffer: MTLBuffer
+        let offset: Int
+        let stride: Int
+    }
+
+    /// Sorts `count` `MortonCode`s in the first buffer ascending by code, using the second as scratch, leaving the
+    /// result in the first
+    typealias KeySorter = (MTLBuffer, MTLBuffer, Int, MTLCommandBuffer) throws -> Void
+
+    // computeBoundsForMorton reduces 8 SIMD groups of 32 threads per threadgroup
+    private static let boundsThreadgroupSize = 256
+
+    private let device: MTLDevice
+    private let resetBoundsPipeline: MTLComputePipelineState
+    private let boundsPipeline: MTLComputePipelineState
+    private let codesPipeline: MTLComputePipelineState
+    private let reorderSplatsPipeline: MTLComputePipelineState
+    private let reorderElementsPipeline: MTLComputePipelineState
+    private let boundsBuffer: MTLBuffer
+    // One reorder at a time owns the bounds buffer
+    private let lock = NSLock()
+
+    /// Gathered copies and sort scratch come from here when set, instead of one-off device buffers
+    var scratchHeap: MetalScratchHeap?
+
+    internal init(device: MTLDevice, library: MTLLibrary) throws {
+        self.device = device
+
+        func makePipeline(_ name: String) throws -> MTLComputePipelineState {
+            guard let function = library.makeFunction(name: name) else {
+                throw SplatRendererError.failedToLoadShaderFunction(name: name)
+            }
+            do {
+                return try device.makeComputePipelineState(function: function)
+            } catch {
+                throw SplatRendererError.failedToCreateComputePipelineState(functionName: name, underlying: error)
+            }
+        }
+        resetBoundsPipeline = try makePipeline("resetBoundsForMorton")
+        boundsPipeline = try makePipeline("computeBoundsForMorton")
+        codesPipeline = try makePipeline("computeMortonCodes")
+        reorderSplatsPipeline = try makePipeline("reorderSplatsByMorton")
+        reorderElementsPipeline = try makePipeline("reorderElementsByMorton")
+
+        guard boundsPipeline.maxTotalThreadsPerThreadgroup >= Self.boundsThreadgroupSize else {
+            throw SplatRendererError.internalPipelineMismatch(
+                expected: "\(Self.boundsThreadgroupSize) threads per threadgroup",
+                actual: "\(boundsPipeline.maxTotalThreadsPerThreadgroup)"
+            )
+        }
+
+        let boundsLength = 6 * MemoryLayout<UInt32>.stride
+        guard let boundsBuffer = device.makeBuffer(length: boundsLength, options: .storageModePrivate) else {
+            throw SplatRendererError.failedToCreateBuffer(length: boundsLength)
+        }
+        boundsBuffer.label = "Morton Reorder Bounds"
+        self.boundsBuffer = boundsBuffer
+    }
+
+    /// Morton-sorts `count` splats starting at `splatOffset` bytes into `splats`, and each attachment with them
+    /// - Parameters:
+    ///   - keySorter: GPU sort for the code pairs; nil sorts them on the CPU between two command buffers
+    /// - Returns: The new order: element `i` of the range came from local index `order[i]`
+    func reorder(splats: MTLBuffer,
+                 splatOffset: Int,
+                 count: Int,
+                 attachments: [Attachment],
+                 commandQueue: MTLCommandQueue,
+                 keySorter: KeySorter?) throws -> [UInt32] {
+        guard count > 1 else { return Array(0..<UInt32(max(count, 0))) }
+        lock.lock()
+        defer { lock.unlock() }
+
+        let codesLength = count * MemoryLayout<MortonCode>.stride
+        guard let codes = device.makeBuffer(length: codesLength, options: .storageModeShared) else {
+            throw SplatRendererError.failedToCreateBuffer(length: codesLength)
+        }
+        codes.label = "Morton Codes"
+
+        guard let commandBuffer = commandQueue.makeCommandBuffer() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        commandBuffer.label = "Morton Reorder"
+        try encodeCodes(splats: splats, splatOffset: splatOffset, count: count, codes: codes, commandBuffer: commandBuffer)
+
+        var scratch: [MTLBuffer] = []
+        defer { scratchHeap?.recycle(scratch) }
+
+        var gatherCommandBuffer = commandBuffer
+        if let keySorter {
+            let keyScratch = try makeScratchBuffer(length: codesLength, label: "Morton Code Scratch")
+            scratch.append(keyScratch)
+            try keySorter(codes, keyScratch, count, commandBuffer)
+        } else {
+            try Self.run(commandBuffer)
+            Self.sortOnCPU(codes, count: count)
+            guard let next = commandQueue.makeCommandBuffer() else {
+                throw SplatRendererError.failedToCreateComputeEncoder
+            }
+            next.label = "Morton Reorder Gather"
+            gatherCommandBuffer = next
+        }
+
+        try encodeGather(from: splats, offset: splatOffset, stride: MemoryLayout<SplatRenderer.Splat>.stride,
+                         count: count, codes: codes, typedSplats: true,
+                         commandBuffer: gatherCommandBuffer, scratch: &scratch)
+        for attachment in attachments {
+            try encodeGather(from: attachment.buffer, offset: attachment.offset, stride: attachment.stride,
+                             count: count, codes: codes, typedSplats: false,
+                             commandBuffer: gatherCommandBuffer, scratch: &scratch)
+        }
+        try Self.run(gatherCommandBuffer)
+
+        let sorted = codes.contents().bindMemory(to: MortonCode.self, capacity: count)
+        return (0..<count).map { sorted[$0].originalIndex }
+    }
+
+    // MARK: - Private
+
+    private func encodeCodes(splats: MTLBuffer,
+                             splatOffset: Int,
+                             count: Int,
+                             codes: MTLBuffer,
+                             commandBuffer: MTLCommandBuffer) throws {
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        encoder.label = "Morton Codes"
+        var splatCount = UInt32(count)
+
+        encoder.setComputePipelineState(resetBoundsPipeline)
+        encoder.setBuffer(boundsBuffer, offset: 0, index: 0)
+        encoder.dispatchThreads(MTLSize(width: 1, height: 1, depth: 1),
+                                threadsPerThreadgroup: MTLSize(width: 1, height: 1, depth: 1))
+
+        encoder.setComputePipelineState(boundsPipeline)
+        encoder.setBuffer(splats, offset: splatOffset, index: 0)
+        encoder.setBuffer(boundsBuffer, offset: 0, index: 1)
+        encoder.setBytes(&splatCount, length: MemoryLayout<UInt32>.stride, index: 2)
+        let threadgroups = (count + Self.boundsThreadgroupSize - 1) / Self.boundsThreadgroupSize
+        encoder.dispatchThreadgroups(MTLSize(width: threadgroups, height: 1, depth: 1),
+                                     threadsPerThreadgroup: MTLSize(width: Self.boundsThreadgroupSize, height: 1, depth: 1))
+
+        encoder.setComputePipelineState(codesPipeline)
+        encoder.setBuffer(splats, offset: splatOffset, index: 0)
+        encoder.setBuffer(codes, offset: 0, index: 1)
+        encoder.setBuffer(boundsBuffer, offset: 0, index: 2)
+        encoder.setBytes(&splatCount, length: MemoryLayout<UInt32>.stride, index: 3)
+        dispatch(codesPipeline, count: count, on: encoder)
+        encoder.endEncoding()
+    }
+
+    /// Gathers the range into scratch in sorted order, then copies it back over the original range
+    private func encodeGather(from buffer: MTLBuffer,
+                              offset: Int,
+                              stride: Int,
+                              count: Int,
+                              codes: MTLBuffer,
+                              typedSplats: Bool,
+                              commandBuffer: MTLCommandBuffer,
+                              scratch: inout [MTLBuffer]) throws {
+        let length = count * stride
+        let gathered = try makeScratchBuffer(length: length, label: "Morton Gather Scratch")
+        scratch.append(gathered)
+
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        encoder.label = "Morton Gather"
+        let pipeline = typedSplats ? reorderSplatsPipeline : reorderElementsPipeline
+        encoder.setComputePipelineState(pipeline)
+        encoder.setBuffer(buffer, offset: offset, index: 0)
+        encoder.setBuffer(gathered, offset: 0, index: 1)
+        encoder.setBuffer(codes, offset: 0, index: 2)
+        if typedSplats {
+            var splatCount = UInt32(count)
+            encoder.setBytes(&splatCount, length: MemoryLayout<UInt32>.stride, index: 3)
+        } else {
+            var parameters = GatherParameters(count: UInt32(count), stride: UInt32(stride))
+            encoder.setBytes(&parameters, length: MemoryLayout<GatherParameters>.stride, index: 3)
+        }
+        dispatch(pipeline, count: count, on: encoder)
+        encoder.endEncoding()
+
+        guard let blit = commandBuffer.makeBlitCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        blit.label = "Morton Gather Copy-Back"
+        blit.copy(from: gathered, sourceOffset: 0, to: buffer, destinationOffset: offset, size: length)
+        blit.endEncoding()
+    }
+
+    private func dispatch(_ pipeline: MTLComputePipelineState, count: Int, on encoder: MTLComputeCommandEncoder) {
+        let width = min(pipeline.maxTotalThreadsPerThreadgroup, 256)
+        encoder.dispatchThreads(MTLSize(width: count, height: 1, depth: 1),
+                                threadsPerThreadgroup: MTLSize(width: width, height: 1, depth: 1))
+    }
+
+    private func makeScratchBuffer(length: Int, label: String) throws -> MTLBuffer {
+        if let scratchHeap {
+            guard let buffer = scratchHeap.makeBuffer(length: length, label: label) else {
+                throw SplatRendererError.failedToCreateBuffer(length: length)
+            }
+            return buffer
+        }
+        guard let buffer = device.makeBuffer(length: length, options: .storageModePrivate) else {
+            throw SplatRendererError.failedToCreateBuffer(length: length)
+        }
+        buffer.label = label
+        return buffer
+    }
+
+    private static func run(_ commandBuffer: MTLCommandBuffer) throws {
+        commandBuffer.commit()
+        commandBuffer.waitUntilCompleted()
+        if let error = commandBuffer.error {
+            log.error("Morton reorder command buffer failed: \(error.localizedDescription)")
+            throw error
+        }
+    }
+
+    /// Stable ascending sort of the code pairs in place; packing code over index makes equal codes keep load order
+    static func sortOnCPU(_ codes: MTLBuffer, count: Int) {
+        let pairs = codes.contents().bindMemory(to: MortonCode.self, capacity: count)
+        var keys = (0..<count).map { UInt64(pairs[$0].code) << 32 | UInt64(pairs[$0].originalIndex) }
+        keys.sort()
+        for (index, key) in keys.enumerated() {
+            pairs[index] = MortonCode(code: UInt32(truncatingIfNeeded: key >> 32),
+                                      originalIndex: UInt32(truncatingIfNeeded: key))
+        }
+    }
+}
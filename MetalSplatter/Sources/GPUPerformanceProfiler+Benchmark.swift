@@ -0,0 +1,434 @@
+import Foundation
+import Metal
+import os
+import simd
+import SplatIO
+
+fileprivate let benchmarkLog = Logger(subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
+                                      category: "SplatBenchmark")
+
+// MARK: - Scene Benchmarks
+
+/**
+ * Benchmarks real captures end to end: every combination of scene, scene size, sort path, render path and scripted
+ * camera path is loaded into a fresh renderer and drawn offscreen, one frame at a time, recording GPU time, CPU
+ * encode time, the renderer's sort telemetry and GPU memory. The report encodes as JSON so runs on the same device
+ * can be diffed between releases.
+ */
+extension GPUPerformanceProfiler {
+
+    public enum BenchmarkSortPath: String, Codable, CaseIterable, Sendable {
+        /// Metal 4 radix sort (iOS 26+, macOS 26+, visionOS 26+); falls back to counting sort elsewhere
+        case metal4
+        case counting
+        case mps
+        case cpu
+    }
+
+    public enum BenchmarkRenderPath: String, Codable, CaseIterable, Sendable {
+        case singleStage
+        /// Requires a depth target and real hardware
+        case multiStage
+        /// Skipped on devices without mesh shader support
+        case meshShader
+        case dithered
+        /// `FastSHSplatRenderer`
+        case fastSH
+        /// `useTileRasterizer`; skipped before iOS 26, macOS 26 and visionOS 26
+        case tileRasterizer
+    }
+
+    /// A scripted camera path framed on the scene's bounds
+    public struct BenchmarkCameraPath: Codable, Sendable {
+        public enum Kind: String, Codable, Sendable {
+            /// One full turn around the scene at twice its radius
+            case orbit
+            /// Straight in from three radii to just inside the scene
+            case dolly
+            /// Sub-centimeter trembling at a fixed pose; exercises sort and SH skipping thresholds
+            case jitter
+        }
+
+        public var kind: Kind
+        public var frameCount: Int
+
+        public init(kind: Kind, frameCount: Int = 120) {
+            self.kind = kind
+            self.frameCount = frameCount
+        }
+
+        public static let orbit = BenchmarkCameraPath(kind: .orbit)
+        public static let dolly = BenchmarkCameraPath(kind: .dolly)
+        public static let jitter = BenchmarkCameraPath(kind: .jitter)
+
+        /// Camera position for `frame`, looking at `center`
+        func eye(frame: Int, center: SIMD3<Float>, radius: Float) -> SIMD3<Float> {
+            let t = frameCount > 1 ? Float(frame) / Float(frameCount - 1) : 0
+            switch kind {
+            case .orbit:
+                let angle = 2 * Float.pi * Float(frame) / Float(max(frameCount, 1))
+                return center + SIMD3(sin(angle) * 2 * radius, 0.25 * radius, cos(angle) * 2 * radius)
+            case .dolly:
+                return center + SIMD3(0, 0, (3 - 2.25 * t) * radius)
+            case .jitter:
+                let phase = Float(frame)
+                return center + SIMD3(0, 0, 2 * radius) + 0.002 * radius * SIMD3(sin(phase * 1.7), cos(phase * 2.3), sin(phase * 0.9))
+            }
+        }
+    }
+
+    public struct BenchmarkConfiguration: Sendable {
+        /// Scene files to load (any format `AutodetectSceneReader` reads)
+        public var scenes: [URL]
+        public var sortPaths: [BenchmarkSortPath] = BenchmarkSortPath.allCases
+        public var renderPaths: [BenchmarkRenderPath] = BenchmarkRenderPath.allCases
+        public var cameraPaths: [BenchmarkCameraPath] = [.orbit, .dolly, .jitter]
+        /// Splat counts to subsample each scene to (evenly strided); empty runs each scene at full size.
+        /// Sizes at or above a scene's splat count run once at full size.
+        public var sceneSizes: [Int] = []
+        /// Frames drawn before measurement starts, so pipelines, pools and the first sort settle
+        public var warmupFrames: Int = 10
+        public var resolution: SIMD2<Int> = SIMD2(1280, 720)
+        public var colorFormat: MTLPixelFormat = .bgra8Unorm
+        public var depthFormat: MTLPixelFormat = .depth32Float
+
+        public init(scenes: [URL]) {
+            self.scenes = scenes
+        }
+    }
+
+    /// Millisecond summary of one measured quantity
+    public struct BenchmarkStatistics: Codable, Sendable, Equatable {
+        public let count: Int
+        public let mean: Double
+        public let min: Double
+        public let max: Double
+        public let p50: Double
+        public let p90: Double
+        public let p99: Double
+
+        /// - Parameter seconds: Samples in seconds; summarized in milliseconds
+        public init?(seconds: [TimeInterval]) {
+            guard !seconds.isEmpty else { return nil }
+            let sorted = seconds.map { $0 * 1000 }.sorted()
+            count = sorted.count
+            mean = sorted.reduce(0, +) / Double(sorted.count)
+            min = sorted[0]
+            max = sorted[sorted.count - 1]
+            p50 = Self.percentile(sorted, 0.50)
+            p90 = Self.percentile(sorted, 0.90)
+            p99 = Self.percentile(sorted, 0.99)
+        }
+
+        /// Nearest-rank percentile of ascending samples
+        static func percentile(_ sorted: [Double], _ fraction: Double) -> Double {
+            let rank = Int((fraction * Double(sorted.count)).rounded(.up))
+            return sorted[Swift.min(Swift.max(rank, 1), sorted.count) - 1]
+        }
+    }
+
+    public struct BenchmarkMemory: Codable, Sendable {
+        /// Bytes of splat data the renderer holds in its primary buffer
+        public let splatBufferBytes: Int
+        /// `MTLDevice.currentAllocatedSize` growth from before the renderer was created to after loading
+        public let gpuAllocatedBytesAfterLoad: Int
+        /// Highest `MTLDevice.currentAllocatedSize` growth seen while drawing
+        public let peakGPUAllocatedBytes: Int
+    }
+
+    public struct BenchmarkResult: Codable, Sendable {
+        public let scene: String
+        public let splatCount: Int
+        public let sortPath: BenchmarkSortPath
+        public let renderPath: BenchmarkRenderPath
+        public let cameraPath: BenchmarkCameraPath.Kind
+        public let frameCount: Int
+        /// Set when the combination can't run on this device; every measurement is then absent
+        public let skippedReason: String?
+        public let gpuFrameTime: BenchmarkStatistics?
+        public let cpuEncodeTime: BenchmarkStatistics?
+        /// Wall time from scheduling a sort to its order being published
+        public let sortLatency: BenchmarkStatistics?
+        public let sortGPUTime: BenchmarkStatistics?
+        /// Sort paths the renderer actually took (a path falls back when unsupported)
+        public let observedSortPaths: [String]
+        public let memory: BenchmarkMemory?
+    }
+
+    public struct BenchmarkReport: Codable, Sendable {
+        public let deviceName: String
+        public let operatingSystem: String
+        public let date: Date
+        public let resolution: [Int]
+        public let results: [BenchmarkResult]
+
+        /// Pretty-printed JSON with sorted keys and ISO 8601 dates, stable enough to diff
+        public func jsonData() throws -> Data {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+            encoder.dateEncodingStrategy = .iso8601
+            return try encoder.encode(self)
+        }
+    }
+
+    /// Runs every combination in `configuration`, one fresh renderer each.
+    ///
+    /// - Warning: Blocks on GPU completion each frame; run it off the main thread.
+    public func runBenchmark(_ configuration: BenchmarkConfiguration) async throws -> BenchmarkReport {
+        var results: [BenchmarkResult] = []
+        for sceneURL in configuration.scenes {
+            let reader = try AutodetectSceneReader(sceneURL)
+            var scene = SplatMemoryBuffer()
+            try await scene.read(from: reader)
+            let sizes = configuration.sceneSizes.isEmpty ? [scene.points.count] : configuration.sceneSizes
+            var ranSizes = Set<Int>()
+            for size in sizes {
+                let points = Self.subsample(scene.points, to: size)
+                guard ranSizes.insert(points.count).inserted else { continue }
+                for renderPath in configuration.renderPaths {
+                    for sortPath in configuration.sortPaths {
+                        for cameraPath in configuration.cameraPaths {
+                            let result = try await benchmark(points: points,
+                                                             sceneName: sceneURL.lastPathComponent,
+                                                             sortPath: sortPath,
+                                                             renderPath: renderPath,
+                                                             cameraPath: cameraPath,
+                                                             configuration: configuration)
+                            benchmarkLog.info("\(sceneURL.lastPathComponent, privacy: .public) \(points.count) \(renderPath.rawValue, privacy: .public)/\(sortPath.rawValue, privacy: .public)/\(cameraPath.kind.rawValue, privacy: .public): gpu p50 \(result.gpuFrameTime?.p50 ?? -1)ms")
+                            results.append(result)
+                        }
+                    }
+                }
+            }
+        }
+
+        return BenchmarkReport(deviceName: device.name,
+                               operatingSystem: ProcessInfo.processInfo.operatingSystemVersionString,
+                               date: Date(),
+                               resolution: [configuration.resolution.x, configuration.resolution.y],
+                               results: results)
+    }
+
+    // MARK: - Private
+
+    private func benchmark(points: [SplatScenePoint],
+                           sceneName: String,
+                           sortPath: BenchmarkSortPath,
+                           renderPath: BenchmarkRenderPath,
+                           cameraPath: BenchmarkCameraPath,
+                           configuration: BenchmarkConfiguration) async throws -> BenchmarkResult {
+        func skipped(_ reason: String) -> BenchmarkResult {
+            BenchmarkResult(scene: sceneName, splatCount: points.count, sortPath: sortPath, renderPath: renderPath,
+                            cameraPath: cameraPath.kind, frameCount: 0, skippedReason: reason,
+                            gpuFrameTime: nil, cpuEncodeTime: nil, sortLatency: nil, sortGPUTime: nil,
+                            observedSortPaths: [], memory: nil)
+        }
+
+        let baselineAllocation = device.currentAllocatedSize
+        let renderer: SplatRenderer = renderPath == .fastSH
+            ? try FastSHSplatRenderer(device: device, colorFormat: configuration.colorFormat,
+                                      depthFormat: configuration.depthFormat, sampleCount: 1,
+                                      maxViewCount: 1, maxSimultaneousRenders: 3)
+            : try SplatRenderer(device: device, colorFormat: configuration.colorFormat,
+                                depthFormat: configuration.depthFormat, sampleCount: 1,
+                                maxViewCount: 1, maxSimultaneousRenders: 3)
+
+        renderer.asynchronousPipelineCompilation = false
+        // Mesh shaders auto-enable once their pipeline compiles; only the mesh shader path should draw with them
+        renderer.meshShaderEnabled = false
+        switch renderPath {
+        case .singleStage, .fastSH:
+            renderer.highQualityDepth = false
+        case .multiStage:
+            renderer.highQualityDepth = true
+            guard renderer.useMultiStagePipeline else { return skipped("multi-stage pipeline needs a depth target and real hardware") }
+        case .meshShader:
+            renderer.highQualityDepth = false
+            renderer.meshShaderEnabled = true
+            // Compiles the mesh pipeline now rather than waiting on the background compile started at init
+            renderer.prewarmRenderPipelines()
+            guard renderer.isMeshShaderSupported else { return skipped("mesh shaders unsupported") }
+        case .dithered:
+            renderer.useDitheredTransparency = true
+        case .tileRasterizer:
+            renderer.highQualityDepth = false
+            renderer.useTileRasterizer = true
+            guard renderer.isTileRasterizerSupported else { return skipped("tile rasterizer unavailable") }
+        }
+
+        renderer.useIncrementalSorting = false
+        renderer.useMetal4Sorting = sortPath == .metal4
+        renderer.metal4SortingThreshold = 0
+        renderer.useCountingSort = sortPath == .counting || sortPath == .metal4
+        renderer.prefersCPUSorting = sortPath == .cpu
+
+        let sortSamples = SortSampleCollector()
+        renderer.sortPerformanceObserver = { sortSamples.append($0) }
+
+        if let fastSHRenderer = renderer as? FastSHSplatRenderer {
+            try await fastSHRenderer.loadSplatsWithSH(points)
+        } else {
+            try renderer.add(points)
+        }
+        let loadedAllocation = device.currentAllocatedSize
+
+        let (colorTexture, depthTexture) = try makeTargets(configuration)
+        let (center, radius) = Self.bounds(of: points)
+        let size = configuration.resolution
+        let projection = Self.perspective(fovY: .pi / 3, aspect: Float(size.x) / Float(size.y),
+                                          near: max(radius * 0.001, 0.01), far: radius * 10 + 10)
+
+        var gpuTimes: [TimeInterval] = []
+        var encodeTimes: [TimeInterval] = []
+        var peakAllocation = loadedAllocation
+        let totalFrames = configuration.warmupFrames + cameraPath.frameCount
+        for frame in 0..<totalFrames {
+            let measuring = frame >= configuration.warmupFrames
+            if frame == configuration.warmupFrames {
+                sortSamples.removeAll()
+            }
+            let pathFrame = max(frame - configuration.warmupFrames, 0)
+            let viewMatrix = Self.lookAt(eye: cameraPath.eye(frame: pathFrame, center: center, radius: radius),
+                                         target: center,
+                                         up: SIMD3(0, 1, 0))
+            let viewport = MTLViewport(originX: 0, originY: 0, width: Double(size.x), height: Double(size.y), znear: 0, zfar: 1)
+
+            guard let commandBuffer = commandQueue.makeCommandBuffer() else {
+                throw SplatRendererError.failedToCreateCommandBuffer
+            }
+            let encodeStart = CFAbsoluteTimeGetCurrent()
+            if let fastSHRenderer = renderer as? FastSHSplatRenderer {
+                try fastSHRenderer.render(viewports: [ModelRendererViewportDescriptor(viewport: viewport,
+                                                                                      projectionMatrix: projection,
+                                                                                      viewMatrix: viewMatrix,
+                                                                                      screenSize: size)],
+                                          colorTexture: colorTexture,
+                                          colorStoreAction: .store,
+                                          depthTexture: depthTexture,
+                                          rasterizationRateMap: nil,
+                                          renderTargetArrayLength: 0,
+                                          to: commandBuffer)
+            } else {
+                try renderer.render(viewports: [SplatRenderer.ViewportDescriptor(viewport: viewport,
+                                                                                 projectionMatrix: projection,
+                                                                                 viewMatrix: viewMatrix,
+                                                                                 screenSize: size)],
+                                    colorTexture: colorTexture,
+                                    colorStoreAction: .store,
+                                    depthTexture: depthTexture,
+                                    rasterizationRateMap: nil,
+                                    renderTargetArrayLength: 0,
+                                    to: commandBuffer)
+            }
+            let encodeTime = CFAbsoluteTimeGetCurrent() - encodeStart
+            commandBuffer.commit()
+            commandBuffer.waitUntilCompleted()
+
+            guard measuring else { continue }
+            encodeTimes.append(encodeTime)
+            let gpuTime = commandBuffer.gpuEndTime - commandBuffer.gpuStartTime
+            if gpuTime > 0 {
+                gpuTimes.append(gpuTime)
+            }
+            peakAllocation = max(peakAllocation, device.currentAllocatedSize)
+        }
+        renderer.sortPerformanceObserver = nil
+
+        let samples = sortSamples.samples
+        return BenchmarkResult(scene: sceneName,
+                               splatCount: points.count,
+                               sortPath: sortPath,
+                               renderPath: renderPath,
+                               cameraPath: cameraPath.kind,
+                               frameCount: cameraPath.frameCount,
+                               skippedReason: nil,
+                               gpuFrameTime: BenchmarkStatistics(seconds: gpuTimes),
+                               cpuEncodeTime: BenchmarkStatistics(seconds: encodeTimes),
+                               sortLatency: BenchmarkStatistics(seconds: samples.map(\.wallTime)),
+                               sortGPUTime: BenchmarkStatistics(seconds: samples.compactMap(\.gpuTime)),
+                               observedSortPaths: Set(samples.map(\.path.rawValue)).sorted(),
+                               memory: BenchmarkMemory(splatBufferBytes: renderer.splatCount * MemoryLayout<SplatRenderer.Splat>.stride,
+                                                       gpuAllocatedBytesAfterLoad: loadedAllocation - baselineAllocation,
+                                                       peakGPUAllocatedBytes: peakAllocation - baselineAllocation))
+    }
+
+    private func makeTargets(_ configuration: BenchmarkConfiguration) throws -> (MTLTexture, MTLTexture?) {
+        let size = configuration.resolution
+        let colorDescriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: configuration.colorFormat,
+                                                                       width: size.x, height: size.y, mipmapped: false)
+        colorDescriptor.usage = .renderTarget
+        colorDescriptor.storageMode = .private
+        guard let colorTexture = device.makeTexture(descriptor: colorDescriptor) else {
+            throw SplatRendererError.failedToCreateBuffer(length: size.x * size.y * 4)
+        }
+        colorTexture.label = "Benchmark Color"
+
+        guard configuration.depthFormat != .invalid else { return (colorTexture, nil) }
+        let depthDescriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: configuration.depthFormat,
+                                                                       width: size.x, height: size.y, mipmapped: false)
+        depthDescriptor.usage = .renderTarget
+        depthDescriptor.storageMode = .private
+        guard let depthTexture = device.makeTexture(descriptor: depthDescriptor) else {
+            throw SplatRendererError.failedToCreateBuffer(length: size.x * size.y * 4)
+        }
+        depthTexture.label = "Benchmark Depth"
+        return (colorTexture, depthTexture)
+    }
+
+    static func subsample(_ points: [SplatScenePoint], to count: Int) -> [SplatScenePoint] {
+        guard count > 0, count < points.count else { return points }
+        return (0..<count).map { points[$0 * points.count / count] }
+    }
+
+    static func bounds(of points: [SplatScenePoint]) -> (center: SIMD3<Float>, radius: Float) {
+        guard let first = points.first?.position else { return (.zero, 1) }
+        let (lower, upper) = points.reduce((first, first)) { (simd_min($0.0, $1.position), simd_max($0.1, $1.position)) }
+        return ((lower + upper) / 2, max(simd_length(upper - lower) / 2, 0.01))
+    }
+
+    /// Right-handed view matrix
+    static func lookAt(eye: SIMD3<Float>, target: SIMD3<Float>, up: SIMD3<Float>) -> simd_float4x4 {
+        let z = simd_normalize(eye - target)
+        let x = simd_normalize(simd_cross(up, z))
+        let y = simd_cross(z, x)
+        return simd_float4x4(columns: (SIMD4(x.x, y.x, z.x, 0),
+                                       SIMD4(x.y, y.y, z.y, 0),
+                                       SIMD4(x.z, y.z, z.z, 0),
+                                       SIMD4(-simd_dot(x, eye), -simd_dot(y, eye), -simd_dot(z, eye), 1)))
+    }
+
+    /// Right-handed perspective projection with Metal's [0, 1] clip depth
+    static func perspective(fovY: Float, aspect: Float, near: Float, far: Float) -> simd_float4x4 {
+        let yScale = 1 / tan(fovY / 2)
+        let xScale = yScale / aspect
+        let zScale = far / (near - far)
+        return simd_float4x4(columns: (SIMD4(xScale, 0, 0, 0),
+                                       SIMD4(0, yScale, 0, 0),
+                                       SIMD4(0, 0, zScale, -1),
+                                       SIMD4(0, 0, zScale * near, 0)))
+    }
+}
+
+/// Sort telemetry gathered from sort completion threads
+private final class SortSampleCollector: @unchecked Sendable {
+    private var storage: [SplatRenderer.SortPerformanceSample] = []
+    private let lock = NSLock()
+
+    var samples: [SplatRenderer.SortPerformanceSample] {
+        lock.lock()
+        defer { lock.unlock() }
+        return storage
+    }
+
+    func append(_ sample: SplatRenderer.SortPerformanceSample) {
+        lock.lock()
+        storage.append(sample)
+        lock.unlock()
+    }
+
+    func removeAll() {
+        lock.lock()
+        storage.removeAll()
+        lock.unlock()
+    }
+}
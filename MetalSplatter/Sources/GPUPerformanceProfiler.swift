@@ -73,8 +73,8 @@ public class GPUPerformanceProfiler {
     
     // MARK: - Properties
     
-    private let device: MTLDevice
-    private let commandQueue: MTLCommandQueue
+    let device: MTLDevice
+    let commandQueue: MTLCommandQueue
     private let log = Logger(
         subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
         category: "GPUPerformanceProfiler"
@@ -0,0 +1,172 @@
+import Metal
+import simd
+import os
+
+/// Temporally coherent refinement of the previous frame's sort order
+///
+/// Small camera motions leave the last sorted indices nearly back-to-front, so rather than
+/// sorting from scratch this copies the previous order and runs a bounded number of tile passes:
+/// 1. Refine: each threadgroup re-evaluates depth for a 1024-entry tile and bitonic-sorts it
+///    in threadgroup memory (tiles already in order are skipped)
+/// 2. Passes alternate the tile origin by half a tile, so splats migrate across tile boundaries
+/// 3. Residual: counts adjacent pairs still out of order, read back once the command buffer completes
+///
+/// The residual tells the renderer when the order has degraded too far (fast motion, large
+/// reorders) and the next sort should be a full counting or radix sort.
+///
+/// Pipelines are immutable and the residual counter is only touched by one sort at a time (the
+/// renderer serializes sorts), so the sorter can be captured by command buffer completion handlers.
+internal final class IncrementalSorter: @unchecked Sendable {
+
+    private static let log = Logger(subsystem: Bundle.main.bundleIdentifier ?? "MetalSplatter",
+                                    category: "IncrementalSorter")
+
+    // Keep in sync with IncrementalSort.metal
+    static let tileSize = 1024
+    private static let threadsPerTile = tileSize / 2
+
+    // Parameters structure matching Metal shader
+    struct IncrementalSortParams {
+        var count: UInt32
+        var tileOffset: UInt32
+    }
+
+    private let device: MTLDevice
+
+    // Pipeline states
+    private let refinePipeline: MTLComputePipelineState
+    private let countInversionsPipeline: MTLComputePipelineState
+
+    // Shared so the residual can be read on completion; sorts are serialized by the renderer
+    private let inversionCountBuffer: MTLBuffer
+
+    internal init(device: MTLDevice, library: MTLLibrary) throws {
+        self.device = device
+
+        guard let refineFunction = library.makeFunction(name: "incrementalSortRefineTiles") else {
+            throw SplatRendererError.failedToLoadShaderFunction(name: "incrementalSortRefineTiles")
+        }
+        guard let countInversionsFunction = library.makeFunction(name: "incrementalSortCountInversions") else {
+            throw SplatRendererError.failedToLoadShaderFunction(name: "incrementalSortCountInversions")
+        }
+
+        do {
+            refinePipeline = try device.makeComputePipelineState(function: refineFunction)
+        } catch {
+            throw SplatRendererError.failedToCreateComputePipelineState(functionName: "incrementalSortRefineTiles", underlying: error)
+        }
+        do {
+            countInversionsPipeline = try device.makeComputePipelineState(function: countInversionsFunction)
+        } catch {
+            throw SplatRendererError.failedToCreateComputePipelineState(functionName: "incrementalSortCountInversions", underlying: error)
+        }
+
+        // Every thread performs one compare-exchange per bitonic step, so the whole tile must fit one threadgroup
+        guard refinePipeline.maxTotalThreadsPerThreadgroup >= Self.threadsPerTile else {
+            throw SplatRendererError.internalPipelineMismatch(
+                expected: "\(Self.threadsPerTile) threads per threadgroup",
+                actual: "\(refinePipeline.maxTotalThreadsPerThreadgroup)"
+            )
+        }
+
+        let counterLength = MemoryLayout<UInt32>.stride
+        guard let counter = device.makeBuffer(length: counterLength, options: .storageModeShared) else {
+            throw SplatRendererError.failedToCreateBuffer(length: counterLength)
+        }
+        counter.label = "Incremental Sort Inversion Count"
+        inversionCountBuffer = counter
+    }
+
+    /// Encodes refinement of `previousOrder` into `outputBuffer`
+    /// - Parameters:
+    ///   - commandBuffer: Command buffer to encode into
+    ///   - splatBuffer: Buffer containing splat data
+    ///   - previousOrder: Last published sorted indices, read-only
+    ///   - outputBuffer: Receives the refined order (may not alias `previousOrder`)
+    ///   - count: Entries in `previousOrder` (the renderable splat count it was sorted for)
+    ///   - cameraPosition: Camera world position
+    ///   - cameraForward: Camera forward direction
+    ///   - sortByDistance: True for radial distance, false for projected distance
+    ///   - passCount: Tile passes to run; each pass lets a splat move up to half a tile
+    internal func refine(
+        commandBuffer: MTLCommandBuffer,
+        splatBuffer: MTLBuffer,
+        previousOrder: MTLBuffer,
+        outputBuffer: MTLBuffer,
+        count: Int,
+        cameraPosition: SIMD3<Float>,
+        cameraForward: SIMD3<Float>,
+        sortByDistance: Bool,
+        passCount: Int
+    ) throws {
+        guard count > 0 else { return }
+
+        var cameraPos = cameraPosition
+        var cameraFwd = cameraForward
+        var sortByDist = sortByDistance
+        let orderLength = count * MemoryLayout<Int32>.stride
+
+        guard let blit = commandBuffer.makeBlitCommandEncoder() else {
+            Self.log.error("Failed to create blit encoder for incremental sort")
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        blit.label = "IncrementalSort Seed"
+        blit.copy(from: previousOrder, sourceOffset: 0, to: outputBuffer, destinationOffset: 0, size: orderLength)
+        blit.fill(buffer: inversionCountBuffer, range: 0..<MemoryLayout<UInt32>.stride, value: 0)
+        blit.endEncoding()
+
+        for pass in 0..<max(passCount, 1) {
+            let tileOffset = pass % 2 == 0 ? 0 : Self.tileSize / 2
+            guard count > tileOffset + 1 else { continue }
+            var params = IncrementalSortParams(count: UInt32(count), tileOffset: UInt32(tileOffset))
+            let tileCount = (count - tileOffset + Self.tileSize - 1) / Self.tileSize
+
+            guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+                throw SplatRendererError.failedToCreateComputeEncoder
+            }
+            encoder.label = "IncrementalSort Refine \(pass)"
+            encoder.setComputePipelineState(refinePipeline)
+            encoder.setBuffer(splatBuffer, offset: 0, index: 0)
+            encoder.setBuffer(outputBuffer, offset: 0, index: 1)
+            encoder.setBytes(&params, length: MemoryLayout<IncrementalSortParams>.size, index: 2)
+            encoder.setBytes(&cameraPos, length: MemoryLayout<SIMD3<Float>>.size, index: 3)
+            encoder.setBytes(&cameraFwd, length: MemoryLayout<SIMD3<Float>>.size, index: 4)
+            encoder.setBytes(&sortByDist, length: MemoryLayout<Bool>.size, index: 5)
+            encoder.dispatchThreadgroups(
+                MTLSize(width: tileCount, height: 1, depth: 1),
+                threadsPerThreadgroup: MTLSize(width: Self.threadsPerTile, height: 1, depth: 1)
+            )
+            encoder.endEncoding()
+        }
+
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        var params = IncrementalSortParams(count: UInt32(count), tileOffset: 0)
+        let threadsPerGroup = min(256, countInversionsPipeline.maxTotalThreadsPerThreadgroup)
+        encoder.label = "IncrementalSort Residual"
+        encoder.setComputePipelineState(countInversionsPipeline)
+        encoder.setBuffer(splatBuffer, offset: 0, index: 0)
+        encoder.setBuffer(outputBuffer, offset: 0, index: 1)
+        encoder.setBytes(&params, length: MemoryLayout<IncrementalSortParams>.size, index: 2)
+        encoder.setBytes(&cameraPos, length: MemoryLayout<SIMD3<Float>>.size, index: 3)
+        encoder.setBytes(&cameraFwd, length: MemoryLayout<SIMD3<Float>>.size, index: 4)
+        encoder.setBytes(&sortByDist, length: MemoryLayout<Bool>.size, index: 5)
+        encoder.setBuffer(inversionCountBuffer, offset: 0, index: 6)
+        encoder.dispatchThreadgroups(
+            MTLSize(width: (count + threadsPerGroup - 1) / threadsPerGroup, height: 1, depth: 1),
+            threadsPerThreadgroup: MTLSize(width: threadsPerGroup, height: 1, depth: 1)
+        )
+        encoder.endEncoding()
+    }
+
+    /// Fraction of adjacent pairs left out of order by the last `refine`; only valid once its command buffer completes
+    internal func residualInversionRatio(count: Int) -> Double {
+        let inversions = inversionCountBuffer.contents().load(as: UInt32.self)
+        return Self.inversionRatio(inversions: Int(inversions), count: count)
+    }
+
+    static func inversionRatio(inversions: Int, count: Int) -> Double {
+        count > 1 ? Double(inversions) / Double(count - 1) : 0
+    }
+}
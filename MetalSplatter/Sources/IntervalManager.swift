@@ -110,6 +110,19 @@ public class IntervalManager {
         return index
     }
 
+    /// Removes the registered interval that starts at `sourceStart`.
+    /// - Parameter sourceStart: Source start of the interval to remove
+    /// - Returns: True if an interval was removed
+    @discardableResult
+    public func unregisterInterval(sourceStart: Int) -> Bool {
+        guard let index = intervals.firstIndex(where: { $0.sourceStart == sourceStart }) else {
+            return false
+        }
+        intervals.remove(at: index)
+        rebuildActiveIntervals()
+        return true
+    }
+
     /// Clears all registered intervals
     public func clearIntervals() {
         intervals.removeAll()
@@ -55,6 +55,25 @@ internal class Metal4Sorter {
     private let scatterWritePipeline: MTLComputePipelineState     // Phase 3: stable write
     private let extractIndicesPipeline: MTLComputePipelineState
 
+    /// Times each pass when the renderer's frame timeline is on
+    var timelineRecorder: FrameTimelineRecorder?
+
+    /// When set, `sort` carves its keys and scan buffers from this arena per call and hands them back once
+    /// encoded, instead of keeping its own buffers sized for the largest sort so far
+    var scratchHeap: MetalScratchHeap? {
+        didSet {
+            if scratchHeap != nil {
+                releaseBuffers()
+            }
+        }
+    }
+
+    private struct ScanBuffers {
+        let histogram: MTLBuffer
+        let tgCounts: MTLBuffer
+        let tgOffsets: MTLBuffer
+    }
+
     // Reusable buffers (allocated on demand)
     private var keysBufferA: MTLBuffer?
     private var keysBufferB: MTLBuffer?
@@ -113,6 +132,16 @@ internal class Metal4Sorter {
         Self.log.info("Metal4Sorter initialized with \(Self.radixPasses)-pass stable radix sort (8-bit buckets)")
     }
 
+    private func releaseBuffers() {
+        keysBufferA = nil
+        keysBufferB = nil
+        histogramBuffer = nil
+        tgBucketCountsBuffer = nil
+        tgBucketOffsetsBuffer = nil
+        allocatedCount = 0
+        allocatedThreadgroups = 0
+    }
+
     /// Ensure buffers are allocated for the given splat count
     private func ensureBuffers(count: Int) throws {
         guard count > allocatedCount else { return }
@@ -125,6 +154,17 @@ internal class Metal4Sorter {
         keysBufferB = device.makeBuffer(length: keyBufferSize, options: .storageModePrivate)
         keysBufferB?.label = "Metal4Sorter Keys B"
 
+        guard keysBufferA != nil, keysBufferB != nil else {
+            throw SplatRendererError.failedToCreateBuffer(length: keyBufferSize)
+        }
+        try ensureScanBuffers(count: count)
+
+        allocatedCount = count
+        Self.log.debug("Allocated buffers for \(count) splats")
+    }
+
+    /// Ensure histogram and per-threadgroup scan buffers cover `count` keys
+    private func ensureScanBuffers(count: Int) throws {
         // Histogram buffer: 256 atomic uints
         let histogramSize = Self.bucketsPerPass * MemoryLayout<UInt32>.stride
         if histogramBuffer == nil || histogramBuffer!.length < histogramSize {
@@ -145,13 +185,34 @@ internal class Metal4Sorter {
             allocatedThreadgroups = numThreadgroups
         }
 
-        guard keysBufferA != nil, keysBufferB != nil, histogramBuffer != nil,
-              tgBucketCountsBuffer != nil, tgBucketOffsetsBuffer != nil else {
-            throw SplatRendererError.failedToCreateBuffer(length: keyBufferSize)
+        guard histogramBuffer != nil, tgBucketCountsBuffer != nil, tgBucketOffsetsBuffer != nil else {
+            throw SplatRendererError.failedToCreateBuffer(length: numThreadgroups * Self.bucketsPerPass * MemoryLayout<UInt32>.stride)
         }
+    }
 
-        allocatedCount = count
-        Self.log.debug("Allocated buffers for \(count) splats (\(numThreadgroups) threadgroups)")
+    private func persistentScanBuffers(count: Int) throws -> ScanBuffers {
+        try ensureScanBuffers(count: count)
+        guard let histogramBuffer, let tgBucketCountsBuffer, let tgBucketOffsetsBuffer else {
+            throw SplatRendererError.failedToCreateBuffer(length: 0)
+        }
+        return ScanBuffers(histogram: histogramBuffer, tgCounts: tgBucketCountsBuffer, tgOffsets: tgBucketOffsetsBuffer)
+    }
+
+    private func makeScratchBuffer(_ heap: MetalScratchHeap, length: Int, label: String) throws -> MTLBuffer {
+        guard let buffer = heap.makeBuffer(length: length, label: label) else {
+            throw SplatRendererError.failedToCreateBuffer(length: length)
+        }
+        return buffer
+    }
+
+    private func scratchScanBuffers(_ heap: MetalScratchHeap, count: Int) throws -> ScanBuffers {
+        let tgBufferSize = (count + Self.scatterThreadgroupSize - 1) / Self.scatterThreadgroupSize
+            * Self.bucketsPerPass * MemoryLayout<UInt32>.stride
+        return ScanBuffers(
+            histogram: try makeScratchBuffer(heap, length: Self.bucketsPerPass * MemoryLayout<UInt32>.stride,
+                                             label: "Metal4Sorter Histogram"),
+            tgCounts: try makeScratchBuffer(heap, length: tgBufferSize, label: "Metal4Sorter TG Bucket Counts"),
+            tgOffsets: try makeScratchBuffer(heap, length: tgBufferSize, label: "Metal4Sorter TG Bucket Offsets"))
     }
 
     /// Sort splats by depth using GPU radix sort
@@ -174,13 +235,26 @@ internal class Metal4Sorter {
     ) throws {
         guard count > 0 else { return }
 
-        try ensureBuffers(count: count)
-
-        guard let keysA = keysBufferA,
-              let keysB = keysBufferB,
-              let histogram = histogramBuffer,
-              let tgOffsets = tgBucketOffsetsBuffer else {
-            throw SplatRendererError.failedToCreateBuffer(length: 0)
+        let keysA: MTLBuffer
+        let keysB: MTLBuffer
+        let scan: ScanBuffers
+        if let scratchHeap {
+            let keyBufferSize = count * MemoryLayout<SortingKey>.stride
+            keysA = try makeScratchBuffer(scratchHeap, length: keyBufferSize, label: "Metal4Sorter Keys A")
+            keysB = try makeScratchBuffer(scratchHeap, length: keyBufferSize, label: "Metal4Sorter Keys B")
+            scan = try scratchScanBuffers(scratchHeap, count: count)
+        } else {
+            try ensureBuffers(count: count)
+            guard let keysBufferA, let keysBufferB else {
+                throw SplatRendererError.failedToCreateBuffer(length: 0)
+            }
+            keysA = keysBufferA
+            keysB = keysBufferB
+            scan = try persistentScanBuffers(count: count)
+        }
+        defer {
+            // Everything using the scratch is encoded by now (or abandoned with the command buffer on a throw)
+            scratchHeap?.recycle([keysA, keysB, scan.histogram, scan.tgCounts, scan.tgOffsets])
         }
 
         // Step 1: Build sorting keys from splat positions
@@ -195,10 +269,43 @@ internal class Metal4Sorter {
             commandBuffer: commandBuffer
         )
 
-        // Step 2: Multi-pass stable radix sort (LSD - least significant digit first)
-        // Ping-pong between keysA and keysB
-        var inputKeys = keysA
-        var outputKeys = keysB
+        // Step 2: Multi-pass stable radix sort; the result lands back in keysA
+        try sortKeys(keysA, scratch: keysB, scan: scan, count: count, commandBuffer: commandBuffer)
+        let finalKeys = keysA
+
+        // Step 3: Extract sorted indices
+        try encodeExtractIndices(
+            sortedKeys: finalKeys,
+            outputIndices: outputIndices,
+            count: count,
+            commandBuffer: commandBuffer
+        )
+    }
+
+    /// Stable ascending radix sort of `count` caller-built keys, ordered by the raw 32 bits of `SortingKey.depth`.
+    /// The sorted keys end up back in `keys` (the pass count is even); `scratch` must hold `count` keys too.
+    func sortKeys(_ keys: MTLBuffer, scratch: MTLBuffer, count: Int, commandBuffer: MTLCommandBuffer) throws {
+        guard count > 0 else { return }
+        guard let scratchHeap else {
+            try sortKeys(keys, scratch: scratch, scan: persistentScanBuffers(count: count), count: count, commandBuffer: commandBuffer)
+            return
+        }
+        let scan = try scratchScanBuffers(scratchHeap, count: count)
+        defer { scratchHeap.recycle([scan.histogram, scan.tgCounts, scan.tgOffsets]) }
+        try sortKeys(keys, scratch: scratch, scan: scan, count: count, commandBuffer: commandBuffer)
+    }
+
+    private func sortKeys(_ keys: MTLBuffer,
+                          scratch: MTLBuffer,
+                          scan: ScanBuffers,
+                          count: Int,
+                          commandBuffer: MTLCommandBuffer) throws {
+        let histogram = scan.histogram
+
+        // Multi-pass stable radix sort (LSD - least significant digit first)
+        // Ping-pong between keys and scratch
+        var inputKeys = keys
+        var outputKeys = scratch
 
         for pass in 0..<Self.radixPasses {
             let byteIndex = UInt32(pass)  // 0, 1, 2, 3 for each byte
@@ -229,7 +336,8 @@ internal class Metal4Sorter {
                 inputKeys: inputKeys,
                 outputKeys: outputKeys,
                 histogram: histogram,
-                tgOffsets: tgOffsets,
+                tgCounts: scan.tgCounts,
+                tgOffsets: scan.tgOffsets,
                 byteIndex: byteIndex,
                 count: count,
                 commandBuffer: commandBuffer
@@ -238,17 +346,6 @@ internal class Metal4Sorter {
             // Swap buffers for next pass
             swap(&inputKeys, &outputKeys)
         }
-
-        // After 4 passes (even), result is in keysA
-        let finalKeys = keysA
-
-        // Step 3: Extract sorted indices
-        try encodeExtractIndices(
-            sortedKeys: finalKeys,
-            outputIndices: outputIndices,
-            count: count,
-            commandBuffer: commandBuffer
-        )
     }
 
     // MARK: - Private Encoding Methods
@@ -262,7 +359,7 @@ internal class Metal4Sorter {
         count: Int,
         commandBuffer: MTLCommandBuffer
     ) throws {
-        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortKeys, with: timelineRecorder) else {
             throw SplatRendererError.failedToCreateComputeEncoder
         }
         encoder.label = "Build Sorting Keys"
@@ -292,7 +389,7 @@ internal class Metal4Sorter {
         histogram: MTLBuffer,
         commandBuffer: MTLCommandBuffer
     ) throws {
-        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) else {
             throw SplatRendererError.failedToCreateComputeEncoder
         }
         encoder.label = "Reset Histogram"
@@ -313,7 +410,7 @@ internal class Metal4Sorter {
         count: Int,
         commandBuffer: MTLCommandBuffer
     ) throws {
-        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) else {
             throw SplatRendererError.failedToCreateComputeEncoder
         }
         encoder.label = "Histogram Pass (byte \(byteIndex))"
@@ -339,7 +436,7 @@ internal class Metal4Sorter {
         histogram: MTLBuffer,
         commandBuffer: MTLCommandBuffer
     ) throws {
-        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) else {
             throw SplatRendererError.failedToCreateComputeEncoder
         }
         encoder.label = "Prefix Sum"
@@ -368,15 +465,12 @@ internal class Metal4Sorter {
         inputKeys: MTLBuffer,
         outputKeys: MTLBuffer,
         histogram: MTLBuffer,
+        tgCounts: MTLBuffer,
         tgOffsets: MTLBuffer,
         byteIndex: UInt32,
         count: Int,
         commandBuffer: MTLCommandBuffer
     ) throws {
-        guard let tgCounts = tgBucketCountsBuffer else {
-            throw SplatRendererError.failedToCreateBuffer(length: 0)
-        }
-
         var splatCount = UInt32(count)
         var byte = byteIndex
 
@@ -390,7 +484,7 @@ internal class Metal4Sorter {
 
         // Phase 1: Count elements per bucket per threadgroup
         // Stores counts to tgCounts[threadgroup_id * 256 + bucket]
-        guard let countEncoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let countEncoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) else {
             throw SplatRendererError.failedToCreateComputeEncoder
         }
         countEncoder.label = "Scatter Count (byte \(byteIndex))"
@@ -407,7 +501,7 @@ internal class Metal4Sorter {
 
         // Phase 2: Compute deterministic block offsets via prefix sum across threadgroups
         // For each bucket, iterates through TGs in order to compute starting positions
-        guard let offsetsEncoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let offsetsEncoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) else {
             throw SplatRendererError.failedToCreateComputeEncoder
         }
         offsetsEncoder.label = "Scatter Offsets (byte \(byteIndex))"
@@ -425,7 +519,7 @@ internal class Metal4Sorter {
 
         // Phase 3: Write elements in stable order using pre-computed offsets
         // Each thread computes its local rank within its threadgroup's bucket
-        guard let writeEncoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let writeEncoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) else {
             throw SplatRendererError.failedToCreateComputeEncoder
         }
         writeEncoder.label = "Scatter Write (byte \(byteIndex))"
@@ -451,7 +545,7 @@ internal class Metal4Sorter {
         count: Int,
         commandBuffer: MTLCommandBuffer
     ) throws {
-        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let encoder = commandBuffer.makeComputeCommandEncoder(timing: .sortPasses, with: timelineRecorder) else {
             throw SplatRendererError.failedToCreateComputeEncoder
         }
         encoder.label = "Extract Sorted Indices"
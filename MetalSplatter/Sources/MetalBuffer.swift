@@ -32,6 +32,8 @@ public class MetalBuffer<T>: @unchecked Sendable {
     }
 
     public let device: MTLDevice
+    /// When set, storage (including regrowth) is sub-allocated from this allocator's heaps
+    internal let allocator: MetalHeapAllocator?
 
     // Lock protecting all mutable state
     private var lock = os_unfair_lock()
@@ -104,24 +106,36 @@ public class MetalBuffer<T>: @unchecked Sendable {
         return try body(_buffer, _count)
     }
 
-    public init(device: MTLDevice, capacity: Int = 1) throws {
+    public convenience init(device: MTLDevice, capacity: Int = 1) throws {
+        try self.init(device: device, capacity: capacity, allocator: nil)
+    }
+
+    internal init(device: MTLDevice, capacity: Int = 1, allocator: MetalHeapAllocator?) throws {
         let capacity = max(capacity, 1)
         guard capacity <= Self.maxCapacity(for: device) else {
             throw Error.capacityGreatedThanMaxCapacity(requested: capacity, max: Self.maxCapacity(for: device))
         }
 
         self.device = device
+        self.allocator = allocator
 
         self._capacity = capacity
         self._count = 0
-        guard let buffer = device.makeBuffer(length: MemoryLayout<T>.stride * capacity,
-                                             options: .storageModeShared) else {
+        guard let buffer = Self.makeStorage(device: device, allocator: allocator, length: MemoryLayout<T>.stride * capacity) else {
             throw Error.bufferCreationFailed
         }
         self._buffer = buffer
         self._values = UnsafeMutableRawPointer(buffer.contents()).bindMemory(to: T.self, capacity: capacity)
     }
 
+    /// Shared storage, from `allocator`'s heaps when there is one
+    private static func makeStorage(device: MTLDevice, allocator: MetalHeapAllocator?, length: Int) -> MTLBuffer? {
+        if let allocator {
+            return allocator.makeBuffer(length: length)
+        }
+        return device.makeBuffer(length: length, options: .storageModeShared)
+    }
+
     public static func maxCapacity(for device: MTLDevice) -> Int {
         device.maxBufferLength / MemoryLayout<T>.stride
     }
@@ -151,10 +165,8 @@ public class MetalBuffer<T>: @unchecked Sendable {
         log.info("Allocating a new buffer of size \(MemoryLayout<T>.stride) * \(actualNewCapacity) = \(Float(MemoryLayout<T>.stride * actualNewCapacity) / (1024.0 * 1024.0))mb")
 
         // Use shared storage mode for CPU+GPU access
-        let storageMode: MTLResourceOptions = .storageModeShared
-
-        guard let newBuffer = device.makeBuffer(length: MemoryLayout<T>.stride * actualNewCapacity,
-                                                options: storageMode) else {
+        guard let newBuffer = Self.makeStorage(device: device, allocator: allocator,
+                                               length: MemoryLayout<T>.stride * actualNewCapacity) else {
             throw Error.bufferCreationFailed
         }
         let newValues = UnsafeMutableRawPointer(newBuffer.contents()).bindMemory(to: T.self, capacity: actualNewCapacity)
@@ -196,8 +208,8 @@ public class MetalBuffer<T>: @unchecked Sendable {
 
         log.info("Allocating a new buffer of size \(MemoryLayout<T>.stride) * \(actualNewCapacity) = \(Float(MemoryLayout<T>.stride * actualNewCapacity) / (1024.0 * 1024.0))mb")
 
-        guard let newBuffer = device.makeBuffer(length: MemoryLayout<T>.stride * actualNewCapacity,
-                                                options: .storageModeShared) else {
+        guard let newBuffer = Self.makeStorage(device: device, allocator: allocator,
+                                               length: MemoryLayout<T>.stride * actualNewCapacity) else {
             os_unfair_lock_unlock(&lock)
             throw Error.bufferCreationFailed
         }
@@ -239,6 +251,21 @@ public class MetalBuffer<T>: @unchecked Sendable {
         return index
     }
 
+    /// Assumes capacity is available.
+    /// Returns the index of the first values.
+    @discardableResult
+    public func append(_ elements: UnsafeBufferPointer<T>) -> Int {
+        os_unfair_lock_lock(&lock)
+        defer { os_unfair_lock_unlock(&lock) }
+
+        let index = _count
+        if let baseAddress = elements.baseAddress {
+            (_values + _count).update(from: baseAddress, count: elements.count)
+        }
+        _count += elements.count
+        return index
+    }
+
     /// Assumes capacity is available
     /// Returns the index of the value
     @discardableResult
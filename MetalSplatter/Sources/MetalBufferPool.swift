@@ -12,6 +12,10 @@ private let metalBufferPoolQueueKey = DispatchSpecificKey<Bool>()
 /**
  * A thread-safe pool of Metal buffers for efficient reuse and reduced allocation overhead.
  * Manages type-safe buffers with automatic memory pressure handling.
+ *
+ * Buffers are pooled by size class (quarter-octave steps, so rounding wastes at most 25%). An acquire takes the
+ * smallest pooled buffer within `maxReuseOvershoot` classes of the request, so acquire and release stay O(1), and
+ * buffers are sub-allocated from `MTLHeap`s when `useHeapAllocation` is set.
  */
 public class MetalBufferPool<T>: @unchecked Sendable {
     
@@ -43,19 +47,25 @@ public class MetalBufferPool<T>: @unchecked Sendable {
         public let enableMemoryPressureMonitoring: Bool
         public let enableMetal4Optimizations: Bool
         public let useResidencyTracking: Bool
+        /// Sub-allocate buffers from shared `MTLHeap`s instead of one device allocation each. Metal tracks hazards
+        /// per heap rather than per buffer, so a GPU write to any buffer orders every other use of the heap after it;
+        /// only pools whose buffers the GPU reads but doesn't write in the frame loop should opt in.
+        public let useHeapAllocation: Bool
         
         public init(maxPoolSize: Int = 10,
                    maxBufferAge: TimeInterval = 60.0,
                    memoryPressureThreshold: Float = 0.8,
                    enableMemoryPressureMonitoring: Bool = true,
                    enableMetal4Optimizations: Bool = true,
-                   useResidencyTracking: Bool = true) {
+                   useResidencyTracking: Bool = true,
+                   useHeapAllocation: Bool = false) {
             self.maxPoolSize = maxPoolSize
             self.maxBufferAge = maxBufferAge
             self.memoryPressureThreshold = memoryPressureThreshold
             self.enableMemoryPressureMonitoring = enableMemoryPressureMonitoring
             self.enableMetal4Optimizations = enableMetal4Optimizations
             self.useResidencyTracking = useResidencyTracking
+            self.useHeapAllocation = useHeapAllocation
         }
         
         
@@ -99,8 +109,11 @@ public class MetalBufferPool<T>: @unchecked Sendable {
     private let device: MTLDevice
     private let configuration: Configuration
     private let queue = DispatchQueue(label: "com.metalsplatter.buffer-pool")  // Serial queue for thread safety
-    private var availableBuffers: [PooledBuffer] = []
+    // Pooled buffers keyed by size class capacity; every buffer in a bucket holds at least that many elements
+    private var availableBuffersByClass: [Int: [PooledBuffer]] = [:]
+    private var availableBufferCount = 0
     private var leasedBuffers: Set<ObjectIdentifier> = []
+    private let heapAllocator: MetalHeapAllocator?
     
     // Metal 4.0 optimizations - use Any to avoid @available on stored properties
     private var residencySet: Any? // MTLResidencySet when available
@@ -126,6 +139,9 @@ public class MetalBufferPool<T>: @unchecked Sendable {
     public init(device: MTLDevice, configuration: Configuration = .default) {
         self.device = device
         self.configuration = configuration
+        self.heapAllocator = configuration.useHeapAllocation
+            ? MetalHeapAllocator(device: device, label: "MetalBufferPool<\(T.self)>")
+            : nil
 
         // Set queue-specific key for reentrancy detection
         queue.setSpecific(key: metalBufferPoolQueueKey, value: true)
@@ -199,7 +215,8 @@ public class MetalBufferPool<T>: @unchecked Sendable {
         }
 
         // Try to find a suitable buffer in the pool
-        if let pooledBuffer = findSuitableBuffer(minimumCapacity: minimumCapacity) {
+        let classCapacity = min(Self.sizeClass(atLeast: minimumCapacity), maxCapacity)
+        if let pooledBuffer = takePooledBuffer(sizeClass: classCapacity) {
             pooledBuffer.markUsed()
             leasedBuffers.insert(ObjectIdentifier(pooledBuffer.buffer))
 
@@ -213,7 +230,7 @@ public class MetalBufferPool<T>: @unchecked Sendable {
         }
 
         // Create a new buffer if none suitable found
-        let buffer = try MetalBuffer<T>(device: device, capacity: minimumCapacity)
+        let buffer = try MetalBuffer<T>(device: device, capacity: max(classCapacity, minimumCapacity), allocator: heapAllocator)
         leasedBuffers.insert(ObjectIdentifier(buffer))
 
         // Metal 4.0: Track residency for new buffers
@@ -251,8 +268,9 @@ public class MetalBufferPool<T>: @unchecked Sendable {
         // Add to pool if there's room and it's worth keeping
         if self.shouldPoolBuffer(buffer) {
             let pooledBuffer = PooledBuffer(buffer: buffer)
-            self.availableBuffers.append(pooledBuffer)
-            self.log.debug("Returned buffer to pool, pool size: \(self.availableBuffers.count)")
+            self.availableBuffersByClass[Self.sizeClass(atMost: buffer.capacity), default: []].append(pooledBuffer)
+            self.availableBufferCount += 1
+            self.log.debug("Returned buffer to pool, pool size: \(self.availableBufferCount)")
         } else {
             self.log.debug("Buffer not added to pool (pool full or not suitable)")
         }
@@ -263,32 +281,58 @@ public class MetalBufferPool<T>: @unchecked Sendable {
     
     // MARK: - Private Helper Methods
     
-    private func findSuitableBuffer(minimumCapacity: Int) -> PooledBuffer? {
-        // Find the smallest buffer that meets the minimum capacity requirement
-        var bestBuffer: PooledBuffer?
-        var bestCapacity = Int.max
-        var bestIndex = -1
-        
-        for (index, pooledBuffer) in availableBuffers.enumerated() {
-            let capacity = pooledBuffer.buffer.capacity
-            if capacity >= minimumCapacity && capacity < bestCapacity {
-                bestBuffer = pooledBuffer
-                bestCapacity = capacity
-                bestIndex = index
+    /// Size classes above the requested one an acquire may reuse; four quarter-octave steps, so a reused buffer is
+    /// at most about twice the request
+    static var maxReuseOvershoot: Int { 4 }
+
+    /// Most recently returned buffer of the smallest non-empty class from `sizeClass` up to `maxReuseOvershoot`
+    /// classes above it
+    private func takePooledBuffer(sizeClass: Int) -> PooledBuffer? {
+        var candidate = sizeClass
+        for _ in 0...Self.maxReuseOvershoot {
+            if let pooledBuffer = availableBuffersByClass[candidate]?.popLast() {
+                if availableBuffersByClass[candidate]?.isEmpty == true {
+                    availableBuffersByClass[candidate] = nil
+                }
+                availableBufferCount -= 1
+                return pooledBuffer
             }
+            candidate = Self.sizeClass(atLeast: candidate + 1)
         }
-        
-        if let buffer = bestBuffer, bestIndex >= 0 {
-            availableBuffers.remove(at: bestIndex)
-            return buffer
-        }
-        
         return nil
     }
+
+    /// Smallest size class holding `capacity` elements. Classes step by a quarter octave
+    /// (…, 64, 80, 96, 112, 128, 160, …), so rounding up wastes at most 25%.
+    static func sizeClass(atLeast capacity: Int) -> Int {
+        let capacity = max(capacity, 1)
+        guard capacity > 4 else { return capacity }
+        let step = 1 << (Int.bitWidth - (capacity - 1).leadingZeroBitCount - 3)
+        return (capacity + step - 1) / step * step
+    }
+
+    /// Largest size class no bigger than `capacity`, the bucket a buffer of that capacity serves
+    static func sizeClass(atMost capacity: Int) -> Int {
+        let capacity = max(capacity, 1)
+        guard capacity > 4 else { return capacity }
+        let step = 1 << (Int.bitWidth - capacity.leadingZeroBitCount - 3)
+        return capacity / step * step
+    }
+
+    private func removeAvailableBuffers(where shouldRemove: (PooledBuffer) -> Bool) {
+        for sizeClass in Array(availableBuffersByClass.keys) {
+            availableBuffersByClass[sizeClass]?.removeAll(where: shouldRemove)
+            if availableBuffersByClass[sizeClass]?.isEmpty == true {
+                availableBuffersByClass[sizeClass] = nil
+            }
+        }
+        availableBufferCount = availableBuffersByClass.values.reduce(0) { $0 + $1.count }
+        heapAllocator?.releaseEmptyHeaps()
+    }
     
     private func shouldPoolBuffer(_ buffer: MetalBuffer<T>) -> Bool {
         // Don't pool if we're at capacity
-        guard availableBuffers.count < configuration.maxPoolSize else {
+        guard availableBufferCount < configuration.maxPoolSize else {
             return false
         }
         
@@ -303,7 +347,7 @@ public class MetalBufferPool<T>: @unchecked Sendable {
     }
     
     private func trimExpiredBuffers() {
-        availableBuffers.removeAll { pooledBuffer in
+        removeAvailableBuffers { pooledBuffer in
             let expired = pooledBuffer.age > configuration.maxBufferAge
             if expired {
                 log.debug("Removed expired buffer from pool")
@@ -360,20 +404,21 @@ public class MetalBufferPool<T>: @unchecked Sendable {
         queue.async(flags: .barrier) { [weak self] in
             guard let self = self else { return }
             
-            let originalSize = self.availableBuffers.count
+            let originalSize = self.availableBufferCount
             
             // Remove least recently used buffers, keeping only the most recent ones
-            self.availableBuffers.sort { lhs, rhs in
+            let byRecency = self.availableBuffersByClass.values.joined().sorted { lhs, rhs in
                 lhs.lastUsedTime > rhs.lastUsedTime
             }
             
             // Keep only the top 25% of buffers during memory pressure
             let targetSize = max(1, self.configuration.maxPoolSize / 4)
-            if self.availableBuffers.count > targetSize {
-                self.availableBuffers.removeSubrange(targetSize...)
+            if byRecency.count > targetSize {
+                let evicted = Set(byRecency[targetSize...].map(ObjectIdentifier.init))
+                self.removeAvailableBuffers { evicted.contains(ObjectIdentifier($0)) }
             }
             
-            let trimmedCount = originalSize - self.availableBuffers.count
+            let trimmedCount = originalSize - self.availableBufferCount
             if trimmedCount > 0 {
                 self.log.info("Trimmed \(trimmedCount) buffers due to memory pressure")
             }
@@ -385,8 +430,8 @@ public class MetalBufferPool<T>: @unchecked Sendable {
         queue.async(flags: .barrier) { [weak self] in
             guard let self = self else { return }
             
-            let clearedCount = self.availableBuffers.count
-            self.availableBuffers.removeAll()
+            let clearedCount = self.availableBufferCount
+            self.removeAvailableBuffers { _ in true }
             
             if clearedCount > 0 {
                 self.log.info("Cleared all \(clearedCount) buffers from pool")
@@ -401,12 +446,17 @@ public class MetalBufferPool<T>: @unchecked Sendable {
         public let leasedBuffers: Int
         public let totalMemoryMB: Float
         public let averageBufferAge: TimeInterval
+        /// Memory reserved by the pool's heaps (`MTLHeap.currentAllocatedSize`), pooled and leased buffers alike;
+        /// zero without heap allocation
+        public let heapAllocatedMB: Float
         
-        public init(availableBuffers: Int, leasedBuffers: Int, totalMemoryMB: Float, averageBufferAge: TimeInterval) {
+        public init(availableBuffers: Int, leasedBuffers: Int, totalMemoryMB: Float, averageBufferAge: TimeInterval,
+                    heapAllocatedMB: Float = 0) {
             self.availableBuffers = availableBuffers
             self.leasedBuffers = leasedBuffers
             self.totalMemoryMB = totalMemoryMB
             self.averageBufferAge = averageBufferAge
+            self.heapAllocatedMB = heapAllocatedMB
         }
     }
     
@@ -421,19 +471,26 @@ public class MetalBufferPool<T>: @unchecked Sendable {
         }
     }
 
+    /// Bytes reserved by the pool's heaps; zero without heap allocation
+    internal var heapAllocatedSize: Int {
+        heapAllocator?.currentAllocatedSize ?? 0
+    }
+
     private func getStatisticsImpl() -> PoolStatistics {
+        let availableBuffers = availableBuffersByClass.values.joined()
         let totalMemory = availableBuffers.reduce(0) { total, pooledBuffer in
             total + pooledBuffer.buffer.capacity * MemoryLayout<T>.stride
         }
 
-        let averageAge = availableBuffers.isEmpty ? 0 :
-            availableBuffers.reduce(0) { $0 + $1.age } / Double(availableBuffers.count)
+        let averageAge = availableBufferCount == 0 ? 0 :
+            availableBuffers.reduce(0) { $0 + $1.age } / Double(availableBufferCount)
 
         return PoolStatistics(
-            availableBuffers: availableBuffers.count,
+            availableBuffers: availableBufferCount,
             leasedBuffers: leasedBuffers.count,
             totalMemoryMB: Float(totalMemory) / (1024 * 1024),
-            averageBufferAge: averageAge
+            averageBufferAge: averageAge,
+            heapAllocatedMB: Float(heapAllocator?.currentAllocatedSize ?? 0) / (1024 * 1024)
         )
     }
     
@@ -0,0 +1,167 @@
+import Foundation
+import Metal
+import os
+
+/// Sub-allocates buffers from a small set of `MTLHeap`s instead of giving every buffer its own allocation.
+///
+/// Heaps grow geometrically, from `minimumHeapSize` up to `maximumHeapSize` per heap; a request larger than that
+/// gets a heap of its own. A buffer's memory goes back to its heap when the buffer is deallocated, and heaps left
+/// empty are dropped by `releaseEmptyHeaps()`. When the device can't make heaps of the requested storage mode the
+/// allocator hands out ordinary device buffers.
+///
+/// Heaps are hazard-tracked, and Metal tracks a heap as one resource: a GPU write to any of its buffers orders every
+/// other command using the heap after it. Allocate from one only buffers the GPU reads, or writes outside the frame
+/// loop; double-buffered GPU outputs, such as sort results drawn while the next sort runs, need standalone buffers.
+internal final class MetalHeapAllocator: @unchecked Sendable {
+    private static let log = Logger(subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
+                                    category: "MetalHeapAllocator")
+
+    static let minimumHeapSize = 1 << 20
+    static let maximumHeapSize = 64 << 20
+
+    let device: MTLDevice
+    let label: String
+    let storageMode: MTLStorageMode
+    private let options: MTLResourceOptions
+    private let lock = NSLock()
+    private var heaps: [MTLHeap] = []
+    private var heapsUnavailable = false
+
+    /// `storageMode` is `.shared` or `.private`
+    init(device: MTLDevice, label: String, storageMode: MTLStorageMode = .shared) {
+        self.device = device
+        self.label = label
+        self.storageMode = storageMode
+        switch storageMode {
+        case .private: options = .storageModePrivate
+        default: options = .storageModeShared
+        }
+    }
+
+    /// Bytes reserved by this allocator's heaps, used or not
+    var currentAllocatedSize: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return heaps.reduce(0) { $0 + $1.currentAllocatedSize }
+    }
+
+    /// Bytes of live buffers inside the heaps
+    var usedSize: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return heaps.reduce(0) { $0 + $1.usedSize }
+    }
+
+    func makeBuffer(length: Int) -> MTLBuffer? {
+        let length = max(length, 1)
+        lock.lock()
+        defer { lock.unlock() }
+        guard !heapsUnavailable else {
+            return device.makeBuffer(length: length, options: options)
+        }
+
+        let sizeAndAlign = device.heapBufferSizeAndAlign(length: length, options: options)
+        for heap in heaps.reversed() where heap.maxAvailableSize(alignment: sizeAndAlign.align) >= sizeAndAlign.size {
+            if let buffer = heap.makeBuffer(length: length, options: options) {
+                return buffer
+            }
+        }
+
+        // Each new heap is as large as all existing ones together, within the per-heap bounds
+        let reserved = heaps.reduce(0) { $0 + $1.size }
+        let heapSize = max(sizeAndAlign.size, min(Self.maximumHeapSize, max(Self.minimumHeapSize, reserved)))
+        let descriptor = MTLHeapDescriptor()
+        descriptor.size = (heapSize + sizeAndAlign.align - 1) / sizeAndAlign.align * sizeAndAlign.align
+        descriptor.storageMode = storageMode == .private ? .private : .shared
+        descriptor.hazardTrackingMode = .tracked
+        guard let heap = device.makeHeap(descriptor: descriptor) else {
+            heapsUnavailable = true
+            Self.log.info("\(self.label, privacy: .public): heaps unavailable; allocating standalone buffers")
+            return device.makeBuffer(length: length, options: options)
+        }
+        heap.label = "\(label) Heap \(heaps.count)"
+        heaps.append(heap)
+        return heap.makeBuffer(length: length, options: options)
+    }
+
+    /// Drops heaps with no live buffers so their memory returns to the system
+    func releaseEmptyHeaps() {
+        lock.lock()
+        defer { lock.unlock() }
+        let before = heaps.count
+        heaps.removeAll { $0.usedSize == 0 }
+        if heaps.count != before {
+            Self.log.debug("\(self.label, privacy: .public): released \(before - self.heaps.count) empty heap(s)")
+        }
+    }
+}
+
+/// One private heap that GPU passes carve short-lived scratch buffers from and hand back with `makeAliasable()`.
+///
+/// Scratch made aliasable after its commands are encoded shares memory with the next pass's scratch, so sorters
+/// that use the same arena reserve what their largest pass needs rather than each keeping its own buffers. The
+/// heap is hazard-tracked, which orders the aliased uses on the GPU; that ordering is what aliasing requires, and
+/// only sort and selection scratch lives here, so draws never wait on it. All users should encode to one command
+/// queue. The heap is replaced with a larger one when a pass outgrows it, settling at the high-water mark.
+internal final class MetalScratchHeap: @unchecked Sendable {
+    private static let log = Logger(subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
+                                    category: "MetalScratchHeap")
+
+    let device: MTLDevice
+    private let lock = NSLock()
+    private var heap: MTLHeap?
+
+    init(device: MTLDevice) {
+        self.device = device
+    }
+
+    /// Bytes the arena holds
+    var currentAllocatedSize: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return heap?.currentAllocatedSize ?? 0
+    }
+
+    func makeBuffer(length: Int, label: String) -> MTLBuffer? {
+        let length = max(length, 1)
+        lock.lock()
+        defer { lock.unlock() }
+        let sizeAndAlign = device.heapBufferSizeAndAlign(length: length, options: .storageModePrivate)
+        if let heap, heap.maxAvailableSize(alignment: sizeAndAlign.align) >= sizeAndAlign.size,
+           let buffer = heap.makeBuffer(length: length, options: .storageModePrivate) {
+            buffer.label = label
+            return buffer
+        }
+
+        // Buffers already carved from the old heap keep it alive until the GPU is done with them
+        let heapSize = max((heap?.size ?? 0) * 2, sizeAndAlign.size, MetalHeapAllocator.minimumHeapSize)
+        let descriptor = MTLHeapDescriptor()
+        descriptor.size = (heapSize + sizeAndAlign.align - 1) / sizeAndAlign.align * sizeAndAlign.align
+        descriptor.storageMode = .private
+        descriptor.hazardTrackingMode = .tracked
+        guard let newHeap = device.makeHeap(descriptor: descriptor) else {
+            Self.log.warning("Failed to create a \(descriptor.size)-byte scratch heap")
+            return nil
+        }
+        newHeap.label = "Sort Scratch Heap"
+        heap = newHeap
+        Self.log.debug("Scratch heap grown to \(descriptor.size) bytes")
+        let buffer = newHeap.makeBuffer(length: length, options: .storageModePrivate)
+        buffer?.label = label
+        return buffer
+    }
+
+    /// Call once every command using `buffers` has been encoded; they must not be encoded again afterwards
+    func recycle(_ buffers: [MTLBuffer]) {
+        for buffer in buffers where buffer.heap != nil {
+            buffer.makeAliasable()
+        }
+    }
+
+    /// Frees the arena; the next `makeBuffer` starts a new one
+    func releaseMemory() {
+        lock.lock()
+        heap = nil
+        lock.unlock()
+    }
+}
@@ -0,0 +1,155 @@
+import Foundation
+import Metal
+import simd
+import os
+import SplatIO
+
+/// A scene kept on the GPU in ChunkedSplatFormat: 16-byte `PackedSplat`s and a 64-byte `GPUChunkHeader` per
+/// 256 splats, about 16.25 bytes per splat against 28 for `Splat`
+///
+/// Nothing is expanded to `Splat`s. The packed vertex shader (PackedSplatRenderPath.metal) and the packed
+/// counting-sort histogram kernels (CountingSort.metal) decode each splat from its chunk's bounds as they
+/// read it. The order is re-sorted in the frame's command buffer, ahead of the draw that reads it, whenever
+/// the sort camera moves past the renderer's sort epsilons.
+internal final class PackedSplatStore {
+
+    private static let log = Logger(subsystem: Bundle.main.bundleIdentifier ?? "MetalSplatter",
+                                    category: "PackedSplatStore")
+
+    let splatCount: Int
+    let packedSplatBuffer: MTLBuffer
+    let chunkHeaderBuffer: MTLBuffer
+    /// Back-to-front draw order (Int32 splat indices)
+    let sortedIndexBuffer: MTLBuffer
+    /// Union of the chunk position bounds
+    let bounds: (min: SIMD3<Float>, max: SIMD3<Float>)
+
+    /// Built on first draw; cleared with the renderer's other pipeline states
+    var pipelineState: MTLRenderPipelineState?
+    var depthState: MTLDepthStencilState?
+
+    private let sorter: CountingSorter
+    private var lastSortCamera: (position: SIMD3<Float>, forward: SIMD3<Float>, sortByDistance: Bool)?
+
+    /// Bytes of splat data resident on the GPU: the packed splats and their chunk headers
+    var storageByteCount: Int {
+        packedSplatBuffer.length + chunkHeaderBuffer.length
+    }
+
+    /// - Throws: `SplatRendererError.invalidPackedSplatChunk` if a chunk other than the last holds fewer than
+    ///   `SplatCompression.chunkSize` splats, since the shaders locate a splat's header from its index
+    init(device: MTLDevice, library: MTLLibrary, chunks: [SplatChunk]) throws {
+        guard !chunks.isEmpty else {
+            throw SplatRendererError.invalidPackedSplatChunk(index: 0)
+        }
+        let chunkSize = SplatCompression.chunkSize
+        for (index, chunk) in chunks.enumerated() {
+            let isLast = index == chunks.count - 1
+            guard chunk.splats.count == Int(chunk.header.splatCount),
+                  isLast ? (1...chunkSize).contains(chunk.splats.count) : chunk.splats.count == chunkSize else {
+                throw SplatRendererError.invalidPackedSplatChunk(index: index)
+            }
+        }
+
+        let splatCount = chunks.reduce(0) { $0 + $1.splats.count }
+        self.splatCount = splatCount
+
+        let packedLength = splatCount * MemoryLayout<PackedSplat>.stride
+        guard let packedSplatBuffer = device.makeBuffer(length: packedLength, options: .storageModeShared) else {
+            throw SplatRendererError.failedToCreateBuffer(length: packedLength)
+        }
+        packedSplatBuffer.label = "Packed Splats"
+        var destination = packedSplatBuffer.contents().bindMemory(to: PackedSplat.self, capacity: splatCount)
+        for chunk in chunks {
+            chunk.splats.withUnsafeBufferPointer { source in
+                destination.update(from: source.baseAddress!, count: source.count)
+            }
+            destination += chunk.splats.count
+        }
+        self.packedSplatBuffer = packedSplatBuffer
+
+        let headers = chunks.map { GPUChunkHeader(from: $0.header) }
+        let headerLength = headers.count * MemoryLayout<GPUChunkHeader>.stride
+        guard let chunkHeaderBuffer = headers.withUnsafeBytes({ raw in
+            device.makeBuffer(bytes: raw.baseAddress!, length: headerLength, options: .storageModeShared)
+        }) else {
+            throw SplatRendererError.failedToCreateBuffer(length: headerLength)
+        }
+        chunkHeaderBuffer.label = "Packed Splat Chunk Headers"
+        self.chunkHeaderBuffer = chunkHeaderBuffer
+
+        let indexLength = splatCount * MemoryLayout<Int32>.stride
+        guard let sortedIndexBuffer = device.makeBuffer(length: indexLength, options: .storageModeShared) else {
+            throw SplatRendererError.failedToCreateBuffer(length: indexLength)
+        }
+        sortedIndexBuffer.label = "Packed Splat Sorted Indices"
+        self.sortedIndexBuffer = sortedIndexBuffer
+
+        bounds = chunks.dropFirst().reduce((min: chunks[0].header.minPosition, max: chunks[0].header.maxPosition)) {
+            (min: simd_min($0.min, $1.header.minPosition), max: simd_max($0.max, $1.header.maxPosition))
+        }
+        sorter = try CountingSorter(device: device, library: library)
+
+        Self.log.info("Packed \(splatCount) splats into \(chunks.count) chunks (\(packedLength + headerLength) bytes)")
+    }
+
+    /// Encodes a counting sort of the packed splats into `commandBuffer`, unless the last sort was made from
+    /// (nearly) the same camera
+    func encodeSortIfNeeded(commandBuffer: MTLCommandBuffer,
+                            cameraPosition: SIMD3<Float>,
+                            cameraForward: SIMD3<Float>,
+                            sortByDistance: Bool,
+                            positionEpsilon: Float,
+                            directionEpsilon: Float,
+                            useCameraRelativeBinning: Bool) throws {
+        if let lastSortCamera,
+           lastSortCamera.sortByDistance == sortByDistance,
+           simd_distance_squared(lastSortCamera.position, cameraPosition) <= positionEpsilon * positionEpsilon,
+           1 - simd_dot(lastSortCamera.forward, cameraForward) <= directionEpsilon {
+            return
+        }
+
+        let depthBounds = SplatRenderer.estimateCountingSortDepthBounds(from: bounds,
+                                                                        cameraPosition: cameraPosition,
+                                                                        cameraForward: cameraForward,
+                                                                        sortByDistance: sortByDistance)
+        try sorter.sort(commandBuffer: commandBuffer,
+                        splatBuffer: packedSplatBuffer,
+                        editStateBuffer: nil,
+                        outputBuffer: sortedIndexBuffer,
+                        cameraPosition: cameraPosition,
+                        cameraForward: cameraForward,
+                        sortByDistance: sortByDistance,
+                        splatCount: splatCount,
+                        depthBounds: depthBounds,
+                        useCameraRelativeBinning: useCameraRelativeBinning,
+                        chunkHeaderBuffer: chunkHeaderBuffer)
+        lastSortCamera = (cameraPosition, cameraForward, sortByDistance)
+    }
+
+    // MARK: - Packing
+
+    /// Quantizes points into chunks holding the renderer's linear color and opacity, as `Splat.init(_:)` does.
+    /// Chunk bounds are only tight for spatially coherent runs of points, so callers should Morton-order first.
+    static func chunks(for points: [SplatScenePoint]) -> [SplatChunk] {
+        SplatChunkCompressor.compress(positions: points.map(\.position),
+                                      rotations: points.map { $0.rotation.normalized },
+                                      scales: points.map { $0.scale.asLinearFloat },
+                                      colors: points.map { SIMD4($0.color.asLinearFloat.sRGBToLinear, $0.opacity.asLinearFloat) })
+    }
+
+    /// CPU mirror of `decodePackedSplat` in PackedSplat.h
+    static func decode(_ packed: PackedSplat, header: GPUChunkHeader) -> SplatRenderer.Splat {
+        var splat = SplatRenderer.Splat(position: SplatCompression.unpackPosition(packed.positionPacked,
+                                                                                  min: header.minPosition,
+                                                                                  max: header.maxPosition),
+                                        color: .zero,
+                                        scale: SplatCompression.unpackScale(packed.scalePacked,
+                                                                            min: header.minScale,
+                                                                            max: header.maxScale),
+                                        rotation: SplatCompression.unpackRotation(packed.rotationPacked).normalized)
+        // Only the byte order differs from Splat's, so the stored bytes are kept exactly
+        splat.packedColor = packed.colorPacked.byteSwapped
+        return splat
+    }
+}
@@ -0,0 +1,112 @@
+import Foundation
+
+/// An array stored as fixed-size pages, each its own copy-on-write buffer.
+///
+/// Copying a `PagedArray` copies one reference per page, and a write duplicates only the page it lands in, so a
+/// copy kept for undo shares every page later edits don't touch. Every page but the last is full.
+struct PagedArray<Element>: RandomAccessCollection, MutableCollection, RangeReplaceableCollection {
+    static var pageShift: Int { 12 }
+    static var pageSize: Int { 1 << pageShift }
+
+    private var pages: [[Element]] = []
+    private var elementCount = 0
+
+    init() {}
+
+    var startIndex: Int { 0 }
+    var endIndex: Int { elementCount }
+    var count: Int { elementCount }
+    var pageCount: Int { pages.count }
+
+    subscript(position: Int) -> Element {
+        get {
+            precondition(position >= 0 && position < elementCount, "PagedArray index out of range")
+            return pages[position >> Self.pageShift][position & (Self.pageSize - 1)]
+        }
+        set {
+            precondition(position >= 0 && position < elementCount, "PagedArray index out of range")
+            pages[position >> Self.pageShift][position & (Self.pageSize - 1)] = newValue
+        }
+    }
+
+    mutating func append(_ newElement: Element) {
+        if pages.isEmpty || pages[pages.count - 1].count == Self.pageSize {
+            var page: [Element] = []
+            page.reserveCapacity(Self.pageSize)
+            pages.append(page)
+        }
+        pages[pages.count - 1].append(newElement)
+        elementCount += 1
+    }
+
+    mutating func append<S: Sequence>(contentsOf newElements: S) where S.Element == Element {
+        var iterator = newElements.makeIterator()
+        while true {
+            if pages.isEmpty || pages[pages.count - 1].count == Self.pageSize {
+                guard let first = iterator.next() else { return }
+                var page: [Element] = [first]
+                page.reserveCapacity(Self.pageSize)
+                pages.append(page)
+                elementCount += 1
+            }
+            let last = pages.count - 1
+            while pages[last].count < Self.pageSize {
+                guard let element = iterator.next() else { return }
+                pages[last].append(element)
+                elementCount += 1
+            }
+        }
+    }
+
+    /// Rewrites the pages from the one holding `subrange.lowerBound` onwards; earlier pages stay shared
+    mutating func replaceSubrange<C: Collection>(_ subrange: Range<Int>, with newElements: C) where C.Element == Element {
+        precondition(subrange.lowerBound >= 0 && subrange.upperBound <= elementCount, "PagedArray range out of bounds")
+        let firstPage = subrange.lowerBound >> Self.pageShift
+        guard firstPage < pages.count else {
+            append(contentsOf: newElements)
+            return
+        }
+        let base = firstPage << Self.pageShift
+        var tail = Array(pages[firstPage...].joined())
+        tail.replaceSubrange((subrange.lowerBound - base)..<(subrange.upperBound - base), with: newElements)
+        pages.removeSubrange(firstPage...)
+        elementCount = base
+        append(contentsOf: tail)
+    }
+
+    mutating func removeAll(keepingCapacity keepCapacity: Bool = false) {
+        pages.removeAll(keepingCapacity: keepCapacity)
+        elementCount = 0
+    }
+
+    /// Pages whose storage is not shared with the page at the same position in `other`
+    func pagesNotShared(with other: PagedArray) -> Int {
+        var unshared = 0
+        for (index, page) in pages.enumerated() {
+            guard index < other.pages.count else {
+                unshared += pages.count - index
+                break
+            }
+            let lhs = page.withUnsafeBufferPointer { $0.baseAddress }
+            let rhs = other.pages[index].withUnsafeBufferPointer { $0.baseAddress }
+            if lhs == nil || lhs != rhs {
+                unshared += 1
+            }
+        }
+        return unshared
+    }
+}
+
+extension PagedArray: ExpressibleByArrayLiteral {
+    init(arrayLiteral elements: Element...) {
+        self.init(elements)
+    }
+}
+
+extension PagedArray: Equatable where Element: Equatable {
+    static func == (lhs: PagedArray, rhs: PagedArray) -> Bool {
+        lhs.count == rhs.count && lhs.elementsEqual(rhs)
+    }
+}
+
+extension PagedArray: Sendable where Element: Sendable {}
@@ -0,0 +1,306 @@
+import Foundation
+import Metal
+import os
+
+/// Render pipeline compilation backed by an `MTLBinaryArchive` that persists across launches.
+///
+/// Each pipeline is first looked up in the archive (`failOnBinaryArchiveMiss`), so one compiled on an earlier launch
+/// loads from its stored GPU binary. Misses are compiled normally, added to the archive, and the archive is written
+/// back to the caches directory shortly after the last addition. One cache is shared by all renderers on a device.
+///
+/// An archive stops taking additions before another one would take it past `maximumArchiveSize`; a full archive keeps
+/// serving the pipelines it holds. Archives left by other app or OS builds are removed, oldest first, while the
+/// directory is over `maximumDirectorySize`.
+internal final class PipelineCache: @unchecked Sendable {
+    private static let log = Logger(subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
+                                    category: "PipelineCache")
+
+    /// Delay between the last archive addition and writing the archive, so a burst of compiles saves once
+    private static let saveDelay: TimeInterval = 2
+    static let defaultMaximumArchiveSize = 32 * 1024 * 1024
+    static let defaultMaximumDirectorySize = 96 * 1024 * 1024
+
+    private static let sharedLock = NSLock()
+    nonisolated(unsafe) private static var sharedCaches: [UInt64: PipelineCache] = [:]
+
+    static func shared(for device: MTLDevice) -> PipelineCache {
+        sharedLock.lock()
+        defer { sharedLock.unlock() }
+        if let cache = sharedCaches[device.registryID] {
+            return cache
+        }
+        let cache = PipelineCache(device: device, directory: defaultDirectory)
+        sharedCaches[device.registryID] = cache
+        return cache
+    }
+
+    /// `Caches/MetalSplatter/PipelineArchives`
+    static var defaultDirectory: URL? {
+        FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first?
+            .appendingPathComponent("MetalSplatter", isDirectory: true)
+            .appendingPathComponent("PipelineArchives", isDirectory: true)
+    }
+
+    let device: MTLDevice
+    /// Bytes of serialized archive that additions may not take it past; archived pipelines still load once full
+    let maximumArchiveSize: Int
+    /// Bytes all archives in the directory may take; stale archives beyond it are deleted at launch
+    let maximumDirectorySize: Int
+    /// Nil when the archive couldn't be created; compilation then goes straight to the device
+    private let archive: MTLBinaryArchive?
+    private let archiveURL: URL?
+    /// Archive additions and serialization, off the render and Metal completion threads
+    private let archiveQueue = DispatchQueue(label: "MetalSplatter.PipelineCache", qos: .utility)
+    private var unsavedAdditions = 0
+    private var saveScheduled = false
+    /// Bytes of the archive as last loaded or saved
+    private var savedSize = 0
+    /// Largest growth per pipeline seen across saves, used to project the size of pending additions
+    private var bytesPerAddition = 0
+    /// Set once further additions would take the archive past `maximumArchiveSize`; it then only serves lookups
+    private var isFull = false
+
+    init(device: MTLDevice,
+         directory: URL?,
+         maximumArchiveSize: Int = PipelineCache.defaultMaximumArchiveSize,
+         maximumDirectorySize: Int = PipelineCache.defaultMaximumDirectorySize) {
+        self.device = device
+        self.maximumArchiveSize = maximumArchiveSize
+        self.maximumDirectorySize = maximumDirectorySize
+        guard let directory else {
+            archive = nil
+            archiveURL = nil
+            return
+        }
+
+        // GPU binaries are specific to the device, OS build and shader source; a new app build starts a new archive
+        let appVersion = Bundle.main.object(forInfoDictionaryKey: "CFBundleVersion") as? String ?? "0"
+        let osVersion = ProcessInfo.processInfo.operatingSystemVersion
+        let name = "\(device.name)-\(osVersion.majorVersion).\(osVersion.minorVersion).\(osVersion.patchVersion)-\(appVersion)"
+            .map { $0.isLetter || $0.isNumber || $0 == "." || $0 == "-" ? $0 : "_" }
+        let url = directory.appendingPathComponent(String(name)).appendingPathExtension("metallib")
+        archiveURL = url
+        Self.removeStaleArchives(in: directory, keeping: url, maximumDirectorySize: maximumDirectorySize)
+
+        let descriptor = MTLBinaryArchiveDescriptor()
+        if FileManager.default.fileExists(atPath: url.path) {
+            descriptor.url = url
+            if let archive = try? device.makeBinaryArchive(descriptor: descriptor) {
+                self.archive = archive
+                let size = Self.fileSize(at: url) ?? 0
+                savedSize = size
+                if size >= maximumArchiveSize {
+                    // Full already (possibly under an earlier, larger setting): keep serving it rather than
+                    // discarding it, which would recompile and refill it on every launch
+                    isFull = true
+                    Self.log.info("Pipeline archive of \(size) bytes is full; loading it read-only")
+                }
+                return
+            }
+            // Unreadable (truncated write, incompatible build): start over
+            Self.log.warning("Discarding unreadable pipeline archive at \(url.path, privacy: .public)")
+            try? FileManager.default.removeItem(at: url)
+            descriptor.url = nil
+        }
+        archive = try? device.makeBinaryArchive(descriptor: descriptor)
+    }
+
+    // MARK: - Compilation
+
+    func renderPipelineState(descriptor: MTLRenderPipelineDescriptor) throws -> MTLRenderPipelineState {
+        attachArchive(to: descriptor)
+        return try compile(attempt: { try self.device.makeRenderPipelineState(descriptor: descriptor, options: $0, reflection: nil) },
+                           add: { try $0.addRenderPipelineFunctions(descriptor: descriptor) })
+    }
+
+    func renderPipelineState(tileDescriptor descriptor: MTLTileRenderPipelineDescriptor) throws -> MTLRenderPipelineState {
+        if let archive {
+            descriptor.binaryArchives = [archive]
+        }
+        return try compile(attempt: { try self.device.makeRenderPipelineState(tileDescriptor: descriptor, options: $0, reflection: nil) },
+                           add: { try $0.addTileRenderPipelineFunctions(descriptor: descriptor) })
+    }
+
+    func renderPipelineState(meshDescriptor descriptor: MTLMeshRenderPipelineDescriptor) throws -> MTLRenderPipelineState {
+        attachArchive(to: descriptor)
+        return try compile(attempt: { try self.device.makeRenderPipelineState(descriptor: descriptor, options: $0).0 },
+                           add: { try Self.addMeshRenderPipelineFunctions($0, descriptor) })
+    }
+
+    /// Compiles on Metal's background threads; `completion` runs on one of them
+    func renderPipelineState(descriptor: MTLRenderPipelineDescriptor,
+                             completion: @escaping @Sendable (Result<MTLRenderPipelineState, Error>) -> Void) {
+        attachArchive(to: descriptor)
+        nonisolated(unsafe) let descriptor = descriptor
+        compile(attempt: { options, handler in
+                    self.device.makeRenderPipelineState(descriptor: descriptor, options: options) { handler($0, $2) }
+                },
+                add: { try $0.addRenderPipelineFunctions(descriptor: descriptor) },
+                completion: completion)
+    }
+
+    func renderPipelineState(tileDescriptor descriptor: MTLTileRenderPipelineDescriptor,
+                             completion: @escaping @Sendable (Result<MTLRenderPipelineState, Error>) -> Void) {
+        if let archive {
+            descriptor.binaryArchives = [archive]
+        }
+        nonisolated(unsafe) let descriptor = descriptor
+        compile(attempt: { options, handler in
+                    self.device.makeRenderPipelineState(tileDescriptor: descriptor, options: options) { handler($0, $2) }
+                },
+                add: { try $0.addTileRenderPipelineFunctions(descriptor: descriptor) },
+                completion: completion)
+    }
+
+    func renderPipelineState(meshDescriptor descriptor: MTLMeshRenderPipelineDescriptor,
+                             completion: @escaping @Sendable (Result<MTLRenderPipelineState, Error>) -> Void) {
+        attachArchive(to: descriptor)
+        nonisolated(unsafe) let descriptor = descriptor
+        compile(attempt: { options, handler in
+                    self.device.makeRenderPipelineState(descriptor: descriptor, options: options) { handler($0, $2) }
+                },
+                add: { try Self.addMeshRenderPipelineFunctions($0, descriptor) },
+                completion: completion)
+    }
+
+    /// Writes pending additions now instead of after `saveDelay`
+    func save() {
+        archiveQueue.sync { saveIfNeeded() }
+    }
+
+    // MARK: - Private
+
+    private typealias Compilation = (MTLRenderPipelineState?, Error?) -> Void
+
+    /// Loads from the archive when it has the pipeline; otherwise compiles and adds it
+    private func compile(attempt: (MTLPipelineOption) throws -> MTLRenderPipelineState,
+                         add: @escaping (MTLBinaryArchive) throws -> Void) throws -> MTLRenderPipelineState {
+        if archive != nil, let pipelineState = try? attempt(.failOnBinaryArchiveMiss) {
+            return pipelineState
+        }
+        let pipelineState = try attempt([])
+        addToArchive(add)
+        return pipelineState
+    }
+
+    private func compile(attempt: @escaping (MTLPipelineOption, @escaping Compilation) -> Void,
+                         add: @escaping (MTLBinaryArchive) throws -> Void,
+                         completion: @escaping @Sendable (Result<MTLRenderPipelineState, Error>) -> Void) {
+        nonisolated(unsafe) let attempt = attempt
+        nonisolated(unsafe) let add = add
+        let compileMissing = { [weak self] in
+            attempt([]) { pipelineState, error in
+                if let pipelineState {
+                    self?.addToArchive(add)
+                    completion(.success(pipelineState))
+                } else {
+                    completion(.failure(error ?? SplatRendererError.failedToCreateRenderPipelineState(label: "",
+                                                                                                      underlying: CancellationError())))
+                }
+            }
+        }
+        guard archive != nil else {
+            compileMissing()
+            return
+        }
+        attempt(.failOnBinaryArchiveMiss) { pipelineState, _ in
+            if let pipelineState {
+                completion(.success(pipelineState))
+            } else {
+                compileMissing()
+            }
+        }
+    }
+
+    private func attachArchive(to descriptor: MTLRenderPipelineDescriptor) {
+        if let archive {
+            descriptor.binaryArchives = [archive]
+        }
+    }
+
+    private func attachArchive(to descriptor: MTLMeshRenderPipelineDescriptor) {
+        if let archive {
+            descriptor.binaryArchives = [archive]
+        }
+    }
+
+    /// Mesh pipelines can only be archived on newer OS versions; on older ones they always compile
+    private static func addMeshRenderPipelineFunctions(_ archive: MTLBinaryArchive,
+                                                       _ descriptor: MTLMeshRenderPipelineDescriptor) throws {
+        if #available(iOS 18.0, macOS 15.0, visionOS 2.0, *) {
+            try archive.addMeshRenderPipelineFunctions(descriptor: descriptor)
+        }
+    }
+
+    private func addToArchive(_ add: @escaping (MTLBinaryArchive) throws -> Void) {
+        guard let archive else { return }
+        nonisolated(unsafe) let add = add
+        archiveQueue.async { [self] in
+            // Skip the addition when it's projected to take the next save past the limit
+            guard !isFull, savedSize + (unsavedAdditions + 1) * bytesPerAddition <= maximumArchiveSize else { return }
+            do {
+                try add(archive)
+                unsavedAdditions += 1
+                scheduleSave()
+            } catch {
+                Self.log.debug("Pipeline not added to archive: \(error.localizedDescription, privacy: .public)")
+            }
+        }
+    }
+
+    private func scheduleSave() {
+        guard !saveScheduled else { return }
+        saveScheduled = true
+        archiveQueue.asyncAfter(deadline: .now() + Self.saveDelay) { [weak self] in
+            self?.saveScheduled = false
+            self?.saveIfNeeded()
+        }
+    }
+
+    private func saveIfNeeded() {
+        guard unsavedAdditions > 0, let archive, let archiveURL else { return }
+        do {
+            try FileManager.default.createDirectory(at: archiveURL.deletingLastPathComponent(),
+                                                    withIntermediateDirectories: true)
+            try archive.serialize(to: archiveURL)
+            Self.log.debug("Saved \(self.unsavedAdditions) pipeline(s) to \(archiveURL.lastPathComponent, privacy: .public)")
+            let size = Self.fileSize(at: archiveURL) ?? savedSize
+            bytesPerAddition = max(bytesPerAddition, (size - savedSize) / unsavedAdditions)
+            savedSize = size
+            unsavedAdditions = 0
+            if size + bytesPerAddition > maximumArchiveSize {
+                isFull = true
+                Self.log.info("Pipeline archive reached \(size) bytes; no further pipelines are added")
+            }
+        } catch {
+            Self.log.warning("Failed to save pipeline archive: \(error.localizedDescription, privacy: .public)")
+        }
+    }
+
+    private static func fileSize(at url: URL) -> Int? {
+        (try? url.resourceValues(forKeys: [.fileSizeKey]))?.fileSize
+    }
+
+    /// Deletes archives other than `current`, least recently modified first, until the directory fits
+    private static func removeStaleArchives(in directory: URL, keeping current: URL, maximumDirectorySize: Int) {
+        let keys: Set<URLResourceKey> = [.fileSizeKey, .contentModificationDateKey]
+        guard let urls = try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: Array(keys)) else {
+            return
+        }
+        var archives = urls.filter { $0.pathExtension == "metallib" }.map { url in
+            let values = try? url.resourceValues(forKeys: keys)
+            return (url: url, size: values?.fileSize ?? 0, modified: values?.contentModificationDate ?? .distantPast)
+        }
+        var totalSize = archives.reduce(0) { $0 + $1.size }
+        archives.sort { $0.modified < $1.modified }
+        for archive in archives where totalSize > maximumDirectorySize && archive.url.lastPathComponent != current.lastPathComponent {
+            do {
+                try FileManager.default.removeItem(at: archive.url)
+                totalSize -= archive.size
+                log.debug("Removed stale pipeline archive \(archive.url.lastPathComponent, privacy: .public)")
+            } catch {
+                log.warning("Failed to remove stale pipeline archive: \(error.localizedDescription, privacy: .public)")
+            }
+        }
+    }
+}
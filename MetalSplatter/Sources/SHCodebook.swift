@@ -0,0 +1,183 @@
+import Foundation
+import simd
+
+/// A k-means codebook for SH coefficient sets, the way SOGS stores `shN`: a palette of centroid sets and a label
+/// per input set that fits in 16 bits.
+///
+/// Training is two-level so assignment stays affordable for 64K entries: sets are first clustered into about
+/// √entryCount coarse cells, then each cell is clustered on its own into a share of the entries proportional to its
+/// population. Each set is only compared against the coarse centroids and its own cell's centroids.
+internal struct SHCodebook {
+    /// Largest codebook addressable by a 16-bit label
+    static let maxEntryCount = Int(UInt16.max) + 1
+
+    /// Centroid coefficient sets, each as long as the training sets
+    let centroids: [[SIMD3<Float>]]
+    /// Index into `centroids` for each training set
+    let labels: [UInt16]
+
+    /// Clusters `sets` (all the same length) into at most `entryCount` centroids
+    /// - Parameter iterations: Lloyd iterations at each level
+    static func train(sets: [[SIMD3<Float>]], entryCount requestedEntryCount: Int, iterations: Int) -> SHCodebook {
+        guard let coefficientCount = sets.first?.count, coefficientCount > 0 else {
+            return SHCodebook(centroids: [], labels: [])
+        }
+        let dimension = coefficientCount * 3
+        let setCount = sets.count
+        var data = [Float](repeating: 0, count: setCount * dimension)
+        for (setIndex, set) in sets.enumerated() {
+            for (coefficientIndex, coefficient) in set.prefix(coefficientCount).enumerated() {
+                let offset = setIndex * dimension + coefficientIndex * 3
+                data[offset + 0] = coefficient.x
+                data[offset + 1] = coefficient.y
+                data[offset + 2] = coefficient.z
+            }
+        }
+
+        let entryCount = max(1, min(requestedEntryCount, maxEntryCount, setCount))
+        let iterations = max(iterations, 1)
+
+        return data.withUnsafeBufferPointer { data in
+            let coarseCount = min(Int(Double(entryCount).squareRoot().rounded(.up)), entryCount)
+            let coarse = kMeans(data, dimension: dimension, members: Array(0..<setCount),
+                                clusterCount: coarseCount, iterations: iterations, parallel: true)
+
+            let cellMembers = coarse.assignments.enumerated().reduce(into: [[Int]](repeating: [], count: coarseCount)) {
+                $0[$1.element].append($1.offset)
+            }
+
+            // Every populated cell gets at least one entry; the +1 per cell keeps the total within entryCount
+            let distributable = Double(entryCount - coarseCount)
+            let cellEntryCounts = cellMembers.map { members -> Int in
+                guard !members.isEmpty else { return 0 }
+                return min(members.count, Int(distributable * Double(members.count) / Double(setCount)) + 1)
+            }
+            let cellEnds = cellEntryCounts.reduce(into: [Int]()) { $0.append(($0.last ?? 0) + $1) }
+            let cellOffsets = [0] + cellEnds.dropLast()
+            let totalEntryCount = cellEnds.last ?? 0
+
+            var centroidData = [Float](repeating: 0, count: totalEntryCount * dimension)
+            var labels = [UInt16](repeating: 0, count: setCount)
+            centroidData.withUnsafeMutableBufferPointer { centroidData in
+                labels.withUnsafeMutableBufferPointer { labels in
+                    DispatchQueue.concurrentPerform(iterations: coarseCount) { cell in
+                        let members = cellMembers[cell]
+                        guard !members.isEmpty else { return }
+                        let fine = kMeans(data, dimension: dimension, members: members,
+                                          clusterCount: cellEntryCounts[cell], iterations: iterations, parallel: false)
+                        let offset = cellOffsets[cell]
+                        for (memberIndex, setIndex) in members.enumerated() {
+                            labels[setIndex] = UInt16(offset + fine.assignments[memberIndex])
+                        }
+                        for value in 0..<fine.centroids.count {
+                            centroidData[offset * dimension + value] = fine.centroids[value]
+                        }
+                    }
+                }
+            }
+
+            let centroids = (0..<totalEntryCount).map { entry in
+                (0..<coefficientCount).map { coefficient in
+                    let offset = entry * dimension + coefficient * 3
+                    return SIMD3<Float>(centroidData[offset], centroidData[offset + 1], centroidData[offset + 2])
+                }
+            }
+            return SHCodebook(centroids: centroids, labels: labels)
+        }
+    }
+
+    /// Lloyd's k-means over `members` (row indices into `data`), seeded with evenly spaced members so results are
+    /// deterministic. Clusters that empty out keep their previous centroid.
+    private static func kMeans(_ data: UnsafeBufferPointer<Float>,
+                               dimension: Int,
+                               members: [Int],
+                               clusterCount: Int,
+                               iterations: Int,
+                               parallel: Bool) -> (centroids: [Float], assignments: [Int]) {
+        var centroids = [Float](repeating: 0, count: clusterCount * dimension)
+        for cluster in 0..<clusterCount {
+            let row = members[cluster * members.count / clusterCount]
+            for value in 0..<dimension {
+                centroids[cluster * dimension + value] = data[row * dimension + value]
+            }
+        }
+        var assignments = [Int](repeating: 0, count: members.count)
+        guard clusterCount > 1 else {
+            updateCentroids(&centroids, data, dimension: dimension, members: members, assignments: assignments)
+            return (centroids, assignments)
+        }
+
+        for _ in 0..<iterations {
+            assign(&assignments, data, dimension: dimension, members: members, centroids: centroids, parallel: parallel)
+            updateCentroids(&centroids, data, dimension: dimension, members: members, assignments: assignments)
+        }
+        assign(&assignments, data, dimension: dimension, members: members, centroids: centroids, parallel: parallel)
+        return (centroids, assignments)
+    }
+
+    private static func assign(_ assignments: inout [Int],
+                               _ data: UnsafeBufferPointer<Float>,
+                               dimension: Int,
+                               members: [Int],
+                               centroids: [Float],
+                               parallel: Bool) {
+        let clusterCount = centroids.count / dimension
+        centroids.withUnsafeBufferPointer { centroids in
+            assignments.withUnsafeMutableBufferPointer { assignments in
+                let assignRange = { (range: Range<Int>) in
+                    for memberIndex in range {
+                        let row = members[memberIndex] * dimension
+                        var bestCluster = 0
+                        var bestDistance = Float.greatestFiniteMagnitude
+                        for cluster in 0..<clusterCount {
+                            let centroid = cluster * dimension
+                            var distance: Float = 0
+                            for value in 0..<dimension {
+                                let delta = data[row + value] - centroids[centroid + value]
+                                distance += delta * delta
+                            }
+                            if distance < bestDistance {
+                                bestDistance = distance
+                                bestCluster = cluster
+                            }
+                        }
+                        assignments[memberIndex] = bestCluster
+                    }
+                }
+
+                let batchSize = 1024
+                let batchCount = (members.count + batchSize - 1) / batchSize
+                if parallel && batchCount > 1 {
+                    DispatchQueue.concurrentPerform(iterations: batchCount) { batch in
+                        assignRange(batch * batchSize..<min((batch + 1) * batchSize, members.count))
+                    }
+                } else {
+                    assignRange(0..<members.count)
+                }
+            }
+        }
+    }
+
+    private static func updateCentroids(_ centroids: inout [Float],
+                                        _ data: UnsafeBufferPointer<Float>,
+                                        dimension: Int,
+                                        members: [Int],
+                                        assignments: [Int]) {
+        let clusterCount = centroids.count / dimension
+        var sums = [Float](repeating: 0, count: centroids.count)
+        var counts = [Int](repeating: 0, count: clusterCount)
+        for (memberIndex, cluster) in assignments.enumerated() {
+            let row = members[memberIndex] * dimension
+            counts[cluster] += 1
+            for value in 0..<dimension {
+                sums[cluster * dimension + value] += data[row + value]
+            }
+        }
+        for cluster in 0..<clusterCount where counts[cluster] > 0 {
+            let scale = 1 / Float(counts[cluster])
+            for value in 0..<dimension {
+                centroids[cluster * dimension + value] = sums[cluster * dimension + value] * scale
+            }
+        }
+    }
+}
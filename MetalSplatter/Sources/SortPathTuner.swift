@@ -0,0 +1,329 @@
+import Foundation
+import Metal
+import os
+
+/// Picks the full-sort path for `SplatRenderer`, and the counting sort's bin count, by timing every candidate on the
+/// device it runs on.
+///
+/// Choices are tuned per `Regime`: scene size in powers of two, the renderable fraction of the scene in quarters,
+/// whether stereo sorts each eye separately, and the paths available (hidden or deleted splats rule out Metal 4 and
+/// the CPU sort). A regime is first explored: each candidate runs back to back, its first `warmupSamplesPerChoice`
+/// sorts are discarded (buffer reallocation, pipeline warm-up) and the next `samplesPerChoice` are kept. The candidate
+/// with the lowest median wall time then wins and is used from then on. Editing the scene or loading another one
+/// moves the renderer into a different regime, which is tuned the same way the first time it is seen.
+///
+/// While a winner is in use its recent sort times are watched; when their median exceeds the tuned time by
+/// `regressionThreshold` (a different scene of similar size, thermal throttling) the regime is explored again.
+/// Winners persist per device model in `storageURL`, so a later launch starts out exploiting.
+/// Thread-safe; sorts report in from Metal's completion threads.
+public final class SortPathTuner: @unchecked Sendable {
+    private static let log = Logger(subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
+                                    category: "SortPathTuner")
+
+    public enum Path: String, Codable, Sendable, Comparable {
+        case metal4
+        case counting
+        case mps
+        case cpu
+
+        public static func < (lhs: Path, rhs: Path) -> Bool {
+            lhs.rawValue < rhs.rawValue
+        }
+    }
+
+    /// One candidate: a sort path and, for counting sort, its bin count
+    public struct Choice: Hashable, Codable, Sendable, CustomStringConvertible {
+        public let path: Path
+        public let countingBinCount: Int?
+
+        public init(path: Path, countingBinCount: Int? = nil) {
+            self.path = path
+            self.countingBinCount = path == .counting ? countingBinCount : nil
+        }
+
+        public var description: String {
+            countingBinCount.map { "\(path.rawValue)(\($0) bins)" } ?? path.rawValue
+        }
+    }
+
+    /// The conditions a choice is tuned for
+    public struct Regime: Hashable, Codable, Sendable, CustomStringConvertible {
+        /// floor(log2(splat count))
+        public let sceneSizeClass: Int
+        /// Renderable fraction of the scene in quarters, 0...3; 4 when every splat renders
+        public let renderableClass: Int
+        /// True when stereo sorts each eye separately
+        public let perEye: Bool
+        /// Paths the renderer could run, sorted
+        public let paths: [Path]
+
+        public init(splatCount: Int, renderableCount: Int, perEye: Bool, paths: [Path]) {
+            let splatCount = max(splatCount, 1)
+            self.sceneSizeClass = Int.bitWidth - 1 - splatCount.leadingZeroBitCount
+            let renderableCount = min(max(renderableCount, 0), splatCount)
+            self.renderableClass = renderableCount == splatCount ? 4 : min(renderableCount * 4 / splatCount, 3)
+            self.perEye = perEye
+            self.paths = Array(Set(paths)).sorted()
+        }
+
+        public var description: String {
+            "2^\(sceneSizeClass) splats, renderable \(renderableClass)/4\(perEye ? ", per eye" : ""), " +
+                "paths \(paths.map(\.rawValue).joined(separator: "/"))"
+        }
+    }
+
+    /// A regime's winner
+    public struct Result: Codable, Sendable, Equatable {
+        public let choice: Choice
+        /// Median wall time of the winner's kept exploration sorts
+        public let sortTime: TimeInterval
+    }
+
+    /// A sort run for the tuner; the renderer hands it back with the sort's time
+    internal struct Trial: Sendable, Equatable {
+        let regime: Regime
+        let choice: Choice
+    }
+
+    private struct RegimeState {
+        var candidates: [Choice] = []
+        var warmupsSeen: [Choice: Int] = [:]
+        var measurements: [Choice: [TimeInterval]] = [:]
+        var failedChoices: Set<Choice> = []
+        var winner: Result?
+        var recentWinnerTimes: [TimeInterval] = []
+    }
+
+    private struct StoredResults: Codable {
+        struct Entry: Codable {
+            let regime: Regime
+            let result: Result
+        }
+
+        static let currentVersion = 1
+
+        var version = currentVersion
+        let deviceName: String
+        let entries: [Entry]
+    }
+
+    /// `Caches/MetalSplatter/SortPathTuning`
+    public static var defaultDirectory: URL? {
+        FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first?
+            .appendingPathComponent("MetalSplatter", isDirectory: true)
+            .appendingPathComponent("SortPathTuning", isDirectory: true)
+    }
+
+    public let deviceName: String
+    /// Where winners are stored; nil keeps them in memory only
+    public let storageURL: URL?
+
+    /// Sorts kept per candidate while exploring
+    public var samplesPerChoice: Int {
+        get { withLock { _samplesPerChoice } }
+        set { withLock { _samplesPerChoice = max(newValue, 1) } }
+    }
+
+    /// Leading sorts of each candidate that are run but not measured
+    public var warmupSamplesPerChoice: Int {
+        get { withLock { _warmupSamplesPerChoice } }
+        set { withLock { _warmupSamplesPerChoice = max(newValue, 0) } }
+    }
+
+    /// Factor over the tuned time at which the winner's recent median triggers another exploration
+    public var regressionThreshold: Double {
+        get { withLock { _regressionThreshold } }
+        set { withLock { _regressionThreshold = max(newValue, 1) } }
+    }
+
+    /// Winner sorts whose median is compared against the tuned time
+    public var regressionWindow: Int {
+        get { withLock { _regressionWindow } }
+        set { withLock { _regressionWindow = max(newValue, 1) } }
+    }
+
+    private let lock = NSLock()
+    private var states: [Regime: RegimeState] = [:]
+    private var _samplesPerChoice = 4
+    private var _warmupSamplesPerChoice = 1
+    private var _regressionThreshold = 1.5
+    private var _regressionWindow = 32
+    /// Stored writes, off the render and Metal completion threads
+    private let storageQueue = DispatchQueue(label: "MetalSplatter.SortPathTuner", qos: .utility)
+
+    /// - Parameters:
+    ///   - deviceName: Device model the measurements belong to; stored results for another model are ignored
+    ///   - storageURL: File to load winners from and save them to; nil to keep them in memory only
+    public init(deviceName: String, storageURL: URL?) {
+        self.deviceName = deviceName
+        self.storageURL = storageURL
+        loadStoredResults()
+    }
+
+    /// A tuner for `device`, stored in `defaultDirectory` under the device's name
+    public convenience init(device: MTLDevice) {
+        let fileName = String(device.name.map { $0.isLetter || $0.isNumber || $0 == "-" ? $0 : "_" })
+        self.init(deviceName: device.name,
+                  storageURL: Self.defaultDirectory?.appendingPathComponent(fileName).appendingPathExtension("json"))
+    }
+
+    /// The winner for `regime`, or nil while it hasn't been tuned
+    public func tunedResult(for regime: Regime) -> Result? {
+        withLock { states[regime]?.winner }
+    }
+
+    /// Every regime's winner
+    public func tunedResults() -> [Regime: Result] {
+        withLock { states.compactMapValues(\.winner) }
+    }
+
+    /// Forgets all measurements and winners, including stored ones
+    public func reset() {
+        withLock { states.removeAll() }
+        saveResults()
+    }
+
+    // MARK: - Renderer
+
+    /// The choice to run next for a full sort. Candidates are explored in order, so the renderer's default path goes
+    /// first.
+    internal func trial(splatCount: Int, renderableCount: Int, perEye: Bool, candidates: [Choice]) -> Trial? {
+        guard !candidates.isEmpty else { return nil }
+        let regime = Regime(splatCount: splatCount,
+                            renderableCount: renderableCount,
+                            perEye: perEye,
+                            paths: candidates.map(\.path))
+        return withLock {
+            var state = states[regime] ?? RegimeState()
+            if let winner = state.winner, candidates.contains(winner.choice) {
+                return Trial(regime: regime, choice: winner.choice)
+            }
+            // A stored winner the renderer can no longer run (say, a different bin set) is explored over
+            if state.winner != nil || state.candidates != candidates {
+                state = RegimeState(candidates: candidates)
+            }
+            let choice = state.candidates.first {
+                !state.failedChoices.contains($0) && state.measurements[$0, default: []].count < _samplesPerChoice
+            } ?? candidates[0]
+            states[regime] = state
+            return Trial(regime: regime, choice: choice)
+        }
+    }
+
+    /// Reports a finished trial. A candidate whose sort fails while exploring is dropped from the regime.
+    internal func record(_ trial: Trial, sortTime: TimeInterval, completed: Bool) {
+        guard sortTime.isFinite, sortTime >= 0 else { return }
+        let changed: Bool = withLock {
+            guard var state = states[trial.regime] else { return false }
+            defer { states[trial.regime] = state }
+
+            if let winner = state.winner {
+                guard completed, trial.choice == winner.choice else { return false }
+                state.recentWinnerTimes.append(sortTime)
+                if state.recentWinnerTimes.count > _regressionWindow {
+                    state.recentWinnerTimes.removeFirst(state.recentWinnerTimes.count - _regressionWindow)
+                }
+                guard state.recentWinnerTimes.count == _regressionWindow,
+                      let recent = Self.median(state.recentWinnerTimes),
+                      recent > winner.sortTime * _regressionThreshold else {
+                    return false
+                }
+                let regression = String(format: "%.2fms, tuned at %.2fms", recent * 1000, winner.sortTime * 1000)
+                Self.log.info("Sort path \(winner.choice.description, privacy: .public) regressed to \(regression, privacy: .public) for \(trial.regime.description, privacy: .public); re-tuning")
+                // A winner loaded from storage has no candidates; the next trial supplies them
+                state = RegimeState(candidates: state.candidates)
+                return true
+            }
+
+            guard state.candidates.contains(trial.choice), !state.failedChoices.contains(trial.choice) else { return false }
+            if !completed {
+                Self.log.warning("Sort path \(trial.choice.description, privacy: .public) failed while tuning \(trial.regime.description, privacy: .public); no longer a candidate")
+                state.failedChoices.insert(trial.choice)
+                state.measurements[trial.choice] = nil
+            } else {
+                let warmups = state.warmupsSeen[trial.choice, default: 0]
+                if warmups < _warmupSamplesPerChoice {
+                    state.warmupsSeen[trial.choice] = warmups + 1
+                    return false
+                }
+                state.measurements[trial.choice, default: []].append(sortTime)
+            }
+
+            var medians: [(choice: Choice, sortTime: TimeInterval)] = []
+            for choice in state.candidates where !state.failedChoices.contains(choice) {
+                guard let times = state.measurements[choice], times.count >= _samplesPerChoice,
+                      let median = Self.median(times) else {
+                    return false
+                }
+                medians.append((choice, median))
+            }
+            guard let best = medians.min(by: { $0.sortTime < $1.sortTime }) else { return false }
+            state.winner = Result(choice: best.choice, sortTime: best.sortTime)
+            state.measurements.removeAll()
+            state.warmupsSeen.removeAll()
+            let summary = medians
+                .map { "\($0.choice.description)=\(String(format: "%.2f", $0.sortTime * 1000))ms" }
+                .joined(separator: " ")
+            Self.log.info("Sort path tuned to \(best.choice.description, privacy: .public) for \(trial.regime.description, privacy: .public): \(summary, privacy: .public)")
+            return true
+        }
+        if changed {
+            saveResults()
+        }
+    }
+
+    // MARK: - Storage
+
+    private func loadStoredResults() {
+        guard let storageURL, let data = try? Data(contentsOf: storageURL) else { return }
+        guard let stored = try? JSONDecoder().decode(StoredResults.self, from: data),
+              stored.version == StoredResults.currentVersion else {
+            Self.log.warning("Discarding unreadable sort path tuning at \(storageURL.path, privacy: .public)")
+            try? FileManager.default.removeItem(at: storageURL)
+            return
+        }
+        guard stored.deviceName == deviceName else { return }
+        for entry in stored.entries {
+            states[entry.regime] = RegimeState(winner: entry.result)
+        }
+    }
+
+    private func saveResults() {
+        guard let storageURL else { return }
+        let stored = withLock {
+            StoredResults(deviceName: deviceName,
+                          entries: states.compactMap { regime, state in
+                              state.winner.map { StoredResults.Entry(regime: regime, result: $0) }
+                          })
+        }
+        storageQueue.async {
+            do {
+                try FileManager.default.createDirectory(at: storageURL.deletingLastPathComponent(),
+                                                        withIntermediateDirectories: true)
+                try JSONEncoder().encode(stored).write(to: storageURL, options: .atomic)
+            } catch {
+                Self.log.warning("Failed to save sort path tuning: \(error.localizedDescription, privacy: .public)")
+            }
+        }
+    }
+
+    /// Waits for pending writes to `storageURL` (used by tests)
+    internal func waitForPendingWrites() {
+        storageQueue.sync {}
+    }
+
+    // MARK: - Helpers
+
+    private static func median(_ values: [TimeInterval]) -> TimeInterval? {
+        guard !values.isEmpty else { return nil }
+        let sorted = values.sorted()
+        let middle = sorted.count / 2
+        return sorted.count % 2 == 0 ? (sorted[middle - 1] + sorted[middle]) / 2 : sorted[middle]
+    }
+
+    private func withLock<Value>(_ body: () -> Value) -> Value {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
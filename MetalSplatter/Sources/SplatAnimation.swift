@@ -93,6 +93,83 @@ internal struct SplatAnimationSceneMetrics: Sendable {
     var radialExtent: Float
 }
 
+// MARK: - GPU Animation Inputs
+
+/// Resident per-splat input for the `animateSplats` kernels (must match SplatAnimation.metal).
+/// Holds the already-decoded linear attributes so the kernel never touches `SplatScenePoint` enums.
+internal struct SplatAnimationSourcePoint {
+    var positionOpacity: SIMD4<Float>
+    var scale: SIMD4<Float>
+    var rotation: SIMD4<Float>
+    var color: SIMD4<Float>
+
+    init(_ point: SplatScenePoint) {
+        positionOpacity = SIMD4<Float>(point.position, point.opacity.asLinearFloat)
+        scale = SIMD4<Float>(point.scale.asLinearFloat, 0)
+        rotation = point.rotation.normalized.vector
+        color = SIMD4<Float>(point.color.asLinearFloat, 0)
+    }
+}
+
+/// Per-scene metrics consumed by the animation kernels (must match SplatAnimation.metal)
+internal struct SplatAnimationGPUSceneMetrics {
+    var center: SIMD4<Float>
+    var centerOfMass: SIMD4<Float>
+
+    init(_ metrics: SplatAnimationSceneMetrics) {
+        center = SIMD4<Float>(metrics.center, 0)
+        centerOfMass = SIMD4<Float>(metrics.centerOfMass, 0)
+    }
+}
+
+/// Animation parameters for the `animateSplats` kernels (must match SplatAnimation.metal).
+/// `time` and `intensity` are pre-scaled exactly as in `SplatAnimationEngine.apply`.
+internal struct SplatAnimationGPUParameters {
+    var effect: UInt32
+    var pointCount: UInt32
+    var sceneCount: UInt32
+    var hasOrigin: UInt32
+    var time: Float
+    var intensity: Float
+    var minimumScale: Float
+    var radius: Float
+    var height: Float
+    var duration: Float
+    var holdDuration: Float
+    var transitionDuration: Float
+    var randomRadius: Float
+    var explosionStrength: Float
+    var gravity: Float
+    var bounceDamping: Float
+    var floorLevel: Float
+    var waves: Float
+    var padding0: Float = 0
+    var padding1: Float = 0
+    var origin: SIMD4<Float>
+
+    init(configuration: SplatAnimationConfiguration, pointCount: Int, sceneCount: Int) {
+        effect = configuration.effect.rawValue
+        self.pointCount = UInt32(pointCount)
+        self.sceneCount = UInt32(sceneCount)
+        hasOrigin = configuration.origin == nil ? 0 : 1
+        time = configuration.time * configuration.speed
+        intensity = max(configuration.intensity, 0)
+        minimumScale = configuration.minimumScale
+        radius = configuration.radius
+        height = configuration.height
+        duration = configuration.duration
+        holdDuration = configuration.holdDuration
+        transitionDuration = configuration.transitionDuration
+        randomRadius = configuration.randomRadius
+        explosionStrength = configuration.explosionStrength
+        gravity = configuration.gravity
+        bounceDamping = configuration.bounceDamping
+        floorLevel = configuration.floorLevel
+        waves = configuration.waves
+        origin = SIMD4<Float>(configuration.origin ?? SIMD3<Float>(repeating: 0), 0)
+    }
+}
+
 internal struct SplatAnimationSample {
     var point: SplatScenePoint
     var tint: SIMD3<Float> = SIMD3<Float>(repeating: 1)
@@ -796,21 +873,30 @@ internal extension SplatRenderer {
         }
         animatedSplatBuffer.count = 0
 
-        for (index, sourcePoint) in sourceScenePoints.enumerated() {
-            let sceneIndex = index < animationSceneIndices.count ? Int(animationSceneIndices[index]) : 0
-            var sample = SplatAnimationEngine.apply(
-                point: sourcePoint,
-                globalIndex: index,
-                sceneIndex: sceneIndex,
-                sceneMetrics: animationSceneMetrics,
-                configuration: configuration
-            )
+        if let pipeline = animateSplatsPipelineState,
+           encodeAnimationKernel(pipeline,
+                                 configuration: configuration,
+                                 output: animatedSplatBuffer.buffer,
+                                 label: "Animate Splats",
+                                 to: commandBuffer) {
+            animatedSplatBuffer.count = sourceScenePoints.count
+        } else {
+            for (index, sourcePoint) in sourceScenePoints.enumerated() {
+                let sceneIndex = index < animationSceneIndices.count ? Int(animationSceneIndices[index]) : 0
+                var sample = SplatAnimationEngine.apply(
+                    point: sourcePoint,
+                    globalIndex: index,
+                    sceneIndex: sceneIndex,
+                    sceneMetrics: animationSceneMetrics,
+                    configuration: configuration
+                )
 
-            let tintedColor = simd_clamp(sample.point.color.asLinearFloat * sample.tint, SIMD3<Float>(repeating: 0), SIMD3<Float>(repeating: 4))
-            sample.point.color = .linearFloat(tintedColor)
-            sample.point.rotation = sample.point.rotation.normalized
+                let tintedColor = simd_clamp(sample.point.color.asLinearFloat * sample.tint, SIMD3<Float>(repeating: 0), SIMD3<Float>(repeating: 4))
+                sample.point.color = .linearFloat(tintedColor)
+                sample.point.rotation = sample.point.rotation.normalized
 
-            animatedSplatBuffer.append(Splat(sample.point))
+                animatedSplatBuffer.append(Splat(sample.point))
+            }
         }
 
         let previousAnimatedBuffer = self.animatedSplatBuffer
@@ -825,6 +911,107 @@ internal extension SplatRenderer {
         return true
     }
 
+    /// Encodes one of the `animateSplats` kernels over every source point, writing into `output`.
+    /// Returns false (without encoding anything) when GPU animation is disabled or the resident
+    /// inputs could not be prepared, in which case callers fall back to `SplatAnimationEngine`.
+    func encodeAnimationKernel(_ pipeline: MTLComputePipelineState,
+                               configuration: SplatAnimationConfiguration,
+                               output: MTLBuffer,
+                               label: String,
+                               to commandBuffer: MTLCommandBuffer,
+                               bindAdditionalResources: (MTLComputeCommandEncoder) -> Void = { _ in }) -> Bool {
+        guard gpuAnimationEnabled, prepareAnimationSourceBuffersIfNeeded(),
+              let sourceBuffer = animationSourceBuffer,
+              let sceneIndexBuffer = animationSceneIndexBuffer,
+              let sceneDataBuffer = animationSceneDataBuffer else {
+            return false
+        }
+
+        let pointCount = sourceBuffer.count
+        guard pointCount > 0 else { return false }
+
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            Self.log.error("Failed to create compute encoder for splat animation")
+            return false
+        }
+        encoder.label = label
+        var parameters = SplatAnimationGPUParameters(configuration: configuration,
+                                                     pointCount: pointCount,
+                                                     sceneCount: sceneDataBuffer.count)
+        encoder.setComputePipelineState(pipeline)
+        encoder.setBytes(&parameters, length: MemoryLayout<SplatAnimationGPUParameters>.stride, index: 0)
+        encoder.setBuffer(sourceBuffer.buffer, offset: 0, index: 1)
+        encoder.setBuffer(sceneIndexBuffer.buffer, offset: 0, index: 2)
+        encoder.setBuffer(sceneDataBuffer.buffer, offset: 0, index: 3)
+        encoder.setBuffer(output, offset: 0, index: 4)
+        bindAdditionalResources(encoder)
+
+        let threadsPerGroup = MTLSize(width: 256, height: 1, depth: 1)
+        let threadgroups = MTLSize(width: (pointCount + 255) / 256, height: 1, depth: 1)
+        encoder.dispatchThreadgroups(threadgroups, threadsPerThreadgroup: threadsPerGroup)
+        encoder.endEncoding()
+        return true
+    }
+
+    /// Uploads source points, scene indices and scene metrics into resident buffers for the animation kernels.
+    /// This is the only per-splat CPU work in the GPU path and runs only after the source data changes.
+    /// Fresh buffers are allocated on each upload so in-flight command buffers keep reading the old ones.
+    private func prepareAnimationSourceBuffersIfNeeded() -> Bool {
+        if !animationSourceDirty,
+           let animationSourceBuffer, animationSourceBuffer.count == sourceScenePoints.count,
+           animationSceneIndexBuffer != nil, animationSceneDataBuffer != nil {
+            return true
+        }
+
+        let pointCount = sourceScenePoints.count
+        do {
+            let sourceBuffer = try MetalBuffer<SplatAnimationSourcePoint>(device: device, capacity: pointCount)
+            sourceBuffer.withLockedValues { values, _ in
+                for (index, point) in sourceScenePoints.enumerated() {
+                    values[index] = SplatAnimationSourcePoint(point)
+                }
+            }
+            sourceBuffer.count = pointCount
+            sourceBuffer.buffer.label = "Animation Source Points"
+
+            let sceneIndexBuffer = try MetalBuffer<UInt32>(device: device, capacity: pointCount)
+            sceneIndexBuffer.withLockedValues { values, _ in
+                let indexCount = min(animationSceneIndices.count, pointCount)
+                animationSceneIndices.withUnsafeBufferPointer { indices in
+                    if indexCount > 0 {
+                        values.update(from: indices.baseAddress!, count: indexCount)
+                    }
+                }
+                if indexCount < pointCount {
+                    (values + indexCount).initialize(repeating: 0, count: pointCount - indexCount)
+                }
+            }
+            sceneIndexBuffer.count = pointCount
+            sceneIndexBuffer.buffer.label = "Animation Scene Indices"
+
+            let sceneDataBuffer = try MetalBuffer<SplatAnimationGPUSceneMetrics>(device: device,
+                                                                                 capacity: max(animationSceneMetrics.count, 1))
+            _ = sceneDataBuffer.append(animationSceneMetrics.map(SplatAnimationGPUSceneMetrics.init))
+            sceneDataBuffer.buffer.label = "Animation Scene Metrics"
+
+            animationSourceBuffer = sourceBuffer
+            animationSceneIndexBuffer = sceneIndexBuffer
+            animationSceneDataBuffer = sceneDataBuffer
+            animationSourceDirty = false
+            return true
+        } catch {
+            Self.log.error("Failed to upload animation source buffers: \(error)")
+            return false
+        }
+    }
+
+    func releaseAnimationSourceBuffers() {
+        animationSourceBuffer = nil
+        animationSceneIndexBuffer = nil
+        animationSceneDataBuffer = nil
+        animationSourceDirty = true
+    }
+
     static func makeSceneMetrics(points: [SplatScenePoint], sceneCounts: [Int]) -> [SplatAnimationSceneMetrics] {
         guard !points.isEmpty else { return [] }
         var metrics: [SplatAnimationSceneMetrics] = []
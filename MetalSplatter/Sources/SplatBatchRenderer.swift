@@ -0,0 +1,467 @@
+import CoreGraphics
+import Foundation
+import ImageIO
+import Metal
+import os
+import simd
+import UniformTypeIdentifiers
+
+/// Renders one loaded scene from a list of cameras offscreen, as fast as the GPU allows, for thumbnails, turntables
+/// and other batch jobs.
+///
+/// Interactive rendering sorts asynchronously and draws with whichever order was published last. Here each camera's
+/// counting sort is encoded into the same command buffer as its draw, ahead of it, so every frame is ordered for its
+/// own camera without a CPU round trip. Up to `framesInFlight` cameras (the renderer's `maxSimultaneousRenders`) are
+/// on the GPU at once, each with its own sort order, targets and readback buffer. SH evaluation and the draw run
+/// through the renderer's usual `render` in the frame's command buffer. For image output, a frame's pixels are
+/// blitted into shared memory at the end of its command buffer, which then signals an `MTLSharedEvent`. The CPU
+/// collects the frame once the event reaches the frame's value; it never blocks on a command buffer.
+///
+/// The renderer should be given over to the batch while it runs. Batch frames draw one view each with the renderer's
+/// current settings, don't schedule camera-driven resorts and don't change the published order. Packed and instanced
+/// scenes sort within `render` as usual. One batch runs at a time.
+public final class SplatBatchRenderer: @unchecked Sendable {
+    private static let log = Logger(subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
+                                    category: "SplatBatchRenderer")
+
+    public struct Camera: Sendable {
+        public var viewMatrix: simd_float4x4
+        public var projectionMatrix: simd_float4x4
+
+        public init(viewMatrix: simd_float4x4, projectionMatrix: simd_float4x4) {
+            self.viewMatrix = viewMatrix
+            self.projectionMatrix = projectionMatrix
+        }
+
+        /// `frameCount` cameras evenly spaced on a horizontal circle of `distance` around `center`, raised by
+        /// `height` and looking at `center`: one full turn of a turntable
+        public static func turntable(center: SIMD3<Float>,
+                                     distance: Float,
+                                     height: Float = 0,
+                                     frameCount: Int,
+                                     fovY: Float = .pi / 3,
+                                     aspect: Float,
+                                     near: Float = 0.01,
+                                     far: Float = 1000,
+                                     up: SIMD3<Float> = SIMD3(0, 1, 0)) -> [Camera] {
+            let projection = GPUPerformanceProfiler.perspective(fovY: fovY, aspect: aspect, near: near, far: far)
+            return (0..<max(frameCount, 0)).map { frame in
+                let angle = 2 * Float.pi * Float(frame) / Float(frameCount)
+                let eye = center + SIMD3(sin(angle) * distance, height, cos(angle) * distance)
+                return Camera(viewMatrix: GPUPerformanceProfiler.lookAt(eye: eye, target: center, up: up),
+                              projectionMatrix: projection)
+            }
+        }
+    }
+
+    /// A frame read back to the CPU: `height` rows of `bytesPerRow` bytes in the renderer's color format, alpha
+    /// premultiplied
+    public struct Image: Sendable {
+        /// Index of the frame's camera
+        public let index: Int
+        public let width: Int
+        public let height: Int
+        public let bytesPerRow: Int
+        public let pixelFormat: MTLPixelFormat
+        public let data: Data
+
+        /// An sRGB `CGImage` of the pixels; nil unless the format is 8-bit BGRA or RGBA
+        public func makeCGImage() -> CGImage? {
+            let bitmapInfo: CGBitmapInfo
+            switch pixelFormat {
+            case .bgra8Unorm, .bgra8Unorm_srgb:
+                bitmapInfo = CGBitmapInfo(rawValue: CGBitmapInfo.byteOrder32Little.rawValue
+                                          | CGImageAlphaInfo.premultipliedFirst.rawValue)
+            case .rgba8Unorm, .rgba8Unorm_srgb:
+                bitmapInfo = CGBitmapInfo(rawValue: CGBitmapInfo.byteOrder32Big.rawValue
+                                          | CGImageAlphaInfo.premultipliedLast.rawValue)
+            default:
+                return nil
+            }
+            guard let provider = CGDataProvider(data: data as CFData),
+                  let colorSpace = CGColorSpace(name: CGColorSpace.sRGB) else {
+                return nil
+            }
+            return CGImage(width: width, height: height, bitsPerComponent: 8, bitsPerPixel: 32, bytesPerRow: bytesPerRow,
+                           space: colorSpace, bitmapInfo: bitmapInfo, provider: provider, decode: nil,
+                           shouldInterpolate: false, intent: .defaultIntent)
+        }
+    }
+
+    /// Per-slot resources, reused by every `framesInFlight`-th frame
+    private final class Slot {
+        let order: MetalBuffer<Int32>
+        let sorter: CountingSorter
+        let colorTexture: MTLTexture
+        let depthTexture: MTLTexture?
+        let readbackBuffer: MTLBuffer?
+
+        init(order: MetalBuffer<Int32>, sorter: CountingSorter, colorTexture: MTLTexture, depthTexture: MTLTexture?,
+             readbackBuffer: MTLBuffer?) {
+            self.order = order
+            self.sorter = sorter
+            self.colorTexture = colorTexture
+            self.depthTexture = depthTexture
+            self.readbackBuffer = readbackBuffer
+        }
+    }
+
+    /// A committed frame; `error` is set from its command buffer's completion handler
+    private final class PendingFrame: @unchecked Sendable {
+        let index: Int
+        let slot: Int
+        let eventValue: UInt64
+        private let lock = NSLock()
+        private var _failure: (any Error)??
+
+        init(index: Int, slot: Int, eventValue: UInt64) {
+            self.index = index
+            self.slot = slot
+            self.eventValue = eventValue
+        }
+
+        /// nil while the frame hasn't failed; otherwise the command buffer's error, if it had one
+        var failure: (any Error)?? {
+            lock.lock()
+            defer { lock.unlock() }
+            return _failure
+        }
+
+        func fail(_ error: (any Error)?) {
+            lock.lock()
+            _failure = .some(error)
+            lock.unlock()
+        }
+    }
+
+    public let renderer: SplatRenderer
+    public let commandQueue: MTLCommandQueue
+    /// Size of every frame, in pixels
+    public let resolution: SIMD2<Int>
+    public let framesInFlight: Int
+
+    private let slots: [Slot]
+    private let bytesPerPixel: Int?
+    private let event: MTLSharedEvent
+    private let eventListener = MTLSharedEventListener(dispatchQueue: DispatchQueue(label: "MetalSplatter.SplatBatchRenderer"))
+    private var nextEventValue: UInt64 = 1
+    private let batchLock = NSLock()
+    private var isRunningBatch = false
+
+    /// - Parameters:
+    ///   - renderer: A renderer with its scene loaded, created with `sampleCount` 1
+    ///   - resolution: Frame size in pixels
+    ///   - commandQueue: Queue for the batch; a new queue by default
+    /// - Throws: `SplatRendererError.invalidBatchConfiguration` for a multisampled renderer or an empty resolution
+    public init(renderer: SplatRenderer, resolution: SIMD2<Int>, commandQueue: MTLCommandQueue? = nil) throws {
+        guard renderer.sampleCount == 1 else {
+            throw SplatRendererError.invalidBatchConfiguration(reason: "batch rendering draws without multisampling; sampleCount is \(renderer.sampleCount)")
+        }
+        guard resolution.x > 0, resolution.y > 0 else {
+            throw SplatRendererError.invalidBatchConfiguration(reason: "resolution \(resolution.x)x\(resolution.y) is empty")
+        }
+        let device = renderer.device
+        guard let commandQueue = commandQueue ?? device.makeCommandQueue() else {
+            throw SplatRendererError.failedToCreateCommandBuffer
+        }
+        guard let event = device.makeSharedEvent() else {
+            throw SplatRendererError.failedToCreateSharedEvent
+        }
+        event.label = "Batch Frames"
+        self.renderer = renderer
+        self.commandQueue = commandQueue
+        self.resolution = resolution
+        self.event = event
+        // The renderer's uniforms ring holds one frame per simultaneous render
+        self.framesInFlight = max(renderer.maxSimultaneousRenders, 1)
+        self.bytesPerPixel = Self.bytesPerPixel(renderer.colorFormat)
+
+        var slots: [Slot] = []
+        for index in 0..<framesInFlight {
+            let colorTexture = try Self.makeTexture(device: device, format: renderer.colorFormat, resolution: resolution,
+                                                    usage: [.renderTarget, .shaderRead], label: "Batch Color \(index)")
+            let depthTexture = renderer.depthFormat == .invalid
+                ? nil
+                : try Self.makeTexture(device: device, format: renderer.depthFormat, resolution: resolution,
+                                       usage: .renderTarget, label: "Batch Depth \(index)")
+            var readbackBuffer: MTLBuffer?
+            if let bytesPerPixel {
+                let length = bytesPerPixel * resolution.x * resolution.y
+                guard let buffer = device.makeBuffer(length: length, options: .storageModeShared) else {
+                    throw SplatRendererError.failedToCreateBuffer(length: length)
+                }
+                buffer.label = "Batch Readback \(index)"
+                readbackBuffer = buffer
+            }
+            slots.append(Slot(order: try MetalBuffer(device: device, capacity: max(renderer.splatCount, 1)),
+                              sorter: try CountingSorter(device: device, library: renderer.library),
+                              colorTexture: colorTexture,
+                              depthTexture: depthTexture,
+                              readbackBuffer: readbackBuffer))
+        }
+        self.slots = slots
+    }
+
+    // MARK: - Rendering
+
+    /// Renders `cameras[i]` into `textures[i]`, which stay on the GPU. Returns once every frame is complete.
+    /// - Throws: `SplatRendererError.invalidBatchConfiguration` unless each texture is a `resolution`-sized render
+    ///   target in the renderer's color format; `SplatRendererError.batchFrameFailed` when a frame's command buffer fails
+    public func render(_ cameras: [Camera], into textures: [MTLTexture]) async throws {
+        guard textures.count == cameras.count else {
+            throw SplatRendererError.invalidBatchConfiguration(reason: "\(cameras.count) cameras need as many textures, not \(textures.count)")
+        }
+        for texture in textures {
+            guard texture.width == resolution.x, texture.height == resolution.y,
+                  texture.pixelFormat == renderer.colorFormat, texture.usage.contains(.renderTarget) else {
+                throw SplatRendererError.invalidBatchConfiguration(reason: "textures must be \(resolution.x)x\(resolution.y) render targets in the renderer's color format")
+            }
+        }
+        try await renderFrames(cameras, outputTextures: textures, deliver: nil)
+    }
+
+    /// Renders every camera and reads each frame back, calling `handler` in camera order as frames complete while
+    /// later frames are still on the GPU.
+    /// - Throws: `SplatRendererError.invalidBatchConfiguration` for color formats that aren't 8, 16 or 32 bits per
+    ///   channel; `SplatRendererError.batchFrameFailed` when a frame's command buffer fails; or what `handler` throws
+    public func render(_ cameras: [Camera], handler: (Image) throws -> Void) async throws {
+        guard bytesPerPixel != nil else {
+            throw SplatRendererError.invalidBatchConfiguration(reason: "frames in pixel format \(renderer.colorFormat.rawValue) can't be read back")
+        }
+        try await renderFrames(cameras, outputTextures: nil, deliver: handler)
+    }
+
+    /// Renders every camera to a PNG in `directory`, named `<prefix><index, zero-padded>.png`
+    /// - Returns: The written files, in camera order
+    /// - Throws: `SplatRendererError.invalidBatchConfiguration` unless the color format is 8-bit BGRA or RGBA;
+    ///   `SplatRendererError.failedToWriteImage` when a file can't be written
+    @discardableResult
+    public func writeImages(_ cameras: [Camera], to directory: URL, fileNamePrefix: String = "frame") async throws -> [URL] {
+        switch renderer.colorFormat {
+        case .bgra8Unorm, .bgra8Unorm_srgb, .rgba8Unorm, .rgba8Unorm_srgb:
+            break
+        default:
+            throw SplatRendererError.invalidBatchConfiguration(reason: "PNG output needs an 8-bit BGRA or RGBA color format")
+        }
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        let digits = max(String(max(cameras.count - 1, 0)).count, 4)
+        var urls: [URL] = []
+        try await render(cameras) { image in
+            let number = String(image.index)
+            let name = fileNamePrefix + String(repeating: "0", count: max(digits - number.count, 0)) + number
+            let url = directory.appendingPathComponent(name).appendingPathExtension("png")
+            guard let cgImage = image.makeCGImage(),
+                  let destination = CGImageDestinationCreateWithURL(url as CFURL, UTType.png.identifier as CFString, 1, nil) else {
+                throw SplatRendererError.failedToWriteImage(url: url)
+            }
+            CGImageDestinationAddImage(destination, cgImage, nil)
+            guard CGImageDestinationFinalize(destination) else {
+                throw SplatRendererError.failedToWriteImage(url: url)
+            }
+            urls.append(url)
+        }
+        return urls
+    }
+
+    // MARK: - Private
+
+    private func renderFrames(_ cameras: [Camera],
+                              outputTextures: [MTLTexture]?,
+                              deliver: ((Image) throws -> Void)?) async throws {
+        try beginBatch()
+        defer { endBatch() }
+        guard !cameras.isEmpty else { return }
+
+        let startTime = CFAbsoluteTimeGetCurrent()
+        var pending: [PendingFrame?] = Array(repeating: nil, count: slots.count)
+        do {
+            for (index, camera) in cameras.enumerated() {
+                let slotIndex = index % slots.count
+                // The slot's previous frame is collected before its resources are reused
+                if let previous = pending[slotIndex] {
+                    pending[slotIndex] = nil
+                    try await finish(previous, deliver: deliver)
+                }
+                pending[slotIndex] = try encodeFrame(index: index,
+                                                     camera: camera,
+                                                     slotIndex: slotIndex,
+                                                     outputTexture: outputTextures?[index],
+                                                     readsBack: deliver != nil)
+            }
+            for frame in pending.compactMap({ $0 }).sorted(by: { $0.index < $1.index }) {
+                try await finish(frame, deliver: deliver)
+            }
+        } catch {
+            // Frames still on the GPU own their slots; let them drain before the next batch
+            for frame in pending.compactMap({ $0 }) {
+                await waitForEvent(frame.eventValue)
+            }
+            throw error
+        }
+
+        let elapsed = CFAbsoluteTimeGetCurrent() - startTime
+        Self.log.info("Rendered \(cameras.count) batch frames in \(String(format: "%.3f", elapsed), privacy: .public)s (\(String(format: "%.1f", Double(cameras.count) / max(elapsed, 1e-6)), privacy: .public) fps)")
+    }
+
+    private func encodeFrame(index: Int,
+                             camera: Camera,
+                             slotIndex: Int,
+                             outputTexture: MTLTexture?,
+                             readsBack: Bool) throws -> PendingFrame {
+        let slot = slots[slotIndex]
+        guard let commandBuffer = commandQueue.makeCommandBuffer() else {
+            throw SplatRendererError.failedToCreateCommandBuffer
+        }
+        commandBuffer.label = "Batch Frame \(index)"
+
+        let colorTexture = outputTexture ?? slot.colorTexture
+        let viewport = MTLViewport(originX: 0, originY: 0,
+                                   width: Double(resolution.x), height: Double(resolution.y),
+                                   znear: 0, zfar: 1)
+        if renderer.drawsWithFrameSortOrder {
+            try renderer.encodeFrameSort(into: slot.order, sorter: slot.sorter, viewMatrix: camera.viewMatrix, to: commandBuffer)
+            try renderer.withFrameSortOrder(slot.order) {
+                try draw(camera: camera, viewport: viewport, colorTexture: colorTexture, depthTexture: slot.depthTexture,
+                         to: commandBuffer)
+            }
+        } else {
+            try draw(camera: camera, viewport: viewport, colorTexture: colorTexture, depthTexture: slot.depthTexture,
+                     to: commandBuffer)
+        }
+
+        if readsBack, let readbackBuffer = slot.readbackBuffer, let bytesPerPixel {
+            guard let blitEncoder = commandBuffer.makeBlitCommandEncoder() else {
+                throw SplatRendererError.failedToCreateComputeEncoder
+            }
+            blitEncoder.label = "Batch Readback"
+            let bytesPerRow = bytesPerPixel * resolution.x
+            blitEncoder.copy(from: colorTexture,
+                             sourceSlice: 0,
+                             sourceLevel: 0,
+                             sourceOrigin: MTLOrigin(x: 0, y: 0, z: 0),
+                             sourceSize: MTLSize(width: resolution.x, height: resolution.y, depth: 1),
+                             to: readbackBuffer,
+                             destinationOffset: 0,
+                             destinationBytesPerRow: bytesPerRow,
+                             destinationBytesPerImage: bytesPerRow * resolution.y)
+            blitEncoder.endEncoding()
+        }
+
+        let eventValue = nextEventValue
+        nextEventValue += 1
+        let frame = PendingFrame(index: index, slot: slotIndex, eventValue: eventValue)
+        commandBuffer.encodeSignalEvent(event, value: eventValue)
+        // A failed command buffer may never reach its signal, so its waiter is released from the CPU
+        commandBuffer.addCompletedHandler { [event] commandBuffer in
+            guard commandBuffer.status == .error else { return }
+            frame.fail(commandBuffer.error)
+            if event.signaledValue < eventValue {
+                event.signaledValue = eventValue
+            }
+        }
+        commandBuffer.commit()
+        return frame
+    }
+
+    private func draw(camera: Camera,
+                      viewport: MTLViewport,
+                      colorTexture: MTLTexture,
+                      depthTexture: MTLTexture?,
+                      to commandBuffer: MTLCommandBuffer) throws {
+        if let fastSHRenderer = renderer as? FastSHSplatRenderer {
+            try fastSHRenderer.render(viewports: [ModelRendererViewportDescriptor(viewport: viewport,
+                                                                                  projectionMatrix: camera.projectionMatrix,
+                                                                                  viewMatrix: camera.viewMatrix,
+                                                                                  screenSize: resolution)],
+                                      colorTexture: colorTexture,
+                                      colorStoreAction: .store,
+                                      depthTexture: depthTexture,
+                                      rasterizationRateMap: nil,
+                                      renderTargetArrayLength: 0,
+                                      to: commandBuffer)
+        } else {
+            try renderer.render(viewports: [SplatRenderer.ViewportDescriptor(viewport: viewport,
+                                                                             projectionMatrix: camera.projectionMatrix,
+                                                                             viewMatrix: camera.viewMatrix,
+                                                                             screenSize: resolution)],
+                                colorTexture: colorTexture,
+                                colorStoreAction: .store,
+                                depthTexture: depthTexture,
+                                rasterizationRateMap: nil,
+                                renderTargetArrayLength: 0,
+                                to: commandBuffer)
+        }
+    }
+
+    /// Waits for `frame`'s event value, then hands its pixels to `deliver`
+    private func finish(_ frame: PendingFrame, deliver: ((Image) throws -> Void)?) async throws {
+        await waitForEvent(frame.eventValue)
+        if let failure = frame.failure {
+            throw SplatRendererError.batchFrameFailed(index: frame.index, underlying: failure)
+        }
+        guard let deliver, let readbackBuffer = slots[frame.slot].readbackBuffer, let bytesPerPixel else { return }
+        let bytesPerRow = bytesPerPixel * resolution.x
+        try deliver(Image(index: frame.index,
+                          width: resolution.x,
+                          height: resolution.y,
+                          bytesPerRow: bytesPerRow,
+                          pixelFormat: renderer.colorFormat,
+                          data: Data(bytes: readbackBuffer.contents(), count: bytesPerRow * resolution.y)))
+    }
+
+    private func waitForEvent(_ value: UInt64) async {
+        guard event.signaledValue < value else { return }
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            // Called right away when the value has been reached in the meantime
+            event.notify(eventListener, atValue: value) { _, _ in
+                continuation.resume()
+            }
+        }
+    }
+
+    private func beginBatch() throws {
+        batchLock.lock()
+        defer { batchLock.unlock() }
+        guard !isRunningBatch else {
+            throw SplatRendererError.invalidBatchConfiguration(reason: "another batch is still running")
+        }
+        isRunningBatch = true
+    }
+
+    private func endBatch() {
+        batchLock.lock()
+        isRunningBatch = false
+        batchLock.unlock()
+    }
+
+    private static func makeTexture(device: MTLDevice,
+                                    format: MTLPixelFormat,
+                                    resolution: SIMD2<Int>,
+                                    usage: MTLTextureUsage,
+                                    label: String) throws -> MTLTexture {
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: format,
+                                                                  width: resolution.x, height: resolution.y,
+                                                                  mipmapped: false)
+        descriptor.usage = usage
+        descriptor.storageMode = .private
+        guard let texture = device.makeTexture(descriptor: descriptor) else {
+            throw SplatRendererError.failedToCreateBuffer(length: resolution.x * resolution.y * 4)
+        }
+        texture.label = label
+        return texture
+    }
+
+    /// Bytes per pixel of color formats that blit into a linear buffer; nil for others (compressed, packed)
+    static func bytesPerPixel(_ format: MTLPixelFormat) -> Int? {
+        switch format {
+        case .bgra8Unorm, .bgra8Unorm_srgb, .rgba8Unorm, .rgba8Unorm_srgb, .rgb10a2Unorm, .bgr10a2Unorm:
+            return 4
+        case .rgba16Float, .rgba16Unorm:
+            return 8
+        case .rgba32Float:
+            return 16
+        default:
+            return nil
+        }
+    }
+}
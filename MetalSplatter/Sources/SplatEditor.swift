@@ -135,6 +135,33 @@ public struct OutlierSelectionConfig: Sendable {
     }
 }
 
+extension OutlierSelectionConfig {
+    /// Voxel edge length for candidates whose bounds have `diagonal` and whose mean representative scale is
+    /// `averageScale`
+    func voxelSize(diagonal: Float, averageScale: Float) -> Float {
+        let clampedVoxelFraction = max(voxelFractionOfBounds, 0.001)
+        let clampedScaleInfluence = max(scaleInfluence, 0)
+        let unclampedVoxelSize = max(diagonal * clampedVoxelFraction, averageScale * clampedScaleInfluence)
+        return min(
+            max(unclampedVoxelSize, max(minimumVoxelSize, 0.0001)),
+            max(maximumVoxelSize, minimumVoxelSize)
+        )
+    }
+}
+
+/// Occupied outlier voxels built on the GPU, each a range of `sortedIndices`
+struct OutlierVoxelGrid: Sendable {
+    struct Cell: Sendable {
+        var coordinate: SIMD3<Int32>
+        var score: Float
+        var entries: Range<Int>
+    }
+
+    var cells: [Cell]
+    /// Candidate splat indices grouped by voxel
+    var sortedIndices: [UInt32]
+}
+
 public struct SplatEditorSnapshot: Sendable {
     public var totalCount: Int
     public var visibleCount: Int
@@ -178,16 +205,69 @@ struct EditableSplatPointChange: Sendable {
     var newPoint: SplatScenePoint
 }
 
+/// The store's paged arrays at one point in time. Taking one copies page references only; pages are shared with
+/// the live store until an edit writes to them.
 struct EditableSplatStoreSnapshot: Sendable {
+    var points: PagedArray<SplatScenePoint>
+    var states: PagedArray<EditableSplatState>
+    var sceneIndices: PagedArray<UInt32>
+
+    /// Bytes held by pages the snapshot no longer shares with `store`
+    func unsharedByteCount(relativeTo store: EditableSplatStore) -> Int {
+        let pageSize = PagedArray<SplatScenePoint>.pageSize
+        return points.pagesNotShared(with: store.points) * pageSize * EditableSplatStore.estimatedPointByteCount
+            + states.pagesNotShared(with: store.states) * pageSize * MemoryLayout<EditableSplatState>.stride
+            + sceneIndices.pagesNotShared(with: store.sceneIndices) * pageSize * MemoryLayout<UInt32>.stride
+    }
+}
+
+/// Splats appended to the end of the store by duplication, with the state changes made to their sources
+struct EditableSplatAppend: Sendable {
+    var startIndex: Int
     var points: [SplatScenePoint]
     var states: [EditableSplatState]
     var sceneIndices: [UInt32]
+    var sourceStateChanges: [EditableSplatStateChange]
+
+    var indices: Range<Int> { startIndex..<(startIndex + points.count) }
+}
+
+/// A structural edit that keeps `keptIndices` of `before`, in order
+struct EditableSplatSeparation: Sendable {
+    var before: EditableSplatStoreSnapshot
+    var keptIndices: [Int]
+    /// The renderer's `mortonPermutation` before the edit
+    var mortonPermutation: [UInt32]?
+
+    /// The renderer's `mortonPermutation` after the edit
+    var keptMortonPermutation: [UInt32]? {
+        SplatRenderer.mortonPermutation(mortonPermutation, keeping: keptIndices)
+    }
 }
 
 enum SplatEditHistoryEntry: Sendable {
     case states([EditableSplatStateChange])
     case points([EditableSplatPointChange])
-    case snapshot(EditableSplatStoreSnapshot)
+    case append(EditableSplatAppend)
+    case separation(EditableSplatSeparation)
+
+    /// Approximate bytes the entry keeps alive, counted against `SplatEditor.historyMemoryLimit`
+    func estimatedByteCount(relativeTo store: EditableSplatStore) -> Int {
+        let stateChangeSize = MemoryLayout<EditableSplatStateChange>.stride
+        switch self {
+        case .states(let changes):
+            return changes.count * stateChangeSize
+        case .points(let changes):
+            return changes.count * (MemoryLayout<Int>.stride + 2 * EditableSplatStore.estimatedPointByteCount)
+        case .append(let append):
+            return append.points.count * (EditableSplatStore.estimatedPointByteCount
+                                          + MemoryLayout<EditableSplatState>.stride + MemoryLayout<UInt32>.stride)
+                + append.sourceStateChanges.count * stateChangeSize
+        case .separation(let separation):
+            return separation.before.unsharedByteCount(relativeTo: store)
+                + separation.keptIndices.count * MemoryLayout<Int>.stride
+        }
+    }
 }
 
 struct EditableSplatStore: Sendable {
@@ -202,6 +282,11 @@ struct EditableSplatStore: Sendable {
         var indices: [Int] = []
     }
 
+    private struct OutlierVoxelScore: Sendable {
+        var score: Float
+        var count: Int
+    }
+
     struct ProjectedCandidate: Sendable {
         var index: Int
         var normalized: SIMD2<Float>
@@ -209,19 +294,22 @@ struct EditableSplatStore: Sendable {
         var radius: Float
     }
 
-    var points: [SplatScenePoint]
-    var states: [EditableSplatState]
-    var sceneIndices: [UInt32]
+    /// History accounting for one point: the struct plus a degree-3 SH coefficient array
+    static let estimatedPointByteCount = MemoryLayout<SplatScenePoint>.stride + 16 * MemoryLayout<SIMD3<Float>>.stride
+
+    var points: PagedArray<SplatScenePoint>
+    var states: PagedArray<EditableSplatState>
+    var sceneIndices: PagedArray<UInt32>
     private var selectedIndexSet: Set<Int>
 
     init(points: [SplatScenePoint], sceneIndices: [UInt32]? = nil) {
-        self.points = points
-        self.states = Array(repeating: [], count: points.count)
+        self.points = PagedArray(points)
+        self.states = PagedArray(repeating: [], count: points.count)
         self.selectedIndexSet = []
         if let sceneIndices, sceneIndices.count == points.count {
-            self.sceneIndices = sceneIndices
+            self.sceneIndices = PagedArray(sceneIndices)
         } else {
-            self.sceneIndices = Array(repeating: 0, count: points.count)
+            self.sceneIndices = PagedArray(repeating: 0, count: points.count)
         }
     }
 
@@ -487,44 +575,85 @@ struct EditableSplatStore: Sendable {
     }
 
     mutating func duplicateSelection() -> [Int] {
-        let sourceIndices = selectedIndices
-        guard !sourceIndices.isEmpty else { return [] }
+        duplicateSelectionRecordingChanges().map { Array($0.indices) } ?? []
+    }
 
-        let insertionStart = points.count
-        let duplicates = sourceIndices.map { points[$0] }
-        points.append(contentsOf: duplicates)
-        sceneIndices.append(contentsOf: sourceIndices.map { sceneIndices[$0] })
+    /// Duplicates the selection and returns what changed, for `apply(_:)` and `revert(_:)` to replay
+    mutating func duplicateSelectionRecordingChanges() -> EditableSplatAppend? {
+        let sourceIndices = selectedIndices
+        guard !sourceIndices.isEmpty else { return nil }
 
+        var sourceStateChanges: [EditableSplatStateChange] = []
         for index in sourceIndices {
-            states[index].remove(.selected)
+            recordStateChange(at: index, into: &sourceStateChanges) { state in
+                state.remove(.selected)
+            }
         }
 
-        let duplicateStates = sourceIndices.map { index in
-            var state = states[index]
-            state.remove([.hidden, .deleted, .locked, .selected])
-            state.insert(.selected)
-            return state
+        let append = EditableSplatAppend(
+            startIndex: points.count,
+            points: sourceIndices.map { points[$0] },
+            states: sourceIndices.map { index in
+                var state = states[index]
+                state.remove([.hidden, .deleted, .locked, .selected])
+                state.insert(.selected)
+                return state
+            },
+            sceneIndices: sourceIndices.map { sceneIndices[$0] },
+            sourceStateChanges: sourceStateChanges
+        )
+        appendSplats(append)
+        return append
+    }
+
+    /// Redoes a recorded duplication
+    mutating func apply(_ append: EditableSplatAppend) {
+        for change in append.sourceStateChanges {
+            states[change.index] = change.newState
         }
-        states.append(contentsOf: duplicateStates)
+        appendSplats(append)
         rebuildSelectionIndexSet()
+    }
 
-        return Array(insertionStart..<(insertionStart + duplicateStates.count))
+    /// Undoes a recorded duplication; only the appended tail and the source states are touched
+    mutating func revert(_ append: EditableSplatAppend) {
+        let removed = append.startIndex..<points.count
+        points.removeSubrange(removed)
+        states.removeSubrange(removed)
+        sceneIndices.removeSubrange(removed)
+        for change in append.sourceStateChanges {
+            states[change.index] = change.oldState
+        }
+        rebuildSelectionIndexSet()
+    }
+
+    private mutating func appendSplats(_ append: EditableSplatAppend) {
+        points.append(contentsOf: append.points)
+        states.append(contentsOf: append.states)
+        sceneIndices.append(contentsOf: append.sceneIndices)
+        for index in append.indices {
+            selectedIndexSet.insert(index)
+        }
     }
 
     mutating func separateSelection() -> Bool {
         let sourceIndices = selectedIndices
         guard !sourceIndices.isEmpty else { return false }
+        separate(keeping: sourceIndices)
+        return true
+    }
 
-        points = sourceIndices.map { points[$0] }
-        sceneIndices = sourceIndices.map { sceneIndices[$0] }
-        states = sourceIndices.map { index in
+    /// Keeps only `indices`, in order, as a selected, editable scene
+    mutating func separate(keeping indices: [Int]) {
+        points = PagedArray(indices.map { points[$0] })
+        sceneIndices = PagedArray(indices.map { sceneIndices[$0] })
+        states = PagedArray(indices.map { index in
             var state = states[index]
             state.remove([.hidden, .deleted, .locked])
             state.insert(.selected)
             return state
-        }
+        })
         rebuildSelectionIndexSet()
-        return true
     }
 
     mutating func applyStateChanges(_ changes: [EditableSplatStateChange], useNewValues: Bool) {
@@ -540,20 +669,32 @@ struct EditableSplatStore: Sendable {
         }
     }
 
-    func colorMatchIndices(referenceIndex: Int, threshold: Float) -> [Int] {
+    /// Selectable splats whose color is within `threshold` of the reference splat's on every channel; with
+    /// `candidates`, only those are tested
+    func colorMatchIndices<Candidates: Sequence<Int>>(referenceIndex: Int,
+                                                      threshold: Float,
+                                                      among candidates: Candidates) -> [Int] {
         guard points.indices.contains(referenceIndex), isSelectable(referenceIndex) else { return [] }
 
         let clampedThreshold = max(0, min(threshold, 1))
         let reference = points[referenceIndex].color.asLinearFloat
 
-        return points.indices.filter { index in
-            guard isSelectable(index) else { return false }
+        return candidates.filter { index in
+            guard points.indices.contains(index), isSelectable(index) else { return false }
             let color = points[index].color.asLinearFloat
             let delta = simd_abs(color - reference)
             return delta.x <= clampedThreshold && delta.y <= clampedThreshold && delta.z <= clampedThreshold
         }
     }
 
+    func colorMatchIndices(referenceIndex: Int, threshold: Float) -> [Int] {
+        colorMatchIndices(referenceIndex: referenceIndex, threshold: threshold, among: points.indices)
+    }
+
+    /// Neighborhood half-width in grid cells a flood fill step searches; very large footprints reach farther
+    /// through their neighbors instead. Keep in sync with `FloodFillMaxCellRange` in EditorSelection.metal.
+    static let floodFillMaxCellRange = 16
+
     func floodFillIndices(seedIndex: Int,
                           threshold: Float,
                           viewport: SplatRenderer.ViewportDescriptor) -> [Int] {
@@ -582,7 +723,7 @@ struct EditableSplatStore: Sendable {
             result.append(current.index)
 
             let searchRadius = max(current.radius * 2.5, cellSize)
-            let cellRange = max(1, Int(ceil(Double(searchRadius / cellSize))))
+            let cellRange = min(max(1, Int(ceil(Double(searchRadius / cellSize)))), Self.floodFillMaxCellRange)
             let currentCell = Self.gridCell(for: current.normalized, cellSize: cellSize)
 
             for deltaY in -cellRange...cellRange {
@@ -642,15 +783,9 @@ struct EditableSplatStore: Sendable {
             return []
         }
 
-        let clampedVoxelFraction = max(config.voxelFractionOfBounds, 0.001)
-        let clampedScaleInfluence = max(config.scaleInfluence, 0)
         let averageScale = averageRepresentativeScale(for: candidateIndices)
-        let diagonal = simd_length(candidateBounds.max - candidateBounds.min)
-        let unclampedVoxelSize = max(diagonal * clampedVoxelFraction, averageScale * clampedScaleInfluence)
-        let voxelSize = min(
-            max(unclampedVoxelSize, max(config.minimumVoxelSize, 0.0001)),
-            max(config.maximumVoxelSize, config.minimumVoxelSize)
-        )
+        let voxelSize = config.voxelSize(diagonal: simd_length(candidateBounds.max - candidateBounds.min),
+                                         averageScale: averageScale)
 
         var voxels: [VoxelKey: OutlierVoxel] = [:]
         voxels.reserveCapacity(candidateIndices.count)
@@ -670,9 +805,42 @@ struct EditableSplatStore: Sendable {
             voxels[key, default: OutlierVoxel()].indices.append(index)
         }
 
-        guard let peakEntry = voxels.max(by: { lhs, rhs in
+        let subjectVoxels = subjectVoxels(
+            scores: voxels.mapValues { OutlierVoxelScore(score: $0.score, count: $0.indices.count) },
+            config: config
+        )
+        let subjectIndices = Set(subjectVoxels.flatMap { voxels[$0]?.indices ?? [] })
+        guard !subjectIndices.isEmpty else { return [] }
+
+        return candidateIndices.filter { !subjectIndices.contains($0) }
+    }
+
+    /// Outliers from voxels the GPU has already scored: every candidate outside the subject's voxels
+    func outlierIndices(in grid: OutlierVoxelGrid, config: OutlierSelectionConfig) -> [Int] {
+        var scores: [VoxelKey: OutlierVoxelScore] = [:]
+        scores.reserveCapacity(grid.cells.count)
+        for cell in grid.cells {
+            let key = VoxelKey(x: cell.coordinate.x, y: cell.coordinate.y, z: cell.coordinate.z)
+            scores[key] = OutlierVoxelScore(score: cell.score, count: cell.entries.count)
+        }
+
+        let subjectVoxels = subjectVoxels(scores: scores, config: config)
+        guard !subjectVoxels.isEmpty else { return [] }
+
+        var result: [Int] = []
+        for cell in grid.cells
+        where !subjectVoxels.contains(VoxelKey(x: cell.coordinate.x, y: cell.coordinate.y, z: cell.coordinate.z)) {
+            result.append(contentsOf: grid.sortedIndices[cell.entries].lazy.map { Int($0) })
+        }
+        return result
+    }
+
+    /// The densest voxel's core component grown through the annex voxels; empty when nothing qualifies
+    private func subjectVoxels(scores: [VoxelKey: OutlierVoxelScore],
+                               config: OutlierSelectionConfig) -> Set<VoxelKey> {
+        guard let peakEntry = scores.max(by: { lhs, rhs in
             if lhs.value.score == rhs.value.score {
-                return lhs.value.indices.count < rhs.value.indices.count
+                return lhs.value.count < rhs.value.count
             }
             return lhs.value.score < rhs.value.score
         }) else {
@@ -684,7 +852,7 @@ struct EditableSplatStore: Sendable {
         let coreThreshold = peakScore * max(min(config.coreDensityThreshold, 1), 0)
         let annexThreshold = peakScore * max(min(config.annexDensityThreshold, 1), 0)
 
-        let coreVoxels = Set(voxels.compactMap { key, voxel in
+        let coreVoxels = Set(scores.compactMap { key, voxel in
             voxel.score >= coreThreshold ? key : nil
         })
         guard coreVoxels.contains(peakKey) else {
@@ -697,21 +865,16 @@ struct EditableSplatStore: Sendable {
             connectivity: config.connectivity
         )
 
-        let subjectVoxels = connectedVoxelComponent(
+        return connectedVoxelComponent(
             startingFrom: denseCore,
-            eligible: Set(voxels.compactMap { key, voxel in
+            eligible: Set(scores.compactMap { key, voxel in
                 voxel.score >= annexThreshold ? key : nil
             }),
             connectivity: config.connectivity
         )
-
-        let subjectIndices = Set(subjectVoxels.flatMap { voxels[$0]?.indices ?? [] })
-        guard !subjectIndices.isEmpty else { return [] }
-
-        return candidateIndices.filter { !subjectIndices.contains($0) }
     }
 
-    private func isSelectable(_ index: Int) -> Bool {
+    func isSelectable(_ index: Int) -> Bool {
         let state = states[index]
         return !state.contains(.hidden) && !state.contains(.deleted) && !state.contains(.locked)
     }
@@ -814,6 +977,18 @@ struct EditableSplatStore: Sendable {
         )
     }
 
+    /// Whether outlier candidates for `scope` are limited to selected splats
+    func outlierScopeUsesSelection(_ scope: OutlierSelectionScope) -> Bool {
+        switch scope {
+        case .selectionIfAvailable:
+            return selectedIndexSet.contains(where: isSelectable)
+        case .selectionOnly:
+            return true
+        case .visibleOnly:
+            return false
+        }
+    }
+
     private func outlierCandidateIndices(scope: OutlierSelectionScope) -> [Int] {
         switch scope {
         case .selectionIfAvailable:
@@ -932,9 +1107,31 @@ public actor SplatEditor {
     private var transformPalette: [simd_float4x4]
     private var undoStack: [SplatEditHistoryEntry] = []
     private var redoStack: [SplatEditHistoryEntry] = []
+    private var undoByteCounts: [Int] = []
+    private var redoByteCounts: [Int] = []
+
+    public static let defaultHistoryMemoryLimit = 512 << 20
+
+    /// Approximate bytes undo and redo history may hold before the oldest undo steps are dropped. The most recent
+    /// step is always kept.
+    public private(set) var historyMemoryLimit: Int
+
+    public static let defaultGPUSelectionThreshold = 65_536
+
+    /// Scenes with at least this many splats run flood-fill, color-match and outlier selection on the GPU's spatial
+    /// hash; smaller scenes, and devices without the kernels, use the CPU paths
+    public private(set) var gpuSelectionThreshold = SplatEditor.defaultGPUSelectionThreshold
 
-    public init(points: [SplatScenePoint], renderer: SplatRenderer) async throws {
+    /// Approximate bytes held by undo and redo history
+    public var historyByteCount: Int {
+        undoByteCounts.reduce(0, +) + redoByteCounts.reduce(0, +)
+    }
+
+    public init(points: [SplatScenePoint],
+                renderer: SplatRenderer,
+                historyMemoryLimit: Int = SplatEditor.defaultHistoryMemoryLimit) async throws {
         self.renderer = renderer
+        self.historyMemoryLimit = max(historyMemoryLimit, 0)
         self.selectionEngine = try SplatSelectionEngine(device: renderer.device)
         let initialSceneIndices = renderer.animationSceneIndices.count == points.count
             ? renderer.animationSceneIndices
@@ -977,8 +1174,14 @@ public actor SplatEditor {
 
     public func selectOutliers(config: OutlierSelectionConfig = OutlierSelectionConfig(),
                                mode: SelectionCombineMode) async throws {
-        let selected = store.outlierIndices(config: config)
-        let changes = store.applySelection(indices: selected, mode: mode)
+        var selected: [Int]?
+        if usesGPUSelection,
+           let grid = try await selectionEngine.outlierVoxels(config: config,
+                                                              selectionOnly: store.outlierScopeUsesSelection(config.scope),
+                                                              renderer: renderer) {
+            selected = store.outlierIndices(in: grid, config: config)
+        }
+        let changes = store.applySelection(indices: selected ?? store.outlierIndices(config: config), mode: mode)
         try applyStateHistory(changes)
     }
 
@@ -1097,44 +1300,49 @@ public actor SplatEditor {
     }
 
     public func duplicateSelection() async throws {
-        let before = store.snapshot
-        let changedIndices = store.duplicateSelection()
-        guard !changedIndices.isEmpty else { return }
+        try clearPreviewTransformState()
+        guard let append = store.duplicateSelectionRecordingChanges() else { return }
 
-        pushHistory(.snapshot(before))
-        previewTransform = nil
-        try renderer.replaceAllSplats(with: store.points, sceneIndices: store.sceneIndices)
-        previewTransformIndices = Array(repeating: 0, count: store.points.count)
-        previewTransformTouchedIndices = []
-        transformPalette[1] = matrix_identity_float4x4
-        try replaceRendererState()
+        pushHistory(.append(append))
+        try applyAppendToRenderer(append)
     }
 
     public func separateSelection() async throws {
         let before = store.snapshot
+        let keptIndices = store.selectedIndices
         guard store.separateSelection() else { return }
 
-        pushHistory(.snapshot(before))
-        previewTransform = nil
-        try renderer.replaceAllSplats(with: store.points, sceneIndices: store.sceneIndices)
-        previewTransformIndices = Array(repeating: 0, count: store.points.count)
-        previewTransformTouchedIndices = []
-        transformPalette[1] = matrix_identity_float4x4
-        try replaceRendererState()
+        let separation = EditableSplatSeparation(before: before, keptIndices: keptIndices,
+                                                 mortonPermutation: renderer.mortonPermutation)
+        pushHistory(.separation(separation))
+        try replaceRendererScene(mortonPermutation: separation.keptMortonPermutation)
+    }
+
+    public func setHistoryMemoryLimit(_ limit: Int) {
+        historyMemoryLimit = max(limit, 0)
+        trimHistory()
+    }
+
+    public func setGPUSelectionThreshold(_ splatCount: Int) {
+        gpuSelectionThreshold = max(splatCount, 0)
     }
 
     public func undo() async throws {
         guard let entry = undoStack.popLast() else { return }
+        let byteCount = undoByteCounts.popLast() ?? 0
         try clearPreviewTransformState()
         try applyHistoryEntry(entry, useNewValues: false)
         redoStack.append(entry)
+        redoByteCounts.append(byteCount)
     }
 
     public func redo() async throws {
         guard let entry = redoStack.popLast() else { return }
+        let byteCount = redoByteCounts.popLast() ?? 0
         try clearPreviewTransformState()
         try applyHistoryEntry(entry, useNewValues: true)
         undoStack.append(entry)
+        undoByteCounts.append(byteCount)
     }
 
     public func exportVisiblePoints() async throws -> [SplatScenePoint] {
@@ -1155,12 +1363,17 @@ public actor SplatEditor {
             viewport: viewport
         ) else { return }
 
-        let selected = store.floodFillIndices(
-            seedIndex: seedIndex,
-            threshold: threshold,
-            viewport: viewport
+        var selected: [Int]?
+        if usesGPUSelection {
+            selected = try await selectionEngine.floodFill(seedIndex: seedIndex,
+                                                           threshold: threshold,
+                                                           viewport: viewport,
+                                                           renderer: renderer)
+        }
+        let changes = store.applySelection(
+            indices: selected ?? store.floodFillIndices(seedIndex: seedIndex, threshold: threshold, viewport: viewport),
+            mode: mode
         )
-        let changes = store.applySelection(indices: selected, mode: mode)
         try applyStateHistory(changes)
     }
 
@@ -1174,11 +1387,28 @@ public actor SplatEditor {
             viewport: viewport
         ) else { return }
 
-        let selected = store.colorMatchIndices(referenceIndex: referenceIndex, threshold: threshold)
-        let changes = store.applySelection(indices: selected, mode: mode)
+        var selected: [Int]?
+        if usesGPUSelection, !store.isSelectable(referenceIndex) {
+            selected = []
+        } else if usesGPUSelection,
+                  let candidates = try await selectionEngine.colorMatch(reference: store.points[referenceIndex].color.asLinearFloat,
+                                                                        threshold: threshold,
+                                                                        renderer: renderer) {
+            // The GPU tests 8-bit stored colors conservatively; the exact test runs on its candidates
+            selected = store.colorMatchIndices(referenceIndex: referenceIndex, threshold: threshold,
+                                               among: candidates.sorted())
+        }
+        let changes = store.applySelection(
+            indices: selected ?? store.colorMatchIndices(referenceIndex: referenceIndex, threshold: threshold),
+            mode: mode
+        )
         try applyStateHistory(changes)
     }
 
+    private var usesGPUSelection: Bool {
+        store.points.count >= gpuSelectionThreshold
+    }
+
     public func pickPoint(normalized: SIMD2<Float>,
                           radius: Float,
                           viewport: SplatRenderer.ViewportDescriptor) async throws -> SplatScenePoint? {
@@ -1202,7 +1432,24 @@ public actor SplatEditor {
 
     private func pushHistory(_ entry: SplatEditHistoryEntry) {
         undoStack.append(entry)
+        undoByteCounts.append(entry.estimatedByteCount(relativeTo: store))
         redoStack.removeAll(keepingCapacity: true)
+        redoByteCounts.removeAll(keepingCapacity: true)
+        trimHistory()
+    }
+
+    /// Drops the oldest undo steps, then redo steps furthest from the present, until history fits the limit
+    private func trimHistory() {
+        var total = historyByteCount
+        while total > historyMemoryLimit, undoStack.count + redoStack.count > 1 {
+            if !undoStack.isEmpty {
+                undoStack.removeFirst()
+                total -= undoByteCounts.removeFirst()
+            } else {
+                redoStack.removeFirst()
+                total -= redoByteCounts.removeFirst()
+            }
+        }
     }
 
     private func applyStateHistory(_ changes: [EditableSplatStateChange]) throws {
@@ -1217,6 +1464,25 @@ public actor SplatEditor {
         try renderer.updateSplats(store.points, at: changes.map(\.index))
     }
 
+    /// Appends a duplication's splats on the GPU and patches the edit states it touched
+    private func applyAppendToRenderer(_ append: EditableSplatAppend) throws {
+        try renderer.appendEditedSplats(append.points, sceneIndices: append.sceneIndices)
+        previewTransformIndices.append(contentsOf: repeatElement(0, count: append.points.count))
+        let changedIndices = append.sourceStateChanges.map(\.index) + Array(append.indices)
+        try renderer.updateEditStates(at: changedIndices, values: changedIndices.map { store.states[$0].rawValue })
+    }
+
+    /// Re-uploads the whole scene after a structural edit; `mortonPermutation` maps the new scene to load order
+    private func replaceRendererScene(mortonPermutation: [UInt32]?) throws {
+        previewTransform = nil
+        try renderer.replaceAllSplats(with: Array(store.points), sceneIndices: Array(store.sceneIndices),
+                                      mortonPermutation: mortonPermutation)
+        previewTransformIndices = Array(repeating: 0, count: store.points.count)
+        previewTransformTouchedIndices = []
+        transformPalette[1] = matrix_identity_float4x4
+        try replaceRendererState()
+    }
+
     private func applyHistoryEntry(_ entry: SplatEditHistoryEntry, useNewValues: Bool) throws {
         switch entry {
         case .states(let changes):
@@ -1226,14 +1492,25 @@ public actor SplatEditor {
         case .points(let changes):
             store.applyPointChanges(changes, useNewValues: useNewValues)
             try renderer.updateSplats(store.points, at: changes.map(\.index))
-        case .snapshot(let snapshot):
-            store.restore(snapshot)
-            previewTransform = nil
-            previewTransformIndices = Array(repeating: 0, count: store.points.count)
-            previewTransformTouchedIndices = []
-            transformPalette[1] = matrix_identity_float4x4
-            try renderer.replaceAllSplats(with: store.points, sceneIndices: store.sceneIndices)
-            try replaceRendererState()
+        case .append(let append):
+            if useNewValues {
+                store.apply(append)
+                try applyAppendToRenderer(append)
+            } else {
+                store.revert(append)
+                try renderer.removeTrailingSplats(from: append.startIndex)
+                previewTransformIndices.removeSubrange(append.startIndex...)
+                let sourceIndices = append.sourceStateChanges.map(\.index)
+                try renderer.updateEditStates(at: sourceIndices, values: append.sourceStateChanges.map(\.oldState.rawValue))
+            }
+        case .separation(let separation):
+            store.restore(separation.before)
+            if useNewValues {
+                store.separate(keeping: separation.keptIndices)
+            }
+            try replaceRendererScene(mortonPermutation: useNewValues
+                                     ? separation.keptMortonPermutation
+                                     : separation.mortonPermutation)
         }
     }
 
@@ -0,0 +1,367 @@
+import Foundation
+import Metal
+import simd
+
+/// The transforms of an instanced scene and the (instance, splat) order it is drawn in
+///
+/// Every instance draws the renderer's one `Splat` buffer, so an instance costs a 64-byte transform rather than a
+/// copy of the splats. The order is a single back-to-front sort across all visible instances, so overlapping
+/// instances blend correctly: `computeInstancedSplatDistances` writes a distance per (visible instance, kept
+/// splat) pair, MPS argsorts them, and `remapInstancedSortKeys` turns the result into the keys the instanced
+/// vertex shader reads (InstancedRenderPath.metal). Pairs are compacted before the argsort: each visible instance
+/// owns `ceil(splatCount / lodStride)` consecutive slots, so frustum culling and the LOD stride shrink what is
+/// written and sorted, and sort memory grows with the kept pairs only. `fittingSortBudget` bounds that when many
+/// instances are close. Like the packed store, the order is re-sorted in the frame's command buffer, ahead of the
+/// draw that reads it.
+internal final class SplatInstanceSet {
+
+    /// A visible instance and the stride of its LOD: it keeps every `lodStride`-th splat
+    /// Keep in sync with ComputeDistances.metal : visibleInstances (uint2)
+    struct VisibleInstance: Equatable {
+        var instance: UInt32
+        var lodStride: UInt32
+    }
+
+    /// Coarsest LOD stride; an instance never drops below 1/16 of its splats
+    static let maximumLODStride: UInt32 = 16
+
+    /// Sort buffer bytes per kept pair: its distance and its key
+    static let sortBytesPerPair = MemoryLayout<Float>.stride + MemoryLayout<Int32>.stride
+
+    private(set) var transforms: [simd_float4x4]
+    /// `transforms`, bound at `BufferIndexInstanceTransforms`. Replaced rather than rewritten on update, so draws
+    /// still in flight keep the buffer they were encoded with.
+    private(set) var transformBuffer: MTLBuffer
+
+    /// Back-to-front (instance, splat) keys from the last sort; the first `drawKeyCount` are drawn
+    private(set) var sortedKeyBuffer: MTLBuffer?
+    private(set) var drawKeyCount = 0
+    /// The instances the last sort kept, with their LOD strides
+    private(set) var sortedVisibleInstances: [VisibleInstance] = []
+    /// Set once the renderer has warned that the visible instances were coarsened to fit the sort budget
+    var reportedSortBudgetOverflow = false
+
+    /// Built on first draw; cleared with the renderer's other pipeline states
+    var pipelineState: MTLRenderPipelineState?
+    var editingPipelineState: MTLRenderPipelineState?
+    var depthState: MTLDepthStencilState?
+
+    private struct SortInputs {
+        var cameraPosition: SIMD3<Float>
+        var cameraForward: SIMD3<Float>
+        var sortByDistance: Bool
+        var visibleInstances: [VisibleInstance]
+        var transformGeneration: UInt64
+        var dataRevision: UInt64
+        var splatCount: Int
+    }
+
+    private let device: MTLDevice
+    private let distancePipeline: MTLComputePipelineState
+    private let remapPipeline: MTLComputePipelineState
+    private let argSort = MPSArgSort(dataType: .float32, descending: true)
+    private var distanceBuffer: MTLBuffer?
+    private var transformGeneration: UInt64 = 0
+    private var lastSortInputs: SortInputs?
+
+    init(device: MTLDevice, library: MTLLibrary, transforms: [simd_float4x4]) throws {
+        self.device = device
+        self.transforms = transforms
+        self.transformBuffer = try Self.makeTransformBuffer(transforms, device: device)
+        distancePipeline = try Self.makeComputePipeline("computeInstancedSplatDistances", device: device, library: library)
+        remapPipeline = try Self.makeComputePipeline("remapInstancedSortKeys", device: device, library: library)
+    }
+
+    func updateTransforms(_ transforms: [simd_float4x4]) throws {
+        transformBuffer = try Self.makeTransformBuffer(transforms, device: device)
+        self.transforms = transforms
+        transformGeneration &+= 1
+    }
+
+    /// Most instances of `splatCount` splats whose keys still fit the Int32 sorted-index buffer
+    static func maximumInstanceCount(splatCount: Int) -> Int {
+        Int(Int32.max) / max(splatCount, 1)
+    }
+
+    // MARK: - Culling and LOD
+
+    /// The instances whose transformed `bounds` reach the view, each with its LOD stride
+    ///
+    /// The stride is the largest power of two (up to `maximumLODStride`) that keeps at least `splatsPerPixel`
+    /// splats per pixel of the instance's projected bounding sphere. Distant instances draw far more splats
+    /// than they cover pixels, so thinning them is cheap in image terms. A `splatsPerPixel` of zero, or a
+    /// `projectionScale` of zero (orthographic views), disables it.
+    /// - Parameters:
+    ///   - viewProjections: Culls instances entirely outside a side plane, or behind the camera, of every view;
+    ///     empty keeps all
+    ///   - projectionScale: Pixels per unit of `radius / distance`, screen height × projection[1][1] / 2
+    static func visibleInstances(transforms: [simd_float4x4],
+                                 bounds: (min: SIMD3<Float>, max: SIMD3<Float>),
+                                 viewProjections: [simd_float4x4],
+                                 cameraPosition: SIMD3<Float>,
+                                 projectionScale: Float,
+                                 splatCount: Int,
+                                 splatsPerPixel: Float) -> [VisibleInstance] {
+        let corners = (0..<8).map { corner in
+            SIMD4<Float>(corner & 1 == 0 ? bounds.min.x : bounds.max.x,
+                         corner & 2 == 0 ? bounds.min.y : bounds.max.y,
+                         corner & 4 == 0 ? bounds.min.z : bounds.max.z,
+                         1)
+        }
+        let localCenter = SIMD4<Float>((bounds.min + bounds.max) * 0.5, 1)
+        let localRadius = simd_length(bounds.max - bounds.min) * 0.5
+
+        var visible: [VisibleInstance] = []
+        visible.reserveCapacity(transforms.count)
+        for (index, transform) in transforms.enumerated() {
+            if !viewProjections.isEmpty,
+               !viewProjections.contains(where: { intersectsFrustum(corners: corners, clipTransform: $0 * transform) }) {
+                continue
+            }
+            let center = transform * localCenter
+            let scale = max(simd_length(transform.columns.0.xyz),
+                            simd_length(transform.columns.1.xyz),
+                            simd_length(transform.columns.2.xyz))
+            let stride = lodStride(splatCount: splatCount,
+                                   radius: localRadius * scale,
+                                   distance: simd_distance(center.xyz, cameraPosition),
+                                   projectionScale: projectionScale,
+                                   splatsPerPixel: splatsPerPixel)
+            visible.append(VisibleInstance(instance: UInt32(index), lodStride: stride))
+        }
+        return visible
+    }
+
+    static func lodStride(splatCount: Int,
+                          radius: Float,
+                          distance: Float,
+                          projectionScale: Float,
+                          splatsPerPixel: Float) -> UInt32 {
+        guard splatsPerPixel > 0, projectionScale > 0, distance > radius, radius > 0 else { return 1 }
+        let projectedRadius = radius * projectionScale / distance
+        let coveredPixels = max(Float.pi * projectedRadius * projectedRadius, 1)
+        let excess = Float(splatCount) / (coveredPixels * splatsPerPixel)
+        var stride: UInt32 = 1
+        while stride < maximumLODStride && Float(stride * 2) <= excess {
+            stride *= 2
+        }
+        return stride
+    }
+
+    /// Pairs an instance keeps at `lodStride`: every `lodStride`-th splat, starting with the first
+    static func keptPairCount(splatCount: Int, lodStride: UInt32) -> Int {
+        let stride = Int(max(lodStride, 1))
+        return (splatCount + stride - 1) / stride
+    }
+
+    /// Start of each visible instance's slots in the compacted pair order, followed by the total pair count
+    static func pairOffsets(_ visibleInstances: [VisibleInstance], splatCount: Int) -> [UInt32] {
+        var offsets: [UInt32] = [0]
+        offsets.reserveCapacity(visibleInstances.count + 1)
+        var total = 0
+        for visible in visibleInstances {
+            total += keptPairCount(splatCount: splatCount, lodStride: visible.lodStride)
+            offsets.append(UInt32(total))
+        }
+        return offsets
+    }
+
+    /// `visibleInstances` trimmed to sort at most `maximumPairCount` pairs: every stride below `maximumLODStride`
+    /// doubles until the pairs fit, then trailing instances are dropped, as when keys overflow Int32
+    static func fittingSortBudget(_ visibleInstances: [VisibleInstance],
+                                  splatCount: Int,
+                                  maximumPairCount: Int) -> [VisibleInstance] {
+        func pairCount(_ instances: [VisibleInstance]) -> Int {
+            instances.reduce(0) { $0 + keptPairCount(splatCount: splatCount, lodStride: $1.lodStride) }
+        }
+
+        var instances = visibleInstances
+        var total = pairCount(instances)
+        while total > maximumPairCount, instances.contains(where: { $0.lodStride < maximumLODStride }) {
+            for index in instances.indices where instances[index].lodStride < maximumLODStride {
+                instances[index].lodStride *= 2
+            }
+            total = pairCount(instances)
+        }
+        while total > maximumPairCount, let last = instances.popLast() {
+            total -= keptPairCount(splatCount: splatCount, lodStride: last.lodStride)
+        }
+        return instances
+    }
+
+    /// False when all corners lie outside one side plane of the clip volume, or behind the camera
+    private static func intersectsFrustum(corners: [SIMD4<Float>], clipTransform: simd_float4x4) -> Bool {
+        var outside = (left: true, right: true, bottom: true, top: true, behind: true)
+        for corner in corners {
+            let clip = clipTransform * corner
+            outside.left = outside.left && clip.x < -clip.w
+            outside.right = outside.right && clip.x > clip.w
+            outside.bottom = outside.bottom && clip.y < -clip.w
+            outside.top = outside.top && clip.y > clip.w
+            outside.behind = outside.behind && clip.w <= 0
+        }
+        return !(outside.left || outside.right || outside.bottom || outside.top || outside.behind)
+    }
+
+    // MARK: - Sorting
+
+    /// Encodes the (instance, splat) sort into `commandBuffer`, unless the visible instances, transforms and
+    /// splats are unchanged and the camera is (nearly) where the last sort was made from
+    func encodeSortIfNeeded(commandBuffer: MTLCommandBuffer,
+                            splatBuffer: MTLBuffer,
+                            editStateBuffer: MTLBuffer?,
+                            splatCount: Int,
+                            dataRevision: UInt64,
+                            visibleInstances: [VisibleInstance],
+                            cameraPosition: SIMD3<Float>,
+                            cameraForward: SIMD3<Float>,
+                            sortByDistance: Bool,
+                            positionEpsilon: Float,
+                            directionEpsilon: Float) throws {
+        let inputs = SortInputs(cameraPosition: cameraPosition,
+                                cameraForward: cameraForward,
+                                sortByDistance: sortByDistance,
+                                visibleInstances: visibleInstances,
+                                transformGeneration: transformGeneration,
+                                dataRevision: dataRevision,
+                                splatCount: splatCount)
+        if let lastSortInputs,
+           lastSortInputs.sortByDistance == sortByDistance,
+           lastSortInputs.visibleInstances == visibleInstances,
+           lastSortInputs.transformGeneration == transformGeneration,
+           lastSortInputs.dataRevision == dataRevision,
+           lastSortInputs.splatCount == splatCount,
+           simd_distance_squared(lastSortInputs.cameraPosition, cameraPosition) <= positionEpsilon * positionEpsilon,
+           1 - simd_dot(lastSortInputs.cameraForward, cameraForward) <= directionEpsilon {
+            return
+        }
+
+        let pairOffsets = Self.pairOffsets(visibleInstances, splatCount: splatCount)
+        let pairCount = Int(pairOffsets.last ?? 0)
+        guard pairCount > 0 else {
+            drawKeyCount = 0
+            sortedVisibleInstances = visibleInstances
+            lastSortInputs = inputs
+            return
+        }
+
+        let distanceBuffer = try buffer(&self.distanceBuffer, count: pairCount, of: Float.self, label: "Instanced Sort Distances")
+        let sortedKeyBuffer = try buffer(&self.sortedKeyBuffer, count: pairCount, of: Int32.self, label: "Instanced Sorted Keys")
+        // A fresh buffer per sort: the previous frame's remap may still be reading the last one
+        let visibleLength = visibleInstances.count * MemoryLayout<VisibleInstance>.stride
+        guard let visibleBuffer = visibleInstances.withUnsafeBytes({ raw in
+            device.makeBuffer(bytes: raw.baseAddress!, length: visibleLength, options: .storageModeShared)
+        }) else {
+            throw SplatRendererError.failedToCreateBuffer(length: visibleLength)
+        }
+        visibleBuffer.label = "Visible Splat Instances"
+        let offsetsLength = pairOffsets.count * MemoryLayout<UInt32>.stride
+        guard let offsetsBuffer = pairOffsets.withUnsafeBytes({ raw in
+            device.makeBuffer(bytes: raw.baseAddress!, length: offsetsLength, options: .storageModeShared)
+        }) else {
+            throw SplatRendererError.failedToCreateBuffer(length: offsetsLength)
+        }
+        offsetsBuffer.label = "Visible Splat Instance Pair Offsets"
+        let widestInstance = visibleInstances.map {
+            Self.keptPairCount(splatCount: splatCount, lodStride: $0.lodStride)
+        }.max() ?? 0
+
+        var cameraPositionValue = cameraPosition
+        var cameraForwardValue = cameraForward
+        var sortByDistanceValue = sortByDistance
+        var splatCountValue = UInt32(splatCount)
+        var visibleCountValue = UInt32(visibleInstances.count)
+        var keyCountValue = UInt32(pairCount)
+
+        guard let distanceEncoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        distanceEncoder.label = "Instanced Sort Distances"
+        distanceEncoder.setComputePipelineState(distancePipeline)
+        distanceEncoder.setBuffer(splatBuffer, offset: 0, index: 0)
+        distanceEncoder.setBuffer(distanceBuffer, offset: 0, index: 1)
+        distanceEncoder.setBuffer(editStateBuffer, offset: 0, index: 2)
+        distanceEncoder.setBytes(&cameraPositionValue, length: MemoryLayout<SIMD3<Float>>.size, index: 3)
+        distanceEncoder.setBytes(&cameraForwardValue, length: MemoryLayout<SIMD3<Float>>.size, index: 4)
+        distanceEncoder.setBytes(&sortByDistanceValue, length: MemoryLayout<Bool>.size, index: 5)
+        distanceEncoder.setBytes(&splatCountValue, length: MemoryLayout<UInt32>.size, index: 6)
+        distanceEncoder.setBuffer(transformBuffer, offset: 0, index: 7)
+        distanceEncoder.setBuffer(visibleBuffer, offset: 0, index: 8)
+        distanceEncoder.setBytes(&visibleCountValue, length: MemoryLayout<UInt32>.size, index: 9)
+        distanceEncoder.setBuffer(offsetsBuffer, offset: 0, index: 10)
+        distanceEncoder.dispatchThreadgroups(MTLSize(width: (widestInstance + 255) / 256, height: visibleInstances.count, depth: 1),
+                                             threadsPerThreadgroup: MTLSize(width: 256, height: 1, depth: 1))
+        distanceEncoder.endEncoding()
+
+        argSort.encode(commandBuffer: commandBuffer, input: distanceBuffer, output: sortedKeyBuffer, count: pairCount)
+
+        guard let remapEncoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        remapEncoder.label = "Instanced Sort Keys"
+        remapEncoder.setComputePipelineState(remapPipeline)
+        remapEncoder.setBuffer(sortedKeyBuffer, offset: 0, index: 0)
+        remapEncoder.setBuffer(distanceBuffer, offset: 0, index: 1)
+        remapEncoder.setBuffer(visibleBuffer, offset: 0, index: 2)
+        remapEncoder.setBytes(&splatCountValue, length: MemoryLayout<UInt32>.size, index: 3)
+        remapEncoder.setBytes(&keyCountValue, length: MemoryLayout<UInt32>.size, index: 4)
+        remapEncoder.setBuffer(offsetsBuffer, offset: 0, index: 5)
+        remapEncoder.setBytes(&visibleCountValue, length: MemoryLayout<UInt32>.size, index: 6)
+        remapEncoder.dispatchThreadgroups(MTLSize(width: (pairCount + 255) / 256, height: 1, depth: 1),
+                                          threadsPerThreadgroup: MTLSize(width: 256, height: 1, depth: 1))
+        remapEncoder.endEncoding()
+
+        // Hidden splats among the kept pairs sort last as -1 keys, which the vertex shader culls
+        drawKeyCount = pairCount
+        sortedVisibleInstances = visibleInstances
+        lastSortInputs = inputs
+    }
+
+    // MARK: - Buffers
+
+    private func buffer<T>(_ storage: inout MTLBuffer?, count: Int, of _: T.Type, label: String) throws -> MTLBuffer {
+        let length = count * MemoryLayout<T>.stride
+        if let storage, storage.length >= length {
+            return storage
+        }
+        // Grow with headroom so a few more visible instances don't reallocate every frame
+        let grownLength = length + length / 4
+        guard let newBuffer = device.makeBuffer(length: grownLength, options: .storageModePrivate) else {
+            throw SplatRendererError.failedToCreateBuffer(length: grownLength)
+        }
+        newBuffer.label = label
+        storage = newBuffer
+        return newBuffer
+    }
+
+    private static func makeTransformBuffer(_ transforms: [simd_float4x4], device: MTLDevice) throws -> MTLBuffer {
+        let length = max(transforms.count, 1) * MemoryLayout<simd_float4x4>.stride
+        let buffer = transforms.isEmpty
+            ? device.makeBuffer(length: length, options: .storageModeShared)
+            : transforms.withUnsafeBytes { raw in
+                device.makeBuffer(bytes: raw.baseAddress!, length: length, options: .storageModeShared)
+            }
+        guard let buffer else {
+            throw SplatRendererError.failedToCreateBuffer(length: length)
+        }
+        buffer.label = "Splat Instance Transforms"
+        return buffer
+    }
+
+    private static func makeComputePipeline(_ name: String,
+                                            device: MTLDevice,
+                                            library: MTLLibrary) throws -> MTLComputePipelineState {
+        guard let function = library.makeFunction(name: name) else {
+            throw SplatRendererError.failedToLoadShaderFunction(name: name)
+        }
+        do {
+            return try device.makeComputePipelineState(function: function)
+        } catch {
+            throw SplatRendererError.failedToCreateComputePipelineState(functionName: name, underlying: error)
+        }
+    }
+}
+
+private extension SIMD4 where Scalar == Float {
+    var xyz: SIMD3<Float> { SIMD3(x, y, z) }
+}
@@ -217,6 +217,16 @@ public class SplatOctree {
         Self.log.debug("Node \(nodeID) marked for potential unload")
     }
 
+    /// LOD level chosen for a node by the last visibility update (screen-space error based)
+    public func selectedLOD(for nodeID: String) -> Int? {
+        nodeState[nodeID]?.selectedLOD
+    }
+
+    /// Whether a node passed frustum culling in the last visibility update
+    public func isVisible(nodeID: String) -> Bool {
+        nodeState[nodeID]?.isVisible ?? false
+    }
+
     /// Returns nodes that should be loaded based on current visibility
     public func getLoadQueue() -> [String] {
         var queue: [String] = []
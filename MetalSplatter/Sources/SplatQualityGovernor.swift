@@ -0,0 +1,325 @@
+import Foundation
+import os
+
+/// Holds a target frame time by stepping `SplatRenderer` through a ladder of progressively cheaper quality levels.
+///
+/// Each frame the renderer reports its GPU time, plus the GPU time of sorts that completed since the last frame,
+/// and its CPU encode time. The larger of the two is smoothed into `measuredFrameTime`, and a few times a second it
+/// is compared with `targetFrameTime`:
+/// - Over budget by `downgradeThreshold`: move one level down the ladder, at most once per `downgradeCooldown`
+/// - Under budget by `upgradeThreshold`: move one level up, at most once per upgrade cooldown. An upgrade that is
+///   undone by a quick downgrade doubles the cooldown (up to `maximumUpgradeCooldown`), so the governor settles
+///   instead of oscillating
+/// - Thermal pressure sets a floor: `.fair` keeps at least level 1, `.serious` level 2, `.critical` the last level
+///
+/// Level settings overlay the renderer's own knobs (`minimumSortInterval`, `sortPositionEpsilon`,
+/// `shDirectionEpsilon`, `lodMaxScreenSpaceError`, `covarianceBlur`, `highQualityDepth`,
+/// `useDitheredTransparency`) without overwriting them, so taking the governor off restores exactly what was set.
+/// Every level change is recorded as a `Decision` for diagnostics. Reporting and the tunables are thread-safe, so
+/// they may be changed while the governor is attached; command buffer completion handlers call in from Metal's threads.
+public final class SplatQualityGovernor: @unchecked Sendable {
+    private static let log = Logger(subsystem: Bundle.module.bundleIdentifier ?? "com.metalsplatter.unknown",
+                                    category: "SplatQualityGovernor")
+
+    /// Knob values for one level. Intervals are in target frames, scales multiply the renderer's configured value.
+    public struct Settings: Equatable, Sendable {
+        /// Camera-driven resorts start at most once per this many frames
+        public var sortIntervalFrames: Int = 0
+        /// Multiplies `sortPositionEpsilon` and `sortDirectionEpsilon`
+        public var sortEpsilonScale: Float = 1
+        /// Camera-driven SH re-evaluation runs at most once per this many frames
+        public var shUpdateIntervalFrames: Int = 0
+        /// Multiplies `shDirectionEpsilon`
+        public var shDirectionEpsilonScale: Float = 1
+        /// Multiplies `lodMaxScreenSpaceError`; larger values select coarser GPU LOD nodes
+        public var lodScreenSpaceErrorScale: Float = 1
+        /// Multiplies `covarianceBlur`; smaller footprints cut fill rate at the cost of some aliasing
+        public var covarianceBlurScale: Float = 1
+        /// Draws with the single-stage pipeline even when `highQualityDepth` asks for multi-stage depth
+        public var singleStageDepth: Bool = false
+        /// Draws with order-independent dithered transparency, which needs no sorting
+        public var ditheredTransparency: Bool = false
+
+        public init(sortIntervalFrames: Int = 0,
+                    sortEpsilonScale: Float = 1,
+                    shUpdateIntervalFrames: Int = 0,
+                    shDirectionEpsilonScale: Float = 1,
+                    lodScreenSpaceErrorScale: Float = 1,
+                    covarianceBlurScale: Float = 1,
+                    singleStageDepth: Bool = false,
+                    ditheredTransparency: Bool = false) {
+            self.sortIntervalFrames = sortIntervalFrames
+            self.sortEpsilonScale = sortEpsilonScale
+            self.shUpdateIntervalFrames = shUpdateIntervalFrames
+            self.shDirectionEpsilonScale = shDirectionEpsilonScale
+            self.lodScreenSpaceErrorScale = lodScreenSpaceErrorScale
+            self.covarianceBlurScale = covarianceBlurScale
+            self.singleStageDepth = singleStageDepth
+            self.ditheredTransparency = ditheredTransparency
+        }
+
+        /// The renderer's own configuration, unchanged
+        public static let full = Settings()
+
+        /// Full quality, then sorting and SH evaluation relaxed towards interaction-mode values, then single-stage
+        /// depth and coarser LOD, then smaller footprints, then dithered transparency
+        public static func defaultLadder(allowsDitheredTransparency: Bool = true) -> [Settings] {
+            [
+                .full,
+                Settings(sortIntervalFrames: 2, sortEpsilonScale: 2,
+                         shUpdateIntervalFrames: 2, shDirectionEpsilonScale: 2,
+                         lodScreenSpaceErrorScale: 1.5),
+                Settings(sortIntervalFrames: 3, sortEpsilonScale: 5,
+                         shUpdateIntervalFrames: 4, shDirectionEpsilonScale: 4,
+                         lodScreenSpaceErrorScale: 2, singleStageDepth: true),
+                Settings(sortIntervalFrames: 4, sortEpsilonScale: 10,
+                         shUpdateIntervalFrames: 8, shDirectionEpsilonScale: 8,
+                         lodScreenSpaceErrorScale: 3, covarianceBlurScale: 0.5, singleStageDepth: true),
+                Settings(sortIntervalFrames: 6, sortEpsilonScale: 10,
+                         shUpdateIntervalFrames: 12, shDirectionEpsilonScale: 8,
+                         lodScreenSpaceErrorScale: 4, covarianceBlurScale: 0.5, singleStageDepth: true,
+                         ditheredTransparency: allowsDitheredTransparency)
+            ]
+        }
+    }
+
+    public struct Decision: Sendable {
+        public enum Reason: Sendable, Equatable {
+            case overBudget
+            case underBudget
+            case thermal(ProcessInfo.ThermalState)
+            case levelFloor
+        }
+
+        public let previousLevel: Int
+        public let level: Int
+        public let reason: Reason
+        /// Smoothed frame cost when the decision was made
+        public let measuredFrameTime: TimeInterval
+        public let targetFrameTime: TimeInterval
+        public let thermalState: ProcessInfo.ThermalState
+        public let time: CFAbsoluteTime
+    }
+
+    public let ladder: [Settings]
+
+    /// Frame time to hold: 1/60, 1/90 or 1/120 for the common display rates
+    public var targetFrameTime: TimeInterval {
+        get { withLock { _targetFrameTime } }
+        set { withLock { _targetFrameTime = max(newValue, 1e-4) } }
+    }
+
+    /// Levels better than this are off limits; callers raise it to cap quality (`ARSplatRenderer` does while
+    /// tracking is poor)
+    public var levelFloor: Int {
+        get { withLock { _levelFloor } }
+        set { withLock { _levelFloor = min(max(newValue, 0), ladder.count - 1) } }
+    }
+
+    /// Fraction over `targetFrameTime` that triggers a downgrade
+    public var downgradeThreshold: Double {
+        get { withLock { _downgradeThreshold } }
+        set { withLock { _downgradeThreshold = newValue } }
+    }
+
+    /// Fraction of `targetFrameTime` the frame cost must fall under before an upgrade
+    public var upgradeThreshold: Double {
+        get { withLock { _upgradeThreshold } }
+        set { withLock { _upgradeThreshold = newValue } }
+    }
+
+    public var downgradeCooldown: TimeInterval {
+        get { withLock { _downgradeCooldown } }
+        set { withLock { _downgradeCooldown = max(newValue, 0) } }
+    }
+
+    public var upgradeCooldown: TimeInterval {
+        get { withLock { _upgradeCooldown } }
+        set { withLock { _upgradeCooldown = max(newValue, 0) } }
+    }
+
+    public var maximumUpgradeCooldown: TimeInterval {
+        get { withLock { _maximumUpgradeCooldown } }
+        set { withLock { _maximumUpgradeCooldown = max(newValue, 0) } }
+    }
+
+    /// Seconds between budget checks
+    public var evaluationInterval: TimeInterval {
+        get { withLock { _evaluationInterval } }
+        set { withLock { _evaluationInterval = max(newValue, 0) } }
+    }
+
+    /// Frames measured at the current level before it is judged
+    public var minimumSamples: Int {
+        get { withLock { _minimumSamples } }
+        set { withLock { _minimumSamples = max(newValue, 0) } }
+    }
+
+    /// Called with each decision, on the thread that reported the frame, after the governor's lock is released
+    public var onDecision: (@Sendable (Decision) -> Void)? {
+        get { withLock { _onDecision } }
+        set { withLock { _onDecision = newValue } }
+    }
+
+    private let thermalStateProvider: @Sendable () -> ProcessInfo.ThermalState
+    private let lock = NSLock()
+    private var _targetFrameTime: TimeInterval
+    private var _levelFloor = 0
+    private var _downgradeThreshold: Double = 1.05
+    private var _upgradeThreshold: Double = 0.7
+    private var _downgradeCooldown: TimeInterval = 0.5
+    private var _upgradeCooldown: TimeInterval = 2
+    private var _maximumUpgradeCooldown: TimeInterval = 32
+    private var _evaluationInterval: TimeInterval = 0.25
+    private var _minimumSamples = 8
+    private var _onDecision: (@Sendable (Decision) -> Void)?
+    private var _level = 0
+    private var _measuredFrameTime: TimeInterval = 0
+    private var samples = 0
+    private var pendingSortTime: TimeInterval = 0
+    private var lastEvaluationTime: CFAbsoluteTime = 0
+    private var lastChangeTime: CFAbsoluteTime = 0
+    private var lastUpgradeTime: CFAbsoluteTime?
+    private var currentUpgradeCooldown: TimeInterval?
+    private var _generation: UInt64 = 0
+    private var decisions: [Decision] = []
+    private static let decisionCapacity = 64
+
+    /// - Parameters:
+    ///   - targetFrameRate: Rate to hold, such as 60, 90 or 120
+    ///   - ladder: Settings per level, best first; defaults to `Settings.defaultLadder()`
+    ///   - thermalStateProvider: Source of the thermal state; the process's by default
+    public init(targetFrameRate: Double,
+                ladder: [Settings] = Settings.defaultLadder(),
+                thermalStateProvider: @escaping @Sendable () -> ProcessInfo.ThermalState = { ProcessInfo.processInfo.thermalState }) {
+        self._targetFrameTime = 1 / max(targetFrameRate, 1)
+        self.ladder = ladder.isEmpty ? [.full] : ladder
+        self.thermalStateProvider = thermalStateProvider
+    }
+
+    /// Current index into `ladder`; 0 is full quality
+    public var level: Int { withLock { _level } }
+
+    public var settings: Settings { withLock { ladder[_level] } }
+
+    /// Smoothed per-frame cost at the current level
+    public var measuredFrameTime: TimeInterval { withLock { _measuredFrameTime } }
+
+    /// Level changes, oldest first (the last 64)
+    public func recentDecisions() -> [Decision] {
+        withLock { decisions }
+    }
+
+    /// Bumped on every level change so the renderer can apply settings once per change
+    internal var generation: UInt64 { withLock { _generation } }
+
+    /// Adds GPU time spent sorting; it is charged to the next reported frame
+    public func recordSort(gpuTime: TimeInterval) {
+        guard gpuTime > 0 else { return }
+        withLock { pendingSortTime += gpuTime }
+    }
+
+    /// Reports one frame and re-evaluates the level when an evaluation is due
+    /// - Parameters:
+    ///   - gpuTime: GPU time of the frame's render command buffer, if known
+    ///   - cpuTime: CPU time spent encoding the frame
+    public func recordFrame(gpuTime: TimeInterval?, cpuTime: TimeInterval, at now: CFAbsoluteTime = CFAbsoluteTimeGetCurrent()) {
+        let (decision, onDecision): (Decision?, (@Sendable (Decision) -> Void)?) = withLock {
+            let cost = max((gpuTime ?? 0) + pendingSortTime, cpuTime)
+            pendingSortTime = 0
+            if samples == 0 {
+                _measuredFrameTime = cost
+            } else {
+                _measuredFrameTime += (cost - _measuredFrameTime) * 0.1
+            }
+            samples += 1
+            return (evaluate(at: now), _onDecision)
+        }
+        if let decision {
+            Self.log.info("Quality level \(decision.previousLevel) -> \(decision.level): \(String(describing: decision.reason), privacy: .public), \(String(format: "%.2f", decision.measuredFrameTime * 1000))ms for a \(String(format: "%.2f", decision.targetFrameTime * 1000))ms target")
+            onDecision?(decision)
+        }
+    }
+
+    /// Returns to full quality (or the floor) and forgets measurements, for example after loading a new scene
+    public func reset() {
+        withLock {
+            _level = max(_levelFloor, 0)
+            samples = 0
+            pendingSortTime = 0
+            lastUpgradeTime = nil
+            currentUpgradeCooldown = nil
+            _generation &+= 1
+        }
+    }
+
+    // MARK: - Private
+
+    /// Called with the lock held
+    private func evaluate(at now: CFAbsoluteTime) -> Decision? {
+        guard now - lastEvaluationTime >= _evaluationInterval else { return nil }
+        lastEvaluationTime = now
+
+        let thermalState = thermalStateProvider()
+        let thermalFloor: Int
+        switch thermalState {
+        case .nominal: thermalFloor = 0
+        case .fair: thermalFloor = 1
+        case .serious: thermalFloor = 2
+        case .critical: thermalFloor = ladder.count - 1
+        @unknown default: thermalFloor = 0
+        }
+        let floor = min(max(_levelFloor, thermalFloor), ladder.count - 1)
+
+        let target: Int
+        let reason: Decision.Reason
+        if _level < floor {
+            target = floor
+            reason = thermalFloor >= _levelFloor ? .thermal(thermalState) : .levelFloor
+        } else if samples >= _minimumSamples,
+                  _measuredFrameTime > _targetFrameTime * _downgradeThreshold,
+                  _level < ladder.count - 1,
+                  now - lastChangeTime >= _downgradeCooldown {
+            target = _level + 1
+            reason = .overBudget
+            // An upgrade that could not hold makes the next attempt wait longer
+            let baseCooldown = currentUpgradeCooldown ?? _upgradeCooldown
+            if let lastUpgradeTime, now - lastUpgradeTime < baseCooldown * 2 {
+                currentUpgradeCooldown = min(baseCooldown * 2, _maximumUpgradeCooldown)
+            }
+        } else if samples >= _minimumSamples,
+                  _measuredFrameTime < _targetFrameTime * _upgradeThreshold,
+                  _level > floor,
+                  now - lastChangeTime >= (currentUpgradeCooldown ?? _upgradeCooldown) {
+            target = _level - 1
+            reason = .underBudget
+            lastUpgradeTime = now
+        } else {
+            return nil
+        }
+
+        let decision = Decision(previousLevel: _level,
+                                level: target,
+                                reason: reason,
+                                measuredFrameTime: _measuredFrameTime,
+                                targetFrameTime: _targetFrameTime,
+                                thermalState: thermalState,
+                                time: now)
+        _level = target
+        lastChangeTime = now
+        // Frames measured at the old level say little about the new one
+        samples = 0
+        _generation &+= 1
+        decisions.append(decision)
+        if decisions.count > Self.decisionCapacity {
+            decisions.removeFirst(decisions.count - Self.decisionCapacity)
+        }
+        return decision
+    }
+
+    private func withLock<Result>(_ body: () -> Result) -> Result {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
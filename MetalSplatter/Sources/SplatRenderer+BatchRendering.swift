@@ -0,0 +1,48 @@
+import Foundation
+import Metal
+import simd
+
+// MARK: - Batch Rendering
+
+extension SplatRenderer {
+    /// False for packed and instanced scenes, which sort inline in `render` already
+    internal var drawsWithFrameSortOrder: Bool {
+        packedSplatStore == nil && splatInstanceSet == nil
+    }
+
+    /// Counting-sorts the renderable splats for a batch frame's camera into `order`, in the frame's command buffer,
+    /// so the draw that follows reads an order made for its own camera
+    internal func encodeFrameSort(into order: MetalBuffer<Int32>,
+                                  sorter: CountingSorter,
+                                  viewMatrix: simd_float4x4,
+                                  to commandBuffer: MTLCommandBuffer) throws {
+        let splatCount = self.splatCount
+        let renderableCount = renderableSplatCountForCurrentEditState
+        try order.ensureCapacity(max(splatCount, 1))
+        order.count = renderableCount
+        guard renderableCount > 0 else { return }
+
+        let inverseView = viewMatrix.inverse
+        let position = inverseView * SIMD4<Float>(0, 0, 0, 1)
+        let forward = inverseView * SIMD4<Float>(0, 0, -1, 0)
+        let cameraPosition = SIMD3(position.x, position.y, position.z)
+        let cameraForward = simd_normalize(SIMD3(forward.x, forward.y, forward.z))
+        let sortByDistance = sortingMode != .linear
+        let depthBounds = (getBounds() ?? getBoundsBlocking()).map {
+            Self.estimateCountingSortDepthBounds(from: $0,
+                                                 cameraPosition: cameraPosition,
+                                                 cameraForward: cameraForward,
+                                                 sortByDistance: sortByDistance)
+        }
+        try sorter.sort(commandBuffer: commandBuffer,
+                        splatBuffer: activeSplatBufferForRendering.buffer,
+                        editStateBuffer: visibilityFilteringEditStateBuffer,
+                        outputBuffer: order.buffer,
+                        cameraPosition: cameraPosition,
+                        cameraForward: cameraForward,
+                        sortByDistance: sortByDistance,
+                        splatCount: splatCount,
+                        depthBounds: depthBounds,
+                        useCameraRelativeBinning: useCameraRelativeBinning)
+    }
+}
@@ -87,7 +87,7 @@ extension SplatRenderer {
         pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
 
         do {
-            return try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+            return try pipelineCache.renderPipelineState(descriptor: pipelineDescriptor)
         } catch {
             throw SplatRendererError.failedToCreateRenderPipelineState(label: "Bindless Splat", underlying: error)
         }
@@ -204,6 +204,15 @@ extension SplatRenderer {
             return
         }
 
+        let qualityGovernor = self.qualityGovernor
+        let encodeStart = CFAbsoluteTimeGetCurrent()
+        applyQualityGovernorIfNeeded()
+        defer {
+            reportGovernedFrame(to: qualityGovernor,
+                                cpuEncodeDuration: CFAbsoluteTimeGetCurrent() - encodeStart,
+                                commandBuffer: commandBuffer)
+        }
+
         let splatCount = splatBuffer.count
         guard splatCount > 0 else { return }
 
@@ -212,7 +221,10 @@ extension SplatRenderer {
 
         // Update uniforms using internal methods
         switchToNextDynamicBuffer()
-        updateUniforms(forViewports: viewports, splatCount: UInt32(splatCount), indexedSplatCount: UInt32(indexedSplatCount))
+        updateUniforms(forViewports: viewports,
+                       splatCount: UInt32(splatCount),
+                       indexedSplatCount: UInt32(indexedSplatCount),
+                       rasterizationRateMap: rasterizationRateMap)
 
         // Update the argument buffer with current resources
         updateBindlessArgumentBuffer()
@@ -230,6 +242,7 @@ extension SplatRenderer {
             renderPassDescriptor.depthAttachment.storeAction = depthStoreAction
             renderPassDescriptor.depthAttachment.clearDepth = 0.0
         }
+        renderPassDescriptor.rasterizationRateMap = rasterizationRateMap
 
         guard let renderEncoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPassDescriptor) else {
             throw SplatRendererError.failedToCreateRenderEncoder
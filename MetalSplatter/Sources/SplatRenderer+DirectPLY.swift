@@ -0,0 +1,115 @@
+import Foundation
+import Metal
+import os
+import simd
+import SplatIO
+
+// MARK: - Direct PLY Loading
+
+extension SplatRenderer {
+    /// Vertices decoded per `concurrentPerform` iteration
+    private static let directPLYChunkSize = 65_536
+
+    /// Where a directly-loaded (or GPU-dequantized) scene came from, so its `SplatScenePoint` mirror can be rebuilt on demand
+    struct DirectPLYSource {
+        let url: URL
+        let mortonOrdered: Bool
+        /// The direct PLY load's mapped file, decoded again instead of re-reading `url`; nil for GPU-dequantized scenes
+        var mappedPLY: (layout: SplatPLYBinaryLayout, data: Data)? = nil
+    }
+
+    /// Decodes a fixed-layout `binary_little_endian` PLY straight from a memory-mapped file into `splatBuffer`,
+    /// without building `PLYElement`s, `SplatScenePoint`s or an intermediate `[Splat]`.
+    ///
+    /// Only used for an empty renderer, so the file maps 1:1 onto the buffer.
+    /// - Returns: false if the file does not use the supported layout; callers fall back to the regular reader
+    func readDirectPLY(from url: URL) throws -> Bool {
+        guard splatBuffer.count == 0, sourceScenePoints.isEmpty else { return false }
+        guard let (layout, data) = try SplatPLYBinaryLayout.mapFile(at: url), layout.pointCount > 0 else {
+            return false
+        }
+
+        let startTime = CFAbsoluteTimeGetCurrent()
+        let count = layout.pointCount
+        do {
+            try ensureAdditionalCapacity(count)
+        } catch {
+            Self.log.error("Failed to grow buffers: \(error)")
+            throw error
+        }
+
+        let mortonOrdered = shouldReorderByMortonOnCPU(count: count)
+        let loadOrder = try data.withUnsafeBytes { (raw: UnsafeRawBufferPointer) -> [Int]? in
+            guard let base = raw.baseAddress else { return nil }
+            let body = base.advanced(by: layout.bodyOffset)
+            let stride = layout.stride
+
+            let sampleStep = max(1, count / 1000)
+            let samples = Swift.stride(from: 0, to: count, by: sampleStep).map {
+                layout.point(body.advanced(by: $0 * stride))
+            }
+            try SplatDataValidator.validatePoints(samples)
+
+            // Decoding in Morton order directly avoids a second pass to permute the splats
+            let order: [Int]? = mortonOrdered
+                ? MortonOrder.computeReorderingIndices(positions: (0..<count).map {
+                    layout.position(body.advanced(by: $0 * stride))
+                })
+                : nil
+
+            let output = splatBuffer.values
+            let chunkSize = Self.directPLYChunkSize
+            let chunkCount = (count + chunkSize - 1) / chunkSize
+            DispatchQueue.concurrentPerform(iterations: chunkCount) { chunk in
+                let lower = chunk * chunkSize
+                let upper = min(lower + chunkSize, count)
+                for i in lower..<upper {
+                    let vertex = body.advanced(by: (order?[i] ?? i) * stride)
+                    output[i] = Splat(position: layout.position(vertex),
+                                      color: .init(layout.linearColor(vertex).sRGBToLinear, layout.linearOpacity(vertex)),
+                                      scale: exp(layout.scale(vertex)),
+                                      rotation: layout.rotation(vertex).normalized)
+                }
+            }
+            return order
+        }
+        splatBuffer.count = count
+        mortonPermutation = loadOrder.map { $0.map { UInt32($0) } }
+        directPLYSource = DirectPLYSource(url: url, mortonOrdered: mortonOrdered, mappedPLY: (layout, data))
+        try splatBufferContentsDidChange()
+
+        let duration = CFAbsoluteTimeGetCurrent() - startTime
+        Self.log.info("Direct PLY load of \(count) splats took \(String(format: "%.2f", duration * 1000))ms")
+        return true
+    }
+
+    /// Rebuilds `sourceScenePoints` for a directly-loaded scene. Animation, point edits and appends need
+    /// the mirror; it is decoded from the mapped file, in the Morton order `mortonPermutation` recorded at load,
+    /// the first time one of them runs.
+    func materializeDirectPLYSourcePointsIfNeeded() {
+        guard let source = directPLYSource else { return }
+        directPLYSource = nil
+        if let mappedPLY = source.mappedPLY {
+            let layout = mappedPLY.layout
+            let data = mappedPLY.data
+            // The direct PLY scene is the leading range; splats added since materialized it first
+            let order = mortonPermutation.map { $0.prefix(layout.pointCount).map { Int($0) } }
+            setAnimationSourcePoints(layout.batch(from: data, order: order).points)
+            return
+        }
+        do {
+            // GPU-dequantized scenes come from other formats and have no mapped PLY
+            var batch = try AutodetectSceneReader(source.url).readBatch()
+            if source.mortonOrdered {
+                batch = MortonOrder.reorder(batch)
+            }
+            guard batch.count == splatBuffer.count else {
+                Self.log.warning("Source file changed since direct PLY load (\(batch.count) points, \(self.splatBuffer.count) splats); animation source unavailable")
+                return
+            }
+            setAnimationSourcePoints(batch.points)
+        } catch {
+            Self.log.error("Failed to rebuild source points for \(source.url.lastPathComponent): \(error)")
+        }
+    }
+}
@@ -71,9 +71,31 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
         @available(*, deprecated, message: "Use shDirectionEpsilon for threshold-based updates instead")
         public var updateFrequency: Int = 1
 
+        /// How SH coefficient sets are stored once a scene has more unique sets than `maxPaletteSize`
+        public var paletteStorage: PaletteStorage = .exact
+
+        /// Lloyd iterations per level when a `.codebook` palette is trained
+        public var codebookIterations: Int = 4
+
+        /// Evaluate SH in a compute pass for splats inside the frustum only, caching each splat's color until its
+        /// local view direction moves to another direction bucket, instead of per vertex in the draw.
+        /// Stereo views share the eyes' midpoint as the SH camera.
+        public var visibleSHCacheEnabled: Bool = false
+
+        /// Octahedral direction buckets per axis for the visible SH cache; 32 is about 6° per bucket
+        public var shCacheDirectionResolution: Int = 32
+
         public init() {}
     }
 
+    public enum PaletteStorage: Sendable {
+        /// Unique sets only; splats whose set does not fit in the palette fall back to their base color
+        case exact
+        /// Cluster the sets into a k-means codebook of `maxPaletteSize` entries (at most 65536, SOGS `shN`
+        /// style) so every splat keeps view-dependent color. Training runs once at load.
+        case codebook
+    }
+
     // Fast SH specific properties
     public var fastSHConfig = FastSHConfiguration()
 
@@ -83,6 +105,15 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
     private var shPaletteBuffer: MTLBuffer?
     private var fastSHPipelineState: MTLRenderPipelineState?
     private var fastSHEditingPipelineState: MTLRenderPipelineState?
+    private var fastSHCachedPipelineState: MTLRenderPipelineState?
+    private var fastSHCachedEditingPipelineState: MTLRenderPipelineState?
+    private var visibleSHPipelineState: MTLComputePipelineState?
+
+    // Visible SH cache: one RGBA8 color and direction bucket per splat, in splatSHBuffer order
+    private var shColorCacheBuffer: MTLBuffer?
+    private var shCacheBucketBuffer: MTLBuffer?
+    private var shCacheNeedsReset = true
+    private var lastSHCacheViewMatrices: [simd_float4x4] = []
     
     // SH data storage
     public private(set) var shCoefficients: [[SIMD3<Float>]] = []
@@ -95,6 +126,7 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
     private var splatSHBufferPrime: MetalBuffer<SplatSH>
     private var animatedSplatSHBuffer: MetalBuffer<SplatSH>?
     private var lastAppliedAnimationTimeSH: Float?
+    private var animationSHPaletteIndexBuffer: MetalBuffer<UInt32>? // Per-source-point palette index for animateSplatsSH
     private let splatSHBufferPool: MetalBufferPool<SplatSH>
 
     private struct FastSHShaderParameters {
@@ -104,6 +136,14 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
         var skipSHEvaluation: UInt32 = 0  // When non-zero, skip SH evaluation and use base color
     }
 
+    // Keep in sync with FastSHRenderPath.metal : FastSHCacheParams
+    private struct FastSHCacheParams {
+        var splatCount: UInt32
+        var viewCount: UInt32
+        var bucketResolution: UInt32
+        var padding: UInt32 = 0
+    }
+
     private var shaderParameters = FastSHShaderParameters()
 
     static func rendererSupportedSHCoefficients(_ coefficients: [SIMD3<Float>], degree: Int) -> [SIMD3<Float>] {
@@ -123,6 +163,43 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
         super.resetPipelineStates()
         fastSHPipelineState = nil
         fastSHEditingPipelineState = nil
+        fastSHCachedPipelineState = nil
+        fastSHCachedEditingPipelineState = nil
+    }
+
+    /// The SH draw has no instanced variant, and SH colors are evaluated for the asset's own view direction
+    internal override var splatInstancesUnsupportedReason: String? {
+        "FastSHSplatRenderer evaluates spherical harmonics without per-instance view directions"
+    }
+
+    /// Foveated frames take the fast SH path, which always clears its target
+    internal override func renderFoveatedScene(viewport: ViewportDescriptor,
+                                               colorTexture: MTLTexture,
+                                               colorLoadAction: MTLLoadAction,
+                                               colorStoreAction: MTLStoreAction,
+                                               depthTexture: MTLTexture?,
+                                               rasterizationRateMap: MTLRasterizationRateMap?,
+                                               to commandBuffer: MTLCommandBuffer) throws {
+        guard colorLoadAction == .clear else {
+            try super.renderFoveatedScene(viewport: viewport,
+                                          colorTexture: colorTexture,
+                                          colorLoadAction: colorLoadAction,
+                                          colorStoreAction: colorStoreAction,
+                                          depthTexture: depthTexture,
+                                          rasterizationRateMap: rasterizationRateMap,
+                                          to: commandBuffer)
+            return
+        }
+        try render(viewports: [ModelRendererViewportDescriptor(viewport: viewport.viewport,
+                                                               projectionMatrix: viewport.projectionMatrix,
+                                                               viewMatrix: viewport.viewMatrix,
+                                                               screenSize: viewport.screenSize)],
+                   colorTexture: colorTexture,
+                   colorStoreAction: colorStoreAction,
+                   depthTexture: depthTexture,
+                   rasterizationRateMap: rasterizationRateMap,
+                   renderTargetArrayLength: 0,
+                   to: commandBuffer)
     }
 
     public override func prepareForSorting(count: Int) throws {
@@ -143,6 +220,7 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
 
     public override func didSwapSplatBuffers() {
         swap(&splatSHBuffer, &splatSHBufferPrime)
+        shCacheNeedsReset = true
     }
 
     public override init(device: MTLDevice,
@@ -156,7 +234,9 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
         let shPoolConfig = MetalBufferPool<SplatSH>.Configuration(
             maxPoolSize: 8,
             maxBufferAge: 120.0,
-            memoryPressureThreshold: 0.7
+            memoryPressureThreshold: 0.7,
+            // SH coefficients are uploaded from the CPU and only read by the GPU
+            useHeapAllocation: true
         )
         self.splatSHBufferPool = MetalBufferPool(device: device, configuration: shPoolConfig)
         self.splatSHBuffer = try splatSHBufferPool.acquire(minimumCapacity: 1)
@@ -219,12 +299,29 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
                 pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
             }
 
-            fastSHPipelineState = try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+            fastSHPipelineState = try pipelineCache.renderPipelineState(descriptor: pipelineDescriptor)
 
             let editingPipelineDescriptor = pipelineDescriptor.copy() as! MTLRenderPipelineDescriptor
             editingPipelineDescriptor.label = "Fast SH Splat Editing Pipeline"
             editingPipelineDescriptor.vertexFunction = editingVertexFunction
-            fastSHEditingPipelineState = try device.makeRenderPipelineState(descriptor: editingPipelineDescriptor)
+            fastSHEditingPipelineState = try pipelineCache.renderPipelineState(descriptor: editingPipelineDescriptor)
+
+            // Visible SH cache (optional)
+            if let visibleSHFunction = try? library.makeFunction(name: "evaluateVisibleSplatSH", constantValues: functionConstants),
+               let cachedVertexFunction = try? library.makeFunction(name: "fastSHCachedSplatVertexShader", constantValues: functionConstants),
+               let cachedEditingVertexFunction = try? library.makeFunction(name: "fastSHCachedSplatVertexShaderEditing", constantValues: functionConstants) {
+                visibleSHPipelineState = try device.makeComputePipelineState(function: visibleSHFunction)
+
+                let cachedPipelineDescriptor = pipelineDescriptor.copy() as! MTLRenderPipelineDescriptor
+                cachedPipelineDescriptor.label = "Fast SH Cached Splat Pipeline"
+                cachedPipelineDescriptor.vertexFunction = cachedVertexFunction
+                fastSHCachedPipelineState = try pipelineCache.renderPipelineState(descriptor: cachedPipelineDescriptor)
+
+                let cachedEditingPipelineDescriptor = pipelineDescriptor.copy() as! MTLRenderPipelineDescriptor
+                cachedEditingPipelineDescriptor.label = "Fast SH Cached Splat Editing Pipeline"
+                cachedEditingPipelineDescriptor.vertexFunction = cachedEditingVertexFunction
+                fastSHCachedEditingPipelineState = try pipelineCache.renderPipelineState(descriptor: cachedEditingPipelineDescriptor)
+            }
         } catch {
             print("Failed to create fast SH pipeline: \(error)")
         }
@@ -232,15 +329,19 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
     
     /// Load splats with SH coefficients support
     private func loadSplatsWithSHSynchronously(_ splats: [SplatScenePoint]) throws {
-        try replaceAllSplats(with: splats)
+        // GPU Morton reordering permutes the source points too, so the SH buffers rebuilt from them follow the new order
+        try replaceAllSplats(with: splats,
+                             mortonReorder: gpuMortonReorderEnabled && !preserveSourceOrderOnAdd && splats.count > 1)
     }
 
     private func rebuildFastSHBuffers(from splats: [SplatScenePoint]) throws {
         // Extract unique SH coefficient sets and build palette
         var uniqueSHSets: [[SIMD3<Float>]] = []
         var shSetToIndex: [[SIMD3<Float>]: UInt32] = [:]
+        var paletteOverflowed = false
         shPaletteMap.removeAll()
         shDegree = 0
+        animationSHPaletteIndexBuffer = nil
         
         // Determine SH degree from first splat with SH
         for splat in splats {
@@ -262,10 +363,33 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
                     uniqueSHSets.append(rendererCoeffs)
                     shSetToIndex[rendererCoeffs] = newIndex
                     shPaletteMap[index] = newIndex
+                } else {
+                    paletteOverflowed = true
                 }
                 // If we exceed maxPaletteSize, splats will use index 0 (fallback)
             }
         }
+
+        // Too many unique sets for the palette: replace it with a codebook that covers every splat
+        if paletteOverflowed && fastSHConfig.paletteStorage == .codebook {
+            var shSplatIndices: [Int] = []
+            var shSets: [[SIMD3<Float>]] = []
+            for (index, splat) in splats.enumerated() {
+                if case let .sphericalHarmonic(coeffs) = splat.color, !coeffs.isEmpty {
+                    shSplatIndices.append(index)
+                    shSets.append(Self.rendererSupportedSHCoefficients(coeffs, degree: shDegree))
+                }
+            }
+            let startTime = CFAbsoluteTimeGetCurrent()
+            let codebook = SHCodebook.train(sets: shSets,
+                                            entryCount: min(fastSHConfig.maxPaletteSize, SHCodebook.maxEntryCount),
+                                            iterations: fastSHConfig.codebookIterations)
+            uniqueSHSets = codebook.centroids
+            for (setIndex, splatIndex) in shSplatIndices.enumerated() {
+                shPaletteMap[splatIndex] = UInt32(codebook.labels[setIndex])
+            }
+            print("Fast SH: Trained \(codebook.centroids.count)-entry SH codebook for \(shSets.count) splats in \(String(format: "%.2f", CFAbsoluteTimeGetCurrent() - startTime))s")
+        }
         
         // Create SH palette buffer if we have SH data
         // Uses half-precision (Float16) storage — 50% less memory and bandwidth vs float32.
@@ -318,6 +442,7 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
 
         // Mark SH as dirty so it gets evaluated on first render
         shDirtyDueToData = true
+        shCacheNeedsReset = true
 
         // Create extended splat buffer with SH info
         try ensureSHBufferCapacity(splats.count)
@@ -352,6 +477,17 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
     
     /// Override read method to use Fast SH loading pipeline
     public override func read(from url: URL) async throws {
+        // Fast SH buffers are built from the whole scene, so remote scenes are downloaded before reading
+        if RemoteSceneLoader.isRemote(url) {
+            let local = try await remoteSceneLoader.localFile(for: url)
+            defer {
+                if local.isTemporary {
+                    try? FileManager.default.removeItem(at: local.url)
+                }
+            }
+            try await read(from: local.url)
+            return
+        }
         let reader = try AutodetectSceneReader(url)
         var newPoints = SplatMemoryBuffer()
         try await newPoints.read(from: reader)
@@ -369,8 +505,23 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
         try replaceAllSplats(with: allPoints, sceneCounts: layers.map { $0.points.count })
     }
 
-    internal override func updateSplats(_ points: [SplatScenePoint], at indices: [Int]) throws {
+    internal override func updateSplats<Points: RandomAccessCollection>(_ points: Points, at indices: [Int]) throws
+    where Points.Element == SplatScenePoint, Points.Index == Int {
         try super.updateSplats(points, at: indices)
+        try rebuildFastSHBuffersAfterEdit()
+    }
+
+    internal override func appendEditedSplats(_ points: [SplatScenePoint], sceneIndices: [UInt32]) throws {
+        try super.appendEditedSplats(points, sceneIndices: sceneIndices)
+        try rebuildFastSHBuffersAfterEdit()
+    }
+
+    internal override func removeTrailingSplats(from count: Int) throws {
+        try super.removeTrailingSplats(from: count)
+        try rebuildFastSHBuffersAfterEdit()
+    }
+
+    private func rebuildFastSHBuffersAfterEdit() throws {
         try rebuildFastSHBuffers(from: sourceScenePoints)
         if let animatedSplatSHBuffer {
             splatSHBufferPool.release(animatedSplatSHBuffer)
@@ -381,8 +532,11 @@ public class FastSHSplatRenderer: SplatRenderer, @unchecked Sendable {
 
     internal override func replaceAllSplats(with points: [SplatScenePoint],
                                             sceneCounts: [Int]? = nil,
-                                            sceneIndices: [UInt32]? = nil) throws {
-        try super.replaceAllSplats(with: points, sceneCounts: sceneCounts, sceneIndices: sceneIndices)
+                                            sceneIndices: [UInt32]? = nil,
+                                            mortonReorder: Bool = false,
+                                            mortonPermutation permutation: [UInt32]? = nil) throws {
+        try super.replaceAllSplats(with: points, sceneCounts: sceneCounts, sceneIndices: sceneIndices,
+                                   mortonReorder: mortonReorder, mortonPermutation: permutation)
         try rebuildFastSHBuffers(from: sourceScenePoints)
         if let animatedSplatSHBuffer {
             splatSHBufferPool.release(animatedSplatSHBuffer)
@@ -426,7 +580,13 @@ extension FastSHSplatRenderer {
             && editStateBuffer != nil
             && editTransformIndexBuffer != nil
             && editTransformPaletteBuffer != nil
-        let pipeline = bindEditingResources ? fastSHEditingPipelineState : fastSHPipelineState
+        let useSHCache = fastSHConfig.visibleSHCacheEnabled
+            && visibleSHPipelineState != nil
+            && fastSHCachedPipelineState != nil
+            && fastSHCachedEditingPipelineState != nil
+        let pipeline = useSHCache
+            ? (bindEditingResources ? fastSHCachedEditingPipelineState : fastSHCachedPipelineState)
+            : (bindEditingResources ? fastSHEditingPipelineState : fastSHPipelineState)
 
         // Use fast SH pipeline if enabled and available
         if fastSHConfig.enabled,
@@ -434,10 +594,22 @@ extension FastSHSplatRenderer {
            shPaletteBuffer != nil,
            shDegree > 0,
            shCoefficientsPerEntry > 0 {
+            let frameTimelineRecorder = self.frameTimelineRecorder
+            let qualityGovernor = self.qualityGovernor
+            let encodeStart = CFAbsoluteTimeGetCurrent()
+            frameTimelineRecorder?.beginFrame()
+            applyQualityGovernorIfNeeded()
+            defer {
+                let cpuEncodeDuration = CFAbsoluteTimeGetCurrent() - encodeStart
+                frameTimelineRecorder?.endFrame(cpuEncodeDuration: cpuEncodeDuration)
+                reportGovernedFrame(to: qualityGovernor, cpuEncodeDuration: cpuEncodeDuration, commandBuffer: commandBuffer)
+            }
+
             switchToNextDynamicBuffer()
             updateUniforms(forViewports: splatViewports,
                            splatCount: UInt32(splatCount),
-                           indexedSplatCount: UInt32(min(splatCount, Constants.maxIndexedSplatCount)))
+                           indexedSplatCount: UInt32(min(splatCount, Constants.maxIndexedSplatCount)),
+                           rasterizationRateMap: rasterizationRateMap)
 
             // Render using fast SH pipeline
             try renderWithFastSH(viewports: viewports,
@@ -448,7 +620,8 @@ extension FastSHSplatRenderer {
                                 rasterizationRateMap: rasterizationRateMap,
                                 renderTargetArrayLength: renderTargetArrayLength,
                                 commandBuffer: commandBuffer,
-                                pipelineState: pipeline)
+                                pipelineState: pipeline,
+                                useSHCache: useSHCache)
         } else {
             // Fall back to regular SplatRenderer rendering
             try render(viewports: splatViewports,
@@ -470,11 +643,17 @@ extension FastSHSplatRenderer {
                                  rasterizationRateMap: MTLRasterizationRateMap?,
                                  renderTargetArrayLength: Int,
                                  commandBuffer: MTLCommandBuffer,
-                                 pipelineState: MTLRenderPipelineState) throws {
+                                 pipelineState: MTLRenderPipelineState,
+                                 useSHCache: Bool) throws {
         if #available(iOS 26.0, macOS 26.0, tvOS 26.0, visionOS 26.0, *) {
             updateMetal4ResidencyForFrame(commandBuffer: commandBuffer)
         }
 
+        // The cache pass reads the uniforms written by render(viewports:...) and must precede the draw
+        if useSHCache && shRenderingEnabled {
+            try encodeVisibleSHEvaluation(viewports: viewports, to: commandBuffer)
+        }
+
         // Create render pass descriptor
         let renderPassDescriptor = MTLRenderPassDescriptor()
         renderPassDescriptor.colorAttachments[0].texture = colorTexture
@@ -491,10 +670,12 @@ extension FastSHSplatRenderer {
 
         if let rateMap = rasterizationRateMap {
             renderPassDescriptor.rasterizationRateMap = rateMap
+            Self.limitRenderTargetSize(of: renderPassDescriptor, to: rateMap)
         }
 
         renderPassDescriptor.renderTargetArrayLength = renderTargetArrayLength
 
+        frameTimelineRecorder?.attach(.draw, to: renderPassDescriptor, on: commandBuffer)
         guard let renderEncoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPassDescriptor) else {
             throw SplatRendererError.failedToCreateRenderPipelineState(label: "Fast SH Render Encoder", underlying: NSError(domain: "MetalSplatter", code: 1))
         }
@@ -521,15 +702,19 @@ extension FastSHSplatRenderer {
         }
 
         // GPU-only sorting: pass sorted indices buffer to shader
-        if let sortedIndices = sortedIndicesBuffer {
-            renderEncoder.setVertexBuffer(sortedIndices.buffer, offset: 0, index: BufferIndex.sortedIndices.rawValue)
-        }
+        bindCurrentSortedIndices(to: renderEncoder)
 
-        // Check if SH needs re-evaluation based on camera movement threshold
-        let shouldUpdateSH = shRenderingEnabled && shouldUpdateSHForCurrentCamera()
+        if useSHCache {
+            // Without a cache yet, draw the base colors rather than read an unbound buffer
+            renderEncoder.setVertexBuffer(shColorCacheBuffer, offset: 0, index: 9)
+            var params = shaderParameters
+            params.skipSHEvaluation = (shRenderingEnabled && shColorCacheBuffer != nil) ? 0 : 1
+            renderEncoder.setVertexBytes(&params, length: MemoryLayout<FastSHShaderParameters>.stride, index: 8)
+        } else if let paletteBuffer = shPaletteBuffer {
+            // Check if SH needs re-evaluation based on camera movement threshold
+            let shouldUpdateSH = shRenderingEnabled && shouldUpdateSHForCurrentCamera()
 
-        // Set SH palette data with skip flag based on threshold
-        if let paletteBuffer = shPaletteBuffer {
+            // Set SH palette data with skip flag based on threshold
             renderEncoder.setVertexBuffer(paletteBuffer, offset: 0, index: 7)
             var params = shaderParameters
             // Skip SH evaluation if disabled or camera hasn't moved enough
@@ -609,6 +794,74 @@ extension FastSHSplatRenderer {
         renderEncoder.endEncoding()
     }
 
+    /// Refreshes the visible SH cache for this frame's cameras, unless the cameras, the scene and its animation are
+    /// unchanged since the last refresh
+    private func encodeVisibleSHEvaluation(viewports: [ModelRendererViewportDescriptor],
+                                           to commandBuffer: MTLCommandBuffer) throws {
+        guard let pipeline = visibleSHPipelineState, let paletteBuffer = shPaletteBuffer else { return }
+        let splats = activeSplatSHBuffer
+        guard splats.count > 0 else { return }
+        try resetSHCacheIfNeeded(for: splats)
+        guard let shColorCacheBuffer, let shCacheBucketBuffer else { return }
+
+        let activeViewports = viewports.prefix(maxViewCount)
+        let viewMatrices = activeViewports.map(\.viewMatrix)
+        if !shDirtyDueToData && !animationEnabled && viewMatrices == lastSHCacheViewMatrices {
+            return
+        }
+
+        guard let computeEncoder = commandBuffer.makeComputeCommandEncoder(timing: .shEvaluation, with: frameTimelineRecorder) else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        computeEncoder.label = "Visible SH Evaluation"
+        var params = shaderParameters
+        params.skipSHEvaluation = 0
+        var cacheParams = FastSHCacheParams(splatCount: UInt32(splats.count),
+                                            viewCount: UInt32(max(activeViewports.count, 1)),
+                                            bucketResolution: UInt32(max(fastSHConfig.shCacheDirectionResolution, 1)))
+        computeEncoder.setComputePipelineState(pipeline)
+        computeEncoder.setBuffer(splats.buffer, offset: 0, index: 0)
+        computeEncoder.setBuffer(paletteBuffer, offset: 0, index: 1)
+        computeEncoder.setBytes(&params, length: MemoryLayout<FastSHShaderParameters>.stride, index: 2)
+        computeEncoder.setBuffer(dynamicUniformBuffers, offset: uniformBufferOffset, index: 3)
+        computeEncoder.setBytes(&cacheParams, length: MemoryLayout<FastSHCacheParams>.stride, index: 4)
+        computeEncoder.setBuffer(shColorCacheBuffer, offset: 0, index: 5)
+        computeEncoder.setBuffer(shCacheBucketBuffer, offset: 0, index: 6)
+        computeEncoder.dispatchThreadgroups(MTLSize(width: (splats.count + 255) / 256, height: 1, depth: 1),
+                                            threadsPerThreadgroup: MTLSize(width: 256, height: 1, depth: 1))
+        computeEncoder.endEncoding()
+
+        lastSHCacheViewMatrices = viewMatrices
+        didUpdateSHForCurrentCamera()
+    }
+
+    /// Starts a fresh cache (base colors, no direction buckets) after the splats were rebuilt or reordered.
+    /// New buffers are allocated rather than cleared, since frames in flight may still read the old ones.
+    private func resetSHCacheIfNeeded(for splats: MetalBuffer<SplatSH>) throws {
+        let length = splats.count * MemoryLayout<UInt32>.stride
+        guard shCacheNeedsReset || (shColorCacheBuffer?.length ?? 0) < length else { return }
+
+        guard let colorBuffer = device.makeBuffer(length: length, options: .storageModeShared) else {
+            throw SplatRendererError.failedToCreateBuffer(length: length)
+        }
+        guard let bucketBuffer = device.makeBuffer(length: length, options: .storageModeShared) else {
+            throw SplatRendererError.failedToCreateBuffer(length: length)
+        }
+        colorBuffer.label = "SH Color Cache"
+        bucketBuffer.label = "SH Cache Direction Buckets"
+
+        let colors = colorBuffer.contents().bindMemory(to: UInt32.self, capacity: splats.count)
+        for index in 0..<splats.count {
+            colors[index] = splats.values[index].baseColor
+        }
+        memset(bucketBuffer.contents(), 0xFF, length)
+
+        shColorCacheBuffer = colorBuffer
+        shCacheBucketBuffer = bucketBuffer
+        lastSHCacheViewMatrices = []
+        shCacheNeedsReset = false
+    }
+
     private var activeSplatSHBuffer: MetalBuffer<SplatSH> {
         animationEnabled ? (animatedSplatSHBuffer ?? splatSHBuffer) : splatSHBuffer
     }
@@ -638,25 +891,40 @@ extension FastSHSplatRenderer {
         }
         animatedSplatSHBuffer.count = 0
 
-        for (index, point) in sourceScenePoints.enumerated() {
-            let sceneIndex = index < animationSceneIndices.count ? Int(animationSceneIndices[index]) : 0
-            let sample = SplatAnimationEngine.apply(
-                point: point,
-                globalIndex: index,
-                sceneIndex: sceneIndex,
-                sceneMetrics: animationSceneMetrics,
-                configuration: configuration
-            )
-
-            let baseSplat = Splat(sample.point)
-            let shIndex = shPaletteMap[index] ?? UInt32.max
-            let shDeg = shPaletteMap[index] != nil ? UInt16(shDegree) : 0
-            var splatSH = SplatSH(splat: baseSplat,
-                                  rotation: sample.point.rotation.normalized,
-                                  shIndex: shIndex,
-                                  shDegree: shDeg)
-            splatSH.tintColor = SIMD4<Float>(sample.tint.x, sample.tint.y, sample.tint.z, 1)
-            animatedSplatSHBuffer.append(splatSH)
+        if let pipeline = animateSplatsSHPipelineState,
+           let paletteIndexBuffer = prepareAnimationSHPaletteIndexBuffer(),
+           encodeAnimationKernel(pipeline,
+                                 configuration: configuration,
+                                 output: animatedSplatSHBuffer.buffer,
+                                 label: "Animate SH Splats",
+                                 to: commandBuffer,
+                                 bindAdditionalResources: { [shDegree] encoder in
+                                     var degree = UInt32(shDegree)
+                                     encoder.setBuffer(paletteIndexBuffer.buffer, offset: 0, index: 5)
+                                     encoder.setBytes(&degree, length: MemoryLayout<UInt32>.stride, index: 6)
+                                 }) {
+            animatedSplatSHBuffer.count = sourceScenePoints.count
+        } else {
+            for (index, point) in sourceScenePoints.enumerated() {
+                let sceneIndex = index < animationSceneIndices.count ? Int(animationSceneIndices[index]) : 0
+                let sample = SplatAnimationEngine.apply(
+                    point: point,
+                    globalIndex: index,
+                    sceneIndex: sceneIndex,
+                    sceneMetrics: animationSceneMetrics,
+                    configuration: configuration
+                )
+
+                let baseSplat = Splat(sample.point)
+                let shIndex = shPaletteMap[index] ?? UInt32.max
+                let shDeg = shPaletteMap[index] != nil ? UInt16(shDegree) : 0
+                var splatSH = SplatSH(splat: baseSplat,
+                                      rotation: sample.point.rotation.normalized,
+                                      shIndex: shIndex,
+                                      shDegree: shDeg)
+                splatSH.tintColor = SIMD4<Float>(sample.tint.x, sample.tint.y, sample.tint.z, 1)
+                animatedSplatSHBuffer.append(splatSH)
+            }
         }
 
         let previousAnimatedBuffer = self.animatedSplatSHBuffer
@@ -668,4 +936,29 @@ extension FastSHSplatRenderer {
             }
         }
     }
+
+    /// Flattens `shPaletteMap` into a per-source-point buffer for the GPU animation kernel.
+    /// Rebuilt only when the palette is rebuilt or the point count changes.
+    private func prepareAnimationSHPaletteIndexBuffer() -> MetalBuffer<UInt32>? {
+        let pointCount = sourceScenePoints.count
+        if let animationSHPaletteIndexBuffer, animationSHPaletteIndexBuffer.count == pointCount {
+            return animationSHPaletteIndexBuffer
+        }
+
+        do {
+            let buffer = try MetalBuffer<UInt32>(device: device, capacity: max(pointCount, 1))
+            buffer.withLockedValues { values, _ in
+                for index in 0..<pointCount {
+                    values[index] = shPaletteMap[index] ?? UInt32.max
+                }
+            }
+            buffer.count = pointCount
+            buffer.buffer.label = "Animation SH Palette Indices"
+            animationSHPaletteIndexBuffer = buffer
+            return buffer
+        } catch {
+            Self.log.error("Failed to allocate animation SH palette index buffer: \(error)")
+            return nil
+        }
+    }
 }
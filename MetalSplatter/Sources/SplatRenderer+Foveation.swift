@@ -0,0 +1,337 @@
+import Foundation
+import Metal
+import simd
+
+// MARK: - Foveated Rendering
+
+extension SplatRenderer {
+    /// Zone rates of a rasterization rate map, sampled for the vertex stage so splat footprints can be filtered to
+    /// the physical pixel size they shade at. Keep in sync with ShaderCommon.h : foveationRate.
+    struct FoveationRates: Equatable {
+        static let zoneCount = 16
+
+        /// Rate of each column and row zone, unorm8-packed four per word
+        var horizontal: SIMD4<UInt32>
+        var vertical: SIMD4<UInt32>
+
+        init(horizontal: [Float], vertical: [Float]) {
+            self.horizontal = Self.pack(horizontal)
+            self.vertical = Self.pack(vertical)
+        }
+
+        /// Measures `layer` of `rateMap` along its center row and column. Layers are separable, so the rates along
+        /// one row hold for every row.
+        init(_ rateMap: MTLRasterizationRateMap, layer: Int) {
+            let layer = min(layer, max(rateMap.layerCount - 1, 0))
+            let width = Float(rateMap.screenSize.width)
+            let height = Float(rateMap.screenSize.height)
+            let zones = (0..<Self.zoneCount).map { Float($0) / Float(Self.zoneCount) }
+            let step = 1 / Float(Self.zoneCount)
+            let horizontal = zones.map { start -> Float in
+                let from = rateMap.mapScreenToPhysicalCoordinates(MTLCoordinate2D(x: start * width, y: height / 2), forLayer: layer)
+                let to = rateMap.mapScreenToPhysicalCoordinates(MTLCoordinate2D(x: (start + step) * width, y: height / 2), forLayer: layer)
+                return (to.x - from.x) / max(step * width, 1)
+            }
+            let vertical = zones.map { start -> Float in
+                let from = rateMap.mapScreenToPhysicalCoordinates(MTLCoordinate2D(x: width / 2, y: start * height), forLayer: layer)
+                let to = rateMap.mapScreenToPhysicalCoordinates(MTLCoordinate2D(x: width / 2, y: (start + step) * height), forLayer: layer)
+                return (to.y - from.y) / max(step * height, 1)
+            }
+            self.init(horizontal: horizontal, vertical: vertical)
+        }
+
+        static func rate(_ packed: SIMD4<UInt32>, zone: Int) -> Float {
+            Float(max((packed[zone / 4] >> UInt32((zone % 4) * 8)) & 0xFF, 1)) / 255
+        }
+
+        private static func pack(_ rates: [Float]) -> SIMD4<UInt32> {
+            var packed = SIMD4<UInt32>.zero
+            for (zone, rate) in rates.prefix(zoneCount).enumerated() {
+                let value = UInt32((min(max(rate, 0), 1) * 255).rounded())
+                packed[zone / 4] |= value << UInt32((zone % 4) * 8)
+            }
+            return packed
+        }
+    }
+
+    /// A density rate map and the targets drawn through it, reused until the camera or scene moves on. The targets
+    /// are screen-size, so maps rebuilt at the same screen size draw into them (through their physical sub-rect)
+    /// instead of reallocating them whenever the physical size changes.
+    final class FoveationCache {
+        let rateMap: MTLRasterizationRateMap
+        let parameterBuffer: MTLBuffer
+        let screenSize: SIMD2<Int>
+        let minimumRate: Float
+        let splatCount: Int
+        let cameraPosition: SIMD3<Float>
+        let cameraForward: SIMD3<Float>
+        let time: CFAbsoluteTime
+        var colorTexture: MTLTexture?
+        var depthTexture: MTLTexture?
+
+        init(rateMap: MTLRasterizationRateMap,
+             parameterBuffer: MTLBuffer,
+             screenSize: SIMD2<Int>,
+             minimumRate: Float,
+             splatCount: Int,
+             cameraPosition: SIMD3<Float>,
+             cameraForward: SIMD3<Float>,
+             time: CFAbsoluteTime) {
+            self.rateMap = rateMap
+            self.parameterBuffer = parameterBuffer
+            self.screenSize = screenSize
+            self.minimumRate = minimumRate
+            self.splatCount = splatCount
+            self.cameraPosition = cameraPosition
+            self.cameraForward = cameraForward
+            self.time = time
+        }
+    }
+
+    /// Whether this device can draw through rasterization rate maps
+    public var supportsFoveatedRendering: Bool {
+        device.supportsRasterizationRateMap(layerCount: 1)
+    }
+
+    /// A rasterization rate map for `viewport` shaped by where the scene's splats land on screen: columns and rows
+    /// holding a good share of the visible splats keep full rate, emptier ones fall towards
+    /// `foveationMinimumRate`. The map is rebuilt at most every `foveationRebuildInterval` while the camera moves.
+    /// Returns nil when the device has no rate map support or nothing is loaded.
+    public func makeSplatDensityRateMap(for viewport: ViewportDescriptor) -> MTLRasterizationRateMap? {
+        densityFoveationCache(for: viewport)?.rateMap
+    }
+
+    /// Draws `viewport` through a splat density rate map into a physical-size region, then resolves it over
+    /// `colorTexture` at full resolution, so sparse regions of the frame shade fewer fragments. Falls back to
+    /// `render(viewports:...)` when the device, sample count, or a missing map rule foveation out.
+    /// Depth is not resolved; use `render(viewports:...)` with a compositor map for depth-dependent output.
+    public func renderFoveated(viewport: ViewportDescriptor,
+                               colorTexture: MTLTexture,
+                               colorLoadAction: MTLLoadAction = .clear,
+                               colorStoreAction: MTLStoreAction,
+                               to commandBuffer: MTLCommandBuffer) throws {
+        guard sampleCount == 1,
+              let cache = densityFoveationCache(for: viewport),
+              let resolvePipeline = foveatedResolvePipeline(),
+              let targets = foveationTargets(in: cache) else {
+            try renderFoveatedScene(viewport: viewport,
+                                    colorTexture: colorTexture,
+                                    colorLoadAction: colorLoadAction,
+                                    colorStoreAction: colorStoreAction,
+                                    depthTexture: nil,
+                                    rasterizationRateMap: nil,
+                                    to: commandBuffer)
+            return
+        }
+
+        // The resolve blends over the destination, so the physical target starts out transparent
+        clearColorOverride = MTLClearColor(red: 0, green: 0, blue: 0, alpha: 0)
+        defer { clearColorOverride = nil }
+        try renderFoveatedScene(viewport: viewport,
+                                colorTexture: targets.color,
+                                colorLoadAction: .clear,
+                                colorStoreAction: .store,
+                                depthTexture: targets.depth,
+                                rasterizationRateMap: cache.rateMap,
+                                to: commandBuffer)
+
+        let renderPassDescriptor = MTLRenderPassDescriptor()
+        renderPassDescriptor.colorAttachments[0].texture = colorTexture
+        renderPassDescriptor.colorAttachments[0].loadAction = colorLoadAction
+        renderPassDescriptor.colorAttachments[0].storeAction = colorStoreAction
+        renderPassDescriptor.colorAttachments[0].clearColor = clearColor
+        guard let encoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPassDescriptor) else {
+            throw SplatRendererError.failedToCreateRenderEncoder
+        }
+        encoder.label = "Foveated Resolve"
+        encoder.setRenderPipelineState(resolvePipeline)
+        encoder.setViewport(viewport.viewport)
+        encoder.setFragmentBuffer(cache.parameterBuffer, offset: 0, index: 0)
+        let physicalSize = cache.rateMap.physicalSize(layer: 0)
+        var physicalExtent = SIMD2<Float>(Float(physicalSize.width), Float(physicalSize.height))
+        encoder.setFragmentBytes(&physicalExtent, length: MemoryLayout<SIMD2<Float>>.stride, index: 1)
+        encoder.setFragmentTexture(targets.color, index: 0)
+        encoder.drawPrimitives(type: .triangle, vertexStart: 0, vertexCount: 3)
+        encoder.endEncoding()
+    }
+
+    /// Rate per zone from the number of splats projected into it: zones with at least
+    /// `Constants.foveationFullRateDensity` of the busiest zone's count keep full rate, and each zone's neighbours
+    /// are raised to its rate so content edges stay sharp
+    static func foveationRates(zoneCounts: [Float], minimumRate: Float) -> [Float] {
+        let minimumRate = min(max(minimumRate, 1 / 255), 1)
+        let peak = zoneCounts.max() ?? 0
+        guard peak > 0 else { return Array(repeating: minimumRate, count: zoneCounts.count) }
+        let rates = zoneCounts.map { count in
+            minimumRate + (1 - minimumRate) * min(count / (peak * Constants.foveationFullRateDensity), 1)
+        }
+        return rates.indices.map { index in
+            rates[max(index - 1, 0)...min(index + 1, rates.count - 1)].max() ?? rates[index]
+        }
+    }
+
+    /// Limits `descriptor`'s render area to `rateMap`'s physical size, so targets larger than it (the foveated path's
+    /// screen-size ones) are drawn through their physical sub-rect
+    static func limitRenderTargetSize(of descriptor: MTLRenderPassDescriptor, to rateMap: MTLRasterizationRateMap) {
+        let physicalSizes = (0..<max(rateMap.layerCount, 1)).map { rateMap.physicalSize(layer: $0) }
+        descriptor.renderTargetWidth = physicalSizes.map(\.width).max() ?? 0
+        descriptor.renderTargetHeight = physicalSizes.map(\.height).max() ?? 0
+    }
+
+    // MARK: - Private
+
+    private func densityFoveationCache(for viewport: ViewportDescriptor) -> FoveationCache? {
+        guard supportsFoveatedRendering, foveationMinimumRate < 1, packedSplatStore == nil else { return nil }
+        let splatCount = activeSplatBufferForRendering.count
+        guard splatCount > 0, viewport.screenSize.x > 0, viewport.screenSize.y > 0 else { return nil }
+
+        let inverseView = viewport.viewMatrix.inverse
+        let position = inverseView * SIMD4<Float>(0, 0, 0, 1)
+        let forward = inverseView * SIMD4<Float>(0, 0, -1, 0)
+        let cameraPosition = SIMD3(position.x, position.y, position.z)
+        let cameraForward = simd_normalize(SIMD3(forward.x, forward.y, forward.z))
+        let now = CFAbsoluteTimeGetCurrent()
+
+        if let cache = foveationCache,
+           cache.screenSize == viewport.screenSize,
+           cache.minimumRate == foveationMinimumRate,
+           cache.splatCount == splatCount,
+           !Self.shouldRunCameraDrivenUpdate(dirty: false,
+                                             now: now,
+                                             lastUpdateTime: cache.time,
+                                             minimumInterval: foveationRebuildInterval,
+                                             currentPosition: cameraPosition,
+                                             currentForward: cameraForward,
+                                             lastPosition: cache.cameraPosition,
+                                             lastForward: cache.cameraForward,
+                                             positionEpsilon: sortPositionEpsilon,
+                                             directionEpsilon: sortDirectionEpsilon) {
+            return cache
+        }
+
+        let (columns, rows) = projectedSplatCounts(viewport: viewport)
+        let horizontal = Self.foveationRates(zoneCounts: columns, minimumRate: foveationMinimumRate)
+        let vertical = Self.foveationRates(zoneCounts: rows, minimumRate: foveationMinimumRate)
+        let layer = MTLRasterizationRateLayerDescriptor(sampleCount: MTLSize(width: horizontal.count, height: vertical.count, depth: 0),
+                                                        horizontal: horizontal,
+                                                        vertical: vertical)
+        let descriptor = MTLRasterizationRateMapDescriptor(screenSize: MTLSize(width: viewport.screenSize.x,
+                                                                               height: viewport.screenSize.y,
+                                                                               depth: 0),
+                                                           layer: layer)
+        descriptor.label = "Splat Density Rate Map"
+        guard let rateMap = device.makeRasterizationRateMap(descriptor: descriptor),
+              let parameterBuffer = device.makeBuffer(length: max(rateMap.parameterBufferSizeAndAlign.size, 16),
+                                                      options: .storageModeShared) else {
+            Self.log.error("Failed to create a splat density rasterization rate map")
+            return nil
+        }
+        rateMap.copyParameterData(buffer: parameterBuffer, offset: 0)
+
+        let cache = FoveationCache(rateMap: rateMap,
+                                   parameterBuffer: parameterBuffer,
+                                   screenSize: viewport.screenSize,
+                                   minimumRate: foveationMinimumRate,
+                                   splatCount: splatCount,
+                                   cameraPosition: cameraPosition,
+                                   cameraForward: cameraForward,
+                                   time: now)
+        // Same screen size: the new map's physical size fits the old targets
+        if let previous = foveationCache, previous.screenSize == viewport.screenSize {
+            cache.colorTexture = previous.colorTexture
+            cache.depthTexture = previous.depthTexture
+        }
+        foveationCache = cache
+        return cache
+    }
+
+    /// Splats per column and row zone, from an even subsample of the scene projected through `viewport`
+    private func projectedSplatCounts(viewport: ViewportDescriptor) -> (columns: [Float], rows: [Float]) {
+        let zoneCount = FoveationRates.zoneCount
+        var columns = [Float](repeating: 0, count: zoneCount)
+        var rows = [Float](repeating: 0, count: zoneCount)
+        let viewProjection = viewport.projectionMatrix * viewport.viewMatrix
+        activeSplatBufferForRendering.withLockedValues { values, count in
+            let stride = max(count / Constants.foveationDensitySampleCount, 1)
+            for index in Swift.stride(from: 0, to: count, by: stride) {
+                let position = values[index].position
+                let clip = viewProjection * SIMD4<Float>(position.x, position.y, position.z, 1)
+                guard clip.w > 0 else { continue }
+                let ndc = SIMD2(clip.x, clip.y) / clip.w
+                guard abs(ndc.x) <= 1, abs(ndc.y) <= 1 else { continue }
+                let column = min(Int((ndc.x * 0.5 + 0.5) * Float(zoneCount)), zoneCount - 1)
+                let row = min(Int((0.5 - ndc.y * 0.5) * Float(zoneCount)), zoneCount - 1)
+                columns[column] += 1
+                rows[row] += 1
+            }
+        }
+        return (columns, rows)
+    }
+
+    /// Screen-size color (and depth, when the pipelines write it) targets for `cache`'s map, which draws into their
+    /// physical-size sub-rect; a rate map's physical size never exceeds its screen size
+    private func foveationTargets(in cache: FoveationCache) -> (color: MTLTexture, depth: MTLTexture?)? {
+        if let color = cache.colorTexture, depthFormat == .invalid || cache.depthTexture != nil {
+            return (color, cache.depthTexture)
+        }
+        let size = cache.screenSize
+        guard size.x > 0, size.y > 0 else { return nil }
+
+        let colorDescriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: colorFormat,
+                                                                       width: size.x,
+                                                                       height: size.y,
+                                                                       mipmapped: false)
+        colorDescriptor.usage = [.renderTarget, .shaderRead]
+        colorDescriptor.storageMode = .private
+        guard let color = device.makeTexture(descriptor: colorDescriptor) else { return nil }
+        color.label = "Foveated Color"
+
+        var depth: MTLTexture?
+        if depthFormat != .invalid {
+            let depthDescriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: depthFormat,
+                                                                           width: size.x,
+                                                                           height: size.y,
+                                                                           mipmapped: false)
+            depthDescriptor.usage = .renderTarget
+            depthDescriptor.storageMode = .private
+            depth = device.makeTexture(descriptor: depthDescriptor)
+            depth?.label = "Foveated Depth"
+            guard depth != nil else { return nil }
+        }
+        cache.colorTexture = color
+        cache.depthTexture = depth
+        return (color, depth)
+    }
+
+    private func foveatedResolvePipeline() -> MTLRenderPipelineState? {
+        if let foveatedResolvePipelineState {
+            return foveatedResolvePipelineState
+        }
+        guard !foveatedResolvePipelineFailed else { return nil }
+        do {
+            let pipelineDescriptor = MTLRenderPipelineDescriptor()
+            pipelineDescriptor.label = "FoveatedResolvePipeline"
+            pipelineDescriptor.vertexFunction = try library.makeRequiredFunction(name: "foveatedResolveVertexShader")
+            pipelineDescriptor.fragmentFunction = try library.makeRequiredFunction(name: "foveatedResolveFragmentShader")
+            pipelineDescriptor.rasterSampleCount = 1
+
+            let colorAttachment = pipelineDescriptor.colorAttachments[0]
+            colorAttachment?.pixelFormat = colorFormat
+            colorAttachment?.isBlendingEnabled = true
+            colorAttachment?.rgbBlendOperation = .add
+            colorAttachment?.alphaBlendOperation = .add
+            colorAttachment?.sourceRGBBlendFactor = .one
+            colorAttachment?.sourceAlphaBlendFactor = .one
+            colorAttachment?.destinationRGBBlendFactor = .oneMinusSourceAlpha
+            colorAttachment?.destinationAlphaBlendFactor = .oneMinusSourceAlpha
+
+            let pipeline = try pipelineCache.renderPipelineState(descriptor: pipelineDescriptor)
+            foveatedResolvePipelineState = pipeline
+            return pipeline
+        } catch {
+            Self.log.error("Foveated resolve pipeline unavailable, drawing at full rate: \(error.localizedDescription)")
+            foveatedResolvePipelineFailed = true
+            return nil
+        }
+    }
+}
@@ -0,0 +1,94 @@
+import Foundation
+import Metal
+import os
+import SplatIO
+
+// MARK: - GPU Dequantization
+
+extension SplatRenderer {
+    /// A scene in the packed form a `GPUDequantizer` kernel consumes
+    private enum PackedScene {
+        case sogV2(SOGSCompressedDataV2)
+        case spz(SPZSceneReader.PackedStreams)
+
+        var pointCount: Int {
+            switch self {
+            case .sogV2(let data): data.numSplats
+            case .spz(let streams): streams.pointCount
+            }
+        }
+    }
+
+    /// Dequantizes a SOG v2 or SPZ scene straight into `splatBuffer` on the GPU, without building
+    /// `SplatScenePoint`s or `Splat`s on the CPU.
+    ///
+    /// Only used for an empty renderer, so the file maps 1:1 onto the buffer. Higher-order spherical harmonics
+    /// are not uploaded: this renderer shades with the DC color, which is all `Splat` holds.
+    /// - Returns: false if the scene is not in a format or layout the kernels cover; callers fall back to the regular reader
+    func readGPUDequantized(from reader: AutodetectSceneReader, url: URL) async throws -> Bool {
+        guard splatBuffer.count == 0, sourceScenePoints.isEmpty else { return false }
+        guard let scene = packedScene(from: reader.formatReader, url: url), scene.pointCount > 0 else {
+            return false
+        }
+
+        let startTime = CFAbsoluteTimeGetCurrent()
+        let count = scene.pointCount
+        do {
+            try ensureAdditionalCapacity(count)
+        } catch {
+            Self.log.error("Failed to grow buffers: \(error)")
+            throw error
+        }
+
+        if gpuDequantizer == nil {
+            gpuDequantizer = try GPUDequantizer(device: device, library: library)
+        }
+        guard let gpuDequantizer else { return false }
+        switch scene {
+        case .sogV2(let data):
+            try await gpuDequantizer.dequantize(data, into: splatBuffer.buffer)
+        case .spz(let streams):
+            try await gpuDequantizer.dequantize(streams, into: splatBuffer.buffer)
+        }
+        splatBuffer.count = count
+        directPLYSource = DirectPLYSource(url: url, mortonOrdered: false)
+        try splatBufferContentsDidChange()
+
+        let duration = CFAbsoluteTimeGetCurrent() - startTime
+        Self.log.info("GPU-dequantized load of \(count) splats took \(String(format: "%.2f", duration * 1000))ms")
+        return true
+    }
+
+    /// Reads the scene's packed data if its format has a dequantization kernel. Failures are logged and
+    /// reported as nil, so the regular reader gets to handle (or report) the file.
+    private func packedScene(from formatReader: any SplatSceneReader, url: URL) -> PackedScene? {
+        do {
+            if let spzReader = formatReader as? SPZSceneReader {
+                return .spz(try spzReader.readPackedStreams())
+            }
+
+            // Bundles use the v2 reader directly; a meta.json may be v1 or v2
+            let sogReader: SplatSOGSSceneReaderV2
+            if let reader = formatReader as? SplatSOGSSceneReaderV2 {
+                sogReader = reader
+            } else if formatReader is SplatSOGSSceneReader {
+                sogReader = try SplatSOGSSceneReaderV2(url)
+            } else {
+                return nil
+            }
+
+            let data = try sogReader.readCompressedData()
+            guard GPUDequantizer.supports(data) else {
+                Self.log.info("SOG layout not covered by GPU dequantization; using the CPU reader")
+                return nil
+            }
+            return .sogV2(data)
+        } catch SplatSOGSSceneReaderV2.SOGSV2Error.unsupportedVersion, SplatSOGSSceneReaderV2.SOGSV2Error.invalidMetadata {
+            // v1 metadata
+            return nil
+        } catch {
+            Self.log.warning("GPU dequantization unavailable for \(url.lastPathComponent): \(error.localizedDescription)")
+            return nil
+        }
+    }
+}
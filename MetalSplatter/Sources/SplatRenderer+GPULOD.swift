@@ -0,0 +1,143 @@
+import Foundation
+import Metal
+import os
+import simd
+import SplatIO
+
+// MARK: - GPU LOD Selection
+
+extension SplatRenderer {
+    /// One node of an LOD hierarchy evaluated by the GPU LOD stage
+    public struct LODNode: Sendable {
+        /// World-space bounds of the node's splats (and of its children's)
+        public var bounds: AABB
+        /// Index of the parent node, or nil for a root
+        public var parentIndex: Int?
+        /// World-space error of drawing this node's splats instead of its children's.
+        /// Should shrink from parent to child; leaves are never refined, so theirs only matters to their parent.
+        public var geometricError: Float
+
+        public init(bounds: AABB, parentIndex: Int?, geometricError: Float) {
+            self.bounds = bounds
+            self.parentIndex = parentIndex
+            self.geometricError = geometricError
+        }
+    }
+
+    public enum LODHierarchyError: LocalizedError {
+        case invalidParentIndex(node: Int, parent: Int)
+        case invalidNodeIndex(splat: Int, node: Int)
+        case splatCountMismatch(expected: Int, actual: Int)
+
+        public var errorDescription: String? {
+            switch self {
+            case .invalidParentIndex(let node, let parent):
+                return "LOD node \(node) has invalid parent index \(parent)"
+            case .invalidNodeIndex(let splat, let node):
+                return "Splat \(splat) references missing LOD node \(node)"
+            case .splatCountMismatch(let expected, let actual):
+                return "LOD hierarchy covers \(actual) splats, but the scene has \(expected)"
+            }
+        }
+    }
+
+    /// Installs an LOD hierarchy for GPU LOD selection.
+    ///
+    /// While `gpuLODEnabled` is true, each sort first selects nodes on the GPU (frustum test plus
+    /// screen-space error against `lodMaxScreenSpaceError`) and culls splats of unselected nodes, so the
+    /// counting sort and the indirect draw only cover splats that contribute. Applies to counting-sort
+    /// resorts of a single shared order; other sort paths render every splat.
+    ///
+    /// `splatNodeIndices` is in load order, the order splats were added in, like an octree's splat ranges. It is
+    /// mapped through `mortonPermutation`, so Morton-reordered scenes need no extra step; the hierarchy is bound to
+    /// the current splats and skipped once splats are added or removed.
+    /// - Parameters:
+    ///   - nodes: Hierarchy nodes; parents may appear after their children
+    ///   - splatNodeIndices: Node of each splat in load order, one entry per splat currently in the renderer
+    public func setLODHierarchy(nodes: [LODNode], splatNodeIndices: [UInt32]) throws {
+        guard splatNodeIndices.count == splatCount else {
+            throw LODHierarchyError.splatCountMismatch(expected: splatCount, actual: splatNodeIndices.count)
+        }
+        if lodSelector == nil {
+            lodSelector = try GPULODSelector(device: device, library: library)
+        }
+        let currentOrder = mortonPermutation == nil
+            ? splatNodeIndices
+            : (0..<splatCount).map { splatNodeIndices[originalIndex(ofSplatAt: $0)] }
+        try lodSelector?.setHierarchy(nodes: nodes, splatNodeIndices: currentOrder)
+        markSortDataDirty()
+        invalidateRender()
+    }
+
+    /// Removes the LOD hierarchy; sorts return to covering every renderable splat
+    public func clearLODHierarchy() {
+        guard let lodSelector, lodSelector.nodeCount > 0 else { return }
+        lodSelector.clearHierarchy()
+        markSortDataDirty()
+        invalidateRender()
+    }
+
+    /// Whether the next sort should run GPU LOD selection
+    func gpuLODSelector(splatCount: Int, viewStride: Int) -> GPULODSelector? {
+        guard gpuLODEnabled,
+              viewStride == 0,
+              useCountingSort,
+              let lodSelector,
+              lodSelector.nodeCount > 0 else {
+            return nil
+        }
+        guard lodSelector.splatCount == splatCount else {
+            if !lodSelector.reportedSplatCountMismatch {
+                lodSelector.reportedSplatCountMismatch = true
+                Self.log.warning("LOD hierarchy covers \(lodSelector.splatCount) splats but the scene has \(splatCount); skipping GPU LOD")
+            }
+            return nil
+        }
+        return lodSelector
+    }
+}
+
+// MARK: - Octree Hierarchy
+
+extension SplatOctree {
+    /// Flattens the octree into a GPU LOD hierarchy.
+    ///
+    /// Each node's splats are taken from the `splatRange` of its finest LOD level, and its geometric
+    /// error is its bounds diagonal scaled by that level's screen-space error threshold. Ranges index
+    /// the file the octree describes, which is the load order `SplatRenderer.setLODHierarchy` expects.
+    /// A splat in several ranges goes to the deepest of those nodes (at equal depth, the first by ID);
+    /// splats not covered by any range are assigned to the root.
+    public func gpuLODHierarchy(splatCount: Int) -> (nodes: [SplatRenderer.LODNode], splatNodeIndices: [UInt32]) {
+        let orderedIDs = scene.nodes.keys.sorted()
+        var indexByID: [String: Int] = [:]
+        for (index, id) in orderedIDs.enumerated() {
+            indexByID[id] = index
+        }
+
+        var nodes: [SplatRenderer.LODNode] = []
+        nodes.reserveCapacity(orderedIDs.count)
+        var splatNodeIndices = [UInt32](repeating: UInt32(scene.rootNode.flatMap { indexByID[$0.id] } ?? 0),
+                                        count: splatCount)
+        for id in orderedIDs {
+            guard let node = scene.nodes[id] else { continue }
+            let finest = node.lodLevels.first
+            nodes.append(SplatRenderer.LODNode(bounds: node.bounds,
+                                               parentIndex: node.parentID.flatMap { indexByID[$0] },
+                                               geometricError: node.bounds.diagonalLength * (finest?.screenSpaceErrorThreshold ?? 1)))
+        }
+
+        // Shallow nodes first and, at equal depth, later IDs first, so the node that keeps a splat writes last
+        let assignmentOrder = orderedIDs.indices.sorted { lhs, rhs in
+            let lhsDepth = scene.nodes[orderedIDs[lhs]]?.depth ?? 0
+            let rhsDepth = scene.nodes[orderedIDs[rhs]]?.depth ?? 0
+            return lhsDepth != rhsDepth ? lhsDepth < rhsDepth : lhs > rhs
+        }
+        for index in assignmentOrder {
+            guard let range = scene.nodes[orderedIDs[index]]?.lodLevels.first?.splatRange else { continue }
+            for splat in range.clamped(to: 0..<splatCount) {
+                splatNodeIndices[splat] = UInt32(index)
+            }
+        }
+        return (nodes, splatNodeIndices)
+    }
+}
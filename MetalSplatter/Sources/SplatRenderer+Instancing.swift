@@ -0,0 +1,273 @@
+import Foundation
+import Metal
+import simd
+
+// MARK: - Splat Instances
+
+extension SplatRenderer {
+    /// Number of transforms the scene is drawn at; zero when it is drawn once, untransformed
+    public var splatInstanceCount: Int {
+        splatInstanceSet?.transforms.count ?? 0
+    }
+
+    /// Instances kept by the last instanced sort after frustum culling
+    public var visibleSplatInstanceCount: Int {
+        splatInstanceSet?.sortedVisibleInstances.count ?? 0
+    }
+
+    /// Draws the loaded splats once per transform, every instance reading the same `Splat` buffer
+    ///
+    /// Unlike layering copies of a capture, an instance adds a 64-byte transform and no splat data. All visible
+    /// instances are sorted together, by (instance, splat) key, so overlapping instances blend in the right
+    /// order; the sort holds 8 bytes per drawn pair, which `splatInstanceFrustumCullingEnabled` and
+    /// `splatInstanceLODSplatsPerPixel` keep to what is on screen and `splatInstanceSortMemoryBudget` caps. Edit
+    /// states and edit transforms apply to the asset and so show in every instance. Splats draw their
+    /// view-independent base color, which stays right under any instance rotation; `FastSHSplatRenderer`, whose
+    /// spherical harmonics are evaluated for the asset's view direction, doesn't support instances.
+    ///
+    /// Instanced scenes draw with the single-stage blend and one sort for all views, like packed scenes; the
+    /// multi-stage, dithered, mesh-shader and tile paths, GPU frustum culling and GPU LOD are not applied. Calling
+    /// again replaces the transforms; an empty array returns to drawing the scene once.
+    /// - Throws: `SplatRendererError.tooManySplatInstances` when instances × splats overflows the Int32 keys, and
+    ///   `SplatRendererError.splatInstancesUnsupported` on renderers that can't draw instances
+    public func setSplatInstances(_ transforms: [simd_float4x4]) throws {
+        guard !transforms.isEmpty else {
+            removeSplatInstances()
+            return
+        }
+        if let reason = splatInstancesUnsupportedReason {
+            throw SplatRendererError.splatInstancesUnsupported(reason: reason)
+        }
+        guard transforms.count <= SplatInstanceSet.maximumInstanceCount(splatCount: splatCount) else {
+            throw SplatRendererError.tooManySplatInstances(instanceCount: transforms.count, splatCount: splatCount)
+        }
+        if let splatInstanceSet {
+            try splatInstanceSet.updateTransforms(transforms)
+        } else {
+            splatInstanceSet = try SplatInstanceSet(device: device, library: library, transforms: transforms)
+        }
+        invalidateRender()
+    }
+
+    /// Returns to drawing the scene once, untransformed
+    public func removeSplatInstances() {
+        guard splatInstanceSet != nil else { return }
+        splatInstanceSet = nil
+        markSortDataDirty()
+        invalidateRender()
+    }
+
+    /// Culls and sorts the instances for the camera when needed, then draws their (instance, splat) keys
+    internal func renderSplatInstances(_ instanceSet: SplatInstanceSet,
+                                       viewports: [ViewportDescriptor],
+                                       colorTexture: MTLTexture,
+                                       colorLoadAction: MTLLoadAction,
+                                       colorStoreAction: MTLStoreAction,
+                                       depthTexture: MTLTexture?,
+                                       depthStoreAction: MTLStoreAction,
+                                       rasterizationRateMap: MTLRasterizationRateMap?,
+                                       renderTargetArrayLength: Int,
+                                       to commandBuffer: MTLCommandBuffer) throws {
+        let activeViewports = Array(viewports.prefix(maxViewCount))
+        guard let firstViewport = activeViewports.first,
+              let bounds = getBounds() ?? getBoundsBlocking() else { return }
+
+        let splatCount = self.splatCount
+        let maximumInstanceCount = SplatInstanceSet.maximumInstanceCount(splatCount: splatCount)
+        var transforms = instanceSet.transforms
+        if transforms.count > maximumInstanceCount {
+            // The scene grew after the instances were set; draw the instances whose keys still fit
+            Self.log.warning("Drawing \(maximumInstanceCount) of \(transforms.count) splat instances; the rest overflow Int32 sort keys")
+            transforms.removeLast(transforms.count - maximumInstanceCount)
+        }
+
+        // One order for every view, sorted from the eyes' midpoint as in `StereoSortMode.midpoint`
+        var cameraPosition = SIMD3<Float>.zero
+        var cameraForward = SIMD3<Float>.zero
+        for viewport in activeViewports {
+            let inverseView = viewport.viewMatrix.inverse
+            let position = inverseView * SIMD4<Float>(0, 0, 0, 1)
+            let forward = inverseView * SIMD4<Float>(0, 0, -1, 0)
+            cameraPosition += SIMD3(position.x, position.y, position.z)
+            cameraForward += SIMD3(forward.x, forward.y, forward.z)
+        }
+        cameraPosition /= Float(activeViewports.count)
+        cameraForward = simd_normalize(cameraForward)
+
+        let projectionScale = firstViewport.isOrthographic
+            ? 0
+            : Float(firstViewport.screenSize.y) * firstViewport.projectionMatrix[1][1] / 2
+        let culledInstances = SplatInstanceSet.visibleInstances(
+            transforms: transforms,
+            bounds: bounds,
+            viewProjections: splatInstanceFrustumCullingEnabled
+                ? activeViewports.map { $0.projectionMatrix * $0.viewMatrix }
+                : [],
+            cameraPosition: cameraPosition,
+            projectionScale: projectionScale,
+            splatCount: splatCount,
+            splatsPerPixel: splatInstanceLODSplatsPerPixel
+        )
+        let visibleInstances = SplatInstanceSet.fittingSortBudget(
+            culledInstances,
+            splatCount: splatCount,
+            maximumPairCount: splatInstanceSortMemoryBudget / SplatInstanceSet.sortBytesPerPair
+        )
+        if visibleInstances != culledInstances && !instanceSet.reportedSortBudgetOverflow {
+            instanceSet.reportedSortBudgetOverflow = true
+            Self.log.warning("Visible splat instances exceed splatInstanceSortMemoryBudget; coarsening to \(visibleInstances.count) of \(culledInstances.count) instances")
+        }
+        try instanceSet.encodeSortIfNeeded(commandBuffer: commandBuffer,
+                                           splatBuffer: activeSplatBufferForRendering.buffer,
+                                           editStateBuffer: visibilityFilteringEditStateBuffer,
+                                           splatCount: splatCount,
+                                           dataRevision: getSortDataRevision(),
+                                           visibleInstances: visibleInstances,
+                                           cameraPosition: cameraPosition,
+                                           cameraForward: cameraForward,
+                                           sortByDistance: sortingMode != .linear,
+                                           positionEpsilon: sortPositionEpsilon * governedSettings.sortEpsilonScale,
+                                           directionEpsilon: sortDirectionEpsilon * governedSettings.sortEpsilonScale)
+
+        let drawKeyCount = instanceSet.drawKeyCount
+        guard drawKeyCount > 0, let sortedKeyBuffer = instanceSet.sortedKeyBuffer else { return }
+        let indexedSplatCount = min(drawKeyCount, Constants.maxIndexedSplatCount)
+        let instanceCount = (drawKeyCount + indexedSplatCount - 1) / indexedSplatCount
+
+        switchToNextDynamicBuffer()
+        for (index, viewport) in activeViewports.enumerated() {
+            var viewUniforms = makeUniforms(for: viewport,
+                                            splatCount: UInt32(drawKeyCount),
+                                            indexedSplatCount: UInt32(indexedSplatCount),
+                                            debugFlags: debugOptions.rawValue,
+                                            foveationRates: rasterizationRateMap.map { FoveationRates($0, layer: index) })
+            viewUniforms.instanceSplatCount = UInt32(splatCount)
+            viewUniforms.instanceCount = UInt32(transforms.count)
+            uniforms.pointee.setUniforms(index: index, viewUniforms)
+        }
+
+        let bindEditingResources = shouldBindEditingResources
+            && editStateBuffer != nil
+            && editTransformIndexBuffer != nil
+            && editTransformPaletteBuffer != nil
+        let (pipelineState, depthState) = try splatInstancePipelineStates(for: instanceSet, editing: bindEditingResources)
+
+        let indexCount = indexedSplatCount * 6
+        if indexBuffer.count < indexCount {
+            if indexBuffer.capacity < indexCount {
+                indexBufferPool.release(indexBuffer)
+                indexBuffer = try indexBufferPool.acquire(minimumCapacity: indexCount)
+            }
+            indexBuffer.count = indexCount
+            for i in 0..<indexedSplatCount {
+                indexBuffer.values[i * 6 + 0] = UInt32(i * 4 + 0)
+                indexBuffer.values[i * 6 + 1] = UInt32(i * 4 + 1)
+                indexBuffer.values[i * 6 + 2] = UInt32(i * 4 + 2)
+                indexBuffer.values[i * 6 + 3] = UInt32(i * 4 + 1)
+                indexBuffer.values[i * 6 + 4] = UInt32(i * 4 + 2)
+                indexBuffer.values[i * 6 + 5] = UInt32(i * 4 + 3)
+            }
+        }
+
+        guard let renderEncoder = renderEncoder(multiStage: false,
+                                                viewports: activeViewports,
+                                                colorTexture: colorTexture,
+                                                colorLoadAction: colorLoadAction,
+                                                colorStoreAction: colorStoreAction,
+                                                depthTexture: depthTexture,
+                                                depthStoreAction: depthStoreAction,
+                                                rasterizationRateMap: rasterizationRateMap,
+                                                renderTargetArrayLength: renderTargetArrayLength,
+                                                for: commandBuffer) else {
+            throw SplatRendererError.failedToCreateRenderEncoder
+        }
+
+        renderEncoder.pushDebugGroup("Draw Splat Instances")
+        renderEncoder.setRenderPipelineState(pipelineState)
+        renderEncoder.setDepthStencilState(depthState)
+        renderEncoder.setVertexBuffer(dynamicUniformBuffers, offset: uniformBufferOffset, index: BufferIndex.uniforms.rawValue)
+        renderEncoder.setVertexBuffer(activeSplatBufferForRendering.buffer, offset: 0, index: BufferIndex.splat.rawValue)
+        renderEncoder.setVertexBuffer(sortedKeyBuffer, offset: 0, index: BufferIndex.sortedIndices.rawValue)
+        renderEncoder.setVertexBuffer(instanceSet.transformBuffer, offset: 0, index: BufferIndex.instanceTransforms.rawValue)
+        if bindEditingResources {
+            renderEncoder.setVertexBuffer(editStateBuffer, offset: 0, index: BufferIndex.editState.rawValue)
+            renderEncoder.setVertexBuffer(editTransformIndexBuffer, offset: 0, index: BufferIndex.transformIndex.rawValue)
+            renderEncoder.setVertexBuffer(editTransformPaletteBuffer, offset: 0, index: BufferIndex.transformPalette.rawValue)
+        }
+        renderEncoder.drawIndexedPrimitives(type: .triangle,
+                                            indexCount: indexCount,
+                                            indexType: .uint32,
+                                            indexBuffer: indexBuffer.buffer,
+                                            indexBufferOffset: 0,
+                                            instanceCount: instanceCount)
+        renderEncoder.popDebugGroup()
+        renderEncoder.endEncoding()
+    }
+
+    /// Same blend and depth setup as the single-stage pipeline, with the instanced vertex shader
+    private func splatInstancePipelineStates(for instanceSet: SplatInstanceSet,
+                                             editing: Bool) throws -> (MTLRenderPipelineState, MTLDepthStencilState) {
+        if let pipelineState = editing ? instanceSet.editingPipelineState : instanceSet.pipelineState,
+           let depthState = instanceSet.depthState {
+            return (pipelineState, depthState)
+        }
+
+        let label = editing ? "InstancedSplatEditingPipeline" : "InstancedSplatPipeline"
+        let functionConstants = MTLFunctionConstantValues()
+        var use2DGSValue = use2DGSMode
+        functionConstants.setConstantValue(&use2DGSValue, type: .bool, index: 12)
+
+        let pipelineDescriptor = MTLRenderPipelineDescriptor()
+        pipelineDescriptor.label = label
+        pipelineDescriptor.vertexFunction = try library.makeFunction(
+            name: editing ? "instancedSplatVertexShaderEditing" : "instancedSplatVertexShader",
+            constantValues: functionConstants
+        )
+        guard let fragmentFunction = library.makeFunction(name: "singleStageSplatFragmentShader") else {
+            throw SplatRendererError.failedToLoadShaderFunction(name: "singleStageSplatFragmentShader")
+        }
+        pipelineDescriptor.fragmentFunction = fragmentFunction
+        pipelineDescriptor.rasterSampleCount = sampleCount
+
+        let colorAttachment = pipelineDescriptor.colorAttachments[0]
+        colorAttachment?.pixelFormat = colorFormat
+        colorAttachment?.isBlendingEnabled = true
+        colorAttachment?.rgbBlendOperation = .add
+        colorAttachment?.alphaBlendOperation = .add
+        colorAttachment?.sourceRGBBlendFactor = .one
+        colorAttachment?.sourceAlphaBlendFactor = .one
+        colorAttachment?.destinationRGBBlendFactor = .oneMinusSourceAlpha
+        colorAttachment?.destinationAlphaBlendFactor = .oneMinusSourceAlpha
+
+        pipelineDescriptor.depthAttachmentPixelFormat = depthFormat
+        pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
+
+        let pipelineState: MTLRenderPipelineState
+        do {
+            pipelineState = try pipelineCache.renderPipelineState(descriptor: pipelineDescriptor)
+        } catch {
+            throw SplatRendererError.failedToCreateRenderPipelineState(label: label, underlying: error)
+        }
+
+        let depthState: MTLDepthStencilState
+        if let existingDepthState = instanceSet.depthState {
+            depthState = existingDepthState
+        } else {
+            let depthStateDescriptor = MTLDepthStencilDescriptor()
+            depthStateDescriptor.depthCompareFunction = .always
+            depthStateDescriptor.isDepthWriteEnabled = depthFormat != .invalid
+            guard let newDepthState = device.makeDepthStencilState(descriptor: depthStateDescriptor) else {
+                throw SplatRendererError.failedToCreateDepthStencilState
+            }
+            depthState = newDepthState
+        }
+
+        if editing {
+            instanceSet.editingPipelineState = pipelineState
+        } else {
+            instanceSet.pipelineState = pipelineState
+        }
+        instanceSet.depthState = depthState
+        return (pipelineState, depthState)
+    }
+}
@@ -0,0 +1,188 @@
+import Foundation
+import Metal
+import simd
+import os
+import SplatIO
+
+// MARK: - Packed Splat Storage
+
+extension SplatRenderer {
+    /// Bytes of packed splat data resident on the GPU; zero unless a packed scene is loaded
+    public var packedSplatStorageByteCount: Int {
+        packedSplatStore?.storageByteCount ?? 0
+    }
+
+    /// Replaces the scene with ChunkedSplatFormat chunks, kept packed on the GPU rather than expanded to `Splat`s
+    ///
+    /// Packed scenes are drawn with the single-stage blend and sorted with the counting sort, one order for all
+    /// views. They are view-only: splat editing, animation, culling, LOD, and the mesh-shader, multi-stage and
+    /// tile paths need the `Splat` buffer and are not applied. Call `reset()` before adding regular splats.
+    /// - Throws: `SplatRendererError.invalidPackedSplatChunk` unless every chunk but the last holds
+    ///   `SplatCompression.chunkSize` splats
+    public func loadPackedSplats(_ chunks: [SplatChunk]) throws {
+        reset()
+        guard !chunks.isEmpty else { return }
+        packedSplatStore = try PackedSplatStore(device: device, library: library, chunks: chunks)
+        invalidateRender()
+    }
+
+    /// Packs points into chunks (Morton-ordered first when `mortonOrderingEnabled`, which keeps chunk bounds tight)
+    /// and loads them with `loadPackedSplats(_:)`
+    public func loadPackedSplats(_ points: [SplatScenePoint]) throws {
+        let orderedPoints = mortonOrderingEnabled && points.count > 1 ? MortonOrder.reorder(points) : points
+        try loadPackedSplats(PackedSplatStore.chunks(for: orderedPoints))
+    }
+
+    func readPacked(from reader: AutodetectSceneReader) async throws {
+        var newPoints = SplatMemoryBuffer()
+        try await newPoints.read(from: reader)
+        try loadPackedSplats(newPoints.points)
+    }
+
+    /// Sorts the packed scene when the camera has moved, then draws it
+    internal func renderPackedSplats(_ store: PackedSplatStore,
+                                     viewports: [ViewportDescriptor],
+                                     colorTexture: MTLTexture,
+                                     colorLoadAction: MTLLoadAction,
+                                     colorStoreAction: MTLStoreAction,
+                                     depthTexture: MTLTexture?,
+                                     depthStoreAction: MTLStoreAction,
+                                     rasterizationRateMap: MTLRasterizationRateMap?,
+                                     renderTargetArrayLength: Int,
+                                     to commandBuffer: MTLCommandBuffer) throws {
+        let activeViewports = Array(viewports.prefix(maxViewCount))
+        guard !activeViewports.isEmpty else { return }
+
+        let splatCount = store.splatCount
+        let indexedSplatCount = min(splatCount, Constants.maxIndexedSplatCount)
+        let instanceCount = (splatCount + indexedSplatCount - 1) / indexedSplatCount
+
+        switchToNextDynamicBuffer()
+        for (index, viewport) in activeViewports.enumerated() {
+            uniforms.pointee.setUniforms(index: index, makeUniforms(for: viewport,
+                                                                   splatCount: UInt32(splatCount),
+                                                                   indexedSplatCount: UInt32(indexedSplatCount),
+                                                                   debugFlags: debugOptions.rawValue,
+                                                                   foveationRates: rasterizationRateMap.map { FoveationRates($0, layer: index) }))
+        }
+
+        // One order for every view, sorted from the eyes' midpoint as in `StereoSortMode.midpoint`
+        var cameraPosition = SIMD3<Float>.zero
+        var cameraForward = SIMD3<Float>.zero
+        for viewport in activeViewports {
+            let inverseView = viewport.viewMatrix.inverse
+            let position = inverseView * SIMD4<Float>(0, 0, 0, 1)
+            let forward = inverseView * SIMD4<Float>(0, 0, -1, 0)
+            cameraPosition += SIMD3(position.x, position.y, position.z)
+            cameraForward += SIMD3(forward.x, forward.y, forward.z)
+        }
+        try store.encodeSortIfNeeded(commandBuffer: commandBuffer,
+                                     cameraPosition: cameraPosition / Float(activeViewports.count),
+                                     cameraForward: simd_normalize(cameraForward),
+                                     sortByDistance: sortingMode != .linear,
+                                     positionEpsilon: sortPositionEpsilon * governedSettings.sortEpsilonScale,
+                                     directionEpsilon: sortDirectionEpsilon * governedSettings.sortEpsilonScale,
+                                     useCameraRelativeBinning: useCameraRelativeBinning)
+
+        let (pipelineState, depthState) = try packedSplatPipelineStates(for: store)
+
+        let indexCount = indexedSplatCount * 6
+        if indexBuffer.count < indexCount {
+            if indexBuffer.capacity < indexCount {
+                indexBufferPool.release(indexBuffer)
+                indexBuffer = try indexBufferPool.acquire(minimumCapacity: indexCount)
+            }
+            indexBuffer.count = indexCount
+            for i in 0..<indexedSplatCount {
+                indexBuffer.values[i * 6 + 0] = UInt32(i * 4 + 0)
+                indexBuffer.values[i * 6 + 1] = UInt32(i * 4 + 1)
+                indexBuffer.values[i * 6 + 2] = UInt32(i * 4 + 2)
+                indexBuffer.values[i * 6 + 3] = UInt32(i * 4 + 1)
+                indexBuffer.values[i * 6 + 4] = UInt32(i * 4 + 2)
+                indexBuffer.values[i * 6 + 5] = UInt32(i * 4 + 3)
+            }
+        }
+
+        guard let renderEncoder = renderEncoder(multiStage: false,
+                                                viewports: activeViewports,
+                                                colorTexture: colorTexture,
+                                                colorLoadAction: colorLoadAction,
+                                                colorStoreAction: colorStoreAction,
+                                                depthTexture: depthTexture,
+                                                depthStoreAction: depthStoreAction,
+                                                rasterizationRateMap: rasterizationRateMap,
+                                                renderTargetArrayLength: renderTargetArrayLength,
+                                                for: commandBuffer) else {
+            throw SplatRendererError.failedToCreateRenderEncoder
+        }
+
+        renderEncoder.pushDebugGroup("Draw Packed Splats")
+        renderEncoder.setRenderPipelineState(pipelineState)
+        renderEncoder.setDepthStencilState(depthState)
+        renderEncoder.setVertexBuffer(dynamicUniformBuffers, offset: uniformBufferOffset, index: BufferIndex.uniforms.rawValue)
+        renderEncoder.setVertexBuffer(store.packedSplatBuffer, offset: 0, index: BufferIndex.splat.rawValue)
+        renderEncoder.setVertexBuffer(store.sortedIndexBuffer, offset: 0, index: BufferIndex.sortedIndices.rawValue)
+        renderEncoder.setVertexBuffer(store.chunkHeaderBuffer, offset: 0, index: BufferIndex.chunkHeaders.rawValue)
+        renderEncoder.drawIndexedPrimitives(type: .triangle,
+                                            indexCount: indexCount,
+                                            indexType: .uint32,
+                                            indexBuffer: indexBuffer.buffer,
+                                            indexBufferOffset: 0,
+                                            instanceCount: instanceCount)
+        renderEncoder.popDebugGroup()
+        renderEncoder.endEncoding()
+    }
+
+    /// Same blend and depth setup as the single-stage pipeline, with the packed vertex shader
+    private func packedSplatPipelineStates(for store: PackedSplatStore) throws -> (MTLRenderPipelineState, MTLDepthStencilState) {
+        if let pipelineState = store.pipelineState, let depthState = store.depthState {
+            return (pipelineState, depthState)
+        }
+
+        let label = "PackedSplatPipeline"
+        let functionConstants = MTLFunctionConstantValues()
+        var use2DGSValue = use2DGSMode
+        functionConstants.setConstantValue(&use2DGSValue, type: .bool, index: 12)
+
+        let pipelineDescriptor = MTLRenderPipelineDescriptor()
+        pipelineDescriptor.label = label
+        pipelineDescriptor.vertexFunction = try library.makeFunction(name: "packedSplatVertexShader",
+                                                                     constantValues: functionConstants)
+        guard let fragmentFunction = library.makeFunction(name: "singleStageSplatFragmentShader") else {
+            throw SplatRendererError.failedToLoadShaderFunction(name: "singleStageSplatFragmentShader")
+        }
+        pipelineDescriptor.fragmentFunction = fragmentFunction
+        pipelineDescriptor.rasterSampleCount = sampleCount
+
+        let colorAttachment = pipelineDescriptor.colorAttachments[0]
+        colorAttachment?.pixelFormat = colorFormat
+        colorAttachment?.isBlendingEnabled = true
+        colorAttachment?.rgbBlendOperation = .add
+        colorAttachment?.alphaBlendOperation = .add
+        colorAttachment?.sourceRGBBlendFactor = .one
+        colorAttachment?.sourceAlphaBlendFactor = .one
+        colorAttachment?.destinationRGBBlendFactor = .oneMinusSourceAlpha
+        colorAttachment?.destinationAlphaBlendFactor = .oneMinusSourceAlpha
+
+        pipelineDescriptor.depthAttachmentPixelFormat = depthFormat
+        pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
+
+        let pipelineState: MTLRenderPipelineState
+        do {
+            pipelineState = try pipelineCache.renderPipelineState(descriptor: pipelineDescriptor)
+        } catch {
+            throw SplatRendererError.failedToCreateRenderPipelineState(label: label, underlying: error)
+        }
+
+        let depthStateDescriptor = MTLDepthStencilDescriptor()
+        depthStateDescriptor.depthCompareFunction = .always
+        depthStateDescriptor.isDepthWriteEnabled = depthFormat != .invalid
+        guard let depthState = device.makeDepthStencilState(descriptor: depthStateDescriptor) else {
+            throw SplatRendererError.failedToCreateDepthStencilState
+        }
+
+        store.pipelineState = pipelineState
+        store.depthState = depthState
+        return (pipelineState, depthState)
+    }
+}
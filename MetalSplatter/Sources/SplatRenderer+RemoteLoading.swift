@@ -0,0 +1,125 @@
+import Foundation
+import os
+import SplatIO
+
+// MARK: - Remote Loading
+
+extension SplatRenderer {
+    /// Reads an http(s) scene with `remoteSceneLoader`. PLY and `.splat` scenes are added in growing batches while
+    /// the body downloads, so the first splats can draw after the header and first batch. Other formats, and scenes
+    /// a whole-file path of `read(from:)` would take (see `readsRemoteSceneWhole(_:)`), are read from a complete
+    /// local copy through the regular `read(from:)` paths.
+    func readRemote(from url: URL) async throws {
+        guard RemoteSceneLoader.supportsStreaming(url), !readsRemoteSceneWhole(url) else {
+            let local = try await remoteSceneLoader.localFile(for: url)
+            defer {
+                if local.isTemporary {
+                    try? FileManager.default.removeItem(at: local.url)
+                }
+            }
+            try await read(from: local.url)
+            return
+        }
+
+        let startTime = CFAbsoluteTimeGetCurrent()
+        let adder = ProgressiveSceneAdder(renderer: self,
+                                          initialBatchSize: max(initialRemoteBatchSize, 1),
+                                          maximumBatchSize: max(maximumRemoteBatchSize, initialRemoteBatchSize, 1))
+        let sceneRenderMode = try await remoteSceneLoader.read(from: url, to: adder)
+        if let error = adder.error {
+            throw error
+        }
+        renderMode = Self.renderMode(from: sceneRenderMode)
+        let duration = CFAbsoluteTimeGetCurrent() - startTime
+        Self.log.info("Streamed \(adder.addedCount) splats from \(url.lastPathComponent, privacy: .public) in \(adder.batchCount) batch(es), \(String(format: "%.2f", duration * 1000))ms")
+    }
+
+    /// Whether `read(from:)` would load the scene at `url` from the whole file rather than point by point: packed
+    /// storage, or a direct PLY load into an empty renderer. Streaming that scene would bypass the option, so it is
+    /// downloaded first instead; turn `directPLYLoadingEnabled` off to stream PLY scenes into an empty renderer.
+    /// GPU dequantization covers SOG v2 and SPZ, which are never streamed.
+    private func readsRemoteSceneWhole(_ url: URL) -> Bool {
+        if packedSplatStorageEnabled {
+            return true
+        }
+        let isEmpty = splatBuffer.count == 0 && sourceScenePoints.isEmpty
+        return directPLYLoadingEnabled && isEmpty && url.pathExtension.lowercased() == "ply"
+    }
+}
+
+/// Collects streamed points and adds them to the renderer in batches that double from `initialBatchSize` up to
+/// `maximumBatchSize`: the first batch lands quickly, later ones amortize the per-`add` sort and Morton work.
+/// Callbacks arrive serially on the reader's thread.
+private final class ProgressiveSceneAdder: SplatSceneReaderDelegate, @unchecked Sendable {
+    private let renderer: SplatRenderer
+    private let maximumBatchSize: Int
+    private var batchSize: Int
+    private var pending = SplatPointBatch()
+    private(set) var error: Error?
+    private(set) var addedCount = 0
+    private(set) var batchCount = 0
+
+    init(renderer: SplatRenderer, initialBatchSize: Int, maximumBatchSize: Int) {
+        self.renderer = renderer
+        self.batchSize = initialBatchSize
+        self.maximumBatchSize = maximumBatchSize
+    }
+
+    func didStartReading(withPointCount pointCount: UInt32?) {
+        // Grow once up front when the header knows the total, instead of once per batch
+        guard let pointCount, error == nil else { return }
+        do {
+            try renderer.ensureAdditionalCapacity(Int(pointCount))
+        } catch {
+            self.error = error
+        }
+    }
+
+    func didRead(points: [SplatScenePoint]) {
+        guard error == nil, !points.isEmpty else { return }
+        if pending.isEmpty {
+            pending = SplatPointBatch(points)
+        } else {
+            pending.append(contentsOf: points)
+        }
+        flushIfNeeded()
+    }
+
+    func didRead(batch: SplatPointBatch) {
+        guard error == nil, !batch.isEmpty else { return }
+        if pending.isEmpty {
+            pending = batch
+        } else {
+            pending.append(contentsOf: batch)
+        }
+        flushIfNeeded()
+    }
+
+    func didFinishReading() {
+        flush()
+    }
+
+    func didFailReading(withError error: Error?) {
+        // Keep what already arrived on screen; the loader throws the failure
+        flush()
+    }
+
+    private func flushIfNeeded() {
+        if pending.count >= batchSize {
+            flush()
+            batchSize = min(batchSize * 2, maximumBatchSize)
+        }
+    }
+
+    private func flush() {
+        guard error == nil, !pending.isEmpty else { return }
+        do {
+            try renderer.add(pending)
+            addedCount += pending.count
+            batchCount += 1
+        } catch {
+            self.error = error
+        }
+        pending = SplatPointBatch()
+    }
+}
@@ -0,0 +1,213 @@
+import Foundation
+import Metal
+import os
+import simd
+
+// MARK: - Stereo Sorting
+
+extension SplatRenderer {
+    /// How the sort camera is chosen when rendering two viewports (e.g. visionOS stereo)
+    public enum StereoSortMode: Sendable {
+        /// Sort for the first viewport; the second eye reuses that order
+        case primaryView
+        /// Sort once from the midpoint between the eyes. If the shared order's measured error for either
+        /// eye exceeds `stereoSortErrorThreshold`, sorts switch to a separate order per eye until it recovers.
+        case midpoint
+    }
+
+    /// Stereo sort quality and reuse counters, accumulated since the last `resetStereoSortStatistics()`
+    public struct StereoSortStatistics: Sendable {
+        /// Fraction of sampled neighbouring splat pairs drawn in the wrong order for each eye by the last shared sort
+        /// (while per-eye sorting is active, the estimated error a shared midpoint order would have)
+        public var leftEyeError: Float = 0
+        public var rightEyeError: Float = 0
+        /// True while sorts produce a separate order for each eye
+        public var perEyeSortActive = false
+        public var sharedSortCount = 0
+        public var perEyeSortCount = 0
+        /// Stereo frames rendered
+        public var renderedFrameCount = 0
+        /// Stereo frames drawn with an order published during an earlier frame
+        public var reusedFrameCount = 0
+
+        public init() {}
+
+        /// Fraction of stereo frames that reused an earlier sort
+        public var sortReuseRatio: Double {
+            renderedFrameCount > 0 ? Double(reusedFrameCount) / Double(renderedFrameCount) : 0
+        }
+    }
+
+    struct StereoSortEye: Sendable {
+        var position: SIMD3<Float>
+        var forward: SIMD3<Float>
+    }
+
+    /// Eye poses and output layout captured when a stereo sort starts
+    struct StereoSortContext: Sendable {
+        let left: StereoSortEye
+        let right: StereoSortEye
+        /// Camera the shared order was sorted for (the left eye when sorting per eye)
+        let sortCamera: StereoSortEye
+        let sortByDistance: Bool
+        /// Offset of the right eye's order in the output buffer, or 0 if both eyes share one order
+        let viewStride: Int
+
+        var isPerEye: Bool { viewStride > 0 }
+    }
+
+    /// Neighbouring pairs sampled per sort when measuring stereo error
+    private static let stereoErrorSampleCount = 2048
+    /// Consecutive over-threshold sorts required before switching to per-eye sorting
+    private static let stereoPerEyeEntrySortCount = 2
+
+    public var stereoSortStatistics: StereoSortStatistics {
+        os_unfair_lock_lock(&stereoSortLock)
+        defer { os_unfair_lock_unlock(&stereoSortLock) }
+        return stereoSortState
+    }
+
+    public func resetStereoSortStatistics() {
+        os_unfair_lock_lock(&stereoSortLock)
+        let perEyeSortActive = stereoSortState.perEyeSortActive
+        stereoSortState = StereoSortStatistics()
+        stereoSortState.perEyeSortActive = perEyeSortActive
+        os_unfair_lock_unlock(&stereoSortLock)
+    }
+
+    /// Whether the next sort should produce a separate order per eye
+    var stereoPerEyeSortActive: Bool {
+        os_unfair_lock_lock(&stereoSortLock)
+        defer { os_unfair_lock_unlock(&stereoSortLock) }
+        return stereoSortState.perEyeSortActive
+    }
+
+    /// Counts a rendered stereo frame, and whether it reuses an order published before the previous frame
+    func recordStereoFrame() {
+        os_unfair_lock_lock(&stereoSortLock)
+        stereoSortState.renderedFrameCount += 1
+        if !sortPublishedSinceLastStereoFrame {
+            stereoSortState.reusedFrameCount += 1
+        }
+        sortPublishedSinceLastStereoFrame = false
+        os_unfair_lock_unlock(&stereoSortLock)
+    }
+
+    /// Measures the published order against both eyes and decides whether the next sort should be per eye.
+    /// Called from sort completion; `sortTime` is the GPU time of the sort when available.
+    func updateStereoSortState(sortedIndices: MetalBuffer<Int32>, context: StereoSortContext, sortTime: TimeInterval) {
+        let orderCount = sortedIndices.count
+        let order = UnsafeBufferPointer(start: UnsafePointer(sortedIndices.values), count: orderCount)
+
+        let errors: (left: Float, right: Float) = activeSplatBufferForRendering.withLockedValues { values, count in
+            let position: (Int) -> SIMD3<Float> = { index in
+                let packed = values[index].position
+                return SIMD3(packed.x, packed.y, packed.z)
+            }
+            if context.isPerEye {
+                // Each eye already has an exact order; estimate what a shared midpoint order would get wrong
+                // from how much the two eye orders disagree
+                let crossError = Self.stereoOrderingError(sortedIndices: order,
+                                                          splatCount: count,
+                                                          position: position,
+                                                          sortCamera: context.left,
+                                                          eye: context.right,
+                                                          sortByDistance: context.sortByDistance,
+                                                          maxSamples: Self.stereoErrorSampleCount)
+                return (crossError * 0.5, crossError * 0.5)
+            }
+            let left = Self.stereoOrderingError(sortedIndices: order,
+                                                splatCount: count,
+                                                position: position,
+                                                sortCamera: context.sortCamera,
+                                                eye: context.left,
+                                                sortByDistance: context.sortByDistance,
+                                                maxSamples: Self.stereoErrorSampleCount)
+            let right = Self.stereoOrderingError(sortedIndices: order,
+                                                 splatCount: count,
+                                                 position: position,
+                                                 sortCamera: context.sortCamera,
+                                                 eye: context.right,
+                                                 sortByDistance: context.sortByDistance,
+                                                 maxSamples: Self.stereoErrorSampleCount)
+            return (left, right)
+        }
+
+        let threshold = stereoSortErrorThreshold
+        let budget = stereoPerEyeSortBudget
+        let allowPerEye = stereoSortMode == .midpoint
+
+        os_unfair_lock_lock(&stereoSortLock)
+        stereoSortState.leftEyeError = errors.left
+        stereoSortState.rightEyeError = errors.right
+        let wasPerEye = stereoSortState.perEyeSortActive
+        if context.isPerEye {
+            stereoSortState.perEyeSortCount += 1
+            // Hysteresis: only return to the shared order once it would be comfortably under the threshold
+            if !allowPerEye || max(errors.left, errors.right) < threshold * 0.5 || sortTime > budget {
+                stereoSortState.perEyeSortActive = false
+            }
+            stereoErrorStreak = 0
+        } else {
+            stereoSortState.sharedSortCount += 1
+            if max(errors.left, errors.right) > threshold {
+                stereoErrorStreak += 1
+            } else {
+                stereoErrorStreak = 0
+            }
+            // Per-eye sorting doubles the sort cost; only switch if two sorts fit the budget
+            if allowPerEye && stereoErrorStreak >= Self.stereoPerEyeEntrySortCount && sortTime * 2 <= budget {
+                stereoSortState.perEyeSortActive = true
+                stereoErrorStreak = 0
+            }
+        }
+        let isPerEye = stereoSortState.perEyeSortActive
+        os_unfair_lock_unlock(&stereoSortLock)
+
+        if isPerEye != wasPerEye {
+            Self.log.debug("Stereo sort switched to \(isPerEye ? "per-eye" : "shared") order (error L=\(errors.left) R=\(errors.right))")
+            markSortDirtyWithoutRevisionChange()
+        }
+    }
+
+    /// Estimates how often an order sorted for `sortCamera` is wrong for `eye`.
+    ///
+    /// Samples up to `maxSamples` neighbouring pairs of `sortedIndices` and returns the fraction whose depth order
+    /// under `eye` disagrees with their depth order under `sortCamera`. Comparing against the sort camera's own
+    /// depths, rather than the stored order, keeps sort precision (e.g. counting-sort bins) out of the metric.
+    static func stereoOrderingError(sortedIndices: UnsafeBufferPointer<Int32>,
+                                    splatCount: Int,
+                                    position: (Int) -> SIMD3<Float>,
+                                    sortCamera: StereoSortEye,
+                                    eye: StereoSortEye,
+                                    sortByDistance: Bool,
+                                    maxSamples: Int) -> Float {
+        let pairCount = sortedIndices.count - 1
+        guard pairCount > 0, maxSamples > 0 else { return 0 }
+
+        func depth(_ point: SIMD3<Float>, _ camera: StereoSortEye) -> Float {
+            sortByDistance
+                ? simd_length_squared(point - camera.position)
+                : simd_dot(point - camera.position, camera.forward)
+        }
+
+        let step = max(1, pairCount / maxSamples)
+        var compared = 0
+        var disagreements = 0
+        for pair in stride(from: 0, to: pairCount, by: step) {
+            let a = Int(sortedIndices[pair])
+            let b = Int(sortedIndices[pair + 1])
+            guard a >= 0, a < splatCount, b >= 0, b < splatCount else { continue }
+            let pointA = position(a)
+            let pointB = position(b)
+            let sortDelta = depth(pointA, sortCamera) - depth(pointB, sortCamera)
+            let eyeDelta = depth(pointA, eye) - depth(pointB, eye)
+            guard sortDelta != 0 || eyeDelta != 0 else { continue }
+            compared += 1
+            if sortDelta * eyeDelta < 0 {
+                disagreements += 1
+            }
+        }
+        return compared > 0 ? Float(disagreements) / Float(compared) : 0
+    }
+}
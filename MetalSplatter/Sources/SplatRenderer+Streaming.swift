@@ -0,0 +1,216 @@
+import Foundation
+import Metal
+import simd
+import os
+
+// MARK: - Streamed Octree Scenes
+
+/// Where each drawn slab lives in the renderer's splat buffer. Every slab takes one page of `pageCapacity` splats and
+/// keeps it while it stays drawn, so a residency change only copies slabs new to the draw and clears the pages of
+/// slabs that left it. Splats past a slab's count, and cleared pages, are zeroed: transparent and zero-sized.
+internal struct StreamingDrawLayout {
+    struct Change {
+        /// Indices into the residency's slabs, and the page each is copied to
+        var copies: [(slab: Int, page: Int)] = []
+        /// Pages to zero
+        var clears: [Int] = []
+
+        var isEmpty: Bool { copies.isEmpty && clears.isEmpty }
+    }
+
+    let pageCapacity: Int
+    private var pagesByID: [UInt64: Int] = [:]
+    /// Sorted descending, so `popLast` hands out the lowest free page
+    private var freePages: [Int] = []
+    private(set) var pageCount = 0
+
+    init(pageCapacity: Int) {
+        self.pageCapacity = max(pageCapacity, 1)
+    }
+
+    /// Splats the renderer draws: every page up to the last one in use
+    var splatCount: Int { pageCount * pageCapacity }
+
+    /// Places the slabs identified by `ids`, keeping the pages of those already placed
+    mutating func place(_ ids: [UInt64]) -> Change {
+        var change = Change()
+        let drawn = Set(ids)
+        for (id, page) in pagesByID where !drawn.contains(id) {
+            pagesByID[id] = nil
+            freePages.append(page)
+        }
+        freePages.sort(by: >)
+        let freedPages = Set(freePages)
+
+        var reused = Set<Int>()
+        for (index, id) in ids.enumerated() where pagesByID[id] == nil {
+            let page: Int
+            if let free = freePages.popLast() {
+                page = free
+                reused.insert(free)
+            } else {
+                page = pageCount
+                pageCount += 1
+            }
+            pagesByID[id] = page
+            change.copies.append((slab: index, page: page))
+        }
+
+        // Free pages at the end are dropped from the draw instead of cleared
+        while let last = freePages.first, last == pageCount - 1 {
+            freePages.removeFirst()
+            pageCount -= 1
+        }
+        change.clears = freedPages.subtracting(reused).filter { $0 < pageCount }.sorted()
+        return change
+    }
+}
+
+/// Render-thread state of a streamed scene: the manager, whether its `update` is running, and the
+/// newest residency it published
+internal final class StreamingScene: @unchecked Sendable {
+    let manager: StreamingLODManager
+    /// Generation of the residency copied into `splatBuffer`; only touched from `render`
+    var appliedGeneration: UInt64?
+    /// Pages of `splatBuffer`; only touched from `render`
+    var layout: StreamingDrawLayout
+    /// Copies changed slabs into `splatBuffer`, apart from the frames' queues
+    let uploadQueue: MTLCommandQueue?
+
+    private let lock = NSLock()
+    private var isUpdating = false
+    private var latestResidency: StreamingLODManager.StreamingResidency?
+
+    init(manager: StreamingLODManager, device: MTLDevice) {
+        self.manager = manager
+        self.layout = StreamingDrawLayout(pageCapacity: manager.splatPool.slabCapacity)
+        self.uploadQueue = device.makeCommandQueue()
+        uploadQueue?.label = "Streaming Slab Uploads"
+    }
+
+    /// False while the previous update is still running
+    func beginUpdate() -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !isUpdating else { return false }
+        isUpdating = true
+        return true
+    }
+
+    func finishUpdate(publishing residency: StreamingLODManager.StreamingResidency) {
+        lock.lock()
+        latestResidency = residency
+        isUpdating = false
+        lock.unlock()
+    }
+
+    /// The newest residency unless it is already applied
+    func unappliedResidency() -> StreamingLODManager.StreamingResidency? {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let latestResidency, latestResidency.generation != appliedGeneration else { return nil }
+        return latestResidency
+    }
+}
+
+extension SplatRenderer {
+    /// Draws `manager`'s octree, streamed within its memory budget, in place of the current scene; nil stops streaming
+    ///
+    /// Each frame hands the first viewport's camera to `StreamingLODManager.update`, which runs off the render
+    /// thread; one update is in flight at a time. When an update changes which slabs are resident and visible, the
+    /// next frame blits the slabs that joined the draw into the splat buffer on the GPU, clears those that left it,
+    /// and resorts. The splat buffer holds one slab-sized page per visible slab, so it takes up to the pool's slab
+    /// limit: `manager.memoryBudget` covers both, half for pool slabs (including slabs evicted but not yet recycled)
+    /// and half for this copy. Streamed scenes are view-only, like packed scenes: splat editing and animation need
+    /// source points, which streamed payloads don't keep.
+    public func setStreamingLODManager(_ manager: StreamingLODManager?) {
+        reset()
+        streamingScene = manager.map { StreamingScene(manager: $0, device: device) }
+        invalidateRender()
+    }
+
+    /// Streams `octree` within `memoryBudget` bytes: pool slabs plus the renderer's copy of the visible ones; see
+    /// `setStreamingLODManager(_:)`
+    /// - Parameter remotePayloadURL: Remote `.splat` file inline LOD levels are range-fetched from
+    @discardableResult
+    public func streamOctree(_ octree: SplatOctree, memoryBudget: Int, remotePayloadURL: URL? = nil) -> StreamingLODManager {
+        octree.memoryBudget = memoryBudget
+        let manager = StreamingLODManager(octree: octree, device: device, remotePayloadURL: remotePayloadURL)
+        setStreamingLODManager(manager)
+        return manager
+    }
+
+    /// The manager set with `setStreamingLODManager(_:)`
+    public var streamingLODManager: StreamingLODManager? {
+        streamingScene?.manager
+    }
+
+    /// Applies the newest published residency, then schedules the next update for this frame's camera
+    internal func updateStreamingScene(_ scene: StreamingScene, viewports: [ViewportDescriptor]) throws {
+        if let residency = scene.unappliedResidency() {
+            try applyStreamingResidency(residency, to: scene)
+            scene.appliedGeneration = residency.generation
+        }
+
+        guard let viewport = viewports.first, scene.beginUpdate() else { return }
+        let viewProjection = viewport.projectionMatrix * viewport.viewMatrix
+        let cameraPosition = viewport.viewMatrix.inverse.columns.3
+        let screenHeight = Float(viewport.viewport.height)
+        Task.detached(priority: .userInitiated) { [weak self] in
+            await scene.manager.update(viewProjectionMatrix: viewProjection,
+                                       cameraPosition: SIMD3(cameraPosition.x, cameraPosition.y, cameraPosition.z),
+                                       screenHeight: screenHeight)
+            scene.finishUpdate(publishing: await scene.manager.residency())
+            self?.invalidateRender()
+        }
+    }
+
+    /// Blits slabs that joined the draw into their `splatBuffer` pages and zeroes the pages of slabs that left it.
+    /// Waits for the copy, which covers only the change, so the sort and every later reader see the new contents.
+    private func applyStreamingResidency(_ residency: StreamingLODManager.StreamingResidency, to scene: StreamingScene) throws {
+        let change = scene.layout.place(residency.slabs.map(\.id))
+        let pageCapacity = scene.layout.pageCapacity
+        // Sized once to the pool's slab limit, the share of the budget reserved for this copy
+        let slabLimit = scene.manager.splatPool.maxSlabs
+        try splatBuffer.ensureCapacity(max(slabLimit, scene.layout.pageCount) * pageCapacity)
+        // Visibility flipped back before this frame: the pages already hold the draw
+        guard !change.isEmpty || splatBuffer.count != scene.layout.splatCount else { return }
+
+        if !change.isEmpty {
+            guard let commandBuffer = scene.uploadQueue?.makeCommandBuffer() else {
+                throw SplatRendererError.failedToCreateCommandBuffer
+            }
+            commandBuffer.label = "Streaming Residency \(residency.generation)"
+            guard let blitEncoder = commandBuffer.makeBlitCommandEncoder() else {
+                throw SplatRendererError.failedToCreateComputeEncoder
+            }
+            let stride = MemoryLayout<Splat>.stride
+            let pageBytes = pageCapacity * stride
+            let target = splatBuffer.buffer
+            for (slabIndex, page) in change.copies {
+                let slab = residency.slabs[slabIndex]
+                let count = min(slab.count, pageCapacity)
+                let pageStart = page * pageBytes
+                blitEncoder.copy(from: slab.buffer, sourceOffset: 0,
+                                 to: target, destinationOffset: pageStart,
+                                 size: count * stride)
+                if count < pageCapacity {
+                    blitEncoder.fill(buffer: target, range: (pageStart + count * stride)..<(pageStart + pageBytes), value: 0)
+                }
+            }
+            for page in change.clears {
+                blitEncoder.fill(buffer: target, range: (page * pageBytes)..<((page + 1) * pageBytes), value: 0)
+            }
+            blitEncoder.endEncoding()
+            commandBuffer.commit()
+            commandBuffer.waitUntilCompleted()
+            if let error = commandBuffer.error {
+                Self.log.error("Streaming residency copy failed: \(error.localizedDescription)")
+            }
+        }
+
+        splatBuffer.count = scene.layout.splatCount
+        try splatBufferContentsDidChange()
+        Self.log.debug("Streaming residency \(residency.generation): \(residency.slabs.count) slab(s), \(change.copies.count) copied, \(change.clears.count) cleared")
+    }
+}
@@ -23,6 +23,14 @@ public enum SplatRendererError: LocalizedError {
     case failedToCreateRenderEncoder
     case failedToCreateComputeEncoder
     case internalPipelineMismatch(expected: String, actual: String)
+    case invalidPackedSplatChunk(index: Int)
+    case tooManySplatInstances(instanceCount: Int, splatCount: Int)
+    case splatInstancesUnsupported(reason: String)
+    case failedToCreateCommandBuffer
+    case failedToCreateSharedEvent
+    case invalidBatchConfiguration(reason: String)
+    case batchFrameFailed(index: Int, underlying: Error?)
+    case failedToWriteImage(url: URL)
 
     public var errorDescription: String? {
         switch self {
@@ -50,6 +58,22 @@ public enum SplatRendererError: LocalizedError {
             return "Failed to create Metal compute command encoder"
         case .internalPipelineMismatch(let expected, let actual):
             return "Internal pipeline mismatch: expected \(expected), but useMultiStagePipeline=\(actual)"
+        case .invalidPackedSplatChunk(let index):
+            return "Packed splat chunk \(index) is empty, or not full while not the last chunk"
+        case .tooManySplatInstances(let instanceCount, let splatCount):
+            return "\(instanceCount) instances of \(splatCount) splats exceed the Int32 range of instanced sort keys"
+        case .splatInstancesUnsupported(let reason):
+            return "Splat instances are unsupported: \(reason)"
+        case .failedToCreateCommandBuffer:
+            return "Failed to create Metal command buffer"
+        case .failedToCreateSharedEvent:
+            return "Failed to create Metal shared event"
+        case .invalidBatchConfiguration(let reason):
+            return "Invalid batch render: \(reason)"
+        case .batchFrameFailed(let index, let underlying):
+            return "Batch frame \(index) failed on the GPU" + (underlying.map { ": \($0.localizedDescription)" } ?? "")
+        case .failedToWriteImage(let url):
+            return "Failed to write image to \(url.path)"
         }
     }
 }
@@ -88,6 +112,7 @@ public class SplatRenderer: @unchecked Sendable {
     internal enum SortPath: String, Sendable {
         case metal4
         case counting
+        case incremental
         case mps
         case cpu
     }
@@ -105,6 +130,8 @@ public class SplatRenderer: @unchecked Sendable {
         let interactionMode: Bool
         let sortByDistance: Bool
         let status: String
+        /// Fraction of adjacent pairs still out of order after an incremental refinement
+        var residualInversionRatio: Double? = nil
 
         var overheadTime: TimeInterval? {
             gpuTime.map { max(0, wallTime - $0) }
@@ -115,12 +142,13 @@ public class SplatRenderer: @unchecked Sendable {
             let gpuMs = gpuTime.map { Self.formatMilliseconds($0) } ?? "n/a"
             let overheadMs = overheadTime.map { Self.formatMilliseconds($0) } ?? "n/a"
             let mainQueueMs = mainQueueDelay.map { Self.formatMilliseconds($0) } ?? "n/a"
+            let residual = residualInversionRatio.map { String(format: " residualInversions=%.4f", $0) } ?? ""
             return "Sort performance path=\(path.rawValue) " +
                 "splats=\(splatCount) renderable=\(renderableCount) " +
                 "wallMs=\(Self.formatMilliseconds(wallTime)) callbackWallMs=\(callbackWallMs) " +
                 "gpuMs=\(gpuMs) overheadMs=\(overheadMs) mainQueueMs=\(mainQueueMs) " +
                 "inFlightStart=\(inFlightSortsAtStart) inFlightEnd=\(inFlightSortsAtCompletion) " +
-                "interaction=\(interactionMode) sortByDistance=\(sortByDistance) status=\(status)"
+                "interaction=\(interactionMode) sortByDistance=\(sortByDistance) status=\(status)" + residual
         }
 
         private static func formatMilliseconds(_ duration: TimeInterval) -> String {
@@ -135,6 +163,8 @@ public class SplatRenderer: @unchecked Sendable {
         let inFlightSortsAtStart: Int
         let interactionMode: Bool
         let sortByDistance: Bool
+        /// Set when `sortPathTuner` picked the path; the sort's time is reported back to it
+        var tunerTrial: SortPathTuner.Trial? = nil
 
         func makeSample(
             wallTime: TimeInterval,
@@ -142,7 +172,8 @@ public class SplatRenderer: @unchecked Sendable {
             gpuTime: TimeInterval?,
             mainQueueDelay: TimeInterval?,
             inFlightSortsAtCompletion: Int,
-            status: String
+            status: String,
+            residualInversionRatio: Double? = nil
         ) -> SortPerformanceSample {
             SortPerformanceSample(
                 path: path,
@@ -156,7 +187,8 @@ public class SplatRenderer: @unchecked Sendable {
                 inFlightSortsAtCompletion: inFlightSortsAtCompletion,
                 interactionMode: interactionMode,
                 sortByDistance: sortByDistance,
-                status: status
+                status: status,
+                residualInversionRatio: residualInversionRatio
             )
         }
     }
@@ -177,6 +209,11 @@ public class SplatRenderer: @unchecked Sendable {
         static let maxRenderDistance: Float = 100.0
         static let lodDistanceThresholds: [Float] = [10.0, 25.0, 50.0]
         static let lodSkipFactors: [Int] = [1, 2, 4, 8] // Skip every Nth splat based on distance
+
+        // Foveation: splats projected to build a density rate map, and the share of the busiest zone's count
+        // that keeps a zone at full rate
+        static let foveationDensitySampleCount = 4096
+        static let foveationFullRateDensity: Float = 0.25
     }
 
     internal static let log =
@@ -220,8 +257,9 @@ public class SplatRenderer: @unchecked Sendable {
     
     // Frustum culling buffers and state
     private var visibleIndicesBuffer: MTLBuffer?
-    private var visibleCountBuffer: MTLBuffer?
-    private var frustumCullDataBuffer: MTLBuffer?
+    private var visibleCountBuffer: MTLBuffer?  // GPU-only; feeds the indirect draw arguments
+    // One visible-count slot per in-flight frame (indexed like the uniform buffers), read in completed handlers
+    private var visibleCountReadbackBuffer: MTLBuffer?
     private var indirectDrawArgsBuffer: MTLBuffer?  // For GPU-driven indirect draw
     private var generateIndirectArgsPipelineState: MTLComputePipelineState?
     private var resetVisibleCountPipelineState: MTLComputePipelineState?
@@ -234,7 +272,11 @@ public class SplatRenderer: @unchecked Sendable {
         }
     }
     public var cameraDrivenFrustumCullingEnabled: Bool = true
+    // Published from culling completed handlers (guarded by frustumCullStatsLock)
     private var lastVisibleCount: Int = 0
+    private var lastVisibleCountSerial: UInt64 = 0
+    private var frustumCullSerial: UInt64 = 0
+    private var frustumCullStatsLock = os_unfair_lock()
     private var lastFrustumCullCameraPosition: SIMD3<Float>?
     private var lastFrustumCullCameraForward: SIMD3<Float>?
     private var lastFrustumCullProjectionMatrix: simd_float4x4?
@@ -271,7 +313,7 @@ public class SplatRenderer: @unchecked Sendable {
     public private(set) var renderRevision: UInt64 = 0
     public private(set) var lastRenderedRevision: UInt64 = 0
     public var needsRender: Bool {
-        renderRevision != lastRenderedRevision || isSorting
+        renderRevision != lastRenderedRevision || isSorting || !compilingPipelineGroups.isEmpty
     }
 
     public func invalidateRender() {
@@ -328,6 +370,8 @@ public class SplatRenderer: @unchecked Sendable {
         case editState      = 4
         case transformIndex = 5
         case transformPalette = 6
+        case chunkHeaders   = 7  // Chunk headers for packed splat storage
+        case instanceTransforms = 8  // Per-instance transforms for instanced scenes
     }
 
     // Keep in sync with Shaders.metal : Uniforms
@@ -347,14 +391,16 @@ public class SplatRenderer: @unchecked Sendable {
         var debugFlags: UInt32
         var renderMode: UInt32
         var isOrthographic: UInt32
-        var padding1: UInt32
+        var instanceSplatCount: UInt32     // Splats per instance in an instanced scene; keys are instance * this + splat
         var lodThresholds: SIMD3<Float>
         var covarianceBlur: Float
         var selectionTintColor: SIMD4<Float>
         var editingEnabled: UInt32
-        var padding2: UInt32
-        var padding3: UInt32
-        var padding4: UInt32
+        var sortedIndexViewOffset: UInt32  // Start of this view's order in sortedIndices (per-eye sorting)
+        var foveationEnabled: UInt32       // Nonzero when drawing through a rasterization rate map
+        var instanceCount: UInt32          // Bound instance transforms (instanced scenes only)
+        var foveationRatesX: SIMD4<UInt32> // Zone rates, unorm8-packed; see FoveationRates
+        var foveationRatesY: SIMD4<UInt32>
     }
 
     // Keep in sync with Shaders.metal : UniformsArray
@@ -458,7 +504,7 @@ public class SplatRenderer: @unchecked Sendable {
 #if targetEnvironment(simulator)
         false
 #else
-        writeDepth && highQualityDepth
+        writeDepth && highQualityDepth && !governedSettings.singleStageDepth
 #endif
     }
 
@@ -473,6 +519,57 @@ public class SplatRenderer: @unchecked Sendable {
     public var onRenderStart: (() -> Void)?
     public var onRenderComplete: ((TimeInterval) -> Void)?
     public var onFrameReady: ((FrameStatistics) -> Void)?
+
+    /// Called on the sort's completion thread with its telemetry (used by the benchmark harness)
+    internal var sortPerformanceObserver: ((SortPerformanceSample) -> Void)?
+    /// When true, camera-driven resorts use the CPU sort (used by the benchmark harness)
+    internal var prefersCPUSorting = false
+
+    /// Records GPU timestamps at each stage boundary (cull, precompute, SH evaluation, sort keys, sort passes, draw,
+    /// postprocess) plus CPU encode time for the last `frameTimelineCapacity` frames, readable through
+    /// `recentFrameTimelines()`, and emits os_signpost intervals for frame encoding and main-queue hops.
+    /// Has no effect on GPUs without stage-boundary counter sampling; costs nothing while off.
+    public var frameTimelineEnabled = false {
+        didSet {
+            if frameTimelineEnabled != oldValue {
+                updateFrameTimelineRecorder()
+            }
+        }
+    }
+
+    /// Frames kept by the timeline; changing it while enabled starts a new timeline
+    public var frameTimelineCapacity = 120 {
+        didSet {
+            if frameTimelineEnabled && frameTimelineCapacity != oldValue {
+                updateFrameTimelineRecorder()
+            }
+        }
+    }
+
+    internal private(set) var frameTimelineRecorder: FrameTimelineRecorder?
+
+    /// Timelines of the most recent frames, oldest first; empty while `frameTimelineEnabled` is off
+    public func recentFrameTimelines() -> [FrameTimeline] {
+        frameTimelineRecorder?.recentFrames ?? []
+    }
+
+    /// When true, multi-stage, dithered and mesh shader pipelines compile on background threads and frames draw with
+    /// the single-stage pipeline until they're ready, instead of stalling the first frame on the compile.
+    /// All pipelines load from a binary archive in the caches directory when an earlier launch compiled them.
+    public var asynchronousPipelineCompilation = true
+
+    /// Bytes the renderer's buffer heaps and sort scratch arena reserve (`MTLHeap.currentAllocatedSize`), whether or
+    /// not their space is in use; compare with `MTLDevice.currentAllocatedSize` for everything else
+    public var heapAllocatedSize: Int {
+        splatBufferPool.heapAllocatedSize
+            + sortScratchHeap.currentAllocatedSize
+            + privateBufferHeap.currentAllocatedSize
+    }
+
+    /// Writes newly compiled pipelines to the on-disk archive now, rather than shortly after they compile
+    public func savePipelineCache() {
+        pipelineCache.save()
+    }
     
     public var debugOptions: DebugOptions = [] {
         didSet {
@@ -515,6 +612,9 @@ public class SplatRenderer: @unchecked Sendable {
     public var animationConfiguration: SplatAnimationConfiguration? {
         didSet {
             guard animationConfiguration != oldValue else { return }
+            if animationConfiguration != nil {
+                materializeSourcePointsIfNeeded()
+            }
             refreshAnimationSceneMetricsIfNeeded()
             animationDirty = true
             markRenderableSetDirty()
@@ -539,6 +639,154 @@ public class SplatRenderer: @unchecked Sendable {
     /// Scenes with more splats than this will use parallel processing.
     public var mortonParallelThreshold: Int = 100_000
 
+    /// Morton-sort each batch on the GPU as it is added, in place of the CPU ordering `mortonOrderingEnabled`
+    /// selects. The splat buffer is reordered together with the edit-state and transform-index buffers, and
+    /// `mortonPermutation` records where every splat came from. `FastSHSplatRenderer` loads are ordered the same
+    /// way, and their SH buffers are built in the new order. A batch is ordered on the CPU instead when the GPU
+    /// stage is unavailable or fails, so the scene is Morton ordered either way.
+    public var gpuMortonReorderEnabled: Bool = false
+
+    /// After Morton reordering, on the CPU or the GPU, splat `i` is the `mortonPermutation[i]`th splat in the order
+    /// the scene was added. Nil while no reorder has run (the order is the load order). Cleared when the scene is
+    /// reset or replaced with new points; editor edits that keep, append or drop splats carry it along.
+    public internal(set) var mortonPermutation: [UInt32]? {
+        didSet { inverseMortonPermutation = nil }
+    }
+    internal var inverseMortonPermutation: [UInt32]?
+    internal var mortonReorderer: GPUMortonReorderer?
+
+    // MARK: - Direct PLY Loading
+
+    /// When true, `read(from:)` decodes fixed-layout binary little-endian PLY files straight into the
+    /// splat buffer, skipping the intermediate scene point representation. Files with other layouts,
+    /// and renderers that already hold splats, use the regular reader.
+    public var directPLYLoadingEnabled: Bool = true
+
+    /// Set while the renderer holds a directly-loaded scene whose `sourceScenePoints` have not been built yet
+    internal var directPLYSource: DirectPLYSource?
+
+    /// Trailing source points added as columnar batches, kept columnar until animation or an edit needs
+    /// `sourceScenePoints`; see `materializeSourcePointsIfNeeded()`
+    internal var pendingSourceBatch: SplatPointBatch?
+
+    // MARK: - GPU Dequantization
+
+    /// When true, `read(from:)` uploads SOG v2 and SPZ scenes in their packed form and dequantizes them into
+    /// the splat buffer on the GPU, instead of decoding every point on the CPU. Splats keep their file order
+    /// (no Morton reordering). Renderers that already hold splats, and layouts the kernels don't cover, use
+    /// the regular reader.
+    public var gpuDequantizationEnabled: Bool = false
+
+    /// Created by the first GPU-dequantized load
+    internal var gpuDequantizer: GPUDequantizer?
+
+    // MARK: - Packed Splat Storage
+
+    /// When true, `read(from:)` keeps the scene on the GPU as ChunkedSplatFormat `PackedSplat`s (about 16 bytes
+    /// per splat instead of 28), decoded on the fly by the packed vertex shader and sort kernels. See
+    /// `loadPackedSplats(_:)` for what a packed scene supports.
+    public var packedSplatStorageEnabled: Bool = false
+
+    /// The resident packed scene; while set, it is drawn instead of `splatBuffer`
+    internal var packedSplatStore: PackedSplatStore?
+
+    // MARK: - Streamed Scenes
+
+    /// While set, `splatBuffer` holds the streamed octree's visible resident slabs; see `setStreamingLODManager(_:)`
+    internal var streamingScene: StreamingScene?
+
+    // MARK: - Splat Instances
+
+    /// While set, `splatBuffer` is drawn once per instance transform; see `setSplatInstances(_:)`
+    internal var splatInstanceSet: SplatInstanceSet?
+
+    /// Why `setSplatInstances(_:)` is refused, for subclasses whose draw path ignores instances
+    internal var splatInstancesUnsupportedReason: String? { nil }
+
+    /// Skips instances whose transformed scene bounds lie outside the view
+    public var splatInstanceFrustumCullingEnabled = true {
+        didSet { invalidateRender() }
+    }
+
+    /// Per-instance LOD budget: distant instances keep every 2nd, 4th … 16th splat while they still draw at least
+    /// this many splats per pixel they cover. Zero draws every splat of every instance.
+    public var splatInstanceLODSplatsPerPixel: Float = 4 {
+        didSet { invalidateRender() }
+    }
+
+    /// Most bytes the instanced sort's distance and key buffers may hold, 8 per kept (instance, splat) pair.
+    /// When the visible instances need more, their LOD strides coarsen and then the last ones are skipped.
+    public var splatInstanceSortMemoryBudget: Int = 512 * 1024 * 1024 {
+        didSet { invalidateRender() }
+    }
+
+    // MARK: - Remote Loading
+
+    /// Fetches the http(s) URLs passed to `read(from:)`, with its ETag-validated disk cache. PLY and `.splat`
+    /// scenes are added in batches while they download; other formats, and scenes that packed storage or a direct
+    /// PLY load would take, are read once the body is complete.
+    public var remoteSceneLoader = RemoteSceneLoader()
+
+    /// Splats in the first batch added from a streamed remote scene; each later batch doubles, up to
+    /// `maximumRemoteBatchSize`
+    public var initialRemoteBatchSize: Int = 16_384
+    public var maximumRemoteBatchSize: Int = 262_144
+
+    // MARK: - Quality Governor
+
+    /// When set, each frame's GPU, sort and encode times are reported to the governor, and its current level's
+    /// settings overlay the sort, SH, LOD, footprint, depth and transparency knobs. The knobs themselves are left as
+    /// configured, so clearing the governor restores them.
+    public var qualityGovernor: SplatQualityGovernor? {
+        didSet {
+            if qualityGovernor !== oldValue {
+                appliedGovernorGeneration = nil
+                invalidateRender()
+            }
+        }
+    }
+
+    /// Settings of the governor level in effect; `.full` without a governor
+    internal private(set) var governedSettings = SplatQualityGovernor.Settings.full
+    /// `covarianceBlur` scaled by the governor level in effect, as frames and selection queries project splats
+    internal var governedCovarianceBlur: Float {
+        covarianceBlur * governedSettings.covarianceBlurScale
+    }
+    private var appliedGovernorGeneration: UInt64?
+
+    // MARK: - Foveated Rendering
+
+    /// Rate `makeSplatDensityRateMap(for:)` gives screen regions without splats; 1 turns density foveation off
+    public var foveationMinimumRate: Float = 0.25
+
+    /// Seconds between density rate map rebuilds while the camera moves
+    public var foveationRebuildInterval: TimeInterval = 0.1
+
+    internal var foveationCache: FoveationCache?
+    internal var foveatedResolvePipelineState: MTLRenderPipelineState?
+    internal var foveatedResolvePipelineFailed = false
+    /// Replaces `clearColor` for passes whose output is composited afterwards
+    internal var clearColorOverride: MTLClearColor?
+
+    /// The scene pass of `renderFoveated`, drawn through `rasterizationRateMap` when it is set; subclasses with their
+    /// own draw path override it so foveated frames use that path too
+    internal func renderFoveatedScene(viewport: ViewportDescriptor,
+                                      colorTexture: MTLTexture,
+                                      colorLoadAction: MTLLoadAction,
+                                      colorStoreAction: MTLStoreAction,
+                                      depthTexture: MTLTexture?,
+                                      rasterizationRateMap: MTLRasterizationRateMap?,
+                                      to commandBuffer: MTLCommandBuffer) throws {
+        try render(viewports: [viewport],
+                   colorTexture: colorTexture,
+                   colorLoadAction: colorLoadAction,
+                   colorStoreAction: colorStoreAction,
+                   depthTexture: depthTexture,
+                   rasterizationRateMap: rasterizationRateMap,
+                   renderTargetArrayLength: 0,
+                   to: commandBuffer)
+    }
+
     // MARK: - Dithered Transparency (Order-Independent)
 
     /// When true, uses stochastic (dithered) transparency instead of sorted alpha blending.
@@ -566,6 +814,11 @@ public class SplatRenderer: @unchecked Sendable {
         }
     }
 
+    /// Whether frames draw dithered: `useDitheredTransparency`, or a quality governor level that asks for it
+    internal var drawsDitheredTransparency: Bool {
+        useDitheredTransparency || governedSettings.ditheredTransparency
+    }
+
     // MARK: - 2DGS Rendering Mode
 
     /// When true, uses simplified 2D Gaussian splat rendering instead of full 3D covariance projection.
@@ -591,6 +844,41 @@ public class SplatRenderer: @unchecked Sendable {
         }
     }
 
+    // MARK: - Front-to-Back Multi-Stage Blending
+
+    /// When true, the multi-stage pipeline (`highQualityDepth` with a depth target) draws splats nearest-first
+    /// and blends with the "under" operator, so tile memory tracks accumulated transmittance.
+    ///
+    /// Once a pixel's transmittance falls below `frontToBackTransmittanceEpsilon`, later fragments on it are
+    /// discarded before shading. This pays off when most fragments land on pixels that are already opaque
+    /// (e.g. interior scans); the result matches back-to-front blending up to the epsilon.
+    ///
+    /// The sorted order is read in reverse, so no extra sort is needed. GPU LOD draws cover the full
+    /// renderable range in this mode instead of the indirect survivor count.
+    public var multiStageFrontToBack: Bool = false {
+        didSet {
+            if multiStageFrontToBack != oldValue {
+                invalidatePipelineStates()
+                invalidateRender()
+            }
+        }
+    }
+
+    /// Transmittance below which front-to-back blending stops shading a pixel. Default is one 8-bit step.
+    public var frontToBackTransmittanceEpsilon: Float = 1.0 / 255.0 {
+        didSet {
+            if frontToBackTransmittanceEpsilon != oldValue && multiStageFrontToBack {
+                invalidatePipelineStates()
+                invalidateRender()
+            }
+        }
+    }
+
+    /// Whether the current multi-stage draw blends front-to-back
+    internal var drawsMultiStageFrontToBack: Bool {
+        useMultiStagePipeline && multiStageFrontToBack
+    }
+
     public var sortPositionEpsilon: Float = 0.01
     public var sortDirectionEpsilon: Float = 0.0001  // ~0.5-1° rotation (reduced from 0.001 to fix flickering during rotation)
     public var minimumSortInterval: TimeInterval = 0
@@ -657,7 +945,14 @@ public class SplatRenderer: @unchecked Sendable {
     /// Computed adaptive sort interval based on recent frame performance.
     /// Respects interaction mode (minimumSortInterval is already adjusted there).
     private var effectiveMinimumSortInterval: TimeInterval {
-        let configuredMinimumInterval = minimumSortInterval
+        var configuredMinimumInterval = minimumSortInterval
+        if isInteracting && incrementalSortKeepingUp {
+            configuredMinimumInterval = min(configuredMinimumInterval, incrementalMinimumSortInterval)
+        }
+        if let qualityGovernor, governedSettings.sortIntervalFrames > 0 {
+            configuredMinimumInterval = max(configuredMinimumInterval,
+                                            Double(governedSettings.sortIntervalFrames) * qualityGovernor.targetFrameTime)
+        }
         var interval = configuredMinimumInterval
 
         guard adaptiveSortFrequencyEnabled else { return interval }
@@ -686,6 +981,32 @@ public class SplatRenderer: @unchecked Sendable {
     /// exceeds this value, radial sorting is preferred. Range: 0.0 to 1.0
     public var autoSortModeRotationBias: Float = 0.5
 
+    /// Sort camera selection for two-viewport rendering. See `StereoSortMode`.
+    public var stereoSortMode: StereoSortMode = .midpoint {
+        didSet {
+            if stereoSortMode != oldValue {
+                markSortDirtyWithoutRevisionChange()
+            }
+        }
+    }
+
+    /// Fraction of sampled neighbouring pairs the shared midpoint order may draw wrongly for either eye
+    /// before sorts switch to a per-eye order
+    public var stereoSortErrorThreshold: Float = 0.01
+
+    /// Largest sort time (GPU time when available) at which per-eye sorting is used. Per-eye sorting
+    /// runs two sorts, so it is entered only when twice the last shared sort fits; the default leaves
+    /// room for rendering at 90 Hz.
+    public var stereoPerEyeSortBudget: TimeInterval = 0.004
+
+    // Stereo sort state, protected by stereoSortLock
+    internal var stereoSortLock = os_unfair_lock()
+    internal var stereoSortState = StereoSortStatistics()
+    internal var stereoErrorStreak = 0
+    internal var sortPublishedSinceLastStereoFrame = false
+    /// Eye poses for the current frame when rendering two viewports
+    private var stereoSortEyes: (left: StereoSortEye, right: StereoSortEye)?
+
     /// Previous camera position for motion tracking (used in auto mode)
     private var previousCameraPosition: SIMD3<Float>?
 
@@ -771,8 +1092,8 @@ public class SplatRenderer: @unchecked Sendable {
     internal var selectionOutlinePipelineState: MTLRenderPipelineState?
     internal var selectionOutlineDepthState: MTLDepthStencilState?
     // Dithered transparency pipeline (order-independent, no sorting required)
-    private var ditheredPipelineState: MTLRenderPipelineState?
-    private var ditheredEditingPipelineState: MTLRenderPipelineState?
+    internal var ditheredPipelineState: MTLRenderPipelineState?
+    internal var ditheredEditingPipelineState: MTLRenderPipelineState?
     private var ditheredDepthState: MTLDepthStencilState?
     // Multi-stage pipeline
     private var initializePipelineState: MTLRenderPipelineState?
@@ -782,25 +1103,107 @@ public class SplatRenderer: @unchecked Sendable {
     private var postprocessPipelineState: MTLRenderPipelineState?
     private var postprocessDepthState: MTLDepthStencilState?
 
+    // Binary-archive-backed pipeline compilation, shared by renderers on the same device
+    internal let pipelineCache: PipelineCache
+    private enum PipelineGroup: Hashable, Sendable {
+        case multiStage
+        case dithered
+        case meshShader
+    }
+    private enum PipelineDescriptor {
+        case render(MTLRenderPipelineDescriptor)
+        case tile(MTLTileRenderPipelineDescriptor)
+        case mesh(MTLMeshRenderPipelineDescriptor)
+    }
+    /// A background compile's results, in the order its descriptors were submitted
+    private struct CompiledPipelineGroup: @unchecked Sendable {
+        let group: PipelineGroup
+        let generation: UInt64
+        let results: [Result<MTLRenderPipelineState, Error>]
+    }
+    /// Collects a group's completion handler results, which arrive on Metal's compiler threads
+    private final class PipelineCompileResults: @unchecked Sendable {
+        private let lock = NSLock()
+        private var results: [Result<MTLRenderPipelineState, Error>]
+
+        init(count: Int) {
+            results = Array(repeating: .failure(CancellationError()), count: count)
+        }
+
+        func store(_ result: Result<MTLRenderPipelineState, Error>, at index: Int) {
+            lock.lock()
+            results[index] = result
+            lock.unlock()
+        }
+
+        var values: [Result<MTLRenderPipelineState, Error>] {
+            lock.lock()
+            defer { lock.unlock() }
+            return results
+        }
+    }
+    private var compilingPipelineGroups: Set<PipelineGroup> = []
+    // Groups whose background compile failed keep using the fallback instead of retrying every frame
+    private var failedPipelineGroups: Set<PipelineGroup> = []
+    // Bumped when pipeline states are reset so compiles for superseded settings are dropped on arrival
+    private var pipelineGeneration: UInt64 = 0
+    // Finished background compiles, installed on the render thread at the start of the next frame
+    private let compiledPipelinesLock = NSLock()
+    private var compiledPipelines: [CompiledPipelineGroup] = []
+
     // Mesh Shader Pipeline (Metal 3+, Apple Silicon)
     private var meshShaderPipelineState: MTLRenderPipelineState?
     private var meshShaderDepthState: MTLDepthStencilState?
     public var meshShaderEnabled = false {
         didSet {
+            // A setting made before the pipeline lands wins over auto-enabling
+            meshShaderAutoEnablePending = false
             if meshShaderEnabled != oldValue {
                 invalidateRender()
             }
         }
     }
     private var meshShadersSupported = false
+    // Set by setupMeshShaders until the pipeline first compiles
+    private var meshShaderAutoEnablePending = false
     
-    /// Returns true if mesh shaders are supported on this device
+    /// Returns true if mesh shaders are supported on this device. With `asynchronousPipelineCompilation` this stays
+    /// false until the mesh shader pipeline has compiled, at the start of a later frame.
     public var isMeshShaderSupported: Bool { meshShadersSupported }
 
+    // Tile-binned compute rasterizer (iOS 26+, macOS 26+, visionOS 26+), created on first use
+    // Stored as AnyObject to avoid @available restrictions on stored properties
+    private var _tileRasterizer: AnyObject?
+    private var tileRasterizerUnavailable = false
+    // The tile rasterizer sorts per tile, so no global order is needed while it draws
+    private var tileRasterizerDrewLastFrame = false
+
+    /// When true, renders with the tile-binned compute rasterizer instead of blended quads: splats are
+    /// projected and binned into 16×16 tiles, sorted per tile and blended front-to-back in threadgroup
+    /// memory with early termination. Suits dense captures where overdraw of large low-alpha splats dominates.
+    ///
+    /// Requires iOS 26+, macOS 26+ or visionOS 26+, a single viewport and no rasterization rate map;
+    /// other frames fall back to the quad paths. Editing overlays and debug tints are not drawn by this path.
+    public var useTileRasterizer = false {
+        didSet {
+            if useTileRasterizer != oldValue {
+                tileRasterizerDrewLastFrame = false
+                markSortDirtyWithoutRevisionChange()
+                invalidateRender()
+            }
+        }
+    }
+
+    /// True when this OS and device can create the tile rasterizer; creates it if needed
+    internal var isTileRasterizerSupported: Bool {
+        guard #available(iOS 26.0, macOS 26.0, visionOS 26.0, *) else { return false }
+        return tileRasterizerIfAvailable() != nil
+    }
+
     /// Returns true if mesh shaders can be safely used without quality regression
     /// Note: useCulledDitheredPath check stays inline in render() since it's a local
     private var canUseMeshShadersSafely: Bool {
-        meshShadersSupported && !useMultiStagePipeline && !useDitheredTransparency
+        meshShadersSupported && !useMultiStagePipeline && !drawsDitheredTransparency
     }
 
     // Debug AABB rendering
@@ -867,22 +1270,55 @@ public class SplatRenderer: @unchecked Sendable {
     
     // Buffer pools for efficient memory management
     private let splatBufferPool: MetalBufferPool<Splat>
+    private let animatedSplatBufferPool: MetalBufferPool<Splat>
     internal let indexBufferPool: MetalBufferPool<UInt32>
 
     // Sort buffer pools for GPU sorting operations (reuse across frames)
     private let sortDistanceBufferPool: MetalBufferPool<Float>
     private let sortIndexBufferPool: MetalBufferPool<Int32>
 
+    // Transient sort scratch shared by the counting and Metal 4 sorters; made aliasable after each sort is encoded
+    internal let sortScratchHeap: MetalScratchHeap
+
+    /// Splat edits the editor's selection engine hasn't folded into its cluster bounds yet
+    internal let selectionClusterInvalidation = SelectionClusterInvalidation()
+    // Private, GPU-only buffers (batch precompute) sub-allocated from heaps
+    private let privateBufferHeap: MetalHeapAllocator
+
     // splatBuffer contains one entry for each gaussian splat (static, never reordered)
     var splatBuffer: MetalBuffer<Splat>
     var animatedSplatBuffer: MetalBuffer<Splat>?
-    internal var sourceScenePoints: [SplatScenePoint] = []
-    internal var animationSceneIndices: [UInt32] = []
+    internal var sourceScenePoints: [SplatScenePoint] = [] {
+        didSet { animationSourceDirty = true }
+    }
+    internal var animationSceneIndices: [UInt32] = [] {
+        didSet { animationSourceDirty = true }
+    }
     internal var animationSceneCounts: [Int] = []
-    internal var animationSceneMetrics: [SplatAnimationSceneMetrics] = []
+    internal var animationSceneMetrics: [SplatAnimationSceneMetrics] = [] {
+        didSet { animationSourceDirty = true }
+    }
     internal var animationMetricsDirty = false
     internal var animationDirty = true
     internal var lastAppliedAnimationTime: Float?
+
+    // GPU animation: resident copies of the animation inputs, re-uploaded only when the source data changes
+    internal var animationSourceDirty = true
+    internal var animationSourceBuffer: MetalBuffer<SplatAnimationSourcePoint>?
+    internal var animationSceneIndexBuffer: MetalBuffer<UInt32>?
+    internal var animationSceneDataBuffer: MetalBuffer<SplatAnimationGPUSceneMetrics>?
+    internal var animateSplatsPipelineState: MTLComputePipelineState?
+    internal var animateSplatsSHPipelineState: MTLComputePipelineState?
+
+    /// Evaluate `animationConfiguration` effects in a compute kernel instead of rebuilding every splat on the CPU.
+    /// Falls back to the CPU path automatically when the kernel is unavailable.
+    public var gpuAnimationEnabled: Bool = true {
+        didSet {
+            guard gpuAnimationEnabled != oldValue else { return }
+            animationDirty = true
+            invalidateRender()
+        }
+    }
     
     // GPU-only sorting: sorted indices buffer holds the depth-sorted order
     // Shaders use this to index into splatBuffer in the correct render order
@@ -942,6 +1378,12 @@ public class SplatRenderer: @unchecked Sendable {
     private var sortedIndicesBufferA: MetalBuffer<Int32>?
     private var sortedIndicesBufferB: MetalBuffer<Int32>?
     private var usingSortedBufferA: Bool = true  // Which buffer is currently used for rendering
+    // Offset of the second view's order within sortedIndicesBuffer (0 when both views share one order)
+    private var sortedIndicesViewStride = 0
+    // Entry offset of GPU-written indirect draw arguments within sortedIndicesBuffer (GPU LOD sorts only)
+    private var sortedIndicesDrawArgumentsOffset: Int?
+    // Order sorted for the batch frame being encoded; replaces the published order while set (guarded by sortStateLock)
+    private var frameSortOrder: MetalBuffer<Int32>?
 
     // Cached arrays to avoid per-frame allocations
     private var cameraPositionsTemp: [SIMD3<Float>] = []
@@ -973,6 +1415,61 @@ public class SplatRenderer: @unchecked Sendable {
     /// Only effective when useCountingSort is true.
     public var useCameraRelativeBinning: Bool = true
 
+    // Temporally coherent sort - refines the previous order instead of sorting from scratch
+    private var incrementalSorter: IncrementalSorter?
+
+    /// When true, camera-driven resorts refine the previously published order on the GPU
+    /// (tile-local bitonic passes) instead of running a full sort. A full sort still runs when
+    /// splat data changes, when the refined order's residual exceeds `incrementalSortEscalationThreshold`,
+    /// when refinement stops being cheaper than the last full sort, and every `maxConsecutiveIncrementalSorts` sorts.
+    /// Stereo sorts that keep a separate order per eye always use a full sort.
+    public var useIncrementalSorting: Bool = true
+
+    /// Tile passes per incremental sort; each pass lets a splat move up to 512 positions
+    public var incrementalSortPassCount: Int = 4
+
+    /// Fraction of adjacent pairs left out of order after refinement above which the next sort is a full sort
+    public var incrementalSortEscalationThreshold: Double = 0.002
+
+    /// Incremental sorts allowed in a row before a full sort resets accumulated drift
+    public var maxConsecutiveIncrementalSorts: Int = 60
+
+    /// Minimum sort interval during interaction while incremental sorting keeps up.
+    /// Refinement is cheap enough to run every frame, so this replaces `interactionMinimumSortInterval` then.
+    public var incrementalMinimumSortInterval: TimeInterval = 0
+
+    // Incremental sort bookkeeping (guarded by sortStateLock)
+    private var lastPublishedSortDataRevision: UInt64?
+    private var lastPublishedSortByDistance: Bool?
+    private var lastPublishedSortPath: SortPath?
+    private var lastFullSortTime: TimeInterval?
+    private var consecutiveIncrementalSorts = 0
+    private var incrementalSortEscalationPending = false
+
+    // GPU LOD selection - created by setLODHierarchy
+    internal var lodSelector: GPULODSelector?
+
+    /// When true and an LOD hierarchy is installed (`setLODHierarchy`), sorts select LOD nodes and cull
+    /// splats on the GPU and draw the survivors with indirect arguments
+    public var gpuLODEnabled: Bool = true {
+        didSet {
+            if gpuLODEnabled != oldValue {
+                markSortDirtyWithoutRevisionChange()
+            }
+        }
+    }
+
+    /// Screen-space error (pixels) above which an LOD node is replaced by its children
+    public var lodMaxScreenSpaceError: Float = 2.0
+
+    /// NDC margin of the per-splat frustum test applied by GPU LOD culling
+    public var lodFrustumMargin: Float = 1.5
+
+    // Focal length in pixels of the first viewport, for LOD screen-space error
+    private var lodProjectionScale: Float = 1
+    // Survivors of the last GPU LOD selection (guarded by sortStateLock)
+    private var lastLODSelectedSplatCount: Int?
+
     // Metal 4 Advanced Atomics Sorter - GPU radix sort for very large scenes
     // Note: Metal4Sorter is only available on iOS 26+, macOS 26+, visionOS 26+
     // Stored as AnyObject to avoid @available restrictions on stored properties
@@ -991,6 +1488,15 @@ public class SplatRenderer: @unchecked Sendable {
     /// Minimum splat count to use Metal 4 sorting (below this, counting sort is faster)
     public var metal4SortingThreshold: Int = 100_000
 
+    /// When set, full sorts run on the path, and with the counting sort bin count, that the tuner measured fastest on
+    /// this device for the scene's size, renderable fraction and stereo mode, after first exploring every path the
+    /// renderer can run. This replaces the `useCountingSort`, `useMetal4Sorting` and `metal4SortingThreshold` rules.
+    /// Incremental sorts, GPU LOD sorts (always counting sort) and `prefersCPUSorting` are unaffected.
+    public var sortPathTuner: SortPathTuner?
+
+    /// Scenes up to this many splats also try the CPU sort while tuning
+    public var sortPathTunerCPUSplatLimit: Int = 32_768
+
 
     // MARK: - Thread-safe sort state accessors
 
@@ -1079,20 +1585,122 @@ public class SplatRenderer: @unchecked Sendable {
         return inFlightSortsAtCompletion
     }
 
-    private func markSortDataDirty() {
+    /// Whether the last published order came from incremental refinement, i.e. refinement is keeping up with the camera
+    private var incrementalSortKeepingUp: Bool {
+        os_unfair_lock_lock(&sortStateLock)
+        defer { os_unfair_lock_unlock(&sortStateLock) }
+        return lastPublishedSortPath == .incremental && !incrementalSortEscalationPending
+    }
+
+    /// Returns the published order to refine for this sort, or nil if it must be a full sort:
+    /// the order has to be a single view sorted for the same splat data, renderable set and sort metric.
+    private func incrementalSortSeed(renderableCount: Int, dataRevision: UInt64, sortByDistance: Bool) -> MetalBuffer<Int32>? {
+        guard useIncrementalSorting, incrementalSorter != nil else { return nil }
+        let maxConsecutive = maxConsecutiveIncrementalSorts
+
+        os_unfair_lock_lock(&sortStateLock)
+        defer { os_unfair_lock_unlock(&sortStateLock) }
+        guard !incrementalSortEscalationPending,
+              consecutiveIncrementalSorts < maxConsecutive,
+              lastPublishedSortDataRevision == dataRevision,
+              lastPublishedSortByDistance == sortByDistance,
+              sortedIndicesViewStride == 0,
+              sortedIndicesDrawArgumentsOffset == nil,
+              let buffer = sortedIndicesBuffer,
+              buffer.count == renderableCount else {
+            return nil
+        }
+        return buffer
+    }
+
+    /// The tuner's pick for a full sort, or nil to follow the fixed path rules. Counting sort, the default path, is
+    /// explored first. Metal 4 and the CPU sort order every splat, so hidden or deleted splats rule them out.
+    private func sortPathTunerTrial(splatCount: Int, renderableCount: Int, perEye: Bool) -> SortPathTuner.Trial? {
+        guard let sortPathTuner else { return nil }
+        let sortsEverySplat = hiddenOrDeletedEditStateCount == 0
+        var candidates: [SortPathTuner.Choice] = []
+        if countingSorter != nil {
+            candidates += CountingSorter.binCountCandidates(for: splatCount).map {
+                SortPathTuner.Choice(path: .counting, countingBinCount: $0)
+            }
+        }
+        if #available(iOS 26.0, macOS 26.0, visionOS 26.0, *), metal4Sorter != nil, sortsEverySplat {
+            candidates.append(SortPathTuner.Choice(path: .metal4))
+        }
+        if computeDistancesPipelineState != nil {
+            candidates.append(SortPathTuner.Choice(path: .mps))
+        }
+        if sortsEverySplat, splatCount <= sortPathTunerCPUSplatLimit {
+            candidates.append(SortPathTuner.Choice(path: .cpu))
+        }
+        return sortPathTuner.trial(splatCount: splatCount,
+                                   renderableCount: renderableCount,
+                                   perEye: perEye,
+                                   candidates: candidates)
+    }
+
+    /// Records which path produced the order about to be published, and whether the next sort must be a full sort.
+    /// Called before `finishSortState` so the decision is in place before the next sort can start.
+    private func recordSortOutcome(path: SortPath,
+                                   sortTime: TimeInterval,
+                                   residualInversionRatio: Double?,
+                                   dataRevision: UInt64,
+                                   sortByDistance: Bool,
+                                   isPerEye: Bool) {
+        let threshold = incrementalSortEscalationThreshold
+
+        os_unfair_lock_lock(&sortStateLock)
+        lastPublishedSortDataRevision = dataRevision
+        lastPublishedSortByDistance = sortByDistance
+        lastPublishedSortPath = path
+        if path == .incremental {
+            consecutiveIncrementalSorts += 1
+            incrementalSortEscalationPending = Self.shouldEscalateIncrementalSort(
+                residualInversionRatio: residualInversionRatio,
+                sortTime: sortTime,
+                lastFullSortTime: lastFullSortTime,
+                threshold: threshold
+            )
+        } else {
+            consecutiveIncrementalSorts = 0
+            incrementalSortEscalationPending = false
+            if !isPerEye {
+                lastFullSortTime = sortTime
+            }
+        }
+        os_unfair_lock_unlock(&sortStateLock)
+    }
+
+    /// An incremental sort escalates to a full sort when refinement left too many pairs out of order,
+    /// or when it cost as much as the last full sort (so refining no longer pays for itself).
+    static func shouldEscalateIncrementalSort(residualInversionRatio: Double?,
+                                              sortTime: TimeInterval,
+                                              lastFullSortTime: TimeInterval?,
+                                              threshold: Double) -> Bool {
+        guard let residualInversionRatio else { return true }
+        if residualInversionRatio > threshold {
+            return true
+        }
+        if let lastFullSortTime, lastFullSortTime > 0, sortTime >= lastFullSortTime {
+            return true
+        }
+        return false
+    }
+
+    internal func markSortDataDirty() {
         os_unfair_lock_lock(&sortStateLock)
         sortDirtyDueToData = true
         sortDataRevision &+= 1
         os_unfair_lock_unlock(&sortStateLock)
     }
 
-    private func markSortDirtyWithoutRevisionChange() {
+    internal func markSortDirtyWithoutRevisionChange() {
         os_unfair_lock_lock(&sortStateLock)
         sortDirtyDueToData = true
         os_unfair_lock_unlock(&sortStateLock)
     }
 
-    private func getSortDataRevision() -> UInt64 {
+    internal func getSortDataRevision() -> UInt64 {
         os_unfair_lock_lock(&sortStateLock)
         defer { os_unfair_lock_unlock(&sortStateLock) }
         return sortDataRevision
@@ -1102,7 +1710,44 @@ public class SplatRenderer: @unchecked Sendable {
     private func getCurrentSortedIndicesBuffer() -> MetalBuffer<Int32>? {
         os_unfair_lock_lock(&sortStateLock)
         defer { os_unfair_lock_unlock(&sortStateLock) }
-        return sortedIndicesBuffer
+        return frameSortOrder ?? sortedIndicesBuffer
+    }
+
+    /// Encodes `body` drawing with `order`, one view, instead of the published order, and without scheduling
+    /// camera-driven resorts (used by `SplatBatchRenderer`, whose frames each sort for their own camera)
+    internal func withFrameSortOrder<Result>(_ order: MetalBuffer<Int32>, _ body: () throws -> Result) rethrows -> Result {
+        os_unfair_lock_lock(&sortStateLock)
+        frameSortOrder = order
+        os_unfair_lock_unlock(&sortStateLock)
+        defer {
+            os_unfair_lock_lock(&sortStateLock)
+            frameSortOrder = nil
+            os_unfair_lock_unlock(&sortStateLock)
+        }
+        return try body()
+    }
+
+    private var isEncodingFrameSortOrder: Bool {
+        os_unfair_lock_lock(&sortStateLock)
+        defer { os_unfair_lock_unlock(&sortStateLock) }
+        return frameSortOrder != nil
+    }
+
+    /// Binds the current sorted indices to the vertex stage and points each view's uniforms at its order.
+    /// - Returns: The bound buffer, and the byte offset of its indirect draw arguments when the sort wrote them
+    @discardableResult
+    internal func bindCurrentSortedIndices(to renderEncoder: MTLRenderCommandEncoder) -> (buffer: MTLBuffer, drawArgumentsByteOffset: Int?)? {
+        os_unfair_lock_lock(&sortStateLock)
+        let buffer = frameSortOrder ?? sortedIndicesBuffer
+        let viewStride = frameSortOrder == nil ? sortedIndicesViewStride : 0
+        let drawArgumentsOffset = frameSortOrder == nil ? sortedIndicesDrawArgumentsOffset : nil
+        os_unfair_lock_unlock(&sortStateLock)
+
+        guard let buffer else { return nil }
+        renderEncoder.setVertexBuffer(buffer.buffer, offset: 0, index: BufferIndex.sortedIndices.rawValue)
+        uniforms.pointee.uniforms0.sortedIndexViewOffset = 0
+        uniforms.pointee.uniforms1.sortedIndexViewOffset = UInt32(viewStride)
+        return (buffer.buffer, drawArgumentsOffset.map { $0 * MemoryLayout<Int32>.stride })
     }
 
     /// Thread-safe check if currently sorting
@@ -1152,10 +1797,15 @@ public class SplatRenderer: @unchecked Sendable {
 
     /// Thread-safe buffer swap for double-buffered sorting
     /// Returns the old buffer that was replaced (if any) for release back to pool
-    private func swapSortedIndicesBuffer(newBuffer: MetalBuffer<Int32>) -> MetalBuffer<Int32>? {
+    private func swapSortedIndicesBuffer(newBuffer: MetalBuffer<Int32>,
+                                         viewStride: Int = 0,
+                                         drawArgumentsOffset: Int? = nil) -> MetalBuffer<Int32>? {
         os_unfair_lock_lock(&sortStateLock)
         defer { os_unfair_lock_unlock(&sortStateLock) }
 
+        sortedIndicesViewStride = viewStride
+        sortedIndicesDrawArgumentsOffset = drawArgumentsOffset
+
         let oldBuffer: MetalBuffer<Int32>?
         if usingSortedBufferA {
             // Currently rendering with A, so B is safe to replace
@@ -1193,11 +1843,58 @@ public class SplatRenderer: @unchecked Sendable {
         return (try sortIndexBufferPool.acquire(minimumCapacity: minimumCapacity), true)
     }
 
+    private func updateFrameTimelineRecorder() {
+        frameTimelineRecorder = frameTimelineEnabled
+            ? FrameTimelineRecorder(device: device, capacity: frameTimelineCapacity)
+            : nil
+        if frameTimelineEnabled && frameTimelineRecorder == nil {
+            Self.log.warning("Frame timeline unavailable: no stage-boundary timestamp sampling on \(self.device.name)")
+        }
+        countingSorter?.timelineRecorder = frameTimelineRecorder
+        if #available(iOS 26.0, macOS 26.0, visionOS 26.0, *) {
+            metal4Sorter?.timelineRecorder = frameTimelineRecorder
+        }
+    }
+
     private func releaseSortOutputBufferOnFailure(_ buffer: MetalBuffer<Int32>, releaseOnFailure: Bool) {
         guard releaseOnFailure else { return }
         sortIndexBufferPool.release(buffer)
     }
 
+    /// Sorts the right eye into a pooled scratch buffer via `encode`, then copies its order into `output` at `viewStride`.
+    /// Returns the scratch buffer, which the caller releases once `commandBuffer` completes.
+    private func encodeRightEyeSort(into output: MetalBuffer<Int32>,
+                                    viewStride: Int,
+                                    count: Int,
+                                    commandBuffer: MTLCommandBuffer,
+                                    encode: (MTLBuffer) throws -> Void) throws -> MetalBuffer<Int32> {
+        let rightEyeBuffer = try sortIndexBufferPool.acquire(minimumCapacity: max(viewStride, 1))
+        do {
+            try encode(rightEyeBuffer.buffer)
+        } catch {
+            sortIndexBufferPool.release(rightEyeBuffer)
+            throw error
+        }
+        encodeRightEyeCopy(from: rightEyeBuffer, into: output, viewStride: viewStride, count: count, commandBuffer: commandBuffer)
+        return rightEyeBuffer
+    }
+
+    private func encodeRightEyeCopy(from rightEyeBuffer: MetalBuffer<Int32>,
+                                    into output: MetalBuffer<Int32>,
+                                    viewStride: Int,
+                                    count: Int,
+                                    commandBuffer: MTLCommandBuffer) {
+        let length = min(count, viewStride) * MemoryLayout<Int32>.stride
+        guard length > 0, let blitEncoder = commandBuffer.makeBlitCommandEncoder() else { return }
+        blitEncoder.label = "Right Eye Sort Copy"
+        blitEncoder.copy(from: rightEyeBuffer.buffer,
+                         sourceOffset: 0,
+                         to: output.buffer,
+                         destinationOffset: viewStride * MemoryLayout<Int32>.stride,
+                         size: length)
+        blitEncoder.endEncoding()
+    }
+
     public init(device: MTLDevice,
                 colorFormat: MTLPixelFormat,
                 depthFormat: MTLPixelFormat,
@@ -1209,6 +1906,7 @@ public class SplatRenderer: @unchecked Sendable {
         }
 
         self.device = device
+        self.pipelineCache = PipelineCache.shared(for: device)
 
         // Initialize command buffer manager with Metal 4 pooling support
         guard let commandQueue = device.makeCommandQueue() else {
@@ -1241,13 +1939,24 @@ public class SplatRenderer: @unchecked Sendable {
         self.uniforms = UnsafeMutableRawPointer(dynamicUniformBuffers.contents()).bindMemory(to: UniformsArray.self, capacity: 1)
 
         // Initialize buffer pools with optimized configurations
+        // Scene splats are written on the CPU and only read by frames, so they can share heaps
         let splatPoolConfig = MetalBufferPool<Splat>.Configuration(
             maxPoolSize: 8,  // Allow more splat buffers for complex scenes
             maxBufferAge: 120.0,  // Keep splat buffers longer as they're expensive
-            memoryPressureThreshold: 0.7  // More aggressive cleanup for large buffers
+            memoryPressureThreshold: 0.7,  // More aggressive cleanup for large buffers
+            useHeapAllocation: true
         )
         self.splatBufferPool = MetalBufferPool(device: device, configuration: splatPoolConfig)
 
+        // Animated splats are rewritten by the GPU each frame while the previous frame draws its buffer, so they get
+        // standalone buffers rather than a heap that would order the two
+        let animatedSplatPoolConfig = MetalBufferPool<Splat>.Configuration(
+            maxPoolSize: 3,
+            maxBufferAge: 30.0,
+            memoryPressureThreshold: 0.7
+        )
+        self.animatedSplatBufferPool = MetalBufferPool(device: device, configuration: animatedSplatPoolConfig)
+
         let indexPoolConfig = MetalBufferPool<UInt32>.Configuration(
             maxPoolSize: 12,  // Index buffers are smaller, can pool more
             maxBufferAge: 90.0
@@ -1268,6 +1977,8 @@ public class SplatRenderer: @unchecked Sendable {
             memoryPressureThreshold: 0.75
         )
         self.sortIndexBufferPool = MetalBufferPool(device: device, configuration: sortIndexPoolConfig)
+        self.sortScratchHeap = MetalScratchHeap(device: device)
+        self.privateBufferHeap = MetalHeapAllocator(device: device, label: "Private Buffers", storageMode: .private)
 
         // Acquire initial buffers from pools
         self.splatBuffer = try splatBufferPool.acquire(minimumCapacity: 1)
@@ -1289,6 +2000,18 @@ public class SplatRenderer: @unchecked Sendable {
         } catch {
             Self.log.error("Failed to create compute pipeline state: \(error)")
         }
+
+        // Initialize GPU animation pipelines (CPU animation is used when unavailable)
+        do {
+            if let animateFunction = library.makeFunction(name: "animateSplats") {
+                animateSplatsPipelineState = try device.makeComputePipelineState(function: animateFunction)
+            }
+            if let animateSHFunction = library.makeFunction(name: "animateSplatsSH") {
+                animateSplatsSHPipelineState = try device.makeComputePipelineState(function: animateSHFunction)
+            }
+        } catch {
+            Self.log.warning("Failed to create splat animation pipeline - falling back to CPU animation: \(error)")
+        }
         
         // Initialize frustum culling pipeline and buffers
         do {
@@ -1306,16 +2029,17 @@ public class SplatRenderer: @unchecked Sendable {
             }
             // Create frustum culling buffers (will be resized as needed)
             // Log failures - these are optional features that degrade gracefully
-            frustumCullDataBuffer = device.makeBuffer(length: MemoryLayout<FrustumCullData>.stride, options: .storageModeShared)
-            if frustumCullDataBuffer == nil {
-                Self.log.warning("Failed to create frustum cull data buffer - frustum culling disabled")
-            }
-            frustumCullDataBuffer?.label = "Frustum Cull Data"
-            visibleCountBuffer = device.makeBuffer(length: MemoryLayout<UInt32>.stride, options: .storageModeShared)
+            visibleCountBuffer = device.makeBuffer(length: MemoryLayout<UInt32>.stride, options: .storageModePrivate)
             if visibleCountBuffer == nil {
                 Self.log.warning("Failed to create visible count buffer - frustum culling disabled")
             }
             visibleCountBuffer?.label = "Visible Count"
+            visibleCountReadbackBuffer = device.makeBuffer(length: MemoryLayout<UInt32>.stride * maxSimultaneousRenders,
+                                                           options: .storageModeShared)
+            if visibleCountReadbackBuffer == nil {
+                Self.log.warning("Failed to create visible count readback buffer - culledSplatCount will not update")
+            }
+            visibleCountReadbackBuffer?.label = "Visible Count Readback"
             // Indirect draw arguments buffer (MTLDrawIndexedPrimitivesIndirectArguments = 5 * uint32)
             indirectDrawArgsBuffer = device.makeBuffer(length: 5 * MemoryLayout<UInt32>.stride, options: .storageModePrivate)
             if indirectDrawArgsBuffer == nil {
@@ -1366,22 +2090,39 @@ public class SplatRenderer: @unchecked Sendable {
         // Initialize O(n) counting sorter for faster sorting
         do {
             countingSorter = try CountingSorter(device: device, library: library)
+            countingSorter?.scratchHeap = sortScratchHeap
             Self.log.info("O(n) counting sort available")
         } catch {
             Self.log.warning("Failed to initialize counting sorter, using MPS fallback: \(error)")
         }
 
+        // Initialize incremental sorter for temporally coherent camera-driven resorts
+        do {
+            incrementalSorter = try IncrementalSorter(device: device, library: library)
+        } catch {
+            Self.log.warning("Failed to initialize incremental sorter, every resort will be a full sort: \(error)")
+        }
+
         // Initialize Metal 4 radix sorter for very large scenes (iOS 26+, macOS 26+)
         if #available(iOS 26.0, macOS 26.0, visionOS 26.0, *) {
             if device.supportsFamily(.apple9) {
                 do {
                     metal4Sorter = try Metal4Sorter(device: device, library: library)
+                    metal4Sorter?.scratchHeap = sortScratchHeap
                     Self.log.info("Metal 4 radix sort available for large scenes (>100K splats)")
                 } catch {
                     Self.log.warning("Failed to initialize Metal 4 sorter: \(error)")
                 }
             }
         }
+
+        // Initialize load-time GPU Morton reordering (gpuMortonReorderEnabled)
+        do {
+            mortonReorderer = try GPUMortonReorderer(device: device, library: library)
+            mortonReorderer?.scratchHeap = sortScratchHeap
+        } catch {
+            Self.log.warning("Failed to initialize GPU Morton reorderer, Morton ordering stays on the CPU: \(error)")
+        }
     }
     
     /// Check if mesh shaders are supported and set up the pipeline
@@ -1393,70 +2134,82 @@ public class SplatRenderer: @unchecked Sendable {
             Self.log.info("Mesh shaders not supported (requires Apple7 GPU family or later)")
             return
         }
-        
-        do {
-            // Set function constants for 2DGS mode
-            let functionConstants = MTLFunctionConstantValues()
-            var use2DGSValue = use2DGSMode
-            functionConstants.setConstantValue(&use2DGSValue, type: .bool, index: 12)
-
-            // Try to load mesh shader functions with function constants
-            guard let objectFunction = try? library.makeFunction(name: "splatObjectShader", constantValues: functionConstants),
-                  let meshFunction = try? library.makeFunction(name: "splatMeshShader", constantValues: functionConstants),
-                  let fragmentFunction = try? library.makeFunction(name: "meshSplatFragmentShader", constantValues: functionConstants) else {
-                Self.log.info("Mesh shader functions not found in library")
-                return
-            }
-            
-            // Create mesh render pipeline descriptor
-            let meshPipelineDescriptor = MTLMeshRenderPipelineDescriptor()
-            meshPipelineDescriptor.label = "MeshShaderSplatPipeline"
-            meshPipelineDescriptor.objectFunction = objectFunction
-            meshPipelineDescriptor.meshFunction = meshFunction
-            meshPipelineDescriptor.fragmentFunction = fragmentFunction
-            
-            // Configure color attachment (same as single-stage pipeline)
-            let colorAttachment = meshPipelineDescriptor.colorAttachments[0]
-            colorAttachment?.pixelFormat = colorFormat
-            colorAttachment?.isBlendingEnabled = true
-            colorAttachment?.rgbBlendOperation = .add
-            colorAttachment?.alphaBlendOperation = .add
-            colorAttachment?.sourceRGBBlendFactor = .one
-            colorAttachment?.sourceAlphaBlendFactor = .one
-            colorAttachment?.destinationRGBBlendFactor = .oneMinusSourceAlpha
-            colorAttachment?.destinationAlphaBlendFactor = .oneMinusSourceAlpha
-            
-            meshPipelineDescriptor.depthAttachmentPixelFormat = depthFormat
-            meshPipelineDescriptor.rasterSampleCount = sampleCount
-            
-            // Meshlet configuration: 64 splats per meshlet (increased from 32, limited by Metal's 256 vertex max)
-            meshPipelineDescriptor.maxTotalThreadsPerObjectThreadgroup = 64
-            meshPipelineDescriptor.maxTotalThreadsPerMeshThreadgroup = 64
-            
-            // Create pipeline state
-            let (pipelineState, _) = try device.makeRenderPipelineState(descriptor: meshPipelineDescriptor, options: [])
-            meshShaderPipelineState = pipelineState
-            
-            // Create depth state (same as single-stage)
-            let depthStateDescriptor = MTLDepthStencilDescriptor()
-            depthStateDescriptor.depthCompareFunction = .always
-            depthStateDescriptor.isDepthWriteEnabled = writeDepth
-            meshShaderDepthState = device.makeDepthStencilState(descriptor: depthStateDescriptor)
-            
-            meshShadersSupported = true
 
-            // Auto-enable mesh shaders only when NOT using multi-stage depth pipeline
-            // Multi-stage is critical for Vision Pro depth quality
-            if !useMultiStagePipeline && !useDitheredTransparency {
-                meshShaderEnabled = true
-                Self.log.info("✅ Mesh shaders auto-enabled (single-stage path) - geometry generated on GPU")
-            } else {
-                Self.log.info("✅ Mesh shaders available but not auto-enabled (multi-stage or dithered path active)")
-            }
-            
-        } catch {
-            Self.log.warning("Failed to create mesh shader pipeline: \(error)")
+        guard makeMeshShaderPipelineDescriptor() != nil else {
+            Self.log.info("Mesh shader functions not found in library")
+            return
         }
+
+        // Compiled in the background when asynchronous compilation is on; the vertex path draws meanwhile, and
+        // support is only reported once the pipeline exists
+        meshShaderAutoEnablePending = true
+        requestMeshShaderPipeline()
+    }
+
+    private func installMeshShaderPipeline(_ pipelineState: MTLRenderPipelineState) {
+        meshShaderPipelineState = pipelineState
+        meshShadersSupported = true
+        guard meshShaderAutoEnablePending else { return }
+
+        // Auto-enable mesh shaders only when NOT using multi-stage depth pipeline
+        // Multi-stage is critical for Vision Pro depth quality
+        if !useMultiStagePipeline && !useDitheredTransparency {
+            meshShaderEnabled = true
+            Self.log.info("✅ Mesh shaders auto-enabled (single-stage path) - geometry generated on GPU")
+        } else {
+            meshShaderAutoEnablePending = false
+            Self.log.info("✅ Mesh shaders available but not auto-enabled (multi-stage or dithered path active)")
+        }
+    }
+
+    /// Nil when the mesh shader functions aren't in the library
+    private func makeMeshShaderPipelineDescriptor() -> MTLMeshRenderPipelineDescriptor? {
+        // Set function constants for 2DGS mode
+        let functionConstants = MTLFunctionConstantValues()
+        var use2DGSValue = use2DGSMode
+        functionConstants.setConstantValue(&use2DGSValue, type: .bool, index: 12)
+
+        // Try to load mesh shader functions with function constants
+        guard let objectFunction = try? library.makeFunction(name: "splatObjectShader", constantValues: functionConstants),
+              let meshFunction = try? library.makeFunction(name: "splatMeshShader", constantValues: functionConstants),
+              let fragmentFunction = try? library.makeFunction(name: "meshSplatFragmentShader", constantValues: functionConstants) else {
+            return nil
+        }
+
+        // Create mesh render pipeline descriptor
+        let meshPipelineDescriptor = MTLMeshRenderPipelineDescriptor()
+        meshPipelineDescriptor.label = "MeshShaderSplatPipeline"
+        meshPipelineDescriptor.objectFunction = objectFunction
+        meshPipelineDescriptor.meshFunction = meshFunction
+        meshPipelineDescriptor.fragmentFunction = fragmentFunction
+
+        // Configure color attachment (same as single-stage pipeline)
+        let colorAttachment = meshPipelineDescriptor.colorAttachments[0]
+        colorAttachment?.pixelFormat = colorFormat
+        colorAttachment?.isBlendingEnabled = true
+        colorAttachment?.rgbBlendOperation = .add
+        colorAttachment?.alphaBlendOperation = .add
+        colorAttachment?.sourceRGBBlendFactor = .one
+        colorAttachment?.sourceAlphaBlendFactor = .one
+        colorAttachment?.destinationRGBBlendFactor = .oneMinusSourceAlpha
+        colorAttachment?.destinationAlphaBlendFactor = .oneMinusSourceAlpha
+
+        meshPipelineDescriptor.depthAttachmentPixelFormat = depthFormat
+        meshPipelineDescriptor.rasterSampleCount = sampleCount
+
+        // Meshlet configuration: 64 splats per meshlet (increased from 32, limited by Metal's 256 vertex max)
+        meshPipelineDescriptor.maxTotalThreadsPerObjectThreadgroup = 64
+        meshPipelineDescriptor.maxTotalThreadsPerMeshThreadgroup = 64
+
+        return meshPipelineDescriptor
+    }
+
+    private func buildMeshShaderDepthState() -> MTLDepthStencilState? {
+        // Same as single-stage
+        let depthStateDescriptor = MTLDepthStencilDescriptor()
+        depthStateDescriptor.depthCompareFunction = .always
+        depthStateDescriptor.isDepthWriteEnabled = writeDepth
+        return device.makeDepthStencilState(descriptor: depthStateDescriptor)
     }
     
     deinit {
@@ -1464,7 +2217,7 @@ public class SplatRenderer: @unchecked Sendable {
         splatBufferPool.release(splatBuffer)
         splatBufferPool.release(splatBufferPrime)
         if let animatedSplatBuffer {
-            splatBufferPool.release(animatedSplatBuffer)
+            animatedSplatBufferPool.release(animatedSplatBuffer)
         }
         indexBufferPool.release(indexBuffer)
         // Release double-buffered sort index buffers
@@ -1481,17 +2234,26 @@ public class SplatRenderer: @unchecked Sendable {
         splatBufferPool.release(splatBuffer)
         splatBufferPool.release(splatBufferPrime)
         if let animatedSplatBuffer {
-            splatBufferPool.release(animatedSplatBuffer)
+            animatedSplatBufferPool.release(animatedSplatBuffer)
             self.animatedSplatBuffer = nil
         }
         resetEditingTracking()
+        selectionClusterInvalidation.invalidateAll()
+        directPLYSource = nil
+        pendingSourceBatch = nil
+        packedSplatStore = nil
+        splatInstanceSet = nil
+        streamingScene = nil
+        lodSelector?.clearHierarchy()
         sourceScenePoints.removeAll(keepingCapacity: false)
+        mortonPermutation = nil
         animationSceneIndices.removeAll(keepingCapacity: false)
         animationSceneCounts.removeAll(keepingCapacity: false)
         animationSceneMetrics.removeAll(keepingCapacity: false)
         animationMetricsDirty = false
         animationDirty = true
         lastAppliedAnimationTime = nil
+        releaseAnimationSourceBuffers()
         
         // Invalidate cached bounds
         cachedBounds = nil
@@ -1541,11 +2303,28 @@ public class SplatRenderer: @unchecked Sendable {
     }
 
     public func read(from url: URL) async throws {
+        if RemoteSceneLoader.isRemote(url) {
+            try await readRemote(from: url)
+            return
+        }
         let reader = try AutodetectSceneReader(url)
+        if directPLYLoadingEnabled, url.pathExtension.lowercased() == "ply", try readDirectPLY(from: url) {
+            renderMode = Self.renderMode(from: reader.renderMode)
+            return
+        }
+        if gpuDequantizationEnabled, try await readGPUDequantized(from: reader, url: url) {
+            renderMode = Self.renderMode(from: reader.renderMode)
+            return
+        }
+        if packedSplatStorageEnabled {
+            try await readPacked(from: reader)
+            renderMode = Self.renderMode(from: reader.renderMode)
+            return
+        }
         var newPoints = SplatMemoryBuffer()
-        try await newPoints.read(from: reader)
+        try await newPoints.readBatch(from: reader)
         renderMode = Self.renderMode(from: reader.renderMode)
-        try add(newPoints.points)
+        try add(newPoints.batch)
     }
 
     internal func resetPipelineStates() {
@@ -1564,6 +2343,12 @@ public class SplatRenderer: @unchecked Sendable {
         postprocessPipelineState = nil
         postprocessDepthState = nil
         meshShaderPipelineState = nil  // Rebuild with updated function constants
+        packedSplatStore?.pipelineState = nil
+        splatInstanceSet?.pipelineState = nil
+        splatInstanceSet?.editingPipelineState = nil
+        pipelineGeneration &+= 1
+        compilingPipelineGroups.removeAll()
+        failedPipelineGroups.removeAll()
     }
 
     private func invalidatePipelineStates() {
@@ -1571,18 +2356,27 @@ public class SplatRenderer: @unchecked Sendable {
     }
 
     /// Compiles the active render pipeline(s) before first draw to avoid first-frame JIT stalls.
+    /// With `asynchronousPipelineCompilation`, builds the single-stage fallback now and starts the active path's
+    /// pipelines in the background.
     public func prewarmRenderPipelines() {
         do {
-            if useMultiStagePipeline {
+            if asynchronousPipelineCompilation {
+                try buildSingleStagePipelineStatesIfNeeded()
+                if useMultiStagePipeline {
+                    _ = try prepareMultiStagePipelineStates()
+                } else if drawsDitheredTransparency {
+                    _ = try prepareDitheredPipelineStates()
+                }
+            } else if useMultiStagePipeline {
                 try buildMultiStagePipelineStatesIfNeeded()
-            } else if useDitheredTransparency {
+            } else if drawsDitheredTransparency {
                 try buildDitheredPipelineStatesIfNeeded()
             } else {
                 try buildSingleStagePipelineStatesIfNeeded()
             }
 
             if meshShaderEnabled && meshShaderPipelineState == nil {
-                setupMeshShaders()
+                requestMeshShaderPipeline()
             }
         } catch {
             Self.log.warning("Pipeline prewarm failed: \(error.localizedDescription)")
@@ -1607,8 +2401,8 @@ public class SplatRenderer: @unchecked Sendable {
             if let visibleCountBuffer {
                 manager.registerAdditionalBuffer(visibleCountBuffer)
             }
-            if let frustumCullDataBuffer {
-                manager.registerAdditionalBuffer(frustumCullDataBuffer)
+            if let visibleCountReadbackBuffer {
+                manager.registerAdditionalBuffer(visibleCountReadbackBuffer)
             }
             if let indirectDrawArgsBuffer {
                 manager.registerAdditionalBuffer(indirectDrawArgsBuffer)
@@ -1668,10 +2462,154 @@ public class SplatRenderer: @unchecked Sendable {
         }
     }
 
-    private func buildSingleStagePipelineState(editing: Bool) throws -> MTLRenderPipelineState {
-        guard !useMultiStagePipeline else {
+    // MARK: - Asynchronous Pipeline Compilation
+
+    /// True when the multi-stage pipelines are ready for this frame. Otherwise starts their background compile (once)
+    /// and returns false so the frame draws single-stage.
+    private func prepareMultiStagePipelineStates() throws -> Bool {
+        guard asynchronousPipelineCompilation else {
+            try buildMultiStagePipelineStatesIfNeeded()
+            return true
+        }
+        if initializePipelineState != nil,
+           drawSplatPipelineState != nil,
+           drawSplatEditingPipelineState != nil,
+           postprocessPipelineState != nil {
+            // Depth states are cheap and never deferred
+            try buildMultiStagePipelineStatesIfNeeded()
+            return true
+        }
+        if !compilingPipelineGroups.contains(.multiStage) && !failedPipelineGroups.contains(.multiStage) {
+            compileInBackground(.multiStage, [
+                .tile(try makeInitializePipelineDescriptor()),
+                .render(try makeDrawSplatPipelineDescriptor(editing: false)),
+                .render(try makeDrawSplatPipelineDescriptor(editing: true)),
+                .render(try makePostprocessPipelineDescriptor()),
+            ])
+        }
+        return false
+    }
+
+    /// Dithered counterpart of `prepareMultiStagePipelineStates()`
+    private func prepareDitheredPipelineStates() throws -> Bool {
+        guard asynchronousPipelineCompilation else {
+            try buildDitheredPipelineStatesIfNeeded()
+            return true
+        }
+        if ditheredPipelineState != nil, ditheredEditingPipelineState != nil {
+            try buildDitheredPipelineStatesIfNeeded()
+            return true
+        }
+        if !compilingPipelineGroups.contains(.dithered) && !failedPipelineGroups.contains(.dithered) {
+            compileInBackground(.dithered, [
+                .render(try makeDitheredPipelineDescriptor(editing: false)),
+                .render(try makeDitheredPipelineDescriptor(editing: true)),
+            ])
+        }
+        return false
+    }
+
+    /// Builds the mesh shader pipeline, in the background when `asynchronousPipelineCompilation` is set; until it
+    /// lands the vertex shader path draws. With it clear, compiles now even when a background compile is still out.
+    private func requestMeshShaderPipeline() {
+        guard meshShaderPipelineState == nil,
+              device.supportsFamily(.apple7),
+              !(asynchronousPipelineCompilation && compilingPipelineGroups.contains(.meshShader)),
+              !failedPipelineGroups.contains(.meshShader),
+              let descriptor = makeMeshShaderPipelineDescriptor() else {
+            return
+        }
+        if meshShaderDepthState == nil {
+            meshShaderDepthState = buildMeshShaderDepthState()
+        }
+        if asynchronousPipelineCompilation {
+            compileInBackground(.meshShader, [.mesh(descriptor)])
+            return
+        }
+        do {
+            installMeshShaderPipeline(try pipelineCache.renderPipelineState(meshDescriptor: descriptor))
+        } catch {
+            failedPipelineGroups.insert(.meshShader)
+            meshShadersSupported = false
+            Self.log.warning("Failed to create mesh shader pipeline: \(error)")
+        }
+    }
+
+    private func compileInBackground(_ group: PipelineGroup, _ descriptors: [PipelineDescriptor]) {
+        compilingPipelineGroups.insert(group)
+        let generation = pipelineGeneration
+        let results = PipelineCompileResults(count: descriptors.count)
+        let dispatchGroup = DispatchGroup()
+        for (index, descriptor) in descriptors.enumerated() {
+            dispatchGroup.enter()
+            let completion: @Sendable (Result<MTLRenderPipelineState, Error>) -> Void = { result in
+                results.store(result, at: index)
+                dispatchGroup.leave()
+            }
+            switch descriptor {
+            case .render(let descriptor):
+                pipelineCache.renderPipelineState(descriptor: descriptor, completion: completion)
+            case .tile(let descriptor):
+                pipelineCache.renderPipelineState(tileDescriptor: descriptor, completion: completion)
+            case .mesh(let descriptor):
+                pipelineCache.renderPipelineState(meshDescriptor: descriptor, completion: completion)
+            }
+        }
+        dispatchGroup.notify(queue: .global(qos: .userInitiated)) { [weak self] in
+            guard let self else { return }
+            let compiled = CompiledPipelineGroup(group: group, generation: generation, results: results.values)
+            self.compiledPipelinesLock.lock()
+            self.compiledPipelines.append(compiled)
+            self.compiledPipelinesLock.unlock()
+        }
+    }
+
+    /// Moves finished background compiles into the pipeline state properties; runs at the start of each frame so
+    /// those properties are only ever touched on the render thread
+    private func installCompiledPipelines() {
+        compiledPipelinesLock.lock()
+        let finished = compiledPipelines
+        compiledPipelines.removeAll()
+        compiledPipelinesLock.unlock()
+
+        for compiled in finished where compiled.generation == pipelineGeneration {
+            compilingPipelineGroups.remove(compiled.group)
+            let states: [MTLRenderPipelineState]
+            do {
+                states = try compiled.results.map { try $0.get() }
+            } catch {
+                failedPipelineGroups.insert(compiled.group)
+                if compiled.group == .meshShader {
+                    meshShadersSupported = false
+                }
+                Self.log.error("Background pipeline compile failed for \(String(describing: compiled.group)); keeping the fallback: \(error)")
+                continue
+            }
+            switch compiled.group {
+            case .multiStage:
+                initializePipelineState = states[0]
+                drawSplatPipelineState = states[1]
+                drawSplatEditingPipelineState = states[2]
+                postprocessPipelineState = states[3]
+            case .dithered:
+                ditheredPipelineState = states[0]
+                ditheredEditingPipelineState = states[1]
+            case .meshShader:
+                installMeshShaderPipeline(states[0])
+            }
+        }
+    }
+
+    /// Single-stage pipelines are built with multi-stage selected only as the fallback while its pipelines compile
+    /// in the background
+    private func checkSingleStagePipelineAllowed() throws {
+        guard !useMultiStagePipeline || asynchronousPipelineCompilation else {
             throw SplatRendererError.internalPipelineMismatch(expected: "single-stage", actual: "multi-stage")
         }
+    }
+
+    private func buildSingleStagePipelineState(editing: Bool) throws -> MTLRenderPipelineState {
+        try checkSingleStagePipelineAllowed()
 
         let pipelineDescriptor = MTLRenderPipelineDescriptor()
 
@@ -1704,13 +2642,11 @@ public class SplatRenderer: @unchecked Sendable {
 
         pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
 
-        return try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+        return try pipelineCache.renderPipelineState(descriptor: pipelineDescriptor)
     }
 
     private func buildSingleStageDepthState() throws -> MTLDepthStencilState {
-        guard !useMultiStagePipeline else {
-            throw SplatRendererError.internalPipelineMismatch(expected: "single-stage", actual: "multi-stage")
-        }
+        try checkSingleStagePipelineAllowed()
 
         let depthStateDescriptor = MTLDepthStencilDescriptor()
         depthStateDescriptor.depthCompareFunction = MTLCompareFunction.always
@@ -1722,9 +2658,7 @@ public class SplatRenderer: @unchecked Sendable {
     }
 
     private func buildSelectionOutlinePipelineState() throws -> MTLRenderPipelineState {
-        guard !useMultiStagePipeline else {
-            throw SplatRendererError.internalPipelineMismatch(expected: "single-stage", actual: "multi-stage")
-        }
+        try checkSingleStagePipelineAllowed()
 
         let pipelineDescriptor = MTLRenderPipelineDescriptor()
         pipelineDescriptor.label = "SelectionOutlinePipeline"
@@ -1750,7 +2684,7 @@ public class SplatRenderer: @unchecked Sendable {
         pipelineDescriptor.depthAttachmentPixelFormat = depthFormat
         pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
 
-        return try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+        return try pipelineCache.renderPipelineState(descriptor: pipelineDescriptor)
     }
 
     private func buildSelectionOutlineDepthState() throws -> MTLDepthStencilState {
@@ -1778,6 +2712,10 @@ public class SplatRenderer: @unchecked Sendable {
     }
 
     private func buildDitheredPipelineState(editing: Bool) throws -> MTLRenderPipelineState {
+        try pipelineCache.renderPipelineState(descriptor: makeDitheredPipelineDescriptor(editing: editing))
+    }
+
+    private func makeDitheredPipelineDescriptor(editing: Bool) throws -> MTLRenderPipelineDescriptor {
         let pipelineDescriptor = MTLRenderPipelineDescriptor()
 
         pipelineDescriptor.label = editing ? "DitheredTransparencyEditingPipeline" : "DitheredTransparencyPipeline"
@@ -1804,7 +2742,7 @@ public class SplatRenderer: @unchecked Sendable {
 
         pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
 
-        return try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+        return pipelineDescriptor
     }
 
     private func buildDitheredDepthState() throws -> MTLDepthStencilState {
@@ -1819,6 +2757,10 @@ public class SplatRenderer: @unchecked Sendable {
     }
 
     private func buildInitializePipelineState() throws -> MTLRenderPipelineState {
+        try pipelineCache.renderPipelineState(tileDescriptor: makeInitializePipelineDescriptor())
+    }
+
+    private func makeInitializePipelineDescriptor() throws -> MTLTileRenderPipelineDescriptor {
         guard useMultiStagePipeline else {
             throw SplatRendererError.internalPipelineMismatch(expected: "multi-stage", actual: "single-stage")
         }
@@ -1830,10 +2772,14 @@ public class SplatRenderer: @unchecked Sendable {
         pipelineDescriptor.threadgroupSizeMatchesTileSize = true;
         pipelineDescriptor.colorAttachments[0].pixelFormat = colorFormat
 
-        return try device.makeRenderPipelineState(tileDescriptor: pipelineDescriptor, options: [], reflection: nil)
+        return pipelineDescriptor
     }
 
     private func buildDrawSplatPipelineState(editing: Bool) throws -> MTLRenderPipelineState {
+        try pipelineCache.renderPipelineState(descriptor: makeDrawSplatPipelineDescriptor(editing: editing))
+    }
+
+    private func makeDrawSplatPipelineDescriptor(editing: Bool) throws -> MTLRenderPipelineDescriptor {
         guard useMultiStagePipeline else {
             throw SplatRendererError.internalPipelineMismatch(expected: "multi-stage", actual: "single-stage")
         }
@@ -1846,12 +2792,20 @@ public class SplatRenderer: @unchecked Sendable {
         let functionConstants = MTLFunctionConstantValues()
         var use2DGSValue = use2DGSMode
         functionConstants.setConstantValue(&use2DGSValue, type: .bool, index: 12)
+        // Front-to-back blending: reversed sorted order plus early termination on opaque pixels
+        var frontToBackValue = multiStageFrontToBack
+        functionConstants.setConstantValue(&frontToBackValue, type: .bool, index: 13)
+        var transmittanceEpsilon = max(frontToBackTransmittanceEpsilon, 0)
+        functionConstants.setConstantValue(&transmittanceEpsilon, type: .float, index: 14)
 
         pipelineDescriptor.vertexFunction = try library.makeFunction(
             name: editing ? "multiStageSplatVertexShaderEditing" : "multiStageSplatVertexShader",
             constantValues: functionConstants
         )
-        pipelineDescriptor.fragmentFunction = try library.makeRequiredFunction(name: "multiStageSplatFragmentShader")
+        pipelineDescriptor.fragmentFunction = try library.makeFunction(
+            name: multiStageFrontToBack ? "multiStageSplatFragmentShaderFrontToBack" : "multiStageSplatFragmentShader",
+            constantValues: functionConstants
+        )
 
         pipelineDescriptor.rasterSampleCount = sampleCount
 
@@ -1860,7 +2814,7 @@ public class SplatRenderer: @unchecked Sendable {
 
         pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
 
-        return try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+        return pipelineDescriptor
     }
 
     private func buildDrawSplatDepthState() throws -> MTLDepthStencilState {
@@ -1878,6 +2832,10 @@ public class SplatRenderer: @unchecked Sendable {
     }
 
     private func buildPostprocessPipelineState() throws -> MTLRenderPipelineState {
+        try pipelineCache.renderPipelineState(descriptor: makePostprocessPipelineDescriptor())
+    }
+
+    private func makePostprocessPipelineDescriptor() throws -> MTLRenderPipelineDescriptor {
         guard useMultiStagePipeline else {
             throw SplatRendererError.internalPipelineMismatch(expected: "multi-stage", actual: "single-stage")
         }
@@ -1897,7 +2855,7 @@ public class SplatRenderer: @unchecked Sendable {
 
         pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
 
-        return try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+        return pipelineDescriptor
     }
 
     private func buildPostprocessDepthState() throws -> MTLDepthStencilState {
@@ -1940,7 +2898,7 @@ public class SplatRenderer: @unchecked Sendable {
         pipelineDescriptor.depthAttachmentPixelFormat = depthFormat
         pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
 
-        return try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+        return try pipelineCache.renderPipelineState(descriptor: pipelineDescriptor)
     }
 
     private func buildDebugAABBDepthState() throws -> MTLDepthStencilState {
@@ -2001,67 +2959,331 @@ public class SplatRenderer: @unchecked Sendable {
         }
 
         // Apply Morton ordering if enabled (improves GPU cache coherency)
+        let gpuReorder = shouldReorderByMortonOnGPU(count: points.count)
         let orderedPoints: [SplatScenePoint]
-        if mortonOrderingEnabled && !preserveSourceOrderOnAdd && points.count > 1 {
+        var order: [Int]?
+        if shouldReorderByMortonOnCPU(count: points.count) && !gpuReorder {
             let startTime = CFAbsoluteTimeGetCurrent()
-            if points.count > mortonParallelThreshold {
-                orderedPoints = MortonOrder.reorderParallel(points)
-            } else {
-                orderedPoints = MortonOrder.reorder(points)
-            }
+            // Large scenes use the O(n) radix sort over the position column
+            let indices = points.count > mortonParallelThreshold
+                ? MortonOrder.computeReorderingIndices(positions: points.map(\.position))
+                : MortonOrder.computeReorderingIndices(points)
+            orderedPoints = indices.map { points[$0] }
+            order = indices
             let duration = CFAbsoluteTimeGetCurrent() - startTime
             Self.log.info("Morton ordering \(points.count) splats took \(String(format: "%.2f", duration * 1000))ms")
         } else {
             orderedPoints = points
         }
 
-        splatBuffer.append(orderedPoints.map { Splat($0) })
-        sourceScenePoints.append(contentsOf: orderedPoints)
+        try appendSplats(orderedPoints.map { Splat($0) }, source: .points(orderedPoints),
+                         appliedOrder: order, mortonReorder: gpuReorder)
+    }
+
+    /// Adds a columnar batch of points. Splats are built straight from the attribute columns, and Morton
+    /// ordering permutes the columns rather than an array of `SplatScenePoint`s.
+    public func add(_ batch: SplatPointBatch) throws {
+        try SplatDataValidator.validateBatch(batch)
+
+        do {
+            try ensureAdditionalCapacity(batch.count)
+        } catch {
+            Self.log.error("Failed to grow buffers: \(error)")
+            throw error
+        }
+
+        let gpuReorder = shouldReorderByMortonOnGPU(count: batch.count)
+        let orderedBatch: SplatPointBatch
+        var order: [Int]?
+        if shouldReorderByMortonOnCPU(count: batch.count) && !gpuReorder {
+            let startTime = CFAbsoluteTimeGetCurrent()
+            let indices = MortonOrder.computeReorderingIndices(batch)
+            orderedBatch = batch.permuted(by: indices)
+            order = indices
+            let duration = CFAbsoluteTimeGetCurrent() - startTime
+            Self.log.info("Morton ordering \(batch.count) splats took \(String(format: "%.2f", duration * 1000))ms")
+        } else {
+            orderedBatch = batch
+        }
+
+        var splats: [Splat] = []
+        splats.reserveCapacity(orderedBatch.count)
+        for i in 0..<orderedBatch.count {
+            splats.append(Splat(position: orderedBatch.positions[i],
+                                color: .init(orderedBatch.linearColor(at: i).sRGBToLinear, orderedBatch.linearOpacity(at: i)),
+                                scale: orderedBatch.linearScale(at: i),
+                                rotation: orderedBatch.rotations[i].normalized))
+        }
+
+        // The batch stays columnar; scene points are only built once animation or an edit needs them
+        try appendSplats(splats, source: .batch(orderedBatch), appliedOrder: order, mortonReorder: gpuReorder)
+    }
+
+    /// Source of splats passed to `appendSplats`, in the same order
+    private enum AppendedSource {
+        case points([SplatScenePoint])
+        case batch(SplatPointBatch)
+    }
+
+    /// Appends already-ordered splats and their source, then refreshes derived state. `appliedOrder` is the
+    /// CPU Morton order the splats were put in, recorded in `mortonPermutation`. With `mortonReorder` the
+    /// appended range is Morton-sorted on the GPU once it is uploaded.
+    private func appendSplats(_ splats: [Splat], source: AppendedSource,
+                              appliedOrder: [Int]? = nil, mortonReorder: Bool = false) throws {
+        switch source {
+        case .points:
+            materializeSourcePointsIfNeeded()
+        case .batch:
+            // Pending batches extend each other; only a direct PLY scene ahead of them is expanded
+            materializeDirectPLYSourcePointsIfNeeded()
+        }
+        let appendedRange = splatBuffer.count..<(splatBuffer.count + splats.count)
+        splatBuffer.append(splats)
+        var order: [UInt32]?
+        if mortonReorder {
+            // Edit state and transform indices must cover the new range before they are reordered with it
+            if hasEditingResourcesAllocated {
+                try ensureEditingResources(pointCount: splatBuffer.count, preservingContents: true)
+            }
+            order = reorderSplatsByMorton(in: appendedRange)
+            recordMortonOrder(order, for: appendedRange)
+        } else if let appliedOrder {
+            recordMortonOrder(appliedOrder.map { UInt32($0) }, for: appendedRange)
+        } else if mortonPermutation != nil {
+            recordMortonOrder(nil, for: appendedRange)
+        }
+
+        switch source {
+        case .points(let points):
+            appendSourcePoints(order.map { $0.map { points[Int($0)] } } ?? points)
+        case .batch(let batch):
+            let ordered = order.map { batch.permuted(by: $0.map { Int($0) }) } ?? batch
+            if animationConfiguration != nil {
+                // Animation reads the scene points every frame
+                appendSourcePoints(ordered.points)
+            } else if pendingSourceBatch != nil {
+                pendingSourceBatch?.append(contentsOf: ordered)
+            } else {
+                pendingSourceBatch = ordered
+            }
+        }
+
+        animationDirty = true
+        markGeometryDirty()  // New splats affect geometry and require re-sorting
+        colorsDirty = true   // New splats also have new colors
+        if hasEditingResourcesAllocated {
+            try ensureEditingResources(pointCount: splatBuffer.count, preservingContents: true)
+        }
+
+        // Initialize sorted indices with identity mapping (0, 1, 2, ...)
+        // This ensures rendering works before first sort completes
+        try initializeIdentitySortedIndices()
+    }
+
+    /// Builds `sourceScenePoints` for splats whose source was kept in another form: a directly-loaded file or
+    /// columnar batches. Animation, point edits and appends of scene points need the mirror.
+    internal func materializeSourcePointsIfNeeded() {
+        materializeDirectPLYSourcePointsIfNeeded()
+        if let pendingSourceBatch {
+            self.pendingSourceBatch = nil
+            appendSourcePoints(pendingSourceBatch.points)
+        }
+    }
+
+    /// Extends `sourceScenePoints` and the animation scene bookkeeping with points appended to the last scene
+    private func appendSourcePoints(_ sourcePoints: [SplatScenePoint]) {
+        sourceScenePoints.append(contentsOf: sourcePoints)
         if animationSceneIndices.isEmpty {
             animationSceneIndices = Array(repeating: 0, count: sourceScenePoints.count)
             animationSceneCounts = [sourceScenePoints.count]
         } else {
             let targetSceneIndex = animationSceneIndices.last ?? 0
-            animationSceneIndices.append(contentsOf: Array(repeating: targetSceneIndex, count: orderedPoints.count))
+            animationSceneIndices.append(contentsOf: Array(repeating: targetSceneIndex, count: sourcePoints.count))
             if animationSceneCounts.isEmpty {
                 animationSceneCounts = [sourceScenePoints.count]
             } else {
-                animationSceneCounts[animationSceneCounts.count - 1] += orderedPoints.count
+                animationSceneCounts[animationSceneCounts.count - 1] += sourcePoints.count
             }
         }
         animationSceneMetrics = Self.makeSceneMetrics(points: sourceScenePoints,
                                                       sceneIndices: animationSceneIndices,
                                                       sceneCounts: animationSceneCounts)
+    }
+    
+    /// Refreshes derived state after a loader wrote the whole of `splatBuffer` in place (direct PLY, GPU
+    /// dequantization, streamed slabs): geometry and colors are dirty and the sort restarts from identity
+    internal func splatBufferContentsDidChange() throws {
         animationDirty = true
-        markGeometryDirty()  // New splats affect geometry and require re-sorting
-        colorsDirty = true   // New splats also have new colors
+        markGeometryDirty()
+        colorsDirty = true
         if hasEditingResourcesAllocated {
             try ensureEditingResources(pointCount: splatBuffer.count)
         }
+        try initializeIdentitySortedIndices()
+    }
+
+    /// Initialize sorted indices buffer with identity mapping (0, 1, 2, ...)
+    /// Called when splats are added to ensure valid render state before first sort
+    private func initializeIdentitySortedIndices() throws {
+        let count = splatBuffer.count
+        guard count > 0 else { return }
+
+        // Acquire new buffer and fill with identity indices
+        let identityBuffer = try sortIndexBufferPool.acquire(minimumCapacity: count)
+        identityBuffer.count = count
+        for i in 0..<count {
+            identityBuffer.values[i] = Int32(i)
+        }
+
+        // Use thread-safe swap to exchange buffers
+        if let oldBuffer = swapSortedIndicesBuffer(newBuffer: identityBuffer) {
+            // Defer release until GPU is done with old buffer
+            deferredBufferRelease(oldBuffer)
+        }
+    }
+
+    // MARK: - GPU Morton Reordering
+
+    /// Index splat `index` had in load order; identity where no Morton reorder has run
+    public func originalIndex(ofSplatAt index: Int) -> Int {
+        guard let mortonPermutation, index >= 0, index < mortonPermutation.count else { return index }
+        return Int(mortonPermutation[index])
+    }
+
+    /// Current index of the splat that was `originalIndex`th in load order
+    public func splatIndex(forOriginalIndex originalIndex: Int) -> Int? {
+        guard originalIndex >= 0, originalIndex < splatCount else { return nil }
+        guard let mortonPermutation, originalIndex < mortonPermutation.count else { return originalIndex }
+        if inverseMortonPermutation == nil {
+            var inverse = [UInt32](repeating: 0, count: mortonPermutation.count)
+            for (index, original) in mortonPermutation.enumerated() {
+                inverse[Int(original)] = UInt32(index)
+            }
+            inverseMortonPermutation = inverse
+        }
+        return inverseMortonPermutation.map { Int($0[originalIndex]) }
+    }
+
+    private func shouldReorderByMortonOnGPU(count: Int) -> Bool {
+        gpuMortonReorderEnabled && !preserveSourceOrderOnAdd && count > 1 && mortonReorderer != nil
+    }
+
+    /// Whether loads are Morton ordered on the CPU before upload; also covers `gpuMortonReorderEnabled`, which needs
+    /// the CPU ordering when the GPU stage is unavailable
+    internal func shouldReorderByMortonOnCPU(count: Int) -> Bool {
+        (mortonOrderingEnabled || gpuMortonReorderEnabled) && !preserveSourceOrderOnAdd && count > 1
+    }
+
+    /// Radix-sorts `GPUMortonReorderer.MortonCode` pairs on the GPU; nil when only a CPU sort is available
+    internal var gpuKeySorter: GPUMortonReorderer.KeySorter? {
+        if #available(iOS 26.0, macOS 26.0, visionOS 26.0, *), let sorter = metal4Sorter {
+            return { try sorter.sortKeys($0, scratch: $1, count: $2, commandBuffer: $3) }
+        }
+        return nil
+    }
+
+    /// The queue sorts run on. Work that takes buffers from `sortScratchHeap` must be encoded to it.
+    internal var sortCommandQueue: MTLCommandQueue {
+        (computeCommandBufferManager ?? commandBufferManager).queue
+    }
+
+    /// Morton-sorts `range` of the splat buffer on the GPU, with the edit-state and transform-index buffers when
+    /// they cover it. Returns the order applied (element `i` came from `range.lowerBound + order[i]`), or nil when
+    /// the range holds fewer than two splats. When the GPU stage is unavailable or fails, the range is sorted on the
+    /// CPU instead.
+    internal func reorderSplatsByMorton(in range: Range<Int>) -> [UInt32]? {
+        guard range.count > 1, range.upperBound <= splatBuffer.count else { return nil }
+        guard let mortonReorderer else { return reorderSplatsByMortonOnCPU(in: range) }
+
+        var attachments: [GPUMortonReorderer.Attachment] = []
+        let stateStride = MemoryLayout<EditStateStorage>.stride
+        if let editStateBuffer, editStateBuffer.length >= range.upperBound * stateStride {
+            attachments.append(.init(buffer: editStateBuffer, offset: range.lowerBound * stateStride, stride: stateStride))
+        }
+        let transformIndexStride = MemoryLayout<TransformIndexStorage>.stride
+        if let editTransformIndexBuffer, editTransformIndexBuffer.length >= range.upperBound * transformIndexStride {
+            attachments.append(.init(buffer: editTransformIndexBuffer,
+                                     offset: range.lowerBound * transformIndexStride,
+                                     stride: transformIndexStride))
+        }
+
+        let startTime = CFAbsoluteTimeGetCurrent()
+        do {
+            let order = try mortonReorderer.reorder(splats: splatBuffer.buffer,
+                                                    splatOffset: range.lowerBound * MemoryLayout<Splat>.stride,
+                                                    count: range.count,
+                                                    attachments: attachments,
+                                                    commandQueue: sortCommandQueue,
+                                                    keySorter: gpuKeySorter)
+            let duration = CFAbsoluteTimeGetCurrent() - startTime
+            Self.log.info("GPU Morton reordering \(range.count) splats took \(String(format: "%.2f", duration * 1000))ms")
+            return order
+        } catch {
+            Self.log.error("GPU Morton reordering failed, ordering on the CPU: \(error)")
+            return reorderSplatsByMortonOnCPU(in: range)
+        }
+    }
+
+    /// The CPU counterpart of `reorderSplatsByMorton(in:)`, permuting the same buffers in place
+    private func reorderSplatsByMortonOnCPU(in range: Range<Int>) -> [UInt32] {
+        let startTime = CFAbsoluteTimeGetCurrent()
+        let splats = splatBuffer.values + range.lowerBound
+        let order = MortonOrder.computeReorderingIndices(positions: (0..<range.count).map {
+            SIMD3<Float>(splats[$0].position.x, splats[$0].position.y, splats[$0].position.z)
+        })
+
+        func permute<T>(_ values: UnsafeMutablePointer<T>) {
+            let original = Array(UnsafeBufferPointer(start: values, count: range.count))
+            for (index, source) in order.enumerated() {
+                values[index] = original[source]
+            }
+        }
+        permute(splats)
+        if let editStateBuffer,
+           editStateBuffer.length >= range.upperBound * MemoryLayout<EditStateStorage>.stride {
+            permute(editStateBuffer.contents().bindMemory(to: EditStateStorage.self, capacity: range.upperBound)
+                    + range.lowerBound)
+        }
+        if let editTransformIndexBuffer,
+           editTransformIndexBuffer.length >= range.upperBound * MemoryLayout<TransformIndexStorage>.stride {
+            permute(editTransformIndexBuffer.contents().bindMemory(to: TransformIndexStorage.self, capacity: range.upperBound)
+                    + range.lowerBound)
+        }
 
-        // Initialize sorted indices with identity mapping (0, 1, 2, ...)
-        // This ensures rendering works before first sort completes
-        try initializeIdentitySortedIndices()
+        let duration = CFAbsoluteTimeGetCurrent() - startTime
+        Self.log.info("CPU Morton reordering \(range.count) splats took \(String(format: "%.2f", duration * 1000))ms")
+        return order.map { UInt32($0) }
     }
-    
-    /// Initialize sorted indices buffer with identity mapping (0, 1, 2, ...)
-    /// Called when splats are added to ensure valid render state before first sort
-    private func initializeIdentitySortedIndices() throws {
-        let count = splatBuffer.count
-        guard count > 0 else { return }
 
-        // Acquire new buffer and fill with identity indices
-        let identityBuffer = try sortIndexBufferPool.acquire(minimumCapacity: count)
-        identityBuffer.count = count
-        for i in 0..<count {
-            identityBuffer.values[i] = Int32(i)
+    /// `permutation` for a scene that keeps only `indices` of its splats, in that order. The kept load-order
+    /// indices are re-ranked so they stay a permutation of the smaller scene.
+    internal static func mortonPermutation(_ permutation: [UInt32]?, keeping indices: [Int]) -> [UInt32]? {
+        guard let permutation, indices.allSatisfy({ permutation.indices.contains($0) }) else { return nil }
+        let originals = indices.map { permutation[$0] }
+        var kept = [UInt32](repeating: 0, count: originals.count)
+        for (rank, position) in originals.indices.sorted(by: { originals[$0] < originals[$1] }).enumerated() {
+            kept[position] = UInt32(rank)
         }
+        return kept
+    }
 
-        // Use thread-safe swap to exchange buffers
-        if let oldBuffer = swapSortedIndicesBuffer(newBuffer: identityBuffer) {
-            // Defer release until GPU is done with old buffer
-            deferredBufferRelease(oldBuffer)
+    /// Extends `mortonPermutation` with `range`, reordered by `order` or in load order when nil
+    private func recordMortonOrder(_ order: [UInt32]?, for range: Range<Int>) {
+        guard order != nil || mortonPermutation != nil else { return }
+        var permutation = mortonPermutation ?? []
+        // Splats uploaded by paths that don't reorder (direct PLY, GPU dequantization) stay in load order
+        if permutation.count < range.lowerBound {
+            permutation.append(contentsOf: UInt32(permutation.count)..<UInt32(range.lowerBound))
+        } else {
+            permutation.removeSubrange(range.lowerBound...)
+        }
+        let base = UInt32(range.lowerBound)
+        if let order {
+            permutation.append(contentsOf: order.map { base + $0 })
+        } else {
+            permutation.append(contentsOf: base..<UInt32(range.upperBound))
         }
+        mortonPermutation = permutation
     }
 
     public func add(_ point: SplatScenePoint) throws {
@@ -2070,14 +3292,16 @@ public class SplatRenderer: @unchecked Sendable {
         try add([ point ])
     }
 
-    internal func ensureEditingResources(pointCount: Int) throws {
+    /// With `preservingContents`, a resized state or transform index buffer keeps the old buffer's leading values,
+    /// so the edit counters stay valid; otherwise resized buffers start zeroed
+    internal func ensureEditingResources(pointCount: Int, preservingContents: Bool = false) throws {
         let stateLength = max(pointCount, 1) * MemoryLayout<EditStateStorage>.stride
         if editStateBuffer == nil || editStateBuffer?.length != stateLength {
             guard let buffer = device.makeBuffer(length: stateLength, options: .storageModeShared) else {
                 throw SplatRendererError.failedToCreateBuffer(length: stateLength)
             }
             buffer.label = "Editable Splat State Buffer"
-            memset(buffer.contents(), 0, stateLength)
+            Self.fill(buffer, from: preservingContents ? editStateBuffer : nil)
             editStateBuffer = buffer
         }
 
@@ -2087,8 +3311,9 @@ public class SplatRenderer: @unchecked Sendable {
                 throw SplatRendererError.failedToCreateBuffer(length: transformIndexLength)
             }
             buffer.label = "Editable Transform Index Buffer"
-            memset(buffer.contents(), 0, transformIndexLength)
+            Self.fill(buffer, from: preservingContents ? editTransformIndexBuffer : nil)
             editTransformIndexBuffer = buffer
+            selectionClusterInvalidation.invalidateAll()
         }
 
         let paletteLength = max(2, 2) * MemoryLayout<matrix_float4x4>.stride
@@ -2104,6 +3329,15 @@ public class SplatRenderer: @unchecked Sendable {
         }
     }
 
+    /// Copies `source`'s leading bytes into `buffer` and zeroes the rest
+    private static func fill(_ buffer: MTLBuffer, from source: MTLBuffer?) {
+        let copied = min(source?.length ?? 0, buffer.length)
+        if let source, copied > 0 {
+            memcpy(buffer.contents(), source.contents(), copied)
+        }
+        memset(buffer.contents() + copied, 0, buffer.length - copied)
+    }
+
     internal func replaceEditingState(_ rawStates: [UInt32],
                                       transformIndices: [UInt32],
                                       transformPalette: [matrix_float4x4]) throws {
@@ -2139,6 +3373,7 @@ public class SplatRenderer: @unchecked Sendable {
 
         let palettePointer = editTransformPaletteBuffer.contents().bindMemory(to: matrix_float4x4.self, capacity: max(transformPalette.count, 2))
         writeTransformPalette(transformPalette, to: palettePointer)
+        selectionClusterInvalidation.invalidateAll()
         refreshEditingEnabled()
         invalidateRender()
     }
@@ -2198,6 +3433,7 @@ public class SplatRenderer: @unchecked Sendable {
             didChange = true
             updateTransformIndexCounters(from: oldValue, to: newValue)
             pointer[index] = storedValue
+            selectionClusterInvalidation.invalidate(splatIndices: CollectionOfOne(index))
         }
         refreshEditingEnabled()
         if didChange {
@@ -2210,6 +3446,7 @@ public class SplatRenderer: @unchecked Sendable {
         guard let editTransformPaletteBuffer else { return }
         let palettePointer = editTransformPaletteBuffer.contents().bindMemory(to: matrix_float4x4.self, capacity: max(transformPalette.count, 2))
         writeTransformPalette(transformPalette, to: palettePointer)
+        selectionClusterInvalidation.invalidateTransformPalette()
         invalidateRender()
     }
 
@@ -2229,8 +3466,11 @@ public class SplatRenderer: @unchecked Sendable {
         invalidateRender()
     }
 
-    internal func updateSplats(_ points: [SplatScenePoint], at indices: [Int]) throws {
+    /// Rewrites the splats at `indices` from the matching elements of `points`, which covers the whole scene
+    internal func updateSplats<Points: RandomAccessCollection>(_ points: Points, at indices: [Int]) throws
+    where Points.Element == SplatScenePoint, Points.Index == Int {
         guard !indices.isEmpty else { return }
+        materializeSourcePointsIfNeeded()
         splatBuffer.withLockedValues { values, count in
             for index in indices where index >= 0 && index < count && index < points.count {
                 values[index] = Splat(points[index])
@@ -2241,7 +3481,51 @@ public class SplatRenderer: @unchecked Sendable {
             animationMetricsDirty = true
         }
         animationDirty = animationDirty || animationMetricsDirty
+        markGeometryDirty(splatIndices: indices)
+    }
+
+    /// Appends edited splats at the end of the scene without re-uploading the existing ones. Edit state and transform
+    /// indices for the new range start at zero; `sceneIndices` gives each new splat's scene.
+    internal func appendEditedSplats(_ points: [SplatScenePoint], sceneIndices: [UInt32]) throws {
+        guard !points.isEmpty else { return }
+        materializeSourcePointsIfNeeded()
+        let existingSceneIndices = animationSceneIndices.count == sourceScenePoints.count
+            ? animationSceneIndices
+            : Array(repeating: 0, count: sourceScenePoints.count)
+        try ensureAdditionalCapacity(points.count)
+        if hasEditingResourcesAllocated {
+            try ensureEditingResources(pointCount: splatBuffer.count + points.count, preservingContents: true)
+        }
+        try appendSplats(points.map { Splat($0) }, source: .points(points))
+        setAnimationSourcePoints(sourceScenePoints, sceneIndices: existingSceneIndices + sceneIndices)
+    }
+
+    /// Drops every splat from index `count` on, the inverse of `appendEditedSplats`
+    internal func removeTrailingSplats(from count: Int) throws {
+        guard count >= 0, count < splatBuffer.count else { return }
+        materializeSourcePointsIfNeeded()
+        if hasEditingResourcesAllocated {
+            // Clearing through the update paths keeps the edit counters in step with the buffers
+            let removed = Array(count..<splatBuffer.count)
+            let zeros = [UInt32](repeating: 0, count: removed.count)
+            try updateEditStates(at: removed, values: zeros)
+            try updateTransformIndices(at: removed, values: zeros)
+        }
+        let sceneIndices = Array(animationSceneIndices.prefix(count))
+        splatBuffer.count = count
+        sourceScenePoints.removeSubrange(min(count, sourceScenePoints.count)...)
+        if sceneIndices.count == sourceScenePoints.count {
+            setAnimationSourcePoints(sourceScenePoints, sceneIndices: sceneIndices)
+        } else {
+            setAnimationSourcePoints(sourceScenePoints)
+        }
+        mortonPermutation = Self.mortonPermutation(mortonPermutation, keeping: Array(0..<count))
         markGeometryDirty()
+        colorsDirty = true
+        if hasEditingResourcesAllocated {
+            try ensureEditingResources(pointCount: count, preservingContents: true)
+        }
+        try initializeIdentitySortedIndices()
     }
 
     public func replaceSceneLayers(_ layers: [SplatSceneLayer]) throws {
@@ -2250,12 +3534,35 @@ public class SplatRenderer: @unchecked Sendable {
         try replaceAllSplats(with: allPoints, sceneCounts: counts)
     }
 
+    /// With `mortonReorder`, each scene's range (all of `points` unless `sceneCounts` splits it) is Morton-sorted on
+    /// the GPU and the source points follow; ignored when `sceneIndices` is given. Otherwise `mortonPermutation`
+    /// becomes the given permutation, which maps `points` back to load order, or nil.
     internal func replaceAllSplats(with points: [SplatScenePoint],
                                    sceneCounts: [Int]? = nil,
-                                   sceneIndices: [UInt32]? = nil) throws {
+                                   sceneIndices: [UInt32]? = nil,
+                                   mortonReorder: Bool = false,
+                                   mortonPermutation permutation: [UInt32]? = nil) throws {
         try ensureAdditionalCapacity(points.count)
+        directPLYSource = nil
+        pendingSourceBatch = nil
         splatBuffer.count = 0
         splatBuffer.append(points.map { Splat($0) })
+        var points = points
+        mortonPermutation = permutation?.count == points.count ? permutation : nil
+        if mortonReorder && sceneIndices == nil {
+            var rangeStart = 0
+            let counts = sceneCounts.flatMap { $0.reduce(0, +) == points.count ? $0 : nil } ?? [points.count]
+            for count in counts {
+                let range = rangeStart..<(rangeStart + count)
+                let order = reorderSplatsByMorton(in: range)
+                if let order {
+                    let reordered = order.map { points[range.lowerBound + Int($0)] }
+                    points.replaceSubrange(range, with: reordered)
+                }
+                recordMortonOrder(order, for: range)
+                rangeStart += count
+            }
+        }
         if let sceneIndices, sceneIndices.count == points.count {
             setAnimationSourcePoints(points, sceneIndices: sceneIndices)
         } else if let sceneCounts, sceneCounts.reduce(0, +) == points.count {
@@ -2342,7 +3649,12 @@ public class SplatRenderer: @unchecked Sendable {
 
     @discardableResult
     private func compactCurrentSortedIndicesForReducedRenderableSet() -> Bool {
+        os_unfair_lock_lock(&sortStateLock)
+        // Per-view orders and GPU LOD orders (whose draw count lives on the GPU) are re-sorted instead
+        let requiresResort = sortedIndicesViewStride > 0 || sortedIndicesDrawArgumentsOffset != nil
+        os_unfair_lock_unlock(&sortStateLock)
         guard let editStateBuffer,
+              !requiresResort,
               let sortedIndicesBuffer = getCurrentSortedIndicesBuffer() else {
             return false
         }
@@ -2485,6 +3797,8 @@ public class SplatRenderer: @unchecked Sendable {
         os_unfair_lock_unlock(&pendingColorUpdateLock)
 
         guard !updates.isEmpty else { return }
+        // Color edits are mirrored into sourceScenePoints, so directly-loaded and batched scenes need them first
+        materializeSourcePointsIfNeeded()
 
         // Optimization: Find last .full update and skip all updates before it
         // This preserves "last write wins" semantics while avoiding redundant work
@@ -2533,7 +3847,13 @@ public class SplatRenderer: @unchecked Sendable {
 
     /// Marks that geometry has changed and requires re-sorting and bounds update.
     /// Called internally when positions or covariance values are modified.
-    private func markGeometryDirty() {
+    /// `splatIndices` limits the change to those splats for consumers that track edits incrementally
+    private func markGeometryDirty(splatIndices: [Int]? = nil) {
+        if let splatIndices {
+            selectionClusterInvalidation.invalidate(splatIndices: splatIndices)
+        } else {
+            selectionClusterInvalidation.invalidateAll()
+        }
         geometryDirty = true
         frustumCullDirtyDueToData = true
         markSortDataDirty()
@@ -2552,12 +3872,12 @@ public class SplatRenderer: @unchecked Sendable {
     }
 
     internal func acquireAnimatedSplatBuffer(minimumCapacity: Int) throws -> MetalBuffer<Splat> {
-        try splatBufferPool.acquire(minimumCapacity: minimumCapacity)
+        try animatedSplatBufferPool.acquire(minimumCapacity: minimumCapacity)
     }
 
     internal func releaseAnimatedSplatBuffer(_ buffer: MetalBuffer<Splat>, on commandBuffer: MTLCommandBuffer) {
         commandBuffer.addCompletedHandler { [weak self] (_: MTLCommandBuffer) in
-            self?.splatBufferPool.release(buffer)
+            self?.animatedSplatBufferPool.release(buffer)
         }
     }
 
@@ -2812,7 +4132,10 @@ public class SplatRenderer: @unchecked Sendable {
     internal func ensurePrecomputedSplatBuffer(requiredSize: Int) -> MTLBuffer? {
         var currentBuffer = precomputedSplatBuffer
         if currentBuffer == nil || currentBuffer!.length < requiredSize {
-            currentBuffer = device.makeBuffer(length: requiredSize, options: .storageModePrivate)
+            // Drop the old buffer first so its heap space can be reused
+            currentBuffer = nil
+            precomputedSplatBuffer = nil
+            currentBuffer = privateBufferHeap.makeBuffer(length: requiredSize)
             currentBuffer?.label = "Precomputed Splats"
             precomputedSplatBuffer = currentBuffer
         }
@@ -2822,16 +4145,18 @@ public class SplatRenderer: @unchecked Sendable {
     internal func makeUniforms(for viewport: ViewportDescriptor,
                                splatCount: UInt32,
                                indexedSplatCount: UInt32,
-                               debugFlags: UInt32) -> Uniforms {
+                               debugFlags: UInt32,
+                               foveationRates: FoveationRates? = nil) -> Uniforms {
         Self.makeUniforms(for: viewport,
                           splatCount: splatCount,
                           indexedSplatCount: indexedSplatCount,
                           debugFlags: debugFlags,
                           renderMode: renderMode,
-                          covarianceBlur: covarianceBlur,
+                          covarianceBlur: governedCovarianceBlur,
                           lodThresholds: lodThresholds,
                           selectionTintColor: selectionTintColor,
-                          editingEnabled: editingEnabled)
+                          editingEnabled: editingEnabled,
+                          foveationRates: foveationRates)
     }
 
     static func makeUniforms(for viewport: ViewportDescriptor,
@@ -2842,7 +4167,8 @@ public class SplatRenderer: @unchecked Sendable {
                              covarianceBlur: Float,
                              lodThresholds: SIMD3<Float>,
                              selectionTintColor: SIMD4<Float> = SIMD4<Float>(0.15, 0.55, 1.0, 0.45),
-                             editingEnabled: Bool = false) -> Uniforms {
+                             editingEnabled: Bool = false,
+                             foveationRates: FoveationRates? = nil) -> Uniforms {
         let proj00 = viewport.projectionMatrix[0][0]
         let proj11 = viewport.projectionMatrix[1][1]
         let focalX = Float(viewport.screenSize.x) * proj00 / 2
@@ -2863,14 +4189,16 @@ public class SplatRenderer: @unchecked Sendable {
             debugFlags: debugFlags,
             renderMode: renderMode.rawValue,
             isOrthographic: viewport.isOrthographic ? 1 : 0,
-            padding1: 0,
+            instanceSplatCount: 0,
             lodThresholds: lodThresholds,
             covarianceBlur: covarianceBlur,
             selectionTintColor: selectionTintColor,
             editingEnabled: editingEnabled ? 1 : 0,
-            padding2: 0,
-            padding3: 0,
-            padding4: 0
+            sortedIndexViewOffset: 0,
+            foveationEnabled: foveationRates == nil ? 0 : 1,
+            instanceCount: 0,
+            foveationRatesX: foveationRates?.horizontal ?? .zero,
+            foveationRatesY: foveationRates?.vertical ?? .zero
         )
     }
 
@@ -2917,7 +4245,7 @@ public class SplatRenderer: @unchecked Sendable {
 
         var splatCountValue = UInt32(splatCount)
         
-        guard let computeEncoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let computeEncoder = commandBuffer.makeComputeCommandEncoder(timing: .precompute, with: frameTimelineRecorder) else {
             Self.log.error("Failed to create compute encoder for batch precompute")
             return
         }
@@ -2949,20 +4277,28 @@ public class SplatRenderer: @unchecked Sendable {
 
     // MARK: - Frustum Culling
     
+    /// Ring slot of a frustum culling pass's visible count, read back once its command buffer completes
+    struct FrustumCullReadbackSlot: Sendable {
+        let serial: UInt64
+        let byteOffset: Int
+    }
+
     /// Encode frustum culling compute pass into command buffer
-    /// Includes: reset count → cull splats → generate indirect draw args
-    private func encodeFrustumCulling(viewport: ViewportDescriptor, to commandBuffer: MTLCommandBuffer) {
+    /// Includes: reset count → cull splats → generate indirect draw args → copy count to readback slot.
+    /// The count never round-trips through the CPU before the draw; only the copy is read, asynchronously.
+    /// - Returns: The readback slot to publish from a completed handler, or nil if culling was not encoded
+    ///   or no readback buffer is available
+    private func encodeFrustumCulling(viewport: ViewportDescriptor, to commandBuffer: MTLCommandBuffer) -> FrustumCullReadbackSlot? {
         let editStateBuffer = visibilityFilteringEditStateBuffer
         let cullPipeline = editStateBuffer == nil ? frustumCullNoEditPipelineState : frustumCullPipelineState
         guard frustumCullingEnabled,
               let cullPipeline,
               let resetPipeline = resetVisibleCountPipelineState,
               let generateArgsPipeline = generateIndirectArgsPipelineState,
-              let cullDataBuffer = frustumCullDataBuffer,
               let countBuffer = visibleCountBuffer,
               let argsBuffer = indirectDrawArgsBuffer,
               splatCount > 0 else {
-            return
+            return nil
         }
         
         // Ensure visible indices buffer is large enough
@@ -2974,7 +4310,7 @@ public class SplatRenderer: @unchecked Sendable {
             currentIndicesBuffer?.label = "Visible Indices"
             visibleIndicesBuffer = currentIndicesBuffer
         }
-        guard let indicesBuffer = currentIndicesBuffer else { return }
+        guard let indicesBuffer = currentIndicesBuffer else { return nil }
         
         // Prepare view-projection matrix for NDC-based culling
         let viewProjection = viewport.projectionMatrix * viewport.viewMatrix
@@ -2984,18 +4320,16 @@ public class SplatRenderer: @unchecked Sendable {
         let cameraPosition = SIMD3<Float>(invView[3][0], invView[3][1], invView[3][2])
         
         // Prepare cull data with view-projection matrix
+        // Passed inline rather than through a shared buffer, so the CPU never writes memory a previous frame may still read
         var cullData = FrustumCullData()
         cullData.viewProjectionMatrix = viewProjection
         cullData.cameraPosition = cameraPosition
         cullData.maxDistance = 10000.0  // Large value = effectively no distance culling
         
-        // Copy cull data to buffer
-        cullDataBuffer.contents().copyMemory(from: &cullData, byteCount: MemoryLayout<FrustumCullData>.stride)
-        
         // === Step 1: Reset visible count on GPU ===
-        guard let resetEncoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let resetEncoder = commandBuffer.makeComputeCommandEncoder(timing: .cull, with: frameTimelineRecorder) else {
             Self.log.error("Failed to create compute encoder for reset visible count")
-            return
+            return nil
         }
         resetEncoder.label = "Reset Visible Count"
         resetEncoder.setComputePipelineState(resetPipeline)
@@ -3005,16 +4339,16 @@ public class SplatRenderer: @unchecked Sendable {
         resetEncoder.endEncoding()
         
         // === Step 2: Frustum cull splats ===
-        guard let cullEncoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let cullEncoder = commandBuffer.makeComputeCommandEncoder(timing: .cull, with: frameTimelineRecorder) else {
             Self.log.error("Failed to create compute encoder for frustum culling")
-            return
+            return nil
         }
         cullEncoder.label = "Frustum Culling"
         cullEncoder.setComputePipelineState(cullPipeline)
         cullEncoder.setBuffer(activeSplatBufferForRendering.buffer, offset: 0, index: 0)
         cullEncoder.setBuffer(indicesBuffer, offset: 0, index: 1)
         cullEncoder.setBuffer(countBuffer, offset: 0, index: 2)
-        cullEncoder.setBuffer(cullDataBuffer, offset: 0, index: 3)
+        cullEncoder.setBytes(&cullData, length: MemoryLayout<FrustumCullData>.stride, index: 3)
         var count = UInt32(splatCount)
         if let editStateBuffer {
             cullEncoder.setBuffer(editStateBuffer, offset: 0, index: 4)
@@ -3029,9 +4363,9 @@ public class SplatRenderer: @unchecked Sendable {
         cullEncoder.endEncoding()
         
         // === Step 3: Generate indirect draw arguments ===
-        guard let argsEncoder = commandBuffer.makeComputeCommandEncoder() else {
+        guard let argsEncoder = commandBuffer.makeComputeCommandEncoder(timing: .cull, with: frameTimelineRecorder) else {
             Self.log.error("Failed to create compute encoder for indirect draw args")
-            return
+            return nil
         }
         argsEncoder.label = "Generate Indirect Draw Args"
         argsEncoder.setComputePipelineState(generateArgsPipeline)
@@ -3046,34 +4380,100 @@ public class SplatRenderer: @unchecked Sendable {
         argsEncoder.dispatchThreads(MTLSize(width: 1, height: 1, depth: 1),
                                     threadsPerThreadgroup: MTLSize(width: 1, height: 1, depth: 1))
         argsEncoder.endEncoding()
+
+        // === Step 4: Copy the count into this frame's readback slot ===
+        guard let readbackBuffer = visibleCountReadbackBuffer,
+              let blit = commandBuffer.makeBlitCommandEncoder() else {
+            return nil
+        }
+        let slot = Self.visibleCountReadbackSlot(frameIndex: uniformBufferIndex, ringSize: maxSimultaneousRenders)
+        blit.label = "Visible Count Readback"
+        blit.copy(from: countBuffer, sourceOffset: 0,
+                  to: readbackBuffer, destinationOffset: slot,
+                  size: MemoryLayout<UInt32>.stride)
+        blit.endEncoding()
+
+        frustumCullSerial &+= 1
+        return FrustumCullReadbackSlot(serial: frustumCullSerial, byteOffset: slot)
     }
-    
-    /// Read back frustum culling results after command buffer completes
-    /// Call this in the completion handler
-    private func readFrustumCullingResults() {
-        guard frustumCullingEnabled,
-              let countBuffer = visibleCountBuffer else {
+
+    /// Byte offset of a frame's visible-count slot; frames share the uniform ring index, so a slot is
+    /// never rewritten while the command buffer that filled it may still be in flight
+    static func visibleCountReadbackSlot(frameIndex: Int, ringSize: Int) -> Int {
+        (frameIndex % max(ringSize, 1)) * MemoryLayout<UInt32>.stride
+    }
+
+    /// Publishes a completed culling pass's visible count for `culledSplatCount`.
+    /// Called from the command buffer's completed handler; results older than the last published one are dropped.
+    private func publishFrustumCullingResults(_ slot: FrustumCullReadbackSlot) {
+        guard let readbackBuffer = visibleCountReadbackBuffer else { return }
+        let visibleCount = Int(readbackBuffer.contents().load(fromByteOffset: slot.byteOffset, as: UInt32.self))
+
+        os_unfair_lock_lock(&frustumCullStatsLock)
+        guard slot.serial > lastVisibleCountSerial else {
+            os_unfair_lock_unlock(&frustumCullStatsLock)
             return
         }
-        
-        let visibleCount = countBuffer.contents().load(as: UInt32.self)
         let previousCount = lastVisibleCount
-        lastVisibleCount = Int(visibleCount)
-        
+        lastVisibleCount = visibleCount
+        lastVisibleCountSerial = slot.serial
+        os_unfair_lock_unlock(&frustumCullStatsLock)
+
         // Log when count changes by more than 5%
         let totalCount = self.renderableSplatCountForCurrentEditState
         let changeThreshold = max(totalCount / 20, 100)  // At least 100 splats or 5%
-        if abs(lastVisibleCount - previousCount) > changeThreshold {
+        if abs(visibleCount - previousCount) > changeThreshold {
             let percentage = totalCount > 0 ? Int(Float(visibleCount) / Float(totalCount) * 100) : 0
             Self.log.info("Frustum culling: \(visibleCount)/\(totalCount) visible (\(percentage)%)")
         }
     }
     
-    /// Get the last frustum culling result
+    /// Splats that survived the last GPU LOD selection, or nil if the last sort did not use GPU LOD.
+    /// Published from the sort's completion handler; the render path never reads the count back.
+    public var lodSelectedSplatCount: Int? {
+        os_unfair_lock_lock(&sortStateLock)
+        defer { os_unfair_lock_unlock(&sortStateLock) }
+        return lastLODSelectedSplatCount
+    }
+
+    /// Get the last frustum culling result.
+    /// Published asynchronously once each culling pass completes on the GPU, so it trails the frame being
+    /// encoded; draws never depend on it.
     public var culledSplatCount: Int {
-        frustumCullingEnabled ? lastVisibleCount : renderableSplatCountForCurrentEditState
+        guard frustumCullingEnabled else { return renderableSplatCountForCurrentEditState }
+        os_unfair_lock_lock(&frustumCullStatsLock)
+        defer { os_unfair_lock_unlock(&frustumCullStatsLock) }
+        return lastVisibleCount
     }
-    
+
+    // MARK: - Quality Governor Control
+
+    /// Picks up the governor's level once per change, at the start of a frame so one frame never mixes two levels
+    internal func applyQualityGovernorIfNeeded() {
+        let generation = qualityGovernor?.generation
+        guard generation != appliedGovernorGeneration || (qualityGovernor == nil && governedSettings != .full) else { return }
+        appliedGovernorGeneration = generation
+
+        let settings = qualityGovernor?.settings ?? .full
+        guard settings != governedSettings else { return }
+        if settings.covarianceBlurScale != governedSettings.covarianceBlurScale {
+            invalidatePrecomputedData()
+        }
+        governedSettings = settings
+        invalidateRender()
+    }
+
+    /// Hands a frame's CPU encode time, and its GPU time once `commandBuffer` completes, to `governor`. Every render
+    /// path that called `applyQualityGovernorIfNeeded()` for a frame reports it here exactly once.
+    internal func reportGovernedFrame(to governor: SplatQualityGovernor?,
+                                      cpuEncodeDuration: CFAbsoluteTime,
+                                      commandBuffer: MTLCommandBuffer) {
+        guard let governor else { return }
+        commandBuffer.addCompletedHandler { commandBuffer in
+            governor.recordFrame(gpuTime: Self.gpuDuration(for: commandBuffer), cpuTime: cpuEncodeDuration)
+        }
+    }
+
     // MARK: - Interaction Mode Control
     
     /// Begin interaction mode - relaxes sort parameters for smoother user experience
@@ -3127,7 +4527,7 @@ public class SplatRenderer: @unchecked Sendable {
         
         // Schedule a final quality-threshold check after a brief delay. If an
         // interaction sort already matches the settled camera, avoid forcing work.
-        if !useDitheredTransparency {
+        if !drawsDitheredTransparency {
             DispatchQueue.main.asyncAfter(deadline: .now() + postInteractionSortDelay) { [weak self] in
                 guard let self = self else { return }
                 // Only the latest interaction end owns the delayed quality check.
@@ -3168,6 +4568,7 @@ public class SplatRenderer: @unchecked Sendable {
     /// Manually triggers memory pressure cleanup on buffer pools
     public func trimBufferPools() {
         splatBufferPool.trimToMemoryPressure()
+        animatedSplatBufferPool.trimToMemoryPressure()
         indexBufferPool.trimToMemoryPressure()
     }
 
@@ -3180,7 +4581,10 @@ public class SplatRenderer: @unchecked Sendable {
     private func shouldResortForCurrentCamera() -> Bool {
         // Skip sorting entirely when using dithered transparency
         // Dithered mode is order-independent, so sort order doesn't affect visual quality
-        if useDitheredTransparency {
+        if drawsDitheredTransparency {
+            return false
+        }
+        if tileRasterizerDrewLastFrame {
             return false
         }
         let now = CFAbsoluteTimeGetCurrent()
@@ -3215,8 +4619,8 @@ public class SplatRenderer: @unchecked Sendable {
             currentForward: sortCameraForward,
             lastPosition: previousSortPosition,
             lastForward: previousSortForward,
-            positionEpsilon: sortPositionEpsilon,
-            directionEpsilon: sortDirectionEpsilon
+            positionEpsilon: sortPositionEpsilon * governedSettings.sortEpsilonScale,
+            directionEpsilon: sortDirectionEpsilon * governedSettings.sortEpsilonScale
         )
     }
 
@@ -3302,7 +4706,11 @@ public class SplatRenderer: @unchecked Sendable {
         }
 
         let now = CFAbsoluteTimeGetCurrent()
-        if minimumSHUpdateInterval > 0 && (now - lastSHUpdateTime) < minimumSHUpdateInterval {
+        var minimumInterval = minimumSHUpdateInterval
+        if let qualityGovernor, governedSettings.shUpdateIntervalFrames > 0 {
+            minimumInterval = max(minimumInterval, Double(governedSettings.shUpdateIntervalFrames) * qualityGovernor.targetFrameTime)
+        }
+        if minimumInterval > 0 && (now - lastSHUpdateTime) < minimumInterval {
             return false
         }
 
@@ -3311,7 +4719,7 @@ public class SplatRenderer: @unchecked Sendable {
         }
 
         let directionDelta = 1 - simd_dot(simd_normalize(cameraWorldForward), simd_normalize(lastDir))
-        return directionDelta > shDirectionEpsilon
+        return directionDelta > shDirectionEpsilon * governedSettings.shDirectionEpsilonScale
     }
 
     /// Marks that SH evaluation has completed for the current camera direction.
@@ -3324,14 +4732,16 @@ public class SplatRenderer: @unchecked Sendable {
 
     internal func updateUniforms(forViewports viewports: [ViewportDescriptor],
                                 splatCount: UInt32,
-                                indexedSplatCount: UInt32) {
+                                indexedSplatCount: UInt32,
+                                rasterizationRateMap: MTLRasterizationRateMap? = nil) {
         // Clamp to maxViewCount to avoid buffer overrun (off-by-one fix: use < not <=)
         for (i, viewport) in viewports.prefix(maxViewCount).enumerated() {
             let debugFlags = debugOptions.rawValue
             let uniforms = makeUniforms(for: viewport,
                                         splatCount: splatCount,
                                         indexedSplatCount: indexedSplatCount,
-                                        debugFlags: debugFlags)
+                                        debugFlags: debugFlags,
+                                        foveationRates: rasterizationRateMap.map { FoveationRates($0, layer: i) })
             self.uniforms.pointee.setUniforms(index: i, uniforms)
         }
         // Use cached arrays to avoid per-frame allocations
@@ -3348,13 +4758,29 @@ public class SplatRenderer: @unchecked Sendable {
         }
         cameraWorldPosition = cameraPositionsTemp.mean ?? .zero
         cameraWorldForward = cameraForwardsTemp.mean?.normalized ?? .init(x: 0, y: 0, z: -1)
-        sortCameraPosition = cameraPositionsTemp.first ?? .zero
-        sortCameraForward = cameraForwardsTemp.first?.normalized ?? .init(x: 0, y: 0, z: -1)
+        if viewports.count >= 2 {
+            let left = StereoSortEye(position: cameraPositionsTemp[0], forward: cameraForwardsTemp[0].normalized)
+            let right = StereoSortEye(position: cameraPositionsTemp[1], forward: cameraForwardsTemp[1].normalized)
+            stereoSortEyes = (left, right)
+            recordStereoFrame()
+        } else {
+            stereoSortEyes = nil
+        }
+        if let stereoSortEyes, stereoSortMode == .midpoint {
+            sortCameraPosition = (stereoSortEyes.left.position + stereoSortEyes.right.position) * 0.5
+            sortCameraForward = (stereoSortEyes.left.forward + stereoSortEyes.right.forward).normalized
+        } else {
+            sortCameraPosition = cameraPositionsTemp.first ?? .zero
+            sortCameraForward = cameraForwardsTemp.first?.normalized ?? .init(x: 0, y: 0, z: -1)
+        }
         currentSortViewMatrix = viewports.first?.viewMatrix
         currentFrustumCullProjectionMatrix = viewports.first?.projectionMatrix
+        if let firstViewport = viewports.first {
+            lodProjectionScale = Float(firstViewport.screenSize.y) * firstViewport.projectionMatrix[1][1] / 2
+        }
 
-        if !isSorting && shouldResortForCurrentCamera() {
-            resort()
+        if !isSorting && !isEncodingFrameSortOrder && shouldResortForCurrentCamera() {
+            resort(useGPU: !prefersCPUSorting)
         }
     }
 
@@ -3380,7 +4806,7 @@ public class SplatRenderer: @unchecked Sendable {
         renderPassDescriptor.colorAttachments[0].texture = colorTexture
         renderPassDescriptor.colorAttachments[0].loadAction = colorLoadAction
         renderPassDescriptor.colorAttachments[0].storeAction = colorStoreAction
-        renderPassDescriptor.colorAttachments[0].clearColor = clearColor
+        renderPassDescriptor.colorAttachments[0].clearColor = clearColorOverride ?? clearColor
         if let depthTexture {
             renderPassDescriptor.depthAttachment.texture = depthTexture
             renderPassDescriptor.depthAttachment.loadAction = .clear
@@ -3389,6 +4815,9 @@ public class SplatRenderer: @unchecked Sendable {
         }
         renderPassDescriptor.rasterizationRateMap = rasterizationRateMap
         renderPassDescriptor.renderTargetArrayLength = renderTargetArrayLength
+        if let rasterizationRateMap {
+            Self.limitRenderTargetSize(of: renderPassDescriptor, to: rasterizationRateMap)
+        }
 
         renderPassDescriptor.tileWidth  = Constants.tileSize.width
         renderPassDescriptor.tileHeight = Constants.tileSize.height
@@ -3401,6 +4830,8 @@ public class SplatRenderer: @unchecked Sendable {
             }
         }
 
+        frameTimelineRecorder?.attach(.draw, to: renderPassDescriptor, on: commandBuffer)
+
         guard let renderEncoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPassDescriptor) else {
             Self.log.error("Failed to create primary render encoder")
             return nil
@@ -3441,8 +4872,15 @@ public class SplatRenderer: @unchecked Sendable {
         frameStartTime = CFAbsoluteTimeGetCurrent()
         frameBufferUploads = 0
         let renderedRevision = renderRevision
+        let frameTimelineRecorder = self.frameTimelineRecorder
+        frameTimelineRecorder?.beginFrame()
+        let qualityGovernor = self.qualityGovernor
+        applyQualityGovernorIfNeeded()
         defer {
             lastRenderedRevision = renderedRevision
+            let cpuEncodeDuration = CFAbsoluteTimeGetCurrent() - frameStartTime
+            frameTimelineRecorder?.endFrame(cpuEncodeDuration: cpuEncodeDuration)
+            reportGovernedFrame(to: qualityGovernor, cpuEncodeDuration: cpuEncodeDuration, commandBuffer: commandBuffer)
         }
 
         // Apply any pending color updates before GPU work begins.
@@ -3450,9 +4888,40 @@ public class SplatRenderer: @unchecked Sendable {
         applyPendingColorUpdates()
         updateAnimatedSplatsIfNeeded(to: commandBuffer)
         schedulePendingBufferRelease(on: commandBuffer)
+        installCompiledPipelines()
+        if let streamingScene {
+            try updateStreamingScene(streamingScene, viewports: viewports)
+        }
+
+        if let packedSplatStore {
+            try renderPackedSplats(packedSplatStore,
+                                   viewports: viewports,
+                                   colorTexture: colorTexture,
+                                   colorLoadAction: colorLoadAction,
+                                   colorStoreAction: colorStoreAction,
+                                   depthTexture: depthTexture,
+                                   depthStoreAction: depthStoreAction,
+                                   rasterizationRateMap: rasterizationRateMap,
+                                   renderTargetArrayLength: renderTargetArrayLength,
+                                   to: commandBuffer)
+            return
+        }
 
         let splatCount = splatBuffer.count
         guard splatCount != 0 else { return }
+        if let splatInstanceSet {
+            try renderSplatInstances(splatInstanceSet,
+                                     viewports: viewports,
+                                     colorTexture: colorTexture,
+                                     colorLoadAction: colorLoadAction,
+                                     colorStoreAction: colorStoreAction,
+                                     depthTexture: depthTexture,
+                                     depthStoreAction: depthStoreAction,
+                                     rasterizationRateMap: rasterizationRateMap,
+                                     renderTargetArrayLength: renderTargetArrayLength,
+                                     to: commandBuffer)
+            return
+        }
         let drawSplatCount = renderableSplatCountForCurrentEditState
         guard drawSplatCount > 0 else { return }
         let indexedSplatCount = min(drawSplatCount, Constants.maxIndexedSplatCount)
@@ -3463,7 +4932,10 @@ public class SplatRenderer: @unchecked Sendable {
         }
 
         switchToNextDynamicBuffer()
-        updateUniforms(forViewports: viewports, splatCount: UInt32(drawSplatCount), indexedSplatCount: UInt32(indexedSplatCount))
+        updateUniforms(forViewports: viewports,
+                       splatCount: UInt32(drawSplatCount),
+                       indexedSplatCount: UInt32(indexedSplatCount),
+                       rasterizationRateMap: rasterizationRateMap)
         frameBufferUploads += 1 // uniforms update
         
         // GPU Frustum Culling: encode compute pass before rendering
@@ -3475,11 +4947,12 @@ public class SplatRenderer: @unchecked Sendable {
             lastFrustumCullProjectionMatrix = firstViewport.projectionMatrix
             lastFrustumCullTime = CFAbsoluteTimeGetCurrent()
             frustumCullDirtyDueToData = false
-            encodeFrustumCulling(viewport: firstViewport, to: commandBuffer)
-            
-            // Add completion handler to read culling results
-            commandBuffer.addCompletedHandler { [weak self] _ in
-                self?.readFrustumCullingResults()
+            if let readbackSlot = encodeFrustumCulling(viewport: firstViewport, to: commandBuffer) {
+                // The draw consumes the count through indirect arguments; the statistic is published
+                // when the GPU is done, without the render loop ever waiting on it
+                commandBuffer.addCompletedHandler { [weak self] _ in
+                    self?.publishFrustumCullingResults(readbackSlot)
+                }
             }
         }
         
@@ -3502,13 +4975,35 @@ public class SplatRenderer: @unchecked Sendable {
             }
         }
 
+        // =========================================================================
+        // TILE RASTERIZER PATH (compute, Metal 4)
+        // Bins, sorts and blends per 16x16 tile; falls back below when unsupported
+        // =========================================================================
+        if useTileRasterizer,
+           renderWithTileRasterizer(viewports: viewports,
+                                    splatCount: splatCount,
+                                    colorTexture: colorTexture,
+                                    colorLoadAction: colorLoadAction,
+                                    colorStoreAction: colorStoreAction,
+                                    depthTexture: depthTexture,
+                                    depthStoreAction: depthStoreAction,
+                                    rasterizationRateMap: rasterizationRateMap,
+                                    renderTargetArrayLength: renderTargetArrayLength,
+                                    to: commandBuffer) {
+            return
+        }
+        tileRasterizerDrewLastFrame = false
+
         // =========================================================================
         // MESH SHADER PATH (Metal 3+)
         // Generates geometry entirely on GPU - significant performance improvement
         // Note: Mesh shader path doesn't support frustum culling with dithered mode yet
         // (would need indirect dispatch with visible count)
         // =========================================================================
-        let useCulledDitheredPath = useDitheredTransparency && frustumCullingEnabled
+        let useCulledDitheredPath = drawsDitheredTransparency && frustumCullingEnabled
+        if meshShaderEnabled && canUseMeshShadersSafely && meshShaderPipelineState == nil {
+            requestMeshShaderPipeline()
+        }
         if meshShaderEnabled && canUseMeshShadersSafely && !useCulledDitheredPath,
            let meshPipeline = meshShaderPipelineState,
            let meshDepth = meshShaderDepthState,
@@ -3577,12 +5072,16 @@ public class SplatRenderer: @unchecked Sendable {
         // =========================================================================
         // TRADITIONAL VERTEX SHADER PATH (fallback)
         // =========================================================================
-        let multiStage = useMultiStagePipeline
-        if multiStage {
-            try buildMultiStagePipelineStatesIfNeeded()
-        } else if useDitheredTransparency {
-            try buildDitheredPipelineStatesIfNeeded()
-        } else {
+        // Until a background compile lands, the selected path draws single-stage
+        var multiStage = useMultiStagePipeline
+        var dithered = drawsDitheredTransparency && !multiStage
+        if multiStage, !(try prepareMultiStagePipelineStates()) {
+            multiStage = false
+            dithered = false
+        } else if dithered, !(try prepareDitheredPipelineStates()) {
+            dithered = false
+        }
+        if !multiStage && !dithered {
             try buildSingleStagePipelineStatesIfNeeded()
         }
 
@@ -3644,7 +5143,7 @@ public class SplatRenderer: @unchecked Sendable {
             renderEncoder.pushDebugGroup("Draw Splats")
             renderEncoder.setRenderPipelineState(drawPipelineState)
             renderEncoder.setDepthStencilState(drawSplatDepthState)
-        } else if useDitheredTransparency {
+        } else if dithered {
             guard let ditheredPipelineState = bindEditingResources ? ditheredEditingPipelineState : ditheredPipelineState
             else { return }
 
@@ -3677,8 +5176,9 @@ public class SplatRenderer: @unchecked Sendable {
         }
 
         // Dithered + Frustum Culling: use culled indices directly (order-independent)
-        // This avoids sorting entirely while still benefiting from frustum culling
-        if useDitheredTransparency && frustumCullingEnabled,
+        // This avoids sorting entirely while still benefiting from frustum culling.
+        // A single-stage fallback frame blends, so it keeps the sorted order.
+        if drawsDitheredTransparency && frustumCullingEnabled && (multiStage || dithered),
            let visibleIndices = visibleIndicesBuffer,
            let indirectArgs = indirectDrawArgsBuffer {
             // Use culled visible indices (unsorted is fine for dithered transparency)
@@ -3695,16 +5195,29 @@ public class SplatRenderer: @unchecked Sendable {
             )
         } else {
             // Standard path: use sorted indices for correct alpha blending
-            if let sortedIndices = getCurrentSortedIndicesBuffer() {
-                renderEncoder.setVertexBuffer(sortedIndices.buffer, offset: 0, index: BufferIndex.sortedIndices.rawValue)
-            }
+            let boundOrder = bindCurrentSortedIndices(to: renderEncoder)
 
-            renderEncoder.drawIndexedPrimitives(type: .triangle,
-                                                indexCount: indexCount,
-                                                indexType: .uint32,
-                                                indexBuffer: indexBuffer.buffer,
-                                                indexBufferOffset: 0,
-                                                instanceCount: instanceCount)
+            // Front-to-back reads the order from its end, so it always covers the full renderable range
+            if let boundOrder,
+               let drawArgumentsByteOffset = boundOrder.drawArgumentsByteOffset,
+               !(multiStage && drawsMultiStageFrontToBack) {
+                // GPU LOD: the sort wrote the survivor count into indirect arguments after the order
+                renderEncoder.drawIndexedPrimitives(
+                    type: .triangle,
+                    indexType: .uint32,
+                    indexBuffer: indexBuffer.buffer,
+                    indexBufferOffset: 0,
+                    indirectBuffer: boundOrder.buffer,
+                    indirectBufferOffset: drawArgumentsByteOffset
+                )
+            } else {
+                renderEncoder.drawIndexedPrimitives(type: .triangle,
+                                                    indexCount: indexCount,
+                                                    indexType: .uint32,
+                                                    indexBuffer: indexBuffer.buffer,
+                                                    indexBufferOffset: 0,
+                                                    instanceCount: instanceCount)
+            }
         }
 
         if !multiStage,
@@ -3736,7 +5249,9 @@ public class SplatRenderer: @unchecked Sendable {
                 renderEncoder.setDepthStencilState(postprocessDepthState)
             }
             renderEncoder.setCullMode(.none)
+            let postprocessSample = frameTimelineRecorder?.beginDraws(.postprocess, in: renderEncoder, on: commandBuffer)
             renderEncoder.drawPrimitives(type: .triangle, vertexStart: 0, vertexCount: 3)
+            frameTimelineRecorder?.endDraws(postprocessSample, in: renderEncoder)
             renderEncoder.popDebugGroup()
         } else {
             renderEncoder.popDebugGroup()
@@ -3814,6 +5329,94 @@ public class SplatRenderer: @unchecked Sendable {
         }
     }
     
+    /// The tile rasterizer, created on first use; nil once creating it has failed
+    @available(iOS 26.0, macOS 26.0, visionOS 26.0, *)
+    private func tileRasterizerIfAvailable() -> TileRasterizer? {
+        if let rasterizer = _tileRasterizer as? TileRasterizer {
+            return rasterizer
+        }
+        guard !tileRasterizerUnavailable else { return nil }
+        do {
+            let rasterizer = try TileRasterizer(device: device,
+                                                library: library,
+                                                colorFormat: colorFormat,
+                                                depthFormat: depthFormat,
+                                                sampleCount: sampleCount,
+                                                maxViewCount: maxViewCount,
+                                                maxSimultaneousRenders: maxSimultaneousRenders)
+            _tileRasterizer = rasterizer
+            return rasterizer
+        } catch {
+            Self.log.warning("Failed to create tile rasterizer - falling back to quad rendering: \(error)")
+            tileRasterizerUnavailable = true
+            return nil
+        }
+    }
+
+    /// Draws the frame with the tile rasterizer.
+    /// - Returns: False if this frame can't use it (OS version, multiple viewports, rate map, failure)
+    private func renderWithTileRasterizer(viewports: [ViewportDescriptor],
+                                          splatCount: Int,
+                                          colorTexture: MTLTexture,
+                                          colorLoadAction: MTLLoadAction,
+                                          colorStoreAction: MTLStoreAction,
+                                          depthTexture: MTLTexture?,
+                                          depthStoreAction: MTLStoreAction,
+                                          rasterizationRateMap: MTLRasterizationRateMap?,
+                                          renderTargetArrayLength: Int,
+                                          to commandBuffer: MTLCommandBuffer) -> Bool {
+        guard #available(iOS 26.0, macOS 26.0, visionOS 26.0, *) else { return false }
+        guard viewports.count == 1,
+              rasterizationRateMap == nil,
+              let viewport = viewports.first,
+              let rasterizer = tileRasterizerIfAvailable() else {
+            return false
+        }
+
+        let readbackSlot: Int
+        do {
+            readbackSlot = try rasterizer.encodeRasterization(commandBuffer: commandBuffer,
+                                                              splatBuffer: activeSplatBufferForRendering.buffer,
+                                                              editStateBuffer: visibilityFilteringEditStateBuffer,
+                                                              uniformsBuffer: dynamicUniformBuffers,
+                                                              uniformsOffset: uniformBufferOffset,
+                                                              splatCount: splatCount,
+                                                              screenSize: viewport.screenSize,
+                                                              frameIndex: uniformBufferIndex)
+        } catch {
+            Self.log.error("Tile rasterizer failed - falling back to quad rendering: \(error)")
+            return false
+        }
+        // Sizes the next frames' tile entries; never waited on
+        commandBuffer.addCompletedHandler { _ in
+            rasterizer.publishEntryCount(readbackSlot: readbackSlot)
+        }
+
+        guard let renderEncoder = renderEncoder(multiStage: false,
+                                                viewports: viewports,
+                                                colorTexture: colorTexture,
+                                                colorLoadAction: colorLoadAction,
+                                                colorStoreAction: colorStoreAction,
+                                                depthTexture: depthTexture,
+                                                depthStoreAction: depthStoreAction,
+                                                rasterizationRateMap: rasterizationRateMap,
+                                                renderTargetArrayLength: renderTargetArrayLength,
+                                                for: commandBuffer) else {
+            return true
+        }
+        rasterizer.encodeComposite(renderEncoder: renderEncoder,
+                                   viewportOrigin: SIMD2(Float(viewport.viewport.originX), Float(viewport.viewport.originY)))
+        renderEncoder.endEncoding()
+
+        if debugOptions.contains(.showAABB), let bounds = calculateBounds() {
+            drawDebugAABB(bounds: bounds, viewports: viewports, colorTexture: colorTexture,
+                         depthTexture: depthTexture, rasterizationRateMap: rasterizationRateMap,
+                         renderTargetArrayLength: renderTargetArrayLength, commandBuffer: commandBuffer)
+        }
+        tileRasterizerDrewLastFrame = true
+        return true
+    }
+
     /// Helper to draw debug AABB wireframe - used by both mesh shader and traditional paths
     private func drawDebugAABB(bounds: (min: SIMD3<Float>, max: SIMD3<Float>),
                                viewports: [ViewportDescriptor],
@@ -3873,9 +5476,14 @@ public class SplatRenderer: @unchecked Sendable {
         cameraWorldForward: SIMD3<Float>,
         sortViewMatrix: simd_float4x4?,
         dataDirtySnapshot: UInt64,
+        stereoContext: StereoSortContext?,
         performanceContext: SortPerformanceContext,
+        residualInversionRatio: Double? = nil,
+        drawArgumentsOffset: Int? = nil,
+        lodSelectedSplatCount: Int? = nil,
         completionHandlerTime: CFAbsoluteTime?,
         gpuTime: TimeInterval?,
+        sortCompleted: Bool,
         commandBufferStatus: String
     ) {
         let bufferReadyTime = completionHandlerTime ?? CFAbsoluteTimeGetCurrent()
@@ -3885,12 +5493,32 @@ public class SplatRenderer: @unchecked Sendable {
         // GPU-only sorting uses double buffering. Publish the newly sorted indices
         // under the same lock used by render reads, so the next frame can consume
         // them without waiting for a main-queue turn.
-        if let oldBuffer = swapSortedIndicesBuffer(newBuffer: indexOutputBuffer) {
+        if let oldBuffer = swapSortedIndicesBuffer(newBuffer: indexOutputBuffer,
+                                                   viewStride: stereoContext?.viewStride ?? 0,
+                                                   drawArgumentsOffset: drawArgumentsOffset) {
             // IMPORTANT: Defer release until a later render command buffer completes.
             // The old buffer may still be referenced by in-flight GPU work.
             deferredBufferRelease(oldBuffer)
         }
 
+        if let stereoContext {
+            updateStereoSortState(sortedIndices: indexOutputBuffer, context: stereoContext, sortTime: gpuTime ?? elapsed)
+        }
+        os_unfair_lock_lock(&stereoSortLock)
+        sortPublishedSinceLastStereoFrame = true
+        os_unfair_lock_unlock(&stereoSortLock)
+
+        os_unfair_lock_lock(&sortStateLock)
+        lastLODSelectedSplatCount = lodSelectedSplatCount
+        os_unfair_lock_unlock(&sortStateLock)
+
+        recordSortOutcome(path: performanceContext.path,
+                          sortTime: gpuTime ?? elapsed,
+                          residualInversionRatio: residualInversionRatio,
+                          dataRevision: dataDirtySnapshot,
+                          sortByDistance: performanceContext.sortByDistance,
+                          isPerEye: stereoContext?.isPerEye ?? false)
+
         let inFlightSortsAtCompletion = finishSortState(
             duration: elapsed,
             bufferReadyTime: bufferReadyTime,
@@ -3907,12 +5535,24 @@ public class SplatRenderer: @unchecked Sendable {
             gpuTime: gpuTime,
             mainQueueDelay: nil,
             inFlightSortsAtCompletion: inFlightSortsAtCompletion,
-            status: commandBufferStatus
+            status: commandBufferStatus,
+            residualInversionRatio: residualInversionRatio
         )
         Self.log.debug("\(sample.logMessage, privacy: .public)")
+        sortPerformanceObserver?(sample)
+        if let tunerTrial = performanceContext.tunerTrial {
+            sortPathTuner?.record(tunerTrial, sortTime: elapsed, completed: sortCompleted)
+        }
+        if let gpuTime {
+            qualityGovernor?.recordSort(gpuTime: gpuTime)
+        }
 
         if let onSortComplete {
+            let mainQueueHop = frameTimelineRecorder.map { ($0, $0.beginMainQueueHop()) }
             DispatchQueue.main.async {
+                if let (recorder, state) = mainQueueHop {
+                    recorder.endMainQueueHop(state)
+                }
                 onSortComplete(elapsed)
             }
         }
@@ -3969,16 +5609,59 @@ public class SplatRenderer: @unchecked Sendable {
             return
         }
 
-        let cameraWorldForward = sortCameraForward
-        let cameraWorldPosition = sortCameraPosition
+        // Scheduling compares against the sort camera (the eye midpoint in stereo), even when sorting per eye
+        let scheduledCameraForward = sortCameraForward
+        let scheduledCameraPosition = sortCameraPosition
         let sortViewMatrix = currentSortViewMatrix
         let sortStartTime = CFAbsoluteTimeGetCurrent()
 
         // Compute effective sort mode based on camera motion (auto mode tracks rotation vs translation)
         let effectiveSortByDistance = computeEffectiveSortByDistance(
-            cameraPosition: cameraWorldPosition,
-            cameraForward: cameraWorldForward
+            cameraPosition: scheduledCameraPosition,
+            cameraForward: scheduledCameraForward
         )
+
+        // Per-eye stereo sorting: the left eye's order fills the front of the output buffer and the
+        // right eye's is sorted separately and copied in at `viewStride`
+        let stereoEyes = stereoSortEyes
+        let perEyeSortEyes = stereoSortMode == .midpoint && stereoPerEyeSortActive ? stereoEyes : nil
+        let viewStride = perEyeSortEyes != nil ? splatCount : 0
+        let cameraWorldPosition = perEyeSortEyes?.left.position ?? scheduledCameraPosition
+        let cameraWorldForward = perEyeSortEyes?.left.forward ?? scheduledCameraForward
+        let stereoContext = stereoEyes.map {
+            StereoSortContext(left: $0.left,
+                              right: $0.right,
+                              sortCamera: StereoSortEye(position: cameraWorldPosition, forward: cameraWorldForward),
+                              sortByDistance: effectiveSortByDistance,
+                              viewStride: viewStride)
+        }
+
+        // GPU LOD culls the sort input and appends indirect draw arguments after the order
+        let lodSelector = useGPU ? gpuLODSelector(splatCount: splatCount, viewStride: viewStride) : nil
+        let lodCullParams = lodSelector.map { selector in
+            GPULODSelector.LODCullParams(
+                viewProjectionMatrix: (currentFrustumCullProjectionMatrix ?? matrix_identity_float4x4) * (sortViewMatrix ?? matrix_identity_float4x4),
+                cameraPosition: SIMD4(scheduledCameraPosition, lodProjectionScale),
+                maxScreenSpaceError: lodMaxScreenSpaceError * governedSettings.lodScreenSpaceErrorScale,
+                frustumMargin: lodFrustumMargin,
+                nodeCount: UInt32(selector.nodeCount),
+                splatCount: UInt32(splatCount)
+            )
+        }
+        let lodDrawArgumentsOffset: Int? = lodSelector != nil ? splatCount : nil
+        let outputCapacity = splatCount + viewStride + (lodSelector != nil ? GPULODSelector.drawArgumentsLength : 0)
+
+        // Camera-only resorts refine the previous order when it is still valid for this sort
+        let incrementalSeed = useGPU && viewStride == 0 && lodSelector == nil
+            ? incrementalSortSeed(renderableCount: renderableCount,
+                                  dataRevision: dataDirtySnapshot,
+                                  sortByDistance: effectiveSortByDistance)
+            : nil
+        // Full sorts follow the tuner when one is set; GPU LOD sorts need counting sort's culled input
+        let tunerTrial = useGPU && (incrementalSeed == nil || incrementalSorter == nil) && lodSelector == nil
+            ? sortPathTunerTrial(splatCount: splatCount, renderableCount: renderableCount, perEye: perEyeSortEyes != nil)
+            : nil
+        let tunedPath = tunerTrial?.choice.path
         let sortJobsInFlightAtStart = getSortJobsInFlight()
         let interactionModeAtStart = isInteracting
         
@@ -3991,7 +5674,7 @@ public class SplatRenderer: @unchecked Sendable {
 //            return
 //        }
 
-        if useGPU {
+        if useGPU && tunedPath != .cpu {
             Task(priority: .high) { [weak self] in
                 guard let self else {
                     return
@@ -4001,7 +5684,7 @@ public class SplatRenderer: @unchecked Sendable {
                 let releaseIndexOutputBufferOnFailure: Bool
 
                 do {
-                    let outputLease = try self.acquireSortOutputBuffer(minimumCapacity: splatCount)
+                    let outputLease = try self.acquireSortOutputBuffer(minimumCapacity: outputCapacity)
                     indexOutputBuffer = outputLease.buffer
                     releaseIndexOutputBufferOnFailure = outputLease.releaseOnFailure
                     indexOutputBuffer.count = max(renderableCount, 0)
@@ -4011,12 +5694,82 @@ public class SplatRenderer: @unchecked Sendable {
                     return
                 }
 
+                // === INCREMENTAL REFINEMENT PATH (temporally coherent) ===
+                // Refines the previous order for the new camera; the residual decides when the next sort escalates
+                if let previousOrder = incrementalSeed, previousOrder !== indexOutputBuffer, let sorter = self.incrementalSorter {
+                    let performanceContext = SortPerformanceContext(
+                        path: .incremental,
+                        splatCount: splatCount,
+                        renderableCount: renderableCount,
+                        inFlightSortsAtStart: sortJobsInFlightAtStart,
+                        interactionMode: interactionModeAtStart,
+                        sortByDistance: effectiveSortByDistance
+                    )
+                    let sortCommandBufferManager = self.computeCommandBufferManager ?? commandBufferManager
+                    guard let commandBuffer = sortCommandBufferManager.makeCommandBuffer() else {
+                        Self.log.error("Failed to create compute command buffer for incremental sort.")
+                        self.releaseSortOutputBufferOnFailure(indexOutputBuffer, releaseOnFailure: releaseIndexOutputBufferOnFailure)
+                        self.finishSort()
+                        return
+                    }
+
+                    do {
+                        try sorter.refine(
+                            commandBuffer: commandBuffer,
+                            splatBuffer: activeSplatBufferForRendering.buffer,
+                            previousOrder: previousOrder.buffer,
+                            outputBuffer: indexOutputBuffer.buffer,
+                            count: renderableCount,
+                            cameraPosition: cameraWorldPosition,
+                            cameraForward: cameraWorldForward,
+                            sortByDistance: effectiveSortByDistance,
+                            passCount: self.incrementalSortPassCount
+                        )
+                    } catch {
+                        Self.log.error("Incremental sort failed: \(error)")
+                        self.releaseSortOutputBufferOnFailure(indexOutputBuffer, releaseOnFailure: releaseIndexOutputBufferOnFailure)
+                        self.finishSort()
+                        return
+                    }
+
+                    // Capture pool before weak self check to ensure buffer release even if self is deallocated
+                    commandBuffer.addCompletedHandler { [weak self, sortIndexBufferPool] buffer in
+                        guard let self = self else {
+                            if releaseIndexOutputBufferOnFailure {
+                                sortIndexBufferPool.release(indexOutputBuffer)
+                            }
+                            return
+                        }
+                        // A failed refinement has no trustworthy residual; treat it as degraded
+                        let residualInversionRatio = buffer.status == .completed
+                            ? sorter.residualInversionRatio(count: renderableCount)
+                            : nil
+                        self.finishSort(
+                            indexOutputBuffer: indexOutputBuffer,
+                            sortStartTime: sortStartTime,
+                            cameraWorldPosition: scheduledCameraPosition,
+                            cameraWorldForward: scheduledCameraForward,
+                            sortViewMatrix: sortViewMatrix,
+                            dataDirtySnapshot: dataDirtySnapshot,
+                            stereoContext: stereoContext,
+                            performanceContext: performanceContext,
+                            residualInversionRatio: residualInversionRatio,
+                            completionHandlerTime: CFAbsoluteTimeGetCurrent(),
+                            gpuTime: Self.gpuDuration(for: buffer),
+                            sortCompleted: buffer.status == .completed,
+                            commandBufferStatus: Self.statusDescription(for: buffer)
+                        )
+                    }
+                    commandBuffer.commit()
+                    return
+                }
+
                 // === METAL 4 RADIX SORT PATH (for very large scenes) ===
                 // Uses GPU atomics-based radix sort, beneficial for >100K splats
                 if #available(iOS 26.0, macOS 26.0, visionOS 26.0, *) {
-                    if self.useMetal4Sorting,
+                    if tunedPath.map({ $0 == .metal4 }) ?? (self.useMetal4Sorting && splatCount > self.metal4SortingThreshold),
+                       lodSelector == nil,
                        self.hiddenOrDeletedEditStateCount == 0,
-                       splatCount > self.metal4SortingThreshold,
                        let sorter = self.metal4Sorter {
                         let performanceContext = SortPerformanceContext(
                             path: .metal4,
@@ -4024,7 +5777,8 @@ public class SplatRenderer: @unchecked Sendable {
                             renderableCount: renderableCount,
                             inFlightSortsAtStart: sortJobsInFlightAtStart,
                             interactionMode: interactionModeAtStart,
-                            sortByDistance: effectiveSortByDistance
+                            sortByDistance: effectiveSortByDistance,
+                            tunerTrial: tunerTrial
                         )
                         let sortCommandBufferManager = self.computeCommandBufferManager ?? commandBufferManager
                         guard let commandBuffer = sortCommandBufferManager.makeCommandBuffer() else {
@@ -4034,6 +5788,7 @@ public class SplatRenderer: @unchecked Sendable {
                             return
                         }
 
+                        var rightEyeBuffer: MetalBuffer<Int32>?
                         do {
                             try sorter.sort(
                                 splats: activeSplatBufferForRendering.buffer,
@@ -4044,6 +5799,22 @@ public class SplatRenderer: @unchecked Sendable {
                                 outputIndices: indexOutputBuffer.buffer,
                                 commandBuffer: commandBuffer
                             )
+                            if let stereoContext, stereoContext.isPerEye {
+                                rightEyeBuffer = try self.encodeRightEyeSort(into: indexOutputBuffer,
+                                                                             viewStride: viewStride,
+                                                                             count: renderableCount,
+                                                                             commandBuffer: commandBuffer) { output in
+                                    try sorter.sort(
+                                        splats: activeSplatBufferForRendering.buffer,
+                                        count: splatCount,
+                                        cameraPosition: stereoContext.right.position,
+                                        cameraForward: stereoContext.right.forward,
+                                        sortByDistance: effectiveSortByDistance,
+                                        outputIndices: output,
+                                        commandBuffer: commandBuffer
+                                    )
+                                }
+                            }
                         } catch {
                             Self.log.error("Metal 4 radix sort failed: \(error)")
                             self.releaseSortOutputBufferOnFailure(indexOutputBuffer, releaseOnFailure: releaseIndexOutputBufferOnFailure)
@@ -4052,7 +5823,11 @@ public class SplatRenderer: @unchecked Sendable {
                         }
 
                         // Capture pool before weak self check to ensure buffer release even if self is deallocated
+                        let rightEyeLease = rightEyeBuffer
                         commandBuffer.addCompletedHandler { [weak self, sortIndexBufferPool] buffer in
+                            if let rightEyeLease {
+                                sortIndexBufferPool.release(rightEyeLease)
+                            }
                             guard let self = self else {
                                 if releaseIndexOutputBufferOnFailure {
                                     sortIndexBufferPool.release(indexOutputBuffer)
@@ -4062,13 +5837,15 @@ public class SplatRenderer: @unchecked Sendable {
                             self.finishSort(
                                 indexOutputBuffer: indexOutputBuffer,
                                 sortStartTime: sortStartTime,
-                                cameraWorldPosition: cameraWorldPosition,
-                                cameraWorldForward: cameraWorldForward,
+                                cameraWorldPosition: scheduledCameraPosition,
+                                cameraWorldForward: scheduledCameraForward,
                                 sortViewMatrix: sortViewMatrix,
                                 dataDirtySnapshot: dataDirtySnapshot,
+                                stereoContext: stereoContext,
                                 performanceContext: performanceContext,
                                 completionHandlerTime: CFAbsoluteTimeGetCurrent(),
                                 gpuTime: Self.gpuDuration(for: buffer),
+                                sortCompleted: buffer.status == .completed,
                                 commandBufferStatus: Self.statusDescription(for: buffer)
                             )
                         }
@@ -4079,14 +5856,15 @@ public class SplatRenderer: @unchecked Sendable {
 
                 // === O(n) COUNTING SORT PATH ===
                 // Uses histogram-based sorting which is faster than O(n log n) radix sort
-                if self.useCountingSort, let sorter = self.countingSorter {
+                if tunedPath.map({ $0 == .counting }) ?? self.useCountingSort, let sorter = self.countingSorter {
                     let performanceContext = SortPerformanceContext(
                         path: .counting,
                         splatCount: splatCount,
                         renderableCount: renderableCount,
                         inFlightSortsAtStart: sortJobsInFlightAtStart,
                         interactionMode: interactionModeAtStart,
-                        sortByDistance: effectiveSortByDistance
+                        sortByDistance: effectiveSortByDistance,
+                        tunerTrial: tunerTrial
                     )
                     // Use compute queue for sorting to allow overlap with rendering
                     let sortCommandBufferManager = self.computeCommandBufferManager ?? commandBufferManager
@@ -4108,19 +5886,64 @@ public class SplatRenderer: @unchecked Sendable {
                         )
                     }
 
+                    var rightEyeBuffer: MetalBuffer<Int32>?
                     do {
-                            try sorter.sort(
-                                commandBuffer: commandBuffer,
-                                splatBuffer: activeSplatBufferForRendering.buffer,
-                                editStateBuffer: self.visibilityFilteringEditStateBuffer,
-                                outputBuffer: indexOutputBuffer.buffer,
-                                cameraPosition: cameraWorldPosition,
-                                cameraForward: cameraWorldForward,
+                        // GPU LOD replaces the edit states with a mask that also hides culled splats
+                        var sortMaskBuffer = self.visibilityFilteringEditStateBuffer
+                        if let lodSelector, let lodCullParams {
+                            sortMaskBuffer = try lodSelector.encodeSelection(commandBuffer: commandBuffer,
+                                                                             splatBuffer: activeSplatBufferForRendering.buffer,
+                                                                             editStateBuffer: self.visibilityFilteringEditStateBuffer,
+                                                                             params: lodCullParams)
+                        }
+                        try sorter.sort(
+                            commandBuffer: commandBuffer,
+                            splatBuffer: activeSplatBufferForRendering.buffer,
+                            editStateBuffer: sortMaskBuffer,
+                            outputBuffer: indexOutputBuffer.buffer,
+                            cameraPosition: cameraWorldPosition,
+                            cameraForward: cameraWorldForward,
                             sortByDistance: effectiveSortByDistance,
                             splatCount: splatCount,
                             depthBounds: depthBounds,
-                            useCameraRelativeBinning: self.useCameraRelativeBinning
+                            useCameraRelativeBinning: self.useCameraRelativeBinning,
+                            binCount: tunerTrial?.choice.countingBinCount
                         )
+                        if let lodSelector, let lodDrawArgumentsOffset {
+                            try lodSelector.encodeDrawArguments(commandBuffer: commandBuffer,
+                                                                sortedIndices: indexOutputBuffer.buffer,
+                                                                renderableCount: renderableCount,
+                                                                drawArgumentsOffset: lodDrawArgumentsOffset,
+                                                                maxIndexedSplatCount: Constants.maxIndexedSplatCount)
+                        }
+                        if let stereoContext, stereoContext.isPerEye {
+                            let rightEyeDepthBounds = (self.getBounds() ?? self.getBoundsBlocking()).map {
+                                Self.estimateCountingSortDepthBounds(
+                                    from: $0,
+                                    cameraPosition: stereoContext.right.position,
+                                    cameraForward: stereoContext.right.forward,
+                                    sortByDistance: effectiveSortByDistance
+                                )
+                            }
+                            rightEyeBuffer = try self.encodeRightEyeSort(into: indexOutputBuffer,
+                                                                         viewStride: viewStride,
+                                                                         count: renderableCount,
+                                                                         commandBuffer: commandBuffer) { output in
+                                try sorter.sort(
+                                    commandBuffer: commandBuffer,
+                                    splatBuffer: activeSplatBufferForRendering.buffer,
+                                    editStateBuffer: self.visibilityFilteringEditStateBuffer,
+                                    outputBuffer: output,
+                                    cameraPosition: stereoContext.right.position,
+                                    cameraForward: stereoContext.right.forward,
+                                    sortByDistance: effectiveSortByDistance,
+                                    splatCount: splatCount,
+                                    depthBounds: rightEyeDepthBounds,
+                                    useCameraRelativeBinning: self.useCameraRelativeBinning,
+                                    binCount: tunerTrial?.choice.countingBinCount
+                                )
+                            }
+                        }
                     } catch {
                         Self.log.error("Counting sort failed: \(error)")
                         self.releaseSortOutputBufferOnFailure(indexOutputBuffer, releaseOnFailure: releaseIndexOutputBufferOnFailure)
@@ -4131,7 +5954,11 @@ public class SplatRenderer: @unchecked Sendable {
                     // Use completion handler instead of blocking waitUntilCompleted
                     // This allows the Task to return while GPU continues sorting
                     // Capture pool before weak self check to ensure buffer release even if self is deallocated
+                    let rightEyeLease = rightEyeBuffer
                     commandBuffer.addCompletedHandler { [weak self, sortIndexBufferPool] buffer in
+                        if let rightEyeLease {
+                            sortIndexBufferPool.release(rightEyeLease)
+                        }
                         guard let self = self else {
                             if releaseIndexOutputBufferOnFailure {
                                 sortIndexBufferPool.release(indexOutputBuffer)
@@ -4141,13 +5968,17 @@ public class SplatRenderer: @unchecked Sendable {
                         self.finishSort(
                             indexOutputBuffer: indexOutputBuffer,
                             sortStartTime: sortStartTime,
-                            cameraWorldPosition: cameraWorldPosition,
-                            cameraWorldForward: cameraWorldForward,
+                            cameraWorldPosition: scheduledCameraPosition,
+                            cameraWorldForward: scheduledCameraForward,
                             sortViewMatrix: sortViewMatrix,
                             dataDirtySnapshot: dataDirtySnapshot,
+                            stereoContext: stereoContext,
                             performanceContext: performanceContext,
+                            drawArgumentsOffset: lodDrawArgumentsOffset,
+                            lodSelectedSplatCount: lodSelector?.lastSurvivorCount,
                             completionHandlerTime: CFAbsoluteTimeGetCurrent(),
                             gpuTime: Self.gpuDuration(for: buffer),
+                            sortCompleted: buffer.status == .completed,
                             commandBufferStatus: Self.statusDescription(for: buffer)
                         )
                     }
@@ -4163,7 +5994,8 @@ public class SplatRenderer: @unchecked Sendable {
                         renderableCount: renderableCount,
                         inFlightSortsAtStart: sortJobsInFlightAtStart,
                         interactionMode: interactionModeAtStart,
-                        sortByDistance: effectiveSortByDistance
+                        sortByDistance: effectiveSortByDistance,
+                        tunerTrial: tunerTrial
                     )
 
                     let distanceBuffer: MetalBuffer<Float>
@@ -4177,20 +6009,49 @@ public class SplatRenderer: @unchecked Sendable {
                         return
                     }
 
+                    // Per-eye sorting argsorts a second distance buffer into the right eye's order
+                    var rightEyeScratch: (distances: MetalBuffer<Float>, indices: MetalBuffer<Int32>)?
+                    if let stereoContext, stereoContext.isPerEye {
+                        do {
+                            let distances = try sortDistanceBufferPool.acquire(minimumCapacity: splatCount)
+                            distances.count = splatCount
+                            do {
+                                rightEyeScratch = (distances, try sortIndexBufferPool.acquire(minimumCapacity: splatCount))
+                            } catch {
+                                sortDistanceBufferPool.release(distances)
+                                throw error
+                            }
+                        } catch {
+                            Self.log.error("Failed to acquire right eye sort buffers from pool: \(error)")
+                            sortDistanceBufferPool.release(distanceBuffer)
+                            self.releaseSortOutputBufferOnFailure(indexOutputBuffer, releaseOnFailure: releaseIndexOutputBufferOnFailure)
+                            self.finishSort()
+                            return
+                        }
+                    }
+                    let rightEye = rightEyeScratch
+                    let releaseDistanceBuffers: @Sendable () -> Void = { [sortDistanceBufferPool, sortIndexBufferPool] in
+                        sortDistanceBufferPool.release(distanceBuffer)
+                        if let rightEye {
+                            sortDistanceBufferPool.release(rightEye.distances)
+                            sortIndexBufferPool.release(rightEye.indices)
+                        }
+                    }
+
                     // Create command buffer for distance computation using pooled manager
                     guard let commandBuffer = commandBufferManager.makeCommandBuffer() else {
                         Self.log.error("Failed to create compute command buffer.")
-                        sortDistanceBufferPool.release(distanceBuffer)
+                        releaseDistanceBuffers()
                         self.releaseSortOutputBufferOnFailure(indexOutputBuffer, releaseOnFailure: releaseIndexOutputBufferOnFailure)
                         self.finishSort()
                         return
                     }
 
                     // Standard distance computation
-                    guard let computeEncoder = commandBuffer.makeComputeCommandEncoder(),
+                    guard let computeEncoder = commandBuffer.makeComputeCommandEncoder(timing: .sortKeys, with: self.frameTimelineRecorder),
                           let computePipelineState = computeDistancesPipelineState else {
                         Self.log.error("Failed to create compute encoder.")
-                        sortDistanceBufferPool.release(distanceBuffer)
+                        releaseDistanceBuffers()
                         self.releaseSortOutputBufferOnFailure(indexOutputBuffer, releaseOnFailure: releaseIndexOutputBufferOnFailure)
                         self.finishSort()
                         return
@@ -4217,6 +6078,14 @@ public class SplatRenderer: @unchecked Sendable {
                     let threadgroups = MTLSize(width: (splatCount + 255) / 256, height: 1, depth: 1)
 
                     computeEncoder.dispatchThreadgroups(threadgroups, threadsPerThreadgroup: threadsPerThreadgroup)
+                    if let rightEye, let stereoContext {
+                        var rightCameraPos = stereoContext.right.position
+                        var rightCameraFwd = stereoContext.right.forward
+                        computeEncoder.setBuffer(rightEye.distances.buffer, offset: 0, index: 1)
+                        computeEncoder.setBytes(&rightCameraPos, length: MemoryLayout<SIMD3<Float>>.size, index: 3)
+                        computeEncoder.setBytes(&rightCameraFwd, length: MemoryLayout<SIMD3<Float>>.size, index: 4)
+                        computeEncoder.dispatchThreadgroups(threadgroups, threadsPerThreadgroup: threadsPerThreadgroup)
+                    }
                     computeEncoder.endEncoding()
 
                     // === ASYNC COMPUTE OVERLAP ===
@@ -4229,11 +6098,12 @@ public class SplatRenderer: @unchecked Sendable {
                             return
                         }
                         let distanceGPUTime = Self.gpuDuration(for: distanceCommandBuffer)
+                        let distanceCompleted = distanceCommandBuffer.status == .completed
                         let distanceStatus = Self.statusDescription(for: distanceCommandBuffer)
 
                         guard let argSortCommandBuffer = sortQueue.makeCommandBuffer() else {
                             Self.log.error("Failed to create MPS arg sort command buffer.")
-                            self.sortDistanceBufferPool.release(distanceBuffer)
+                            releaseDistanceBuffers()
                             self.releaseSortOutputBufferOnFailure(indexOutputBuffer, releaseOnFailure: releaseIndexOutputBufferOnFailure)
                             self.finishSort()
                             return
@@ -4241,7 +6111,7 @@ public class SplatRenderer: @unchecked Sendable {
                         argSortCommandBuffer.addCompletedHandler { [weak self] buffer in
                             guard let self = self else { return }
 
-                            self.sortDistanceBufferPool.release(distanceBuffer)
+                            releaseDistanceBuffers()
 
                             if buffer.status != .completed {
                                 Self.log.error("MPSArgSort command buffer failed: \(String(describing: buffer.error))")
@@ -4253,13 +6123,15 @@ public class SplatRenderer: @unchecked Sendable {
                             self.finishSort(
                                 indexOutputBuffer: indexOutputBuffer,
                                 sortStartTime: sortStartTime,
-                                cameraWorldPosition: cameraWorldPosition,
-                                cameraWorldForward: cameraWorldForward,
+                                cameraWorldPosition: scheduledCameraPosition,
+                                cameraWorldForward: scheduledCameraForward,
                                 sortViewMatrix: sortViewMatrix,
                                 dataDirtySnapshot: dataDirtySnapshot,
+                                stereoContext: stereoContext,
                                 performanceContext: performanceContext,
                                 completionHandlerTime: CFAbsoluteTimeGetCurrent(),
                                 gpuTime: Self.combinedGPUTime(distanceGPUTime, Self.gpuDuration(for: buffer)),
+                                sortCompleted: distanceCompleted && buffer.status == .completed,
                                 commandBufferStatus: "distance:\(distanceStatus),argsort:\(Self.statusDescription(for: buffer))"
                             )
                         }
@@ -4269,6 +6141,19 @@ public class SplatRenderer: @unchecked Sendable {
                             output: indexOutputBuffer.buffer,
                             count: splatCount
                         )
+                        if let rightEye {
+                            self.cachedMPSArgSort.encode(
+                                commandBuffer: argSortCommandBuffer,
+                                input: rightEye.distances.buffer,
+                                output: rightEye.indices.buffer,
+                                count: splatCount
+                            )
+                            self.encodeRightEyeCopy(from: rightEye.indices,
+                                                    into: indexOutputBuffer,
+                                                    viewStride: viewStride,
+                                                    count: renderableCount,
+                                                    commandBuffer: argSortCommandBuffer)
+                        }
                         argSortCommandBuffer.commit()
                     }
                     commandBuffer.commit()
@@ -4283,59 +6168,72 @@ public class SplatRenderer: @unchecked Sendable {
                     renderableCount: renderableCount,
                     inFlightSortsAtStart: sortJobsInFlightAtStart,
                     interactionMode: interactionModeAtStart,
-                    sortByDistance: effectiveSortByDistance
+                    sortByDistance: effectiveSortByDistance,
+                    tunerTrial: tunerTrial
                 )
                 var actualCount = 0
 
-                // Copy positions under lock to ensure pointer validity during sort
-                // This avoids holding the lock during the slow sort operation
-                activeSplatBufferForRendering.withLockedValues { values, count in
-                    actualCount = count
-                    if orderAndDepthTempSort.count != actualCount {
-                        orderAndDepthTempSort = Array(
-                            repeating: SplatIndexAndDepth(index: .max, depth: 0),
-                            count: actualCount
-                        )
-                    }
-                    guard actualCount > 0 else { return }
-                    if effectiveSortByDistance {
-                        for i in 0..<actualCount {
-                            orderAndDepthTempSort[i].index = UInt32(i)
-                            let splatPos = values[i].position.simd
-                            orderAndDepthTempSort[i].depth = (splatPos - cameraWorldPosition).lengthSquared
+                func sortForCamera(position cameraWorldPosition: SIMD3<Float>, forward cameraWorldForward: SIMD3<Float>) {
+                    // Copy positions under lock to ensure pointer validity during sort
+                    // This avoids holding the lock during the slow sort operation
+                    activeSplatBufferForRendering.withLockedValues { values, count in
+                        actualCount = count
+                        if orderAndDepthTempSort.count != actualCount {
+                            orderAndDepthTempSort = Array(
+                                repeating: SplatIndexAndDepth(index: .max, depth: 0),
+                                count: actualCount
+                            )
                         }
-                    } else {
-                        for i in 0..<actualCount {
-                            orderAndDepthTempSort[i].index = UInt32(i)
-                            let splatPos = values[i].position.simd
-                            orderAndDepthTempSort[i].depth = dot(splatPos - cameraWorldPosition, cameraWorldForward)
+                        guard actualCount > 0 else { return }
+                        if effectiveSortByDistance {
+                            for i in 0..<actualCount {
+                                orderAndDepthTempSort[i].index = UInt32(i)
+                                let splatPos = values[i].position.simd
+                                orderAndDepthTempSort[i].depth = (splatPos - cameraWorldPosition).lengthSquared
+                            }
+                        } else {
+                            for i in 0..<actualCount {
+                                orderAndDepthTempSort[i].index = UInt32(i)
+                                let splatPos = values[i].position.simd
+                                orderAndDepthTempSort[i].depth = dot(splatPos - cameraWorldPosition, cameraWorldForward)
+                            }
                         }
                     }
+
+                    orderAndDepthTempSort.sort { $0.depth > $1.depth }
                 }
 
-                orderAndDepthTempSort.sort { $0.depth > $1.depth }
+                sortForCamera(position: cameraWorldPosition, forward: cameraWorldForward)
 
                 // CPU fallback: populate sortedIndicesBuffer instead of reordering splats
                 // This maintains consistency with GPU path - splat data stays static
                 do {
-                    let cpuSortedIndices = try acquireSortOutputBuffer(minimumCapacity: max(actualCount, 1)).buffer
+                    let cpuSortedIndices = try acquireSortOutputBuffer(minimumCapacity: max(actualCount + viewStride, 1)).buffer
                     cpuSortedIndices.count = actualCount
                     for newIndex in 0..<actualCount {
                         cpuSortedIndices.values[newIndex] = Int32(orderAndDepthTempSort[newIndex].index)
                     }
+                    if let stereoContext, stereoContext.isPerEye {
+                        sortForCamera(position: stereoContext.right.position, forward: stereoContext.right.forward)
+                        for newIndex in 0..<min(actualCount, viewStride) {
+                            cpuSortedIndices.values[viewStride + newIndex] = Int32(orderAndDepthTempSort[newIndex].index)
+                        }
+                    }
 
                     // finishSort publishes scheduling state under sortStateLock, matching
                     // the GPU completion path while keeping external callbacks on main.
                     self.finishSort(
                         indexOutputBuffer: cpuSortedIndices,
                         sortStartTime: sortStartTime,
-                        cameraWorldPosition: cameraWorldPosition,
-                        cameraWorldForward: cameraWorldForward,
+                        cameraWorldPosition: scheduledCameraPosition,
+                        cameraWorldForward: scheduledCameraForward,
                         sortViewMatrix: sortViewMatrix,
                         dataDirtySnapshot: dataDirtySnapshot,
+                        stereoContext: stereoContext,
                         performanceContext: performanceContext,
                         completionHandlerTime: nil,
                         gpuTime: nil,
+                        sortCompleted: true,
                         commandBufferStatus: "completed"
                     )
                 } catch {
@@ -4410,7 +6308,7 @@ private extension SIMD3 where Scalar: BinaryFloatingPoint, Scalar.RawSignificand
     }
 }
 
-private extension SIMD3<Float> {
+extension SIMD3<Float> {
     var sRGBToLinear: SIMD3<Float> {
         SIMD3(x: pow(x, 2.2), y: pow(y, 2.2), z: pow(z, 2.2))
     }
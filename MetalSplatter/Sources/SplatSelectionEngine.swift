@@ -43,16 +43,121 @@ final class SplatSelectionEngine: @unchecked Sendable {
         var padding3: UInt32
     }
 
+    /// Keep in sync with `SelectionCluster` in EditorSelection.metal
+    private struct SelectionCluster {
+        var minimum: SIMD4<Float>
+        var maximum: SIMD4<Float>
+    }
+
+    /// Spatial hash entries share `GPUMortonReorderer.MortonCode`'s layout so they sort with the same key sorter
+    private typealias SpatialHashEntry = GPUMortonReorderer.MortonCode
+
+    /// Keep in sync with `FloodFillParameters` in EditorSelection.metal
+    private struct FloodFillParameters {
+        var splatCount: UInt32
+        var seedIndex: UInt32
+        var threshold: Float
+        var threadgroupWidth: UInt32
+    }
+
+    /// Keep in sync with `FloodFillState` in EditorSelection.metal
+    private struct FloodFillState {
+        var frontierStart: UInt32
+        var frontierEnd: UInt32
+        var cellSize: Float
+        var padding: UInt32
+    }
+
+    /// Keep in sync with `ColorMatchParameters` in EditorSelection.metal
+    private struct ColorMatchParameters {
+        var lower: SIMD3<Float>
+        var upper: SIMD3<Float>
+        var splatCount: UInt32
+    }
+
+    /// Keep in sync with `OutlierParameters` in EditorSelection.metal
+    private struct OutlierParameters {
+        var origin: SIMD3<Float>
+        var splatCount: UInt32
+        var selectionOnly: UInt32
+        var voxelSize: Float
+        var scaleReference: Float
+        var largeSplatPenalty: Float
+        var minimumOpacityWeight: Float
+    }
+
+    /// Keep in sync with `OutlierCandidatePartial` in EditorSelection.metal
+    private struct OutlierCandidatePartial {
+        var minimum: SIMD4<Float>
+        var maximum: SIMD4<Float>
+    }
+
+    /// Keep in sync with `OutlierVoxelCell` in EditorSelection.metal
+    private struct OutlierVoxelCell {
+        var key: UInt32
+        var start: UInt32
+        var count: UInt32
+        var score: Float
+    }
+
+    // Splats per selection cluster; the cluster kernels run one threadgroup of this many threads per cluster
+    private static let clusterSize = 256
+    // Frontier expansions encoded per command buffer before checking whether a flood fill has finished
+    private static let floodFillRoundsPerCommandBuffer = 32
+    // reduceOutlierCandidates reduces 256 threads per threadgroup
+    private static let outlierThreadgroupSize = 256
+    // Outlier voxel keys hold 10 bits per axis
+    private static let maximumOutlierVoxelsPerAxis = 1024
+
     private let device: MTLDevice
     private let commandQueue: MTLCommandQueue?
     private let pipelineState: MTLComputePipelineState?
     private let nearestPointPipelineState: MTLComputePipelineState?
+    private let projectFloodFillPipelineState: MTLComputePipelineState?
+    private let assignFloodFillPipelineState: MTLComputePipelineState?
+    private let advanceFloodFillPipelineState: MTLComputePipelineState?
+    private let expandFloodFillPipelineState: MTLComputePipelineState?
+    private let colorMatchPipelineState: MTLComputePipelineState?
+    private let reduceOutlierPipelineState: MTLComputePipelineState?
+    private let outlierKeysPipelineState: MTLComputePipelineState?
+    private let outlierCellsPipelineState: MTLComputePipelineState?
+    private let buildClustersPipelineState: MTLComputePipelineState?
+    private let cullClustersPipelineState: MTLComputePipelineState?
+    private let prepareClusterDispatchPipelineState: MTLComputePipelineState?
+    private let selectInClustersPipelineState: MTLComputePipelineState?
+    private let nearestInClustersPipelineState: MTLComputePipelineState?
     private let dummyMaskTexture: MTLTexture?
     private var queryBuffer: MTLBuffer?
     private var selectedIndexBuffer: MTLBuffer?
     private var selectedCountBuffer: MTLBuffer?
     private var nearestCandidateBuffer: MTLBuffer?
     private var cachedMaskTextures: [String: MTLTexture] = [:]
+    private var spatialHashEntryBuffer: MTLBuffer?
+    private var floodFillCandidateBuffer: MTLBuffer?
+    private var floodFillVisitedBuffer: MTLBuffer?
+    private var floodFillResultBuffer: MTLBuffer?
+    private var floodFillResultCountBuffer: MTLBuffer?
+    private var floodFillStateBuffer: MTLBuffer?
+    private var floodFillDispatchBuffer: MTLBuffer?
+    private var outlierPartialBuffer: MTLBuffer?
+    private var outlierWeightBuffer: MTLBuffer?
+    private var outlierCellBuffer: MTLBuffer?
+    private var outlierCellCountBuffer: MTLBuffer?
+    private var clusterBuffer: MTLBuffer?
+    private var clusterIndexBuffer: MTLBuffer?
+    private var clusterSurvivorBuffer: MTLBuffer?
+    private var clusterSurvivorCountBuffer: MTLBuffer?
+    private var clusterDispatchBuffer: MTLBuffer?
+    private var clusterCount = 0
+    // Clusters whose bounds must be rebuilt before the next query, and those holding transformed splats
+    private var dirtyClusters = IndexSet()
+    private var transformedClusters = IndexSet()
+    /// The renderer's `selectionClusterInvalidation` generation these clusters reflect
+    private var consumedClusterGeneration: UInt64?
+
+    /// Point, rect, mask, sphere and box queries cull 256-splat clusters by their bounds before testing splats.
+    /// Turning it off, or a device without the cluster kernels, tests every splat.
+    var clusterCullingEnabled = true
 
     init(device: MTLDevice) throws {
         self.device = device
@@ -70,6 +175,24 @@ final class SplatSelectionEngine: @unchecked Sendable {
             self.nearestPointPipelineState = nil
         }
 
+        func makeOptionalPipelineState(_ name: String) throws -> MTLComputePipelineState? {
+            guard let function = library.makeFunction(name: name) else { return nil }
+            return try device.makeComputePipelineState(function: function)
+        }
+        self.projectFloodFillPipelineState = try makeOptionalPipelineState("projectFloodFillCandidates")
+        self.assignFloodFillPipelineState = try makeOptionalPipelineState("assignFloodFillCells")
+        self.advanceFloodFillPipelineState = try makeOptionalPipelineState("advanceFloodFillFrontier")
+        self.expandFloodFillPipelineState = try makeOptionalPipelineState("expandFloodFillFrontier")
+        self.colorMatchPipelineState = try makeOptionalPipelineState("selectColorMatchSplats")
+        self.reduceOutlierPipelineState = try makeOptionalPipelineState("reduceOutlierCandidates")
+        self.outlierKeysPipelineState = try makeOptionalPipelineState("computeOutlierVoxelKeys")
+        self.outlierCellsPipelineState = try makeOptionalPipelineState("buildOutlierVoxelCells")
+        self.buildClustersPipelineState = try makeOptionalPipelineState("buildSelectionClusters")
+        self.cullClustersPipelineState = try makeOptionalPipelineState("cullSelectionClusters")
+        self.prepareClusterDispatchPipelineState = try makeOptionalPipelineState("prepareSelectionClusterDispatch")
+        self.selectInClustersPipelineState = try makeOptionalPipelineState("selectEditableSplatsInClusters")
+        self.nearestInClustersPipelineState = try makeOptionalPipelineState("pickNearestEditableSplatInClusters")
+
         let descriptor = MTLTextureDescriptor.texture2DDescriptor(
             pixelFormat: .r8Unorm,
             width: 1,
@@ -97,7 +220,6 @@ final class SplatSelectionEngine: @unchecked Sendable {
               let selectedCountBuffer,
               let queryBuffer,
               let commandBuffer = commandQueue.makeCommandBuffer(),
-              let encoder = commandBuffer.makeComputeCommandEncoder(),
               let editStateBuffer = renderer.editStateBuffer,
               let editTransformIndexBuffer = renderer.editTransformIndexBuffer,
               let editTransformPaletteBuffer = renderer.editTransformPaletteBuffer else {
@@ -105,35 +227,7 @@ final class SplatSelectionEngine: @unchecked Sendable {
         }
 
         var maskTexture = dummyMaskTexture
-        let projectionMatrix = viewport.projectionMatrix
-        let projectionX = max(abs(projectionMatrix[0][0]), .ulpOfOne)
-        let projectionY = max(abs(projectionMatrix[1][1]), .ulpOfOne)
-        var parameters = QueryParameters(
-            projectionMatrix: projectionMatrix,
-            viewMatrix: viewport.viewMatrix,
-            point: SIMD2<Float>(0, 0),
-            pointRadius: 0,
-            mode: QueryMode.rect.rawValue,
-            splatCount: UInt32(splatCount),
-            rect: SIMD4<Float>(0, 0, 0, 0),
-            sphereCenter: .zero,
-            sphereRadius: 0,
-            boxCenter: .zero,
-            padding0: 0,
-            boxExtents: .zero,
-            padding1: 0,
-            maskSize: .zero,
-            padding2: .zero,
-            screenSize: SIMD2<UInt32>(UInt32(max(viewport.screenSize.x, 1)), UInt32(max(viewport.screenSize.y, 1))),
-            focalX: Float(max(viewport.screenSize.x, 1)) * projectionX * 0.5,
-            focalY: Float(max(viewport.screenSize.y, 1)) * projectionY * 0.5,
-            tanHalfFovX: 1 / projectionX,
-            tanHalfFovY: 1 / projectionY,
-            covarianceBlur: renderer.covarianceBlur,
-            renderMode: renderer.renderMode.rawValue,
-            isOrthographic: viewport.isOrthographic ? 1 : 0,
-            padding3: 0
-        )
+        var parameters = makeQueryParameters(viewport: viewport, renderer: renderer, splatCount: splatCount)
 
         switch query {
         case let .point(normalized, radius):
@@ -166,7 +260,14 @@ final class SplatSelectionEngine: @unchecked Sendable {
         memcpy(queryBuffer.contents(), &parameters, MemoryLayout<QueryParameters>.stride)
         selectedCountBuffer.contents().storeBytes(of: UInt32(0), as: UInt32.self)
 
-        encoder.setComputePipelineState(pipelineState)
+        let rebuiltClusters = try encodeClusterUpdate(renderer: renderer, splatCount: splatCount,
+                                                      commandBuffer: commandBuffer)
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        let clusterCull = try rebuiltClusters.map { _ in try encodeClusterCull(queryBuffer: queryBuffer, on: encoder) }
+
+        encoder.setComputePipelineState(clusterCull == nil ? pipelineState : selectInClustersPipelineState ?? pipelineState)
         encoder.setBuffer(renderer.splatBuffer.buffer, offset: 0, index: 0)
         encoder.setBuffer(editStateBuffer, offset: 0, index: 1)
         encoder.setBuffer(editTransformIndexBuffer, offset: 0, index: 2)
@@ -178,21 +279,22 @@ final class SplatSelectionEngine: @unchecked Sendable {
             encoder.setTexture(maskTexture, index: 0)
         }
 
-        let gridSize = MTLSize(width: splatCount, height: 1, depth: 1)
-        let threadWidth = min(pipelineState.maxTotalThreadsPerThreadgroup, splatCount)
-        let threadgroupSize = MTLSize(width: max(1, threadWidth), height: 1, depth: 1)
-        encoder.dispatchThreads(gridSize, threadsPerThreadgroup: threadgroupSize)
+        if let clusterCull {
+            encoder.setBuffer(clusterCull.survivors, offset: 0, index: 7)
+            encoder.dispatchThreadgroups(indirectBuffer: clusterCull.dispatchArguments,
+                                         indirectBufferOffset: 0,
+                                         threadsPerThreadgroup: MTLSize(width: Self.clusterSize, height: 1, depth: 1))
+        } else {
+            let gridSize = MTLSize(width: splatCount, height: 1, depth: 1)
+            let threadWidth = min(pipelineState.maxTotalThreadsPerThreadgroup, splatCount)
+            let threadgroupSize = MTLSize(width: max(1, threadWidth), height: 1, depth: 1)
+            encoder.dispatchThreads(gridSize, threadsPerThreadgroup: threadgroupSize)
+        }
         encoder.endEncoding()
 
-        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-            commandBuffer.addCompletedHandler { buffer in
-                if let error = buffer.error {
-                    continuation.resume(throwing: error)
-                } else {
-                    continuation.resume(returning: ())
-                }
-            }
-            commandBuffer.commit()
+        try await commit(commandBuffer)
+        if let rebuiltClusters {
+            finishClusterUpdate(rebuiltClusters)
         }
 
         let selectedCount = Int(selectedCountBuffer.contents().load(as: UInt32.self))
@@ -218,70 +320,601 @@ final class SplatSelectionEngine: @unchecked Sendable {
         while threadsPerGroup * 2 <= maxThreads {
             threadsPerGroup *= 2
         }
-        let threadgroupCount = max(1, (splatCount + threadsPerGroup - 1) / threadsPerGroup)
+        let fullThreadgroupCount = max(1, (splatCount + threadsPerGroup - 1) / threadsPerGroup)
+        let clusterCandidateCount = (splatCount + Self.clusterSize - 1) / Self.clusterSize
 
-        try ensureNearestResources(threadgroupCount: threadgroupCount)
+        try ensureNearestResources(threadgroupCount: max(fullThreadgroupCount, clusterCandidateCount))
         try ensureQueryBuffer()
 
         guard let queryBuffer,
               let nearestCandidateBuffer,
               let commandBuffer = commandQueue.makeCommandBuffer(),
-              let encoder = commandBuffer.makeComputeCommandEncoder(),
               let editStateBuffer = renderer.editStateBuffer,
               let editTransformIndexBuffer = renderer.editTransformIndexBuffer,
               let editTransformPaletteBuffer = renderer.editTransformPaletteBuffer else {
             throw SplatEditorError.selectionEngineUnavailable
         }
 
-        let projectionMatrix = viewport.projectionMatrix
-        let projectionX = max(abs(projectionMatrix[0][0]), .ulpOfOne)
-        let projectionY = max(abs(projectionMatrix[1][1]), .ulpOfOne)
-        var parameters = QueryParameters(
-            projectionMatrix: projectionMatrix,
-            viewMatrix: viewport.viewMatrix,
-            point: normalized,
-            pointRadius: radius,
-            mode: QueryMode.point.rawValue,
-            splatCount: UInt32(splatCount),
-            rect: SIMD4<Float>(0, 0, 0, 0),
-            sphereCenter: .zero,
-            sphereRadius: 0,
-            boxCenter: .zero,
-            padding0: 0,
-            boxExtents: .zero,
-            padding1: 0,
-            maskSize: .zero,
-            padding2: .zero,
-            screenSize: SIMD2<UInt32>(UInt32(max(viewport.screenSize.x, 1)), UInt32(max(viewport.screenSize.y, 1))),
-            focalX: Float(max(viewport.screenSize.x, 1)) * projectionX * 0.5,
-            focalY: Float(max(viewport.screenSize.y, 1)) * projectionY * 0.5,
-            tanHalfFovX: 1 / projectionX,
-            tanHalfFovY: 1 / projectionY,
-            covarianceBlur: renderer.covarianceBlur,
-            renderMode: renderer.renderMode.rawValue,
-            isOrthographic: viewport.isOrthographic ? 1 : 0,
-            padding3: 0
-        )
+        var parameters = makeQueryParameters(viewport: viewport, renderer: renderer, splatCount: splatCount)
+        parameters.mode = QueryMode.point.rawValue
+        parameters.point = normalized
+        parameters.pointRadius = radius
         memcpy(queryBuffer.contents(), &parameters, MemoryLayout<QueryParameters>.stride)
 
+        let rebuiltClusters = try encodeClusterUpdate(renderer: renderer, splatCount: splatCount,
+                                                      commandBuffer: commandBuffer)
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        let clusterCull = try rebuiltClusters.map { _ in try encodeClusterCull(queryBuffer: queryBuffer, on: encoder) }
+
+        let threadgroupCount = clusterCull == nil ? fullThreadgroupCount : clusterCandidateCount
         let candidates = nearestCandidateBuffer.contents().bindMemory(to: NearestSelectionCandidate.self, capacity: threadgroupCount)
         for index in 0..<threadgroupCount {
             candidates[index] = NearestSelectionCandidate(index: -1, distanceSquared: .greatestFiniteMagnitude)
         }
 
-        encoder.setComputePipelineState(nearestPointPipelineState)
+        encoder.setComputePipelineState(clusterCull == nil
+                                        ? nearestPointPipelineState
+                                        : nearestInClustersPipelineState ?? nearestPointPipelineState)
         encoder.setBuffer(renderer.splatBuffer.buffer, offset: 0, index: 0)
         encoder.setBuffer(editStateBuffer, offset: 0, index: 1)
         encoder.setBuffer(editTransformIndexBuffer, offset: 0, index: 2)
         encoder.setBuffer(editTransformPaletteBuffer, offset: 0, index: 3)
         encoder.setBuffer(nearestCandidateBuffer, offset: 0, index: 4)
         encoder.setBuffer(queryBuffer, offset: 0, index: 5)
-        encoder.dispatchThreadgroups(
-            MTLSize(width: threadgroupCount, height: 1, depth: 1),
-            threadsPerThreadgroup: MTLSize(width: threadsPerGroup, height: 1, depth: 1)
-        )
+        if let clusterCull {
+            encoder.setBuffer(clusterCull.survivors, offset: 0, index: 6)
+            encoder.dispatchThreadgroups(indirectBuffer: clusterCull.dispatchArguments,
+                                         indirectBufferOffset: 0,
+                                         threadsPerThreadgroup: MTLSize(width: Self.clusterSize, height: 1, depth: 1))
+        } else {
+            encoder.dispatchThreadgroups(
+                MTLSize(width: threadgroupCount, height: 1, depth: 1),
+                threadsPerThreadgroup: MTLSize(width: threadsPerGroup, height: 1, depth: 1)
+            )
+        }
+        encoder.endEncoding()
+
+        try await commit(commandBuffer)
+        if let rebuiltClusters {
+            finishClusterUpdate(rebuiltClusters)
+        }
+
+        // Surviving clusters report in any order, so ties go to the lower splat index
+        let candidateCount = clusterCull.map { Int($0.survivorCount.contents().load(as: UInt32.self)) } ?? threadgroupCount
+        var bestCandidate = NearestSelectionCandidate(index: -1, distanceSquared: .greatestFiniteMagnitude)
+        for index in 0..<min(candidateCount, threadgroupCount) {
+            let candidate = candidates[index]
+            guard candidate.index >= 0 else { continue }
+            if candidate.distanceSquared < bestCandidate.distanceSquared ||
+                (candidate.distanceSquared == bestCandidate.distanceSquared && candidate.index < bestCandidate.index) {
+                bestCandidate = candidate
+            }
+        }
+
+        return bestCandidate.index >= 0 ? Int(bestCandidate.index) : nil
+    }
+
+    // MARK: - Selection Clusters
+
+    /// Rebuilds the bounds of clusters invalidated since the last query, in their own encoder at the start of
+    /// `commandBuffer`. Call `finishClusterUpdate` with the result once the command buffer completes.
+    /// - Returns: The clusters rebuilt, or nil when cluster culling is off or unavailable
+    private func encodeClusterUpdate(renderer: SplatRenderer,
+                                     splatCount: Int,
+                                     commandBuffer: MTLCommandBuffer) throws -> IndexSet? {
+        guard clusterCullingEnabled,
+              let buildClustersPipelineState,
+              cullClustersPipelineState != nil,
+              prepareClusterDispatchPipelineState != nil,
+              let selectInClustersPipelineState,
+              let nearestInClustersPipelineState,
+              buildClustersPipelineState.maxTotalThreadsPerThreadgroup >= Self.clusterSize,
+              selectInClustersPipelineState.maxTotalThreadsPerThreadgroup >= Self.clusterSize,
+              nearestInClustersPipelineState.maxTotalThreadsPerThreadgroup >= Self.clusterSize,
+              let editTransformIndexBuffer = renderer.editTransformIndexBuffer,
+              let editTransformPaletteBuffer = renderer.editTransformPaletteBuffer else {
+            return nil
+        }
+
+        let count = (splatCount + Self.clusterSize - 1) / Self.clusterSize
+        let previousClusterBuffer = clusterBuffer
+        let clusters = try spatialBuffer(&clusterBuffer, length: count * MemoryLayout<SelectionCluster>.stride,
+                                         options: .storageModeShared, label: "Selection Clusters")
+        let (invalidation, generation) = renderer.selectionClusterInvalidation.changes(since: consumedClusterGeneration)
+        consumedClusterGeneration = generation
+        if invalidation.all || count != clusterCount || clusters !== previousClusterBuffer {
+            dirtyClusters = IndexSet(integersIn: 0..<count)
+            transformedClusters = IndexSet()
+        } else {
+            for range in invalidation.splatIndices.rangeView {
+                let first = range.lowerBound / Self.clusterSize
+                let last = min((range.upperBound - 1) / Self.clusterSize, count - 1)
+                if first <= last {
+                    dirtyClusters.insert(integersIn: first...last)
+                }
+            }
+            if invalidation.transformPalette {
+                dirtyClusters.formUnion(transformedClusters)
+            }
+        }
+        clusterCount = count
+
+        let rebuilt = dirtyClusters
+        guard !rebuilt.isEmpty else { return rebuilt }
+
+        let indexBuffer = try spatialBuffer(&clusterIndexBuffer, length: rebuilt.count * MemoryLayout<UInt32>.stride,
+                                            options: .storageModeShared, label: "Selection Cluster Rebuild List")
+        let indices = indexBuffer.contents().bindMemory(to: UInt32.self, capacity: rebuilt.count)
+        for (slot, cluster) in rebuilt.enumerated() {
+            indices[slot] = UInt32(cluster)
+        }
+
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        encoder.label = "Selection Cluster Bounds"
+        var clusteredSplatCount = UInt32(splatCount)
+        encoder.setComputePipelineState(buildClustersPipelineState)
+        encoder.setBuffer(renderer.splatBuffer.buffer, offset: 0, index: 0)
+        encoder.setBuffer(editTransformIndexBuffer, offset: 0, index: 1)
+        encoder.setBuffer(editTransformPaletteBuffer, offset: 0, index: 2)
+        encoder.setBuffer(clusters, offset: 0, index: 3)
+        encoder.setBuffer(indexBuffer, offset: 0, index: 4)
+        encoder.setBytes(&clusteredSplatCount, length: MemoryLayout<UInt32>.stride, index: 5)
+        encoder.dispatchThreadgroups(MTLSize(width: rebuilt.count, height: 1, depth: 1),
+                                     threadsPerThreadgroup: MTLSize(width: Self.clusterSize, height: 1, depth: 1))
         encoder.endEncoding()
+        return rebuilt
+    }
+
+    /// Records which rebuilt clusters hold transformed splats; those are rebuilt whenever the transform palette changes
+    private func finishClusterUpdate(_ rebuilt: IndexSet) {
+        guard let clusterBuffer, !rebuilt.isEmpty else { return }
+        let clusters = clusterBuffer.contents().bindMemory(to: SelectionCluster.self, capacity: clusterCount)
+        for cluster in rebuilt where cluster < clusterCount {
+            if clusters[cluster].minimum.w > 0 {
+                transformedClusters.insert(cluster)
+            } else {
+                transformedClusters.remove(cluster)
+            }
+        }
+        dirtyClusters.subtract(rebuilt)
+    }
+
+    /// Culls the clusters against the query in `queryBuffer` and prepares an indirect dispatch of one threadgroup per
+    /// surviving cluster. The caller sets its refine pipeline and dispatches with `dispatchArguments`.
+    private func encodeClusterCull(queryBuffer: MTLBuffer,
+                                   on encoder: MTLComputeCommandEncoder) throws
+    -> (survivors: MTLBuffer, survivorCount: MTLBuffer, dispatchArguments: MTLBuffer) {
+        guard let clusterBuffer,
+              let cullClustersPipelineState,
+              let prepareClusterDispatchPipelineState else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        let survivors = try spatialBuffer(&clusterSurvivorBuffer, length: clusterCount * MemoryLayout<UInt32>.stride,
+                                          options: .storageModePrivate, label: "Selection Cluster Survivors")
+        let survivorCount = try spatialBuffer(&clusterSurvivorCountBuffer, length: MemoryLayout<UInt32>.stride,
+                                              options: .storageModeShared, label: "Selection Cluster Survivor Count")
+        let dispatchArguments = try spatialBuffer(&clusterDispatchBuffer,
+                                                  length: MemoryLayout<MTLDispatchThreadgroupsIndirectArguments>.stride,
+                                                  options: .storageModePrivate,
+                                                  label: "Selection Cluster Dispatch Arguments")
+        survivorCount.contents().storeBytes(of: UInt32(0), as: UInt32.self)
+
+        var count = UInt32(clusterCount)
+        encoder.setComputePipelineState(cullClustersPipelineState)
+        encoder.setBuffer(clusterBuffer, offset: 0, index: 0)
+        encoder.setBuffer(queryBuffer, offset: 0, index: 1)
+        encoder.setBuffer(survivors, offset: 0, index: 2)
+        encoder.setBuffer(survivorCount, offset: 0, index: 3)
+        encoder.setBytes(&count, length: MemoryLayout<UInt32>.stride, index: 4)
+        dispatch(cullClustersPipelineState, count: clusterCount, on: encoder)
+
+        encoder.setComputePipelineState(prepareClusterDispatchPipelineState)
+        encoder.setBuffer(survivorCount, offset: 0, index: 0)
+        encoder.setBuffer(dispatchArguments, offset: 0, index: 1)
+        encoder.dispatchThreads(MTLSize(width: 1, height: 1, depth: 1),
+                                threadsPerThreadgroup: MTLSize(width: 1, height: 1, depth: 1))
+        return (survivors, survivorCount, dispatchArguments)
+    }
+
+    // MARK: - Spatial Hash Selection
+
+    /// Grows a region from `seedIndex` through splats whose projected footprints touch and whose opacities are within
+    /// `threshold` of each other. Splats are bucketed into a sorted screen-space hash sized from the seed's footprint,
+    /// and each breadth-first step is one indirect dispatch over the previous step's discoveries.
+    /// - Returns: The region in discovery order, or nil when the kernels are unavailable
+    func floodFill(seedIndex: Int,
+                   threshold: Float,
+                   viewport: SplatRenderer.ViewportDescriptor,
+                   renderer: SplatRenderer) async throws -> [Int]? {
+        guard let projectFloodFillPipelineState,
+              let assignFloodFillPipelineState,
+              let advanceFloodFillPipelineState,
+              let expandFloodFillPipelineState else {
+            return nil
+        }
+
+        let splatCount = renderer.splatCount
+        guard seedIndex >= 0, seedIndex < splatCount else { return [] }
+
+        try ensureQueryBuffer()
+        let indexLength = splatCount * MemoryLayout<UInt32>.stride
+        let candidates = try spatialBuffer(&floodFillCandidateBuffer,
+                                           length: splatCount * MemoryLayout<SIMD4<Float>>.stride,
+                                           options: .storageModePrivate,
+                                           label: "Flood Fill Candidates")
+        let entries = try spatialBuffer(&spatialHashEntryBuffer,
+                                        length: splatCount * MemoryLayout<SpatialHashEntry>.stride,
+                                        options: .storageModeShared,
+                                        label: "Spatial Hash Entries")
+        let visited = try spatialBuffer(&floodFillVisitedBuffer, length: indexLength,
+                                        options: .storageModePrivate, label: "Flood Fill Visited")
+        let result = try spatialBuffer(&floodFillResultBuffer, length: indexLength,
+                                       options: .storageModeShared, label: "Flood Fill Result")
+        let resultCount = try spatialBuffer(&floodFillResultCountBuffer, length: MemoryLayout<UInt32>.stride,
+                                            options: .storageModeShared, label: "Flood Fill Result Count")
+        let state = try spatialBuffer(&floodFillStateBuffer, length: MemoryLayout<FloodFillState>.stride,
+                                      options: .storageModeShared, label: "Flood Fill State")
+        let dispatchArguments = try spatialBuffer(&floodFillDispatchBuffer,
+                                                  length: MemoryLayout<MTLDispatchThreadgroupsIndirectArguments>.stride,
+                                                  options: .storageModePrivate,
+                                                  label: "Flood Fill Dispatch Arguments")
+
+        let queue = renderer.sortCommandQueue
+        guard let queryBuffer,
+              var commandBuffer = queue.makeCommandBuffer(),
+              let editStateBuffer = renderer.editStateBuffer,
+              let editTransformIndexBuffer = renderer.editTransformIndexBuffer,
+              let editTransformPaletteBuffer = renderer.editTransformPaletteBuffer else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        commandBuffer.label = "Flood Fill Selection"
+
+        var parameters = makeQueryParameters(viewport: viewport, renderer: renderer, splatCount: splatCount)
+        memcpy(queryBuffer.contents(), &parameters, MemoryLayout<QueryParameters>.stride)
+        let threadgroupWidth = min(expandFloodFillPipelineState.maxTotalThreadsPerThreadgroup, 256)
+        var floodParameters = FloodFillParameters(splatCount: UInt32(splatCount),
+                                                  seedIndex: UInt32(seedIndex),
+                                                  threshold: max(0.001, min(threshold, 1)),
+                                                  threadgroupWidth: UInt32(threadgroupWidth))
+        let floodParametersLength = MemoryLayout<FloodFillParameters>.stride
+
+        guard let blit = commandBuffer.makeBlitCommandEncoder() else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        blit.fill(buffer: visited, range: 0..<indexLength, value: 0)
+        blit.fill(buffer: resultCount, range: 0..<MemoryLayout<UInt32>.stride, value: 0)
+        blit.endEncoding()
 
+        guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        encoder.setComputePipelineState(projectFloodFillPipelineState)
+        encoder.setBuffer(renderer.splatBuffer.buffer, offset: 0, index: 0)
+        encoder.setBuffer(editStateBuffer, offset: 0, index: 1)
+        encoder.setBuffer(editTransformIndexBuffer, offset: 0, index: 2)
+        encoder.setBuffer(editTransformPaletteBuffer, offset: 0, index: 3)
+        encoder.setBuffer(candidates, offset: 0, index: 4)
+        encoder.setBuffer(queryBuffer, offset: 0, index: 5)
+        encoder.setBytes(&floodParameters, length: floodParametersLength, index: 6)
+        dispatch(projectFloodFillPipelineState, count: splatCount, on: encoder)
+
+        encoder.setComputePipelineState(assignFloodFillPipelineState)
+        encoder.setBuffer(candidates, offset: 0, index: 0)
+        encoder.setBuffer(entries, offset: 0, index: 1)
+        encoder.setBuffer(state, offset: 0, index: 2)
+        encoder.setBuffer(visited, offset: 0, index: 3)
+        encoder.setBuffer(result, offset: 0, index: 4)
+        encoder.setBuffer(resultCount, offset: 0, index: 5)
+        encoder.setBytes(&floodParameters, length: floodParametersLength, index: 6)
+        dispatch(assignFloodFillPipelineState, count: splatCount, on: encoder)
+        encoder.endEncoding()
+
+        commandBuffer = try await sortSpatialHash(entries, count: splatCount, commandBuffer: commandBuffer, renderer: renderer)
+
+        while true {
+            guard let encoder = commandBuffer.makeComputeCommandEncoder() else {
+                throw SplatEditorError.selectionEngineUnavailable
+            }
+            for _ in 0..<Self.floodFillRoundsPerCommandBuffer {
+                encoder.setComputePipelineState(advanceFloodFillPipelineState)
+                encoder.setBuffer(state, offset: 0, index: 0)
+                encoder.setBuffer(resultCount, offset: 0, index: 1)
+                encoder.setBuffer(dispatchArguments, offset: 0, index: 2)
+                encoder.setBytes(&floodParameters, length: floodParametersLength, index: 3)
+                encoder.dispatchThreads(MTLSize(width: 1, height: 1, depth: 1),
+                                        threadsPerThreadgroup: MTLSize(width: 1, height: 1, depth: 1))
+
+                encoder.setComputePipelineState(expandFloodFillPipelineState)
+                encoder.setBuffer(entries, offset: 0, index: 0)
+                encoder.setBuffer(candidates, offset: 0, index: 1)
+                encoder.setBuffer(visited, offset: 0, index: 2)
+                encoder.setBuffer(result, offset: 0, index: 3)
+                encoder.setBuffer(resultCount, offset: 0, index: 4)
+                encoder.setBuffer(state, offset: 0, index: 5)
+                encoder.setBytes(&floodParameters, length: floodParametersLength, index: 6)
+                encoder.dispatchThreadgroups(indirectBuffer: dispatchArguments,
+                                             indirectBufferOffset: 0,
+                                             threadsPerThreadgroup: MTLSize(width: threadgroupWidth, height: 1, depth: 1))
+            }
+            encoder.endEncoding()
+            try await commit(commandBuffer)
+
+            // Finished once the last expansion found nothing past the frontier it expanded
+            let found = resultCount.contents().load(as: UInt32.self)
+            if found == state.contents().load(as: FloodFillState.self).frontierEnd {
+                break
+            }
+            guard let next = queue.makeCommandBuffer() else {
+                throw SplatEditorError.selectionEngineUnavailable
+            }
+            next.label = "Flood Fill Selection"
+            commandBuffer = next
+        }
+
+        let count = Int(resultCount.contents().load(as: UInt32.self))
+        let indices = result.contents().bindMemory(to: UInt32.self, capacity: max(count, 1))
+        return (0..<count).map { Int(indices[$0]) }
+    }
+
+    /// Stored-color bounds holding every color within `threshold` of `reference` per channel. `Splat` packs
+    /// `pow(color, 2.2)` to unorm8, which is monotonic for nonnegative colors, so the linear bounds map through it
+    /// exactly; half a step of rounding either way, plus slack for the kernel unpacking to half, keeps the test
+    /// conservative.
+    static func storedColorMatchBounds(reference: SIMD3<Float>,
+                                       threshold: Float) -> (lower: SIMD3<Float>, upper: SIMD3<Float>) {
+        let threshold = max(0, min(threshold, 1))
+        let slack = SIMD3<Float>(repeating: 0.5 / 255 + 1e-3)
+        let lower = simd_max(reference - threshold, SIMD3<Float>(repeating: 0)).sRGBToLinear
+        let upper = simd_max(reference + threshold, SIMD3<Float>(repeating: 0)).sRGBToLinear
+        return (lower - slack, upper + slack)
+    }
+
+    /// Selectable splats whose color may be within `threshold` of `reference` on every channel, or nil when the
+    /// kernel is unavailable. Splats store 8-bit gamma-expanded colors, so the kernel tests them against the
+    /// threshold's bounds mapped into that space and widened by a quantization step: every splat that matches in
+    /// linear float is returned, plus possibly a few within one step of the bounds. Callers holding the float colors
+    /// refine the result with the exact test.
+    func colorMatch(reference: SIMD3<Float>,
+                    threshold: Float,
+                    renderer: SplatRenderer) async throws -> [Int]? {
+        guard let commandQueue, let colorMatchPipelineState else { return nil }
+
+        let splatCount = renderer.splatCount
+        guard splatCount > 0 else { return [] }
+
+        try ensureSelectionResources(splatCount: splatCount)
+
+        guard let outputBuffer = selectedIndexBuffer,
+              let selectedCountBuffer,
+              let commandBuffer = commandQueue.makeCommandBuffer(),
+              let encoder = commandBuffer.makeComputeCommandEncoder(),
+              let editStateBuffer = renderer.editStateBuffer else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+
+        let bounds = Self.storedColorMatchBounds(reference: reference, threshold: threshold)
+        var parameters = ColorMatchParameters(lower: bounds.lower,
+                                              upper: bounds.upper,
+                                              splatCount: UInt32(splatCount))
+        selectedCountBuffer.contents().storeBytes(of: UInt32(0), as: UInt32.self)
+
+        encoder.setComputePipelineState(colorMatchPipelineState)
+        encoder.setBuffer(renderer.splatBuffer.buffer, offset: 0, index: 0)
+        encoder.setBuffer(editStateBuffer, offset: 0, index: 1)
+        encoder.setBuffer(outputBuffer, offset: 0, index: 2)
+        encoder.setBuffer(selectedCountBuffer, offset: 0, index: 3)
+        encoder.setBytes(&parameters, length: MemoryLayout<ColorMatchParameters>.stride, index: 4)
+        dispatch(colorMatchPipelineState, count: splatCount, on: encoder)
+        encoder.endEncoding()
+
+        try await commit(commandBuffer)
+
+        let selectedCount = Int(selectedCountBuffer.contents().load(as: UInt32.self))
+        guard selectedCount > 0 else { return [] }
+
+        let indices = outputBuffer.contents().bindMemory(to: UInt32.self, capacity: max(selectedCount, 1))
+        return (0..<selectedCount).map { Int(indices[$0]) }
+    }
+
+    /// Scores the outlier candidates' occupied voxels on the GPU: one reduction for bounds and mean scale, then a
+    /// sorted voxel hash whose cells carry their summed density weights.
+    /// - Returns: The occupied voxels, or nil when the kernels are unavailable or the grid needs more than 1024
+    ///   voxels on an axis
+    func outlierVoxels(config: OutlierSelectionConfig,
+                       selectionOnly: Bool,
+                       renderer: SplatRenderer) async throws -> OutlierVoxelGrid? {
+        guard let reduceOutlierPipelineState,
+              let outlierKeysPipelineState,
+              let outlierCellsPipelineState,
+              reduceOutlierPipelineState.maxTotalThreadsPerThreadgroup >= Self.outlierThreadgroupSize else {
+            return nil
+        }
+
+        let splatCount = renderer.splatCount
+        guard splatCount > 1 else { return OutlierVoxelGrid(cells: [], sortedIndices: []) }
+
+        let queue = renderer.sortCommandQueue
+        let threadgroupCount = (splatCount + Self.outlierThreadgroupSize - 1) / Self.outlierThreadgroupSize
+        let partials = try spatialBuffer(&outlierPartialBuffer,
+                                         length: threadgroupCount * MemoryLayout<OutlierCandidatePartial>.stride,
+                                         options: .storageModeShared,
+                                         label: "Outlier Candidate Partials")
+        guard let reduceCommandBuffer = queue.makeCommandBuffer(),
+              let encoder = reduceCommandBuffer.makeComputeCommandEncoder(),
+              let editStateBuffer = renderer.editStateBuffer,
+              let editTransformIndexBuffer = renderer.editTransformIndexBuffer,
+              let editTransformPaletteBuffer = renderer.editTransformPaletteBuffer else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        reduceCommandBuffer.label = "Outlier Selection Bounds"
+
+        var parameters = OutlierParameters(origin: .zero,
+                                           splatCount: UInt32(splatCount),
+                                           selectionOnly: selectionOnly ? 1 : 0,
+                                           voxelSize: 1,
+                                           scaleReference: 1,
+                                           largeSplatPenalty: max(config.largeSplatPenalty, 0),
+                                           minimumOpacityWeight: max(config.minimumOpacityWeight, 0))
+        encoder.setComputePipelineState(reduceOutlierPipelineState)
+        encoder.setBuffer(renderer.splatBuffer.buffer, offset: 0, index: 0)
+        encoder.setBuffer(editStateBuffer, offset: 0, index: 1)
+        encoder.setBuffer(editTransformIndexBuffer, offset: 0, index: 2)
+        encoder.setBuffer(editTransformPaletteBuffer, offset: 0, index: 3)
+        encoder.setBuffer(partials, offset: 0, index: 4)
+        encoder.setBytes(&parameters, length: MemoryLayout<OutlierParameters>.stride, index: 5)
+        encoder.dispatchThreadgroups(MTLSize(width: threadgroupCount, height: 1, depth: 1),
+                                     threadsPerThreadgroup: MTLSize(width: Self.outlierThreadgroupSize, height: 1, depth: 1))
+        encoder.endEncoding()
+        try await commit(reduceCommandBuffer)
+
+        var minimum = SIMD3<Float>(repeating: .greatestFiniteMagnitude)
+        var maximum = SIMD3<Float>(repeating: -.greatestFiniteMagnitude)
+        var scaleSum: Float = 0
+        var candidateCount = 0
+        let partialValues = partials.contents().bindMemory(to: OutlierCandidatePartial.self, capacity: threadgroupCount)
+        for index in 0..<threadgroupCount {
+            let partial = partialValues[index]
+            let count = Int(partial.maximum.w)
+            guard count > 0 else { continue }
+            minimum = simd_min(minimum, SIMD3(partial.minimum.x, partial.minimum.y, partial.minimum.z))
+            maximum = simd_max(maximum, SIMD3(partial.maximum.x, partial.maximum.y, partial.maximum.z))
+            scaleSum += partial.minimum.w
+            candidateCount += count
+        }
+        guard candidateCount > 1 else { return OutlierVoxelGrid(cells: [], sortedIndices: []) }
+
+        let averageScale = max(scaleSum / Float(candidateCount), 0.0001)
+        let voxelSize = config.voxelSize(diagonal: simd_length(maximum - minimum), averageScale: averageScale)
+        let voxelsPerAxis = simd_reduce_max(floor((maximum - minimum) / voxelSize)) + 1
+        guard voxelsPerAxis <= Float(Self.maximumOutlierVoxelsPerAxis) else { return nil }
+        parameters.origin = minimum
+        parameters.voxelSize = voxelSize
+        parameters.scaleReference = max(averageScale, 0.0001)
+
+        let entries = try spatialBuffer(&spatialHashEntryBuffer,
+                                        length: splatCount * MemoryLayout<SpatialHashEntry>.stride,
+                                        options: .storageModeShared,
+                                        label: "Spatial Hash Entries")
+        let weights = try spatialBuffer(&outlierWeightBuffer, length: splatCount * MemoryLayout<Float>.stride,
+                                        options: .storageModePrivate, label: "Outlier Weights")
+        let cells = try spatialBuffer(&outlierCellBuffer, length: candidateCount * MemoryLayout<OutlierVoxelCell>.stride,
+                                      options: .storageModeShared, label: "Outlier Voxel Cells")
+        let cellCount = try spatialBuffer(&outlierCellCountBuffer, length: MemoryLayout<UInt32>.stride,
+                                          options: .storageModeShared, label: "Outlier Voxel Cell Count")
+        cellCount.contents().storeBytes(of: UInt32(0), as: UInt32.self)
+
+        guard var commandBuffer = queue.makeCommandBuffer(),
+              let keyEncoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        commandBuffer.label = "Outlier Selection Voxels"
+        keyEncoder.setComputePipelineState(outlierKeysPipelineState)
+        keyEncoder.setBuffer(renderer.splatBuffer.buffer, offset: 0, index: 0)
+        keyEncoder.setBuffer(editStateBuffer, offset: 0, index: 1)
+        keyEncoder.setBuffer(editTransformIndexBuffer, offset: 0, index: 2)
+        keyEncoder.setBuffer(editTransformPaletteBuffer, offset: 0, index: 3)
+        keyEncoder.setBuffer(entries, offset: 0, index: 4)
+        keyEncoder.setBuffer(weights, offset: 0, index: 5)
+        keyEncoder.setBytes(&parameters, length: MemoryLayout<OutlierParameters>.stride, index: 6)
+        dispatch(outlierKeysPipelineState, count: splatCount, on: keyEncoder)
+        keyEncoder.endEncoding()
+
+        commandBuffer = try await sortSpatialHash(entries, count: splatCount, commandBuffer: commandBuffer, renderer: renderer)
+
+        guard let cellEncoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        // Candidates sort ahead of the empty keys, so the first `candidateCount` entries are the whole hash
+        var entryCount = UInt32(candidateCount)
+        cellEncoder.setComputePipelineState(outlierCellsPipelineState)
+        cellEncoder.setBuffer(entries, offset: 0, index: 0)
+        cellEncoder.setBuffer(weights, offset: 0, index: 1)
+        cellEncoder.setBuffer(cells, offset: 0, index: 2)
+        cellEncoder.setBuffer(cellCount, offset: 0, index: 3)
+        cellEncoder.setBytes(&entryCount, length: MemoryLayout<UInt32>.stride, index: 4)
+        dispatch(outlierCellsPipelineState, count: candidateCount, on: cellEncoder)
+        cellEncoder.endEncoding()
+        try await commit(commandBuffer)
+
+        let occupiedCount = Int(cellCount.contents().load(as: UInt32.self))
+        let cellValues = cells.contents().bindMemory(to: OutlierVoxelCell.self, capacity: max(occupiedCount, 1))
+        let gridCells = (0..<occupiedCount).map { index in
+            let cell = cellValues[index]
+            return OutlierVoxelGrid.Cell(
+                coordinate: SIMD3<Int32>(Self.compactMortonBits(cell.key),
+                                         Self.compactMortonBits(cell.key >> 1),
+                                         Self.compactMortonBits(cell.key >> 2)),
+                score: cell.score,
+                entries: Int(cell.start)..<Int(cell.start + cell.count)
+            )
+        }
+        let sortedEntries = entries.contents().bindMemory(to: SpatialHashEntry.self, capacity: splatCount)
+        let sortedIndices = (0..<candidateCount).map { sortedEntries[$0].originalIndex }
+        return OutlierVoxelGrid(cells: gridCells, sortedIndices: sortedIndices)
+    }
+
+    /// Sorts `count` entries by key inside `commandBuffer` when the renderer has a GPU key sorter. Otherwise runs
+    /// `commandBuffer`, sorts on the CPU and returns a new command buffer for the remaining work.
+    private func sortSpatialHash(_ entries: MTLBuffer,
+                                 count: Int,
+                                 commandBuffer: MTLCommandBuffer,
+                                 renderer: SplatRenderer) async throws -> MTLCommandBuffer {
+        if let keySorter = renderer.gpuKeySorter {
+            let length = count * MemoryLayout<SpatialHashEntry>.stride
+            guard let scratch = renderer.sortScratchHeap.makeBuffer(length: length, label: "Spatial Hash Sort Scratch") else {
+                throw SplatEditorError.selectionEngineUnavailable
+            }
+            defer { renderer.sortScratchHeap.recycle([scratch]) }
+            try keySorter(entries, scratch, count, commandBuffer)
+            return commandBuffer
+        }
+
+        try await commit(commandBuffer)
+        GPUMortonReorderer.sortOnCPU(entries, count: count)
+        guard let next = renderer.sortCommandQueue.makeCommandBuffer() else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        next.label = commandBuffer.label
+        return next
+    }
+
+    /// Every third bit of `value`, starting from bit 0: one axis of a 30-bit Morton code
+    private static func compactMortonBits(_ value: UInt32) -> Int32 {
+        var x = value & 0x09249249
+        x = (x | (x >> 2)) & 0x030C30C3
+        x = (x | (x >> 4)) & 0x0300F00F
+        x = (x | (x >> 8)) & 0x030000FF
+        x = (x | (x >> 16)) & 0x000003FF
+        return Int32(x)
+    }
+
+    private func spatialBuffer(_ buffer: inout MTLBuffer?,
+                               length: Int,
+                               options: MTLResourceOptions,
+                               label: String) throws -> MTLBuffer {
+        let length = max(length, 16)
+        if let buffer, buffer.length >= length {
+            return buffer
+        }
+        guard let newBuffer = device.makeBuffer(length: length, options: options) else {
+            throw SplatEditorError.selectionEngineUnavailable
+        }
+        newBuffer.label = label
+        buffer = newBuffer
+        return newBuffer
+    }
+
+    private func dispatch(_ pipeline: MTLComputePipelineState, count: Int, on encoder: MTLComputeCommandEncoder) {
+        let width = max(1, min(pipeline.maxTotalThreadsPerThreadgroup, 256, count))
+        encoder.dispatchThreads(MTLSize(width: count, height: 1, depth: 1),
+                                threadsPerThreadgroup: MTLSize(width: width, height: 1, depth: 1))
+    }
+
+    private func commit(_ commandBuffer: MTLCommandBuffer) async throws {
         try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
             commandBuffer.addCompletedHandler { buffer in
                 if let error = buffer.error {
@@ -292,17 +925,40 @@ final class SplatSelectionEngine: @unchecked Sendable {
             }
             commandBuffer.commit()
         }
+    }
 
-        var bestCandidate = NearestSelectionCandidate(index: -1, distanceSquared: .greatestFiniteMagnitude)
-        for index in 0..<threadgroupCount {
-            let candidate = candidates[index]
-            guard candidate.index >= 0 else { continue }
-            if candidate.distanceSquared < bestCandidate.distanceSquared {
-                bestCandidate = candidate
-            }
-        }
-
-        return bestCandidate.index >= 0 ? Int(bestCandidate.index) : nil
+    private func makeQueryParameters(viewport: SplatRenderer.ViewportDescriptor,
+                                     renderer: SplatRenderer,
+                                     splatCount: Int) -> QueryParameters {
+        let projectionMatrix = viewport.projectionMatrix
+        let projectionX = max(abs(projectionMatrix[0][0]), .ulpOfOne)
+        let projectionY = max(abs(projectionMatrix[1][1]), .ulpOfOne)
+        return QueryParameters(
+            projectionMatrix: projectionMatrix,
+            viewMatrix: viewport.viewMatrix,
+            point: SIMD2<Float>(0, 0),
+            pointRadius: 0,
+            mode: QueryMode.rect.rawValue,
+            splatCount: UInt32(splatCount),
+            rect: SIMD4<Float>(0, 0, 0, 0),
+            sphereCenter: .zero,
+            sphereRadius: 0,
+            boxCenter: .zero,
+            padding0: 0,
+            boxExtents: .zero,
+            padding1: 0,
+            maskSize: .zero,
+            padding2: .zero,
+            screenSize: SIMD2<UInt32>(UInt32(max(viewport.screenSize.x, 1)), UInt32(max(viewport.screenSize.y, 1))),
+            focalX: Float(max(viewport.screenSize.x, 1)) * projectionX * 0.5,
+            focalY: Float(max(viewport.screenSize.y, 1)) * projectionY * 0.5,
+            tanHalfFovX: 1 / projectionX,
+            tanHalfFovY: 1 / projectionY,
+            covarianceBlur: renderer.governedCovarianceBlur,
+            renderMode: renderer.renderMode.rawValue,
+            isOrthographic: viewport.isOrthographic ? 1 : 0,
+            padding3: 0
+        )
     }
 
     private func makeMaskTexture(data: Data, size: SIMD2<Int>) throws -> MTLTexture? {
@@ -375,3 +1031,80 @@ final class SplatSelectionEngine: @unchecked Sendable {
         }
     }
 }
+
+/// What changed in a renderer's splats, as a log of generations. The renderer records invalidations as it edits;
+/// each selection engine remembers the generation it last consumed and asks for the changes since then, so any
+/// number of engines can share one renderer.
+internal final class SelectionClusterInvalidation: @unchecked Sendable {
+    struct Pending {
+        /// Every cluster is stale: the scene was replaced, resized or reordered
+        var all: Bool
+        /// Splats whose position, covariance or transform index changed
+        var splatIndices: IndexSet
+        /// The transform palette changed, moving every splat with a nonzero transform index
+        var transformPalette: Bool
+    }
+
+    /// Splat edits kept in the log; a consumer further behind than this rebuilds every cluster
+    static let maximumRetainedEdits = 256
+
+    private let lock = NSLock()
+    private var generation: UInt64 = 0
+    private var allGeneration: UInt64 = 0
+    private var transformPaletteGeneration: UInt64 = 0
+    /// Consumers that last saw a generation before this one missed dropped edits
+    private var retainedSinceGeneration: UInt64 = 0
+    private var splatEdits: [(generation: UInt64, splatIndices: IndexSet)] = []
+
+    func invalidateAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        generation += 1
+        allGeneration = generation
+        splatEdits.removeAll()
+    }
+
+    func invalidate<Indices: Sequence>(splatIndices: Indices) where Indices.Element == Int {
+        var indices = IndexSet()
+        for index in splatIndices where index >= 0 {
+            indices.insert(index)
+        }
+        guard !indices.isEmpty else { return }
+
+        lock.lock()
+        defer { lock.unlock() }
+        generation += 1
+        splatEdits.append((generation, indices))
+        if splatEdits.count > Self.maximumRetainedEdits {
+            retainedSinceGeneration = splatEdits.removeFirst().generation
+        }
+    }
+
+    func invalidateTransformPalette() {
+        lock.lock()
+        defer { lock.unlock() }
+        generation += 1
+        transformPaletteGeneration = generation
+    }
+
+    /// The invalidations after `consumedGeneration`, and the generation to pass next time; nil means nothing was
+    /// consumed yet, so everything is stale
+    func changes(since consumedGeneration: UInt64?) -> (pending: Pending, generation: UInt64) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let consumedGeneration,
+              consumedGeneration >= allGeneration,
+              consumedGeneration >= retainedSinceGeneration else {
+            return (Pending(all: true, splatIndices: IndexSet(), transformPalette: false), generation)
+        }
+        var splatIndices = IndexSet()
+        for edit in splatEdits.reversed() {
+            guard edit.generation > consumedGeneration else { break }
+            splatIndices.formUnion(edit.splatIndices)
+        }
+        return (Pending(all: false,
+                        splatIndices: splatIndices,
+                        transformPalette: transformPaletteGeneration > consumedGeneration),
+                generation)
+    }
+}
@@ -4,8 +4,19 @@ import simd
 import os
 import SplatIO
 
+/// Decoded payload handed back by an inline payload provider
+public enum StreamingNodePayload: Sendable {
+    /// Already-decoded scene points
+    case points([SplatScenePoint])
+    /// Chunk-compressed splats (see `SplatCompression`)
+    case chunks([SplatChunk])
+}
+
 /// Actor that manages asynchronous loading and unloading of octree nodes.
 /// Implements memory budget enforcement and priority-based loading.
+///
+/// Node payloads are decoded off the actor, uploaded into `splatPool`, and each resident slab is
+/// registered as a `SplatInterval` so the renderer can remap visible ranges.
 public actor StreamingLODManager {
 
     private static let log = Logger(
@@ -13,26 +24,73 @@ public actor StreamingLODManager {
         category: "StreamingLODManager"
     )
 
+    /// Supplies the payload for LOD levels stored inline (`OctreeLODLevel.splatRange`)
+    public typealias InlinePayloadProvider = @Sendable (_ nodeID: String, _ splatRange: Range<Int>) throws -> StreamingNodePayload
+
     /// The octree being managed
     private let octree: SplatOctree
 
     /// Metal device for buffer allocation
     private let device: MTLDevice
 
-    /// Memory budget for loaded splats (bytes)
+    /// Resident GPU storage for loaded nodes
+    public let splatPool: StreamingSplatPool
+
+    /// Intervals of the virtual splat index space covered by resident slabs
+    private let intervalManager: IntervalManager
+
+    /// Memory budget for streamed splats (bytes). Half of it bounds pool slabs, resident and retired; the other half
+    /// is the renderer's draw copy of the visible slabs (see `SplatRenderer.setStreamingLODManager(_:)`).
     public var memoryBudget: Int {
         get { octree.memoryBudget }
-        set { octree.memoryBudget = newValue }
+        set {
+            octree.memoryBudget = newValue
+            splatPool.updateMemoryBudget(Self.slabBudget(forMemoryBudget: newValue))
+        }
+    }
+
+    /// Share of `memoryBudget` available to pool slabs
+    public var slabMemoryBudget: Int {
+        Self.slabBudget(forMemoryBudget: memoryBudget)
+    }
+
+    static func slabBudget(forMemoryBudget memoryBudget: Int) -> Int {
+        memoryBudget / 2
+    }
+
+    /// Loaded slab bytes over `slabMemoryBudget`; the draw copy grows and shrinks with them
+    private var slabBudgetUtilization: Float {
+        Float(octree.loadedMemoryBytes) / Float(max(slabMemoryBudget, 1))
     }
 
     /// Maximum concurrent load operations
     public var maxConcurrentLoads: Int = 4
 
+    /// Maximum number of splats started per `update` call. At least one load is always
+    /// allowed so a single oversized node cannot stall streaming.
+    public var maxUploadSplatsPerUpdate: Int = 1_000_000
+
+    /// Provider for inline LOD payloads; when nil, inline levels are fetched from `remotePayloadURL`
+    public var inlinePayloadProvider: InlinePayloadProvider?
+
+    /// Remote `.splat` file holding the splats inline LOD levels address: each `splatRange` is fetched with one
+    /// HTTP range request, so a node costs only its own bytes. Used when `inlinePayloadProvider` is nil.
+    public var remotePayloadURL: URL?
+
+    /// Fetches remote node resources and `remotePayloadURL` ranges
+    public var remoteLoader: RemoteSceneLoader
+
     /// Currently loading node IDs
     private var loadingNodes: Set<String> = []
 
-    /// Queue of nodes waiting to load
-    private var loadQueue: [String] = []
+    /// Interval start indices registered for each resident node
+    private var nodeIntervalStarts: [String: [Int]] = [:]
+
+    /// Bumped whenever the resident slabs or their visibility change
+    private var residencyGeneration: UInt64 = 0
+
+    /// Pool bytes reserved by in-flight loads
+    private var reservedBytes: Int = 0
 
     /// Callback when a node finishes loading
     public var onNodeLoaded: ((String, Int) -> Void)?
@@ -40,9 +98,17 @@ public actor StreamingLODManager {
     /// Callback when a node is unloaded
     public var onNodeUnloaded: ((String) -> Void)?
 
-    private enum LoadPlan: Sendable {
-        case external(URL, Int)
-        case inline(Int)
+    private struct LoadPlan: Sendable {
+        enum Source: Sendable {
+            case external(URL)
+            case inline(Range<Int>)
+            case remoteRange(URL, Range<Int>)
+        }
+
+        let nodeID: String
+        let lodLevel: Int
+        let splatCount: Int
+        let source: Source
     }
 
     /// Whether the manager is actively streaming
@@ -51,9 +117,25 @@ public actor StreamingLODManager {
     /// Base URL for loading splat data files
     public var baseURL: URL?
 
-    public init(octree: SplatOctree, device: MTLDevice) {
+    /// - Parameters:
+    ///   - octree: Octree to stream
+    ///   - device: Metal device used for the slab pool
+    ///   - slabCapacity: Splats per pool slab
+    ///   - remotePayloadURL: Remote `.splat` file that inline LOD levels are range-fetched from
+    ///   - remoteLoader: Loader for remote node resources and payload ranges
+    public init(octree: SplatOctree,
+                device: MTLDevice,
+                slabCapacity: Int = 65_536,
+                remotePayloadURL: URL? = nil,
+                remoteLoader: RemoteSceneLoader = RemoteSceneLoader()) {
         self.octree = octree
+        self.remotePayloadURL = remotePayloadURL
+        self.remoteLoader = remoteLoader
         self.device = device
+        self.splatPool = StreamingSplatPool(device: device,
+                                            slabCapacity: slabCapacity,
+                                            memoryBudget: Self.slabBudget(forMemoryBudget: octree.memoryBudget))
+        self.intervalManager = IntervalManager(device: device)
     }
 
     /// Updates the streaming state based on current camera view.
@@ -75,19 +157,22 @@ public actor StreamingLODManager {
             screenHeight: screenHeight
         )
 
+        // Recycle slabs evicted far enough in the past
+        splatPool.advanceFrame()
+
         // Check memory pressure and unload if needed
         await enforceMemoryBudget()
 
         // Queue new loads
         await processLoadQueue()
+
+        refreshIntervalVisibility()
     }
 
     /// Enforces memory budget by unloading least important nodes
     private func enforceMemoryBudget() async {
-        let stats = octree.getStatistics()
-
         // If over budget, unload until under
-        while octree.loadedMemoryBytes > memoryBudget {
+        while octree.loadedMemoryBytes > slabMemoryBudget {
             let candidates = octree.getUnloadCandidates()
             guard let nodeID = candidates.first else {
                 Self.log.warning("Over memory budget but no unload candidates")
@@ -97,72 +182,111 @@ public actor StreamingLODManager {
             await unloadNode(nodeID: nodeID)
         }
 
-        if stats.budgetUtilization > 0.9 {
-            Self.log.debug("Memory budget at \(String(format: "%.1f", stats.budgetUtilization * 100))%")
+        let utilization = slabBudgetUtilization
+        if utilization > 0.9 {
+            Self.log.debug("Slab memory budget at \(String(format: "%.1f", utilization * 100))%")
         }
     }
 
     /// Processes the load queue, starting new loads as capacity allows
     private func processLoadQueue() async {
-        // Get nodes that need loading
-        let pendingLoads = octree.getLoadQueue()
-
-        // Filter out already loading nodes
-        let newLoads = pendingLoads.filter { !loadingNodes.contains($0) }
+        // Get nodes that need loading, most important first
+        let pendingLoads = octree.getLoadQueue().filter { !loadingNodes.contains($0) }
 
-        // Start new loads up to capacity
         // Guard against negative capacity if loadingNodes.count exceeds maxConcurrentLoads
         // (can happen if maxConcurrentLoads is lowered while loads are in flight)
-        let availableCapacity = max(0, maxConcurrentLoads - loadingNodes.count)
-        for nodeID in newLoads.prefix(availableCapacity) {
-            await startLoading(nodeID: nodeID)
+        var availableCapacity = max(0, maxConcurrentLoads - loadingNodes.count)
+        var uploadBudget = maxUploadSplatsPerUpdate
+
+        for nodeID in pendingLoads {
+            guard availableCapacity > 0 else { break }
+
+            let plan: LoadPlan
+            do {
+                plan = try makeLoadPlan(nodeID: nodeID)
+            } catch {
+                Self.log.error("Failed to prepare node \(nodeID): \(error.localizedDescription)")
+                continue
+            }
+
+            if plan.splatCount > uploadBudget && uploadBudget < maxUploadSplatsPerUpdate {
+                break
+            }
+
+            let bytes = splatPool.slabsRequired(forSplatCount: plan.splatCount) * splatPool.slabByteSize
+            guard await reserveMemory(bytes, for: nodeID) else {
+                Self.log.debug("Deferring node \(nodeID): \(bytes / 1024)KB does not fit the memory budget")
+                break
+            }
+
+            availableCapacity -= 1
+            uploadBudget -= plan.splatCount
+            startLoading(plan, reservedBytes: bytes)
+        }
+    }
+
+    /// Reserves `bytes` of pool memory if resident, retired and reserved slabs leave room for them.
+    /// Otherwise evicts unload candidates covering the shortfall and defers the load: evicted slabs
+    /// stay allocated until they retire, so the room only appears a few frames later.
+    private func reserveMemory(_ bytes: Int, for nodeID: String) async -> Bool {
+        var shortfall = splatPool.allocatedBytes + reservedBytes + bytes - slabMemoryBudget
+        guard shortfall > 0 else { return true }
+
+        for victim in octree.getUnloadCandidates() where victim != nodeID {
+            guard shortfall > 0 else { break }
+            shortfall -= splatPool.slabs(for: victim).count * splatPool.slabByteSize
+            await unloadNode(nodeID: victim)
         }
+        return false
     }
 
-    /// Starts loading a node asynchronously
-    private func startLoading(nodeID: String) async {
-        guard !loadingNodes.contains(nodeID) else { return }
+    /// Starts loading a node asynchronously. Decoding and upload run off the actor.
+    private func startLoading(_ plan: LoadPlan, reservedBytes bytes: Int) {
+        guard !loadingNodes.contains(plan.nodeID) else { return }
 
-        loadingNodes.insert(nodeID)
+        loadingNodes.insert(plan.nodeID)
+        reservedBytes += bytes
         isStreaming = true
 
-        let plan: LoadPlan
-        do {
-            plan = try makeLoadPlan(nodeID: nodeID)
-        } catch {
-            Self.log.error("Failed to prepare node \(nodeID): \(error.localizedDescription)")
-            await completeLoading(nodeID: nodeID, success: false, memoryBytes: 0)
-            return
-        }
+        let pool = splatPool
+        let provider = inlinePayloadProvider
+        let loader = remoteLoader
 
         Task.detached(priority: .userInitiated) { [weak self] in
             do {
-                let memoryUsed = try Self.executeLoadPlan(plan)
-                await self?.completeLoading(nodeID: nodeID, success: true, memoryBytes: memoryUsed)
+                let splats = try await Self.decodePayload(plan, inlinePayloadProvider: provider, remoteLoader: loader)
+                let slabs = try pool.upload(splats, nodeID: plan.nodeID, lodLevel: plan.lodLevel)
+                await self?.completeLoading(plan, reservedBytes: bytes, slabs: slabs)
             } catch {
-                Self.log.error("Failed to load node \(nodeID): \(error)")
-                await self?.completeLoading(nodeID: nodeID, success: false, memoryBytes: 0)
+                Self.log.error("Failed to load node \(plan.nodeID): \(error)")
+                await self?.completeLoading(plan, reservedBytes: bytes, slabs: nil)
             }
         }
     }
 
     /// Resolves the data source for a node without performing blocking IO on the actor.
+    /// Picks the LOD level selected by the octree's screen-space error test, or the closest available one.
     private func makeLoadPlan(nodeID: String) throws -> LoadPlan {
         guard let node = octree.scene.nodes[nodeID] else {
             throw StreamingError.nodeNotFound(nodeID)
         }
 
-        // Find the LOD level to load
-        // For now, load the finest available LOD
-        guard let lod = node.lodLevels.first else {
+        let targetLevel = octree.selectedLOD(for: nodeID) ?? 0
+        guard let lod = node.lodLevels.min(by: { abs($0.level - targetLevel) < abs($1.level - targetLevel) }) else {
             throw StreamingError.noLODData(nodeID)
         }
 
         if let url = lod.resourceURL {
-            return .external(resolveURL(url), lod.splatCount)
+            return LoadPlan(nodeID: nodeID, lodLevel: lod.level, splatCount: lod.splatCount,
+                            source: .external(resolveURL(url)))
         } else if let range = lod.splatRange {
-            let memoryEstimate = range.count * MemoryLayout<Float>.stride * 20  // ~20 floats per splat estimate
-            return .inline(memoryEstimate)
+            let source: LoadPlan.Source
+            if inlinePayloadProvider == nil, let remotePayloadURL {
+                source = .remoteRange(resolveURL(remotePayloadURL), range)
+            } else {
+                source = .inline(range)
+            }
+            return LoadPlan(nodeID: nodeID, lodLevel: lod.level, splatCount: range.count, source: source)
         } else {
             throw StreamingError.noLODData(nodeID)
         }
@@ -178,28 +302,91 @@ public actor StreamingLODManager {
         }
     }
 
-    private nonisolated static func executeLoadPlan(_ plan: LoadPlan) throws -> Int {
-        switch plan {
-        case .inline(let memoryEstimate):
-            return memoryEstimate
-        case .external(let resolvedURL, let splatCount):
-            let data = try Data(contentsOf: resolvedURL, options: [.mappedIfSafe])
-            let memoryUsed = data.count
-            Self.log.debug("Loaded \(splatCount) splats from \(resolvedURL.lastPathComponent), \(memoryUsed / 1024)KB")
-            return memoryUsed
+    /// Decodes a node payload into renderer splats
+    private nonisolated static func decodePayload(_ plan: LoadPlan,
+                                                  inlinePayloadProvider: InlinePayloadProvider?,
+                                                  remoteLoader: RemoteSceneLoader) async throws -> [SplatRenderer.Splat] {
+        switch plan.source {
+        case .external(let url):
+            var fileURL = url
+            var isTemporary = false
+            if RemoteSceneLoader.isRemote(url) {
+                (fileURL, isTemporary) = try await remoteLoader.localFile(for: url)
+            }
+            defer {
+                if isTemporary {
+                    try? FileManager.default.removeItem(at: fileURL)
+                }
+            }
+            let points = try AutodetectSceneReader(fileURL).readScene()
+            Self.log.debug("Decoded \(points.count) splats from \(url.lastPathComponent)")
+            return points.map(SplatRenderer.Splat.init)
+        case .remoteRange(let url, let range):
+            let points = try await remoteLoader.dotSplatPoints(from: url, records: range)
+            Self.log.debug("Fetched \(points.count) splats from \(url.lastPathComponent) [\(range.lowerBound)..<\(range.upperBound)]")
+            return points.map(SplatRenderer.Splat.init)
+        case .inline(let range):
+            guard let inlinePayloadProvider else {
+                throw StreamingError.noInlinePayloadProvider(plan.nodeID)
+            }
+            switch try inlinePayloadProvider(plan.nodeID, range) {
+            case .points(let points):
+                return points.map(SplatRenderer.Splat.init)
+            case .chunks(let chunks):
+                return decodeChunks(chunks)
+            }
+        }
+    }
+
+    private nonisolated static func decodeChunks(_ chunks: [SplatChunk]) -> [SplatRenderer.Splat] {
+        var splats: [SplatRenderer.Splat] = []
+        splats.reserveCapacity(chunks.reduce(0) { $0 + $1.splats.count })
+
+        for chunk in chunks {
+            let header = chunk.header
+            for packed in chunk.splats {
+                let color = SplatCompression.unpackColor(packed.colorPacked)
+                let point = SplatScenePoint(
+                    position: SplatCompression.unpackPosition(packed.positionPacked,
+                                                              min: header.minPosition,
+                                                              max: header.maxPosition),
+                    color: .linearFloat(SIMD3(color.x, color.y, color.z)),
+                    opacity: .linearFloat(color.w),
+                    scale: .linearFloat(SplatCompression.unpackScale(packed.scalePacked,
+                                                                     min: header.minScale,
+                                                                     max: header.maxScale)),
+                    rotation: SplatCompression.unpackRotation(packed.rotationPacked)
+                )
+                splats.append(SplatRenderer.Splat(point))
+            }
         }
+        return splats
     }
 
     /// Completes a loading operation
-    private func completeLoading(nodeID: String, success: Bool, memoryBytes: Int) async {
-        loadingNodes.remove(nodeID)
-
-        if success {
-            // Get the LOD level that was loaded
-            let lodLevel = octree.scene.nodes[nodeID]?.lodLevels.first?.level ?? 0
-            octree.markAsLoaded(nodeID: nodeID, lodLevel: lodLevel, memoryBytes: memoryBytes)
-            onNodeLoaded?(nodeID, lodLevel)
-            Self.log.debug("Node \(nodeID) loaded, LOD \(lodLevel)")
+    private func completeLoading(_ plan: LoadPlan, reservedBytes bytes: Int, slabs: [StreamingSplatPool.Slab]?) async {
+        loadingNodes.remove(plan.nodeID)
+        reservedBytes -= bytes
+
+        if let slabs {
+            unregisterIntervals(nodeID: plan.nodeID)
+            for slab in slabs {
+                intervalManager.registerInterval(SplatInterval(
+                    sourceStart: slab.globalStart,
+                    sourceEnd: slab.globalRange.upperBound,
+                    priority: 1.0 / Float(plan.lodLevel + 1),
+                    lodLevel: plan.lodLevel,
+                    isVisible: octree.isVisible(nodeID: plan.nodeID)
+                ))
+            }
+            nodeIntervalStarts[plan.nodeID] = slabs.map(\.globalStart)
+            residencyGeneration += 1
+
+            octree.markAsLoaded(nodeID: plan.nodeID,
+                                lodLevel: plan.lodLevel,
+                                memoryBytes: slabs.count * splatPool.slabByteSize)
+            onNodeLoaded?(plan.nodeID, plan.lodLevel)
+            Self.log.debug("Node \(plan.nodeID) loaded, LOD \(plan.lodLevel), \(slabs.count) slab(s)")
         }
 
         isStreaming = !loadingNodes.isEmpty
@@ -207,11 +394,51 @@ public actor StreamingLODManager {
 
     /// Unloads a node to free memory
     private func unloadNode(nodeID: String) async {
+        splatPool.evict(nodeID: nodeID)
+        unregisterIntervals(nodeID: nodeID)
+        residencyGeneration += 1
         octree.markAsUnloaded(nodeID: nodeID)
         onNodeUnloaded?(nodeID)
         Self.log.debug("Node \(nodeID) unloaded")
     }
 
+    private func unregisterIntervals(nodeID: String) {
+        for sourceStart in nodeIntervalStarts.removeValue(forKey: nodeID) ?? [] {
+            intervalManager.unregisterInterval(sourceStart: sourceStart)
+        }
+    }
+
+    /// Mirrors octree node visibility onto the registered intervals
+    private func refreshIntervalVisibility() {
+        var visibleIndices = Set<Int>()
+        for (index, interval) in intervalManager.intervals.enumerated() {
+            if let nodeID = splatPool.nodeID(forGlobalIndex: interval.sourceStart),
+               octree.isVisible(nodeID: nodeID) {
+                visibleIndices.insert(index)
+            }
+        }
+        let wasVisible = intervalManager.intervals.map(\.isVisible)
+        intervalManager.updateVisibility(visibleIndices: visibleIndices)
+        if intervalManager.intervals.map(\.isVisible) != wasVisible {
+            residencyGeneration += 1
+        }
+    }
+
+    /// Visible intervals of resident slabs, in remapped order
+    public func activeIntervals() -> [SplatInterval] {
+        intervalManager.activeIntervals
+    }
+
+    /// The slabs to draw: resident slabs of visible nodes, in `activeIntervals()` order
+    public func residency() -> StreamingResidency {
+        let slabs = intervalManager.activeIntervals.compactMap { interval -> StreamingResidency.DrawSlab? in
+            let slot = interval.sourceStart / splatPool.slabCapacity
+            guard let (buffer, uploadID) = splatPool.uploadedBuffer(forSlot: slot) else { return nil }
+            return StreamingResidency.DrawSlab(buffer: buffer, count: interval.sourceEnd - interval.sourceStart, id: uploadID)
+        }
+        return StreamingResidency(generation: residencyGeneration, slabs: slabs)
+    }
+
     /// Forces immediate unloading of all non-visible nodes
     public func unloadInvisibleNodes() async {
         let candidates = octree.getUnloadCandidates()
@@ -231,10 +458,28 @@ public actor StreamingLODManager {
             visibleNodes: octreeStats.visibleNodes,
             memoryUsedMB: octreeStats.loadedMemoryMB,
             memoryBudgetMB: octreeStats.memoryBudgetMB,
-            budgetUtilization: octreeStats.budgetUtilization
+            budgetUtilization: slabBudgetUtilization
         )
     }
 
+    /// Snapshot of the slabs a frame should draw. Slab buffers outlive eviction by the pool's
+    /// `retireFrameLatency` updates, so a snapshot stays readable until the next few `update` calls.
+    public struct StreamingResidency: @unchecked Sendable {
+        public struct DrawSlab {
+            /// Pool buffer holding `count` splats from offset zero
+            public let buffer: MTLBuffer
+            public let count: Int
+            /// Identifies the upload the buffer holds; the same buffer recycled for another node has a new id
+            public let id: UInt64
+        }
+
+        /// Changes whenever the set of slabs to draw changes
+        public let generation: UInt64
+        public let slabs: [DrawSlab]
+
+        public var splatCount: Int { slabs.reduce(0) { $0 + $1.count } }
+    }
+
     /// Statistics about streaming state
     public struct StreamingStatistics: Sendable {
         public let isStreaming: Bool
@@ -242,8 +487,10 @@ public actor StreamingLODManager {
         public let queuedCount: Int
         public let loadedNodes: Int
         public let visibleNodes: Int
+        /// Pool slab memory of loaded nodes
         public let memoryUsedMB: Float
         public let memoryBudgetMB: Float
+        /// `memoryUsedMB` over the slab half of the budget
         public let budgetUtilization: Float
     }
 
@@ -251,6 +498,7 @@ public actor StreamingLODManager {
     public enum StreamingError: Error, LocalizedError {
         case nodeNotFound(String)
         case noLODData(String)
+        case noInlinePayloadProvider(String)
         case loadFailed(String, Error)
 
         public var errorDescription: String? {
@@ -259,6 +507,8 @@ public actor StreamingLODManager {
                 return "Node not found: \(id)"
             case .noLODData(let id):
                 return "No LOD data available for node: \(id)"
+            case .noInlinePayloadProvider(let id):
+                return "Node \(id) stores inline splats but no inline payload provider is set"
             case .loadFailed(let id, let error):
                 return "Failed to load node \(id): \(error.localizedDescription)"
             }
@@ -0,0 +1,296 @@
+import Foundation
+import Metal
+import os
+import SplatIO
+
+/// Resident GPU storage for streamed octree node payloads.
+///
+/// Node payloads are uploaded into fixed-capacity slabs leased from a `MetalBufferPool`, so evicting
+/// a node recycles its slabs instead of reallocating them. Each slab owns a stable slot in a virtual
+/// index space (`slot * slabCapacity ..< slot * slabCapacity + count`); those ranges are what
+/// `StreamingLODManager` registers with `IntervalManager`.
+///
+/// Evicted slabs are not returned to the pool until `retireFrameLatency` frames have passed, so a
+/// command buffer still reading a slab never sees it overwritten by the next upload. Until then they
+/// still occupy GPU memory, so retired slabs count against the memory budget like resident ones.
+public final class StreamingSplatPool: @unchecked Sendable {
+
+    private static let log = Logger(
+        subsystem: Bundle.main.bundleIdentifier ?? "MetalSplatter",
+        category: "StreamingSplatPool"
+    )
+
+    /// Snapshot of one resident slab
+    public struct Slab: Sendable {
+        /// Stable slot in the virtual index space
+        public let slot: Int
+        /// Node whose payload this slab holds
+        public let nodeID: String
+        /// LOD level of the payload
+        public let lodLevel: Int
+        /// Number of splats stored in the slab (≤ `slabCapacity`)
+        public let count: Int
+        /// First virtual splat index covered by this slab
+        public let globalStart: Int
+
+        public var globalRange: Range<Int> { globalStart..<(globalStart + count) }
+    }
+
+    public enum PoolError: LocalizedError {
+        case capacityExhausted(requestedSlabs: Int, freeSlabs: Int)
+
+        public var errorDescription: String? {
+            switch self {
+            case .capacityExhausted(let requested, let free):
+                return "Streaming pool exhausted: requested \(requested) slabs, \(free) free"
+            }
+        }
+    }
+
+    private struct ResidentSlab {
+        let info: Slab
+        let buffer: MetalBuffer<SplatRenderer.Splat>
+        /// Unique per upload; a recycled buffer or slot comes back with a new one
+        let uploadID: UInt64
+    }
+
+    private struct RetiredSlab {
+        let buffer: MetalBuffer<SplatRenderer.Splat>
+        let releaseFrame: UInt64
+    }
+
+    /// Number of splats per slab
+    public let slabCapacity: Int
+
+    /// Maximum number of slabs resident at once (derived from the memory budget)
+    public var maxSlabs: Int {
+        lock.withLock { slabLimit }
+    }
+
+    /// Frames an evicted slab is kept alive before its buffer is recycled
+    public var retireFrameLatency: Int = 3
+
+    private let bufferPool: MetalBufferPool<SplatRenderer.Splat>
+    private let lock = NSLock()
+    private var slabLimit: Int
+    private var residentSlabs: [Int: ResidentSlab] = [:]
+    private var slotsByNode: [String: [Int]] = [:]
+    private var freeSlots: [Int] = []
+    private var nextSlot = 0
+    private var retiredSlabs: [RetiredSlab] = []
+    private var frame: UInt64 = 0
+    private var nextUploadID: UInt64 = 0
+
+    /// - Parameters:
+    ///   - device: Metal device used for slab allocation
+    ///   - slabCapacity: Splats per slab
+    ///   - memoryBudget: Upper bound on resident slab memory; determines `maxSlabs`
+    public init(device: MTLDevice, slabCapacity: Int = 65_536, memoryBudget: Int) {
+        self.slabCapacity = max(slabCapacity, 1)
+        self.slabLimit = Self.slabLimit(forMemoryBudget: memoryBudget, slabCapacity: self.slabCapacity)
+        self.bufferPool = MetalBufferPool(
+            device: device,
+            configuration: MetalBufferPool<SplatRenderer.Splat>.Configuration(
+                maxPoolSize: 16,
+                maxBufferAge: 300.0,
+                memoryPressureThreshold: 0.8,
+                // Slabs are filled on the CPU and only read by the GPU
+                useHeapAllocation: true
+            )
+        )
+    }
+
+    deinit {
+        for slab in residentSlabs.values {
+            bufferPool.release(slab.buffer)
+        }
+        for retired in retiredSlabs {
+            bufferPool.release(retired.buffer)
+        }
+    }
+
+    /// Updates the resident slab limit. Lowering it does not evict anything by itself;
+    /// callers evict nodes until `residentBytes` fits again.
+    public func updateMemoryBudget(_ memoryBudget: Int) {
+        lock.withLock {
+            slabLimit = Self.slabLimit(forMemoryBudget: memoryBudget, slabCapacity: slabCapacity)
+        }
+    }
+
+    private static func slabLimit(forMemoryBudget memoryBudget: Int, slabCapacity: Int) -> Int {
+        max(1, memoryBudget / (slabCapacity * MemoryLayout<SplatRenderer.Splat>.stride))
+    }
+
+    /// Bytes occupied by one slab
+    public var slabByteSize: Int {
+        slabCapacity * MemoryLayout<SplatRenderer.Splat>.stride
+    }
+
+    /// Number of slabs needed to hold `splatCount` splats
+    public func slabsRequired(forSplatCount splatCount: Int) -> Int {
+        (max(splatCount, 1) + slabCapacity - 1) / slabCapacity
+    }
+
+    public var residentSlabCount: Int {
+        lock.withLock { residentSlabs.count }
+    }
+
+    /// Evicted slabs whose buffers are still waiting out `retireFrameLatency`
+    public var retiredSlabCount: Int {
+        lock.withLock { retiredSlabs.count }
+    }
+
+    public var freeSlabCount: Int {
+        lock.withLock { max(0, slabLimit - residentSlabs.count - retiredSlabs.count) }
+    }
+
+    public var residentBytes: Int {
+        residentSlabCount * slabByteSize
+    }
+
+    /// GPU memory held by the pool's slabs: resident and retired
+    public var allocatedBytes: Int {
+        lock.withLock { (residentSlabs.count + retiredSlabs.count) * slabByteSize }
+    }
+
+    /// Uploads a decoded node payload into as many slabs as it needs.
+    /// Any slabs previously held by the node are evicted once the upload succeeds; they stay allocated
+    /// until retired, so a replacement needs free slabs of its own.
+    @discardableResult
+    func upload(_ splats: [SplatRenderer.Splat], nodeID: String, lodLevel: Int) throws -> [Slab] {
+        let slabCount = slabsRequired(forSplatCount: splats.count)
+
+        let slots: [Int] = try lock.withLock {
+            let free = max(0, slabLimit - residentSlabs.count - retiredSlabs.count)
+            guard slabCount <= free else {
+                throw PoolError.capacityExhausted(requestedSlabs: slabCount, freeSlabs: free)
+            }
+            return (0..<slabCount).map { _ in allocateSlot() }
+        }
+
+        var uploaded: [ResidentSlab] = []
+        do {
+            for (slabIndex, slot) in slots.enumerated() {
+                let start = slabIndex * slabCapacity
+                let end = min(start + slabCapacity, splats.count)
+                let buffer = try bufferPool.acquire(minimumCapacity: slabCapacity)
+                buffer.count = 0
+                if start < end {
+                    splats.withUnsafeBufferPointer {
+                        buffer.append(UnsafeBufferPointer(rebasing: $0[start..<end]))
+                    }
+                }
+                buffer.buffer.label = "Streaming Slab \(slot) (\(nodeID))"
+                let info = Slab(slot: slot,
+                                nodeID: nodeID,
+                                lodLevel: lodLevel,
+                                count: end - start,
+                                globalStart: slot * slabCapacity)
+                uploaded.append(ResidentSlab(info: info, buffer: buffer, uploadID: 0))
+            }
+        } catch {
+            lock.withLock {
+                freeSlots.append(contentsOf: slots)
+            }
+            for slab in uploaded {
+                bufferPool.release(slab.buffer)
+            }
+            throw error
+        }
+
+        lock.withLock {
+            if let previous = slotsByNode[nodeID] {
+                retireSlotsLocked(previous)
+            }
+            for slab in uploaded {
+                nextUploadID += 1
+                residentSlabs[slab.info.slot] = ResidentSlab(info: slab.info, buffer: slab.buffer, uploadID: nextUploadID)
+            }
+            slotsByNode[nodeID] = slots
+        }
+
+        Self.log.debug("Uploaded \(splats.count) splats for \(nodeID) into \(slots.count) slab(s)")
+        return uploaded.map(\.info)
+    }
+
+    /// Evicts every slab owned by `nodeID`. Returns the evicted slabs so callers can drop their intervals.
+    @discardableResult
+    public func evict(nodeID: String) -> [Slab] {
+        lock.withLock {
+            guard let slots = slotsByNode.removeValue(forKey: nodeID) else { return [] }
+            let evicted = slots.compactMap { residentSlabs[$0]?.info }
+            retireSlotsLocked(slots)
+            return evicted
+        }
+    }
+
+    /// Advances the retirement clock and recycles slabs evicted more than `retireFrameLatency` frames ago.
+    /// Call once per frame.
+    public func advanceFrame() {
+        let ready: [MetalBuffer<SplatRenderer.Splat>] = lock.withLock {
+            frame += 1
+            let ready = retiredSlabs.filter { $0.releaseFrame <= frame }.map(\.buffer)
+            retiredSlabs.removeAll { $0.releaseFrame <= frame }
+            return ready
+        }
+        for buffer in ready {
+            bufferPool.release(buffer)
+        }
+    }
+
+    /// Resident slabs for a node, ordered by slot
+    public func slabs(for nodeID: String) -> [Slab] {
+        lock.withLock {
+            (slotsByNode[nodeID] ?? []).compactMap { residentSlabs[$0]?.info }
+        }
+    }
+
+    /// All resident slabs, ordered by slot
+    public func allSlabs() -> [Slab] {
+        lock.withLock {
+            residentSlabs.keys.sorted().compactMap { residentSlabs[$0]?.info }
+        }
+    }
+
+    /// Node owning the slab that contains a virtual splat index
+    public func nodeID(forGlobalIndex globalIndex: Int) -> String? {
+        lock.withLock {
+            residentSlabs[globalIndex / slabCapacity]?.info.nodeID
+        }
+    }
+
+    /// The GPU buffer backing a resident slab (contains `Slab.count` splats)
+    public func buffer(forSlot slot: Int) -> MTLBuffer? {
+        lock.withLock {
+            residentSlabs[slot]?.buffer.buffer
+        }
+    }
+
+    /// `buffer(forSlot:)` with the id of the upload it holds
+    func uploadedBuffer(forSlot slot: Int) -> (buffer: MTLBuffer, uploadID: UInt64)? {
+        lock.withLock {
+            residentSlabs[slot].map { ($0.buffer.buffer, $0.uploadID) }
+        }
+    }
+
+    // MARK: - Private
+
+    /// Must be called with `lock` held
+    private func allocateSlot() -> Int {
+        if let slot = freeSlots.popLast() {
+            return slot
+        }
+        defer { nextSlot += 1 }
+        return nextSlot
+    }
+
+    /// Must be called with `lock` held
+    private func retireSlotsLocked(_ slots: [Int]) {
+        let releaseFrame = frame + UInt64(max(retireFrameLatency, 0))
+        for slot in slots {
+            guard let slab = residentSlabs.removeValue(forKey: slot) else { continue }
+            retiredSlabs.append(RetiredSlab(buffer: slab.buffer, releaseFrame: releaseFrame))
+            freeSlots.append(slot)
+        }
+    }
+}
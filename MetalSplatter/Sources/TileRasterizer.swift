@@ -0,0 +1,385 @@
+import Metal
+import simd
+import os
+
+/// Tile-binned compute rasterizer modeled on the reference 3DGS tile renderer
+///
+/// Instead of blending instanced quads in the hardware blend unit, each frame:
+/// 1. Project: splats are projected in a compute pass and duplicated into one key per
+///    16×16 tile they touch, keyed by (tile, view depth)
+/// 2. Sort: the keys go through the stable radix passes shared with `Metal4Sorter`, so every
+///    tile's splats are contiguous and front-to-back
+/// 3. Ranges: each tile's span of the sorted keys is found, dispatched indirectly from the
+///    GPU-side entry count
+/// 4. Blend: one threadgroup per tile blends its splats front-to-back in threadgroup memory,
+///    terminating early once every pixel's transmittance is saturated
+/// 5. Composite: the premultiplied image is drawn over the render target
+///
+/// The number of tile entries is only known on the GPU. Key storage is sized from the last
+/// completed frame's count (read back asynchronously) with headroom; entries past the capacity
+/// are dropped for that frame and the next frame grows to fit.
+///
+/// Resources are only replaced on the render thread and the entry count is published under a
+/// lock, so the rasterizer can be captured by command buffer completion handlers.
+@available(iOS 26.0, macOS 26.0, visionOS 26.0, *)
+internal final class TileRasterizer: @unchecked Sendable {
+
+    private static let log = Logger(subsystem: Bundle.main.bundleIdentifier ?? "MetalSplatter",
+                                    category: "TileRasterizer")
+
+    // Keep in sync with TileRasterizer.metal
+    static let tileSize = 16
+    private static let threadsPerTile = tileSize * tileSize
+    /// Fewest key bits left for depth; limits the tile count per frame
+    static let minimumDepthBits = 16
+    private static let projectedSplatStride = 32
+    private static let entryStride = MemoryLayout<Metal4Sorter.SortingKey>.stride
+    private static let minimumEntriesPerSplat = 4
+
+    // Parameters structure matching Metal shader
+    struct TileRasterParams {
+        var screenSize: SIMD2<UInt32>
+        var tileCount: SIMD2<UInt32>
+        var splatCount: UInt32
+        var entryCapacity: UInt32
+        var depthBits: UInt32
+        var padding: UInt32 = 0
+    }
+
+    private let device: MTLDevice
+    private let sorter: Metal4Sorter
+
+    // Pipeline states
+    private let projectPipeline: MTLComputePipelineState
+    private let prepareDispatchPipeline: MTLComputePipelineState
+    private let identifyRangesPipeline: MTLComputePipelineState
+    private let blendPipeline: MTLComputePipelineState
+    private let compositePipeline: MTLRenderPipelineState
+    private let compositeDepthState: MTLDepthStencilState
+
+    // Reusable buffers (allocated on demand)
+    private var projectedBuffer: MTLBuffer?
+    private var entriesBuffer: MTLBuffer?
+    private var entriesScratchBuffer: MTLBuffer?
+    private var tileRangesBuffer: MTLBuffer?
+    private var imageTexture: MTLTexture?
+    private let entryCountBuffer: MTLBuffer
+    private let dispatchArgumentsBuffer: MTLBuffer
+    // One entry-count slot per in-flight frame, read in completed handlers
+    private let entryCountReadbackBuffer: MTLBuffer
+    private let readbackSlotCount: Int
+
+    private var entryCountLock = os_unfair_lock()
+    private var lastEntryCount = 0
+
+    /// Upper bound on key slots per frame (each slot costs 16 bytes across the key and scratch buffers)
+    var maximumEntryCount = 16 * 1024 * 1024
+
+    init(device: MTLDevice,
+         library: MTLLibrary,
+         colorFormat: MTLPixelFormat,
+         depthFormat: MTLPixelFormat,
+         sampleCount: Int,
+         maxViewCount: Int,
+         maxSimultaneousRenders: Int) throws {
+        self.device = device
+        sorter = try Metal4Sorter(device: device, library: library)
+
+        func makeFunction(_ name: String) throws -> MTLFunction {
+            guard let function = library.makeFunction(name: name) else {
+                throw SplatRendererError.failedToLoadShaderFunction(name: name)
+            }
+            return function
+        }
+        func makeComputePipeline(_ name: String) throws -> MTLComputePipelineState {
+            let function = try makeFunction(name)
+            do {
+                return try device.makeComputePipelineState(function: function)
+            } catch {
+                throw SplatRendererError.failedToCreateComputePipelineState(functionName: name, underlying: error)
+            }
+        }
+        projectPipeline = try makeComputePipeline("tileRasterProjectSplats")
+        prepareDispatchPipeline = try makeComputePipeline("tileRasterPrepareDispatch")
+        identifyRangesPipeline = try makeComputePipeline("tileRasterIdentifyRanges")
+        blendPipeline = try makeComputePipeline("tileRasterBlend")
+
+        // One thread per pixel of a tile
+        guard blendPipeline.maxTotalThreadsPerThreadgroup >= Self.threadsPerTile else {
+            throw SplatRendererError.internalPipelineMismatch(
+                expected: "\(Self.threadsPerTile) threads per threadgroup",
+                actual: "\(blendPipeline.maxTotalThreadsPerThreadgroup)"
+            )
+        }
+
+        let pipelineDescriptor = MTLRenderPipelineDescriptor()
+        pipelineDescriptor.label = "TileRasterCompositePipeline"
+        pipelineDescriptor.vertexFunction = try makeFunction("tileRasterCompositeVertex")
+        pipelineDescriptor.fragmentFunction = try makeFunction("tileRasterCompositeFragment")
+        pipelineDescriptor.rasterSampleCount = sampleCount
+
+        let colorAttachment = pipelineDescriptor.colorAttachments[0]
+        colorAttachment?.pixelFormat = colorFormat
+        colorAttachment?.isBlendingEnabled = true
+        colorAttachment?.rgbBlendOperation = .add
+        colorAttachment?.alphaBlendOperation = .add
+        colorAttachment?.sourceRGBBlendFactor = .one
+        colorAttachment?.sourceAlphaBlendFactor = .one
+        colorAttachment?.destinationRGBBlendFactor = .oneMinusSourceAlpha
+        colorAttachment?.destinationAlphaBlendFactor = .oneMinusSourceAlpha
+
+        pipelineDescriptor.depthAttachmentPixelFormat = depthFormat
+        pipelineDescriptor.maxVertexAmplificationCount = maxViewCount
+        compositePipeline = try device.makeRenderPipelineState(descriptor: pipelineDescriptor)
+
+        let depthStateDescriptor = MTLDepthStencilDescriptor()
+        depthStateDescriptor.depthCompareFunction = .always
+        depthStateDescriptor.isDepthWriteEnabled = false
+        guard let depthState = device.makeDepthStencilState(descriptor: depthStateDescriptor) else {
+            throw SplatRendererError.failedToCreateDepthStencilState
+        }
+        compositeDepthState = depthState
+
+        let counterLength = MemoryLayout<UInt32>.stride
+        guard let counter = device.makeBuffer(length: counterLength, options: .storageModePrivate) else {
+            throw SplatRendererError.failedToCreateBuffer(length: counterLength)
+        }
+        counter.label = "TileRaster Entry Count"
+        entryCountBuffer = counter
+
+        let dispatchLength = 3 * MemoryLayout<UInt32>.stride
+        guard let dispatchArguments = device.makeBuffer(length: dispatchLength, options: .storageModePrivate) else {
+            throw SplatRendererError.failedToCreateBuffer(length: dispatchLength)
+        }
+        dispatchArguments.label = "TileRaster Range Dispatch Arguments"
+        dispatchArgumentsBuffer = dispatchArguments
+
+        readbackSlotCount = max(maxSimultaneousRenders, 1)
+        let readbackLength = counterLength * readbackSlotCount
+        guard let readback = device.makeBuffer(length: readbackLength, options: .storageModeShared) else {
+            throw SplatRendererError.failedToCreateBuffer(length: readbackLength)
+        }
+        readback.label = "TileRaster Entry Count Readback"
+        entryCountReadbackBuffer = readback
+
+        Self.log.info("TileRasterizer initialized (\(Self.tileSize)x\(Self.tileSize) tiles)")
+    }
+
+    // MARK: - Sizing
+
+    static func tileCount(screenSize: SIMD2<Int>) -> SIMD2<Int> {
+        SIMD2((screenSize.x + tileSize - 1) / tileSize, (screenSize.y + tileSize - 1) / tileSize)
+    }
+
+    /// Key bits left for depth, or nil if the tile IDs (plus the reserved empty-key tile) don't fit
+    static func depthBits(tileCount: Int) -> Int? {
+        var tileBits = 1
+        while (1 << tileBits) < tileCount + 1 {
+            tileBits += 1
+        }
+        let depthBits = 32 - tileBits
+        return depthBits >= minimumDepthBits ? depthBits : nil
+    }
+
+    /// Key slots for the next frame: the last observed entry count plus a quarter, at least a few per splat
+    static func entryCapacity(splatCount: Int, lastEntryCount: Int, maximum: Int) -> Int {
+        let estimate = max(splatCount * minimumEntriesPerSplat, lastEntryCount + lastEntryCount / 4)
+        // Whole scatter threadgroups, so the radix passes never see a partial trailing group
+        let rounded = (estimate + Metal4Sorter.scatterThreadgroupSize - 1) / Metal4Sorter.scatterThreadgroupSize
+            * Metal4Sorter.scatterThreadgroupSize
+        return max(min(rounded, maximum), 1)
+    }
+
+    /// Tile entries emitted by the last completed frame (including any dropped past the capacity)
+    var lastCompletedEntryCount: Int {
+        os_unfair_lock_lock(&entryCountLock)
+        defer { os_unfair_lock_unlock(&entryCountLock) }
+        return lastEntryCount
+    }
+
+    private func ensureResources(splatCount: Int, entryCapacity: Int, tileCount: Int, screenSize: SIMD2<Int>) throws {
+        let projectedLength = splatCount * Self.projectedSplatStride
+        if projectedBuffer == nil || projectedBuffer!.length < projectedLength {
+            guard let buffer = device.makeBuffer(length: projectedLength, options: .storageModePrivate) else {
+                throw SplatRendererError.failedToCreateBuffer(length: projectedLength)
+            }
+            buffer.label = "TileRaster Projected Splats"
+            projectedBuffer = buffer
+        }
+
+        let entriesLength = entryCapacity * Self.entryStride
+        if entriesBuffer == nil || entriesBuffer!.length < entriesLength {
+            guard let entries = device.makeBuffer(length: entriesLength, options: .storageModePrivate),
+                  let scratch = device.makeBuffer(length: entriesLength, options: .storageModePrivate) else {
+                throw SplatRendererError.failedToCreateBuffer(length: entriesLength)
+            }
+            entries.label = "TileRaster Entries"
+            scratch.label = "TileRaster Entries Scratch"
+            entriesBuffer = entries
+            entriesScratchBuffer = scratch
+        }
+
+        let rangesLength = tileCount * MemoryLayout<SIMD2<UInt32>>.stride
+        if tileRangesBuffer == nil || tileRangesBuffer!.length < rangesLength {
+            guard let buffer = device.makeBuffer(length: rangesLength, options: .storageModePrivate) else {
+                throw SplatRendererError.failedToCreateBuffer(length: rangesLength)
+            }
+            buffer.label = "TileRaster Tile Ranges"
+            tileRangesBuffer = buffer
+        }
+
+        if imageTexture == nil || imageTexture!.width != screenSize.x || imageTexture!.height != screenSize.y {
+            let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .rgba16Float,
+                                                                      width: screenSize.x,
+                                                                      height: screenSize.y,
+                                                                      mipmapped: false)
+            descriptor.usage = [.shaderRead, .shaderWrite]
+            descriptor.storageMode = .private
+            guard let texture = device.makeTexture(descriptor: descriptor) else {
+                throw SplatRendererError.failedToCreateBuffer(length: screenSize.x * screenSize.y * 8)
+            }
+            texture.label = "TileRaster Image"
+            imageTexture = texture
+        }
+    }
+
+    // MARK: - Encoding
+
+    /// Encodes projection, binning, sorting and blending of one view into the tile image.
+    /// - Parameters:
+    ///   - uniformsBuffer: Renderer uniforms; only the first view at `uniformsOffset` is used
+    ///   - screenSize: Viewport size in pixels
+    ///   - frameIndex: Frame ring index, selecting the entry-count readback slot
+    /// - Returns: The slot to pass to `publishEntryCount(readbackSlot:)` once the command buffer completes
+    func encodeRasterization(commandBuffer: MTLCommandBuffer,
+                             splatBuffer: MTLBuffer,
+                             editStateBuffer: MTLBuffer?,
+                             uniformsBuffer: MTLBuffer,
+                             uniformsOffset: Int,
+                             splatCount: Int,
+                             screenSize: SIMD2<Int>,
+                             frameIndex: Int) throws -> Int {
+        let tiles = Self.tileCount(screenSize: screenSize)
+        let tileCount = tiles.x * tiles.y
+        guard splatCount > 0, tileCount > 0, let depthBits = Self.depthBits(tileCount: tileCount) else {
+            throw SplatRendererError.internalPipelineMismatch(expected: "at most \(1 << (32 - Self.minimumDepthBits)) tiles",
+                                                              actual: "\(tiles.x)x\(tiles.y)")
+        }
+        let entryCapacity = Self.entryCapacity(splatCount: splatCount,
+                                               lastEntryCount: lastCompletedEntryCount,
+                                               maximum: maximumEntryCount)
+        try ensureResources(splatCount: splatCount, entryCapacity: entryCapacity, tileCount: tileCount, screenSize: screenSize)
+        guard let projectedBuffer, let entriesBuffer, let entriesScratchBuffer, let tileRangesBuffer, let imageTexture else {
+            throw SplatRendererError.failedToCreateBuffer(length: 0)
+        }
+
+        var params = TileRasterParams(screenSize: SIMD2(UInt32(screenSize.x), UInt32(screenSize.y)),
+                                      tileCount: SIMD2(UInt32(tiles.x), UInt32(tiles.y)),
+                                      splatCount: UInt32(splatCount),
+                                      entryCapacity: UInt32(entryCapacity),
+                                      depthBits: UInt32(depthBits))
+        let readbackSlot = SplatRenderer.visibleCountReadbackSlot(frameIndex: frameIndex, ringSize: readbackSlotCount)
+
+        // Empty key slots sort last; empty tiles keep a [0, 0) range
+        guard let resetBlit = commandBuffer.makeBlitCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        resetBlit.label = "TileRaster Reset"
+        resetBlit.fill(buffer: entriesBuffer, range: 0..<(entryCapacity * Self.entryStride), value: 0xFF)
+        resetBlit.fill(buffer: tileRangesBuffer, range: 0..<(tileCount * MemoryLayout<SIMD2<UInt32>>.stride), value: 0)
+        resetBlit.fill(buffer: entryCountBuffer, range: 0..<MemoryLayout<UInt32>.stride, value: 0)
+        resetBlit.endEncoding()
+
+        guard let projectEncoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        var hasEditStates = editStateBuffer != nil
+        projectEncoder.label = "TileRaster Project"
+        projectEncoder.setComputePipelineState(projectPipeline)
+        projectEncoder.setBuffer(splatBuffer, offset: 0, index: 0)
+        projectEncoder.setBuffer(uniformsBuffer, offset: uniformsOffset, index: 1)
+        projectEncoder.setBytes(&params, length: MemoryLayout<TileRasterParams>.stride, index: 2)
+        projectEncoder.setBuffer(projectedBuffer, offset: 0, index: 3)
+        projectEncoder.setBuffer(entriesBuffer, offset: 0, index: 4)
+        projectEncoder.setBuffer(entryCountBuffer, offset: 0, index: 5)
+        // Not read without edit states; bound so every argument has a buffer
+        projectEncoder.setBuffer(editStateBuffer ?? entryCountBuffer, offset: 0, index: 6)
+        projectEncoder.setBytes(&hasEditStates, length: MemoryLayout<Bool>.size, index: 7)
+        let projectThreads = min(256, projectPipeline.maxTotalThreadsPerThreadgroup)
+        projectEncoder.dispatchThreadgroups(MTLSize(width: (splatCount + projectThreads - 1) / projectThreads, height: 1, depth: 1),
+                                            threadsPerThreadgroup: MTLSize(width: projectThreads, height: 1, depth: 1))
+        projectEncoder.endEncoding()
+
+        try sorter.sortKeys(entriesBuffer, scratch: entriesScratchBuffer, count: entryCapacity, commandBuffer: commandBuffer)
+
+        guard let rangesEncoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        rangesEncoder.label = "TileRaster Ranges"
+        rangesEncoder.setComputePipelineState(prepareDispatchPipeline)
+        rangesEncoder.setBuffer(entryCountBuffer, offset: 0, index: 0)
+        rangesEncoder.setBytes(&params, length: MemoryLayout<TileRasterParams>.stride, index: 1)
+        rangesEncoder.setBuffer(dispatchArgumentsBuffer, offset: 0, index: 2)
+        rangesEncoder.dispatchThreads(MTLSize(width: 1, height: 1, depth: 1),
+                                      threadsPerThreadgroup: MTLSize(width: 1, height: 1, depth: 1))
+
+        // Dispatches in the same encoder are serialized, so the arguments are written before use
+        rangesEncoder.setComputePipelineState(identifyRangesPipeline)
+        rangesEncoder.setBuffer(entriesBuffer, offset: 0, index: 0)
+        rangesEncoder.setBuffer(tileRangesBuffer, offset: 0, index: 1)
+        rangesEncoder.setBytes(&params, length: MemoryLayout<TileRasterParams>.stride, index: 2)
+        rangesEncoder.setBuffer(entryCountBuffer, offset: 0, index: 3)
+        rangesEncoder.dispatchThreadgroups(indirectBuffer: dispatchArgumentsBuffer,
+                                           indirectBufferOffset: 0,
+                                           threadsPerThreadgroup: MTLSize(width: Self.threadsPerTile, height: 1, depth: 1))
+        rangesEncoder.endEncoding()
+
+        guard let blendEncoder = commandBuffer.makeComputeCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        blendEncoder.label = "TileRaster Blend"
+        blendEncoder.setComputePipelineState(blendPipeline)
+        blendEncoder.setBuffer(projectedBuffer, offset: 0, index: 0)
+        blendEncoder.setBuffer(entriesBuffer, offset: 0, index: 1)
+        blendEncoder.setBuffer(tileRangesBuffer, offset: 0, index: 2)
+        blendEncoder.setBytes(&params, length: MemoryLayout<TileRasterParams>.stride, index: 3)
+        blendEncoder.setTexture(imageTexture, index: 0)
+        blendEncoder.dispatchThreadgroups(MTLSize(width: tiles.x, height: tiles.y, depth: 1),
+                                          threadsPerThreadgroup: MTLSize(width: Self.tileSize, height: Self.tileSize, depth: 1))
+        blendEncoder.endEncoding()
+
+        guard let readbackBlit = commandBuffer.makeBlitCommandEncoder() else {
+            throw SplatRendererError.failedToCreateComputeEncoder
+        }
+        readbackBlit.label = "TileRaster Entry Count Readback"
+        readbackBlit.copy(from: entryCountBuffer, sourceOffset: 0,
+                          to: entryCountReadbackBuffer, destinationOffset: readbackSlot,
+                          size: MemoryLayout<UInt32>.stride)
+        readbackBlit.endEncoding()
+
+        return readbackSlot
+    }
+
+    /// Draws the last rasterized image over the encoder's render target
+    func encodeComposite(renderEncoder: MTLRenderCommandEncoder, viewportOrigin: SIMD2<Float>) {
+        guard let imageTexture else { return }
+        var origin = viewportOrigin
+        renderEncoder.pushDebugGroup("Tile Raster Composite")
+        renderEncoder.setRenderPipelineState(compositePipeline)
+        renderEncoder.setDepthStencilState(compositeDepthState)
+        renderEncoder.setCullMode(.none)
+        renderEncoder.setFragmentTexture(imageTexture, index: 0)
+        renderEncoder.setFragmentBytes(&origin, length: MemoryLayout<SIMD2<Float>>.stride, index: 0)
+        renderEncoder.drawPrimitives(type: .triangle, vertexStart: 0, vertexCount: 3)
+        renderEncoder.popDebugGroup()
+    }
+
+    /// Publishes a completed frame's entry count, which sizes later frames' key storage.
+    /// Call from the command buffer's completed handler.
+    func publishEntryCount(readbackSlot: Int) {
+        let count = Int(entryCountReadbackBuffer.contents().load(fromByteOffset: readbackSlot, as: UInt32.self))
+        os_unfair_lock_lock(&entryCountLock)
+        lastEntryCount = count
+        os_unfair_lock_unlock(&entryCountLock)
+    }
+}
@@ -0,0 +1,105 @@
+import XCTest
+import simd
+import SplatIO
+@testable import MetalSplatter
+
+final class BenchmarkReportTests: XCTestCase {
+    typealias Profiler = GPUPerformanceProfiler
+
+    func testStatisticsUseNearestRankPercentilesInMilliseconds() throws {
+        let seconds = (1...100).map { TimeInterval($0) / 1000 }
+        let statistics = try XCTUnwrap(Profiler.BenchmarkStatistics(seconds: seconds.shuffled()))
+
+        XCTAssertEqual(statistics.count, 100)
+        XCTAssertEqual(statistics.min, 1, accuracy: 1e-9)
+        XCTAssertEqual(statistics.max, 100, accuracy: 1e-9)
+        XCTAssertEqual(statistics.mean, 50.5, accuracy: 1e-9)
+        XCTAssertEqual(statistics.p50, 50, accuracy: 1e-9)
+        XCTAssertEqual(statistics.p90, 90, accuracy: 1e-9)
+        XCTAssertEqual(statistics.p99, 99, accuracy: 1e-9)
+
+        XCTAssertNil(Profiler.BenchmarkStatistics(seconds: []))
+        let single = try XCTUnwrap(Profiler.BenchmarkStatistics(seconds: [0.004]))
+        XCTAssertEqual(single.p99, 4, accuracy: 1e-9)
+    }
+
+    func testCameraPathsStayFramedOnTheScene() {
+        let center = SIMD3<Float>(1, 2, 3)
+        let radius: Float = 5
+
+        let orbit = Profiler.BenchmarkCameraPath(kind: .orbit, frameCount: 36)
+        for frame in 0..<36 {
+            let offset = orbit.eye(frame: frame, center: center, radius: radius) - center
+            XCTAssertEqual(simd_length(SIMD2(offset.x, offset.z)), 2 * radius, accuracy: 1e-3)
+        }
+
+        let dolly = Profiler.BenchmarkCameraPath(kind: .dolly, frameCount: 10)
+        let distances = (0..<10).map { simd_distance(dolly.eye(frame: $0, center: center, radius: radius), center) }
+        XCTAssertEqual(distances, distances.sorted(by: >))
+        XCTAssertLessThan(distances.last!, radius)
+
+        let jitter = Profiler.BenchmarkCameraPath(kind: .jitter, frameCount: 10)
+        let rest = center + SIMD3(0, 0, 2 * radius)
+        for frame in 0..<10 {
+            XCTAssertLessThan(simd_distance(jitter.eye(frame: frame, center: center, radius: radius), rest), 0.01 * radius)
+        }
+    }
+
+    func testLookAtAndPerspectivePlaceTheTargetAtScreenCenter() {
+        let eye = SIMD3<Float>(3, 1, 4)
+        let target = SIMD3<Float>(0, 0, 0)
+        let view = Profiler.lookAt(eye: eye, target: target, up: SIMD3(0, 1, 0))
+        let projection = Profiler.perspective(fovY: .pi / 3, aspect: 16 / 9, near: 0.1, far: 100)
+
+        let viewSpace = view * SIMD4(target, 1)
+        XCTAssertEqual(viewSpace.z, -simd_length(eye), accuracy: 1e-4)
+
+        let clip = projection * viewSpace
+        XCTAssertEqual(clip.x / clip.w, 0, accuracy: 1e-4)
+        XCTAssertEqual(clip.y / clip.w, 0, accuracy: 1e-4)
+        XCTAssertGreaterThan(clip.z / clip.w, 0)
+        XCTAssertLessThan(clip.z / clip.w, 1)
+    }
+
+    func testSubsampleKeepsRequestedCountAndFullSceneAboveIt() {
+        let points = (0..<1000).map { index in
+            SplatScenePoint(position: SIMD3(Float(index), 0, 0),
+                            color: .linearFloat(SIMD3<Float>(repeating: 1)),
+                            opacity: .linearFloat(1),
+                            scale: .linearFloat(SIMD3(repeating: 1)),
+                            rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1))
+        }
+        XCTAssertEqual(Profiler.subsample(points, to: 100).count, 100)
+        XCTAssertEqual(Profiler.subsample(points, to: 5000).count, 1000)
+
+        let (center, radius) = Profiler.bounds(of: points)
+        XCTAssertEqual(center.x, 499.5, accuracy: 1e-3)
+        XCTAssertEqual(radius, 499.5, accuracy: 1e-3)
+    }
+
+    func testReportEncodesAsDiffableJSON() throws {
+        let result = Profiler.BenchmarkResult(scene: "skull.sog", splatCount: 10, sortPath: .counting,
+                                              renderPath: .meshShader, cameraPath: .orbit, frameCount: 0,
+                                              skippedReason: "mesh shaders unsupported",
+                                              gpuFrameTime: nil, cpuEncodeTime: nil, sortLatency: nil, sortGPUTime: nil,
+                                              observedSortPaths: [], memory: nil)
+        let report = Profiler.BenchmarkReport(deviceName: "Test", operatingSystem: "Test OS",
+                                              date: Date(timeIntervalSince1970: 0), resolution: [1280, 720],
+                                              results: [result])
+        let json = try XCTUnwrap(String(data: report.jsonData(), encoding: .utf8))
+        XCTAssertTrue(json.contains("\"date\" : \"1970-01-01T00:00:00Z\""))
+        XCTAssertTrue(json.contains("\"renderPath\" : \"meshShader\""))
+        XCTAssertTrue(json.contains("\"skippedReason\" : \"mesh shaders unsupported\""))
+
+        let decoded = try JSONDecoder.iso8601.decode(Profiler.BenchmarkReport.self, from: report.jsonData())
+        XCTAssertEqual(decoded.results.first?.sortPath, .counting)
+    }
+}
+
+private extension JSONDecoder {
+    static var iso8601: JSONDecoder {
+        let decoder = JSONDecoder()
+        decoder.dateDecodingStrategy = .iso8601
+        return decoder
+    }
+}
@@ -0,0 +1,118 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class FoveationTests: XCTestCase {
+    func testDensityRatesKeepBusyZonesAndTheirNeighboursAtFullRate() {
+        var counts = [Float](repeating: 0, count: 16)
+        counts[7] = 100
+        counts[8] = 40
+        counts[12] = 10
+
+        let rates = SplatRenderer.foveationRates(zoneCounts: counts, minimumRate: 0.25)
+        XCTAssertEqual(rates.count, 16)
+        XCTAssertEqual(rates[7], 1)
+        XCTAssertEqual(rates[8], 1)
+        XCTAssertEqual(rates[6], 1, "neighbours take the rate of a busy zone")
+        XCTAssertEqual(rates[9], 1)
+        XCTAssertEqual(rates[12], 0.25 + 0.75 * 0.4, accuracy: 1e-6)
+        XCTAssertEqual(rates[0], 0.25)
+        XCTAssertEqual(rates[15], 0.25)
+
+        XCTAssertEqual(SplatRenderer.foveationRates(zoneCounts: [0, 0], minimumRate: 0.5), [0.5, 0.5])
+    }
+
+    func testRatesPackIntoUniformWords() {
+        let horizontal = (0..<16).map { Float($0 + 1) / 16 }
+        let vertical = [Float](repeating: 0.5, count: 16)
+        let rates = SplatRenderer.FoveationRates(horizontal: horizontal, vertical: vertical)
+        for zone in 0..<16 {
+            XCTAssertEqual(SplatRenderer.FoveationRates.rate(rates.horizontal, zone: zone), horizontal[zone], accuracy: 1 / 255)
+            XCTAssertEqual(SplatRenderer.FoveationRates.rate(rates.vertical, zone: zone), 0.5, accuracy: 1 / 255)
+        }
+
+        let viewport = SplatRenderer.ViewportDescriptor(
+            viewport: MTLViewport(originX: 0, originY: 0, width: 64, height: 64, znear: 0, zfar: 1),
+            projectionMatrix: matrix_identity_float4x4,
+            viewMatrix: matrix_identity_float4x4,
+            screenSize: SIMD2(64, 64))
+        let foveated = SplatRenderer.makeUniforms(for: viewport, splatCount: 1, indexedSplatCount: 1, debugFlags: 0,
+                                                  renderMode: .standard, covarianceBlur: 0.3, lodThresholds: .zero,
+                                                  foveationRates: rates)
+        XCTAssertEqual(foveated.foveationEnabled, 1)
+        XCTAssertEqual(foveated.foveationRatesX, rates.horizontal)
+        let unfoveated = SplatRenderer.makeUniforms(for: viewport, splatCount: 1, indexedSplatCount: 1, debugFlags: 0,
+                                                    renderMode: .standard, covarianceBlur: 0.3, lodThresholds: .zero)
+        XCTAssertEqual(unfoveated.foveationEnabled, 0)
+    }
+
+    func testDensityRateMapShadesSparseRegionsAtLowerRate() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        guard renderer.supportsFoveatedRendering else {
+            throw XCTSkip("Rasterization rate maps unsupported")
+        }
+        // A small cluster in front of the camera; the rest of the frame is empty
+        try renderer.add(TestScenes.grid(side: 16, spacing: 0.01, origin: SIMD3(-0.08, -0.08, -2), opacity: 0.5, scale: 0.01))
+        let viewport = SplatRenderer.ViewportDescriptor(
+            viewport: MTLViewport(originX: 0, originY: 0, width: 512, height: 512, znear: 0, zfar: 1),
+            projectionMatrix: GPUPerformanceProfiler.perspective(fovY: .pi / 3, aspect: 1, near: 0.1, far: 100),
+            viewMatrix: matrix_identity_float4x4,
+            screenSize: SIMD2(512, 512))
+
+        let rateMap = try XCTUnwrap(renderer.makeSplatDensityRateMap(for: viewport))
+        let physicalSize = rateMap.physicalSize(layer: 0)
+        XCTAssertLessThan(physicalSize.width, 512)
+        XCTAssertLessThan(physicalSize.height, 512)
+        XCTAssertTrue(renderer.makeSplatDensityRateMap(for: viewport) === rateMap, "an unmoved camera reuses the map")
+
+        let rates = SplatRenderer.FoveationRates(rateMap, layer: 0)
+        let center = SplatRenderer.FoveationRates.rate(rates.horizontal, zone: 8)
+        let edge = SplatRenderer.FoveationRates.rate(rates.horizontal, zone: 0)
+        XCTAssertGreaterThan(center, edge)
+
+        renderer.foveationMinimumRate = 1
+        XCTAssertNil(renderer.makeSplatDensityRateMap(for: viewport))
+    }
+
+    func testFoveatedTargetsAreScreenSizeAndOutliveMapRebuilds() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        guard renderer.supportsFoveatedRendering else {
+            throw XCTSkip("Rasterization rate maps unsupported")
+        }
+        try renderer.add(TestScenes.grid(side: 16, spacing: 0.01, origin: SIMD3(-0.3, 0, -2), opacity: 0.5, scale: 0.01))
+        renderer.foveationRebuildInterval = 0
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .bgra8Unorm, width: 512, height: 512, mipmapped: false)
+        descriptor.usage = [.renderTarget, .shaderRead]
+        descriptor.storageMode = .private
+        let colorTexture = try XCTUnwrap(renderer.device.makeTexture(descriptor: descriptor))
+        let commandQueue = try XCTUnwrap(renderer.device.makeCommandQueue())
+
+        func renderFoveated(cameraX: Float) throws -> MTLRasterizationRateMap? {
+            var viewMatrix = matrix_identity_float4x4
+            viewMatrix.columns.3.x = cameraX
+            let viewport = SplatRenderer.ViewportDescriptor(
+                viewport: MTLViewport(originX: 0, originY: 0, width: 512, height: 512, znear: 0, zfar: 1),
+                projectionMatrix: GPUPerformanceProfiler.perspective(fovY: .pi / 3, aspect: 1, near: 0.1, far: 100),
+                viewMatrix: viewMatrix,
+                screenSize: SIMD2(512, 512))
+            let commandBuffer = try XCTUnwrap(commandQueue.makeCommandBuffer())
+            try renderer.renderFoveated(viewport: viewport, colorTexture: colorTexture, colorStoreAction: .store, to: commandBuffer)
+            commandBuffer.commit()
+            commandBuffer.waitUntilCompleted()
+            XCTAssertNil(commandBuffer.error)
+            return renderer.foveationCache?.rateMap
+        }
+
+        let firstMap = try XCTUnwrap(try renderFoveated(cameraX: 0))
+        let firstTarget = try XCTUnwrap(renderer.foveationCache?.colorTexture)
+        XCTAssertEqual(firstTarget.width, 512)
+        XCTAssertEqual(firstTarget.height, 512)
+
+        // Moving the cluster across the frame reshapes the map; the targets stay
+        let secondMap = try XCTUnwrap(try renderFoveated(cameraX: 0.6))
+        XCTAssertFalse(secondMap === firstMap)
+        XCTAssertTrue(renderer.foveationCache?.colorTexture === firstTarget)
+    }
+}
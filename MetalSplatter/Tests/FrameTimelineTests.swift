@@ -0,0 +1,87 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class FrameTimelineTests: XCTestCase {
+    func testStageDurationsAreSummedPerStage() {
+        var timeline = FrameTimeline(frameIndex: 1)
+        XCTAssertNil(timeline.gpuSpan)
+
+        timeline.passes = [
+            FrameTimeline.Pass(stage: .cull, start: 1.000, end: 1.001),
+            FrameTimeline.Pass(stage: .cull, start: 1.001, end: 1.003),
+            FrameTimeline.Pass(stage: .draw, start: 1.004, end: 1.010),
+        ]
+        XCTAssertEqual(timeline.gpuDuration(of: .cull), 0.003, accuracy: 1e-9)
+        XCTAssertEqual(timeline.gpuDuration(of: .draw), 0.006, accuracy: 1e-9)
+        XCTAssertEqual(timeline.gpuDuration(of: .sortPasses), 0)
+        XCTAssertEqual(try XCTUnwrap(timeline.gpuSpan), 0.010, accuracy: 1e-9)
+    }
+
+    func testDisabledTimelineHasNoRecorder() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        XCTAssertNil(renderer.frameTimelineRecorder)
+        XCTAssertTrue(renderer.recentFrameTimelines().isEmpty)
+
+        renderer.frameTimelineEnabled = true
+        renderer.frameTimelineEnabled = false
+        XCTAssertNil(renderer.frameTimelineRecorder)
+    }
+
+    func testEnabledTimelineKeepsRecentFramesWithDrawPasses() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        renderer.frameTimelineCapacity = 3
+        renderer.frameTimelineEnabled = true
+        guard renderer.frameTimelineRecorder != nil else {
+            throw XCTSkip("Stage-boundary counter sampling unavailable")
+        }
+
+        try renderer.add((0..<64).map { index in
+            SplatScenePoint(position: SIMD3<Float>(Float(index % 8) * 0.1, Float(index / 8) * 0.1, -2),
+                            color: .linearFloat(SIMD3<Float>(repeating: 0.5)),
+                            opacity: .linearFloat(0.5),
+                            scale: .linearFloat(SIMD3<Float>(repeating: 0.05)),
+                            rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1))
+        })
+
+        let device = renderer.device
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .bgra8Unorm, width: 64, height: 64, mipmapped: false)
+        descriptor.usage = .renderTarget
+        descriptor.storageMode = .private
+        let colorTexture = try XCTUnwrap(device.makeTexture(descriptor: descriptor))
+        let queue = try XCTUnwrap(device.makeCommandQueue())
+        let viewport = SplatRenderer.ViewportDescriptor(
+            viewport: MTLViewport(originX: 0, originY: 0, width: 64, height: 64, znear: 0, zfar: 1),
+            projectionMatrix: matrix_identity_float4x4,
+            viewMatrix: matrix_identity_float4x4,
+            screenSize: SIMD2(64, 64))
+
+        for _ in 0..<5 {
+            let commandBuffer = try XCTUnwrap(queue.makeCommandBuffer())
+            try renderer.render(viewports: [viewport],
+                                colorTexture: colorTexture,
+                                colorStoreAction: .store,
+                                depthTexture: nil,
+                                rasterizationRateMap: nil,
+                                renderTargetArrayLength: 0,
+                                to: commandBuffer)
+            commandBuffer.commit()
+            commandBuffer.waitUntilCompleted()
+        }
+
+        // Completed handlers may still be running right after waitUntilCompleted returns
+        let deadline = Date().addingTimeInterval(2)
+        while renderer.recentFrameTimelines().last?.passes.isEmpty ?? true, Date() < deadline {
+            Thread.sleep(forTimeInterval: 0.01)
+        }
+
+        let frames = renderer.recentFrameTimelines()
+        XCTAssertEqual(frames.map(\.frameIndex), [3, 4, 5])
+        XCTAssertTrue(frames.allSatisfy { $0.cpuEncodeDuration != nil })
+        let last = try XCTUnwrap(frames.last)
+        XCTAssertGreaterThan(last.gpuDuration(of: .draw), 0)
+        XCTAssertTrue(last.passes.allSatisfy { $0.end >= $0.start })
+    }
+}
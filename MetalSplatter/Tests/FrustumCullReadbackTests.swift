@@ -0,0 +1,16 @@
+import XCTest
+@testable import MetalSplatter
+
+final class FrustumCullReadbackTests: XCTestCase {
+    func testReadbackSlotsFollowTheFrameRing() {
+        let stride = MemoryLayout<UInt32>.stride
+        XCTAssertEqual(SplatRenderer.visibleCountReadbackSlot(frameIndex: 0, ringSize: 3), 0)
+        XCTAssertEqual(SplatRenderer.visibleCountReadbackSlot(frameIndex: 2, ringSize: 3), 2 * stride)
+        XCTAssertEqual(SplatRenderer.visibleCountReadbackSlot(frameIndex: 3, ringSize: 3), 0)
+    }
+
+    func testSingleFrameRingReusesOneSlot() {
+        XCTAssertEqual(SplatRenderer.visibleCountReadbackSlot(frameIndex: 5, ringSize: 1), 0)
+        XCTAssertEqual(SplatRenderer.visibleCountReadbackSlot(frameIndex: 5, ringSize: 0), 0)
+    }
+}
@@ -0,0 +1,110 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class GPUDequantizationTests: XCTestCase {
+    func testParameterLayoutsMatchShaderStructs() {
+        XCTAssertEqual(MemoryLayout<GPUDequantizer.SOGV2Params>.stride, 48)
+        XCTAssertEqual(MemoryLayout<GPUDequantizer.SPZParams>.stride, 16)
+    }
+
+    func testShortCodebooksArePaddedWithZeros() {
+        let padded = GPUDequantizer.paddedCodebook([1, 2, 3])
+        XCTAssertEqual(padded.count, GPUDequantizer.sogCodebookLength)
+        XCTAssertEqual(Array(padded.prefix(4)), [1, 2, 3, 0])
+        XCTAssertEqual(GPUDequantizer.paddedCodebook([Float](repeating: 1, count: 300)).count, GPUDequantizer.sogCodebookLength)
+    }
+
+    func testGPUDequantizedSPZMatchesCPUReader() async throws {
+        let gpuRenderer = try makeRendererOrSkip()
+        let cpuRenderer = try makeRendererOrSkip()
+
+        let points = (0..<64).map { index in
+            let t = Float(index)
+            return SplatScenePoint(position: SIMD3<Float>(sin(t) * 3, cos(t * 0.7) * 2, t * 0.05 - 1),
+                                   color: .linearFloat(SIMD3<Float>(0.2 + 0.01 * t, 0.5, 0.9 - 0.01 * t)),
+                                   opacity: .linearFloat(0.1 + 0.012 * t),
+                                   scale: .linearFloat(SIMD3<Float>(0.05, 0.1, 0.02 + 0.001 * t)),
+                                   rotation: simd_quatf(angle: t * 0.3, axis: simd_normalize(SIMD3<Float>(1, t, 2))))
+        }
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("gpu-dequantization-\(UUID().uuidString).spz")
+        defer { try? FileManager.default.removeItem(at: url) }
+        try SPZSceneWriter(useFloat16: false, fractionalBits: 12, compress: false).writeScene(points, to: url)
+
+        gpuRenderer.gpuDequantizationEnabled = true
+        try await gpuRenderer.read(from: url)
+        cpuRenderer.mortonOrderingEnabled = false
+        try await cpuRenderer.read(from: url)
+
+        XCTAssertNotNil(gpuRenderer.gpuDequantizer, "SPZ should load through the GPU kernel")
+        XCTAssertTrue(gpuRenderer.sourceScenePoints.isEmpty, "Scene points are only rebuilt on demand")
+        XCTAssertEqual(gpuRenderer.splatBuffer.count, cpuRenderer.splatBuffer.count)
+        for index in 0..<min(gpuRenderer.splatBuffer.count, cpuRenderer.splatBuffer.count) {
+            let actual = gpuRenderer.splatBuffer.values[index]
+            let expected = cpuRenderer.splatBuffer.values[index]
+            XCTAssertEqual(actual.position.x, expected.position.x, accuracy: 1e-4, "x[\(index)]")
+            XCTAssertEqual(actual.position.y, expected.position.y, accuracy: 1e-4, "y[\(index)]")
+            XCTAssertEqual(actual.position.z, expected.position.z, accuracy: 1e-4, "z[\(index)]")
+            XCTAssertEqual(Float(actual.covA.x), Float(expected.covA.x), accuracy: 1e-3, "covA[\(index)]")
+            XCTAssertEqual(Float(actual.covB.z), Float(expected.covB.z), accuracy: 1e-3, "covB[\(index)]")
+            for shift in stride(from: 0, to: 32, by: 8) {
+                let difference = abs(Int((actual.packedColor >> shift) & 0xFF) - Int((expected.packedColor >> shift) & 0xFF))
+                XCTAssertLessThanOrEqual(difference, 1, "color[\(index)] byte \(shift / 8)")
+            }
+        }
+    }
+
+    func testGPUDequantizedSOGV2MatchesCPUReader() async throws {
+        let gpuRenderer = try makeRendererOrSkip()
+        let cpuRenderer = try makeRendererOrSkip()
+
+        // Degree-1 harmonics, so the bundle carries shN textures alongside the DC term
+        let points = (0..<64).map { index in
+            let t = Float(index)
+            let dc = SIMD3<Float>(0.2 + 0.01 * t, -0.3 + 0.005 * t, 0.6 - 0.01 * t)
+            let band1 = [SIMD3<Float>(0.1, -0.05, 0.02) * sin(t),
+                         SIMD3<Float>(-0.08, 0.04, 0.1) * cos(t),
+                         SIMD3<Float>(0.03, 0.06, -0.09)]
+            return SplatScenePoint(position: SIMD3<Float>(sin(t) * 3, cos(t * 0.7) * 2, t * 0.05 - 1),
+                                   color: .sphericalHarmonic([dc] + band1),
+                                   opacity: .linearFloat(0.1 + 0.012 * t),
+                                   scale: .linearFloat(SIMD3<Float>(0.05, 0.1, 0.02 + 0.001 * t)),
+                                   rotation: simd_quatf(angle: t * 0.3, axis: simd_normalize(SIMD3<Float>(1, t, 2))))
+        }
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("gpu-dequantization-\(UUID().uuidString).sog")
+        defer { try? FileManager.default.removeItem(at: url) }
+        try SOGSV2SceneWriter().writeScene(points, to: url)
+        XCTAssertTrue(try SplatSOGSSceneReaderV2(url).readCompressedData().hasSphericalHarmonics)
+
+        gpuRenderer.gpuDequantizationEnabled = true
+        try await gpuRenderer.read(from: url)
+        cpuRenderer.mortonOrderingEnabled = false
+        try await cpuRenderer.read(from: url)
+
+        XCTAssertNotNil(gpuRenderer.gpuDequantizer, "SOG v2 should load through the GPU kernel")
+        XCTAssertTrue(gpuRenderer.sourceScenePoints.isEmpty, "Scene points are only rebuilt on demand")
+        XCTAssertEqual(gpuRenderer.splatBuffer.count, cpuRenderer.splatBuffer.count)
+        for index in 0..<min(gpuRenderer.splatBuffer.count, cpuRenderer.splatBuffer.count) {
+            let actual = gpuRenderer.splatBuffer.values[index]
+            let expected = cpuRenderer.splatBuffer.values[index]
+            XCTAssertEqual(actual.position.x, expected.position.x, accuracy: 1e-4, "x[\(index)]")
+            XCTAssertEqual(actual.position.y, expected.position.y, accuracy: 1e-4, "y[\(index)]")
+            XCTAssertEqual(actual.position.z, expected.position.z, accuracy: 1e-4, "z[\(index)]")
+            // The covariance carries both the scale codebook lookup and the quaternion decode
+            let components: [(name: String, keyPath: KeyPath<SplatRenderer.PackedHalf3, Float16>)] = [("x", \.x), ("y", \.y), ("z", \.z)]
+            for component in components {
+                XCTAssertEqual(Float(actual.covA[keyPath: component.keyPath]), Float(expected.covA[keyPath: component.keyPath]),
+                               accuracy: 1e-3, "covA.\(component.name)[\(index)]")
+                XCTAssertEqual(Float(actual.covB[keyPath: component.keyPath]), Float(expected.covB[keyPath: component.keyPath]),
+                               accuracy: 1e-3, "covB.\(component.name)[\(index)]")
+            }
+            // Color is the SH0 codebook lookup; higher bands are dropped by both paths, which shade with the DC term
+            for shift in stride(from: 0, to: 32, by: 8) {
+                let difference = abs(Int((actual.packedColor >> shift) & 0xFF) - Int((expected.packedColor >> shift) & 0xFF))
+                XCTAssertLessThanOrEqual(difference, 1, "color[\(index)] byte \(shift / 8)")
+            }
+        }
+    }
+}
@@ -0,0 +1,154 @@
+import XCTest
+import Metal
+import simd
+import SplatIO
+@testable import MetalSplatter
+
+final class GPULODHierarchyTests: XCTestCase {
+    private func node(parent: Int?, error: Float = 1) -> SplatRenderer.LODNode {
+        SplatRenderer.LODNode(bounds: AABB(min: SIMD3(repeating: -1), max: SIMD3(repeating: 1)),
+                              parentIndex: parent,
+                              geometricError: error)
+    }
+
+    func testFlagsReflectChildrenAndSplats() throws {
+        // Root without its own splats, two children, one of which holds all the splats
+        let gpuNodes = try GPULODSelector.makeGPUNodes([node(parent: nil), node(parent: 0), node(parent: 0)],
+                                                       splatNodeIndices: [1, 1, 1])
+        let flags = gpuNodes.map { GPULODSelector.NodeFlags(rawValue: $0.flags) }
+        XCTAssertEqual(flags[0], [])
+        XCTAssertEqual(flags[1], [.leaf, .hasSplats])
+        XCTAssertEqual(flags[2], [.leaf])
+    }
+
+    func testRootsEncodeParentAsMinusOne() throws {
+        let gpuNodes = try GPULODSelector.makeGPUNodes([node(parent: nil, error: 4), node(parent: 0)],
+                                                       splatNodeIndices: [0, 1])
+        XCTAssertEqual(gpuNodes[0].splatAncestorIndex, -1)
+        XCTAssertEqual(gpuNodes[1].splatAncestorIndex, 0)
+        XCTAssertEqual(gpuNodes[0].boundsMin.w, 4)
+    }
+
+    func testAncestorsSkipNodesWithoutSplats() throws {
+        // Root with splats, an empty intermediate node, and a leaf under it; a root-level sibling without splats
+        let gpuNodes = try GPULODSelector.makeGPUNodes([node(parent: nil), node(parent: 0), node(parent: 1), node(parent: 3),
+                                                        node(parent: nil)],
+                                                       splatNodeIndices: [0, 2, 3])
+        XCTAssertEqual(gpuNodes.map(\.splatAncestorIndex), [-1, 0, 0, -1, -1])
+    }
+
+    func testRejectsParentCycles() {
+        XCTAssertThrowsError(try GPULODSelector.makeGPUNodes([node(parent: nil), node(parent: 2), node(parent: 1)],
+                                                             splatNodeIndices: [0])) { error in
+            guard case SplatRenderer.LODHierarchyError.invalidParentIndex = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+
+    func testOverlappingRangesGoToTheDeepestNode() {
+        func octreeNode(_ id: String, parent: String?, depth: Int, range: Range<Int>) -> OctreeNode {
+            OctreeNode(id: id,
+                       bounds: AABB(min: SIMD3(repeating: -1), max: SIMD3(repeating: 1)),
+                       lodLevels: [OctreeLODLevel(splatRange: range, splatCount: range.count, level: 0, screenSpaceErrorThreshold: 1)],
+                       parentID: parent,
+                       depth: depth)
+        }
+        // "a" is the deepest node; "b" and "c" overlap at equal depth, where "b" comes first by ID
+        let nodes = [
+            "0": octreeNode("0", parent: nil, depth: 0, range: 0..<8),
+            "a": octreeNode("a", parent: "0", depth: 2, range: 2..<4),
+            "b": octreeNode("b", parent: "0", depth: 1, range: 3..<6),
+            "c": octreeNode("c", parent: "0", depth: 1, range: 5..<7)
+        ]
+        let header = OctreeSceneHeader(nodeCount: nodes.count, totalSplatCount: 10, lodLevelCount: 1, rootNodeID: "0",
+                                       sceneBounds: AABB(min: SIMD3(repeating: -1), max: SIMD3(repeating: 1)), maxDepth: 2)
+        let octree = SplatOctree(scene: OctreeScene(header: header, nodes: nodes))
+
+        let hierarchy = octree.gpuLODHierarchy(splatCount: 10)
+        // Nodes are indexed in ID order: 0, a, b, c
+        XCTAssertEqual(hierarchy.splatNodeIndices, [0, 0, 1, 1, 2, 2, 3, 0, 0, 0])
+        XCTAssertEqual(hierarchy.nodes.map(\.parentIndex), [nil, 0, 0, 0])
+    }
+
+    func testSelectionDrawsEachRegionFromOneNode() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        // Load order: the root's eight splats interleaved with eight of a leaf under an empty intermediate node,
+        // spread out so Morton ordering shuffles them
+        let points = (0..<16).map { index in
+            SplatScenePoint(position: SIMD3<Float>(Float(index % 4) * 0.2 - 0.3, Float(index / 4) * 0.2 - 0.3, 0.5),
+                            color: .linearFloat(SIMD3<Float>(repeating: 0.5)),
+                            opacity: .linearFloat(0.8),
+                            scale: .linearFloat(SIMD3<Float>(repeating: 0.01)),
+                            rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1))
+        }
+        try renderer.add(points)
+        XCTAssertNotNil(renderer.mortonPermutation)
+
+        let bounds = AABB(min: SIMD3(-0.5, -0.5, 0.1), max: SIMD3(0.5, 0.5, 0.9))
+        let nodes = [SplatRenderer.LODNode(bounds: bounds, parentIndex: nil, geometricError: 1),
+                     SplatRenderer.LODNode(bounds: bounds, parentIndex: 0, geometricError: 0.5),
+                     SplatRenderer.LODNode(bounds: bounds, parentIndex: 1, geometricError: 0.25)]
+        let loadOrderNodes = (0..<16).map { UInt32($0 % 2 == 0 ? 0 : 2) }
+        try renderer.setLODHierarchy(nodes: nodes, splatNodeIndices: loadOrderNodes)
+        let selector = try XCTUnwrap(renderer.lodSelector)
+
+        // A coarse cut draws only the root, a fine one only the leaf
+        for (maxError, drawnNode) in [(Float(1000), UInt32(0)), (Float(0.001), UInt32(2))] {
+            let params = GPULODSelector.LODCullParams(viewProjectionMatrix: matrix_identity_float4x4,
+                                                      cameraPosition: SIMD4(0, 0, -10, 100),
+                                                      maxScreenSpaceError: maxError,
+                                                      frustumMargin: 0.1,
+                                                      nodeCount: 0,
+                                                      splatCount: UInt32(points.count))
+            let mask = try sortMask(selector, renderer: renderer, params: params)
+            var drawnLoadOrder: [Int] = []
+            for index in 0..<points.count where mask[index] == 0 {
+                drawnLoadOrder.append(renderer.originalIndex(ofSplatAt: index))
+            }
+            XCTAssertEqual(drawnLoadOrder.sorted(), (0..<16).filter { loadOrderNodes[$0] == drawnNode },
+                           "maxScreenSpaceError \(maxError)")
+            XCTAssertEqual(selector.lastSurvivorCount, 8)
+        }
+    }
+
+    // MARK: - Helpers
+
+    /// Runs node selection and splat culling, returning a copy of the per-splat sort mask
+    private func sortMask(_ selector: GPULODSelector, renderer: SplatRenderer,
+                          params: GPULODSelector.LODCullParams) throws -> [UInt8] {
+        let count = Int(params.splatCount)
+        let commandQueue = try XCTUnwrap(renderer.device.makeCommandQueue())
+        let commandBuffer = try XCTUnwrap(commandQueue.makeCommandBuffer())
+        let mask = try selector.encodeSelection(commandBuffer: commandBuffer,
+                                                splatBuffer: renderer.splatBuffer.buffer,
+                                                editStateBuffer: nil,
+                                                params: params)
+        let readback = try XCTUnwrap(renderer.device.makeBuffer(length: count, options: .storageModeShared))
+        let blit = try XCTUnwrap(commandBuffer.makeBlitCommandEncoder())
+        blit.copy(from: mask, sourceOffset: 0, to: readback, destinationOffset: 0, size: count)
+        blit.endEncoding()
+        commandBuffer.commit()
+        commandBuffer.waitUntilCompleted()
+        XCTAssertEqual(commandBuffer.status, .completed)
+        return Array(UnsafeBufferPointer(start: readback.contents().bindMemory(to: UInt8.self, capacity: count), count: count))
+    }
+
+    func testRejectsInvalidParentIndex() {
+        XCTAssertThrowsError(try GPULODSelector.makeGPUNodes([node(parent: nil), node(parent: 5)],
+                                                             splatNodeIndices: [0])) { error in
+            guard case SplatRenderer.LODHierarchyError.invalidParentIndex(node: 1, parent: 5) = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+        XCTAssertThrowsError(try GPULODSelector.makeGPUNodes([node(parent: 0)], splatNodeIndices: [0]))
+    }
+
+    func testRejectsSplatsReferencingMissingNodes() {
+        XCTAssertThrowsError(try GPULODSelector.makeGPUNodes([node(parent: nil)], splatNodeIndices: [0, 2])) { error in
+            guard case SplatRenderer.LODHierarchyError.invalidNodeIndex(splat: 1, node: 2) = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+    }
+}
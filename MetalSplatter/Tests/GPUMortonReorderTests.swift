@@ -0,0 +1,213 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class GPUMortonReorderTests: XCTestCase {
+    func testLayoutsMatchShaderStructs() {
+        XCTAssertEqual(MemoryLayout<GPUMortonReorderer.MortonCode>.stride, 8)
+        XCTAssertEqual(MemoryLayout<GPUMortonReorderer.GatherParameters>.stride, 8)
+    }
+
+    func testCPUSortIsStableByCode() throws {
+        guard let device = MTLCreateSystemDefaultDevice() else {
+            throw XCTSkip("Metal device unavailable")
+        }
+        let codes: [GPUMortonReorderer.MortonCode] = [
+            .init(code: 7, originalIndex: 0), .init(code: 3, originalIndex: 1),
+            .init(code: 7, originalIndex: 2), .init(code: 0, originalIndex: 3), .init(code: 3, originalIndex: 4)
+        ]
+        let buffer = try XCTUnwrap(device.makeBuffer(bytes: codes,
+                                                     length: codes.count * MemoryLayout<GPUMortonReorderer.MortonCode>.stride,
+                                                     options: .storageModeShared))
+        GPUMortonReorderer.sortOnCPU(buffer, count: codes.count)
+        let sorted = buffer.contents().bindMemory(to: GPUMortonReorderer.MortonCode.self, capacity: codes.count)
+        XCTAssertEqual((0..<codes.count).map { sorted[$0].originalIndex }, [3, 1, 4, 0, 2])
+    }
+
+    func testAddReordersSplatsAndRecordsPermutation() throws {
+        let renderer = try makeRendererOrSkip()
+        guard renderer.mortonReorderer != nil else {
+            throw XCTSkip("GPU Morton reorderer unavailable")
+        }
+        renderer.gpuMortonReorderEnabled = true
+        let points = makePoints(count: 1000)
+        try renderer.add(points)
+
+        let permutation = try XCTUnwrap(renderer.mortonPermutation)
+        XCTAssertEqual(permutation.count, points.count)
+        XCTAssertEqual(Set(permutation).count, points.count, "Permutation must be a bijection")
+        XCTAssertNotEqual(permutation, Array(0..<UInt32(points.count)))
+
+        let codes = mortonCodes(points.map(\.position))
+        var previousCode: UInt32 = 0
+        var inversions = 0
+        for index in 0..<points.count {
+            let original = renderer.originalIndex(ofSplatAt: index)
+            XCTAssertEqual(renderer.splatIndex(forOriginalIndex: original), index)
+            XCTAssertEqual(position(renderer.splatBuffer.values[index]), points[original].position)
+            XCTAssertEqual(renderer.sourceScenePoints[index].position, points[original].position)
+            if codes[original] < previousCode {
+                inversions += 1
+            }
+            previousCode = codes[original]
+        }
+        // GPU and CPU quantization can disagree by one step on a cell boundary
+        XCTAssertLessThan(inversions, points.count / 100, "Splats should be in Morton order")
+    }
+
+    func testSecondBatchIsReorderedWithinItsOwnRange() throws {
+        let renderer = try makeRendererOrSkip()
+        guard renderer.mortonReorderer != nil else {
+            throw XCTSkip("GPU Morton reorderer unavailable")
+        }
+        renderer.gpuMortonReorderEnabled = true
+        let first = makePoints(count: 300)
+        let second = makePoints(count: 200, seed: 7)
+        try renderer.add(first)
+        let firstPermutation = try XCTUnwrap(renderer.mortonPermutation)
+        try renderer.add(second)
+
+        let permutation = try XCTUnwrap(renderer.mortonPermutation)
+        XCTAssertEqual(permutation.count, 500)
+        XCTAssertEqual(Array(permutation.prefix(300)), firstPermutation, "Earlier splats keep their indices")
+        XCTAssertTrue(permutation.suffix(200).allSatisfy { $0 >= 300 })
+        for index in 300..<500 {
+            let original = renderer.originalIndex(ofSplatAt: index)
+            XCTAssertEqual(position(renderer.splatBuffer.values[index]), second[original - 300].position)
+        }
+    }
+
+    func testEditStateAndTransformIndicesFollowSplats() throws {
+        let renderer = try makeRendererOrSkip()
+        let points = makePoints(count: 600)
+        renderer.mortonOrderingEnabled = false
+        try renderer.add(points)
+        try renderer.ensureEditingResources(pointCount: points.count)
+        let states = try XCTUnwrap(renderer.editStateBuffer)
+            .contents().bindMemory(to: SplatRenderer.EditStateStorage.self, capacity: points.count)
+        let transformIndices = try XCTUnwrap(renderer.editTransformIndexBuffer)
+            .contents().bindMemory(to: SplatRenderer.TransformIndexStorage.self, capacity: points.count)
+        for index in 0..<points.count {
+            states[index] = SplatRenderer.EditStateStorage(index % 251)
+            transformIndices[index] = SplatRenderer.TransformIndexStorage(index)
+        }
+
+        guard let order = renderer.reorderSplatsByMorton(in: 0..<points.count) else {
+            throw XCTSkip("GPU Morton reorderer unavailable")
+        }
+        for (index, original) in order.enumerated() {
+            XCTAssertEqual(position(renderer.splatBuffer.values[index]), points[Int(original)].position)
+            XCTAssertEqual(states[index], SplatRenderer.EditStateStorage(Int(original) % 251))
+            XCTAssertEqual(transformIndices[index], SplatRenderer.TransformIndexStorage(original))
+        }
+    }
+
+    func testCPUOrderingRecordsPermutation() throws {
+        let renderer = try makeRendererOrSkip()
+        let points = makePoints(count: 400)
+        try renderer.add(points)
+        try renderer.add(SplatPointBatch(makePoints(count: 100, seed: 3)))
+
+        let permutation = try XCTUnwrap(renderer.mortonPermutation)
+        XCTAssertEqual(permutation.count, 500)
+        XCTAssertEqual(Set(permutation).count, 500, "Permutation must be a bijection")
+        XCTAssertTrue(permutation.suffix(100).allSatisfy { $0 >= 400 })
+        for index in 0..<400 {
+            let original = renderer.originalIndex(ofSplatAt: index)
+            XCTAssertEqual(position(renderer.splatBuffer.values[index]), points[original].position)
+        }
+    }
+
+    func testUnavailableGPUStageFallsBackToCPUOrdering() throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.mortonReorderer = nil
+        renderer.mortonOrderingEnabled = false
+        renderer.gpuMortonReorderEnabled = true
+        let points = makePoints(count: 300)
+        try renderer.add(points)
+
+        let permutation = try XCTUnwrap(renderer.mortonPermutation)
+        XCTAssertNotEqual(permutation, Array(0..<UInt32(points.count)))
+        let codes = mortonCodes(points.map(\.position))
+        var inversions = 0
+        for index in 0..<points.count {
+            let original = renderer.originalIndex(ofSplatAt: index)
+            XCTAssertEqual(position(renderer.splatBuffer.values[index]), points[original].position)
+            if index > 0 && codes[original] < codes[renderer.originalIndex(ofSplatAt: index - 1)] {
+                inversions += 1
+            }
+        }
+        XCTAssertLessThan(inversions, points.count / 100, "Splats should be in Morton order")
+
+        // A reorder of an uploaded range also sorts on the CPU without the GPU stage
+        let before = (0..<points.count).map { position(renderer.splatBuffer.values[$0]) }
+        let order = try XCTUnwrap(renderer.reorderSplatsByMorton(in: 0..<points.count))
+        XCTAssertEqual(Set(order).count, points.count)
+        for (index, source) in order.enumerated() {
+            XCTAssertEqual(position(renderer.splatBuffer.values[index]), before[Int(source)])
+        }
+    }
+
+    func testKeptSplatsKeepTheirRelativeLoadOrder() {
+        XCTAssertEqual(SplatRenderer.mortonPermutation([3, 0, 4, 2, 1], keeping: [0, 2, 3]), [1, 2, 0])
+        XCTAssertEqual(SplatRenderer.mortonPermutation([3, 0, 4, 2, 1], keeping: Array(0..<2)), [1, 0])
+        XCTAssertNil(SplatRenderer.mortonPermutation(nil, keeping: [0]))
+        XCTAssertNil(SplatRenderer.mortonPermutation([1, 0], keeping: [2]))
+    }
+
+    func testRemovingTrailingSplatsKeepsPermutation() throws {
+        let renderer = try makeRendererOrSkip()
+        let points = makePoints(count: 200)
+        try renderer.add(points)
+        let permutation = try XCTUnwrap(renderer.mortonPermutation)
+        try renderer.appendEditedSplats(Array(points.prefix(10)), sceneIndices: Array(repeating: 0, count: 10))
+        XCTAssertEqual(renderer.mortonPermutation, permutation + Array(200..<210))
+
+        try renderer.removeTrailingSplats(from: 200)
+        XCTAssertEqual(renderer.mortonPermutation, permutation)
+    }
+
+    func testDisabledReorderLeavesLoadOrder() throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.mortonOrderingEnabled = false
+        let points = makePoints(count: 100)
+        try renderer.add(points)
+        XCTAssertNil(renderer.mortonPermutation)
+        XCTAssertEqual(renderer.originalIndex(ofSplatAt: 42), 42)
+        XCTAssertEqual(renderer.splatIndex(forOriginalIndex: 42), 42)
+        XCTAssertNil(renderer.splatIndex(forOriginalIndex: 100))
+    }
+
+    // MARK: - Helpers
+
+    private func position(_ splat: SplatRenderer.Splat) -> SIMD3<Float> {
+        SIMD3(splat.position.x, splat.position.y, splat.position.z)
+    }
+
+    /// Mirrors computeMortonCodes: 10 bits per axis over the positions' bounds
+    private func mortonCodes(_ positions: [SIMD3<Float>]) -> [UInt32] {
+        let boundsMin = positions.reduce(SIMD3<Float>(repeating: .infinity)) { simd_min($0, $1) }
+        let boundsMax = positions.reduce(SIMD3<Float>(repeating: -.infinity)) { simd_max($0, $1) }
+        let size = simd_max(boundsMax - boundsMin, SIMD3<Float>(repeating: 1e-6))
+        func expand(_ value: UInt32) -> UInt32 {
+            var x = value & 0x3FF
+            x = (x | (x << 16)) & 0x030000FF
+            x = (x | (x << 8)) & 0x0300F00F
+            x = (x | (x << 4)) & 0x030C30C3
+            x = (x | (x << 2)) & 0x09249249
+            return x
+        }
+        return positions.map { position in
+            let quantized = simd_clamp((position - boundsMin) / size * 1023, SIMD3(repeating: 0), SIMD3(repeating: 1023))
+            return expand(UInt32(quantized.x)) | (expand(UInt32(quantized.y)) << 1) | (expand(UInt32(quantized.z)) << 2)
+        }
+    }
+
+    private func makePoints(count: Int, seed: Int = 0) -> [SplatScenePoint] {
+        TestScenes.points(count: count, seed: seed) { t in
+            SIMD3<Float>(sin(t * 1.7) * 4, cos(t * 0.9) * 2, sin(t * 0.37) * 3)
+        }
+    }
+}
@@ -0,0 +1,41 @@
+import XCTest
+@testable import MetalSplatter
+
+final class IncrementalSortPolicyTests: XCTestCase {
+    func testKeepsRefiningWhileResidualIsLowAndCheaperThanFullSort() {
+        XCTAssertFalse(SplatRenderer.shouldEscalateIncrementalSort(residualInversionRatio: 0.0005,
+                                                                   sortTime: 0.001,
+                                                                   lastFullSortTime: 0.004,
+                                                                   threshold: 0.002))
+        XCTAssertFalse(SplatRenderer.shouldEscalateIncrementalSort(residualInversionRatio: 0,
+                                                                   sortTime: 0.001,
+                                                                   lastFullSortTime: nil,
+                                                                   threshold: 0.002))
+    }
+
+    func testEscalatesWhenResidualExceedsThreshold() {
+        XCTAssertTrue(SplatRenderer.shouldEscalateIncrementalSort(residualInversionRatio: 0.01,
+                                                                  sortTime: 0.001,
+                                                                  lastFullSortTime: 0.004,
+                                                                  threshold: 0.002))
+    }
+
+    func testEscalatesWhenRefinementCostsAsMuchAsFullSort() {
+        XCTAssertTrue(SplatRenderer.shouldEscalateIncrementalSort(residualInversionRatio: 0,
+                                                                  sortTime: 0.004,
+                                                                  lastFullSortTime: 0.004,
+                                                                  threshold: 0.002))
+    }
+
+    func testEscalatesWithoutResidual() {
+        XCTAssertTrue(SplatRenderer.shouldEscalateIncrementalSort(residualInversionRatio: nil,
+                                                                  sortTime: 0.001,
+                                                                  lastFullSortTime: 0.004,
+                                                                  threshold: 0.002))
+    }
+
+    func testInversionRatioIsPerAdjacentPair() {
+        XCTAssertEqual(IncrementalSorter.inversionRatio(inversions: 5, count: 11), 0.5)
+        XCTAssertEqual(IncrementalSorter.inversionRatio(inversions: 0, count: 1), 0)
+    }
+}
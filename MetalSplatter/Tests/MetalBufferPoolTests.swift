@@ -132,6 +132,62 @@ final class MetalBufferPoolTests: XCTestCase {
         XCTAssertEqual(stats.availableBuffers, 1)
     }
     
+    func testSizeClassesRoundUpByAtMostAQuarter() {
+        XCTAssertEqual(MetalBufferPool<Float>.sizeClass(atLeast: 3), 3)
+        XCTAssertEqual(MetalBufferPool<Float>.sizeClass(atLeast: 100), 112)
+        XCTAssertEqual(MetalBufferPool<Float>.sizeClass(atLeast: 128), 128)
+        XCTAssertEqual(MetalBufferPool<Float>.sizeClass(atLeast: 129), 160)
+        for capacity in 1..<5000 {
+            let sizeClass = MetalBufferPool<Float>.sizeClass(atLeast: capacity)
+            XCTAssertGreaterThanOrEqual(sizeClass, capacity)
+            XCTAssertLessThanOrEqual(Double(sizeClass), Double(capacity) * 1.25 + 1)
+            // A buffer of a class's capacity is pooled under that same class
+            XCTAssertEqual(MetalBufferPool<Float>.sizeClass(atMost: sizeClass), sizeClass)
+        }
+    }
+
+    func testGrownBufferServesTheClassBelowItsCapacity() throws {
+        let buffer = try pool.acquire(minimumCapacity: 10)
+        try buffer.ensureCapacity(1000)
+        pool.release(buffer)
+
+        let reused = try pool.acquire(minimumCapacity: MetalBufferPool<Float>.sizeClass(atMost: buffer.capacity))
+        XCTAssertTrue(reused === buffer)
+        pool.release(reused)
+    }
+
+    func testLargerPooledBufferIsReusedWithinTheOvershoot() throws {
+        let large = try pool.acquire(minimumCapacity: 1000)
+        pool.release(large)
+
+        // 768 rounds to a smaller class than 1000's, within four quarter-octave steps of it
+        let reused = try pool.acquire(minimumCapacity: 768)
+        XCTAssertTrue(reused === large)
+        pool.release(reused)
+
+        // Too small a request to hand a buffer twice its size
+        let small = try pool.acquire(minimumCapacity: 100)
+        XCTAssertFalse(small === large)
+        pool.release(small)
+    }
+
+    func testHeapBackedBuffersReportHeapMemory() throws {
+        let heapPool = MetalBufferPool<Float>(device: device,
+                                              configuration: .init(enableMemoryPressureMonitoring: false,
+                                                                   useHeapAllocation: true))
+        let buffer = try heapPool.acquire(minimumCapacity: 4096)
+        if buffer.buffer.heap != nil {
+            XCTAssertGreaterThan(heapPool.getStatistics().heapAllocatedMB, 0)
+        }
+        heapPool.release(buffer)
+
+        // Pools are standalone unless they opt in
+        let plain = try pool.acquire(minimumCapacity: 4096)
+        XCTAssertNil(plain.buffer.heap)
+        XCTAssertEqual(pool.getStatistics().heapAllocatedMB, 0)
+        pool.release(plain)
+    }
+
     func testInvalidCapacityHandling() {
         // Test handling of capacity larger than device maximum
         let maxCapacity = MetalBuffer<Float>.maxCapacity(for: device)
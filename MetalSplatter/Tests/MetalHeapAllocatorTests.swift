@@ -0,0 +1,75 @@
+import XCTest
+import Metal
+@testable import MetalSplatter
+
+final class MetalHeapAllocatorTests: XCTestCase {
+    func testBuffersShareAHeapAndEmptyHeapsAreReleased() throws {
+        let device = try makeDeviceOrSkip()
+        let allocator = MetalHeapAllocator(device: device, label: "Test")
+        var first = allocator.makeBuffer(length: 4096)
+        var second = allocator.makeBuffer(length: 4096)
+        guard let firstHeap = first?.heap else {
+            throw XCTSkip("Shared heaps unavailable on this device")
+        }
+        XCTAssertTrue(second?.heap === firstHeap)
+        XCTAssertGreaterThanOrEqual(allocator.currentAllocatedSize, MetalHeapAllocator.minimumHeapSize)
+        XCTAssertGreaterThan(allocator.usedSize, 0)
+
+        first = nil
+        second = nil
+        allocator.releaseEmptyHeaps()
+        XCTAssertEqual(allocator.currentAllocatedSize, 0)
+    }
+
+    func testOversizedRequestGetsItsOwnHeap() throws {
+        let device = try makeDeviceOrSkip()
+        let allocator = MetalHeapAllocator(device: device, label: "Test", storageMode: .private)
+        let length = MetalHeapAllocator.maximumHeapSize + 4096
+        let buffer = try XCTUnwrap(allocator.makeBuffer(length: length))
+        XCTAssertGreaterThanOrEqual(buffer.length, length)
+        if let heap = buffer.heap {
+            XCTAssertGreaterThanOrEqual(heap.size, length)
+        }
+    }
+
+    func testAliasableScratchIsReusedBySubsequentAllocations() throws {
+        let device = try makeDeviceOrSkip()
+        let scratch = MetalScratchHeap(device: device)
+        let first = try XCTUnwrap(scratch.makeBuffer(length: 256 * 1024, label: "First"))
+        let reserved = scratch.currentAllocatedSize
+        XCTAssertGreaterThan(reserved, 0)
+        XCTAssertEqual(first.label, "First")
+
+        scratch.recycle([first])
+        XCTAssertTrue(first.isAliasable())
+        for _ in 0..<16 {
+            let next = try XCTUnwrap(scratch.makeBuffer(length: 256 * 1024, label: "Next"))
+            scratch.recycle([next])
+        }
+        // Recycled scratch is reused instead of growing the arena
+        XCTAssertEqual(scratch.currentAllocatedSize, reserved)
+
+        scratch.releaseMemory()
+        XCTAssertEqual(scratch.currentAllocatedSize, 0)
+    }
+
+    func testScratchArenaGrowsToFitAPass() throws {
+        let device = try makeDeviceOrSkip()
+        let scratch = MetalScratchHeap(device: device)
+        let small = try XCTUnwrap(scratch.makeBuffer(length: 1024, label: "Small"))
+        let large = try XCTUnwrap(scratch.makeBuffer(length: 4 * MetalHeapAllocator.minimumHeapSize, label: "Large"))
+        XCTAssertGreaterThanOrEqual(large.length, 4 * MetalHeapAllocator.minimumHeapSize)
+        XCTAssertGreaterThanOrEqual(scratch.currentAllocatedSize, large.length)
+        // The first buffer's heap stays alive through its buffer
+        XCTAssertNotNil(small.heap)
+    }
+
+    // MARK: - Helpers
+
+    private func makeDeviceOrSkip() throws -> MTLDevice {
+        guard let device = MTLCreateSystemDefaultDevice() else {
+            throw XCTSkip("Metal device unavailable")
+        }
+        return device
+    }
+}
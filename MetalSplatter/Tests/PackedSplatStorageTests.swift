@@ -0,0 +1,109 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class PackedSplatStorageTests: XCTestCase {
+    func testPackedLayoutsMatchShaderStructs() {
+        XCTAssertEqual(MemoryLayout<PackedSplat>.stride, 16)
+        XCTAssertEqual(MemoryLayout<GPUChunkHeader>.stride, 64)
+
+        let header = GPUChunkHeader(from: ChunkHeader(minPosition: SIMD3(-1, -2, -3),
+                                                      maxPosition: SIMD3(1, 2, 3),
+                                                      minScale: SIMD3(repeating: 0.01),
+                                                      maxScale: SIMD3(0.1, 0.2, 0.3),
+                                                      splatCount: 200))
+        XCTAssertEqual(header.splatCount, 200)
+        XCTAssertEqual(header.maxScale, SIMD3(0.1, 0.2, 0.3))
+        XCTAssertEqual(header.minPosition, SIMD3(-1, -2, -3))
+    }
+
+    func testDecodedPackedSplatsMatchRendererSplats() {
+        let points = makePoints(count: 300)
+        let chunks = PackedSplatStore.chunks(for: points)
+        XCTAssertEqual(chunks.map(\.splats.count), [256, 44])
+
+        for (index, point) in points.enumerated() {
+            let chunk = chunks[index / SplatCompression.chunkSize]
+            let header = GPUChunkHeader(from: chunk.header)
+            let actual = PackedSplatStore.decode(chunk.splats[index % SplatCompression.chunkSize], header: header)
+            let expected = SplatRenderer.Splat(point)
+
+            // 10 bits over the chunk extent is the coarsest axis
+            let tolerance = simd_reduce_max(header.maxPosition - header.minPosition) / 1023 + 1e-5
+            XCTAssertEqual(actual.position.x, expected.position.x, accuracy: tolerance, "x[\(index)]")
+            XCTAssertEqual(actual.position.y, expected.position.y, accuracy: tolerance, "y[\(index)]")
+            XCTAssertEqual(actual.position.z, expected.position.z, accuracy: tolerance, "z[\(index)]")
+            XCTAssertEqual(Float(actual.covA.x), Float(expected.covA.x), accuracy: 2e-3, "covA[\(index)]")
+            XCTAssertEqual(Float(actual.covB.z), Float(expected.covB.z), accuracy: 2e-3, "covB[\(index)]")
+            for shift in stride(from: 0, to: 32, by: 8) {
+                let difference = abs(Int((actual.packedColor >> shift) & 0xFF) - Int((expected.packedColor >> shift) & 0xFF))
+                XCTAssertLessThanOrEqual(difference, 1, "color[\(index)] byte \(shift / 8)")
+            }
+        }
+    }
+
+    func testLoadRejectsPartialInteriorChunks() throws {
+        let renderer = try makeRendererOrSkip()
+        let chunks = PackedSplatStore.chunks(for: makePoints(count: 300))
+
+        XCTAssertThrowsError(try renderer.loadPackedSplats([chunks[1], chunks[0]])) { error in
+            guard case SplatRendererError.invalidPackedSplatChunk(let index) = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+            XCTAssertEqual(index, 0)
+        }
+        XCTAssertNil(renderer.packedSplatStore)
+    }
+
+    func testPackedSceneIsSortedBackToFrontWithoutSplatBuffer() throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.mortonOrderingEnabled = false
+        // A row of splats receding from a camera at the origin looking down -Z
+        let points = (0..<600).map { index in
+            SplatScenePoint(position: SIMD3<Float>(0, 0, -1 - Float(index) * 0.01),
+                            color: .linearFloat(SIMD3<Float>(repeating: 0.5)),
+                            opacity: .linearFloat(0.5),
+                            scale: .linearFloat(SIMD3<Float>(repeating: 0.01)),
+                            rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1))
+        }
+        try renderer.loadPackedSplats(points)
+
+        let store = try XCTUnwrap(renderer.packedSplatStore)
+        XCTAssertEqual(renderer.splatBuffer.count, 0, "Packed scenes are not expanded to Splats")
+        XCTAssertEqual(renderer.packedSplatStorageByteCount,
+                       600 * MemoryLayout<PackedSplat>.stride + 3 * MemoryLayout<GPUChunkHeader>.stride)
+
+        let commandBuffer = try XCTUnwrap(renderer.device.makeCommandQueue()?.makeCommandBuffer())
+        try store.encodeSortIfNeeded(commandBuffer: commandBuffer,
+                                     cameraPosition: .zero,
+                                     cameraForward: SIMD3(0, 0, -1),
+                                     sortByDistance: false,
+                                     positionEpsilon: 0.01,
+                                     directionEpsilon: 0.0001,
+                                     useCameraRelativeBinning: false)
+        commandBuffer.commit()
+        commandBuffer.waitUntilCompleted()
+        XCTAssertNil(commandBuffer.error)
+
+        let order = Array(UnsafeBufferPointer(start: store.sortedIndexBuffer.contents().bindMemory(to: Int32.self, capacity: 600),
+                                              count: 600))
+        XCTAssertEqual(Set(order).count, 600, "The order is a permutation")
+        XCTAssertEqual(order.first, 599, "The farthest splat draws first")
+        XCTAssertEqual(order.last, 0, "The nearest splat draws last")
+    }
+
+    // MARK: - Helpers
+
+    private func makePoints(count: Int) -> [SplatScenePoint] {
+        (0..<count).map { index in
+            let t = Float(index)
+            return SplatScenePoint(position: SIMD3<Float>(sin(t) * 2, cos(t * 0.3), t * 0.01),
+                                   color: .linearFloat(SIMD3<Float>(0.2 + 0.002 * t, 0.5, 0.8 - 0.002 * t)),
+                                   opacity: .linearFloat(0.1 + 0.002 * t),
+                                   scale: .linearFloat(SIMD3<Float>(0.02, 0.05, 0.01 + 0.0001 * t)),
+                                   rotation: simd_quatf(angle: t * 0.2, axis: simd_normalize(SIMD3<Float>(1, 2, t + 1))))
+        }
+    }
+}
@@ -0,0 +1,168 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class PipelineCacheTests: XCTestCase {
+    private static let shaderSource = """
+    #include <metal_stdlib>
+    using namespace metal;
+    vertex float4 cacheTestVertex(uint vid [[vertex_id]]) { return float4(float(vid & 1), float(vid >> 1), 0, 1); }
+    fragment half4 cacheTestFragment() { return half4(1); }
+    """
+
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("PipelineCacheTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    func testSavedArchiveServesPipelinesWithoutCompiling() throws {
+        let device = try makeDeviceOrSkip()
+        let cache = PipelineCache(device: device, directory: directory)
+        _ = try cache.renderPipelineState(descriptor: try makeDescriptor(device: device))
+        // Additions are queued behind the compile; save() drains them
+        cache.save()
+
+        let archiveURL = try XCTUnwrap(try FileManager.default.contentsOfDirectory(at: directory,
+                                                                                  includingPropertiesForKeys: nil).first)
+        XCTAssertEqual(archiveURL.pathExtension, "metallib")
+
+        let archiveDescriptor = MTLBinaryArchiveDescriptor()
+        archiveDescriptor.url = archiveURL
+        let archive = try device.makeBinaryArchive(descriptor: archiveDescriptor)
+        let descriptor = try makeDescriptor(device: device)
+        descriptor.binaryArchives = [archive]
+        XCTAssertNoThrow(try device.makeRenderPipelineState(descriptor: descriptor,
+                                                            options: .failOnBinaryArchiveMiss,
+                                                            reflection: nil))
+    }
+
+    func testUnreadableArchiveIsReplaced() throws {
+        let device = try makeDeviceOrSkip()
+        let seeded = PipelineCache(device: device, directory: directory)
+        _ = try seeded.renderPipelineState(descriptor: try makeDescriptor(device: device))
+        seeded.save()
+        let archiveURL = try XCTUnwrap(try FileManager.default.contentsOfDirectory(at: directory,
+                                                                                  includingPropertiesForKeys: nil).first)
+        try Data("not an archive".utf8).write(to: archiveURL)
+
+        let cache = PipelineCache(device: device, directory: directory)
+        XCTAssertNoThrow(try cache.renderPipelineState(descriptor: try makeDescriptor(device: device)))
+    }
+
+    func testStaleArchivesArePrunedOldestFirst() throws {
+        let device = try makeDeviceOrSkip()
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        let older = directory.appendingPathComponent("older-build.metallib")
+        let newer = directory.appendingPathComponent("newer-build.metallib")
+        try Data(count: 1024).write(to: older)
+        try Data(count: 1024).write(to: newer)
+        try FileManager.default.setAttributes([.modificationDate: Date(timeIntervalSinceNow: -3600)], ofItemAtPath: older.path)
+
+        _ = PipelineCache(device: device, directory: directory, maximumDirectorySize: 1536)
+        XCTAssertFalse(FileManager.default.fileExists(atPath: older.path))
+        XCTAssertTrue(FileManager.default.fileExists(atPath: newer.path))
+    }
+
+    func testFullArchiveIsKeptReadOnlyOnLaunch() throws {
+        let device = try makeDeviceOrSkip()
+        let seeded = PipelineCache(device: device, directory: directory)
+        _ = try seeded.renderPipelineState(descriptor: try makeDescriptor(device: device))
+        seeded.save()
+        let archiveURL = try XCTUnwrap(try FileManager.default.contentsOfDirectory(at: directory,
+                                                                                  includingPropertiesForKeys: nil).first)
+        let savedArchive = try Data(contentsOf: archiveURL)
+
+        // Over the limit on the next launch: the archive still serves what it holds but takes no additions
+        let relaunched = PipelineCache(device: device, directory: directory, maximumArchiveSize: 1)
+        XCTAssertNoThrow(try relaunched.renderPipelineState(descriptor: try makeDescriptor(device: device)))
+        XCTAssertNoThrow(try relaunched.renderPipelineState(descriptor: try makeDescriptor(device: device,
+                                                                                           pixelFormat: .rgba8Unorm)))
+        relaunched.save()
+        XCTAssertEqual(try Data(contentsOf: archiveURL), savedArchive)
+    }
+
+    func testAsynchronousCompileUsesCompletionHandler() throws {
+        let device = try makeDeviceOrSkip()
+        let cache = PipelineCache(device: device, directory: directory)
+        let compiled = expectation(description: "pipeline compiled")
+        cache.renderPipelineState(descriptor: try makeDescriptor(device: device)) { result in
+            if case .success = result {
+                compiled.fulfill()
+            }
+        }
+        wait(for: [compiled], timeout: 10)
+    }
+
+    func testDitheredPathDrawsSingleStageUntilItsPipelinesArrive() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        renderer.useDitheredTransparency = true
+        try renderer.add(TestScenes.grid(side: 4, spacing: 0.1, origin: SIMD3(0, 0, -2), opacity: 0.5, scale: 0.05))
+
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .bgra8Unorm, width: 32, height: 32, mipmapped: false)
+        descriptor.usage = .renderTarget
+        descriptor.storageMode = .private
+        let colorTexture = try XCTUnwrap(renderer.device.makeTexture(descriptor: descriptor))
+        let queue = try XCTUnwrap(renderer.device.makeCommandQueue())
+        let viewport = SplatRenderer.ViewportDescriptor(
+            viewport: MTLViewport(originX: 0, originY: 0, width: 32, height: 32, znear: 0, zfar: 1),
+            projectionMatrix: matrix_identity_float4x4,
+            viewMatrix: matrix_identity_float4x4,
+            screenSize: SIMD2(32, 32))
+
+        func renderFrame() throws {
+            let commandBuffer = try XCTUnwrap(queue.makeCommandBuffer())
+            try renderer.render(viewports: [viewport],
+                                colorTexture: colorTexture,
+                                colorStoreAction: .store,
+                                depthTexture: nil,
+                                rasterizationRateMap: nil,
+                                renderTargetArrayLength: 0,
+                                to: commandBuffer)
+            commandBuffer.commit()
+            commandBuffer.waitUntilCompleted()
+        }
+
+        try renderFrame()
+        if renderer.ditheredPipelineState == nil {
+            // The first frame fell back rather than waiting on the compile
+            XCTAssertNotNil(renderer.singleStagePipelineState)
+            XCTAssertTrue(renderer.needsRender)
+        }
+
+        let deadline = Date().addingTimeInterval(10)
+        while renderer.ditheredPipelineState == nil, Date() < deadline {
+            Thread.sleep(forTimeInterval: 0.01)
+            try renderFrame()
+        }
+        XCTAssertNotNil(renderer.ditheredPipelineState)
+        XCTAssertNotNil(renderer.ditheredEditingPipelineState)
+    }
+
+    // MARK: - Helpers
+
+    private func makeDeviceOrSkip() throws -> MTLDevice {
+        guard let device = MTLCreateSystemDefaultDevice() else {
+            throw XCTSkip("Metal device unavailable")
+        }
+        return device
+    }
+
+    private func makeDescriptor(device: MTLDevice,
+                                pixelFormat: MTLPixelFormat = .bgra8Unorm) throws -> MTLRenderPipelineDescriptor {
+        let library = try device.makeLibrary(source: Self.shaderSource, options: nil)
+        let descriptor = MTLRenderPipelineDescriptor()
+        descriptor.label = "PipelineCacheTests"
+        descriptor.vertexFunction = library.makeFunction(name: "cacheTestVertex")
+        descriptor.fragmentFunction = library.makeFunction(name: "cacheTestFragment")
+        descriptor.colorAttachments[0].pixelFormat = pixelFormat
+        return descriptor
+    }
+}
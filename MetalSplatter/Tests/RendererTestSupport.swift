@@ -0,0 +1,77 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+// MARK: - Test Renderers
+
+extension XCTestCase {
+    /// A single-view, non-multisampled BGRA renderer with three frames in flight; skips the test where Metal or the
+    /// renderer's shaders are unavailable
+    func makeRendererOrSkip(depthFormat: MTLPixelFormat = .depth32Float) throws -> SplatRenderer {
+        try makeOrSkip { device in
+            try SplatRenderer(device: device,
+                              colorFormat: .bgra8Unorm,
+                              depthFormat: depthFormat,
+                              sampleCount: 1,
+                              maxViewCount: 1,
+                              maxSimultaneousRenders: 3)
+        }
+    }
+
+    /// `makeRendererOrSkip(depthFormat:)` for `FastSHSplatRenderer`
+    func makeFastSHRendererOrSkip(depthFormat: MTLPixelFormat = .depth32Float) throws -> FastSHSplatRenderer {
+        try makeOrSkip { device in
+            try FastSHSplatRenderer(device: device,
+                                    colorFormat: .bgra8Unorm,
+                                    depthFormat: depthFormat,
+                                    sampleCount: 1,
+                                    maxViewCount: 1,
+                                    maxSimultaneousRenders: 3)
+        }
+    }
+
+    private func makeOrSkip<Renderer>(_ make: (MTLDevice) throws -> Renderer) throws -> Renderer {
+        guard let device = MTLCreateSystemDefaultDevice() else {
+            throw XCTSkip("Metal device unavailable")
+        }
+        do {
+            return try make(device)
+        } catch {
+            throw XCTSkip("Renderer unavailable in swift test environment: \(error.localizedDescription)")
+        }
+    }
+}
+
+// MARK: - Test Scenes
+
+enum TestScenes {
+    /// `count` small, identically shaded splats, each placed at `position(t)` and rotated by `t`, where `t` is its
+    /// index offset by `seed * 1000`
+    static func points(count: Int, seed: Int = 0, position: (Float) -> SIMD3<Float>) -> [SplatScenePoint] {
+        (0..<count).map { index in
+            let t = Float(index + seed * 1000)
+            return SplatScenePoint(position: position(t),
+                                   color: .linearFloat(SIMD3<Float>(0.3, 0.5, 0.7)),
+                                   opacity: .linearFloat(0.6),
+                                   scale: .linearFloat(SIMD3<Float>(0.02, 0.03, 0.01)),
+                                   rotation: simd_quatf(angle: t * 0.2, axis: simd_normalize(SIMD3<Float>(1, 2, 3))))
+        }
+    }
+
+    /// A `side` by `side` grid of gray, unrotated splats at `spacing` in the xy plane, starting at `origin`
+    static func grid(side: Int,
+                     spacing: Float,
+                     origin: SIMD3<Float> = .zero,
+                     opacity: Float,
+                     scale: Float) -> [SplatScenePoint] {
+        (0..<(side * side)).map { index in
+            SplatScenePoint(position: origin + SIMD3<Float>(Float(index % side) * spacing, Float(index / side) * spacing, 0),
+                            color: .linearFloat(SIMD3<Float>(repeating: 0.5)),
+                            opacity: .linearFloat(opacity),
+                            scale: .linearFloat(SIMD3<Float>(repeating: scale)),
+                            rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1))
+        }
+    }
+}
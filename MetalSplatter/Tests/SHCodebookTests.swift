@@ -0,0 +1,67 @@
+import XCTest
+import simd
+@testable import MetalSplatter
+
+final class SHCodebookTests: XCTestCase {
+    func testCodebookStaysWithinEntryCountAndLabelsAreValid() {
+        let sets = makeSets(count: 2000, coefficientCount: 16)
+        let codebook = SHCodebook.train(sets: sets, entryCount: 100, iterations: 3)
+
+        XCTAssertLessThanOrEqual(codebook.centroids.count, 100)
+        XCTAssertGreaterThan(codebook.centroids.count, 1)
+        XCTAssertEqual(codebook.labels.count, sets.count)
+        XCTAssertTrue(codebook.centroids.allSatisfy { $0.count == 16 })
+        XCTAssertTrue(codebook.labels.allSatisfy { Int($0) < codebook.centroids.count })
+    }
+
+    func testLargerCodebookQuantizesMoreAccurately() {
+        let sets = makeSets(count: 4000, coefficientCount: 9)
+        let small = SHCodebook.train(sets: sets, entryCount: 16, iterations: 4)
+        let large = SHCodebook.train(sets: sets, entryCount: 1024, iterations: 4)
+
+        let smallError = meanSquaredError(sets, small)
+        let largeError = meanSquaredError(sets, large)
+        XCTAssertLessThan(largeError, smallError)
+
+        let mean = sets.reduce([SIMD3<Float>](repeating: .zero, count: 9)) { sum, set in
+            zip(sum, set).map { $0 + $1 / Float(sets.count) }
+        }
+        let variance = meanSquaredError(sets, SHCodebook(centroids: [mean], labels: [UInt16](repeating: 0, count: sets.count)))
+        XCTAssertLessThan(largeError, variance * 0.5)
+    }
+
+    func testDuplicateSetsShareALabel() {
+        let prototypes = makeSets(count: 3, coefficientCount: 4)
+        let sets = (0..<300).map { prototypes[$0 % 3] }
+        let codebook = SHCodebook.train(sets: sets, entryCount: 64, iterations: 2)
+
+        for (index, label) in codebook.labels.enumerated() {
+            XCTAssertEqual(label, codebook.labels[index % 3])
+        }
+    }
+
+    func testEmptyInputProducesEmptyCodebook() {
+        let codebook = SHCodebook.train(sets: [], entryCount: 16, iterations: 2)
+        XCTAssertTrue(codebook.centroids.isEmpty)
+        XCTAssertTrue(codebook.labels.isEmpty)
+    }
+
+    // MARK: - Helpers
+
+    private func makeSets(count: Int, coefficientCount: Int) -> [[SIMD3<Float>]] {
+        (0..<count).map { index in
+            (0..<coefficientCount).map { coefficient in
+                let t = Float(index * coefficientCount + coefficient)
+                return SIMD3<Float>(sin(t * 1.3), cos(t * 0.7), sin(t * 2.9 + 1)) * (coefficient == 0 ? 1 : 0.2)
+            }
+        }
+    }
+
+    private func meanSquaredError(_ sets: [[SIMD3<Float>]], _ codebook: SHCodebook) -> Float {
+        var total: Float = 0
+        for (set, label) in zip(sets, codebook.labels) {
+            total += zip(set, codebook.centroids[Int(label)]).reduce(0) { $0 + simd_distance_squared($1.0, $1.1) }
+        }
+        return total / Float(sets.count)
+    }
+}
@@ -0,0 +1,174 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class SelectionClusterTests: XCTestCase {
+    func testClusterCullingMatchesFullPassForEachQuery() async throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.mortonOrderingEnabled = false
+        try renderer.add(makePoints(count: 3000))
+        try renderer.ensureEditingResources(pointCount: renderer.splatCount)
+        let engine = try SplatSelectionEngine(device: renderer.device)
+
+        let queries: [SplatSelectionQuery] = [
+            .point(normalized: SIMD2<Float>(0.5, 0.5), radius: 0.05),
+            .rect(normalizedMin: SIMD2<Float>(0.1, 0.2), normalizedMax: SIMD2<Float>(0.4, 0.6)),
+            .sphere(center: SIMD3<Float>(0.3, -0.2, -3.0), radius: 0.4),
+            .box(center: SIMD3<Float>(-0.4, 0.3, -2.5), extents: SIMD3<Float>(0.3, 0.2, 0.5))
+        ]
+        for query in queries {
+            engine.clusterCullingEnabled = true
+            let culled = try await engine.select(query: query, viewport: makeViewport(), renderer: renderer)
+            engine.clusterCullingEnabled = false
+            let full = try await engine.select(query: query, viewport: makeViewport(), renderer: renderer)
+            XCTAssertFalse(full.isEmpty, "\(query) should hit some splats")
+            XCTAssertEqual(culled.sorted(), full.sorted(), "\(query)")
+        }
+
+        engine.clusterCullingEnabled = true
+        let culledPick = try await engine.pickNearest(normalized: SIMD2<Float>(0.62, 0.41), radius: 0.05,
+                                                      viewport: makeViewport(), renderer: renderer)
+        engine.clusterCullingEnabled = false
+        let fullPick = try await engine.pickNearest(normalized: SIMD2<Float>(0.62, 0.41), radius: 0.05,
+                                                    viewport: makeViewport(), renderer: renderer)
+        XCTAssertNotNil(fullPick)
+        XCTAssertEqual(culledPick, fullPick)
+    }
+
+    func testClusterCullingMatchesFullPassOnWideViewportWithLargeAnisotropicSplats() async throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.mortonOrderingEnabled = false
+        let points = (0..<2048).map { index in
+            let t = Float(index)
+            return SplatScenePoint(position: SIMD3<Float>(sin(t * 1.3) * 3, cos(t * 0.7) * 0.8, -4 - abs(sin(t * 0.29)) * 6),
+                                   color: .linearFloat(SIMD3<Float>(0.3, 0.5, 0.7)),
+                                   opacity: .linearFloat(0.6),
+                                   scale: .linearFloat(SIMD3<Float>(0.6, 0.02, 0.05)),
+                                   rotation: simd_quatf(angle: t * 0.4, axis: simd_normalize(SIMD3<Float>(0.2, 1, 0.5))))
+        }
+        try renderer.add(points)
+        try renderer.ensureEditingResources(pointCount: renderer.splatCount)
+        let engine = try SplatSelectionEngine(device: renderer.device)
+
+        let size = SIMD2<Int>(1024, 256)
+        let viewport = SplatRenderer.ViewportDescriptor(
+            viewport: MTLViewport(originX: 0, originY: 0, width: Double(size.x), height: Double(size.y), znear: 0, zfar: 1),
+            projectionMatrix: GPUPerformanceProfiler.perspective(fovY: .pi / 5, aspect: Float(size.x) / Float(size.y),
+                                                                 near: 0.1, far: 100),
+            viewMatrix: matrix_identity_float4x4,
+            screenSize: size
+        )
+
+        // Thin rects and small points hit splats mostly through their footprints rather than their centers
+        let queries: [SplatSelectionQuery] = [
+            .point(normalized: SIMD2<Float>(0.45, 0.5), radius: 0.002),
+            .point(normalized: SIMD2<Float>(0.58, 0.55), radius: 0.002),
+            .rect(normalizedMin: SIMD2<Float>(0.495, 0.1), normalizedMax: SIMD2<Float>(0.505, 0.9)),
+            .rect(normalizedMin: SIMD2<Float>(0.05, 0.48), normalizedMax: SIMD2<Float>(0.95, 0.49))
+        ]
+        for query in queries {
+            engine.clusterCullingEnabled = true
+            let culled = try await engine.select(query: query, viewport: viewport, renderer: renderer)
+            engine.clusterCullingEnabled = false
+            let full = try await engine.select(query: query, viewport: viewport, renderer: renderer)
+            XCTAssertFalse(full.isEmpty, "\(query) should hit some splats")
+            XCTAssertEqual(culled.sorted(), full.sorted(), "\(query)")
+        }
+
+        engine.clusterCullingEnabled = true
+        let culledPick = try await engine.pickNearest(normalized: SIMD2<Float>(0.52, 0.47), radius: 0.002,
+                                                      viewport: viewport, renderer: renderer)
+        engine.clusterCullingEnabled = false
+        let fullPick = try await engine.pickNearest(normalized: SIMD2<Float>(0.52, 0.47), radius: 0.002,
+                                                    viewport: viewport, renderer: renderer)
+        XCTAssertEqual(culledPick, fullPick)
+    }
+
+    func testEnginesSharingARendererEachSeeItsUpdates() async throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.mortonOrderingEnabled = false
+        var points = makePoints(count: 1000)
+        try renderer.add(points)
+        try renderer.ensureEditingResources(pointCount: points.count)
+        let first = try SplatSelectionEngine(device: renderer.device)
+        let second = try SplatSelectionEngine(device: renderer.device)
+
+        let target = SIMD3<Float>(5, 5, -20)
+        let query = SplatSelectionQuery.sphere(center: target, radius: 0.1)
+        _ = try await first.select(query: query, viewport: makeViewport(), renderer: renderer)
+        _ = try await second.select(query: query, viewport: makeViewport(), renderer: renderer)
+
+        points[300].position = target
+        try renderer.updateSplats(points, at: [300])
+        let firstAfter = try await first.select(query: query, viewport: makeViewport(), renderer: renderer)
+        let secondAfter = try await second.select(query: query, viewport: makeViewport(), renderer: renderer)
+        XCTAssertEqual(firstAfter, [300])
+        XCTAssertEqual(secondAfter, [300])
+    }
+
+    func testClusterBoundsFollowSplatUpdates() async throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.mortonOrderingEnabled = false
+        var points = makePoints(count: 1000)
+        try renderer.add(points)
+        try renderer.ensureEditingResources(pointCount: points.count)
+        let engine = try SplatSelectionEngine(device: renderer.device)
+
+        let target = SIMD3<Float>(5, 5, -20)
+        let query = SplatSelectionQuery.sphere(center: target, radius: 0.1)
+        let before = try await engine.select(query: query, viewport: makeViewport(), renderer: renderer)
+        XCTAssertEqual(before, [])
+
+        points[700].position = target
+        try renderer.updateSplats(points, at: [700])
+        let after = try await engine.select(query: query, viewport: makeViewport(), renderer: renderer)
+        XCTAssertEqual(after, [700])
+    }
+
+    func testClusterBoundsFollowTransformPaletteChanges() async throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.mortonOrderingEnabled = false
+        let points = makePoints(count: 1000)
+        try renderer.add(points)
+        try renderer.ensureEditingResources(pointCount: points.count)
+        let engine = try SplatSelectionEngine(device: renderer.device)
+
+        var offset = SIMD3<Float>(8, 0, 0)
+        try renderer.updateTransformIndices(at: [42], values: [1])
+        try renderer.updateTransformPalette([matrix_identity_float4x4, translation(offset)])
+        var selected = try await engine.select(query: .sphere(center: points[42].position + offset, radius: 0.05),
+                                               viewport: makeViewport(), renderer: renderer)
+        XCTAssertEqual(selected, [42])
+
+        offset = SIMD3<Float>(0, -8, 0)
+        try renderer.updateTransformPalette([matrix_identity_float4x4, translation(offset)])
+        selected = try await engine.select(query: .sphere(center: points[42].position + offset, radius: 0.05),
+                                           viewport: makeViewport(), renderer: renderer)
+        XCTAssertEqual(selected, [42])
+    }
+
+    // MARK: - Helpers
+
+    private func translation(_ offset: SIMD3<Float>) -> simd_float4x4 {
+        var matrix = matrix_identity_float4x4
+        matrix.columns.3 = SIMD4<Float>(offset, 1)
+        return matrix
+    }
+
+    private func makeViewport() -> SplatRenderer.ViewportDescriptor {
+        SplatRenderer.ViewportDescriptor(
+            viewport: MTLViewport(originX: 0, originY: 0, width: 256, height: 256, znear: 0, zfar: 1),
+            projectionMatrix: matrix_identity_float4x4,
+            viewMatrix: matrix_identity_float4x4,
+            screenSize: SIMD2<Int>(256, 256)
+        )
+    }
+
+    private func makePoints(count: Int) -> [SplatScenePoint] {
+        TestScenes.points(count: count) { t in
+            SIMD3<Float>(sin(t * 1.7) * 0.9, cos(t * 0.9) * 0.9, -2 - abs(sin(t * 0.37)) * 2)
+        }
+    }
+}
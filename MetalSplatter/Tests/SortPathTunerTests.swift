@@ -0,0 +1,132 @@
+import XCTest
+@testable import MetalSplatter
+
+final class SortPathTunerTests: XCTestCase {
+    private static let candidates = [
+        SortPathTuner.Choice(path: .counting, countingBinCount: 16384),
+        SortPathTuner.Choice(path: .counting, countingBinCount: 8192),
+        SortPathTuner.Choice(path: .mps),
+    ]
+
+    func testExploresEachCandidateThenExploitsTheFastest() throws {
+        let tuner = makeTuner()
+        let times: [SortPathTuner.Choice: TimeInterval] = [Self.candidates[0]: 0.003,
+                                                           Self.candidates[1]: 0.002,
+                                                           Self.candidates[2]: 0.004]
+        var explored: [SortPathTuner.Choice] = []
+        for _ in 0..<9 {
+            let trial = try XCTUnwrap(nextTrial(tuner))
+            explored.append(trial.choice)
+            // The first sort of each candidate is a warm-up and far slower; it must not count
+            let isWarmup = explored.filter { $0 == trial.choice }.count == 1
+            tuner.record(trial, sortTime: isWarmup ? 1 : times[trial.choice]!, completed: true)
+        }
+        XCTAssertEqual(explored, Self.candidates.flatMap { Array(repeating: $0, count: 3) }, "candidates run back to back")
+
+        let regime = try XCTUnwrap(nextTrial(tuner)).regime
+        let result = try XCTUnwrap(tuner.tunedResult(for: regime))
+        XCTAssertEqual(result.choice, Self.candidates[1])
+        XCTAssertEqual(result.sortTime, 0.002, accuracy: 1e-9)
+        XCTAssertEqual(nextTrial(tuner)?.choice, Self.candidates[1])
+        XCTAssertEqual(nextTrial(tuner, candidates: Array(Self.candidates.reversed()))?.choice, Self.candidates[1],
+                       "candidate order doesn't matter once tuned")
+    }
+
+    func testRegimesSplitBySceneSizeAndRenderableFraction() {
+        let full = SortPathTuner.Regime(splatCount: 100_000, renderableCount: 100_000, perEye: false, paths: [.mps, .counting])
+        XCTAssertEqual(full.sceneSizeClass, 16)
+        XCTAssertEqual(full.renderableClass, 4)
+        XCTAssertEqual(full.paths, [.counting, .mps])
+        XCTAssertEqual(full, SortPathTuner.Regime(splatCount: 120_000, renderableCount: 120_000, perEye: false,
+                                                  paths: [.counting, .mps, .counting]))
+
+        let edited = SortPathTuner.Regime(splatCount: 100_000, renderableCount: 99_999, perEye: false, paths: [.counting, .mps])
+        XCTAssertEqual(edited.renderableClass, 3)
+        XCTAssertEqual(SortPathTuner.Regime(splatCount: 100_000, renderableCount: 30_000, perEye: false, paths: [.mps]).renderableClass, 1)
+        XCTAssertNotEqual(full, edited)
+        XCTAssertNotEqual(full, SortPathTuner.Regime(splatCount: 100_000, renderableCount: 100_000, perEye: true, paths: [.counting, .mps]))
+        XCTAssertNotEqual(full, SortPathTuner.Regime(splatCount: 300_000, renderableCount: 300_000, perEye: false, paths: [.counting, .mps]))
+    }
+
+    func testFailedCandidateIsDropped() throws {
+        let tuner = makeTuner()
+        tuner.warmupSamplesPerChoice = 0
+        let first = try XCTUnwrap(nextTrial(tuner))
+        tuner.record(first, sortTime: 0.001, completed: false)
+
+        var tried: Set<SortPathTuner.Choice> = []
+        while tuner.tunedResults().isEmpty {
+            let trial = try XCTUnwrap(nextTrial(tuner))
+            tried.insert(trial.choice)
+            tuner.record(trial, sortTime: trial.choice.path == .mps ? 0.003 : 0.002, completed: true)
+        }
+        XCTAssertFalse(tried.contains(Self.candidates[0]))
+        XCTAssertEqual(tuner.tunedResults().first?.value.choice, Self.candidates[1])
+    }
+
+    func testRegressionReexploresTheRegime() throws {
+        let tuner = makeTuner()
+        tuner.regressionWindow = 4
+        tuner.warmupSamplesPerChoice = 0
+        while tuner.tunedResults().isEmpty {
+            let trial = try XCTUnwrap(nextTrial(tuner))
+            tuner.record(trial, sortTime: trial.choice.path == .mps ? 0.001 : 0.002, completed: true)
+        }
+        let winner = try XCTUnwrap(nextTrial(tuner))
+        XCTAssertEqual(winner.choice.path, .mps)
+
+        // Ordinary noise within the threshold keeps the winner
+        for _ in 0..<4 {
+            tuner.record(winner, sortTime: 0.0014, completed: true)
+        }
+        XCTAssertFalse(tuner.tunedResults().isEmpty)
+
+        for _ in 0..<4 {
+            tuner.record(winner, sortTime: 0.005, completed: true)
+        }
+        XCTAssertTrue(tuner.tunedResults().isEmpty)
+        XCTAssertEqual(nextTrial(tuner)?.choice, Self.candidates[0], "exploration restarts from the first candidate")
+    }
+
+    func testWinnersPersistPerDeviceModel() throws {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let url = directory.appendingPathComponent("tuning.json")
+
+        let tuner = SortPathTuner(deviceName: "Apple M3", storageURL: url)
+        tuner.samplesPerChoice = 1
+        tuner.warmupSamplesPerChoice = 0
+        while tuner.tunedResults().isEmpty {
+            let trial = try XCTUnwrap(nextTrial(tuner))
+            tuner.record(trial, sortTime: trial.choice == Self.candidates[2] ? 0.001 : 0.002, completed: true)
+        }
+        tuner.waitForPendingWrites()
+
+        let relaunched = SortPathTuner(deviceName: "Apple M3", storageURL: url)
+        XCTAssertEqual(relaunched.tunedResults(), tuner.tunedResults())
+        XCTAssertEqual(nextTrial(relaunched)?.choice, Self.candidates[2], "a stored winner is used without exploring")
+
+        XCTAssertTrue(SortPathTuner(deviceName: "Apple A17 Pro GPU", storageURL: url).tunedResults().isEmpty)
+
+        relaunched.reset()
+        relaunched.waitForPendingWrites()
+        XCTAssertTrue(SortPathTuner(deviceName: "Apple M3", storageURL: url).tunedResults().isEmpty)
+    }
+
+    func testCountingSortBinCandidatesStayInRange() {
+        XCTAssertEqual(CountingSorter.binCountCandidates(for: 5_000), [4096, 8192])
+        XCTAssertEqual(CountingSorter.binCountCandidates(for: 50_000), [16384, 8192, 32768])
+        XCTAssertEqual(CountingSorter.binCountCandidates(for: 2_000_000), [65536, 32768])
+    }
+
+    private func makeTuner() -> SortPathTuner {
+        let tuner = SortPathTuner(deviceName: "Test GPU", storageURL: nil)
+        tuner.samplesPerChoice = 2
+        return tuner
+    }
+
+    private func nextTrial(_ tuner: SortPathTuner,
+                           candidates: [SortPathTuner.Choice] = SortPathTunerTests.candidates) -> SortPathTuner.Trial? {
+        tuner.trial(splatCount: 100_000, renderableCount: 100_000, perEye: false, candidates: candidates)
+    }
+}
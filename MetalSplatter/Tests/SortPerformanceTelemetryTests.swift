@@ -34,4 +34,28 @@ final class SortPerformanceTelemetryTests: XCTestCase {
         XCTAssertTrue(message.contains("sortByDistance=false"))
         XCTAssertTrue(message.contains("status=completed"))
     }
+
+    func testLogMessageIncludesResidualOnlyForIncrementalSorts() {
+        var sample = SplatRenderer.SortPerformanceSample(
+            path: .incremental,
+            splatCount: 1_000,
+            renderableCount: 1_000,
+            wallTime: 0.001,
+            callbackWallTime: nil,
+            gpuTime: nil,
+            mainQueueDelay: nil,
+            inFlightSortsAtStart: 0,
+            inFlightSortsAtCompletion: 0,
+            interactionMode: true,
+            sortByDistance: true,
+            status: "completed",
+            residualInversionRatio: 0.0015
+        )
+
+        XCTAssertTrue(sample.logMessage.contains("path=incremental"))
+        XCTAssertTrue(sample.logMessage.contains("residualInversions=0.0015"))
+
+        sample.residualInversionRatio = nil
+        XCTAssertFalse(sample.logMessage.contains("residualInversions"))
+    }
 }
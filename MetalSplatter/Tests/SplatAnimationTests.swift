@@ -1,4 +1,5 @@
 import XCTest
+import Metal
 import simd
 @testable import MetalSplatter
 import SplatIO
@@ -173,6 +174,74 @@ final class SplatAnimationTests: XCTestCase {
         XCTAssertLessThan(next.point.scale.asLinearFloat.x, layers[1].scale.asLinearFloat.x)
     }
 
+    func testGPUAnimationInputLayoutsMatchShaderStructs() {
+        XCTAssertEqual(MemoryLayout<SplatAnimationSourcePoint>.stride, 64)
+        XCTAssertEqual(MemoryLayout<SplatAnimationGPUSceneMetrics>.stride, 32)
+        XCTAssertEqual(MemoryLayout<SplatAnimationGPUParameters>.stride, 96)
+        XCTAssertEqual(MemoryLayout<SplatAnimationGPUParameters>.offset(of: \.origin), 80)
+    }
+
+    func testGPUAnimationMatchesCPUEngine() throws {
+        let renderer = try makeRendererOrSkip()
+        let commandQueue = try XCTUnwrap(renderer.device.makeCommandQueue())
+        guard renderer.animateSplatsPipelineState != nil else {
+            throw XCTSkip("Animation kernel unavailable")
+        }
+
+        let layerA = (0..<8).map { makePoint(position: SIMD3<Float>(Float($0) * 0.25, Float($0 % 3) * 0.5, 0.1)) }
+        let layerB = (0..<8).map { makePoint(position: SIMD3<Float>(-1, Float($0) * 0.2, Float($0) * -0.3)) }
+        try renderer.replaceSceneLayers([SplatSceneLayer(points: layerA), SplatSceneLayer(points: layerB)])
+
+        for effect in [SplatAnimationEffect.spread, .unroll, .spherical, .morph] {
+            let configuration = SplatAnimationConfiguration(effect: effect, time: 2.3, minimumScale: 0.01)
+            renderer.animationConfiguration = configuration
+
+            let commandBuffer = try XCTUnwrap(commandQueue.makeCommandBuffer())
+            XCTAssertTrue(renderer.updateAnimatedSplatsIfNeeded(to: commandBuffer))
+            commandBuffer.commit()
+            commandBuffer.waitUntilCompleted()
+
+            let animated = try XCTUnwrap(renderer.animatedSplatBuffer)
+            XCTAssertEqual(animated.count, renderer.sourceScenePoints.count)
+            for (index, point) in renderer.sourceScenePoints.enumerated() {
+                var sample = SplatAnimationEngine.apply(point: point,
+                                                        globalIndex: index,
+                                                        sceneIndex: Int(renderer.animationSceneIndices[index]),
+                                                        sceneMetrics: renderer.animationSceneMetrics,
+                                                        configuration: configuration)
+                sample.point.color = .linearFloat(simd_clamp(sample.point.color.asLinearFloat * sample.tint,
+                                                             SIMD3<Float>(repeating: 0),
+                                                             SIMD3<Float>(repeating: 4)))
+                let expected = SplatRenderer.Splat(sample.point)
+                let actual = animated.values[index]
+                XCTAssertEqual(actual.position.x, expected.position.x, accuracy: 0.001, "\(effect) x[\(index)]")
+                XCTAssertEqual(actual.position.y, expected.position.y, accuracy: 0.001, "\(effect) y[\(index)]")
+                XCTAssertEqual(actual.position.z, expected.position.z, accuracy: 0.001, "\(effect) z[\(index)]")
+                XCTAssertEqual(Float(actual.covA.x), Float(expected.covA.x), accuracy: 0.001, "\(effect) cov[\(index)]")
+                XCTAssertLessThanOrEqual(abs(Int(actual.packedColor >> 24) - Int(expected.packedColor >> 24)), 1,
+                                         "\(effect) alpha[\(index)]")
+            }
+        }
+    }
+
+    func testBatchedSplatsKeepColumnarSourceUntilAnimated() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        renderer.mortonOrderingEnabled = false
+        let first = (0..<6).map { makePoint(position: SIMD3<Float>(Float($0), 0, 0)) }
+        let second = (0..<4).map { makePoint(position: SIMD3<Float>(0, Float($0), 0)) }
+        try renderer.add(SplatPointBatch(first))
+        try renderer.add(SplatPointBatch(second))
+
+        XCTAssertEqual(renderer.splatCount, 10)
+        XCTAssertTrue(renderer.sourceScenePoints.isEmpty, "batches are not expanded into scene points")
+        XCTAssertEqual(renderer.pendingSourceBatch?.count, 10)
+
+        renderer.animationConfiguration = SplatAnimationConfiguration(effect: .spread, time: 1)
+        XCTAssertNil(renderer.pendingSourceBatch)
+        XCTAssertEqual(renderer.sourceScenePoints.map(\.position), (first + second).map(\.position))
+        XCTAssertEqual(renderer.animationSceneIndices.count, 10)
+    }
+
     private func makePoint(position: SIMD3<Float>,
                            scale: SIMD3<Float> = SIMD3<Float>(repeating: 0.2),
                            opacity: Float = 1) -> SplatScenePoint {
@@ -0,0 +1,168 @@
+import XCTest
+import ImageIO
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class SplatBatchRendererTests: XCTestCase {
+    func testTurntableCirclesTheCenter() {
+        let center = SIMD3<Float>(1, 2, 3)
+        let cameras = SplatBatchRenderer.Camera.turntable(center: center, distance: 4, height: 1, frameCount: 8, aspect: 1)
+        XCTAssertEqual(cameras.count, 8)
+
+        let eyes = cameras.map { camera -> SIMD3<Float> in
+            let position = camera.viewMatrix.inverse.columns.3
+            return SIMD3(position.x, position.y, position.z)
+        }
+        for eye in eyes {
+            XCTAssertEqual(simd_length(SIMD2(eye.x - center.x, eye.z - center.z)), 4, accuracy: 1e-4)
+            XCTAssertEqual(eye.y, center.y + 1, accuracy: 1e-4)
+        }
+        XCTAssertEqual(eyes[0].z, center.z + 4, accuracy: 1e-4)
+        XCTAssertEqual(eyes[4].z, center.z - 4, accuracy: 1e-4, "half a turn puts the camera opposite")
+        XCTAssertTrue(SplatBatchRenderer.Camera.turntable(center: center, distance: 4, frameCount: 0, aspect: 1).isEmpty)
+    }
+
+    func testFramesAreReadBackInCameraOrder() async throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        try renderer.add(Self.grid)
+        let batch = try SplatBatchRenderer(renderer: renderer, resolution: SIMD2(64, 48))
+        XCTAssertEqual(batch.framesInFlight, 3)
+
+        let cameras = SplatBatchRenderer.Camera.turntable(center: SIMD3(0.175, 0.175, 0), distance: 2,
+                                                          frameCount: 10, aspect: 64.0 / 48.0)
+        var images: [SplatBatchRenderer.Image] = []
+        try await batch.render(cameras) { images.append($0) }
+
+        XCTAssertEqual(images.map(\.index), Array(0..<10))
+        for image in images {
+            XCTAssertEqual(image.width, 64)
+            XCTAssertEqual(image.height, 48)
+            XCTAssertEqual(image.data.count, image.bytesPerRow * 48)
+            XCTAssertNotNil(image.makeCGImage())
+        }
+        XCTAssertTrue(images.contains { image in image.data.contains { $0 != 0 } }, "the splats cover some pixels")
+    }
+
+    func testTexturesMustMatchTheCameras() async throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        try renderer.add(Self.grid)
+        let batch = try SplatBatchRenderer(renderer: renderer, resolution: SIMD2(32, 32))
+        let cameras = SplatBatchRenderer.Camera.turntable(center: .zero, distance: 2, frameCount: 2, aspect: 1)
+
+        do {
+            try await batch.render(cameras, into: [])
+            XCTFail("expected a thrown error")
+        } catch SplatRendererError.invalidBatchConfiguration {
+        }
+    }
+
+    func testBatchFrameMatchesInteractiveRender() async throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        try renderer.add(Self.grid)
+        let batch = try SplatBatchRenderer(renderer: renderer, resolution: SIMD2(64, 48))
+        let camera = SplatBatchRenderer.Camera.turntable(center: SIMD3(0.175, 0.175, 0), distance: 2,
+                                                         frameCount: 8, aspect: 64.0 / 48.0)[1]
+        var batchImage: SplatBatchRenderer.Image?
+        try await batch.render([camera]) { batchImage = $0 }
+        let batchData = try XCTUnwrap(batchImage).data
+
+        // The interactive path sorts in the background and draws the last published order, so it is rendered until
+        // the sort for this camera has landed
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .bgra8Unorm, width: 64, height: 48, mipmapped: false)
+        descriptor.usage = .renderTarget
+        descriptor.storageMode = .private
+        let colorTexture = try XCTUnwrap(renderer.device.makeTexture(descriptor: descriptor))
+        let readback = try XCTUnwrap(renderer.device.makeBuffer(length: batchData.count, options: .storageModeShared))
+        let queue = try XCTUnwrap(renderer.device.makeCommandQueue())
+        let viewport = SplatRenderer.ViewportDescriptor(
+            viewport: MTLViewport(originX: 0, originY: 0, width: 64, height: 48, znear: 0, zfar: 1),
+            projectionMatrix: camera.projectionMatrix,
+            viewMatrix: camera.viewMatrix,
+            screenSize: SIMD2(64, 48))
+        let deadline = Date().addingTimeInterval(10)
+        repeat {
+            let commandBuffer = try XCTUnwrap(queue.makeCommandBuffer())
+            try renderer.render(viewports: [viewport],
+                                colorTexture: colorTexture,
+                                colorStoreAction: .store,
+                                depthTexture: nil,
+                                rasterizationRateMap: nil,
+                                renderTargetArrayLength: 0,
+                                to: commandBuffer)
+            let blitEncoder = try XCTUnwrap(commandBuffer.makeBlitCommandEncoder())
+            blitEncoder.copy(from: colorTexture, sourceSlice: 0, sourceLevel: 0,
+                             sourceOrigin: MTLOrigin(x: 0, y: 0, z: 0), sourceSize: MTLSize(width: 64, height: 48, depth: 1),
+                             to: readback, destinationOffset: 0, destinationBytesPerRow: 64 * 4, destinationBytesPerImage: batchData.count)
+            blitEncoder.endEncoding()
+            commandBuffer.commit()
+            commandBuffer.waitUntilCompleted()
+            XCTAssertNil(commandBuffer.error)
+            if !renderer.needsRender { break }
+            try await Task.sleep(nanoseconds: 10_000_000)
+        } while Date() < deadline
+
+        let interactiveData = Data(bytes: readback.contents(), count: batchData.count)
+        XCTAssertTrue(batchData.contains { $0 != 0 }, "the splats cover some pixels")
+        let largestDifference = zip(batchData, interactiveData).map { abs(Int($0) - Int($1)) }.max() ?? 0
+        XCTAssertLessThanOrEqual(largestDifference, 2, "a batch frame draws what an interactive frame does")
+    }
+
+    func testWriteImagesWritesNumberedPNGsInCameraOrder() async throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        try renderer.add(Self.grid)
+        let batch = try SplatBatchRenderer(renderer: renderer, resolution: SIMD2(32, 24))
+        let cameras = SplatBatchRenderer.Camera.turntable(center: SIMD3(0.175, 0.175, 0), distance: 2,
+                                                          frameCount: 5, aspect: 32.0 / 24.0)
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        let urls = try await batch.writeImages(cameras, to: directory, fileNamePrefix: "turn")
+        XCTAssertEqual(urls.map(\.lastPathComponent), (0..<5).map { "turn000\($0).png" })
+        for url in urls {
+            let source = try XCTUnwrap(CGImageSourceCreateWithURL(url as CFURL, nil))
+            let image = try XCTUnwrap(CGImageSourceCreateImageAtIndex(source, 0, nil))
+            XCTAssertEqual(image.width, 32)
+            XCTAssertEqual(image.height, 24)
+        }
+    }
+
+    func testRenderIntoTexturesLeavesFramesOnTheGPU() async throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        try renderer.add(Self.grid)
+        let batch = try SplatBatchRenderer(renderer: renderer, resolution: SIMD2(32, 32))
+        let cameras = SplatBatchRenderer.Camera.turntable(center: SIMD3(0.175, 0.175, 0), distance: 2,
+                                                          frameCount: 4, aspect: 1)
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .bgra8Unorm, width: 32, height: 32, mipmapped: false)
+        descriptor.usage = .renderTarget
+        descriptor.storageMode = .private
+        let textures = try cameras.map { _ in try XCTUnwrap(renderer.device.makeTexture(descriptor: descriptor)) }
+
+        try await batch.render(cameras, into: textures)
+
+        let queue = try XCTUnwrap(renderer.device.makeCommandQueue())
+        let readback = try XCTUnwrap(renderer.device.makeBuffer(length: 32 * 32 * 4 * textures.count, options: .storageModeShared))
+        let commandBuffer = try XCTUnwrap(queue.makeCommandBuffer())
+        let blitEncoder = try XCTUnwrap(commandBuffer.makeBlitCommandEncoder())
+        for (index, texture) in textures.enumerated() {
+            blitEncoder.copy(from: texture, sourceSlice: 0, sourceLevel: 0,
+                             sourceOrigin: MTLOrigin(x: 0, y: 0, z: 0), sourceSize: MTLSize(width: 32, height: 32, depth: 1),
+                             to: readback, destinationOffset: index * 32 * 32 * 4,
+                             destinationBytesPerRow: 32 * 4, destinationBytesPerImage: 32 * 32 * 4)
+        }
+        blitEncoder.endEncoding()
+        commandBuffer.commit()
+        commandBuffer.waitUntilCompleted()
+
+        let pixels = UnsafeRawBufferPointer(start: readback.contents(), count: readback.length)
+        for index in textures.indices {
+            let frame = pixels[(index * 32 * 32 * 4)..<((index + 1) * 32 * 32 * 4)]
+            XCTAssertTrue(frame.contains { $0 != 0 }, "frame \(index) was drawn")
+        }
+    }
+
+    private static var grid: [SplatScenePoint] {
+        TestScenes.grid(side: 8, spacing: 0.05, opacity: 0.8, scale: 0.03)
+    }
+}
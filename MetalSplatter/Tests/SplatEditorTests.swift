@@ -128,6 +128,47 @@ final class SplatEditorTests: XCTestCase {
         XCTAssertEqual(store.sceneIndices, [0, 1])
     }
 
+    func testPagedArrayCopiesShareUntouchedPages() {
+        let count = PagedArray<UInt32>.pageSize * 3 + 5
+        var array = PagedArray((0..<UInt32(count)).map { $0 })
+        let copy = array
+        XCTAssertEqual(array.pageCount, 4)
+        XCTAssertEqual(array.pagesNotShared(with: copy), 0)
+
+        array[PagedArray<UInt32>.pageSize + 1] = 7
+        XCTAssertEqual(array.pagesNotShared(with: copy), 1)
+        XCTAssertEqual(copy[PagedArray<UInt32>.pageSize + 1], UInt32(PagedArray<UInt32>.pageSize + 1))
+
+        array.removeSubrange((count - 10)...)
+        XCTAssertEqual(array.count, count - 10)
+        XCTAssertEqual(array.last, UInt32(count - 11))
+        XCTAssertEqual(array.pagesNotShared(with: copy), 3, "Only the edited page and the rewritten tail differ")
+        array.append(contentsOf: [1, 2, 3])
+        XCTAssertEqual(Array(array.suffix(4)), [UInt32(count - 11), 1, 2, 3])
+    }
+
+    func testEditableStoreDuplicateRevertAndApplyRoundTrip() throws {
+        var store = EditableSplatStore(points: makePoints(), sceneIndices: [0, 0, 1, 1])
+        _ = store.applySelection(indices: [1, 2], mode: .replace)
+        let before = store.snapshot
+
+        let append = try XCTUnwrap(store.duplicateSelectionRecordingChanges())
+        XCTAssertEqual(append.startIndex, 4)
+        XCTAssertEqual(Array(append.indices), [4, 5])
+        XCTAssertEqual(append.sourceStateChanges.map(\.index), [1, 2])
+
+        store.revert(append)
+        XCTAssertEqual(store.points.count, 4)
+        XCTAssertEqual(store.states, before.states)
+        XCTAssertEqual(store.sceneIndices, [0, 0, 1, 1])
+        XCTAssertEqual(store.selectedIndices, [1, 2])
+
+        store.apply(append)
+        XCTAssertEqual(store.sceneIndices, [0, 0, 1, 1, 0, 1])
+        XCTAssertEqual(store.selectedIndices, [4, 5])
+        XCTAssertEqual(store.points[5].position, store.points[2].position)
+    }
+
     func testEditableStoreSeparateSelectionKeepsOnlySelectedPoints() {
         var store = EditableSplatStore(points: makePoints())
         _ = store.applySelection(indices: [1, 3], mode: .replace)
@@ -584,6 +625,77 @@ final class SplatEditorTests: XCTestCase {
         XCTAssertEqual(reread.count, 3)
     }
 
+    func testDuplicateUndoRedoPatchesRendererTail() async throws {
+        let renderer = try makeRenderer()
+        let editor = try await SplatEditor(points: makePoints(), renderer: renderer)
+        try await editor.selectAll()
+
+        try await editor.duplicateSelection()
+        XCTAssertEqual(renderer.splatCount, 8)
+        XCTAssertEqual(renderer.sourceScenePoints.count, 8)
+        var snapshot = await editor.snapshot()
+        XCTAssertEqual(snapshot.totalCount, 8)
+        XCTAssertEqual(snapshot.selectedCount, 4)
+        XCTAssertEqual(try editStates(of: renderer), [0, 0, 0, 0, 1, 1, 1, 1])
+
+        try await editor.undo()
+        XCTAssertEqual(renderer.splatCount, 4)
+        XCTAssertEqual(renderer.sourceScenePoints.map(\.position), makePoints().map(\.position))
+        XCTAssertEqual(try editStates(of: renderer), [1, 1, 1, 1])
+        snapshot = await editor.snapshot()
+        XCTAssertEqual(snapshot.totalCount, 4)
+        XCTAssertEqual(snapshot.selectedCount, 4)
+
+        try await editor.redo()
+        XCTAssertEqual(renderer.splatCount, 8)
+        XCTAssertEqual(try editStates(of: renderer), [0, 0, 0, 0, 1, 1, 1, 1])
+        snapshot = await editor.snapshot()
+        XCTAssertEqual(snapshot.visibleCount, 8)
+    }
+
+    func testSeparateUndoRedoRestoresScene() async throws {
+        let renderer = try makeRenderer()
+        let editor = try await SplatEditor(points: makePoints(), renderer: renderer)
+        try await editor.select(
+            .rect(normalizedMin: SIMD2<Float>(0.40, 0.40), normalizedMax: SIMD2<Float>(0.60, 0.60)),
+            mode: .replace,
+            viewport: makeViewport()
+        )
+
+        try await editor.separateSelection()
+        XCTAssertEqual(renderer.splatCount, 1)
+        try await editor.undo()
+        XCTAssertEqual(renderer.splatCount, 4)
+        XCTAssertEqual(renderer.sourceScenePoints.map(\.position), makePoints().map(\.position))
+        try await editor.redo()
+        XCTAssertEqual(renderer.splatCount, 1)
+        let snapshot = await editor.snapshot()
+        XCTAssertEqual(snapshot.selectedCount, 1)
+    }
+
+    func testHistoryMemoryLimitDropsOldestUndoSteps() async throws {
+        let renderer = try makeRenderer()
+        let editor = try await SplatEditor(points: makePoints(), renderer: renderer, historyMemoryLimit: 1)
+        try await editor.selectAll()
+        try await editor.hideSelection()
+        try await editor.unhideAll()
+
+        // Only the newest step survives a limit smaller than any one step
+        try await editor.undo()
+        var snapshot = await editor.snapshot()
+        XCTAssertEqual(snapshot.hiddenCount, 4)
+        try await editor.undo()
+        snapshot = await editor.snapshot()
+        XCTAssertEqual(snapshot.hiddenCount, 4)
+
+        await editor.setHistoryMemoryLimit(SplatEditor.defaultHistoryMemoryLimit)
+        try await editor.redo()
+        snapshot = await editor.snapshot()
+        XCTAssertEqual(snapshot.hiddenCount, 0)
+        let byteCount = await editor.historyByteCount
+        XCTAssertGreaterThan(byteCount, 0)
+    }
+
     func testPreviewTransformCommitUndoRedoBakesSelection() async throws {
         let renderer = try makeRenderer()
         let editor = try await SplatEditor(points: makePoints(), renderer: renderer)
@@ -782,6 +894,93 @@ final class SplatEditorTests: XCTestCase {
         XCTAssertEqual(snapshot.selectedCount, 6)
     }
 
+    func testGPUOutlierSelectionMatchesCPUVoxels() async throws {
+        let renderer = try makeRenderer()
+        let editor = try await SplatEditor(points: makeOutlierPoints(), renderer: renderer)
+        await editor.setGPUSelectionThreshold(0)
+
+        try await editor.selectOutliers(config: makeOutlierSelectionConfig(), mode: .replace)
+
+        XCTAssertEqual(try selectedIndices(of: renderer), [6, 7])
+    }
+
+    func testGPUColorMatchMatchesCPUSelection() async throws {
+        let points = [
+            makePoint(position: SIMD3<Float>(0.0, 0.0, -2.0), color: SIMD3<Float>(0.20, 0.40, 0.60)),
+            makePoint(position: SIMD3<Float>(0.1, 0.0, -2.0), color: SIMD3<Float>(0.22, 0.38, 0.61)),
+            makePoint(position: SIMD3<Float>(0.2, 0.0, -2.0), color: SIMD3<Float>(0.20, 0.52, 0.60)),
+            makePoint(position: SIMD3<Float>(0.3, 0.0, -2.0), color: SIMD3<Float>(0.19, 0.39, 0.58))
+        ]
+        let renderer = try makeRenderer()
+        let editor = try await SplatEditor(points: points, renderer: renderer)
+        await editor.setGPUSelectionThreshold(0)
+
+        try await editor.selectColorMatch(normalized: SIMD2<Float>(0.5, 0.5),
+                                          threshold: 0.03,
+                                          mode: .replace,
+                                          viewport: makeViewport())
+
+        let expected = EditableSplatStore(points: points).colorMatchIndices(referenceIndex: 0, threshold: 0.03)
+        XCTAssertEqual(try selectedIndices(of: renderer), expected)
+    }
+
+    func testGPUColorMatchMatchesCPUSelectionForDarkColors() async throws {
+        // Dark channels lose the most precision in 8-bit gamma-expanded storage
+        let colors: [SIMD3<Float>] = [
+            SIMD3(0.05, 0.06, 0.04), SIMD3(0.02, 0.06, 0.04), SIMD3(0.079, 0.031, 0.069),
+            SIMD3(0.081, 0.06, 0.04), SIMD3(0.0, 0.09, 0.01), SIMD3(0.05, 0.06, 0.071)
+        ]
+        let points = colors.enumerated().map { index, color in
+            makePoint(position: SIMD3<Float>(Float(index) * 0.02, 0, -2), color: color)
+        }
+        let renderer = try makeRenderer()
+        let editor = try await SplatEditor(points: points, renderer: renderer)
+        await editor.setGPUSelectionThreshold(0)
+
+        try await editor.selectColorMatch(normalized: SIMD2<Float>(0.5, 0.5),
+                                          threshold: 0.03,
+                                          mode: .replace,
+                                          viewport: makeViewport())
+
+        let expected = EditableSplatStore(points: points).colorMatchIndices(referenceIndex: 0, threshold: 0.03)
+        XCTAssertEqual(try selectedIndices(of: renderer), expected)
+    }
+
+    func testStoredColorMatchBoundsHoldEveryPackedMatch() {
+        let reference = SIMD3<Float>(0.05, 0.5, 0.97)
+        let threshold: Float = 0.03
+        let bounds = SplatSelectionEngine.storedColorMatchBounds(reference: reference, threshold: threshold)
+        for step in 0...60 {
+            let offset = -threshold + Float(step) / 60 * 2 * threshold
+            let color = simd_clamp(reference + offset, SIMD3<Float>(repeating: 0), SIMD3<Float>(repeating: 1))
+            let packed = SplatRenderer.Splat(position: .zero, color: SIMD4(color.sRGBToLinear, 1),
+                                             scale: SIMD3(repeating: 0.01), rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1))
+                .packedColor
+            let stored = SIMD3<Float>(Float(packed & 0xFF), Float((packed >> 8) & 0xFF), Float((packed >> 16) & 0xFF)) / 255
+            XCTAssertTrue(all(stored .>= bounds.lower) && all(stored .<= bounds.upper), "\(color)")
+        }
+    }
+
+    func testGPUFloodFillMatchesCPUSelection() async throws {
+        let points = [
+            makePoint(position: SIMD3<Float>(0.00, 0.00, -2.0), color: SIMD3<Float>(1.0, 0.0, 0.0), opacity: 0.20),
+            makePoint(position: SIMD3<Float>(0.03, 0.00, -2.0), color: SIMD3<Float>(0.9, 0.1, 0.0), opacity: 0.24),
+            makePoint(position: SIMD3<Float>(0.06, 0.00, -2.0), color: SIMD3<Float>(0.8, 0.2, 0.0), opacity: 0.22),
+            makePoint(position: SIMD3<Float>(0.45, 0.00, -2.0), color: SIMD3<Float>(0.7, 0.3, 0.0), opacity: 0.21),
+            makePoint(position: SIMD3<Float>(0.02, 0.02, -2.0), color: SIMD3<Float>(0.6, 0.4, 0.0), opacity: 0.80)
+        ]
+        let renderer = try makeRenderer()
+        let editor = try await SplatEditor(points: points, renderer: renderer)
+        await editor.setGPUSelectionThreshold(0)
+
+        try await editor.selectFloodFill(normalized: SIMD2<Float>(0.5, 0.5),
+                                         threshold: 0.08,
+                                         mode: .replace,
+                                         viewport: makeViewport())
+
+        XCTAssertEqual(try selectedIndices(of: renderer), [0, 1, 2])
+    }
+
     func testPointPickingReturnsNearestVisibleSplatWithoutChangingSelection() async throws {
         let renderer = try makeRenderer()
         let editor = try await SplatEditor(points: makePoints(), renderer: renderer)
@@ -910,6 +1109,16 @@ final class SplatEditorTests: XCTestCase {
         }
     }
 
+    private func editStates(of renderer: SplatRenderer) throws -> [UInt8] {
+        let buffer = try XCTUnwrap(renderer.editStateBuffer)
+        let states = buffer.contents().bindMemory(to: UInt8.self, capacity: renderer.splatCount)
+        return (0..<renderer.splatCount).map { states[$0] }
+    }
+
+    private func selectedIndices(of renderer: SplatRenderer) throws -> [Int] {
+        try editStates(of: renderer).enumerated().compactMap { $0.element & 1 != 0 ? $0.offset : nil }
+    }
+
     private func makeViewport() -> SplatRenderer.ViewportDescriptor {
         SplatRenderer.ViewportDescriptor(
             viewport: MTLViewport(originX: 0, originY: 0, width: 256, height: 256, znear: 0, zfar: 1),
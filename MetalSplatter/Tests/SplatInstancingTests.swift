@@ -0,0 +1,179 @@
+import XCTest
+import Metal
+import simd
+@testable import MetalSplatter
+import SplatIO
+
+final class SplatInstancingTests: XCTestCase {
+    func testLODStrideThinsInstancesThatDrawMoreSplatsThanPixels() {
+        // 100K splats in a 1-unit sphere, 500 px per unit of radius / distance
+        XCTAssertEqual(SplatInstanceSet.lodStride(splatCount: 100_000, radius: 1, distance: 2,
+                                                  projectionScale: 500, splatsPerPixel: 4), 1)
+        // 25 px radius: ~1960 px covered, ~51 splats per pixel against a budget of 4
+        XCTAssertEqual(SplatInstanceSet.lodStride(splatCount: 100_000, radius: 1, distance: 20,
+                                                  projectionScale: 500, splatsPerPixel: 4), 8)
+        XCTAssertEqual(SplatInstanceSet.lodStride(splatCount: 100_000, radius: 1, distance: 2000,
+                                                  projectionScale: 500, splatsPerPixel: 4),
+                       SplatInstanceSet.maximumLODStride)
+        XCTAssertEqual(SplatInstanceSet.lodStride(splatCount: 100_000, radius: 1, distance: 2000,
+                                                  projectionScale: 500, splatsPerPixel: 0), 1)
+        XCTAssertEqual(SplatInstanceSet.lodStride(splatCount: 100_000, radius: 1, distance: 0.5,
+                                                  projectionScale: 500, splatsPerPixel: 4), 1, "camera inside the instance")
+    }
+
+    func testVisibleInstancesCullOutsideEveryView() {
+        let bounds = (min: SIMD3<Float>(repeating: -0.5), max: SIMD3<Float>(repeating: 0.5))
+        let transforms = [
+            Self.translation(0, 0, -5),   // in front
+            Self.translation(40, 0, -5),  // far off to the side
+            Self.translation(0, 0, 5),    // behind the camera
+            Self.translation(1, 0, -5),
+        ]
+        let viewProjection = GPUPerformanceProfiler.perspective(fovY: .pi / 3, aspect: 1, near: 0.1, far: 100)
+
+        let visible = SplatInstanceSet.visibleInstances(transforms: transforms, bounds: bounds,
+                                                        viewProjections: [viewProjection],
+                                                        cameraPosition: .zero, projectionScale: 0,
+                                                        splatCount: 16, splatsPerPixel: 4)
+        XCTAssertEqual(visible.map(\.instance), [0, 3])
+        XCTAssertTrue(visible.allSatisfy { $0.lodStride == 1 })
+
+        let unculled = SplatInstanceSet.visibleInstances(transforms: transforms, bounds: bounds,
+                                                         viewProjections: [], cameraPosition: .zero,
+                                                         projectionScale: 0, splatCount: 16, splatsPerPixel: 4)
+        XCTAssertEqual(unculled.count, transforms.count)
+
+        // A second view looking along +z keeps the instance behind the first
+        let turned = viewProjection * Self.rotationY(.pi)
+        let stereo = SplatInstanceSet.visibleInstances(transforms: transforms, bounds: bounds,
+                                                       viewProjections: [viewProjection, turned],
+                                                       cameraPosition: .zero, projectionScale: 0,
+                                                       splatCount: 16, splatsPerPixel: 4)
+        XCTAssertEqual(stereo.map(\.instance), [0, 2, 3])
+
+        XCTAssertEqual(SplatInstanceSet.maximumInstanceCount(splatCount: 1 << 20), 2047)
+    }
+
+    func testInstancesDrawFromTheSharedSplatBuffer() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        try renderer.add((0..<64).map { index in
+            SplatScenePoint(position: SIMD3<Float>(Float(index % 8) * 0.05, Float(index / 8) * 0.05, 0),
+                            color: .linearFloat(SIMD3<Float>(repeating: 0.5)),
+                            opacity: .linearFloat(0.5),
+                            scale: .linearFloat(SIMD3<Float>(repeating: 0.02)),
+                            rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1))
+        })
+        try renderer.setSplatInstances([Self.translation(-1, 0, -4), Self.translation(1, 0, -4), Self.translation(0, 0, 4)])
+        XCTAssertEqual(renderer.splatInstanceCount, 3)
+        XCTAssertEqual(renderer.splatCount, 64, "instances do not copy splats")
+
+        let device = renderer.device
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .bgra8Unorm, width: 64, height: 64, mipmapped: false)
+        descriptor.usage = .renderTarget
+        descriptor.storageMode = .private
+        let colorTexture = try XCTUnwrap(device.makeTexture(descriptor: descriptor))
+        let queue = try XCTUnwrap(device.makeCommandQueue())
+        let viewport = SplatRenderer.ViewportDescriptor(
+            viewport: MTLViewport(originX: 0, originY: 0, width: 64, height: 64, znear: 0, zfar: 1),
+            projectionMatrix: GPUPerformanceProfiler.perspective(fovY: .pi / 2, aspect: 1, near: 0.1, far: 100),
+            viewMatrix: matrix_identity_float4x4,
+            screenSize: SIMD2(64, 64))
+
+        let commandBuffer = try XCTUnwrap(queue.makeCommandBuffer())
+        try renderer.render(viewports: [viewport],
+                            colorTexture: colorTexture,
+                            colorStoreAction: .store,
+                            depthTexture: nil,
+                            rasterizationRateMap: nil,
+                            renderTargetArrayLength: 0,
+                            to: commandBuffer)
+        commandBuffer.commit()
+        commandBuffer.waitUntilCompleted()
+        XCTAssertEqual(commandBuffer.status, .completed)
+        XCTAssertEqual(renderer.visibleSplatInstanceCount, 2, "the instance behind the camera is culled")
+
+        renderer.removeSplatInstances()
+        XCTAssertEqual(renderer.splatInstanceCount, 0)
+        XCTAssertEqual(renderer.visibleSplatInstanceCount, 0)
+    }
+
+    func testKeptPairsAreCompactedPerInstance() {
+        let visible = [SplatInstanceSet.VisibleInstance(instance: 0, lodStride: 1),
+                       SplatInstanceSet.VisibleInstance(instance: 3, lodStride: 4),
+                       SplatInstanceSet.VisibleInstance(instance: 5, lodStride: 16)]
+        XCTAssertEqual(SplatInstanceSet.pairOffsets(visible, splatCount: 10), [0, 10, 13, 14])
+        XCTAssertEqual(SplatInstanceSet.keptPairCount(splatCount: 0, lodStride: 4), 0)
+    }
+
+    func testSortBudgetCoarsensStridesBeforeDroppingInstances() {
+        let visible = (0..<4).map { SplatInstanceSet.VisibleInstance(instance: UInt32($0), lodStride: $0 == 3 ? 16 : 1) }
+        let coarsened = SplatInstanceSet.fittingSortBudget(visible, splatCount: 1600, maximumPairCount: 1000)
+        XCTAssertEqual(coarsened.map(\.lodStride), [8, 8, 8, 16], "3 × 200 + 100 pairs fit")
+
+        let dropped = SplatInstanceSet.fittingSortBudget(visible, splatCount: 1600, maximumPairCount: 250)
+        XCTAssertEqual(dropped.map(\.instance), [0, 1])
+        XCTAssertTrue(dropped.allSatisfy { $0.lodStride == SplatInstanceSet.maximumLODStride })
+
+        XCTAssertEqual(SplatInstanceSet.fittingSortBudget(visible, splatCount: 1600, maximumPairCount: .max), visible)
+    }
+
+    func testSortOnlyKeysTheKeptSplats() throws {
+        let renderer = try makeRendererOrSkip(depthFormat: .invalid)
+        renderer.mortonOrderingEnabled = false
+        try renderer.add((0..<10).map { index in
+            SplatScenePoint(position: SIMD3<Float>(Float(index) * 0.1, 0, -2),
+                            color: .linearFloat(SIMD3<Float>(repeating: 0.5)),
+                            opacity: .linearFloat(0.5),
+                            scale: .linearFloat(SIMD3<Float>(repeating: 0.02)),
+                            rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1))
+        })
+        let instanceSet = try SplatInstanceSet(device: renderer.device, library: renderer.library,
+                                               transforms: [Self.translation(0, 0, 0), Self.translation(0, 0, -1)])
+        let queue = try XCTUnwrap(renderer.device.makeCommandQueue())
+        let commandBuffer = try XCTUnwrap(queue.makeCommandBuffer())
+        try instanceSet.encodeSortIfNeeded(commandBuffer: commandBuffer,
+                                           splatBuffer: renderer.splatBuffer.buffer,
+                                           editStateBuffer: nil,
+                                           splatCount: 10,
+                                           dataRevision: 0,
+                                           visibleInstances: [.init(instance: 0, lodStride: 1), .init(instance: 1, lodStride: 4)],
+                                           cameraPosition: .zero,
+                                           cameraForward: SIMD3(0, 0, -1),
+                                           sortByDistance: true,
+                                           positionEpsilon: 0,
+                                           directionEpsilon: 0)
+        XCTAssertEqual(instanceSet.drawKeyCount, 13)
+        let keyLength = instanceSet.drawKeyCount * MemoryLayout<Int32>.stride
+        let readback = try XCTUnwrap(renderer.device.makeBuffer(length: keyLength, options: .storageModeShared))
+        let blit = try XCTUnwrap(commandBuffer.makeBlitCommandEncoder())
+        blit.copy(from: try XCTUnwrap(instanceSet.sortedKeyBuffer), sourceOffset: 0, to: readback, destinationOffset: 0, size: keyLength)
+        blit.endEncoding()
+        commandBuffer.commit()
+        commandBuffer.waitUntilCompleted()
+        XCTAssertEqual(commandBuffer.status, .completed)
+
+        let keys = Array(UnsafeBufferPointer(start: readback.contents().bindMemory(to: Int32.self, capacity: 13), count: 13))
+        XCTAssertEqual(Set(keys), Set(Array(0..<10) + [10, 14, 18]))
+        XCTAssertEqual(keys.first, 18, "the farthest pair, instance 1's splat 8, draws first")
+    }
+
+    func testFastSHRendererRejectsInstances() throws {
+        let renderer = try makeFastSHRendererOrSkip(depthFormat: .invalid)
+        XCTAssertThrowsError(try renderer.setSplatInstances([matrix_identity_float4x4])) { error in
+            guard case SplatRendererError.splatInstancesUnsupported = error else {
+                return XCTFail("Unexpected error \(error)")
+            }
+        }
+        XCTAssertEqual(renderer.splatInstanceCount, 0)
+    }
+
+    private static func translation(_ x: Float, _ y: Float, _ z: Float) -> simd_float4x4 {
+        var matrix = matrix_identity_float4x4
+        matrix.columns.3 = SIMD4(x, y, z, 1)
+        return matrix
+    }
+
+    private static func rotationY(_ angle: Float) -> simd_float4x4 {
+        simd_float4x4(simd_quatf(angle: angle, axis: SIMD3(0, 1, 0)))
+    }
+}
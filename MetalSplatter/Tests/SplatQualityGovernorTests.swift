@@ -0,0 +1,138 @@
+import XCTest
+import Metal
+@testable import MetalSplatter
+
+final class SplatQualityGovernorTests: XCTestCase {
+    func testDowngradesWhileOverBudget() {
+        let governor = SplatQualityGovernor(targetFrameRate: 60, thermalStateProvider: { .nominal })
+        var decisions: [SplatQualityGovernor.Decision] = []
+
+        let end = feedFrames(governor, gpuTime: 0.025, from: 100, duration: 0.4)
+        XCTAssertEqual(governor.level, 1)
+        decisions = governor.recentDecisions()
+        XCTAssertEqual(decisions.count, 1)
+        XCTAssertEqual(decisions.first?.reason, .overBudget)
+        XCTAssertEqual(decisions.first?.previousLevel, 0)
+        XCTAssertGreaterThan(decisions.first?.measuredFrameTime ?? 0, governor.targetFrameTime)
+
+        // Still over budget: keeps stepping down, no faster than the downgrade cooldown
+        _ = feedFrames(governor, gpuTime: 0.025, from: end, duration: 3)
+        XCTAssertEqual(governor.level, governor.ladder.count - 1)
+        decisions = governor.recentDecisions()
+        for (earlier, later) in zip(decisions, decisions.dropFirst()) {
+            XCTAssertGreaterThanOrEqual(later.time - earlier.time, governor.downgradeCooldown - 1e-9)
+        }
+    }
+
+    func testSortTimeIsChargedToTheNextFrame() {
+        let governor = SplatQualityGovernor(targetFrameRate: 120, thermalStateProvider: { .nominal })
+        governor.recordSort(gpuTime: 0.004)
+        governor.recordFrame(gpuTime: 0.002, cpuTime: 0.001, at: 100)
+        XCTAssertEqual(governor.measuredFrameTime, 0.006, accuracy: 1e-9)
+    }
+
+    func testUpgradesAfterHeadroomAndCooldown() {
+        let governor = SplatQualityGovernor(targetFrameRate: 90, thermalStateProvider: { .nominal })
+        var time = feedFrames(governor, gpuTime: 0.02, from: 100, duration: 0.4)
+        XCTAssertEqual(governor.level, 1)
+        let downgradeTime = time
+
+        // Cheap frames, but not for long enough to clear the upgrade cooldown
+        time = feedFrames(governor, gpuTime: 0.003, from: time, duration: governor.upgradeCooldown - 0.5)
+        XCTAssertEqual(governor.level, 1)
+
+        time = feedFrames(governor, gpuTime: 0.003, from: time, duration: 1)
+        XCTAssertEqual(governor.level, 0)
+        let upgrade = governor.recentDecisions().last
+        XCTAssertEqual(upgrade?.reason, .underBudget)
+        XCTAssertGreaterThanOrEqual((upgrade?.time ?? 0) - downgradeTime, governor.upgradeCooldown - 0.3)
+    }
+
+    func testThermalStateSetsAFloor() {
+        let governor = SplatQualityGovernor(targetFrameRate: 60, thermalStateProvider: { .serious })
+        _ = feedFrames(governor, gpuTime: 0.001, from: 100, duration: 5)
+        XCTAssertEqual(governor.level, 2)
+        XCTAssertEqual(governor.recentDecisions().first?.reason, .thermal(.serious))
+        XCTAssertEqual(governor.recentDecisions().count, 1)
+    }
+
+    func testLevelFloorCapsQuality() {
+        let governor = SplatQualityGovernor(targetFrameRate: 60, thermalStateProvider: { .nominal })
+        governor.levelFloor = 1
+        governor.recordFrame(gpuTime: 0.001, cpuTime: 0.001, at: 100)
+        XCTAssertEqual(governor.level, 1)
+        XCTAssertEqual(governor.recentDecisions().last?.reason, .levelFloor)
+
+        governor.levelFloor = 99
+        XCTAssertEqual(governor.levelFloor, governor.ladder.count - 1)
+    }
+
+    func testRendererOverlaysGovernedSettingsWithoutChangingKnobs() throws {
+        let renderer = try makeRendererOrSkip()
+        let reduced = SplatQualityGovernor.Settings(sortEpsilonScale: 4, singleStageDepth: true, ditheredTransparency: true)
+        let governor = SplatQualityGovernor(targetFrameRate: 60, ladder: [.full, reduced], thermalStateProvider: { .nominal })
+        renderer.qualityGovernor = governor
+        renderer.applyQualityGovernorIfNeeded()
+        XCTAssertEqual(renderer.governedSettings, .full)
+        XCTAssertFalse(renderer.drawsDitheredTransparency)
+
+        governor.levelFloor = 1
+        governor.recordFrame(gpuTime: 0.001, cpuTime: 0.001, at: 100)
+        renderer.applyQualityGovernorIfNeeded()
+        XCTAssertEqual(renderer.governedSettings, reduced)
+        XCTAssertTrue(renderer.drawsDitheredTransparency)
+        XCTAssertFalse(renderer.useMultiStagePipeline)
+        XCTAssertFalse(renderer.useDitheredTransparency)
+        XCTAssertTrue(renderer.highQualityDepth)
+
+        renderer.qualityGovernor = nil
+        renderer.applyQualityGovernorIfNeeded()
+        XCTAssertEqual(renderer.governedSettings, .full)
+        XCTAssertFalse(renderer.drawsDitheredTransparency)
+#if !targetEnvironment(simulator)
+        XCTAssertTrue(renderer.useMultiStagePipeline)
+#endif
+    }
+
+    func testSelectionProjectsWithTheGovernedCovarianceBlur() throws {
+        let renderer = try makeRendererOrSkip()
+        renderer.covarianceBlur = 0.3
+        let reduced = SplatQualityGovernor.Settings(covarianceBlurScale: 2)
+        let governor = SplatQualityGovernor(targetFrameRate: 60, ladder: [.full, reduced], thermalStateProvider: { .nominal })
+        renderer.qualityGovernor = governor
+        governor.levelFloor = 1
+        governor.recordFrame(gpuTime: 0.001, cpuTime: 0.001, at: 100)
+        renderer.applyQualityGovernorIfNeeded()
+        XCTAssertEqual(renderer.governedCovarianceBlur, 0.6, accuracy: 1e-6)
+        XCTAssertEqual(renderer.covarianceBlur, 0.3)
+    }
+
+    func testGovernedFrameIsReportedWhenItsCommandBufferCompletes() throws {
+        let renderer = try makeRendererOrSkip()
+        let governor = SplatQualityGovernor(targetFrameRate: 60, thermalStateProvider: { .nominal })
+        let commandBuffer = try XCTUnwrap(renderer.device.makeCommandQueue()?.makeCommandBuffer())
+        renderer.reportGovernedFrame(to: governor, cpuEncodeDuration: 0.004, commandBuffer: commandBuffer)
+        XCTAssertEqual(governor.measuredFrameTime, 0)
+
+        // Completed handlers run in the order they were added
+        let completed = expectation(description: "Command buffer completed")
+        commandBuffer.addCompletedHandler { _ in completed.fulfill() }
+        commandBuffer.commit()
+        wait(for: [completed], timeout: 5)
+        XCTAssertGreaterThanOrEqual(governor.measuredFrameTime, 0.004)
+    }
+
+    /// Reports a 60 Hz stream of frames with a fixed GPU time; returns the time after the last one
+    @discardableResult
+    private func feedFrames(_ governor: SplatQualityGovernor,
+                            gpuTime: TimeInterval,
+                            from start: CFAbsoluteTime,
+                            duration: TimeInterval) -> CFAbsoluteTime {
+        var time = start
+        while time < start + duration {
+            governor.recordFrame(gpuTime: gpuTime, cpuTime: 0.001, at: time)
+            time += 1.0 / 60
+        }
+        return time
+    }
+}
@@ -0,0 +1,63 @@
+import XCTest
+import simd
+@testable import MetalSplatter
+
+final class StereoSortErrorTests: XCTestCase {
+    private let forward = SIMD3<Float>(0, 0, -1)
+
+    private func orderingError(order: [Int32],
+                               positions: [SIMD3<Float>],
+                               sortCamera: SIMD3<Float>,
+                               eye: SIMD3<Float>,
+                               sortByDistance: Bool = true) -> Float {
+        order.withUnsafeBufferPointer { indices in
+            SplatRenderer.stereoOrderingError(
+                sortedIndices: indices,
+                splatCount: positions.count,
+                position: { positions[$0] },
+                sortCamera: SplatRenderer.StereoSortEye(position: sortCamera, forward: forward),
+                eye: SplatRenderer.StereoSortEye(position: eye, forward: forward),
+                sortByDistance: sortByDistance,
+                maxSamples: 1024
+            )
+        }
+    }
+
+    func testSameCameraHasNoError() {
+        let positions = (0..<16).map { SIMD3<Float>(Float($0 % 4), Float($0 / 4), -Float($0) - 1) }
+        let order = (0..<16).reversed().map { Int32($0) }
+
+        XCTAssertEqual(orderingError(order: order, positions: positions, sortCamera: .zero, eye: .zero), 0)
+    }
+
+    func testCountsPairsOrderedDifferentlyForEachEye() {
+        // Seen from the midpoint, a is marginally farther than b; the left eye sees b farther, the right eye agrees
+        let positions: [SIMD3<Float>] = [SIMD3(-1, 0, -5.01), SIMD3(1, 0, -5)]
+        let order: [Int32] = [0, 1]
+
+        let left = orderingError(order: order, positions: positions, sortCamera: .zero, eye: SIMD3(-0.5, 0, 0))
+        let right = orderingError(order: order, positions: positions, sortCamera: .zero, eye: SIMD3(0.5, 0, 0))
+
+        XCTAssertEqual(left, 1)
+        XCTAssertEqual(right, 0)
+    }
+
+    func testLinearDepthIgnoresLateralEyeOffset() {
+        let positions: [SIMD3<Float>] = [SIMD3(-1, 0, -5.01), SIMD3(1, 0, -5)]
+
+        let error = orderingError(order: [0, 1],
+                                  positions: positions,
+                                  sortCamera: .zero,
+                                  eye: SIMD3(-0.5, 0, 0),
+                                  sortByDistance: false)
+
+        XCTAssertEqual(error, 0)
+    }
+
+    func testSkipsInvalidIndicesAndTinyOrders() {
+        let positions: [SIMD3<Float>] = [SIMD3(0, 0, -1), SIMD3(0, 0, -2)]
+
+        XCTAssertEqual(orderingError(order: [1], positions: positions, sortCamera: .zero, eye: .zero), 0)
+        XCTAssertEqual(orderingError(order: [1, 7, -1], positions: positions, sortCamera: .zero, eye: SIMD3(1, 0, 0)), 0)
+    }
+}
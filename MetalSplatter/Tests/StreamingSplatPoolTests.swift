@@ -0,0 +1,144 @@
+import XCTest
+import Metal
+import simd
+import SplatIO
+@testable import MetalSplatter
+
+final class StreamingSplatPoolTests: XCTestCase {
+
+    private func makeSplats(_ count: Int) -> [SplatRenderer.Splat] {
+        (0..<count).map { i in
+            SplatRenderer.Splat(SplatScenePoint(
+                position: SIMD3<Float>(Float(i), 0, 0),
+                color: .linearFloat(SIMD3<Float>(repeating: 0.5)),
+                opacity: .linearFloat(1),
+                scale: .linearFloat(SIMD3<Float>(repeating: 0.1)),
+                rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1)
+            ))
+        }
+    }
+
+    private func makePool(slabCapacity: Int, maxSlabs: Int) throws -> StreamingSplatPool {
+        guard let device = MTLCreateSystemDefaultDevice() else {
+            throw XCTSkip("Metal device not available")
+        }
+        let slabBytes = slabCapacity * MemoryLayout<SplatRenderer.Splat>.stride
+        let pool = StreamingSplatPool(device: device, slabCapacity: slabCapacity, memoryBudget: maxSlabs * slabBytes)
+        pool.retireFrameLatency = 2
+        return pool
+    }
+
+    func testUploadSplitsPayloadIntoSlabs() throws {
+        let pool = try makePool(slabCapacity: 16, maxSlabs: 4)
+
+        let slabs = try pool.upload(makeSplats(40), nodeID: "a", lodLevel: 1)
+
+        XCTAssertEqual(slabs.map(\.count), [16, 16, 8])
+        XCTAssertEqual(pool.residentSlabCount, 3)
+        XCTAssertEqual(pool.freeSlabCount, 1)
+        for (index, slab) in slabs.enumerated() {
+            XCTAssertEqual(slab.globalStart, slab.slot * 16)
+            XCTAssertEqual(slab.lodLevel, 1)
+            XCTAssertEqual(pool.nodeID(forGlobalIndex: slab.globalStart), "a")
+            let buffer = try XCTUnwrap(pool.buffer(forSlot: slab.slot))
+            let splats = buffer.contents().bindMemory(to: SplatRenderer.Splat.self, capacity: slab.count)
+            XCTAssertEqual(splats[0].position.x, Float(index * 16), "slab \(index) holds its own slice")
+            XCTAssertEqual(splats[slab.count - 1].position.x, Float(index * 16 + slab.count - 1))
+        }
+    }
+
+    func testUploadBeyondCapacityThrows() throws {
+        let pool = try makePool(slabCapacity: 16, maxSlabs: 2)
+
+        try pool.upload(makeSplats(20), nodeID: "a", lodLevel: 0)
+
+        XCTAssertThrowsError(try pool.upload(makeSplats(1), nodeID: "b", lodLevel: 0))
+        XCTAssertEqual(pool.slabs(for: "a").count, 2)
+        XCTAssertTrue(pool.slabs(for: "b").isEmpty)
+    }
+
+    func testReuploadReplacesNodeSlabs() throws {
+        let pool = try makePool(slabCapacity: 16, maxSlabs: 3)
+
+        try pool.upload(makeSplats(32), nodeID: "a", lodLevel: 0)
+        let replaced = try pool.upload(makeSplats(8), nodeID: "a", lodLevel: 2)
+
+        XCTAssertEqual(replaced.count, 1)
+        XCTAssertEqual(pool.slabs(for: "a").map(\.lodLevel), [2])
+        XCTAssertEqual(pool.residentSlabCount, 1)
+        XCTAssertEqual(pool.retiredSlabCount, 2, "the replaced slabs wait out the retire latency")
+        XCTAssertEqual(pool.freeSlabCount, 0)
+    }
+
+    func testEvictFreesSlotsForReuse() throws {
+        let pool = try makePool(slabCapacity: 16, maxSlabs: 1)
+
+        let first = try pool.upload(makeSplats(4), nodeID: "a", lodLevel: 0)
+        let evicted = pool.evict(nodeID: "a")
+
+        XCTAssertEqual(evicted.map(\.slot), first.map(\.slot))
+        XCTAssertNil(pool.nodeID(forGlobalIndex: first[0].globalStart))
+        // The evicted slab is still allocated until it retires, so it still counts against the budget
+        XCTAssertEqual(pool.freeSlabCount, 0)
+        XCTAssertEqual(pool.allocatedBytes, pool.slabByteSize)
+        XCTAssertThrowsError(try pool.upload(makeSplats(4), nodeID: "b", lodLevel: 0))
+
+        for _ in 0..<2 {
+            pool.advanceFrame()
+        }
+        XCTAssertEqual(pool.freeSlabCount, 1)
+        XCTAssertEqual(pool.allocatedBytes, 0)
+
+        let second = try pool.upload(makeSplats(4), nodeID: "b", lodLevel: 0)
+        XCTAssertEqual(second[0].slot, first[0].slot)
+        XCTAssertEqual(pool.nodeID(forGlobalIndex: second[0].globalStart), "b")
+        XCTAssertEqual(pool.residentSlabCount, 1)
+    }
+
+    func testReuploadedSlotGetsANewUploadID() throws {
+        let pool = try makePool(slabCapacity: 16, maxSlabs: 1)
+        let first = try pool.upload(makeSplats(4), nodeID: "a", lodLevel: 0)
+        let firstID = try XCTUnwrap(pool.uploadedBuffer(forSlot: first[0].slot)).uploadID
+        pool.evict(nodeID: "a")
+        for _ in 0..<2 {
+            pool.advanceFrame()
+        }
+
+        let second = try pool.upload(makeSplats(4), nodeID: "b", lodLevel: 0)
+        XCTAssertEqual(second[0].slot, first[0].slot)
+        XCTAssertNotEqual(try XCTUnwrap(pool.uploadedBuffer(forSlot: second[0].slot)).uploadID, firstID)
+    }
+
+    // MARK: - Draw Layout
+
+    func testDrawLayoutCopiesOnlySlabsNewToTheDraw() {
+        var layout = StreamingDrawLayout(pageCapacity: 16)
+
+        let initial = layout.place([1, 2, 3])
+        XCTAssertEqual(initial.copies.map(\.page), [0, 1, 2])
+        XCTAssertTrue(initial.clears.isEmpty)
+        XCTAssertEqual(layout.splatCount, 48)
+
+        // 2 leaves and 4 joins: 4 takes 2's page, 1 and 3 stay put
+        let swapped = layout.place([3, 4, 1])
+        XCTAssertEqual(swapped.copies.map(\.slab), [1])
+        XCTAssertEqual(swapped.copies.map(\.page), [1])
+        XCTAssertTrue(swapped.clears.isEmpty)
+
+        XCTAssertTrue(layout.place([1, 4, 3]).isEmpty, "reordering the same slabs copies nothing")
+    }
+
+    func testDrawLayoutClearsInnerPagesAndDropsTrailingOnes() {
+        var layout = StreamingDrawLayout(pageCapacity: 16)
+        _ = layout.place([1, 2, 3])
+
+        let inner = layout.place([1, 3])
+        XCTAssertTrue(inner.copies.isEmpty)
+        XCTAssertEqual(inner.clears, [1])
+        XCTAssertEqual(layout.pageCount, 3)
+
+        let trailing = layout.place([1])
+        XCTAssertTrue(trailing.clears.isEmpty)
+        XCTAssertEqual(layout.pageCount, 1, "free pages at the end leave the draw")
+    }
+}
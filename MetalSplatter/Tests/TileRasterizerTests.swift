@@ -0,0 +1,27 @@
+import XCTest
+@testable import MetalSplatter
+
+final class TileRasterizerTests: XCTestCase {
+    func testTileCountRoundsUpPartialTiles() throws {
+        guard #available(iOS 26.0, macOS 26.0, visionOS 26.0, *) else { throw XCTSkip("Requires Metal 4") }
+        XCTAssertEqual(TileRasterizer.tileCount(screenSize: SIMD2(1920, 1080)), SIMD2(120, 68))
+        XCTAssertEqual(TileRasterizer.tileCount(screenSize: SIMD2(16, 17)), SIMD2(1, 2))
+    }
+
+    func testDepthBitsReserveTheEmptyKeyTile() throws {
+        guard #available(iOS 26.0, macOS 26.0, visionOS 26.0, *) else { throw XCTSkip("Requires Metal 4") }
+        // 8160 tiles need 13 bits
+        XCTAssertEqual(TileRasterizer.depthBits(tileCount: 120 * 68), 19)
+        // A power-of-two tile count needs one more bit, so the all-ones tile stays free for empty slots
+        XCTAssertEqual(TileRasterizer.depthBits(tileCount: 4096), 19)
+        XCTAssertEqual(TileRasterizer.depthBits(tileCount: 4095), 20)
+        XCTAssertNil(TileRasterizer.depthBits(tileCount: 1 << 16))
+    }
+
+    func testEntryCapacityGrowsFromLastFrameAndClamps() throws {
+        guard #available(iOS 26.0, macOS 26.0, visionOS 26.0, *) else { throw XCTSkip("Requires Metal 4") }
+        XCTAssertEqual(TileRasterizer.entryCapacity(splatCount: 1000, lastEntryCount: 0, maximum: 1 << 24), 4096)
+        XCTAssertEqual(TileRasterizer.entryCapacity(splatCount: 1000, lastEntryCount: 8000, maximum: 1 << 24), 10_240)
+        XCTAssertEqual(TileRasterizer.entryCapacity(splatCount: 1000, lastEntryCount: 8000, maximum: 5000), 5000)
+    }
+}
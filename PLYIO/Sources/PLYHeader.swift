@@ -31,6 +31,26 @@ public struct PLYHeader: Equatable, Sendable {
         public func index(forPropertyNamed name: String) -> Int? {
             properties.firstIndex { $0.name == name }
         }
+
+        /// Size in bytes of one binary element, or nil if any property is a list (variable-size)
+        public var fixedByteStride: Int? {
+            var stride = 0
+            for property in properties {
+                guard case .primitive(let type) = property.type else { return nil }
+                stride += type.byteWidth
+            }
+            return stride
+        }
+
+        /// Byte offset of a property within one binary element, or nil if a list property precedes it
+        public func byteOffset(forPropertyAt index: Int) -> Int? {
+            var offset = 0
+            for property in properties[..<index] {
+                guard case .primitive(let type) = property.type else { return nil }
+                offset += type.byteWidth
+            }
+            return offset
+        }
     }
 
     public enum PropertyType: Equatable, Sendable {
@@ -77,6 +77,31 @@ public class PLYReader {
         self.sourceURL = url
     }
 
+    /// Decodes the header at the start of an in-memory (typically memory-mapped) PLY file.
+    /// - Returns: The header and the byte offset at which the element body begins
+    public static func decodeHeader(fromPrefixOf data: Data) throws -> (header: PLYHeader, bodyOffset: Int) {
+        guard data.starts(with: Constants.headerStartKeyword) else {
+            throw Error.headerStartMissing
+        }
+
+        let searchEnd = min(data.endIndex, data.startIndex + Constants.maxHeaderSize)
+        var lineStart = data.startIndex
+        while let lineFeed = data[lineStart..<searchEnd].firstIndex(of: Constants.lf) {
+            var lineEnd = lineFeed
+            if lineEnd > lineStart && data[data.index(before: lineEnd)] == Constants.cr {
+                lineEnd = data.index(before: lineEnd)
+            }
+            let nextLineStart = data.index(after: lineFeed)
+            if data[lineStart..<lineEnd].elementsEqual(Constants.headerEndKeyword) {
+                let header = try PLYHeader.decodeASCII(from: Data(data[data.startIndex..<nextLineStart]))
+                return (header, nextLineStart - data.startIndex)
+            }
+            lineStart = nextLineStart
+        }
+
+        throw searchEnd < data.endIndex ? Error.headerTooLarge : Error.headerEndMissing
+    }
+
     public func read(to delegate: PLYReaderDelegate) {
         header = nil
         body = Data()
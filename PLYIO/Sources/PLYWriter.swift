@@ -164,6 +164,70 @@ public class PLYWriter {
         }
     }
 
+    /// Encodes elements of one element group into the bytes write(encoded:elementCount:) expects, without writing them.
+    /// Touches no writer state, so batches can be encoded concurrently and then written in order.
+    public static func encode(_ elements: [PLYElement],
+                              count: Int? = nil,
+                              type elementHeader: PLYHeader.Element,
+                              format: PLYHeader.Format) throws -> Data {
+        let count = count ?? elements.count
+        guard count <= elements.count else {
+            throw Error.invalidElementCount(requested: count, available: elements.count)
+        }
+
+        switch format {
+        case .ascii:
+            var string = ""
+            for i in 0..<count {
+                string += elements[i].description
+                string += "\n"
+            }
+            return Data(string.utf8)
+        case .binaryBigEndian, .binaryLittleEndian:
+            var byteCount = 0
+            for i in 0..<count {
+                byteCount += try elements[i].encodedBinaryByteWidth(type: elementHeader)
+            }
+            var data = Data(count: byteCount)
+            try data.withUnsafeMutableBytes { raw in
+                guard let base = raw.baseAddress else { return }
+                var offset = 0
+                for i in 0..<count {
+                    offset += try elements[i].encodeBinary(type: elementHeader,
+                                                           to: base,
+                                                           at: offset,
+                                                           bigEndian: format == .binaryBigEndian)
+                }
+            }
+            return data
+        }
+    }
+
+    /// Writes `elementCount` elements previously encoded with encode(_:count:type:format:) for the current element group.
+    /// The elements must not extend past the end of the group.
+    public func write(encoded data: Data, elementCount: Int) throws {
+        guard !closed else {
+            throw Error.cannotWriteAfterClose
+        }
+        guard let header else {
+            throw Error.headerNotYetWritten
+        }
+        guard elementCount > 0 else { return }
+        guard currentElementGroupIndex < header.elements.count,
+              elementCount <= Int(header.elements[currentElementGroupIndex].count) - currentElementCountInGroup else {
+            throw Error.unexpectedElement
+        }
+
+        try writeData(data)
+
+        currentElementCountInGroup += elementCount
+        while (currentElementGroupIndex < header.elements.count) &&
+                (currentElementCountInGroup == header.elements[currentElementGroupIndex].count) {
+            currentElementGroupIndex += 1
+            currentElementCountInGroup = 0
+        }
+    }
+
     private func dumpBuffer(length: Int) throws {
         guard length > 0 else {
             return
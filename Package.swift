@@ -30,6 +30,10 @@ let package = Package(
             name: "SplatConverter",
             targets: [ "SplatConverter" ]
         ),
+        .executable(
+            name: "SplatBenchmark",
+            targets: [ "SplatBenchmark" ]
+        ),
     ],
     dependencies: [
         .package(url: "https://github.com/apple/swift-argument-parser", from: "1.7.0"),
@@ -102,6 +106,15 @@ let package = Package(
             path: "SplatConverter",
             sources: [ "Sources" ]
         ),
+        .executableTarget(
+            name: "SplatBenchmark",
+            dependencies: [
+                "MetalSplatter",
+                .product(name: "ArgumentParser", package: "swift-argument-parser")
+            ],
+            path: "SplatBenchmark",
+            sources: [ "Sources" ]
+        ),
     ],
     swiftLanguageModes: [.v6]
 )
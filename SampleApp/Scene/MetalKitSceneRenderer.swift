@@ -194,6 +194,8 @@ class MetalKitSceneRenderer: NSObject, MTKViewDelegate {
     private var modelScale: Float = 1.0
     private var modelCenterOffset: SIMD3<Float> = .zero
     private var autoFitEnabled: Bool = true
+    /// Draws splat scenes through a splat density rate map, so sparse regions of the frame shade at a lower rate
+    var densityFoveationEnabled: Bool = true
 
     var drawableSize: CGSize = .zero
     
@@ -968,6 +970,17 @@ class MetalKitSceneRenderer: NSObject, MTKViewDelegate {
                                    commandBuffer: MTLCommandBuffer) {
         guard let colorTexture else { return }
         do {
+            if densityFoveationEnabled, let splat = modelRenderer as? SplatRenderer, splat.supportsFoveatedRendering {
+                // Depth isn't resolved out of the foveated pass; nothing drawn after the splats reads it
+                try splat.renderFoveated(viewport: SplatRenderer.ViewportDescriptor(viewport: viewport.viewport,
+                                                                                    projectionMatrix: viewport.projectionMatrix,
+                                                                                    viewMatrix: viewport.viewMatrix,
+                                                                                    screenSize: viewport.screenSize),
+                                         colorTexture: colorTexture,
+                                         colorStoreAction: .store,
+                                         to: commandBuffer)
+                return
+            }
             try modelRenderer.render(viewports: [viewport],
                                    colorTexture: colorTexture,
                                    colorStoreAction: .store,
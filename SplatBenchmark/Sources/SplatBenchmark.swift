@@ -0,0 +1,89 @@
+import ArgumentParser
+import Foundation
+import Metal
+import MetalSplatter
+
+@main
+struct SplatBenchmark: AsyncParsableCommand {
+    typealias SortPath = GPUPerformanceProfiler.BenchmarkSortPath
+    typealias RenderPath = GPUPerformanceProfiler.BenchmarkRenderPath
+    typealias CameraPathKind = GPUPerformanceProfiler.BenchmarkCameraPath.Kind
+
+    static let configuration = CommandConfiguration(
+        commandName: "SplatBenchmark",
+        abstract: "Benchmarks sort and render paths on real splat captures and writes a JSON report",
+        version: "1.0.0"
+    )
+
+    @Argument(help: "Splat scene files to benchmark (default: skull.sog and test_splats_50k.glb in the current directory)")
+    var scenes: [String] = []
+
+    @Option(name: [.long], parsing: .upToNextOption, help: "Sort paths to sweep (metal4, counting, mps, cpu)")
+    var sortPaths: [SortPath] = SortPath.allCases
+
+    @Option(name: [.long], parsing: .upToNextOption, help: "Render paths to sweep (singleStage, multiStage, meshShader, dithered, fastSH, tileRasterizer)")
+    var renderPaths: [RenderPath] = RenderPath.allCases
+
+    @Option(name: [.long], parsing: .upToNextOption, help: "Camera paths to sweep (orbit, dolly, jitter)")
+    var cameraPaths: [CameraPathKind] = [.orbit, .dolly, .jitter]
+
+    @Option(name: [.long], parsing: .upToNextOption, help: "Splat counts to subsample each scene to (default: full size)")
+    var sizes: [Int] = []
+
+    @Option(name: [.long], help: "Measured frames per camera path")
+    var frames: Int = 120
+
+    @Option(name: [.long], help: "Unmeasured frames drawn first")
+    var warmup: Int = 10
+
+    @Option(name: [.long], help: "Render target width")
+    var width: Int = 1280
+
+    @Option(name: [.long], help: "Render target height")
+    var height: Int = 720
+
+    @Option(name: .shortAndLong, help: "The JSON report file (default: standard output)")
+    var output: String?
+
+    func validate() throws {
+        guard frames > 0, warmup >= 0 else {
+            throw ValidationError("--frames must be positive and --warmup non-negative")
+        }
+        guard width > 0, height > 0 else {
+            throw ValidationError("--width and --height must be positive")
+        }
+    }
+
+    func run() async throws {
+        guard let device = MTLCreateSystemDefaultDevice() else {
+            throw ValidationError("No Metal device available")
+        }
+
+        let sceneURLs = (scenes.isEmpty ? ["skull.sog", "test_splats_50k.glb"] : scenes).map { URL(fileURLWithPath: $0) }
+        for url in sceneURLs where !FileManager.default.fileExists(atPath: url.path) {
+            throw ValidationError("Scene not found: \(url.path)")
+        }
+
+        var configuration = GPUPerformanceProfiler.BenchmarkConfiguration(scenes: sceneURLs)
+        configuration.sortPaths = sortPaths
+        configuration.renderPaths = renderPaths
+        configuration.cameraPaths = cameraPaths.map { .init(kind: $0, frameCount: frames) }
+        configuration.sceneSizes = sizes
+        configuration.warmupFrames = warmup
+        configuration.resolution = SIMD2(width, height)
+
+        let report = try await GPUPerformanceProfiler(device: device).runBenchmark(configuration)
+        let json = try report.jsonData()
+        if let output {
+            try json.write(to: URL(fileURLWithPath: output))
+            print("Wrote \(report.results.count) results to \(output)")
+        } else {
+            FileHandle.standardOutput.write(json)
+            FileHandle.standardOutput.write(Data("\n".utf8))
+        }
+    }
+}
+
+extension GPUPerformanceProfiler.BenchmarkSortPath: ExpressibleByArgument {}
+extension GPUPerformanceProfiler.BenchmarkRenderPath: ExpressibleByArgument {}
+extension GPUPerformanceProfiler.BenchmarkCameraPath.Kind: ExpressibleByArgument {}
@@ -21,7 +21,7 @@ struct SplatConverter: ParsableCommand {
     @Option(name: .shortAndLong, help: "The output splat scene file")
     var outputFile: String?
 
-    @Option(name: [.customShort("f"), .long], help: "The format of the output file (dotSplat, ply, ply-ascii, gltf, glb, sog)")
+    @Option(name: [.customShort("f"), .long], help: "The format of the output file (dotSplat, ply, ply-ascii, gltf, glb, sog, spz)")
     var outputFormat: SplatOutputFileFormat?
 
     @Flag(name: [.long], help: "Describe each of the splats from first to first + count")
@@ -39,9 +39,16 @@ struct SplatConverter: ParsableCommand {
     @Flag(name: .shortAndLong, help: "Reorder splats by Morton code for improved spatial locality")
     var mortonOrder = false
 
-    func run() throws {
-        let reader = try AutodetectSceneReader(URL(fileURLWithPath: inputFile))
+    @Flag(name: [.long], help: "Convert without holding the scene in memory: pipelined parallel encoding for ply and dotSplat, two passes over the input for sog and spz")
+    var streaming = false
+
+    @Option(name: [.long], help: "Encode workers for --streaming (default: one per core)")
+    var workers: Int?
 
+    @Option(name: [.long], help: "Batches read ahead of the writer for --streaming (default: twice the worker count)")
+    var maxInFlightBatches: Int?
+
+    func run() throws {
         var outputFormat = outputFormat
         if let outputFile, outputFormat == nil {
             outputFormat = .init(defaultFor: SplatFileFormat(for: URL(fileURLWithPath: outputFile)))
@@ -50,6 +57,19 @@ struct SplatConverter: ParsableCommand {
             }
         }
 
+        if streaming {
+            guard let outputFile, let outputFormat else {
+                throw ValidationError("--streaming requires an output file")
+            }
+            guard !describe && !mortonOrder else {
+                throw ValidationError("--streaming can't be combined with --describe or --morton-order")
+            }
+            try convertStreaming(to: outputFile, format: outputFormat)
+            return
+        }
+
+        let reader = try AutodetectSceneReader(URL(fileURLWithPath: inputFile))
+
         let delegate = ReaderDelegate(save: outputFile != nil,
                                       start: start,
                                       count: count,
@@ -105,6 +125,10 @@ struct SplatConverter: ParsableCommand {
                     let sogWriter = SOGSV2SceneWriter()
                     sogWriter.setOutputURL(URL(fileURLWithPath: outputFile))
                     writer = sogWriter
+                case .spz:
+                    let spzWriter = SPZSceneWriter()
+                    spzWriter.setOutputURL(URL(fileURLWithPath: outputFile))
+                    writer = spzWriter
                 }
 
                 defer {
@@ -122,6 +146,43 @@ struct SplatConverter: ParsableCommand {
         }
     }
 
+    func convertStreaming(to outputFile: String, format outputFormat: SplatOutputFileFormat) throws {
+        let inputURL = URL(fileURLWithPath: inputFile)
+        let outputURL = URL(fileURLWithPath: outputFile)
+        let converter = SplatStreamingConverter(options: .init(start: start,
+                                                               count: count,
+                                                               workerCount: workers ?? ProcessInfo.processInfo.activeProcessorCount,
+                                                               maxInFlightBatches: maxInFlightBatches))
+        let makeReader = { try AutodetectSceneReader(inputURL) as any SplatSceneReader }
+
+        let statistics: SplatStreamingConverter.Statistics
+        switch outputFormat {
+        case .dotSplat:
+            statistics = try converter.convert(makeReader: makeReader) { _ in
+                try DotSplatSceneWriter(toFileAtPath: outputFile, append: false)
+            }
+        case .binaryPLY, .asciiPLY:
+            statistics = try converter.convert(makeReader: makeReader) { pointCount in
+                let splatPLYWriter = try SplatPLYSceneWriter(toFileAtPath: outputFile, append: false)
+                try splatPLYWriter.start(sphericalHarmonicDegree: 3, binary: outputFormat == .binaryPLY, pointCount: pointCount)
+                return splatPLYWriter
+            }
+        case .sog:
+            let sogWriter = SOGSV2SceneWriter()
+            sogWriter.setOutputURL(outputURL)
+            statistics = try converter.convert(makeReader: makeReader, to: sogWriter)
+        case .spz:
+            let spzWriter = SPZSceneWriter()
+            spzWriter.setOutputURL(outputURL)
+            statistics = try converter.convert(makeReader: makeReader, to: spzWriter)
+        case .gltf, .glb:
+            throw ValidationError("--streaming doesn't support glTF output, which needs each attribute contiguous")
+        }
+
+        let passes = statistics.passCount == 1 ? "1 pass" : "\(statistics.passCount) passes"
+        print("Converted \(statistics.pointCount) points from \(inputFile) to \(outputFile) in \(statistics.duration.asSeconds.formatted(.number.precision(.fractionLength(2)))) seconds, \(passes) (\(statistics.pointsPerSecond.formatted(.number.precision(.fractionLength(0)))) splats/s)")
+    }
+
     class ReaderDelegate: SplatSceneReaderDelegate {
         let save: Bool
         let start: Int
@@ -209,6 +270,7 @@ enum SplatOutputFileFormat: ExpressibleByArgument {
     case gltf
     case glb
     case sog
+    case spz
 
     public init?(argument: String) {
         switch argument.lowercased() {
@@ -219,6 +281,7 @@ enum SplatOutputFileFormat: ExpressibleByArgument {
         case "gltf": self = .gltf
         case "glb": self = .glb
         case "sog": self = .sog
+        case "spz": self = .spz
         default: return nil
         }
     }
@@ -18,6 +18,10 @@ public class AutodetectSceneReader: SplatSceneReader {
 
     private let reader: SplatSceneReader
 
+    /// The format-specific reader this one forwards to, for callers that use format-specific APIs
+    /// (such as reading packed data without dequantizing it)
+    public var formatReader: any SplatSceneReader { reader }
+
     /// Initialize with default settings
     public convenience init(_ url: URL) throws {
         try self.init(url, useOptimizedSOGS: true)
@@ -112,10 +116,18 @@ public class AutodetectSceneReader: SplatSceneReader {
     /// For binary PLYs, only decode the ASCII header bytes up to `end_header` so
     /// binary payload data cannot break UTF-8/ASCII decoding.
     private static func detectRenderMode(url: URL) -> RenderMode {
-        let scanSize = 8192
         guard let handle = try? FileHandle(forReadingFrom: url) else { return .standard }
         defer { try? handle.close() }
-        guard let data = try? handle.read(upToCount: scanSize), !data.isEmpty else { return .standard }
+        guard let data = try? handle.read(upToCount: renderModeScanSize) else { return .standard }
+        return detectRenderMode(leadingBytes: data)
+    }
+
+    /// Bytes at the start of a file that are scanned for the render mode marker
+    static let renderModeScanSize = 8192
+
+    /// The render mode marked in the first `renderModeScanSize` bytes of a file, for bodies read without a file
+    static func detectRenderMode(leadingBytes data: Data) -> RenderMode {
+        guard !data.isEmpty else { return .standard }
 
         let headerData: Data
         if let range = data.range(of: Data("end_header".utf8)) {
@@ -141,6 +153,10 @@ public class AutodetectSceneReader: SplatSceneReader {
     public func readScene() throws -> [SplatScenePoint] {
         return try reader.readScene()
     }
+
+    public func readBatch() throws -> SplatPointBatch {
+        return try reader.readBatch()
+    }
     
     public func read(to delegate: SplatSceneReaderDelegate) {
         reader.read(to: delegate)
@@ -68,26 +68,45 @@ public struct ChunkHeader: Sendable {
 }
 
 /// GPU-compatible header for chunk decompression
-/// This matches the Metal shader structure exactly
+/// This matches the Metal shader structure exactly (64 bytes). `SIMD3<Float>` has a 16-byte stride in
+/// Swift, so each bound is stored with the shader's trailing scalar in one `SIMD4<Float>`.
 public struct GPUChunkHeader {
-    public var minPosition: SIMD3<Float>
-    public var padding1: Float = 0
+    private var minPositionAndPadding: SIMD4<Float>
+    private var maxPositionAndPadding: SIMD4<Float>
+    private var minScaleAndPadding: SIMD4<Float>
+    private var maxScaleAndCount: SIMD4<Float>
+
+    public var minPosition: SIMD3<Float> {
+        get { SIMD3(minPositionAndPadding.x, minPositionAndPadding.y, minPositionAndPadding.z) }
+        set { minPositionAndPadding = SIMD4(newValue, 0) }
+    }
 
-    public var maxPosition: SIMD3<Float>
-    public var padding2: Float = 0
+    public var maxPosition: SIMD3<Float> {
+        get { SIMD3(maxPositionAndPadding.x, maxPositionAndPadding.y, maxPositionAndPadding.z) }
+        set { maxPositionAndPadding = SIMD4(newValue, 0) }
+    }
 
-    public var minScale: SIMD3<Float>
-    public var padding3: Float = 0
+    public var minScale: SIMD3<Float> {
+        get { SIMD3(minScaleAndPadding.x, minScaleAndPadding.y, minScaleAndPadding.z) }
+        set { minScaleAndPadding = SIMD4(newValue, 0) }
+    }
 
-    public var maxScale: SIMD3<Float>
-    public var splatCount: UInt32
+    public var maxScale: SIMD3<Float> {
+        get { SIMD3(maxScaleAndCount.x, maxScaleAndCount.y, maxScaleAndCount.z) }
+        set { maxScaleAndCount = SIMD4(newValue, maxScaleAndCount.w) }
+    }
+
+    /// Shares the last lane with `maxScale`, as `uint splatCount` follows `float3 maxScale` in the shader
+    public var splatCount: UInt32 {
+        get { maxScaleAndCount.w.bitPattern }
+        set { maxScaleAndCount.w = Float(bitPattern: newValue) }
+    }
 
     public init(from header: ChunkHeader) {
-        self.minPosition = header.minPosition
-        self.maxPosition = header.maxPosition
-        self.minScale = header.minScale
-        self.maxScale = header.maxScale
-        self.splatCount = UInt32(header.splatCount)
+        minPositionAndPadding = SIMD4(header.minPosition, 0)
+        maxPositionAndPadding = SIMD4(header.maxPosition, 0)
+        minScaleAndPadding = SIMD4(header.minScale, 0)
+        maxScaleAndCount = SIMD4(header.maxScale, Float(bitPattern: UInt32(header.splatCount)))
     }
 }
 
@@ -2,7 +2,7 @@ import Foundation
 import simd
 
 /// A writer for Gaussian Splat files in the ".splat" format, created by https://github.com/antimatter15/splat/
-public class DotSplatSceneWriter: SplatSceneWriter {
+public class DotSplatSceneWriter: SplatChunkEncodingWriter {
     enum Constants {
         static let bufferSize = 64*1024
     }
@@ -66,4 +66,38 @@ public class DotSplatSceneWriter: SplatSceneWriter {
             offset += count
         }
     }
+
+    /// Encodes points into .splat records; safe to call concurrently
+    public func encodeChunk(_ points: [SplatScenePoint]) throws -> SplatEncodedChunk {
+        try SplatDataValidator.validatePoints(points)
+
+        var data = Data(count: points.count * DotSplatEncodedPoint.byteWidth)
+        data.withUnsafeMutableBytes { raw in
+            guard let base = raw.baseAddress else { return }
+            var bytesStored = 0
+            for point in points {
+                bytesStored += DotSplatEncodedPoint(point).store(to: base, at: bytesStored, bigEndian: false)
+            }
+        }
+        return SplatEncodedChunk(data: data, pointCount: points.count)
+    }
+
+    public func write(encoded chunk: SplatEncodedChunk) throws {
+        guard buffer != nil else {
+            throw Error.cannotWriteAfterClose
+        }
+        guard !chunk.data.isEmpty else { return }
+
+        let written = chunk.data.withUnsafeBytes { raw -> Int in
+            guard let base = raw.baseAddress?.assumingMemoryBound(to: UInt8.self) else { return 0 }
+            return outputStream.write(base, maxLength: chunk.data.count)
+        }
+        if written != chunk.data.count {
+            if let error = outputStream.streamError {
+                throw error
+            } else {
+                throw Error.unknownOutputStreamError
+            }
+        }
+    }
 }
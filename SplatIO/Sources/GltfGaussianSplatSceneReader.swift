@@ -206,17 +206,6 @@ public final class GltfGaussianSplatSceneReader: SplatSceneReader {
             guard let scaleAccessor = primitive.attributes["KHR_gaussian_splatting:SCALE"] else { continue }
             guard let opacityAccessor = primitive.attributes["KHR_gaussian_splatting:OPACITY"] else { continue }
 
-            let positions = try accessorReader.readVec3(positionAccessor)
-            let rotations = try accessorReader.readVec4(rotationAccessor)
-            let scales = try accessorReader.readVec3(scaleAccessor)
-            let opacities = try accessorReader.readScalar(opacityAccessor)
-
-            let count = positions.count
-            if rotations.count != count || scales.count != count || opacities.count != count {
-                continue
-            }
-
-            let sh0Accessor = primitive.attributes["KHR_gaussian_splatting:SH_DEGREE_0_COEF_0"]
             var sh1Accessors: [Int] = []
             var sh2Accessors: [Int] = []
             var sh3Accessors: [Int] = []
@@ -236,85 +225,84 @@ public final class GltfGaussianSplatSceneReader: SplatSceneReader {
                     sh3Accessors.append(index)
                 }
             }
+            if !sh1Accessors.isEmpty && sh1Accessors.count != 3 { continue }
+            if !sh2Accessors.isEmpty && sh2Accessors.count != 5 { continue }
+            if !sh3Accessors.isEmpty && sh3Accessors.count != 7 { continue }
 
+            let sh0Accessor = primitive.attributes["KHR_gaussian_splatting:SH_DEGREE_0_COEF_0"]
             let color0Accessor = primitive.attributes["COLOR_0"]
-
-            var sh0Values: [SIMD3<Float>]? = nil
-            var sh1Values: [[SIMD3<Float>]] = []
-            var sh2Values: [[SIMD3<Float>]] = []
-            var sh3Values: [[SIMD3<Float>]] = []
-            var color0Values: [SIMD4<Float>]? = nil
-            var shDataValid = true
-
+            let higherOrderAccessors = sh1Accessors + sh2Accessors + sh3Accessors
+
+            // Every attribute of the primitive is decoded in one batch, concurrently when the primitive is large
+            var requests: [AccessorReader.Request] = [
+                .init(accessor: positionAccessor, componentCounts: [3]),
+                .init(accessor: rotationAccessor, componentCounts: [4]),
+                .init(accessor: scaleAccessor, componentCounts: [3]),
+                .init(accessor: opacityAccessor, componentCounts: [1])
+            ]
+            requests += higherOrderAccessors.map { AccessorReader.Request(accessor: $0, componentCounts: [3]) }
             if let sh0Accessor {
-                sh0Values = try accessorReader.readVec3(sh0Accessor)
-                if sh0Values?.count != count { sh0Values = nil }
+                requests.append(.init(accessor: sh0Accessor, componentCounts: [3]))
             }
-
-            if sh1Accessors.count > 0 {
-                guard sh1Accessors.count == 3 else { continue }
-                for index in sh1Accessors {
-                    let values = try accessorReader.readVec3(index)
-                    if values.count != count { shDataValid = false; break }
-                    sh1Values.append(values)
-                }
+            if let color0Accessor {
+                requests.append(.init(accessor: color0Accessor, componentCounts: [3, 4]))
             }
+            let decoded = try accessorReader.decode(requests)
 
-            if sh2Accessors.count > 0 {
-                guard sh2Accessors.count == 5 else { continue }
-                for index in sh2Accessors {
-                    let values = try accessorReader.readVec3(index)
-                    if values.count != count { shDataValid = false; break }
-                    sh2Values.append(values)
-                }
+            let positions = decoded[0]
+            let rotations = decoded[1]
+            let scales = decoded[2]
+            let opacities = decoded[3]
+            let count = positions.count
+            if rotations.count != count || scales.count != count || opacities.count != count {
+                continue
             }
 
-            if sh3Accessors.count > 0 {
-                guard sh3Accessors.count == 7 else { continue }
-                for index in sh3Accessors {
-                    let values = try accessorReader.readVec3(index)
-                    if values.count != count { shDataValid = false; break }
-                    sh3Values.append(values)
-                }
+            let higherOrderValues = Array(decoded[4..<(4 + higherOrderAccessors.count)])
+            if higherOrderValues.contains(where: { $0.count != count }) { continue }
+            var nextOptional = 4 + higherOrderAccessors.count
+            var sh0Values: AccessorReader.DecodedAccessor? = nil
+            if sh0Accessor != nil {
+                sh0Values = decoded[nextOptional].count == count ? decoded[nextOptional] : nil
+                nextOptional += 1
             }
-
-            if !shDataValid { continue }
-            if sh0Values == nil && (!sh1Values.isEmpty || !sh2Values.isEmpty || !sh3Values.isEmpty) { continue }
-
-            if let color0Accessor {
-                color0Values = try accessorReader.readColor(color0Accessor)
-                if color0Values?.count != count { color0Values = nil }
+            var color0Values: AccessorReader.DecodedAccessor? = nil
+            if color0Accessor != nil {
+                color0Values = decoded[nextOptional].count == count ? decoded[nextOptional] : nil
             }
+            if sh0Values == nil && !higherOrderValues.isEmpty { continue }
 
+            let coefficientCount = (sh0Values == nil ? 0 : 1) + higherOrderValues.count
+            results.reserveCapacity(results.count + count)
             for i in 0..<count {
                 var coeffs: [SIMD3<Float>] = []
-                if let sh0Values {
-                    coeffs.append(sh0Values[i])
+                if coefficientCount > 0 {
+                    coeffs.reserveCapacity(coefficientCount)
+                    if let sh0Values {
+                        coeffs.append(sh0Values.vec3(i))
+                    }
+                    for values in higherOrderValues { coeffs.append(values.vec3(i)) }
                 }
-                for values in sh1Values { coeffs.append(values[i]) }
-                for values in sh2Values { coeffs.append(values[i]) }
-                for values in sh3Values { coeffs.append(values[i]) }
 
                 let color: SplatScenePoint.Color
                 if !coeffs.isEmpty {
                     color = .sphericalHarmonic(coeffs)
                 } else if let color0Values {
-                    let rgba = color0Values[i]
-                    color = .linearFloat(SIMD3<Float>(rgba.x, rgba.y, rgba.z))
+                    color = .linearFloat(color0Values.vec3(i))
                 } else {
                     continue
                 }
 
-                var opacity = opacities[i]
+                var opacity = opacities.scalar(i)
                 if opacity < 0 || opacity > 1 {
                     opacity = max(0, min(1, opacity))
                 }
 
-                let rotationVector = rotations[i]
+                let rotationVector = rotations.vec4(i)
                 var rotation = simd_quatf(ix: rotationVector.x, iy: rotationVector.y, iz: rotationVector.z, r: rotationVector.w)
                 rotation = rotation.normalized
 
-                let scaleExp = scales[i]
+                let scaleExp = scales.vec3(i)
                 let adjustedScale: SIMD3<Float>
                 if transform.scale != 1 {
                     let logScale = log(transform.scale)
@@ -323,7 +311,7 @@ public final class GltfGaussianSplatSceneReader: SplatSceneReader {
                     adjustedScale = scaleExp
                 }
 
-                let scaledPosition = positions[i] * transform.scale
+                let scaledPosition = positions.vec3(i) * transform.scale
                 let transformedPosition = transform.translation + transform.rotation.act(scaledPosition)
                 let transformedRotation = (transform.rotation * rotation).normalized
 
@@ -379,7 +367,8 @@ public final class GltfGaussianSplatSceneReader: SplatSceneReader {
             let chunkStart = offset + 8
             let chunkEnd = chunkStart + chunkLength
             if chunkEnd > data.count { throw Error.invalidGLBHeader }
-            let chunkData = data.subdata(in: chunkStart..<chunkEnd)
+            // A slice shares the file's storage, so the BIN chunk is never copied
+            let chunkData = data[(data.startIndex + chunkStart)..<(data.startIndex + chunkEnd)]
 
             if chunkType == 0x4e4f534a { // JSON
                 jsonChunk = chunkData
@@ -496,43 +485,93 @@ public final class GltfGaussianSplatSceneReader: SplatSceneReader {
     }
 
     private struct AccessorReader {
-        let accessors: [GltfAccessor]
-        let bufferViews: [GltfBufferView]
-        let buffers: [Data]
-
-        func readVec3(_ index: Int) throws -> [SIMD3<Float>] {
-            let values = try readAccessor(index: index, expectedComponents: 3)
-            return values.map { SIMD3<Float>($0[0], $0[1], $0[2]) }
+        /// An accessor to decode and the component counts its type may have
+        struct Request {
+            let accessor: Int
+            let componentCounts: [Int]
         }
 
-        func readVec4(_ index: Int) throws -> [SIMD4<Float>] {
-            let values = try readAccessor(index: index, expectedComponents: 4)
-            return values.map { SIMD4<Float>($0[0], $0[1], $0[2], $0[3]) }
+        /// An accessor's elements as contiguous floats, `componentCount` per element
+        struct DecodedAccessor {
+            let values: [Float]
+            let componentCount: Int
+
+            var count: Int { values.count / componentCount }
+
+            func scalar(_ index: Int) -> Float {
+                values[index * componentCount]
+            }
+
+            func vec3(_ index: Int) -> SIMD3<Float> {
+                let base = index * componentCount
+                return SIMD3<Float>(values[base], values[base + 1], values[base + 2])
+            }
+
+            func vec4(_ index: Int) -> SIMD4<Float> {
+                let base = index * componentCount
+                return SIMD4<Float>(values[base], values[base + 1], values[base + 2], values[base + 3])
+            }
         }
 
-        func readScalar(_ index: Int) throws -> [Float] {
-            let values = try readAccessor(index: index, expectedComponents: 1)
-            return values.map { $0[0] }
+        /// A validated accessor: `count` elements of `componentCount` components, `stride` bytes apart from
+        /// `byteOffset` in `buffer`
+        private struct Layout {
+            let buffer: Int
+            let byteOffset: Int
+            let stride: Int
+            let count: Int
+            let componentCount: Int
+            let componentSize: Int
+            let componentType: Int
+            let normalized: Bool
+
+            var elementSize: Int { componentSize * componentCount }
         }
 
-        func readColor(_ index: Int) throws -> [SIMD4<Float>] {
-            let accessor = try getAccessor(index)
-            let componentCount = components(for: accessor.type)
-            guard componentCount == 3 || componentCount == 4 else { throw Error.unsupportedAccessorType(accessor.type) }
-            let values = try readAccessor(index: index, expectedComponents: componentCount)
-            if componentCount == 3 {
-                return values.map { SIMD4<Float>($0[0], $0[1], $0[2], 1) }
+        // Primitives with fewer elements decode their attributes on the calling thread
+        private static let concurrentDecodeMinimumCount = 16_384
+
+        let accessors: [GltfAccessor]
+        let bufferViews: [GltfBufferView]
+        let buffers: [Data]
+
+        /// Decodes each request's accessor; result `i` belongs to `requests[i]`. Large accessors decode concurrently.
+        func decode(_ requests: [Request]) throws -> [DecodedAccessor] {
+            let layouts = try requests.map { try layout(for: $0) }
+            let largest = layouts.map(\.count).max() ?? 0
+            guard layouts.count > 1, largest >= Self.concurrentDecodeMinimumCount else {
+                return try layouts.map { try decode($0) }
+            }
+
+            let decoded = LockedBox<[Int: DecodedAccessor]>([:])
+            let firstError = LockedBox<Swift.Error?>(nil)
+            DispatchQueue.concurrentPerform(iterations: layouts.count) { index in
+                guard firstError.get() == nil else { return }
+                do {
+                    let values = try decode(layouts[index])
+                    decoded.withValue { $0[index] = values }
+                } catch {
+                    firstError.withValue { if $0 == nil { $0 = error } }
+                }
+            }
+            if let error = firstError.get() {
+                throw error
+            }
+            let results = decoded.get()
+            return try layouts.indices.map { index in
+                guard let values = results[index] else { throw Error.missingAccessor(requests[index].accessor) }
+                return values
             }
-            return values.map { SIMD4<Float>($0[0], $0[1], $0[2], $0[3]) }
         }
 
-        private func readAccessor(index: Int, expectedComponents: Int) throws -> [[Float]] {
+        private func layout(for request: Request) throws -> Layout {
+            let index = request.accessor
             let accessor = try getAccessor(index)
             if accessor.sparse != nil { throw Error.sparseAccessorsNotSupported }
 
             let componentCount = components(for: accessor.type)
             guard componentCount > 0 else { throw Error.unsupportedAccessorType(accessor.type) }
-            guard componentCount == expectedComponents else { throw Error.unsupportedAccessorType(accessor.type) }
+            guard request.componentCounts.contains(componentCount) else { throw Error.unsupportedAccessorType(accessor.type) }
 
             guard let bufferViewIndex = accessor.bufferView else { throw Error.missingBufferView(index) }
             guard bufferViewIndex >= 0 && bufferViewIndex < bufferViews.count else { throw Error.missingBufferView(bufferViewIndex) }
@@ -572,22 +611,92 @@ public final class GltfGaussianSplatSceneReader: SplatSceneReader {
             }
             if requiredSize > viewEnd { throw Error.bufferOutOfBounds }
 
-            var result: [[Float]] = []
-            result.reserveCapacity(accessor.count)
-
-            for i in 0..<accessor.count {
-                var entry: [Float] = []
-                entry.reserveCapacity(componentCount)
-                let elementOffset = baseOffset + i * stride
-                for c in 0..<componentCount {
-                    let offset = elementOffset + c * componentSize
-                    let value = try readComponentAsFloat(buffer: buffer, offset: offset, componentType: accessor.componentType, normalized: accessor.normalized ?? false)
-                    entry.append(value)
+            return Layout(buffer: bufferView.buffer,
+                          byteOffset: baseOffset,
+                          stride: stride,
+                          count: accessor.count,
+                          componentCount: componentCount,
+                          componentSize: componentSize,
+                          componentType: accessor.componentType,
+                          normalized: accessor.normalized ?? false)
+        }
+
+        /// One loop per (component type, normalized) pair; glTF data is little-endian, like every Apple platform
+        private func decode(_ layout: Layout) throws -> DecodedAccessor {
+            guard layout.count > 0 else {
+                return DecodedAccessor(values: [], componentCount: layout.componentCount)
+            }
+            let values = try buffers[layout.buffer].withUnsafeBytes { (bytes: UnsafeRawBufferPointer) throws -> [Float] in
+                guard let start = bytes.baseAddress else { throw Error.bufferOutOfBounds }
+                let base = start + layout.byteOffset
+                switch (layout.componentType, layout.normalized) {
+                case (5126, _):
+                    return Self.decodeFloat32(base, layout)
+                case (5120, true):
+                    return Self.decode(base, layout, as: Int8.self) { Swift.max(-1, Float($0) / 127) }
+                case (5120, false):
+                    return Self.decode(base, layout, as: Int8.self) { Float($0) }
+                case (5121, true):
+                    return Self.decode(base, layout, as: UInt8.self) { Float($0) / 255 }
+                case (5121, false):
+                    return Self.decode(base, layout, as: UInt8.self) { Float($0) }
+                case (5122, true):
+                    return Self.decode(base, layout, as: Int16.self) { Swift.max(-1, Float($0) / 32767) }
+                case (5122, false):
+                    return Self.decode(base, layout, as: Int16.self) { Float($0) }
+                case (5123, true):
+                    return Self.decode(base, layout, as: UInt16.self) { Float($0) / 65535 }
+                case (5123, false):
+                    return Self.decode(base, layout, as: UInt16.self) { Float($0) }
+                case (5125, true):
+                    return Self.decode(base, layout, as: UInt32.self) { Float($0) / 4294967295.0 }
+                case (5125, false):
+                    return Self.decode(base, layout, as: UInt32.self) { Float($0) }
+                default:
+                    throw Error.unsupportedComponentType(layout.componentType)
+                }
+            }
+            return DecodedAccessor(values: values, componentCount: layout.componentCount)
+        }
+
+        /// Tightly packed floats are one bulk copy out of the buffer; strided ones one copy per element
+        private static func decodeFloat32(_ base: UnsafeRawPointer, _ layout: Layout) -> [Float] {
+            let valueCount = layout.count * layout.componentCount
+            return [Float](unsafeUninitializedCapacity: valueCount) { output, initializedCount in
+                let destination = UnsafeMutableRawPointer(output.baseAddress!)
+                if layout.stride == layout.elementSize {
+                    destination.copyMemory(from: base, byteCount: valueCount * MemoryLayout<Float>.size)
+                } else {
+                    for element in 0..<layout.count {
+                        destination.advanced(by: element * layout.elementSize)
+                            .copyMemory(from: base + element * layout.stride, byteCount: layout.elementSize)
+                    }
                 }
-                result.append(entry)
+                initializedCount = valueCount
             }
+        }
 
-            return result
+        @inline(__always)
+        private static func decode<Component: FixedWidthInteger & BitwiseCopyable>(_ base: UnsafeRawPointer,
+                                                                 _ layout: Layout,
+                                                                 as type: Component.Type,
+                                                                 _ convert: (Component) -> Float) -> [Float] {
+            let componentCount = layout.componentCount
+            let valueCount = layout.count * componentCount
+            return [Float](unsafeUninitializedCapacity: valueCount) { output, initializedCount in
+                var elementBase = base
+                var outputIndex = 0
+                for _ in 0..<layout.count {
+                    for component in 0..<componentCount {
+                        let value = elementBase.loadUnaligned(fromByteOffset: component * MemoryLayout<Component>.size,
+                                                              as: Component.self)
+                        output[outputIndex] = convert(Component(littleEndian: value))
+                        outputIndex += 1
+                    }
+                    elementBase += layout.stride
+                }
+                initializedCount = valueCount
+            }
         }
 
         private func getAccessor(_ index: Int) throws -> GltfAccessor {
@@ -613,68 +722,6 @@ public final class GltfGaussianSplatSceneReader: SplatSceneReader {
             default: return 0
             }
         }
-
-        private func readComponentAsFloat(buffer: Data, offset: Int, componentType: Int, normalized: Bool) throws -> Float {
-            switch componentType {
-            case 5120:
-                guard offset + 1 <= buffer.count else { throw Error.bufferOutOfBounds }
-                let value = Int8(bitPattern: buffer[offset])
-                if normalized { return normalizeSigned(Float(value), maxValue: 127) }
-                return Float(value)
-            case 5121:
-                guard offset + 1 <= buffer.count else { throw Error.bufferOutOfBounds }
-                let value = buffer[offset]
-                if normalized { return Float(value) / 255.0 }
-                return Float(value)
-            case 5122:
-                let value = try readInt16(buffer, offset: offset)
-                if normalized { return normalizeSigned(Float(value), maxValue: 32767) }
-                return Float(value)
-            case 5123:
-                let value = try readUInt16(buffer, offset: offset)
-                if normalized { return Float(value) / 65535.0 }
-                return Float(value)
-            case 5125:
-                let value = try readUInt32(buffer, offset: offset)
-                if normalized { return Float(value) / 4294967295.0 }
-                return Float(value)
-            case 5126:
-                return try readFloat32(buffer, offset: offset)
-            default:
-                throw Error.unsupportedComponentType(componentType)
-            }
-        }
-
-        private func normalizeSigned(_ value: Float, maxValue: Float) -> Float {
-            let scaled = value / maxValue
-            return Swift.max(-1, Swift.min(1, scaled))
-        }
-
-        private func readUInt16(_ buffer: Data, offset: Int) throws -> UInt16 {
-            guard offset + 2 <= buffer.count else { throw Error.bufferOutOfBounds }
-            let start = buffer.startIndex + offset
-            return UInt16(buffer[start])
-                | (UInt16(buffer[start + 1]) << 8)
-        }
-
-        private func readInt16(_ buffer: Data, offset: Int) throws -> Int16 {
-            let value = try readUInt16(buffer, offset: offset)
-            return Int16(bitPattern: value)
-        }
-
-        private func readUInt32(_ buffer: Data, offset: Int) throws -> UInt32 {
-            guard offset + 4 <= buffer.count else { throw Error.bufferOutOfBounds }
-            let start = buffer.startIndex + offset
-            return UInt32(buffer[start])
-                | (UInt32(buffer[start + 1]) << 8)
-                | (UInt32(buffer[start + 2]) << 16)
-                | (UInt32(buffer[start + 3]) << 24)
-        }
-
-        private func readFloat32(_ buffer: Data, offset: Int) throws -> Float {
-            let bits = try readUInt32(buffer, offset: offset)
-            return Float(bitPattern: bits)
-        }
     }
 }
 
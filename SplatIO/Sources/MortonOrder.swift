@@ -65,7 +65,18 @@ public enum MortonOrder {
     ) -> [UInt32] {
         guard !points.isEmpty else { return [] }
 
-        let (minBounds, maxBounds) = bounds ?? computeBounds(points)
+        return computeMortonCodes(count: points.count,
+                                  bounds: bounds ?? computeBounds(points)) { points[$0].position }
+    }
+
+    /// Shared Morton code kernel for point arrays and position columns
+    @inline(__always)
+    private static func computeMortonCodes(
+        count: Int,
+        bounds: (min: SIMD3<Float>, max: SIMD3<Float>),
+        position: (Int) -> SIMD3<Float>
+    ) -> [UInt32] {
+        let (minBounds, maxBounds) = bounds
         let size = maxBounds - minBounds
 
         // Prevent division by zero for degenerate cases (all points on a plane/line)
@@ -75,11 +86,10 @@ public enum MortonOrder {
             size.z > 0 ? 1.0 / size.z : 0
         )
 
-        var codes = [UInt32](repeating: 0, count: points.count)
+        var codes = [UInt32](repeating: 0, count: count)
 
-        for i in 0..<points.count {
-            let pos = points[i].position
-            let normalized = (pos - minBounds) * invSize
+        for i in 0..<count {
+            let normalized = (position(i) - minBounds) * invSize
 
             // Quantize to 10-bit integers (0-1023)
             let qx = UInt32(min(max(normalized.x * 1023, 0), 1023))
@@ -239,6 +249,59 @@ extension MortonOrder {
     }
 }
 
+// MARK: - Columnar Batches
+
+extension MortonOrder {
+
+    /// Computes the axis-aligned bounding box of a position column.
+    public static func computeBounds(positions: [SIMD3<Float>]) -> (min: SIMD3<Float>, max: SIMD3<Float>) {
+        guard !positions.isEmpty else {
+            return (SIMD3<Float>.zero, SIMD3<Float>.zero)
+        }
+
+        var minBounds = SIMD3<Float>(repeating: .infinity)
+        var maxBounds = SIMD3<Float>(repeating: -.infinity)
+        for position in positions {
+            minBounds = simd_min(minBounds, position)
+            maxBounds = simd_max(maxBounds, position)
+        }
+        return (minBounds, maxBounds)
+    }
+
+    /// Computes Morton codes for a batch, reading only its position column.
+    public static func computeMortonCodes(
+        _ batch: SplatPointBatch,
+        bounds: (min: SIMD3<Float>, max: SIMD3<Float>)? = nil
+    ) -> [UInt32] {
+        guard !batch.isEmpty else { return [] }
+
+        let positions = batch.positions
+        return computeMortonCodes(count: positions.count,
+                                  bounds: bounds ?? computeBounds(positions: positions)) { positions[$0] }
+    }
+
+    /// Computes the Morton-ordered permutation of a batch using the O(n) radix sort.
+    /// - Returns: Indices such that `batch.permuted(by: indices)` is Morton ordered
+    public static func computeReorderingIndices(_ batch: SplatPointBatch) -> [Int] {
+        computeReorderingIndices(positions: batch.positions)
+    }
+
+    /// Computes the Morton-ordered permutation of a position column using the O(n) radix sort.
+    /// Deterministic for a given column, so callers can re-derive the same order later.
+    public static func computeReorderingIndices(positions: [SIMD3<Float>]) -> [Int] {
+        guard !positions.isEmpty else { return [] }
+        let codes = computeMortonCodes(count: positions.count,
+                                       bounds: computeBounds(positions: positions)) { positions[$0] }
+        return radixSortIndices(codes, count: positions.count)
+    }
+
+    /// Reorders a batch by Morton code. Each column is permuted once; no points are materialized.
+    public static func reorder(_ batch: SplatPointBatch) -> SplatPointBatch {
+        guard batch.count > 1 else { return batch }
+        return batch.permuted(by: computeReorderingIndices(batch))
+    }
+}
+
 // MARK: - Statistics
 
 extension MortonOrder {
@@ -0,0 +1,103 @@
+import Foundation
+
+/// On-disk cache of remote scene bodies, validated by ETag.
+///
+/// Each entry is a response body plus a small JSON record of its source URL, ETag and length, stored under a name
+/// derived from the URL. `RemoteSceneLoader` sends the cached ETag as `If-None-Match` and reads the cached body when
+/// the server answers 304 Not Modified, or can't be reached. Responses without an ETag are never cached.
+public final class RemoteSceneCache: @unchecked Sendable {
+    public struct Entry: Sendable {
+        /// Local copy of the body; keeps the remote file name so format detection by extension still works
+        public let fileURL: URL
+        public let etag: String
+    }
+
+    private struct Record: Codable {
+        var url: String
+        var etag: String
+        var length: Int
+    }
+
+    public let directory: URL
+    private let lock = NSLock()
+
+    public static var defaultDirectory: URL {
+        let caches = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first
+            ?? FileManager.default.temporaryDirectory
+        return caches.appendingPathComponent("MetalSplatter/RemoteScenes", isDirectory: true)
+    }
+
+    /// The directory is created on the first `store`
+    public init(directory: URL = RemoteSceneCache.defaultDirectory) {
+        self.directory = directory
+    }
+
+    /// The cached body for `url`, if one is stored and intact
+    public func entry(for url: URL) -> Entry? {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let data = try? Data(contentsOf: recordURL(for: url)),
+              let record = try? JSONDecoder().decode(Record.self, from: data),
+              record.url == url.absoluteString else {
+            return nil
+        }
+        let fileURL = bodyURL(for: url)
+        guard let attributes = try? FileManager.default.attributesOfItem(atPath: fileURL.path),
+              (attributes[.size] as? NSNumber)?.intValue == record.length else {
+            return nil
+        }
+        return Entry(fileURL: fileURL, etag: record.etag)
+    }
+
+    /// Moves the complete body at `fileURL` into the cache as the entry for `url`, replacing any older one
+    @discardableResult
+    public func store(_ fileURL: URL, for url: URL, etag: String) throws -> Entry {
+        lock.lock()
+        defer { lock.unlock() }
+        let fileManager = FileManager.default
+        try fileManager.createDirectory(at: directory, withIntermediateDirectories: true)
+
+        let destination = bodyURL(for: url)
+        try? fileManager.removeItem(at: recordURL(for: url))
+        try? fileManager.removeItem(at: destination)
+        try fileManager.moveItem(at: fileURL, to: destination)
+
+        let length = (try fileManager.attributesOfItem(atPath: destination.path)[.size] as? NSNumber)?.intValue ?? 0
+        let record = Record(url: url.absoluteString, etag: etag, length: length)
+        try JSONEncoder().encode(record).write(to: recordURL(for: url), options: .atomic)
+        return Entry(fileURL: destination, etag: etag)
+    }
+
+    public func removeEntry(for url: URL) {
+        lock.lock()
+        defer { lock.unlock() }
+        try? FileManager.default.removeItem(at: recordURL(for: url))
+        try? FileManager.default.removeItem(at: bodyURL(for: url))
+    }
+
+    public func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    // MARK: - Private
+
+    private func recordURL(for url: URL) -> URL {
+        directory.appendingPathComponent("\(Self.key(for: url)).json")
+    }
+
+    private func bodyURL(for url: URL) -> URL {
+        let name = url.lastPathComponent.isEmpty ? "scene" : url.lastPathComponent
+        return directory.appendingPathComponent("\(Self.key(for: url))-\(name)")
+    }
+
+    /// 64-bit FNV-1a of the absolute URL; stable across launches, unlike `hashValue`
+    private static func key(for url: URL) -> String {
+        var hash: UInt64 = 0xcbf29ce484222325
+        for byte in url.absoluteString.utf8 {
+            hash = (hash ^ UInt64(byte)) &* 0x100000001b3
+        }
+        return String(hash, radix: 16)
+    }
+}
@@ -0,0 +1,469 @@
+import Foundation
+
+/// Loads splat scenes over HTTP(S).
+///
+/// `.splat` and PLY bodies are parsed while they download: each chunk URLSession receives feeds the same
+/// stream-based readers used for local files, so the delegate gets the header and the first batches long before the
+/// body is complete.
+/// Formats that need random access are downloaded in full first. Complete bodies go into `cache` when the server
+/// sends an ETag, and the next load revalidates them with `If-None-Match`; a 304, or no connection at all, reads the
+/// cached copy instead.
+///
+/// `data(from:byteRange:)` fetches part of a resource with a `Range` request, for payloads addressed by offset such
+/// as octree LOD levels stored as ranges of `.splat` records.
+public final class RemoteSceneLoader: Sendable {
+    public enum Error: Swift.Error {
+        case unsupportedScheme(URL)
+        case unexpectedStatus(URL, statusCode: Int)
+        case rangeNotSatisfiable(URL, Range<Int>)
+        case readFailed(URL)
+    }
+
+    public let session: URLSession
+    public let cache: RemoteSceneCache?
+
+    public init(session: URLSession = .shared, cache: RemoteSceneCache? = RemoteSceneCache()) {
+        self.session = session
+        self.cache = cache
+    }
+
+    public static func isRemote(_ url: URL) -> Bool {
+        guard let scheme = url.scheme?.lowercased() else { return false }
+        return scheme == "http" || scheme == "https"
+    }
+
+    /// Whether `read(from:to:)` parses `url` while it downloads, rather than after
+    public static func supportsStreaming(_ url: URL) -> Bool {
+        switch url.pathExtension.lowercased() {
+        case "ply", "splat": return true
+        default: return false
+        }
+    }
+
+    /// Reads the scene at `url` into `delegate`, streaming the body where the format allows.
+    /// Failures are reported to the delegate with `didFailReading` and also thrown.
+    /// - Returns: The render mode marked in the scene's header, as `AutodetectSceneReader.renderMode` reports it
+    @discardableResult
+    public func read(from url: URL, to delegate: SplatSceneReaderDelegate) async throws -> AutodetectSceneReader.RenderMode {
+        let observer = ReadObserver(delegate, url: url)
+        do {
+            return try await read(from: url, observer: observer)
+        } catch {
+            observer.fail(error)
+            throw error
+        }
+    }
+
+    /// A local file holding the complete resource at `url`: the cached copy when the server confirms it is current,
+    /// otherwise a fresh download. Temporary files were not cached and belong to the caller.
+    public func localFile(for url: URL) async throws -> (url: URL, isTemporary: Bool) {
+        switch try await open(url) {
+        case .cached(let entry):
+            return (entry.fileURL, false)
+        case .body(let responseBody, let etag):
+            return try await save(responseBody, from: url, etag: etag)
+        }
+    }
+
+    /// Fetches `byteRange` of the resource at `url` with an HTTP `Range` request.
+    /// A server that ignores `Range` and answers with the whole body is handled by slicing it.
+    public func data(from url: URL, byteRange: Range<Int>) async throws -> Data {
+        guard Self.isRemote(url) else { throw Error.unsupportedScheme(url) }
+        guard !byteRange.isEmpty else { return Data() }
+        var request = URLRequest(url: url)
+        request.setValue("bytes=\(byteRange.lowerBound)-\(byteRange.upperBound - 1)", forHTTPHeaderField: "Range")
+
+        let (data, response) = try await session.data(for: request)
+        switch (response as? HTTPURLResponse)?.statusCode ?? 200 {
+        case 206:
+            guard data.count == byteRange.count else { throw Error.rangeNotSatisfiable(url, byteRange) }
+            return data
+        case 200:
+            guard data.count >= byteRange.upperBound else { throw Error.rangeNotSatisfiable(url, byteRange) }
+            return data.subdata(in: byteRange)
+        case 416:
+            throw Error.rangeNotSatisfiable(url, byteRange)
+        case let status:
+            throw Error.unexpectedStatus(url, statusCode: status)
+        }
+    }
+
+    /// Fetches `records` of a remote `.splat` file, each a fixed-size record, with one range request
+    public func dotSplatPoints(from url: URL, records: Range<Int>) async throws -> [SplatScenePoint] {
+        let width = DotSplatEncodedPoint.byteWidth
+        let data = try await data(from: url, byteRange: (records.lowerBound * width)..<(records.upperBound * width))
+        return DotSplatEncodedPoint.array(data, from: 0, count: records.count, bigEndian: false).map(\.splatScenePoint)
+    }
+
+    // MARK: - Private
+
+    private enum Source {
+        case cached(RemoteSceneCache.Entry)
+        case body(ResponseBody, etag: String?)
+    }
+
+    /// Sends the request, revalidating a cached copy when there is one
+    private func open(_ url: URL) async throws -> Source {
+        guard Self.isRemote(url) else { throw Error.unsupportedScheme(url) }
+        let cached = cache?.entry(for: url)
+        var request = URLRequest(url: url)
+        if let cached {
+            request.setValue(cached.etag, forHTTPHeaderField: "If-None-Match")
+        }
+
+        let body: ResponseBody
+        let response: URLResponse
+        do {
+            (body, response) = try await ResponseBody.start(request, in: session)
+        } catch {
+            // Offline: the last good copy beats no scene
+            guard let cached, !(error is CancellationError) else { throw error }
+            return .cached(cached)
+        }
+
+        let httpResponse = response as? HTTPURLResponse
+        let status = httpResponse?.statusCode ?? 200
+        if status == 304, let cached {
+            body.cancel()
+            return .cached(cached)
+        }
+        guard (200..<300).contains(status) else {
+            body.cancel()
+            throw Error.unexpectedStatus(url, statusCode: status)
+        }
+        return .body(body, etag: httpResponse?.value(forHTTPHeaderField: "ETag"))
+    }
+
+    private func read(from url: URL, observer: ReadObserver) async throws -> AutodetectSceneReader.RenderMode {
+        let source = try await open(url)
+        guard case .body(let responseBody, let etag) = source, Self.supportsStreaming(url) else {
+            let local: (url: URL, isTemporary: Bool)
+            switch source {
+            case .cached(let entry):
+                local = (entry.fileURL, false)
+            case .body(let responseBody, let etag):
+                local = try await save(responseBody, from: url, etag: etag)
+            }
+            defer {
+                if local.isTemporary {
+                    try? FileManager.default.removeItem(at: local.url)
+                }
+            }
+            return try await Self.readFile(local.url, observer: observer)
+        }
+
+        // Tee the body to disk only when it can be cached afterwards
+        let fileURL = Self.temporaryFileURL(for: url)
+        var body: BodyFile?
+        if etag != nil && cache != nil {
+            body = try BodyFile(fileURL)
+        }
+        // The body counts bytes as buffered until the reader takes them, so a slow parse pauses the download
+        let stream = StreamedInputStream { [responseBody] in responseBody.didConsume(byteCount: $0) }
+        let isPLY = url.pathExtension.lowercased() == "ply"
+        let reading = Task.detached {
+            await Self.run {
+                let reader: SplatSceneReader = isPLY ? SplatPLYSceneReader(stream) : DotSplatSceneReader(stream)
+                reader.read(to: observer)
+                // Not every reader closes its stream; closing releases bytes it left queued so the download can stop
+                stream.close()
+            }
+        }
+
+        // The readers don't surface the header's render mode marker, so scan the bytes they were given
+        let scanSize = AutodetectSceneReader.renderModeScanSize
+        var leadingBytes = Data()
+        var complete = true
+        do {
+            try await Self.receive(responseBody) { chunk in
+                if leadingBytes.count < scanSize {
+                    leadingBytes.append(chunk.prefix(scanSize - leadingBytes.count))
+                }
+                try body?.write(chunk)
+                // False once the reader has given up, which stops the download
+                complete = stream.append(chunk)
+                return complete
+            }
+            stream.finish()
+            try body?.close()
+        } catch {
+            stream.finish(error: error)
+            await reading.value
+            body?.discard()
+            throw error
+        }
+        await reading.value
+
+        if let error = observer.error {
+            body?.discard()
+            throw error
+        }
+        guard observer.didFinish else {
+            body?.discard()
+            throw Error.readFailed(url)
+        }
+        let renderMode = AutodetectSceneReader.detectRenderMode(leadingBytes: leadingBytes)
+        guard let body else { return renderMode }
+        if let etag, let cache, complete, (try? cache.store(fileURL, for: url, etag: etag)) != nil {
+            return renderMode
+        }
+        body.discard()
+        return renderMode
+    }
+
+    /// Downloads the whole body to a file, moving it into the cache when it has an ETag
+    private func save(_ responseBody: ResponseBody, from url: URL, etag: String?) async throws -> (url: URL, isTemporary: Bool) {
+        let fileURL = Self.temporaryFileURL(for: url)
+        let body = try BodyFile(fileURL)
+        do {
+            try await Self.receive(responseBody) { chunk in
+                try body.write(chunk)
+                responseBody.didConsume(byteCount: chunk.count)
+                return true
+            }
+            try body.close()
+        } catch {
+            body.discard()
+            throw error
+        }
+        if let etag, let cache, let entry = try? cache.store(fileURL, for: url, etag: etag) {
+            return (entry.fileURL, false)
+        }
+        return (fileURL, true)
+    }
+
+    /// Hands the body to `sink` in the chunks it arrives in, until it ends or `sink` returns false.
+    /// `sink` reports the bytes it has finished with through `didConsume(byteCount:)`.
+    private static func receive(_ body: ResponseBody, into sink: (Data) throws -> Bool) async throws {
+        // Stops the transfer when the sink gives up or throws; a no-op once the body has ended
+        defer { body.cancel() }
+        for try await chunk in body.chunks {
+            guard try sink(chunk) else { return }
+        }
+    }
+
+    private static func readFile(_ fileURL: URL, observer: ReadObserver) async throws -> AutodetectSceneReader.RenderMode {
+        let renderMode = LockedBox(AutodetectSceneReader.RenderMode.standard)
+        await run {
+            do {
+                let reader = try AutodetectSceneReader(fileURL)
+                renderMode.set(reader.renderMode)
+                reader.read(to: observer)
+            } catch {
+                observer.didFailReading(withError: error)
+            }
+        }
+        if let error = observer.error {
+            throw error
+        }
+        guard observer.didFinish else { throw Error.readFailed(fileURL) }
+        return renderMode.get()
+    }
+
+    /// Runs a blocking reader on a dispatch thread so it doesn't hold a Swift concurrency thread while it waits
+    private static func run(_ body: @escaping @Sendable () -> Void) async {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            DispatchQueue.global(qos: .userInitiated).async {
+                body()
+                continuation.resume()
+            }
+        }
+    }
+
+    private static func temporaryFileURL(for url: URL) -> URL {
+        let name = url.lastPathComponent.isEmpty ? "scene" : url.lastPathComponent
+        return FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString)-\(name)")
+    }
+}
+
+/// Forwards reader callbacks to the caller's delegate and remembers how the read ended
+private final class ReadObserver: SplatSceneReaderDelegate, @unchecked Sendable {
+    private let delegate: SplatSceneReaderDelegate
+    private let url: URL
+    private let lock = NSLock()
+    private var finished = false
+    private var failure: Error?
+    private var reportedEnd = false
+
+    init(_ delegate: SplatSceneReaderDelegate, url: URL) {
+        self.delegate = delegate
+        self.url = url
+    }
+
+    var didFinish: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return finished
+    }
+
+    var error: Error? {
+        lock.lock()
+        defer { lock.unlock() }
+        return failure
+    }
+
+    func didStartReading(withPointCount pointCount: UInt32?) {
+        delegate.didStartReading(withPointCount: pointCount)
+    }
+
+    func didRead(points: [SplatScenePoint]) {
+        delegate.didRead(points: points)
+    }
+
+    func didRead(batch: SplatPointBatch) {
+        delegate.didRead(batch: batch)
+    }
+
+    func didFinishReading() {
+        guard markEnd(error: nil) else { return }
+        delegate.didFinishReading()
+    }
+
+    func didFailReading(withError error: Error?) {
+        guard markEnd(error: error ?? RemoteSceneLoader.Error.readFailed(url)) else { return }
+        delegate.didFailReading(withError: error)
+    }
+
+    /// Reports a failure that happened outside the reader, unless the delegate already heard how the read ended
+    func fail(_ error: Error) {
+        guard markEnd(error: error) else { return }
+        delegate.didFailReading(withError: error)
+    }
+
+    private func markEnd(error: Error?) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !reportedEnd else { return false }
+        reportedEnd = true
+        if let error {
+            failure = error
+        } else {
+            finished = true
+        }
+        return true
+    }
+}
+
+/// Write side of a body being saved while it downloads
+private final class BodyFile {
+    let url: URL
+    private let handle: FileHandle
+
+    init(_ url: URL) throws {
+        self.url = url
+        guard FileManager.default.createFile(atPath: url.path, contents: nil) else {
+            throw CocoaError(.fileWriteUnknown, userInfo: [NSFilePathErrorKey: url.path])
+        }
+        handle = try FileHandle(forWritingTo: url)
+    }
+
+    func write(_ data: Data) throws {
+        try handle.write(contentsOf: data)
+    }
+
+    func close() throws {
+        try handle.close()
+    }
+
+    func discard() {
+        try? handle.close()
+        try? FileManager.default.removeItem(at: url)
+    }
+}
+
+/// A response body delivered in the chunks URLSession receives, through the task's data delegate.
+/// `URLSession.AsyncBytes` hands a body over one byte per iteration, which caps a download at the speed of that loop;
+/// here each `didReceive` chunk is yielded whole. The task suspends while `maximumBufferedByteCount` bytes wait for
+/// the consumer and resumes once half of them are consumed.
+private final class ResponseBody: NSObject, URLSessionDataDelegate, @unchecked Sendable {
+    static let maximumBufferedByteCount = 8 * 1024 * 1024
+
+    let chunks: AsyncThrowingStream<Data, Swift.Error>
+    private let chunkContinuation: AsyncThrowingStream<Data, Swift.Error>.Continuation
+    private let lock = NSLock()
+    private var task: URLSessionDataTask?
+    private var responseContinuation: CheckedContinuation<URLResponse, Swift.Error>?
+    private var bufferedByteCount = 0
+    private var isSuspended = false
+
+    private override init() {
+        (chunks, chunkContinuation) = AsyncThrowingStream.makeStream()
+        super.init()
+    }
+
+    /// Sends `request` and returns once the response headers arrive; the body follows in `chunks`
+    static func start(_ request: URLRequest, in session: URLSession) async throws -> (ResponseBody, URLResponse) {
+        let body = ResponseBody()
+        let task = session.dataTask(with: request)
+        task.delegate = body
+        body.task = task
+        body.chunkContinuation.onTermination = { _ in task.cancel() }
+        do {
+            let response = try await withTaskCancellationHandler {
+                try await withCheckedThrowingContinuation { continuation in
+                    body.lock.withLock { body.responseContinuation = continuation }
+                    task.resume()
+                }
+            } onCancel: {
+                task.cancel()
+            }
+            return (body, response)
+        } catch {
+            if Task.isCancelled { throw CancellationError() }
+            throw error
+        }
+    }
+
+    /// Stops the transfer; `chunks` ends with an error unless the body already completed
+    func cancel() {
+        task?.cancel()
+    }
+
+    /// Called as the consumer finishes with bytes from `chunks`, to resume a task suspended on a full buffer
+    func didConsume(byteCount: Int) {
+        lock.withLock {
+            bufferedByteCount -= byteCount
+            if isSuspended && bufferedByteCount <= Self.maximumBufferedByteCount / 2 {
+                isSuspended = false
+                task?.resume()
+            }
+        }
+    }
+
+    func urlSession(_ session: URLSession,
+                    dataTask: URLSessionDataTask,
+                    didReceive response: URLResponse,
+                    completionHandler: @escaping (URLSession.ResponseDisposition) -> Void) {
+        let continuation = takeResponseContinuation()
+        completionHandler(.allow)
+        continuation?.resume(returning: response)
+    }
+
+    func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
+        chunkContinuation.yield(data)
+        lock.withLock {
+            bufferedByteCount += data.count
+            if !isSuspended && bufferedByteCount > Self.maximumBufferedByteCount {
+                isSuspended = true
+                dataTask.suspend()
+            }
+        }
+    }
+
+    func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Swift.Error?) {
+        // Failing before any response means the request itself failed
+        takeResponseContinuation()?.resume(throwing: error ?? URLError(.badServerResponse))
+        if let error {
+            chunkContinuation.finish(throwing: error)
+        } else {
+            chunkContinuation.finish()
+        }
+    }
+
+    private func takeResponseContinuation() -> CheckedContinuation<URLResponse, Swift.Error>? {
+        lock.withLock {
+            defer { responseContinuation = nil }
+            return responseContinuation
+        }
+    }
+}
@@ -7,6 +7,8 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
         case cannotDetermineOutputFormat
         case unsupportedOutputURL(URL)
         case tooManySphericalHarmonicPalettes(Int)
+        case secondPassNotStarted
+        case secondPassPointCountMismatch(expected: Int, actual: Int)
     }
 
     private struct Asset: Encodable {
@@ -34,11 +36,6 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
         }
     }
 
-    private struct QuantizedPoint {
-        let shCoefficients: [SIMD3<Float>]
-        let positionEncoded: SIMD3<Float>
-    }
-
     private struct QuantizedPaletteEntry: Hashable {
         let bytes: Data
     }
@@ -48,9 +45,147 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
         let data: Data
     }
 
+    /// Scene-wide values the textures are quantized against
+    private struct SceneStatistics {
+        var count = 0
+        var encodedPositionMins = SIMD3<Float>(repeating: .greatestFiniteMagnitude)
+        var encodedPositionMaxs = SIMD3<Float>(repeating: -.greatestFiniteMagnitude)
+        var maxCoefficientCount = 1
+
+        init() {}
+
+        init(_ points: [SplatScenePoint]) {
+            accumulate(points)
+        }
+
+        mutating func accumulate(_ points: [SplatScenePoint]) {
+            for point in points {
+                let encoded = SOGSV2SceneWriter.encodedPosition(point.position)
+                encodedPositionMins = simd_min(encodedPositionMins, encoded)
+                encodedPositionMaxs = simd_max(encodedPositionMaxs, encoded)
+                maxCoefficientCount = max(maxCoefficientCount, point.color.asSphericalHarmonic.count)
+            }
+            count += points.count
+        }
+
+        var mins: [Float] {
+            count == 0 ? [0, 0, 0] : [encodedPositionMins.x, encodedPositionMins.y, encodedPositionMins.z]
+        }
+
+        var maxs: [Float] {
+            count == 0 ? [0, 0, 0] : [encodedPositionMaxs.x, encodedPositionMaxs.y, encodedPositionMaxs.z]
+        }
+
+        var coefficientCount: Int {
+            SOGSV2SceneWriter.normalizedSphericalHarmonicCount(maxCoefficientCount)
+        }
+    }
+
+    /// Texture contents, filled one point at a time in output order
+    private struct TextureAccumulator {
+        let dimensions: TextureDimensions
+        let coefficientCount: Int
+        let mins: SIMD3<Float>
+        let maxs: SIMD3<Float>
+
+        var meansLower: Data
+        var meansUpper: Data
+        var scales: Data
+        var quats: Data
+        var sh0: Data
+        var labels: Data?
+        var paletteLookup: [QuantizedPaletteEntry: UInt16] = [:]
+        var paletteEntries: [QuantizedPaletteEntry] = []
+        var pointCount = 0
+
+        init(statistics: SceneStatistics) {
+            dimensions = SOGSV2SceneWriter.makeBaseTextureDimensions(pointCount: max(statistics.count, 1))
+            coefficientCount = statistics.coefficientCount
+            let mins = statistics.mins
+            let maxs = statistics.maxs
+            self.mins = SIMD3<Float>(mins[0], mins[1], mins[2])
+            self.maxs = SIMD3<Float>(maxs[0], maxs[1], maxs[2])
+
+            meansLower = Data(repeating: 0, count: dimensions.byteCount)
+            meansUpper = Data(repeating: 0, count: dimensions.byteCount)
+            scales = Data(repeating: 0, count: dimensions.byteCount)
+            quats = Data(repeating: 0, count: dimensions.byteCount)
+            sh0 = Data(repeating: 0, count: dimensions.byteCount)
+            labels = coefficientCount > 1 ? Data(repeating: 0, count: dimensions.byteCount) : nil
+        }
+
+        mutating func append(_ points: [SplatScenePoint]) throws {
+            for point in points {
+                try append(point)
+            }
+        }
+
+        mutating func append(_ point: SplatScenePoint) throws {
+            let baseOffset = pointCount * 4
+            let shCoefficients = SOGSV2SceneWriter.paddedSphericalHarmonics(point.color.asSphericalHarmonic, count: coefficientCount)
+
+            let encoded = SOGSV2SceneWriter.encodedPosition(point.position)
+            for componentIndex in 0..<3 {
+                let quantized = SOGSV2SceneWriter.quantizePositionComponent(encoded[componentIndex],
+                                                                            minValue: mins[componentIndex],
+                                                                            maxValue: maxs[componentIndex])
+                meansLower[baseOffset + componentIndex] = UInt8(quantized & 0xFF)
+                meansUpper[baseOffset + componentIndex] = UInt8(quantized >> 8)
+            }
+            meansLower[baseOffset + 3] = 255
+            meansUpper[baseOffset + 3] = 255
+
+            let exponent = point.scale.asExponent
+            scales[baseOffset + 0] = SOGSV2SceneWriter.encodeScale(exponent.x)
+            scales[baseOffset + 1] = SOGSV2SceneWriter.encodeScale(exponent.y)
+            scales[baseOffset + 2] = SOGSV2SceneWriter.encodeScale(exponent.z)
+            scales[baseOffset + 3] = 255
+
+            let quaternion = SOGSV2SceneWriter.encodeQuaternion(point.rotation)
+            quats[baseOffset + 0] = quaternion.0
+            quats[baseOffset + 1] = quaternion.1
+            quats[baseOffset + 2] = quaternion.2
+            quats[baseOffset + 3] = quaternion.3
+
+            let dc = shCoefficients[0]
+            sh0[baseOffset + 0] = SOGSV2SceneWriter.encodeSH0(dc.x)
+            sh0[baseOffset + 1] = SOGSV2SceneWriter.encodeSH0(dc.y)
+            sh0[baseOffset + 2] = SOGSV2SceneWriter.encodeSH0(dc.z)
+            sh0[baseOffset + 3] = SOGSV2SceneWriter.encodeOpacity(point.opacity.asLinearFloat)
+
+            if labels != nil {
+                let paletteIndex = try paletteIndex(for: shCoefficients.dropFirst())
+                labels?[baseOffset + 0] = UInt8(paletteIndex & 0xFF)
+                labels?[baseOffset + 1] = UInt8(paletteIndex >> 8)
+                labels?[baseOffset + 2] = 0
+                labels?[baseOffset + 3] = 255
+            }
+
+            pointCount += 1
+        }
+
+        private mutating func paletteIndex(for coefficients: ArraySlice<SIMD3<Float>>) throws -> UInt16 {
+            let entry = QuantizedPaletteEntry(bytes: SOGSV2SceneWriter.encodePaletteEntry(coefficients))
+            if let existing = paletteLookup[entry] {
+                return existing
+            }
+
+            guard paletteEntries.count < 65_536 else {
+                throw Error.tooManySphericalHarmonicPalettes(paletteEntries.count + 1)
+            }
+
+            let newIndex = UInt16(paletteEntries.count)
+            paletteEntries.append(entry)
+            paletteLookup[entry] = newIndex
+            return newIndex
+        }
+    }
+
     private let antialias: Bool
     private var outputURL: URL?
     private var points: [SplatScenePoint]?
+    private var statistics: SceneStatistics?
+    private var textures: TextureAccumulator?
 
     public init(antialias: Bool = false) {
         self.antialias = antialias
@@ -66,14 +201,25 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
     }
 
     public func close() throws {
-        guard let outputURL, let points else { return }
-        try writeScene(points, to: outputURL)
+        guard let outputURL else { return }
+        if let textures {
+            self.textures = nil
+            try writeTextures(textures, to: outputURL)
+        } else if let points {
+            try writeScene(points, to: outputURL)
+        }
     }
 
     public func writeScene(_ points: [SplatScenePoint], to url: URL) throws {
         try SplatDataValidator.validatePoints(points)
 
-        let payloads = try buildPayloads(for: points)
+        var textures = TextureAccumulator(statistics: SceneStatistics(points))
+        try textures.append(points)
+        try writeTextures(textures, to: url)
+    }
+
+    private func writeTextures(_ textures: TextureAccumulator, to url: URL) throws {
+        let payloads = try buildPayloads(from: textures)
         switch try resolvedOutputKind(for: url) {
         case .archive:
             try writeArchive(payloads, to: url)
@@ -101,32 +247,16 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
         throw Error.unsupportedOutputURL(url)
     }
 
-    private func buildPayloads(for points: [SplatScenePoint]) throws -> [FilePayload] {
-        let baseDimensions = Self.makeBaseTextureDimensions(pointCount: max(points.count, 1))
-        let normalizedCoefficientCount = Self.normalizedSphericalHarmonicCount(
-            points.map { $0.color.asSphericalHarmonic.count }.max() ?? 1
-        )
-        let quantizedPoints = points.map { point in
-            QuantizedPoint(
-                shCoefficients: Self.paddedSphericalHarmonics(point.color.asSphericalHarmonic, count: normalizedCoefficientCount),
-                positionEncoded: SIMD3<Float>(
-                    Self.sogEncodeLog(point.position.x),
-                    Self.sogEncodeLog(point.position.y),
-                    Self.sogEncodeLog(point.position.z)
-                )
-            )
-        }
-
-        let meansTextures = buildMeansTextures(from: quantizedPoints, dimensions: baseDimensions)
-        let scalesTexture = buildScalesTexture(from: points, dimensions: baseDimensions)
-        let quatsTexture = buildQuatsTexture(from: points, dimensions: baseDimensions)
-        let sh0Texture = buildSH0Texture(from: points, quantizedPoints: quantizedPoints, dimensions: baseDimensions)
-        let shNTextures = try buildSHNTextures(from: quantizedPoints, dimensions: baseDimensions)
+    private func buildPayloads(from textures: TextureAccumulator) throws -> [FilePayload] {
+        let dimensions = textures.dimensions
+        let shNTextures = buildSHNTextures(from: textures)
 
         let document = Document(
-            count: points.count,
+            count: textures.pointCount,
             antialias: antialias ? true : nil,
-            means: SOGSMeansInfoV2(mins: meansTextures.mins, maxs: meansTextures.maxs, files: ["means_l.webp", "means_u.webp"]),
+            means: SOGSMeansInfoV2(mins: [textures.mins.x, textures.mins.y, textures.mins.z],
+                                   maxs: [textures.maxs.x, textures.maxs.y, textures.maxs.z],
+                                   files: ["means_l.webp", "means_u.webp"]),
             scales: SOGSScalesInfoV2(codebook: Self.scaleCodebook, mins: nil, maxs: nil, files: ["scales.webp"]),
             quats: SOGSQuatsInfoV2(files: ["quats.webp"]),
             sh0: SOGSH0InfoV2(codebook: Self.sh0Codebook, mins: nil, maxs: nil, files: ["sh0.webp"]),
@@ -139,14 +269,14 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
 
         var payloads = [
             FilePayload(name: "meta.json", data: metaData),
-            FilePayload(name: "means_l.webp", data: try WebPEncoder.encodeLosslessRGBA(meansTextures.lowerBytes, width: baseDimensions.width, height: baseDimensions.height)),
-            FilePayload(name: "means_u.webp", data: try WebPEncoder.encodeLosslessRGBA(meansTextures.upperBytes, width: baseDimensions.width, height: baseDimensions.height)),
-            FilePayload(name: "scales.webp", data: try WebPEncoder.encodeLosslessRGBA(scalesTexture, width: baseDimensions.width, height: baseDimensions.height)),
-            FilePayload(name: "quats.webp", data: try WebPEncoder.encodeLosslessRGBA(quatsTexture, width: baseDimensions.width, height: baseDimensions.height)),
-            FilePayload(name: "sh0.webp", data: try WebPEncoder.encodeLosslessRGBA(sh0Texture, width: baseDimensions.width, height: baseDimensions.height))
+            FilePayload(name: "means_l.webp", data: try WebPEncoder.encodeLosslessRGBA(textures.meansLower, width: dimensions.width, height: dimensions.height)),
+            FilePayload(name: "means_u.webp", data: try WebPEncoder.encodeLosslessRGBA(textures.meansUpper, width: dimensions.width, height: dimensions.height)),
+            FilePayload(name: "scales.webp", data: try WebPEncoder.encodeLosslessRGBA(textures.scales, width: dimensions.width, height: dimensions.height)),
+            FilePayload(name: "quats.webp", data: try WebPEncoder.encodeLosslessRGBA(textures.quats, width: dimensions.width, height: dimensions.height)),
+            FilePayload(name: "sh0.webp", data: try WebPEncoder.encodeLosslessRGBA(textures.sh0, width: dimensions.width, height: dimensions.height))
         ]
 
-        if let shNTextures {
+        if let shNTextures, let labels = textures.labels {
             payloads.append(FilePayload(
                 name: "shN_centroids.webp",
                 data: try WebPEncoder.encodeLosslessRGBA(
@@ -158,9 +288,9 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
             payloads.append(FilePayload(
                 name: "shN_labels.webp",
                 data: try WebPEncoder.encodeLosslessRGBA(
-                    shNTextures.labels,
-                    width: baseDimensions.width,
-                    height: baseDimensions.height
+                    labels,
+                    width: dimensions.width,
+                    height: dimensions.height
                 )
             ))
         }
@@ -168,109 +298,15 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
         return payloads
     }
 
-    private func buildMeansTextures(from points: [QuantizedPoint], dimensions: TextureDimensions) -> (lowerBytes: Data, upperBytes: Data, mins: [Float], maxs: [Float]) {
-        let mins: [Float] = [
-            points.map { $0.positionEncoded.x }.min() ?? 0,
-            points.map { $0.positionEncoded.y }.min() ?? 0,
-            points.map { $0.positionEncoded.z }.min() ?? 0
-        ]
-        let maxs: [Float] = [
-            points.map { $0.positionEncoded.x }.max() ?? 0,
-            points.map { $0.positionEncoded.y }.max() ?? 0,
-            points.map { $0.positionEncoded.z }.max() ?? 0
-        ]
-
-        var lowerBytes = Data(repeating: 0, count: dimensions.byteCount)
-        var upperBytes = Data(repeating: 0, count: dimensions.byteCount)
-
-        for (index, point) in points.enumerated() {
-            let encoded = point.positionEncoded
-            let quantized = [
-                Self.quantizePositionComponent(encoded.x, minValue: mins[0], maxValue: maxs[0]),
-                Self.quantizePositionComponent(encoded.y, minValue: mins[1], maxValue: maxs[1]),
-                Self.quantizePositionComponent(encoded.z, minValue: mins[2], maxValue: maxs[2])
-            ]
-
-            let baseOffset = index * 4
-            for componentIndex in 0..<3 {
-                lowerBytes[baseOffset + componentIndex] = UInt8(quantized[componentIndex] & 0xFF)
-                upperBytes[baseOffset + componentIndex] = UInt8(quantized[componentIndex] >> 8)
-            }
-            lowerBytes[baseOffset + 3] = 255
-            upperBytes[baseOffset + 3] = 255
-        }
-
-        return (lowerBytes, upperBytes, mins, maxs)
-    }
-
-    private func buildScalesTexture(from points: [SplatScenePoint], dimensions: TextureDimensions) -> Data {
-        var data = Data(repeating: 0, count: dimensions.byteCount)
-        for (index, point) in points.enumerated() {
-            let exponent = point.scale.asExponent
-            let baseOffset = index * 4
-            data[baseOffset + 0] = Self.encodeScale(exponent.x)
-            data[baseOffset + 1] = Self.encodeScale(exponent.y)
-            data[baseOffset + 2] = Self.encodeScale(exponent.z)
-            data[baseOffset + 3] = 255
-        }
-        return data
-    }
-
-    private func buildQuatsTexture(from points: [SplatScenePoint], dimensions: TextureDimensions) -> Data {
-        var data = Data(repeating: 0, count: dimensions.byteCount)
-        for (index, point) in points.enumerated() {
-            let encoded = Self.encodeQuaternion(point.rotation)
-            let baseOffset = index * 4
-            data[baseOffset + 0] = encoded.0
-            data[baseOffset + 1] = encoded.1
-            data[baseOffset + 2] = encoded.2
-            data[baseOffset + 3] = encoded.3
-        }
-        return data
-    }
-
-    private func buildSH0Texture(from points: [SplatScenePoint], quantizedPoints: [QuantizedPoint], dimensions: TextureDimensions) -> Data {
-        var data = Data(repeating: 0, count: dimensions.byteCount)
-        for index in points.indices {
-            let sh0 = quantizedPoints[index].shCoefficients[0]
-            let baseOffset = index * 4
-            data[baseOffset + 0] = Self.encodeSH0(sh0.x)
-            data[baseOffset + 1] = Self.encodeSH0(sh0.y)
-            data[baseOffset + 2] = Self.encodeSH0(sh0.z)
-            data[baseOffset + 3] = Self.encodeOpacity(points[index].opacity.asLinearFloat)
-        }
-        return data
-    }
-
-    private func buildSHNTextures(from points: [QuantizedPoint], dimensions: TextureDimensions) throws -> (metadata: SOGSSHNInfoV2, centroids: Data, centroidDimensions: TextureDimensions, labels: Data)? {
-        guard let totalCoefficientCount = points.map({ $0.shCoefficients.count }).max(), totalCoefficientCount > 1 else {
+    private func buildSHNTextures(from textures: TextureAccumulator) -> (metadata: SOGSSHNInfoV2, centroids: Data, centroidDimensions: TextureDimensions)? {
+        let totalCoefficientCount = textures.coefficientCount
+        guard totalCoefficientCount > 1, textures.labels != nil else {
             return nil
         }
 
         let coefficientsPerEntry = totalCoefficientCount - 1
         let bands = Self.bands(forTotalCoefficientCount: totalCoefficientCount)
-
-        var paletteIndices: [UInt16] = []
-        paletteIndices.reserveCapacity(points.count)
-        var paletteLookup: [QuantizedPaletteEntry: UInt16] = [:]
-        var paletteEntries: [QuantizedPaletteEntry] = []
-
-        for point in points {
-            let entry = QuantizedPaletteEntry(bytes: Self.encodePaletteEntry(point.shCoefficients.dropFirst()))
-            if let existing = paletteLookup[entry] {
-                paletteIndices.append(existing)
-                continue
-            }
-
-            guard paletteEntries.count < 65_536 else {
-                throw Error.tooManySphericalHarmonicPalettes(paletteEntries.count + 1)
-            }
-
-            let newIndex = UInt16(paletteEntries.count)
-            paletteEntries.append(entry)
-            paletteLookup[entry] = newIndex
-            paletteIndices.append(newIndex)
-        }
+        let paletteEntries = textures.paletteEntries
 
         let centroidDimensions = TextureDimensions(
             width: 64 * coefficientsPerEntry,
@@ -291,15 +327,6 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
             }
         }
 
-        var labelBytes = Data(repeating: 0, count: dimensions.byteCount)
-        for (index, paletteIndex) in paletteIndices.enumerated() {
-            let baseOffset = index * 4
-            labelBytes[baseOffset + 0] = UInt8(paletteIndex & 0xFF)
-            labelBytes[baseOffset + 1] = UInt8(paletteIndex >> 8)
-            labelBytes[baseOffset + 2] = 0
-            labelBytes[baseOffset + 3] = 255
-        }
-
         let metadata = SOGSSHNInfoV2(
             count: paletteEntries.count,
             bands: bands,
@@ -308,7 +335,7 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
             maxs: nil,
             files: ["shN_centroids.webp", "shN_labels.webp"]
         )
-        return (metadata, centroidBytes, centroidDimensions, labelBytes)
+        return (metadata, centroidBytes, centroidDimensions)
     }
 
     private func writeArchive(_ payloads: [FilePayload], to url: URL) throws {
@@ -378,6 +405,10 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
         return coefficients + Array(repeating: .zero, count: count - coefficients.count)
     }
 
+    private static func encodedPosition(_ position: SIMD3<Float>) -> SIMD3<Float> {
+        SIMD3<Float>(sogEncodeLog(position.x), sogEncodeLog(position.y), sogEncodeLog(position.z))
+    }
+
     private static func sogEncodeLog(_ value: Float) -> Float {
         let transformed = log(abs(value) + 1)
         return value < 0 ? -transformed : transformed
@@ -458,3 +489,31 @@ public final class SOGSV2SceneWriter: SplatSceneWriter {
         UInt8(min(max(Int(value), 0), 255))
     }
 }
+
+// MARK: - Two-Pass Streaming
+
+extension SOGSV2SceneWriter: SplatTwoPassSceneWriter {
+    /// First pass: gathers the position quantization range and spherical harmonic degree
+    public func accumulateStatistics(_ points: [SplatScenePoint]) throws {
+        try SplatDataValidator.validatePoints(points)
+        var statistics = self.statistics ?? SceneStatistics()
+        statistics.accumulate(points)
+        self.statistics = statistics
+    }
+
+    public func beginSecondPass() throws {
+        textures = TextureAccumulator(statistics: statistics ?? SceneStatistics())
+    }
+
+    /// Second pass: quantizes points straight into the textures, so only the encoded bytes are kept
+    public func writeSecondPass(_ points: [SplatScenePoint]) throws {
+        guard let written = textures?.pointCount else {
+            throw Error.secondPassNotStarted
+        }
+        let expected = statistics?.count ?? 0
+        guard written + points.count <= expected else {
+            throw Error.secondPassPointCountMismatch(expected: expected, actual: written + points.count)
+        }
+        try textures?.append(points)
+    }
+}
@@ -183,6 +183,57 @@ public class SPZSceneReader: SplatSceneReader {
         }
     }
     
+    // MARK: - Packed Streams
+
+    /// The quantized attribute streams of an SPZ file, one tightly packed byte array per attribute
+    public struct PackedStreams: Sendable {
+        public let pointCount: Int
+        public let shDegree: Int
+        /// Fractional bits of 24-bit fixed-point positions
+        public let fractionalBits: Int
+        /// Positions are 3 × float16 (6 bytes) instead of 3 × 24-bit fixed point (9 bytes)
+        public let usesFloat16Positions: Bool
+        /// Rotations are smallest-three packed in 4 bytes instead of first-three in 3 bytes
+        public let usesSmallestThreeRotations: Bool
+        public let positions: [UInt8]
+        public let scales: [UInt8]
+        public let rotations: [UInt8]
+        public let alphas: [UInt8]
+        public let colors: [UInt8]
+        public let sh: [UInt8]
+
+        public var positionStride: Int { usesFloat16Positions ? 6 : 9 }
+        public var rotationStride: Int { usesSmallestThreeRotations ? 4 : 3 }
+    }
+
+    /// Deserializes the file without dequantizing any point, for consumers that dequantize themselves
+    /// (such as a GPU decode). Unlike `readScene()`, which skips points with missing data, this throws
+    /// unless every stream covers every point.
+    public func readPackedStreams() throws -> PackedStreams {
+        let packed = try PackedGaussians.deserialize(data)
+        let pointCount = min(packed.numPoints, 10_000_000)
+        let streams = PackedStreams(pointCount: pointCount,
+                                    shDegree: packed.shDegree,
+                                    fractionalBits: packed.fractionalBits,
+                                    usesFloat16Positions: packed.usesFloat16,
+                                    usesSmallestThreeRotations: packed.usesQuaternionSmallestThree,
+                                    positions: packed.positions,
+                                    scales: packed.scales,
+                                    rotations: packed.rotations,
+                                    alphas: packed.alphas,
+                                    colors: packed.colors,
+                                    sh: packed.sh)
+
+        guard streams.positions.count >= pointCount * streams.positionStride,
+              streams.scales.count >= pointCount * 3,
+              streams.rotations.count >= pointCount * streams.rotationStride,
+              streams.alphas.count >= pointCount,
+              streams.colors.count >= pointCount * 3 else {
+            throw SplatFileFormatError.invalidData
+        }
+        return streams
+    }
+
     // MARK: - Private helpers
 
     private func refreshMetadata() {
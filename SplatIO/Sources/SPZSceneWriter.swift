@@ -39,6 +39,11 @@ public class SPZSceneWriter: SplatSceneWriter {
     }
     
     public func close() throws {
+        if let streamingPacked, let outputURL {
+            self.streamingPacked = nil
+            try writePacked(streamingPacked, to: outputURL)
+            return
+        }
         guard let outputURL = outputURL, let points = points else {
             // Nothing to do if no URL or points are set
             return
@@ -54,13 +59,22 @@ public class SPZSceneWriter: SplatSceneWriter {
     
     // Store points for writing
     private var points: [SplatScenePoint]?
+
+    // Two-pass state: first-pass statistics, then the packed output filled by the second pass
+    private var statisticsPointCount = 0
+    private var maxAbsolutePosition: Float = 0
+    private var streamingPacked: PackedGaussians?
+    private var streamingPointsWritten = 0
     
     // Direct writing method
     public func writeScene(_ points: [SplatScenePoint], to url: URL) throws {
         // Validate points before writing
         try SplatDataValidator.validatePoints(points)
         
-        let packed = packGaussians(points)
+        try writePacked(packGaussians(points), to: url)
+    }
+
+    private func writePacked(_ packed: PackedGaussians, to url: URL) throws {
         if outputVersion >= 4 {
             let serialized = try packed.serializeNgspV4()
             try serialized.write(to: url)
@@ -76,30 +90,38 @@ public class SPZSceneWriter: SplatSceneWriter {
     
     // MARK: - Private helpers
     
+    private var writesFloat16Positions: Bool {
+        useFloat16 && outputVersion == 1
+    }
+
     private func packGaussians(_ points: [SplatScenePoint]) -> PackedGaussians {
+        var result = makePackedGaussians(count: points.count, fractionalBits: fractionalBits)
+
+        // Pack each point
+        for (i, point) in points.enumerated() {
+            packPoint(point, into: &result, at: i, useFloat16Positions: writesFloat16Positions)
+        }
+        
+        return result
+    }
+
+    private func makePackedGaussians(count: Int, fractionalBits: Int) -> PackedGaussians {
         var result = PackedGaussians()
         result.version = outputVersion
-        result.numPoints = points.count
+        result.numPoints = count
         result.shDegree = 0 // Only supporting SH degree 0 for now
         result.fractionalBits = fractionalBits
         result.antialiased = antialiased
         result.usesQuaternionSmallestThree = outputVersion >= 3
-        let writesFloat16 = useFloat16 && outputVersion == 1
         
         // Pre-allocate arrays
-        let positionComponents = writesFloat16 ? 6 : 9 // 2 bytes per component for float16, 3 bytes for fixed-point
-        result.positions = [UInt8](repeating: 0, count: points.count * positionComponents)
-        result.scales = [UInt8](repeating: 0, count: points.count * 3)
+        let positionComponents = writesFloat16Positions ? 6 : 9 // 2 bytes per component for float16, 3 bytes for fixed-point
+        result.positions = [UInt8](repeating: 0, count: count * positionComponents)
+        result.scales = [UInt8](repeating: 0, count: count * 3)
         let rotationComponents = result.usesQuaternionSmallestThree ? 4 : 3
-        result.rotations = [UInt8](repeating: 0, count: points.count * rotationComponents)
-        result.alphas = [UInt8](repeating: 0, count: points.count)
-        result.colors = [UInt8](repeating: 0, count: points.count * 3)
-        
-        // Pack each point
-        for (i, point) in points.enumerated() {
-            packPoint(point, into: &result, at: i, useFloat16Positions: writesFloat16)
-        }
-        
+        result.rotations = [UInt8](repeating: 0, count: count * rotationComponents)
+        result.alphas = [UInt8](repeating: 0, count: count)
+        result.colors = [UInt8](repeating: 0, count: count * 3)
         return result
     }
     
@@ -117,7 +139,7 @@ public class SPZSceneWriter: SplatSceneWriter {
             }
         } else {
             let baseIdx = index * 9
-            let scale = Float(1 << fractionalBits)
+            let scale = Float(1 << packed.fractionalBits)
             for j in 0..<3 {
                 let fixed = Int32(position[j] * scale)
                 packed.positions[baseIdx + j*3] = UInt8(fixed & 0xFF)
@@ -247,3 +269,56 @@ public class SPZSceneWriter: SplatSceneWriter {
         return UInt16(sign | (exponent << 10) | mantissa)
     }
 }
+
+// MARK: - Two-Pass Streaming
+
+extension SPZSceneWriter: SplatTwoPassSceneWriter {
+    public enum TwoPassError: Swift.Error {
+        case secondPassNotStarted
+        case secondPassPointCountMismatch(expected: Int, actual: Int)
+    }
+
+    /// First pass: gathers the point count and position extent
+    public func accumulateStatistics(_ points: [SplatScenePoint]) throws {
+        try SplatDataValidator.validatePoints(points)
+        for point in points {
+            let magnitude = simd_reduce_max(simd_abs(point.position))
+            maxAbsolutePosition = max(maxAbsolutePosition, magnitude)
+        }
+        statisticsPointCount += points.count
+    }
+
+    /// Allocates the packed output. Fixed-point positions use the configured fractional bits, reduced if
+    /// needed so the scene's extent fits in 24 bits.
+    public func beginSecondPass() throws {
+        let bits = Self.fractionalBits(fitting: maxAbsolutePosition, preferred: fractionalBits)
+        streamingPacked = makePackedGaussians(count: statisticsPointCount, fractionalBits: bits)
+        streamingPointsWritten = 0
+    }
+
+    /// Second pass: packs points straight into the output arrays, so only the packed bytes are kept
+    public func writeSecondPass(_ points: [SplatScenePoint]) throws {
+        guard streamingPacked != nil else {
+            throw TwoPassError.secondPassNotStarted
+        }
+        guard streamingPointsWritten + points.count <= statisticsPointCount else {
+            throw TwoPassError.secondPassPointCountMismatch(expected: statisticsPointCount,
+                                                            actual: streamingPointsWritten + points.count)
+        }
+        let useFloat16Positions = writesFloat16Positions
+        for point in points {
+            packPoint(point, into: &streamingPacked!, at: streamingPointsWritten, useFloat16Positions: useFloat16Positions)
+            streamingPointsWritten += 1
+        }
+    }
+
+    /// Largest fractional bit count, up to `preferred`, whose 24-bit signed fixed point can hold `maxAbsolutePosition`
+    static func fractionalBits(fitting maxAbsolutePosition: Float, preferred: Int) -> Int {
+        let limit = Float((1 << 23) - 1)
+        var bits = preferred
+        while bits > 0 && maxAbsolutePosition * Float(1 << bits) > limit {
+            bits -= 1
+        }
+        return bits
+    }
+}
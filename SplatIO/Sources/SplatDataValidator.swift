@@ -197,15 +197,26 @@ public struct SplatDataValidator {
     
     /// Validates an array of points, collecting all errors before throwing
     public static func validatePoints(_ points: [SplatScenePoint], mode: ValidationMode = .lenient) throws {
+        try validateSampledPoints(count: points.count, mode: mode) { points[$0] }
+    }
+
+    /// Validates a columnar batch, materializing only the sampled points
+    public static func validateBatch(_ batch: SplatPointBatch, mode: ValidationMode = .lenient) throws {
+        try validateSampledPoints(count: batch.count, mode: mode) { batch[$0] }
+    }
+
+    private static func validateSampledPoints(count: Int,
+                                              mode: ValidationMode,
+                                              point: (Int) -> SplatScenePoint) throws {
         var errors: [SplatValidationError] = []
         
         // Only sample a subset for performance on large datasets
-        let sampleSize = min(points.count, 1000)
-        let step = max(1, points.count / sampleSize)
+        let sampleSize = min(count, 1000)
+        let step = max(1, count / sampleSize)
         
-        for i in stride(from: 0, to: points.count, by: step) {
+        for i in stride(from: 0, to: count, by: step) {
             do {
-                try validatePoint(points[i], mode: mode)
+                try validatePoint(point(i), mode: mode)
             } catch let error as SplatValidationError {
                 errors.append(error)
                 
@@ -56,6 +56,9 @@ public struct SplatMemoryBuffer {
 
     public var points: [SplatScenePoint] = []
 
+    /// Columnar contents filled by `readBatch(from:)`
+    public var batch = SplatPointBatch()
+
     public init() {}
 
     /** Replace the content of points with the content read from the given SplatSceneReader. */
@@ -70,4 +73,9 @@ public struct SplatMemoryBuffer {
             }
         }
     }
+
+    /** Replace the content of batch with the content read from the given SplatSceneReader, without materializing points for readers that decode columnar batches. */
+    mutating public func readBatch(from reader: SplatSceneReader) async throws {
+        batch = try reader.readBatch()
+    }
 }
@@ -0,0 +1,181 @@
+import Foundation
+import PLYIO
+import simd
+
+/// Byte layout of a fixed-stride `binary_little_endian` 3DGS PLY, resolved once from the header.
+///
+/// This lets consumers decode vertices straight out of a memory-mapped file, without going through
+/// `PLYElement` or `SplatScenePoint`. Only the common layout is supported: the vertex element is the
+/// first element, every property is a primitive, and position, `f_dc_*`, opacity, scale and rotation
+/// are all float32. Anything else yields `nil`; those files should use `SplatPLYSceneReader`.
+public struct SplatPLYBinaryLayout: Sendable {
+    public let pointCount: Int
+    /// Offset of the first vertex in the file
+    public let bodyOffset: Int
+    /// Bytes per vertex
+    public let stride: Int
+
+    public let positionOffsets: SIMD3<Int>
+    /// Offsets of the DC spherical harmonic (`f_dc_0...2`)
+    public let colorOffsets: SIMD3<Int>
+    /// Offsets of the higher-order spherical harmonic triplets (`f_rest_*`), in file order
+    public let sphericalHarmonicOffsets: [SIMD3<Int>]
+    public let opacityOffset: Int
+    public let scaleOffsets: SIMD3<Int>
+    /// Offsets of `rot_0...3` (real, then imaginary x/y/z)
+    public let rotationOffsets: SIMD4<Int>
+
+    public init?(header: PLYHeader, bodyOffset: Int) {
+        guard header.format == .binaryLittleEndian,
+              let element = header.elements.first,
+              element.name == SplatPLYConstants.ElementName.point.rawValue,
+              let stride = element.fixedByteStride else {
+            return nil
+        }
+
+        func offset(_ names: [String]) -> Int? {
+            for name in names {
+                if let index = element.index(forPropertyNamed: name) {
+                    guard case .primitive(.float32) = element.properties[index].type else { return nil }
+                    return element.byteOffset(forPropertyAt: index)
+                }
+            }
+            return nil
+        }
+
+        func offsets(_ x: [String], _ y: [String], _ z: [String]) -> SIMD3<Int>? {
+            guard let x = offset(x), let y = offset(y), let z = offset(z) else { return nil }
+            return SIMD3(x, y, z)
+        }
+
+        typealias Names = SplatPLYConstants.PropertyName
+        guard let position = offsets(Names.positionX, Names.positionY, Names.positionZ),
+              let color = offsets(Names.sh0_r, Names.sh0_g, Names.sh0_b),
+              let opacity = offset(Names.opacity),
+              let scale = offsets(Names.scaleX, Names.scaleY, Names.scaleZ),
+              let rotation0 = offset(Names.rotation0),
+              let rotation1 = offset(Names.rotation1),
+              let rotation2 = offset(Names.rotation2),
+              let rotation3 = offset(Names.rotation3) else {
+            return nil
+        }
+
+        var restOffsets: [Int] = []
+        while let restOffset = offset(["\(Names.sphericalHarmonicsPrefix)\(restOffsets.count)"]) {
+            restOffsets.append(restOffset)
+        }
+        // Matches SplatPLYSceneReader: SH triplets are consecutive f_rest properties
+        let tripletCount = restOffsets.count / 3
+
+        self.pointCount = Int(element.count)
+        self.bodyOffset = bodyOffset
+        self.stride = stride
+        self.positionOffsets = position
+        self.colorOffsets = color
+        self.sphericalHarmonicOffsets = (0..<tripletCount).map {
+            SIMD3(restOffsets[$0 * 3], restOffsets[$0 * 3 + 1], restOffsets[$0 * 3 + 2])
+        }
+        self.opacityOffset = opacity
+        self.scaleOffsets = scale
+        self.rotationOffsets = SIMD4(rotation0, rotation1, rotation2, rotation3)
+    }
+
+    /// Memory-maps a PLY file and resolves its layout.
+    /// - Returns: nil if the file does not use the supported fixed layout
+    public static func mapFile(at url: URL) throws -> (layout: SplatPLYBinaryLayout, data: Data)? {
+        let data = try Data(contentsOf: url, options: [.alwaysMapped])
+        let (header, bodyOffset) = try PLYReader.decodeHeader(fromPrefixOf: data)
+        guard let layout = SplatPLYBinaryLayout(header: header, bodyOffset: bodyOffset) else {
+            return nil
+        }
+        guard data.count >= layout.bodyOffset + layout.pointCount * layout.stride else {
+            throw PLYReader.Error.unexpectedEndOfFile
+        }
+        return (layout, data)
+    }
+
+    // MARK: - Vertex Access
+
+    @inlinable
+    public func float(_ vertex: UnsafeRawPointer, at offset: Int) -> Float {
+        Float(bitPattern: UInt32(littleEndian: vertex.loadUnaligned(fromByteOffset: offset, as: UInt32.self)))
+    }
+
+    @inlinable
+    public func vector(_ vertex: UnsafeRawPointer, at offsets: SIMD3<Int>) -> SIMD3<Float> {
+        SIMD3(float(vertex, at: offsets.x), float(vertex, at: offsets.y), float(vertex, at: offsets.z))
+    }
+
+    @inlinable
+    public func position(_ vertex: UnsafeRawPointer) -> SIMD3<Float> {
+        vector(vertex, at: positionOffsets)
+    }
+
+    /// DC spherical harmonic coefficient; see `SplatPointBatch.colors`
+    @inlinable
+    public func color(_ vertex: UnsafeRawPointer) -> SIMD3<Float> {
+        vector(vertex, at: colorOffsets)
+    }
+
+    /// Display color in 0...1, equivalent to `SplatScenePoint.Color.asLinearFloat`
+    public func linearColor(_ vertex: UnsafeRawPointer) -> SIMD3<Float> {
+        SplatScenePoint.Color.primarySphericalHarmonicToLinear(color(vertex))
+    }
+
+    /// Logit opacity
+    @inlinable
+    public func opacity(_ vertex: UnsafeRawPointer) -> Float {
+        float(vertex, at: opacityOffset)
+    }
+
+    /// Opacity in 0...1, equivalent to `SplatScenePoint.Opacity.asLinearFloat`
+    public func linearOpacity(_ vertex: UnsafeRawPointer) -> Float {
+        SplatScenePoint.Opacity.sigmoid(opacity(vertex))
+    }
+
+    /// Log scale
+    @inlinable
+    public func scale(_ vertex: UnsafeRawPointer) -> SIMD3<Float> {
+        vector(vertex, at: scaleOffsets)
+    }
+
+    /// Unnormalized rotation quaternion
+    @inlinable
+    public func rotation(_ vertex: UnsafeRawPointer) -> simd_quatf {
+        simd_quatf(real: float(vertex, at: rotationOffsets.x),
+                   imag: SIMD3(float(vertex, at: rotationOffsets.y),
+                               float(vertex, at: rotationOffsets.z),
+                               float(vertex, at: rotationOffsets.w)))
+    }
+
+    /// Decodes every vertex of a file mapped with `mapFile(at:)`, higher-order spherical harmonics included.
+    /// Point `i` of the batch is vertex `order[i]` when an order is given.
+    public func batch(from data: Data, order: [Int]? = nil) -> SplatPointBatch {
+        var batch = SplatPointBatch(shCoefficientsPerPoint: sphericalHarmonicOffsets.count, reservingCapacity: pointCount)
+        data.withUnsafeBytes { (raw: UnsafeRawBufferPointer) in
+            guard let base = raw.baseAddress else { return }
+            let body = base.advanced(by: bodyOffset)
+            for index in 0..<pointCount {
+                let vertex = body.advanced(by: (order?[index] ?? index) * stride)
+                batch.positions.append(position(vertex))
+                batch.colors.append(color(vertex))
+                for offsets in sphericalHarmonicOffsets {
+                    batch.sphericalHarmonics.append(vector(vertex, at: offsets))
+                }
+                batch.opacities.append(opacity(vertex))
+                batch.scales.append(scale(vertex))
+                batch.rotations.append(rotation(vertex))
+            }
+        }
+        return batch
+    }
+
+    /// Materializes one vertex (DC color only), e.g. for validating a sample of the file
+    public func point(_ vertex: UnsafeRawPointer) -> SplatScenePoint {
+        SplatScenePoint(position: position(vertex),
+                        color: .sphericalHarmonic([ color(vertex) ]),
+                        opacity: .logitFloat(opacity(vertex)),
+                        scale: .exponent(scale(vertex)),
+                        rotation: rotation(vertex))
+    }
+}
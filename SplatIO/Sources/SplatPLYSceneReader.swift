@@ -1,5 +1,6 @@
 import Foundation
 import PLYIO
+import simd
 
 public class SplatPLYSceneReader: SplatSceneReader {
     enum Error: LocalizedError {
@@ -50,12 +51,7 @@ private class SplatPLYSceneReaderStream {
     private var elementMapping: ElementInputMapping?
     private var expectedPointCount: UInt32 = 0
     private var pointCount: UInt32 = 0
-    private var reusablePoint = SplatScenePoint(position: .zero,
-                                                color: .linearUInt8(.zero),
-                                                opacity: .linearFloat(.zero),
-                                                scale: .exponent(.zero),
-                                                rotation: .init(vector: .zero))
-    private var pointBatch: [SplatScenePoint] = []
+    private var pointBatch = SplatPointBatch()
 
     func read(_ ply: PLYReader, to delegate: SplatSceneReaderDelegate) {
         self.delegate = delegate
@@ -63,8 +59,7 @@ private class SplatPLYSceneReaderStream {
         elementMapping = nil
         expectedPointCount = 0
         pointCount = 0
-        pointBatch = []
-        pointBatch.reserveCapacity(Self.batchSize)
+        pointBatch = SplatPointBatch()
 
         ply.read(to: self)
 
@@ -85,6 +80,8 @@ extension SplatPLYSceneReaderStream: PLYReaderDelegate {
             let elementMapping = try ElementInputMapping.elementMapping(for: header)
             self.elementMapping = elementMapping
             expectedPointCount = header.elements[elementMapping.elementTypeIndex].count
+            pointBatch = SplatPointBatch(shCoefficientsPerPoint: elementMapping.sphericalHarmonicCoefficientCount,
+                                         reservingCapacity: Self.batchSize)
             delegate?.didStartReading(withPointCount: expectedPointCount)
         } catch {
             delegate?.didFailReading(withError: error)
@@ -103,13 +100,12 @@ extension SplatPLYSceneReaderStream: PLYReaderDelegate {
 
         guard typeIndex == elementMapping.elementTypeIndex else { return }
         do {
-            try elementMapping.apply(from: element, to: &reusablePoint)
+            try elementMapping.apply(from: element, to: &pointBatch)
             pointCount += 1
 
-            // Batch points to reduce ARC/GC overhead from single-element array allocations
-            pointBatch.append(reusablePoint)
+            // Columnar batches avoid a spherical harmonic array allocation per point
             if pointBatch.count >= Self.batchSize {
-                delegate?.didRead(points: pointBatch)
+                delegate?.didRead(batch: pointBatch)
                 pointBatch.removeAll(keepingCapacity: true)
             }
         } catch {
@@ -124,7 +120,7 @@ extension SplatPLYSceneReaderStream: PLYReaderDelegate {
 
         // Flush any remaining batched points
         if !pointBatch.isEmpty {
-            delegate?.didRead(points: pointBatch)
+            delegate?.didRead(batch: pointBatch)
             pointBatch.removeAll(keepingCapacity: false)
         }
 
@@ -168,6 +164,12 @@ private struct ElementInputMapping {
     let rotation2PropertyIndex: Int
     let rotation3PropertyIndex: Int
 
+    /// Higher-order spherical harmonic triplets stored per point (0 for plain RGB color)
+    var sphericalHarmonicCoefficientCount: Int {
+        guard case let .sphericalHarmonic(indices) = colorPropertyIndices else { return 0 }
+        return indices.count - 1
+    }
+
     static func elementMapping(for header: PLYHeader) throws -> ElementInputMapping {
         guard let elementTypeIndex = header.index(forElementNamed: SplatPLYConstants.ElementName.point.rawValue) else {
             throw SplatPLYSceneReader.Error.unsupportedFileContents("No element type \"\(SplatPLYConstants.ElementName.point.rawValue)\" found")
@@ -247,37 +249,55 @@ private struct ElementInputMapping {
                                    rotation3PropertyIndex: rotation3PropertyIndex)
     }
 
-    func apply(from element: PLYElement, to result: inout SplatScenePoint) throws {
-        result.position = SIMD3(x: try element.float32Value(forPropertyIndex: positionXPropertyIndex),
-                                y: try element.float32Value(forPropertyIndex: positionYPropertyIndex),
-                                z: try element.float32Value(forPropertyIndex: positionZPropertyIndex))
+    func apply(from element: PLYElement, to batch: inout SplatPointBatch) throws {
+        // Read every property before appending so a throwing read leaves the columns aligned
+        let position = SIMD3(x: try element.float32Value(forPropertyIndex: positionXPropertyIndex),
+                             y: try element.float32Value(forPropertyIndex: positionYPropertyIndex),
+                             z: try element.float32Value(forPropertyIndex: positionZPropertyIndex))
 
+        let color: SIMD3<Float>
         switch colorPropertyIndices {
         case .sphericalHarmonic(let sphericalHarmonicsPropertyIndices):
-            result.color = .sphericalHarmonic(try sphericalHarmonicsPropertyIndices.map {
-                try SIMD3<Float>(x: element.float32Value(forPropertyIndex: $0.x),
-                                 y: element.float32Value(forPropertyIndex: $0.y),
-                                 z: element.float32Value(forPropertyIndex: $0.z))
-            })
+            color = try element.float32Vector(forPropertyIndices: sphericalHarmonicsPropertyIndices[0])
         case .linearFloat256(let propertyIndices):
-            result.color = .linearFloat256(SIMD3(try element.float32Value(forPropertyIndex: propertyIndices.x),
-                                                 try element.float32Value(forPropertyIndex: propertyIndices.y),
-                                                 try element.float32Value(forPropertyIndex: propertyIndices.z)))
+            color = SplatScenePoint.Color.linearToPrimarySphericalHarmonic(
+                try element.float32Vector(forPropertyIndices: propertyIndices) / 256)
         case .linearUInt8(let propertyIndices):
-            result.color = .linearUInt8(SIMD3(try element.uint8Value(forPropertyIndex: propertyIndices.x),
-                                              try element.uint8Value(forPropertyIndex: propertyIndices.y),
-                                              try element.uint8Value(forPropertyIndex: propertyIndices.z)))
+            let value = SIMD3(try element.uint8Value(forPropertyIndex: propertyIndices.x),
+                              try element.uint8Value(forPropertyIndex: propertyIndices.y),
+                              try element.uint8Value(forPropertyIndex: propertyIndices.z))
+            color = SplatScenePoint.Color.linearToPrimarySphericalHarmonic(value.asFloat / 255)
         }
 
-        result.scale =
-            .exponent(SIMD3(try element.float32Value(forPropertyIndex: scaleXPropertyIndex),
-                            try element.float32Value(forPropertyIndex: scaleYPropertyIndex),
-                            try element.float32Value(forPropertyIndex: scaleZPropertyIndex)))
-        result.opacity = .logitFloat(try element.float32Value(forPropertyIndex: opacityPropertyIndex))
-        result.rotation.real   = try element.float32Value(forPropertyIndex: rotation0PropertyIndex)
-        result.rotation.imag.x = try element.float32Value(forPropertyIndex: rotation1PropertyIndex)
-        result.rotation.imag.y = try element.float32Value(forPropertyIndex: rotation2PropertyIndex)
-        result.rotation.imag.z = try element.float32Value(forPropertyIndex: rotation3PropertyIndex)
+        let scale = SIMD3(try element.float32Value(forPropertyIndex: scaleXPropertyIndex),
+                          try element.float32Value(forPropertyIndex: scaleYPropertyIndex),
+                          try element.float32Value(forPropertyIndex: scaleZPropertyIndex))
+        let opacity = try element.float32Value(forPropertyIndex: opacityPropertyIndex)
+        let rotation = simd_quatf(real: try element.float32Value(forPropertyIndex: rotation0PropertyIndex),
+                                  imag: SIMD3(try element.float32Value(forPropertyIndex: rotation1PropertyIndex),
+                                              try element.float32Value(forPropertyIndex: rotation2PropertyIndex),
+                                              try element.float32Value(forPropertyIndex: rotation3PropertyIndex)))
+
+        let shCount = batch.shCoefficientsPerPoint
+        if shCount > 0, case .sphericalHarmonic(let sphericalHarmonicsPropertyIndices) = colorPropertyIndices {
+            let restStart = batch.sphericalHarmonics.count
+            do {
+                for i in 0..<shCount {
+                    batch.sphericalHarmonics.append(try element.float32Vector(forPropertyIndices: sphericalHarmonicsPropertyIndices[i + 1]))
+                }
+            } catch {
+                batch.sphericalHarmonics.removeSubrange(restStart...)
+                throw error
+            }
+        } else {
+            batch.appendZeroSphericalHarmonics()
+        }
+
+        batch.positions.append(position)
+        batch.colors.append(color)
+        batch.opacities.append(opacity)
+        batch.scales.append(scale)
+        batch.rotations.append(rotation)
     }
 }
 
@@ -337,6 +357,12 @@ private extension PLYElement {
         return typedValue
     }
 
+    func float32Vector(forPropertyIndices propertyIndices: SIMD3<Int>) throws -> SIMD3<Float> {
+        SIMD3(x: try float32Value(forPropertyIndex: propertyIndices.x),
+              y: try float32Value(forPropertyIndex: propertyIndices.y),
+              z: try float32Value(forPropertyIndex: propertyIndices.z))
+    }
+
     func uint8Value(forPropertyIndex propertyIndex: Int) throws -> UInt8 {
         guard case .uint8(let typedValue) = properties[propertyIndex] else { throw SplatPLYSceneReader.Error.internalConsistency("Unexpected type for property at index \(propertyIndex)") }
         return typedValue
@@ -2,7 +2,7 @@ import Foundation
 import PLYIO
 import simd
 
-public class SplatPLYSceneWriter: SplatSceneWriter {
+public class SplatPLYSceneWriter: SplatChunkEncodingWriter {
     enum Error: Swift.Error {
         case cannotWriteToFile(String)
         case unknownOutputStreamError
@@ -26,6 +26,7 @@ public class SplatPLYSceneWriter: SplatSceneWriter {
 
     private var elementBuffer: [PLYElement] = Array.init(repeating: PLYElement(properties: []), count: Constants.elementBufferSize)
     private var elementMapping: ElementOutputMapping?
+    private var header: PLYHeader?
 
     public init(_ outputStream: OutputStream) {
         plyWriter = PLYWriter(outputStream)
@@ -57,6 +58,7 @@ public class SplatPLYSceneWriter: SplatSceneWriter {
 
         self.totalPointCount = pointCount
         self.elementMapping = elementMapping
+        self.header = header
     }
 
     public func write(_ points: [SplatScenePoint]) throws {
@@ -86,6 +88,64 @@ public class SplatPLYSceneWriter: SplatSceneWriter {
 
         pointsWritten += points.count
     }
+
+    public func write(_ batch: SplatPointBatch) throws {
+        guard let elementMapping else {
+            throw Error.notStarted
+        }
+        guard !closed else {
+            throw Error.cannotWriteAfterClose
+        }
+
+        guard batch.count + pointsWritten <= totalPointCount else {
+            throw Error.unexpectedPoints
+        }
+
+        try SplatDataValidator.validateBatch(batch)
+
+        var elementBufferOffset = 0
+        for i in 0..<batch.count {
+            elementBuffer[elementBufferOffset].set(toPointAt: i, in: batch, with: elementMapping)
+            elementBufferOffset += 1
+            if elementBufferOffset == elementBuffer.count || i == batch.count-1 {
+                try plyWriter.write(elementBuffer, count: elementBufferOffset)
+                elementBufferOffset = 0
+            }
+        }
+
+        pointsWritten += batch.count
+    }
+
+    /// Encodes points into PLY element bytes; safe to call concurrently once `start` has been called
+    public func encodeChunk(_ points: [SplatScenePoint]) throws -> SplatEncodedChunk {
+        guard let elementMapping, let header, let elementHeader = header.elements.first else {
+            throw Error.notStarted
+        }
+
+        try SplatDataValidator.validatePoints(points)
+
+        var elements = Array(repeating: PLYElement(properties: []), count: points.count)
+        for i in 0..<points.count {
+            elements[i].set(to: points[i], with: elementMapping)
+        }
+        let data = try PLYWriter.encode(elements, type: elementHeader, format: header.format)
+        return SplatEncodedChunk(data: data, pointCount: points.count)
+    }
+
+    public func write(encoded chunk: SplatEncodedChunk) throws {
+        guard elementMapping != nil else {
+            throw Error.notStarted
+        }
+        guard !closed else {
+            throw Error.cannotWriteAfterClose
+        }
+        guard chunk.pointCount + pointsWritten <= totalPointCount else {
+            throw Error.unexpectedPoints
+        }
+
+        try plyWriter.write(encoded: chunk.data, elementCount: chunk.pointCount)
+        pointsWritten += chunk.pointCount
+    }
 }
 
 private struct ElementOutputMapping {
@@ -195,4 +255,59 @@ fileprivate extension PLYElement {
             properties = properties.dropLast(properties.count - propertyCount)
         }
     }
+
+    /// Columnar counterpart of `set(to:with:)`; batch attributes are already in PLY encodings
+    mutating func set(toPointAt index: Int, in batch: SplatPointBatch, with mapping: ElementOutputMapping) {
+        var propertyCount = 0
+
+        func appendProperty(_ value: Float) {
+            if properties.count == propertyCount {
+                properties.append(.float32(value))
+            } else {
+                properties[propertyCount] = .float32(value)
+            }
+            propertyCount += 1
+        }
+
+        let position = batch.positions[index]
+        appendProperty(position.x)
+        appendProperty(position.y)
+        appendProperty(position.z)
+
+        // Normal
+        appendProperty(0)
+        appendProperty(0)
+        appendProperty(1)
+
+        let directColor = batch.colors[index]
+        appendProperty(directColor.x)
+        appendProperty(directColor.y)
+        appendProperty(directColor.z)
+
+        let shStride = batch.shCoefficientsPerPoint
+        let shBase = index * shStride
+        for i in 0..<mapping.indirectColorCount {
+            let shColor = i < shStride ? batch.sphericalHarmonics[shBase + i] : .zero
+            appendProperty(shColor.x)
+            appendProperty(shColor.y)
+            appendProperty(shColor.z)
+        }
+
+        appendProperty(batch.opacities[index])
+
+        let scale = batch.scales[index]
+        appendProperty(scale.x)
+        appendProperty(scale.y)
+        appendProperty(scale.z)
+
+        let rotation = batch.rotations[index]
+        appendProperty(rotation.real)
+        appendProperty(rotation.imag.x)
+        appendProperty(rotation.imag.y)
+        appendProperty(rotation.imag.z)
+
+        if propertyCount > properties.count {
+            properties = properties.dropLast(properties.count - propertyCount)
+        }
+    }
 }
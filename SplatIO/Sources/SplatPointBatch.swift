@@ -0,0 +1,208 @@
+import Foundation
+import simd
+
+/// Columnar (structure-of-arrays) storage for splat scene points.
+///
+/// Every attribute lives in one contiguous array and all higher-order spherical harmonic coefficients share a
+/// single flat block, so a batch of N points costs a fixed handful of allocations instead of one
+/// `[SIMD3<Float>]` per point. Attributes are stored in their PLY-native encodings:
+/// - `colors`: the DC (degree 0) spherical harmonic coefficient
+/// - `sphericalHarmonics`: `shCoefficientsPerPoint` higher-order coefficients per point, in file order
+/// - `opacities`: logit opacity
+/// - `scales`: log scale
+public struct SplatPointBatch: Sendable {
+    /// Higher-order spherical harmonic coefficients stored per point (3, 8 and 15 for full degrees 1...3;
+    /// partial counts from truncated files are preserved as-is)
+    public private(set) var shCoefficientsPerPoint: Int
+
+    public internal(set) var positions: [SIMD3<Float>] = []
+    public internal(set) var colors: [SIMD3<Float>] = []
+    public internal(set) var sphericalHarmonics: [SIMD3<Float>] = []
+    public internal(set) var opacities: [Float] = []
+    public internal(set) var scales: [SIMD3<Float>] = []
+    public internal(set) var rotations: [simd_quatf] = []
+
+    public init(shCoefficientsPerPoint: Int, reservingCapacity capacity: Int = 0) {
+        self.shCoefficientsPerPoint = max(shCoefficientsPerPoint, 0)
+        reserveCapacity(capacity)
+    }
+
+    public init(shDegree: Int = 0, reservingCapacity capacity: Int = 0) {
+        self.init(shCoefficientsPerPoint: Self.coefficientsPerPoint(forDegree: shDegree.clamped(to: 0...3)),
+                  reservingCapacity: capacity)
+    }
+
+    /// Converts an array of points; the batch keeps as many coefficients as the richest point carries.
+    public init(_ points: [SplatScenePoint]) {
+        var coefficients = 0
+        for point in points {
+            if case let .sphericalHarmonic(values) = point.color {
+                coefficients = max(coefficients, values.count - 1)
+            }
+        }
+        self.init(shCoefficientsPerPoint: coefficients, reservingCapacity: points.count)
+        for point in points {
+            append(point)
+        }
+    }
+
+    // MARK: - Size
+
+    public var count: Int { positions.count }
+
+    public var isEmpty: Bool { positions.isEmpty }
+
+    /// Highest complete spherical harmonic degree in the batch (0...3)
+    public var shDegree: Int {
+        Self.degree(forCoefficientCount: shCoefficientsPerPoint + 1)
+    }
+
+    public static func coefficientsPerPoint(forDegree degree: Int) -> Int {
+        (degree + 1) * (degree + 1) - 1
+    }
+
+    /// Degree for a total (DC + higher-order) coefficient count; counts between full degrees round down.
+    public static func degree(forCoefficientCount count: Int) -> Int {
+        switch count {
+        case ..<4: 0
+        case 4..<9: 1
+        case 9..<16: 2
+        default: 3
+        }
+    }
+
+    public mutating func reserveCapacity(_ capacity: Int) {
+        guard capacity > 0 else { return }
+        positions.reserveCapacity(capacity)
+        colors.reserveCapacity(capacity)
+        sphericalHarmonics.reserveCapacity(capacity * shCoefficientsPerPoint)
+        opacities.reserveCapacity(capacity)
+        scales.reserveCapacity(capacity)
+        rotations.reserveCapacity(capacity)
+    }
+
+    public mutating func removeAll(keepingCapacity: Bool = false) {
+        positions.removeAll(keepingCapacity: keepingCapacity)
+        colors.removeAll(keepingCapacity: keepingCapacity)
+        sphericalHarmonics.removeAll(keepingCapacity: keepingCapacity)
+        opacities.removeAll(keepingCapacity: keepingCapacity)
+        scales.removeAll(keepingCapacity: keepingCapacity)
+        rotations.removeAll(keepingCapacity: keepingCapacity)
+    }
+
+    // MARK: - Appending
+
+    /// Appends a point, converting its attributes to the batch encodings.
+    /// Coefficients beyond `shCoefficientsPerPoint` are dropped; missing ones are zero-filled.
+    public mutating func append(_ point: SplatScenePoint) {
+        positions.append(point.position)
+        switch point.color {
+        case let .sphericalHarmonic(values):
+            colors.append(values.first ?? .zero)
+            let available = max(values.count - 1, 0)
+            for i in 0..<shCoefficientsPerPoint {
+                sphericalHarmonics.append(i < available ? values[i + 1] : .zero)
+            }
+        default:
+            colors.append(SplatScenePoint.Color.linearToPrimarySphericalHarmonic(point.color.asLinearFloat))
+            appendZeroSphericalHarmonics()
+        }
+        opacities.append(point.opacity.asLogitFloat)
+        scales.append(point.scale.asExponent)
+        rotations.append(point.rotation)
+    }
+
+    public mutating func append(contentsOf points: [SplatScenePoint]) {
+        reserveCapacity(count + points.count)
+        for point in points {
+            append(point)
+        }
+    }
+
+    /// Appends every point of another batch. Spherical harmonics are truncated or zero-filled when layouts differ.
+    public mutating func append(contentsOf other: SplatPointBatch) {
+        positions.append(contentsOf: other.positions)
+        colors.append(contentsOf: other.colors)
+        opacities.append(contentsOf: other.opacities)
+        scales.append(contentsOf: other.scales)
+        rotations.append(contentsOf: other.rotations)
+
+        if other.shCoefficientsPerPoint == shCoefficientsPerPoint {
+            sphericalHarmonics.append(contentsOf: other.sphericalHarmonics)
+        } else {
+            let stride = shCoefficientsPerPoint
+            let otherStride = other.shCoefficientsPerPoint
+            sphericalHarmonics.reserveCapacity(sphericalHarmonics.count + other.count * stride)
+            for index in 0..<other.count {
+                let base = index * otherStride
+                for i in 0..<stride {
+                    sphericalHarmonics.append(i < otherStride ? other.sphericalHarmonics[base + i] : .zero)
+                }
+            }
+        }
+    }
+
+    mutating func appendZeroSphericalHarmonics() {
+        for _ in 0..<shCoefficientsPerPoint {
+            sphericalHarmonics.append(.zero)
+        }
+    }
+
+    // MARK: - Access
+
+    /// Higher-order spherical harmonic coefficients of one point
+    public func sphericalHarmonics(at index: Int) -> ArraySlice<SIMD3<Float>> {
+        let stride = shCoefficientsPerPoint
+        return sphericalHarmonics[(index * stride)..<((index + 1) * stride)]
+    }
+
+    /// Display color in 0...1, equivalent to `SplatScenePoint.Color.asLinearFloat`
+    public func linearColor(at index: Int) -> SIMD3<Float> {
+        SplatScenePoint.Color.primarySphericalHarmonicToLinear(colors[index])
+    }
+
+    public func linearOpacity(at index: Int) -> Float {
+        SplatScenePoint.Opacity.sigmoid(opacities[index])
+    }
+
+    public func linearScale(at index: Int) -> SIMD3<Float> {
+        exp(scales[index])
+    }
+
+    /// Materializes one point. Allocates its spherical harmonic array, so prefer the columns on hot paths.
+    public subscript(index: Int) -> SplatScenePoint {
+        var sh = [SIMD3<Float>]()
+        sh.reserveCapacity(shCoefficientsPerPoint + 1)
+        sh.append(colors[index])
+        sh.append(contentsOf: sphericalHarmonics(at: index))
+        return SplatScenePoint(position: positions[index],
+                               color: .sphericalHarmonic(sh),
+                               opacity: .logitFloat(opacities[index]),
+                               scale: .exponent(scales[index]),
+                               rotation: rotations[index])
+    }
+
+    /// Materializes every point, for consumers that still take `[SplatScenePoint]`
+    public var points: [SplatScenePoint] {
+        (0..<count).map { self[$0] }
+    }
+
+    /// Returns a batch whose point `i` is this batch's point `indices[i]`
+    public func permuted(by indices: [Int]) -> SplatPointBatch {
+        var result = SplatPointBatch(shCoefficientsPerPoint: shCoefficientsPerPoint)
+        result.positions = indices.map { positions[$0] }
+        result.colors = indices.map { colors[$0] }
+        result.opacities = indices.map { opacities[$0] }
+        result.scales = indices.map { scales[$0] }
+        result.rotations = indices.map { rotations[$0] }
+
+        let stride = shCoefficientsPerPoint
+        if stride > 0 {
+            result.sphericalHarmonics.reserveCapacity(indices.count * stride)
+            for index in indices {
+                result.sphericalHarmonics.append(contentsOf: sphericalHarmonics[(index * stride)..<((index + 1) * stride)])
+            }
+        }
+        return result
+    }
+}
@@ -135,32 +135,44 @@ public class SplatSOGSSceneReader: SplatSceneReader, @unchecked Sendable {
             throw SOGSError.missingRequiredTextureFile("sh0", 1, metadata.sh0.files.count)
         }
 
-        // Load means textures
-        let means_l = try loadAndDecodeWebP(metadata.means.files[0])
-        let means_u = try loadAndDecodeWebP(metadata.means.files[1])
+        // Decode every texture of the bundle concurrently
+        var filenames = [metadata.means.files[0], metadata.means.files[1],
+                         metadata.quats.files[0], metadata.scales.files[0], metadata.sh0.files[0]]
+        if let shN = metadata.shN, shN.files.count >= 2 {
+            filenames.append(contentsOf: shN.files[0...1])
+        }
 
-        // Load other required textures
-        let quats = try loadAndDecodeWebP(metadata.quats.files[0])
-        let scales = try loadAndDecodeWebP(metadata.scales.files[0])
-        let sh0 = try loadAndDecodeWebP(metadata.sh0.files[0])
-        
-        // Load optional spherical harmonics textures
+        let decoded = LockedBox<[Int: WebPDecoder.DecodedImage]>([:])
+        let firstError = LockedBox<Error?>(nil)
+        DispatchQueue.concurrentPerform(iterations: filenames.count) { index in
+            guard firstError.get() == nil else { return }
+            do {
+                let image = try loadAndDecodeWebP(filenames[index])
+                decoded.withValue { $0[index] = image }
+            } catch {
+                firstError.withValue { if $0 == nil { $0 = error } }
+            }
+        }
+        if let error = firstError.get() {
+            throw error
+        }
+        let images = decoded.get()
+        guard let means_l = images[0], let means_u = images[1],
+              let quats = images[2], let scales = images[3], let sh0 = images[4] else {
+            throw SOGSError.webpDecodingFailed("Missing decoded texture")
+        }
+
+        // Only keep SH data if the centroids texture width maps to SH bands > 0
         var sh_centroids: WebPDecoder.DecodedImage?
         var sh_labels: WebPDecoder.DecodedImage?
-        
-        // Only load SH data if we have SH bands > 0
-        // Calculate potential SH bands based on texture width
-        if let shN = metadata.shN, shN.files.count >= 2 {
-            // First load the centroids to determine SH bands
-            let tempCentroids = try loadAndDecodeWebP(shN.files[0])
-            let shBands = calculateSHBands(width: tempCentroids.width)
-            
+        if let centroids = images[5], let labels = images[6] {
+            let shBands = calculateSHBands(width: centroids.width)
             if shBands > 0 {
-                sh_centroids = tempCentroids
-                sh_labels = try loadAndDecodeWebP(shN.files[1])
+                sh_centroids = centroids
+                sh_labels = labels
                 print("SplatSOGSSceneReader: Loaded SH data with \(shBands) bands")
             } else {
-                print("SplatSOGSSceneReader: Skipping SH data loading - no valid bands detected")
+                print("SplatSOGSSceneReader: Skipping SH data - no valid bands detected")
             }
         }
         
@@ -265,8 +277,17 @@ public class SplatSOGSSceneReader: SplatSceneReader, @unchecked Sendable {
             }
         }
         
+        // libwebp first: no Core Image context or color management
+        do {
+            let result = try WebPDecoder.decodeNative(webpData)
+            print("SplatSOGSSceneReader: Successfully decoded \(filename) using libwebp - \(result.width)x\(result.height)")
+            return result
+        } catch {
+            print("SplatSOGSSceneReader: libwebp decode failed for \(filename): \(error)")
+        }
+
         do {
-            // Try Core Image first (iOS 14+/macOS 11+)
+            // Fall back to Core Image (iOS 14+/macOS 11+)
             print("SplatSOGSSceneReader: Attempting Core Image decode...")
             let result = try WebPDecoder.decode(webpData)
             print("SplatSOGSSceneReader: Successfully decoded \(filename) using Core Image - \(result.width)x\(result.height), \(result.bytesPerPixel) bpp")
@@ -307,6 +307,9 @@ public class SplatSOGSSceneReaderOptimized: SplatSceneReader, @unchecked Sendabl
         // This is just a placeholder - the actual implementation should be copied
         let fileURL = baseURL.appendingPathComponent(filename)
         let webpData = try Data(contentsOf: fileURL)
+        if let image = try? WebPDecoder.decodeNative(webpData) {
+            return image
+        }
         return try WebPDecoder.decode(webpData)
     }
     
@@ -70,6 +70,13 @@ public class SplatSOGSSceneReaderV2: SplatSceneReader, @unchecked Sendable {
     }
     
     public func readScene() throws -> [SplatScenePoint] {
+        // Decompress and convert to SplatScenePoint format
+        return try decompressDataV2(readCompressedData())
+    }
+
+    /// Parses the metadata and decodes every texture, without dequantizing any splat.
+    /// For consumers that dequantize themselves, such as a GPU decode.
+    public func readCompressedData() throws -> SOGSCompressedDataV2 {
         traceSOGSV2("Loading SOGS v2 metadata")
         
         // Load metadata from either zip archive or standalone file
@@ -109,9 +116,7 @@ public class SplatSOGSSceneReaderV2: SplatSceneReader, @unchecked Sendable {
         // Load and decode all WebP textures
         let compressedData = try loadCompressedDataV2(metadata: metadata)
         traceSOGSV2("Successfully loaded all v2 WebP textures")
-        
-        // Decompress and convert to SplatScenePoint format
-        return try decompressDataV2(compressedData)
+        return compressedData
     }
     
     public func read(to delegate: SplatSceneReaderDelegate) {
@@ -379,9 +384,16 @@ public class SplatSOGSSceneReaderV2: SplatSceneReader, @unchecked Sendable {
             traceSOGSV2("WebP signature: \(webpSignature.map { String(format: "%02X", $0) }.joined())")
         }
         
-        // Decode WebP data
+        // Decode WebP data with libwebp directly; Core Image and ImageIO remain as fallbacks
+        do {
+            let result = try WebPDecoder.decodeNative(webpData)
+            traceSOGSV2("Decoded \(filename) with libwebp - \(result.width)x\(result.height)")
+            return result
+        } catch {
+            traceSOGSV2("libwebp decode failed for \(filename): \(error.localizedDescription)")
+        }
+
         do {
-            // Try Core Image first (iOS 14+/macOS 11+)
             let result = try WebPDecoder.decode(webpData)
             traceSOGSV2("Successfully decoded \(filename) - \(result.width)x\(result.height), \(result.bytesPerPixel) bpp")
             return result
@@ -12,13 +12,13 @@ public struct SplatScenePoint: Sendable {
         case linearFloat256(SIMD3<Float>)
         case linearUInt8(SIMD3<UInt8>)
 
-        private static func primarySphericalHarmonicToLinear(_ sh0: SIMD3<Float>) -> SIMD3<Float> {
+        static func primarySphericalHarmonicToLinear(_ sh0: SIMD3<Float>) -> SIMD3<Float> {
             SIMD3(x: (0.5 + Self.SH_C0 * sh0.x).clamped(to: 0...1),
                   y: (0.5 + Self.SH_C0 * sh0.y).clamped(to: 0...1),
                   z: (0.5 + Self.SH_C0 * sh0.z).clamped(to: 0...1))
         }
 
-        private static func linearToPrimarySphericalHarmonic(_ values: SIMD3<Float>) -> SIMD3<Float> {
+        static func linearToPrimarySphericalHarmonic(_ values: SIMD3<Float>) -> SIMD3<Float> {
             (values - 0.5) * Self.INV_SH_C0
         }
 
@@ -3,14 +3,26 @@ import Foundation
 public protocol SplatSceneReaderDelegate: AnyObject {
     func didStartReading(withPointCount pointCount: UInt32?)
     func didRead(points: [SplatScenePoint])
+    /// Columnar variant of `didRead(points:)`. Readers that decode into `SplatPointBatch` call this instead;
+    /// the default implementation materializes the points and forwards them to `didRead(points:)`.
+    func didRead(batch: SplatPointBatch)
     func didFinishReading()
     func didFailReading(withError error: Error?)
 }
 
+extension SplatSceneReaderDelegate {
+    public func didRead(batch: SplatPointBatch) {
+        didRead(points: batch.points)
+    }
+}
+
 public protocol SplatSceneReader {
     /// Read a scene directly into an array of points
     func readScene() throws -> [SplatScenePoint]
-    
+
+    /// Read a scene into columnar storage, avoiding per-point allocations where the reader supports it
+    func readBatch() throws -> SplatPointBatch
+
     /// For backward compatibility - implementations can be added via extension
     func read(to delegate: SplatSceneReaderDelegate)
 }
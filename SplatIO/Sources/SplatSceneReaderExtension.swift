@@ -30,6 +30,19 @@ extension SplatSceneReader {
         return collector.points
     }
 
+    public func readBatch() throws -> SplatPointBatch {
+        let collector = BatchCollector()
+        read(to: collector)
+
+        try collector.waitForCompletion(timeout: 300.0)
+
+        if let error = collector.error {
+            throw error
+        }
+
+        return collector.result
+    }
+
     /// Reads the scene and reorders points using Morton code ordering for improved GPU cache coherency.
     ///
     /// Morton ordering clusters spatially nearby 3D points together in memory, which can significantly
@@ -90,3 +103,58 @@ private class PointCollector: SplatSceneReaderDelegate {
         }
     }
 }
+
+/// Helper class to collect a columnar batch from a delegate-based reader.
+/// Readers that emit `didRead(batch:)` are appended column-wise without materializing points.
+private class BatchCollector: SplatSceneReaderDelegate {
+    var batch: SplatPointBatch?
+    var error: Error?
+    private var expectedPointCount = 0
+    private let semaphore = DispatchSemaphore(value: 0)
+    private var completed = false
+
+    var result: SplatPointBatch {
+        batch ?? SplatPointBatch()
+    }
+
+    func didStartReading(withPointCount pointCount: UInt32?) {
+        expectedPointCount = Int(pointCount ?? 0)
+    }
+
+    func didRead(points: [SplatScenePoint]) {
+        guard !points.isEmpty else { return }
+        didRead(batch: SplatPointBatch(points))
+    }
+
+    func didRead(batch newBatch: SplatPointBatch) {
+        if batch == nil {
+            // The first batch fixes the SH layout of the result
+            var initial = SplatPointBatch(shCoefficientsPerPoint: newBatch.shCoefficientsPerPoint,
+                                          reservingCapacity: expectedPointCount)
+            initial.append(contentsOf: newBatch)
+            batch = initial
+        } else {
+            batch?.append(contentsOf: newBatch)
+        }
+    }
+
+    func didFinishReading() {
+        completed = true
+        semaphore.signal()
+    }
+
+    func didFailReading(withError error: Error?) {
+        self.error = error
+        completed = true
+        semaphore.signal()
+    }
+
+    func waitForCompletion(timeout: TimeInterval) throws {
+        if completed { return }
+
+        let result = semaphore.wait(timeout: .now() + timeout)
+        if result == .timedOut {
+            throw SplatSceneReaderError.timeout
+        }
+    }
+}
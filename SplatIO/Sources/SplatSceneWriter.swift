@@ -2,5 +2,47 @@ import Foundation
 
 public protocol SplatSceneWriter {
     func write(_ points: [SplatScenePoint]) throws
+    /// Writes a columnar batch. The default implementation materializes the points and calls `write(_:)`.
+    func write(_ batch: SplatPointBatch) throws
+    func close() throws
+}
+
+extension SplatSceneWriter {
+    public func write(_ batch: SplatPointBatch) throws {
+        try write(batch.points)
+    }
+}
+
+/// Points already encoded into a writer's output representation
+public struct SplatEncodedChunk: Sendable {
+    public let data: Data
+    public let pointCount: Int
+
+    public init(data: Data, pointCount: Int) {
+        self.data = data
+        self.pointCount = pointCount
+    }
+}
+
+/// A writer whose per-batch encoding is independent of its output, so `SplatStreamingConverter` can encode
+/// batches concurrently and append them in input order.
+public protocol SplatChunkEncodingWriter: SplatSceneWriter, AnyObject {
+    /// Encodes points without writing them. Must be safe to call concurrently, including with `write(encoded:)`.
+    func encodeChunk(_ points: [SplatScenePoint]) throws -> SplatEncodedChunk
+    /// Appends a chunk from `encodeChunk(_:)`. Called serially, in input order.
+    func write(encoded chunk: SplatEncodedChunk) throws
+}
+
+/// A writer whose format depends on statistics of the whole scene (quantization ranges, codebooks, fixed-point
+/// precision). Rather than buffering the scene, it sees the input twice: once to accumulate statistics, then
+/// again, in the same order, to encode.
+public protocol SplatTwoPassSceneWriter: AnyObject {
+    /// First pass: called with every batch, in order
+    func accumulateStatistics(_ points: [SplatScenePoint]) throws
+    /// Called once between the passes
+    func beginSecondPass() throws
+    /// Second pass: called with the same batches as the first pass, in the same order
+    func writeSecondPass(_ points: [SplatScenePoint]) throws
+    /// Finishes the output once the second pass is complete
     func close() throws
 }
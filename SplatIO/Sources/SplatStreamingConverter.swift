@@ -0,0 +1,330 @@
+import Foundation
+
+/// Converts a scene without holding it in memory.
+///
+/// Chunk-encoding writers (PLY, .splat) run as a pipeline: the reader feeds a bounded queue, `workerCount` workers
+/// encode batches concurrently, and an ordered writer appends them in input order. Reading blocks while
+/// `maxInFlightBatches` batches are queued, encoding or waiting to be written, which bounds memory.
+///
+/// Writers whose format depends on whole-scene statistics (SOG, SPZ) instead stream the input twice: once to
+/// accumulate statistics, then again to encode.
+public final class SplatStreamingConverter {
+    public enum Error: Swift.Error {
+        case unknownReadError
+        case pointCountMismatch(expected: Int, actual: Int)
+    }
+
+    public struct Options: Sendable {
+        /// Index of the first input splat to convert
+        public var start: Int
+        /// Maximum number of splats to convert, or nil for all remaining
+        public var count: Int?
+        /// Concurrent encode workers
+        public var workerCount: Int
+        /// Batches that may be read but not yet written
+        public var maxInFlightBatches: Int
+
+        public init(start: Int = 0,
+                    count: Int? = nil,
+                    workerCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+                    maxInFlightBatches: Int? = nil) {
+            self.start = start
+            self.count = count
+            self.workerCount = max(workerCount, 1)
+            self.maxInFlightBatches = max(maxInFlightBatches ?? self.workerCount * 2, 1)
+        }
+    }
+
+    public struct Statistics: Sendable {
+        /// Splats written
+        public var pointCount: Int
+        /// Times the input was read
+        public var passCount: Int
+        public var duration: Duration
+
+        /// Written splats per second, over every pass
+        public var pointsPerSecond: Double {
+            let seconds = Double(duration.components.seconds) + Double(duration.components.attoseconds) * 1e-18
+            return Double(pointCount) / max(seconds, 1e-6)
+        }
+    }
+
+    public let options: Options
+
+    public init(options: Options = Options()) {
+        self.options = options
+    }
+
+    /// Pipelined conversion. The writer is created once the reader reports its point count; inputs that
+    /// don't report one are counted first, then read again.
+    /// - Parameters:
+    ///   - makeReader: Opens the input; called a second time only if the first read reports no point count
+    ///   - makeWriter: Creates the writer for the given number of output points
+    public func convert(makeReader: () throws -> any SplatSceneReader,
+                        makeWriter: (_ pointCount: Int) throws -> any SplatChunkEncodingWriter) throws -> Statistics {
+        let clock = ContinuousClock()
+        let startInstant = clock.now
+        let window = window
+        let options = options
+
+        return try withoutActuallyEscaping(makeWriter) { makeWriter in
+            var writer: (any SplatChunkEncodingWriter)?
+            var pipeline: EncodePipeline?
+            var expectedCount = 0
+
+            func start(outputCount: Int, reader: WindowedReader) throws {
+                let newWriter = try makeWriter(outputCount)
+                let newPipeline = EncodePipeline(writer: newWriter, options: options)
+                writer = newWriter
+                pipeline = newPipeline
+                expectedCount = outputCount
+                reader.consume = { newPipeline.enqueue($0) }
+            }
+
+            defer { try? writer?.close() }
+
+            let firstPass = WindowedReader(window: window)
+            firstPass.onStart = { [unowned firstPass] reportedCount in
+                // Without a reported count, this pass only counts the input
+                guard let reportedCount else { return }
+                try start(outputCount: window.outputCount(forInputCount: reportedCount), reader: firstPass)
+            }
+            var passCount = 1
+            do {
+                defer { firstPass.onStart = nil }
+                try firstPass.read(from: makeReader())
+
+                if pipeline == nil {
+                    let secondPass = WindowedReader(window: window)
+                    try start(outputCount: window.outputCount(forInputCount: firstPass.inputPointCount), reader: secondPass)
+                    try secondPass.read(from: makeReader())
+                    passCount += 1
+                }
+            } catch {
+                // Let in-flight batches drain before the writer is closed
+                _ = try? pipeline?.finish()
+                throw error
+            }
+
+            guard let writer, let pipeline else {
+                throw Error.unknownReadError
+            }
+
+            let written = try pipeline.finish()
+            guard written == expectedCount else {
+                throw Error.pointCountMismatch(expected: expectedCount, actual: written)
+            }
+            try writer.close()
+            return Statistics(pointCount: written, passCount: passCount, duration: clock.now - startInstant)
+        }
+    }
+
+    /// Two-pass conversion: statistics, then encoding, each streamed from a fresh reader
+    public func convert(makeReader: () throws -> any SplatSceneReader,
+                        to writer: any SplatTwoPassSceneWriter) throws -> Statistics {
+        let clock = ContinuousClock()
+        let startInstant = clock.now
+
+        let firstPass = WindowedReader(window: window)
+        firstPass.consume = { points in
+            try writer.accumulateStatistics(points)
+        }
+        try firstPass.read(from: makeReader())
+
+        try writer.beginSecondPass()
+        let secondPass = WindowedReader(window: window)
+        secondPass.consume = { points in
+            try writer.writeSecondPass(points)
+        }
+        try secondPass.read(from: makeReader())
+
+        guard secondPass.outputPointCount == firstPass.outputPointCount else {
+            throw Error.pointCountMismatch(expected: firstPass.outputPointCount, actual: secondPass.outputPointCount)
+        }
+        try writer.close()
+        return Statistics(pointCount: secondPass.outputPointCount, passCount: 2, duration: clock.now - startInstant)
+    }
+
+    private var window: PointWindow {
+        PointWindow(start: max(options.start, 0), count: options.count)
+    }
+}
+
+// MARK: - Windowing
+
+/// The [start, start + count) range of input points to convert
+struct PointWindow: Sendable {
+    let start: Int
+    let count: Int?
+
+    func outputCount(forInputCount inputCount: Int) -> Int {
+        let remaining = max(inputCount - start, 0)
+        return count.map { min(remaining, max($0, 0)) } ?? remaining
+    }
+}
+
+/// Reads a scene, trimming batches to a PointWindow and handing them on as they arrive
+final class WindowedReader: SplatSceneReaderDelegate {
+    private let window: PointWindow
+    private var error: Swift.Error?
+    private var failed = false
+
+    /// Called with the reader's reported input point count, before any batch
+    var onStart: ((Int?) throws -> Void)?
+    /// Receives each trimmed batch; while nil, batches are only counted
+    var consume: (([SplatScenePoint]) throws -> Void)?
+
+    private(set) var inputPointCount = 0
+    private(set) var outputPointCount = 0
+
+    init(window: PointWindow) {
+        self.window = window
+    }
+
+    func read(from reader: any SplatSceneReader) throws {
+        reader.read(to: self)
+        if failed {
+            throw error ?? SplatStreamingConverter.Error.unknownReadError
+        }
+    }
+
+    func didStartReading(withPointCount pointCount: UInt32?) {
+        do {
+            try onStart?(pointCount.map { Int($0) })
+        } catch {
+            fail(with: error)
+        }
+    }
+
+    func didRead(points: [SplatScenePoint]) {
+        let batchStart = inputPointCount
+        inputPointCount += points.count
+        guard !failed else { return }
+
+        let windowEnd = window.count.map { window.start + max($0, 0) } ?? Int.max
+        let lower = max(window.start, batchStart) - batchStart
+        let upper = min(windowEnd, inputPointCount) - batchStart
+        guard lower < upper else { return }
+        outputPointCount += upper - lower
+
+        guard let consume else { return }
+        // Only the batches straddling the window's ends are copied
+        let trimmed = (lower == 0 && upper == points.count) ? points : Array(points[lower..<upper])
+        do {
+            try consume(trimmed)
+        } catch {
+            fail(with: error)
+        }
+    }
+
+    func didFinishReading() {}
+
+    func didFailReading(withError error: Swift.Error?) {
+        fail(with: error ?? SplatStreamingConverter.Error.unknownReadError)
+    }
+
+    private func fail(with error: Swift.Error) {
+        if !failed {
+            self.error = error
+        }
+        failed = true
+    }
+}
+
+// MARK: - Encode Pipeline
+
+/// Bounded reader → parallel encode → ordered write pipeline.
+/// `@unchecked Sendable`: the writer is only written to under `lock`, and `SplatChunkEncodingWriter` requires
+/// `encodeChunk` to be safe to call concurrently.
+private final class EncodePipeline: @unchecked Sendable {
+    private let writer: any SplatChunkEncodingWriter
+    private let encodeQueue = OperationQueue()
+    private let inFlight: DispatchSemaphore
+
+    private let lock = NSLock()
+    private var nextSequence = 0
+    private var nextSequenceToWrite = 0
+    private var pending: [Int: SplatEncodedChunk] = [:]
+    private var pointsWritten = 0
+    private var error: Swift.Error?
+
+    init(writer: any SplatChunkEncodingWriter, options: SplatStreamingConverter.Options) {
+        self.writer = writer
+        inFlight = DispatchSemaphore(value: options.maxInFlightBatches)
+        encodeQueue.name = "SplatStreamingConverter.encode"
+        encodeQueue.maxConcurrentOperationCount = options.workerCount
+    }
+
+    /// Called on the reading thread; blocks while the pipeline is full
+    func enqueue(_ points: [SplatScenePoint]) {
+        inFlight.wait()
+        let sequence = nextSequence
+        nextSequence += 1
+
+        encodeQueue.addOperation { [self] in
+            if hasFailed {
+                complete(sequence: sequence, with: .failure(CancellationError()))
+                return
+            }
+            complete(sequence: sequence, with: Result { try writer.encodeChunk(points) })
+        }
+    }
+
+    /// Waits for every batch to be written. Returns the number of points written.
+    func finish() throws -> Int {
+        encodeQueue.waitUntilAllOperationsAreFinished()
+        lock.lock()
+        defer { lock.unlock() }
+        if let error {
+            throw error
+        }
+        return pointsWritten
+    }
+
+    private var hasFailed: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return error != nil
+    }
+
+    /// Writes every chunk that is next in order. On failure, releases the slots of all pending chunks so the
+    /// reader never blocks on chunks that will not be written.
+    private func complete(sequence: Int, with result: Result<SplatEncodedChunk, Swift.Error>) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        if error != nil {
+            inFlight.signal()
+            return
+        }
+
+        switch result {
+        case .failure(let failure):
+            fail(with: failure, releasing: 1)
+            return
+        case .success(let chunk):
+            pending[sequence] = chunk
+        }
+
+        while let chunk = pending.removeValue(forKey: nextSequenceToWrite) {
+            do {
+                try writer.write(encoded: chunk)
+            } catch {
+                fail(with: error, releasing: 1)
+                return
+            }
+            pointsWritten += chunk.pointCount
+            nextSequenceToWrite += 1
+            inFlight.signal()
+        }
+    }
+
+    private func fail(with failure: Swift.Error, releasing count: Int) {
+        error = failure
+        let released = count + pending.count
+        pending.removeAll()
+        for _ in 0..<released {
+            inFlight.signal()
+        }
+    }
+}
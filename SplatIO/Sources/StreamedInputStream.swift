@@ -0,0 +1,162 @@
+import Foundation
+
+/// An `InputStream` fed by a producer while a reader consumes it, so the synchronous stream-based readers can parse
+/// a body that is still downloading.
+///
+/// `read(_:maxLength:)` blocks until bytes arrive or the producer calls `finish`; it should run on its own thread,
+/// not in the Swift concurrency pool. Appending never blocks: chunks queue until the reader takes them, and
+/// `didConsume` reports each read's byte count so the producer can pause while too many are queued.
+final class StreamedInputStream: InputStream, @unchecked Sendable {
+    private let condition = NSCondition()
+    private let didConsume: @Sendable (Int) -> Void
+    /// Queued chunks; those before `headIndex` have been read and are dropped in batches
+    private var chunks: [Data] = []
+    private var headIndex = 0
+    private var headOffset = 0
+    private var finished = false
+    private var failure: Swift.Error?
+    private var status: Stream.Status = .notOpen
+
+    /// `didConsume` is called, outside the stream's lock, with the bytes each read takes from the queue
+    init(didConsume: @escaping @Sendable (Int) -> Void = { _ in }) {
+        self.didConsume = didConsume
+        super.init(data: Data())
+    }
+
+    private var isQueueEmpty: Bool {
+        headIndex == chunks.count
+    }
+
+    /// Queues `data` for the reader; returns false once the reader has closed the stream, so the producer can stop
+    @discardableResult
+    func append(_ data: Data) -> Bool {
+        condition.lock()
+        defer { condition.unlock() }
+        guard status != .closed, !finished else { return false }
+        if !data.isEmpty {
+            chunks.append(data)
+            condition.signal()
+        }
+        return true
+    }
+
+    /// Ends the stream: the reader sees end-of-stream once the queue drains, or an error straight away
+    func finish(error: Swift.Error? = nil) {
+        condition.lock()
+        finished = true
+        failure = error
+        condition.broadcast()
+        condition.unlock()
+    }
+
+    override func open() {
+        condition.lock()
+        if status == .notOpen {
+            status = .open
+        }
+        condition.unlock()
+    }
+
+    /// Drops whatever is still queued, reporting it through `didConsume` so a paused producer resumes and stops
+    override func close() {
+        condition.lock()
+        status = .closed
+        let dropped = chunks[headIndex...].reduce(0) { $0 + $1.count } - headOffset
+        chunks.removeAll()
+        headIndex = 0
+        headOffset = 0
+        condition.broadcast()
+        condition.unlock()
+        if dropped > 0 {
+            didConsume(dropped)
+        }
+    }
+
+    override var streamStatus: Stream.Status {
+        condition.lock()
+        defer { condition.unlock() }
+        return status
+    }
+
+    override var streamError: Swift.Error? {
+        condition.lock()
+        defer { condition.unlock() }
+        return failure
+    }
+
+    override var hasBytesAvailable: Bool {
+        condition.lock()
+        defer { condition.unlock() }
+        return !isQueueEmpty || !finished
+    }
+
+    override func read(_ buffer: UnsafeMutablePointer<UInt8>, maxLength len: Int) -> Int {
+        let copied = dequeue(into: buffer, maxLength: len)
+        if copied > 0 {
+            didConsume(copied)
+        }
+        return copied
+    }
+
+    private func dequeue(into buffer: UnsafeMutablePointer<UInt8>, maxLength len: Int) -> Int {
+        condition.lock()
+        defer { condition.unlock() }
+        while isQueueEmpty && !finished && status != .closed {
+            condition.wait()
+        }
+        if failure != nil {
+            status = .error
+            return -1
+        }
+        guard !isQueueEmpty else {
+            if status != .closed {
+                status = .atEnd
+            }
+            return 0
+        }
+
+        var copied = 0
+        while copied < len, !isQueueEmpty {
+            let chunk = chunks[headIndex]
+            let count = min(len - copied, chunk.count - headOffset)
+            chunk.withUnsafeBytes { bytes in
+                let start = bytes.baseAddress!.advanced(by: headOffset).assumingMemoryBound(to: UInt8.self)
+                (buffer + copied).update(from: start, count: count)
+            }
+            copied += count
+            headOffset += count
+            if headOffset == chunk.count {
+                chunks[headIndex] = Data()
+                headIndex += 1
+                headOffset = 0
+            }
+        }
+        // Drop read chunks once they're at least half the array, so dequeuing stays amortized O(1)
+        if headIndex == chunks.count {
+            chunks.removeAll(keepingCapacity: true)
+            headIndex = 0
+        } else if headIndex * 2 >= chunks.count {
+            chunks.removeFirst(headIndex)
+            headIndex = 0
+        }
+        return copied
+    }
+
+    override func getBuffer(_ buffer: UnsafeMutablePointer<UnsafeMutablePointer<UInt8>?>,
+                            length len: UnsafeMutablePointer<Int>) -> Bool {
+        false
+    }
+
+    override var delegate: StreamDelegate? {
+        get { nil }
+        set {}
+    }
+
+    override func property(forKey key: Stream.PropertyKey) -> Any? { nil }
+
+    override func setProperty(_ property: Any?, forKey key: Stream.PropertyKey) -> Bool { false }
+
+    override func schedule(in aRunLoop: RunLoop, forMode mode: RunLoop.Mode) {}
+
+    override func remove(from aRunLoop: RunLoop, forMode mode: RunLoop.Mode) {}
+}
@@ -0,0 +1,82 @@
+import Foundation
+
+/// Thread-safe pool of scratch memory for WebP decodes.
+///
+/// Buffers handed out by `checkout` come back through `recycle` (for `WebPDecoder.decodeNative`, when the decoded
+/// pixel data is released), so reopening a scene or decoding a bundle's same-sized textures reuses memory
+/// instead of allocating and zero-filling it again. At most `maxRetainedBytes` of idle buffers are kept.
+public final class WebPDecodeBufferPool: @unchecked Sendable {
+    public static let shared = WebPDecodeBufferPool()
+
+    public let maxRetainedBytes: Int
+
+    private let lock = NSLock()
+    private var idleBuffers: [(pointer: UnsafeMutableRawPointer, capacity: Int)] = []
+    private var idleByteCount = 0
+
+    public init(maxRetainedBytes: Int = 128 * 1024 * 1024) {
+        self.maxRetainedBytes = maxRetainedBytes
+    }
+
+    deinit {
+        for buffer in idleBuffers {
+            buffer.pointer.deallocate()
+        }
+    }
+
+    /// Bytes currently held by idle buffers
+    public var retainedByteCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return idleByteCount
+    }
+
+    /// Releases every idle buffer
+    public func removeAll() {
+        lock.lock()
+        let buffers = idleBuffers
+        idleBuffers.removeAll()
+        idleByteCount = 0
+        lock.unlock()
+
+        for buffer in buffers {
+            buffer.pointer.deallocate()
+        }
+    }
+
+    /// A buffer of at least `byteCount` bytes. Reuses the smallest idle buffer that fits without
+    /// wasting more than half of it; otherwise allocates.
+    func checkout(byteCount: Int) -> (pointer: UnsafeMutableRawPointer, capacity: Int) {
+        lock.lock()
+        var bestIndex: Int?
+        for (index, buffer) in idleBuffers.enumerated()
+        where buffer.capacity >= byteCount && buffer.capacity <= byteCount * 2 {
+            if bestIndex.map({ buffer.capacity < idleBuffers[$0].capacity }) ?? true {
+                bestIndex = index
+            }
+        }
+        if let bestIndex {
+            let buffer = idleBuffers.remove(at: bestIndex)
+            idleByteCount -= buffer.capacity
+            lock.unlock()
+            return buffer
+        }
+        lock.unlock()
+
+        let capacity = max(byteCount, 1)
+        return (UnsafeMutableRawPointer.allocate(byteCount: capacity, alignment: 16), capacity)
+    }
+
+    /// Returns a buffer from `checkout`. Freed instead if keeping it would exceed `maxRetainedBytes`.
+    func recycle(_ pointer: UnsafeMutableRawPointer, capacity: Int) {
+        lock.lock()
+        if idleByteCount + capacity <= maxRetainedBytes {
+            idleBuffers.append((pointer, capacity))
+            idleByteCount += capacity
+            lock.unlock()
+            return
+        }
+        lock.unlock()
+        pointer.deallocate()
+    }
+}
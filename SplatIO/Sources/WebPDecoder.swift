@@ -2,6 +2,7 @@ import Foundation
 import CoreImage
 import CoreGraphics
 import ImageIO
+import libwebp
 
 #if canImport(UIKit)
 import UIKit
@@ -32,14 +33,90 @@ public struct WebPDecoder {
         public let width: Int
         public let height: Int
         public let bytesPerPixel: Int
+        /// Whether color is premultiplied by alpha (Core Image / ImageIO decodes) or straight (libwebp decodes)
+        public let isPremultiplied: Bool
         
-        public init(pixels: Data, width: Int, height: Int, bytesPerPixel: Int) {
+        public init(pixels: Data, width: Int, height: Int, bytesPerPixel: Int, isPremultiplied: Bool = true) {
             self.pixels = pixels
             self.width = width
             self.height = height
             self.bytesPerPixel = bytesPerPixel
+            self.isPremultiplied = isPremultiplied
         }
     }
+
+    /// Image dimensions from the WebP header, without decoding
+    public static func dimensions(of webpData: Data) throws -> (width: Int, height: Int) {
+        var width: Int32 = 0
+        var height: Int32 = 0
+        let valid = webpData.withUnsafeBytes { raw -> Bool in
+            guard let base = raw.bindMemory(to: UInt8.self).baseAddress else { return false }
+            return WebPGetInfo(base, raw.count, &width, &height) != 0
+        }
+        guard valid else {
+            throw WebPError.invalidImageData
+        }
+        return (Int(width), Int(height))
+    }
+
+    /// Decodes with libwebp into caller-provided memory as tightly packed, straight-alpha RGBA8.
+    /// `destination` must hold at least width * height * 4 bytes; it can be reused across decodes.
+    @discardableResult
+    public static func decodeRGBA(_ webpData: Data, into destination: UnsafeMutableRawBufferPointer) throws -> (width: Int, height: Int) {
+        let (width, height) = try validatedDimensions(of: webpData)
+        let stride = width * 4
+        guard let output = destination.baseAddress, destination.count >= stride * height else {
+            throw WebPError.imageTooLarge
+        }
+
+        let decoded = webpData.withUnsafeBytes { raw -> Bool in
+            guard let base = raw.bindMemory(to: UInt8.self).baseAddress else { return false }
+            return WebPDecodeRGBAInto(base,
+                                      raw.count,
+                                      output.assumingMemoryBound(to: UInt8.self),
+                                      destination.count,
+                                      Int32(stride)) != nil
+        }
+        guard decoded else {
+            throw WebPError.decodingFailed
+        }
+        return (width, height)
+    }
+
+    /// Decodes with libwebp, skipping Core Image setup and color management. Pixels are straight-alpha RGBA8
+    /// in memory borrowed from `pool`, which gets it back once the image's pixel data is released.
+    public static func decodeNative(_ webpData: Data, pool: WebPDecodeBufferPool = .shared) throws -> DecodedImage {
+        let (width, height) = try validatedDimensions(of: webpData)
+        let byteCount = width * height * 4
+
+        let buffer = pool.checkout(byteCount: byteCount)
+        do {
+            try decodeRGBA(webpData, into: UnsafeMutableRawBufferPointer(start: buffer.pointer, count: byteCount))
+        } catch {
+            pool.recycle(buffer.pointer, capacity: buffer.capacity)
+            throw error
+        }
+
+        let capacity = buffer.capacity
+        let pixels = Data(bytesNoCopy: buffer.pointer, count: byteCount, deallocator: .custom { pointer, _ in
+            pool.recycle(pointer, capacity: capacity)
+        })
+        return DecodedImage(pixels: pixels, width: width, height: height, bytesPerPixel: 4, isPremultiplied: false)
+    }
+
+    private static func validatedDimensions(of webpData: Data) throws -> (width: Int, height: Int) {
+        let (width, height) = try dimensions(of: webpData)
+        guard width > 0 && height > 0 else {
+            throw WebPError.invalidImageData
+        }
+        guard width <= 16384 && height <= 16384 else {
+            throw WebPError.invalidImageData  // Reject unreasonably large images
+        }
+        guard width * height * 4 <= Self.maxDecodedBytes else {
+            throw WebPError.imageTooLarge
+        }
+        return (width, height)
+    }
     
     /// Decode WebP data to RGBA pixel data using Core Image
     /// This requires iOS 14+/macOS 11+ for WebP support
@@ -204,7 +281,7 @@ public struct WebPDecoder {
 
         // Un-premultiply alpha to get original color values
         // Since CGContext uses premultiplied alpha, we need to divide by alpha to get original colors
-        if a > 0 {
+        if image.isPremultiplied && a > 0 {
             let alpha = Float(a) / 255.0
             let unpremultipliedR = UInt8(min(255.0, Float(r) / alpha))
             let unpremultipliedG = UInt8(min(255.0, Float(g) / alpha))
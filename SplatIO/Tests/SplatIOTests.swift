@@ -713,6 +713,32 @@ final class SplatIOTests: XCTestCase {
         }
     }
 
+    func testGLBReaderDecodesLargePrimitivesInParallel() throws {
+        let points = (0..<20_000).map { index in
+            let t = Float(index)
+            return SplatScenePoint(
+                position: SIMD3<Float>(sin(t * 0.13) * 4, cos(t * 0.07) * 2, t * 0.001),
+                color: .sphericalHarmonic([SIMD3<Float>(0.1, 0.2, 0.3) * (t.truncatingRemainder(dividingBy: 7) / 7)]),
+                opacity: .linearFloat(0.25 + 0.5 * (t.truncatingRemainder(dividingBy: 11) / 11)),
+                scale: .exponent(SIMD3<Float>(-1, -0.5, -0.25)),
+                rotation: simd_quatf(angle: t * 0.01, axis: simd_normalize(SIMD3<Float>(1, 2, 3)))
+            )
+        }
+
+        let url = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathExtension("glb")
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        try GltfGaussianSplatSceneWriter(container: .glb).writeScene(points, to: url)
+        let roundTripped = try GltfGaussianSplatSceneReader(url).readScene()
+
+        XCTAssertEqual(roundTripped.count, points.count)
+        for index in Swift.stride(from: 0, to: points.count, by: 997) {
+            XCTAssertTrue(roundTripped[index] ~= points[index], "Point \(index)")
+        }
+    }
+
     func testGLTFWriterRoundTripsSphericalHarmonics() throws {
         let points = [
             SplatScenePoint(
@@ -1280,6 +1306,47 @@ final class SplatIOTests: XCTestCase {
         )
     }
 
+    func testNativeWebPDecodeRoundTripsStraightAlphaAndReusesBuffers() throws {
+        let width = 7
+        let height = 5
+        var rgba = Data(count: width * height * 4)
+        for i in 0..<(width * height) {
+            rgba[i * 4 + 0] = UInt8(truncatingIfNeeded: i * 37)
+            rgba[i * 4 + 1] = UInt8(truncatingIfNeeded: i * 11 + 3)
+            rgba[i * 4 + 2] = UInt8(truncatingIfNeeded: 255 - i * 5)
+            rgba[i * 4 + 3] = UInt8(truncatingIfNeeded: 64 + i)
+        }
+        let webp = try WebPEncoder.encodeLosslessRGBA(rgba, width: width, height: height)
+
+        let dimensions = try WebPDecoder.dimensions(of: webp)
+        XCTAssertEqual(dimensions.width, width)
+        XCTAssertEqual(dimensions.height, height)
+
+        let pool = WebPDecodeBufferPool()
+        do {
+            let image = try WebPDecoder.decodeNative(webp, pool: pool)
+            XCTAssertEqual(image.width, width)
+            XCTAssertEqual(image.height, height)
+            XCTAssertFalse(image.isPremultiplied)
+            XCTAssertEqual(image.pixels, rgba, "Lossless decode should return the exact straight-alpha input")
+
+            let pixel = WebPDecoder.getPixelUInt8(from: image, x: 3, y: 2)
+            let offset = (2 * width + 3) * 4
+            XCTAssertEqual(pixel.x, rgba[offset])
+            XCTAssertEqual(pixel.w, rgba[offset + 3])
+            // The image may otherwise be released after its last use above, handing its buffer back early
+            withExtendedLifetime(image) {
+                XCTAssertEqual(pool.retainedByteCount, 0, "Live pixels shouldn't be counted as idle")
+            }
+        }
+        XCTAssertEqual(pool.retainedByteCount, width * height * 4, "Released pixels should return to the pool")
+
+        _ = try WebPDecoder.decodeNative(webp, pool: pool)
+        XCTAssertEqual(pool.retainedByteCount, width * height * 4, "A same-sized decode should reuse the idle buffer")
+
+        XCTAssertThrowsError(try WebPDecoder.decodeNative(Data([0x52, 0x49, 0x46, 0x46]), pool: pool))
+    }
+
     // MARK: - Morton Order Tests
 
     func testMortonCodeEncoding() {
@@ -1583,6 +1650,381 @@ final class SplatIOTests: XCTestCase {
         )
     }
 
+    // MARK: - Columnar Batch Tests
+
+    func testReadBatchMatchesReadScene() throws {
+        let points = try SplatPLYSceneReader(plyURL).readScene()
+        let batch = try SplatPLYSceneReader(plyURL).readBatch()
+
+        XCTAssertEqual(batch.count, points.count)
+        for (index, point) in points.enumerated() {
+            XCTAssertTrue(batch[index] ~= point)
+            XCTAssertEqual(batch.sphericalHarmonics(at: index).count, max(point.color.asSphericalHarmonic.count - 1, 0))
+        }
+    }
+
+    func testBatchRoundTripsPoints() {
+        let points = [
+            SplatScenePoint(position: SIMD3(1, 2, 3),
+                            color: .linearUInt8(SIMD3(10, 128, 250)),
+                            opacity: .linearUInt8(200),
+                            scale: .exponent(SIMD3(-1, -2, -3)),
+                            rotation: simd_quatf(angle: 0.5, axis: SIMD3(0, 1, 0))),
+            SplatScenePoint(position: SIMD3(-1, 0, 4),
+                            color: .sphericalHarmonic([SIMD3(0.1, 0.2, 0.3), SIMD3(0.01, 0.02, 0.03),
+                                                       SIMD3(0.04, 0.05, 0.06), SIMD3(0.07, 0.08, 0.09)]),
+                            opacity: .logitFloat(1.5),
+                            scale: .exponent(SIMD3(-2, -3, -4)),
+                            rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1)),
+        ]
+
+        let batch = SplatPointBatch(points)
+
+        XCTAssertEqual(batch.count, 2)
+        XCTAssertEqual(batch.shDegree, 1)
+        XCTAssertEqual(batch.sphericalHarmonics.count, 2 * 3)
+        XCTAssertEqual(Array(batch.sphericalHarmonics(at: 0)), [SIMD3<Float>](repeating: .zero, count: 3))
+        XCTAssertEqual(batch.sphericalHarmonics(at: 1).last, SIMD3(0.07, 0.08, 0.09))
+        for (index, point) in points.enumerated() {
+            XCTAssertTrue(batch[index] ~= point)
+        }
+    }
+
+    func testMortonReorderBatchMatchesPermutation() {
+        var batch = SplatPointBatch(shDegree: 1)
+        for i in 0..<2000 {
+            let t = Float(i)
+            batch.append(SplatScenePoint(position: SIMD3(sin(t) * 10, cos(t * 0.7) * 10, t * 0.01),
+                                         color: .sphericalHarmonic([SIMD3(repeating: t), SIMD3(t, 0, 0), SIMD3(0, t, 0), SIMD3(0, 0, t)]),
+                                         opacity: .logitFloat(0),
+                                         scale: .exponent(.zero),
+                                         rotation: simd_quatf(ix: 0, iy: 0, iz: 0, r: 1)))
+        }
+
+        let indices = MortonOrder.computeReorderingIndices(batch)
+        let reordered = MortonOrder.reorder(batch)
+        let codes = MortonOrder.computeMortonCodes(reordered)
+
+        XCTAssertEqual(Set(indices).count, batch.count)
+        XCTAssertEqual(codes, codes.sorted())
+        for (newIndex, oldIndex) in indices.enumerated() {
+            XCTAssertEqual(reordered.positions[newIndex], batch.positions[oldIndex])
+            XCTAssertEqual(Array(reordered.sphericalHarmonics(at: newIndex)), Array(batch.sphericalHarmonics(at: oldIndex)))
+        }
+    }
+
+    func testPLYWriterWritesBatch() throws {
+        let batch = try SplatPLYSceneReader(plyURL).readBatch()
+
+        let memoryOutput = DataOutputStream()
+        memoryOutput.open()
+        let writer = SplatPLYSceneWriter(memoryOutput)
+        try writer.start(sphericalHarmonicDegree: UInt(batch.shDegree), pointCount: batch.count)
+        try writer.write(batch)
+        try writer.close()
+
+        let memoryInput = InputStream(data: memoryOutput.data)
+        memoryInput.open()
+        let rewritten = try SplatPLYSceneReader(memoryInput).readBatch()
+
+        XCTAssertEqual(rewritten.count, batch.count)
+        XCTAssertEqual(rewritten.sphericalHarmonics.count, batch.sphericalHarmonics.count)
+        for index in 0..<batch.count {
+            XCTAssertTrue(rewritten[index] ~= batch[index])
+        }
+    }
+
+    func testBinaryLayoutMatchesBatch() throws {
+        let batch = try SplatPLYSceneReader(plyURL).readBatch()
+        let mapped = try XCTUnwrap(try SplatPLYBinaryLayout.mapFile(at: plyURL))
+        let layout = mapped.layout
+
+        XCTAssertEqual(layout.pointCount, batch.count)
+        XCTAssertEqual(layout.sphericalHarmonicOffsets.count, batch.shCoefficientsPerPoint)
+        mapped.data.withUnsafeBytes { raw in
+            let body = raw.baseAddress!.advanced(by: layout.bodyOffset)
+            for index in 0..<batch.count {
+                let vertex = body.advanced(by: index * layout.stride)
+                XCTAssertEqual(layout.position(vertex), batch.positions[index])
+                XCTAssertEqual(layout.color(vertex), batch.colors[index])
+                XCTAssertEqual(layout.opacity(vertex), batch.opacities[index])
+                XCTAssertEqual(layout.scale(vertex), batch.scales[index])
+                XCTAssertEqual(layout.rotation(vertex).vector, batch.rotations[index].vector)
+            }
+        }
+
+        let decoded = layout.batch(from: mapped.data)
+        XCTAssertEqual(decoded.count, batch.count)
+        XCTAssertEqual(decoded.sphericalHarmonics, batch.sphericalHarmonics)
+        XCTAssertEqual(decoded.positions, batch.positions)
+
+        let order = Array((0..<batch.count).reversed())
+        let reversed = layout.batch(from: mapped.data, order: order)
+        XCTAssertEqual(reversed.positions, order.map { batch.positions[$0] })
+        XCTAssertEqual(Array(reversed.sphericalHarmonics(at: 0)), Array(batch.sphericalHarmonics(at: batch.count - 1)))
+    }
+
+    // MARK: - Streaming Conversion Tests
+
+    /// Emits fixed points in small batches, optionally without announcing a point count
+    final class BatchedPointReader: SplatSceneReader {
+        let points: [SplatScenePoint]
+        let batchSize: Int
+        let reportsPointCount: Bool
+
+        init(points: [SplatScenePoint], batchSize: Int, reportsPointCount: Bool = true) {
+            self.points = points
+            self.batchSize = batchSize
+            self.reportsPointCount = reportsPointCount
+        }
+
+        func read(to delegate: SplatSceneReaderDelegate) {
+            delegate.didStartReading(withPointCount: reportsPointCount ? UInt32(points.count) : nil)
+            for start in stride(from: 0, to: points.count, by: batchSize) {
+                delegate.didRead(points: Array(points[start..<min(start + batchSize, points.count)]))
+            }
+            delegate.didFinishReading()
+        }
+    }
+
+    private func makeStreamingTestPoints(count: Int) -> [SplatScenePoint] {
+        (0..<count).map { index in
+            let t = Float(index)
+            return SplatScenePoint(position: SIMD3<Float>(t * 0.1, -t * 0.05, 1 + t * 0.01),
+                                   color: .linearFloat(SIMD3<Float>(0.2, 0.4, Float(index % 10) / 10)),
+                                   opacity: .linearFloat(0.5),
+                                   scale: .exponent(SIMD3<Float>(-2, -1.5, -1)),
+                                   rotation: simd_quatf(angle: t * 0.01, axis: SIMD3<Float>(0, 1, 0)))
+        }
+    }
+
+    func testStreamingConverterWritesBatchesInOrder() throws {
+        let points = makeStreamingTestPoints(count: 257)
+        for reportsPointCount in [true, false] {
+            let url = FileManager.default.temporaryDirectory
+                .appendingPathComponent(UUID().uuidString)
+                .appendingPathExtension("ply")
+            defer { try? FileManager.default.removeItem(at: url) }
+
+            let converter = SplatStreamingConverter(options: .init(start: 5, count: 240, workerCount: 4, maxInFlightBatches: 3))
+            let statistics = try converter.convert(makeReader: {
+                BatchedPointReader(points: points, batchSize: 16, reportsPointCount: reportsPointCount)
+            }) { pointCount in
+                XCTAssertEqual(pointCount, 240)
+                let writer = try SplatPLYSceneWriter(toFileAtPath: url.path, append: false)
+                try writer.start(sphericalHarmonicDegree: 0, pointCount: pointCount)
+                return writer
+            }
+            XCTAssertEqual(statistics.pointCount, 240)
+            XCTAssertEqual(statistics.passCount, reportsPointCount ? 1 : 2)
+
+            let rewritten = try SplatPLYSceneReader(url).readScene()
+            XCTAssertEqual(rewritten.count, 240)
+            for (actual, expected) in zip(rewritten, points[5..<245]) {
+                XCTAssertTrue(actual ~= expected)
+            }
+        }
+    }
+
+    func testStreamingConverterDotSplatMatchesBufferedWrite() throws {
+        let points = makeStreamingTestPoints(count: 100)
+
+        let bufferedOutput = DataOutputStream()
+        bufferedOutput.open()
+        try DotSplatSceneWriter(bufferedOutput).write(points)
+
+        let streamedOutput = DataOutputStream()
+        streamedOutput.open()
+        let converter = SplatStreamingConverter(options: .init(workerCount: 3))
+        _ = try converter.convert(makeReader: { BatchedPointReader(points: points, batchSize: 7) }) { _ in
+            DotSplatSceneWriter(streamedOutput)
+        }
+
+        XCTAssertEqual(streamedOutput.data, bufferedOutput.data)
+    }
+
+    func testStreamedInputStreamReportsBytesAsTheReaderTakesThem() {
+        let consumed = LockedBox(0)
+        let stream = StreamedInputStream { count in consumed.withValue { $0 += count } }
+        stream.open()
+        for value in 0..<100 {
+            stream.append(Data([UInt8(value), UInt8(value)]))
+        }
+        XCTAssertEqual(consumed.get(), 0, "Queuing alone must not count as consumed")
+
+        var buffer = [UInt8](repeating: 0, count: 51)
+        XCTAssertEqual(stream.read(&buffer, maxLength: buffer.count), 51)
+        XCTAssertEqual(consumed.get(), 51)
+        XCTAssertEqual(buffer.prefix(4), [0, 0, 1, 1])
+        XCTAssertEqual(buffer.last, 25)
+
+        XCTAssertEqual(stream.read(&buffer, maxLength: 3), 3)
+        XCTAssertEqual(buffer.prefix(3), [25, 26, 26])
+
+        // Closing releases what the reader left, so a producer paused on it can resume and stop
+        stream.close()
+        XCTAssertEqual(consumed.get(), 200)
+        XCTAssertFalse(stream.append(Data([0])))
+    }
+
+    func testRemoteLoaderStreamsDotSplatAndRevalidatesByETag() async throws {
+        let output = DataOutputStream()
+        output.open()
+        try DotSplatSceneWriter(output).write(makeStreamingTestPoints(count: 5000))
+        let expected = try DotSplatSceneReader(InputStream(data: output.data)).readScene()
+
+        let url = URL(string: "https://splats.example/scenes/remote.splat")!
+        StubURLProtocol.serve(output.data, at: url, etag: "\"v1\"")
+        let cacheDirectory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: cacheDirectory) }
+        let cache = RemoteSceneCache(directory: cacheDirectory)
+        let loader = RemoteSceneLoader(session: StubURLProtocol.makeSession(), cache: cache)
+
+        let streamed = ContentStorage()
+        try await loader.read(from: url, to: streamed)
+        XCTAssertTrue(streamed.didFinish)
+        XCTAssertEqual(streamed.points.count, expected.count)
+        for (actual, expected) in zip(streamed.points, expected) {
+            XCTAssertTrue(actual ~= expected)
+        }
+        XCTAssertEqual(cache.entry(for: url)?.etag, "\"v1\"")
+
+        let revalidated = ContentStorage()
+        try await loader.read(from: url, to: revalidated)
+        let exchange = try XCTUnwrap(StubURLProtocol.log(for: url).last)
+        XCTAssertEqual(exchange.request.value(forHTTPHeaderField: "If-None-Match"), "\"v1\"")
+        XCTAssertEqual(exchange.status, 304)
+        XCTAssertTrue(revalidated.didFinish)
+        ContentStorage.testApproximatelyEqual(lhs: revalidated, rhs: streamed)
+    }
+
+    func testRemoteLoaderStreamsPLYWithoutCachingUntaggedResponses() async throws {
+        let url = URL(string: "https://splats.example/scenes/untagged.ply")!
+        StubURLProtocol.serve(try Data(contentsOf: plyURL), at: url, etag: nil)
+        let cacheDirectory = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        defer { try? FileManager.default.removeItem(at: cacheDirectory) }
+        let cache = RemoteSceneCache(directory: cacheDirectory)
+        let loader = RemoteSceneLoader(session: StubURLProtocol.makeSession(), cache: cache)
+
+        let streamed = ContentStorage()
+        try await loader.read(from: url, to: streamed)
+        let local = ContentStorage()
+        try AutodetectSceneReader(plyURL).read(to: local)
+        XCTAssertTrue(streamed.didFinish)
+        ContentStorage.testApproximatelyEqual(lhs: streamed, rhs: local)
+        XCTAssertNil(cache.entry(for: url))
+    }
+
+    func testRemoteLoaderReportsStreamedRenderModeWithoutACache() async throws {
+        // Mark the test PLY as a Brush mip scene with a header comment after the format line
+        var body = try Data(contentsOf: plyURL)
+        let formatLineEnd = try XCTUnwrap(body.indices.filter { body[$0] == UInt8(ascii: "\n") }.dropFirst().first)
+        body.insert(contentsOf: Data("comment SplatRenderMode: mip\n".utf8), at: formatLineEnd + 1)
+
+        let url = URL(string: "https://splats.example/scenes/mip.ply")!
+        StubURLProtocol.serve(body, at: url, etag: "\"mip\"")
+        let loader = RemoteSceneLoader(session: StubURLProtocol.makeSession(), cache: nil)
+
+        let streamed = ContentStorage()
+        let renderMode = try await loader.read(from: url, to: streamed)
+        XCTAssertTrue(streamed.didFinish)
+        XCTAssertEqual(renderMode, .mip)
+
+        let local = ContentStorage()
+        try AutodetectSceneReader(plyURL).read(to: local)
+        ContentStorage.testApproximatelyEqual(lhs: streamed, rhs: local)
+        let plain = URL(string: "https://splats.example/scenes/plain.ply")!
+        StubURLProtocol.serve(try Data(contentsOf: plyURL), at: plain, etag: nil)
+        let plainRenderMode = try await loader.read(from: plain, to: ContentStorage())
+        XCTAssertEqual(plainRenderMode, .standard)
+    }
+
+    func testRemoteLoaderReportsHTTPErrors() async throws {
+        let url = URL(string: "https://splats.example/scenes/missing.splat")!
+        let loader = RemoteSceneLoader(session: StubURLProtocol.makeSession(), cache: nil)
+        let content = ContentStorage()
+        do {
+            try await loader.read(from: url, to: content)
+            XCTFail("Expected a failed read")
+        } catch RemoteSceneLoader.Error.unexpectedStatus(_, let statusCode) {
+            XCTAssertEqual(statusCode, 404)
+        }
+        XCTAssertTrue(content.didFail)
+    }
+
+    func testRemoteLoaderFetchesDotSplatRecordRanges() async throws {
+        let output = DataOutputStream()
+        output.open()
+        try DotSplatSceneWriter(output).write(makeStreamingTestPoints(count: 64))
+        let expected = try DotSplatSceneReader(InputStream(data: output.data)).readScene()
+
+        let url = URL(string: "https://splats.example/scenes/ranged.splat")!
+        StubURLProtocol.serve(output.data, at: url, etag: nil)
+        let loader = RemoteSceneLoader(session: StubURLProtocol.makeSession(), cache: nil)
+
+        let fetched = try await loader.dotSplatPoints(from: url, records: 10..<27)
+        XCTAssertEqual(fetched.count, 17)
+        for (actual, expected) in zip(fetched, expected[10..<27]) {
+            XCTAssertTrue(actual ~= expected)
+        }
+        let exchange = try XCTUnwrap(StubURLProtocol.log(for: url).last)
+        XCTAssertEqual(exchange.request.value(forHTTPHeaderField: "Range"), "bytes=320-863")
+        XCTAssertEqual(exchange.status, 206)
+    }
+
+    func testSOGV2TwoPassMatchesBufferedWrite() throws {
+        let points = makeStreamingTestPoints(count: 50)
+        let bufferedURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathExtension("sog")
+        let streamedURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathExtension("sog")
+        defer {
+            try? FileManager.default.removeItem(at: bufferedURL)
+            try? FileManager.default.removeItem(at: streamedURL)
+        }
+
+        try SOGSV2SceneWriter().writeScene(points, to: bufferedURL)
+
+        let writer = SOGSV2SceneWriter()
+        writer.setOutputURL(streamedURL)
+        let statistics = try SplatStreamingConverter().convert(makeReader: {
+            BatchedPointReader(points: points, batchSize: 8)
+        }, to: writer)
+        XCTAssertEqual(statistics.passCount, 2)
+
+        let buffered = try SplatSOGSSceneReaderV2(bufferedURL).readScene()
+        let streamed = try SplatSOGSSceneReaderV2(streamedURL).readScene()
+        XCTAssertEqual(streamed.count, buffered.count)
+        for (actual, expected) in zip(streamed, buffered) {
+            XCTAssertEqual(actual.position, expected.position)
+            XCTAssertEqual(actual.opacity.asLinearFloat, expected.opacity.asLinearFloat)
+        }
+    }
+
+    func testSPZTwoPassReducesFractionalBitsToFitExtent() throws {
+        XCTAssertEqual(SPZSceneWriter.fractionalBits(fitting: 1, preferred: 12), 12)
+        XCTAssertEqual(SPZSceneWriter.fractionalBits(fitting: 10_000, preferred: 12), 9)
+        XCTAssertEqual(SPZSceneWriter.fractionalBits(fitting: 0, preferred: 10), 10)
+
+        var points = makeStreamingTestPoints(count: 20)
+        points[3].position = SIMD3<Float>(5_000, -2, 3)
+
+        let url = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathExtension("spz")
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        let writer = SPZSceneWriter(useFloat16: false, fractionalBits: 12, outputVersion: 4)
+        writer.setOutputURL(url)
+        _ = try SplatStreamingConverter().convert(makeReader: { BatchedPointReader(points: points, batchSize: 6) }, to: writer)
+
+        let roundTripped = try SPZSceneReader(contentsOf: url).readScene()
+        XCTAssertEqual(roundTripped.count, points.count)
+        XCTAssertEqual(roundTripped[3].position.x, 5_000, accuracy: 0.01)
+    }
+
     // MARK: - Equality Tests
 
     func testEqual(_ urlA: URL, _ urlB: URL) throws {
@@ -1699,6 +2141,84 @@ private class DataOutputStream: OutputStream {
     }
 }
 
+/// Serves registered bodies over a stubbed URLSession, with ETag revalidation and single byte ranges, delivering
+/// each body in several pieces
+private final class StubURLProtocol: URLProtocol {
+    private struct Resource {
+        var body: Data
+        var etag: String?
+    }
+
+    private struct State {
+        var resources: [URL: Resource] = [:]
+        var log: [URL: [(request: URLRequest, status: Int)]] = [:]
+    }
+
+    private static let state = LockedBox(State())
+
+    static func makeSession() -> URLSession {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StubURLProtocol.self]
+        configuration.urlCache = nil
+        return URLSession(configuration: configuration)
+    }
+
+    static func serve(_ body: Data, at url: URL, etag: String?) {
+        state.withValue { $0.resources[url] = Resource(body: body, etag: etag) }
+    }
+
+    static func log(for url: URL) -> [(request: URLRequest, status: Int)] {
+        state.withValue { $0.log[url] ?? [] }
+    }
+
+    override class func canInit(with request: URLRequest) -> Bool { true }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest { request }
+
+    override func startLoading() {
+        guard let url = request.url else { return }
+        var status = 404
+        var body = Data()
+        var headers: [String: String] = [:]
+        if let resource = Self.state.withValue({ $0.resources[url] }) {
+            status = 200
+            body = resource.body
+            if let etag = resource.etag {
+                headers["ETag"] = etag
+                if request.value(forHTTPHeaderField: "If-None-Match") == etag {
+                    status = 304
+                    body = Data()
+                }
+            }
+            if status == 200, let range = request.value(forHTTPHeaderField: "Range"), range.hasPrefix("bytes=") {
+                let bounds = range.dropFirst(6).split(separator: "-").compactMap { Int($0) }
+                if bounds.count == 2, bounds[0] <= bounds[1], bounds[1] < resource.body.count {
+                    status = 206
+                    body = resource.body.subdata(in: bounds[0]..<(bounds[1] + 1))
+                    headers["Content-Range"] = "bytes \(bounds[0])-\(bounds[1])/\(resource.body.count)"
+                } else {
+                    status = 416
+                    body = Data()
+                }
+            }
+        }
+
+        let request = self.request
+        Self.state.withValue { $0.log[url, default: []].append((request, status)) }
+        let response = HTTPURLResponse(url: url, statusCode: status, httpVersion: "HTTP/1.1", headerFields: headers)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        var offset = 0
+        while offset < body.count {
+            let end = min(offset + 8192, body.count)
+            client?.urlProtocol(self, didLoad: body.subdata(in: offset..<end))
+            offset = end
+        }
+        client?.urlProtocolDidFinishLoading(self)
+    }
+
+    override func stopLoading() {}
+}
+
 private extension SIMD3 where Scalar == Float {
     var magnitude: Scalar {
         sqrt(x*x + y*y + z*z)